@@ -1,4 +1,5 @@
 #include "ActorBase.h"
+#include "ActorCoreTable.h"
 #include "../ContentResolver.h"
 #include "../ILevelHandler.h"
 #include "../PreferencesCache.h"
@@ -34,7 +35,8 @@ namespace Jazz2::Actors
 		: _state(ActorState::None), _levelHandler(nullptr), _internalForceY(0.0f), _elasticity(0.0f), _friction(1.5f),
 			_unstuckCooldown(0.0f), _frozenTimeLeft(0.0f), _maxHealth(1), _health(1), _spawnFrames(0.0f), _metadata(nullptr),
 			_renderer(this), _currentAnimation(nullptr), _currentTransition(nullptr), _currentTransitionCancellable(false),
-			_collisionProxyID(Collisions::NullNode)
+			_collisionProxyID(Collisions::NullNode), _coreTable(nullptr), _coreIndex(-1),
+			_parallelPhysics(ParallelPhysicsState::None)
 	{
 	}
 
@@ -82,6 +84,7 @@ namespace Jazz2::Actors
 		bool success = async_await OnActivatedAsync(details);
 
 		_renderer.setPosition(std::round(_pos.X), std::round(_pos.Y));
+		_renderer._lastPos = _pos;
 
 		OnUpdateHitbox();
 
@@ -113,12 +116,39 @@ namespace Jazz2::Actors
 
 	void ActorBase::OnUpdate(float timeMult)
 	{
-		TileCollisionParams params = { TileDestructType::None, _speed.Y >= 0.0f };
-		TryStandardMovement(timeMult, params);
+		if ((_parallelPhysics & ParallelPhysicsState::Updated) == ParallelPhysicsState::Updated) {
+			// Movement was already updated on a worker thread, only deferred callbacks are left
+			ParallelPhysicsState hits = _parallelPhysics;
+			_parallelPhysics = ParallelPhysicsState::None;
+			if ((hits & ParallelPhysicsState::HitWall) == ParallelPhysicsState::HitWall) {
+				OnHitWall(timeMult);
+			}
+			if ((hits & ParallelPhysicsState::HitCeiling) == ParallelPhysicsState::HitCeiling) {
+				OnHitCeiling(timeMult);
+			}
+			if ((hits & ParallelPhysicsState::HitFloor) == ParallelPhysicsState::HitFloor) {
+				OnHitFloor(timeMult);
+			}
+		} else {
+			TileCollisionParams params = { TileDestructType::None, _speed.Y >= 0.0f };
+			TryStandardMovement(timeMult, params);
+		}
 		OnUpdateHitbox();
 		UpdateFrozenState(timeMult);
 	}
 
+	Vector2f ActorBase::GetInterpolatedPos(float alpha)
+	{
+		// Teleports and warps are not interpolated
+		constexpr float MaxDistance = 64.0f;
+
+		Vector2f lastPos = _renderer._lastPos;
+		if (std::abs(_pos.X - lastPos.X) > MaxDistance || std::abs(_pos.Y - lastPos.Y) > MaxDistance) {
+			return _pos;
+		}
+		return lastPos + (_pos - lastPos) * alpha;
+	}
+
 	void ActorBase::OnUpdateHitbox()
 	{
 		if (_metadata != nullptr) {
@@ -147,7 +177,7 @@ namespace Jazz2::Actors
 			}
 		}
 
-		_state |= ActorState::IsDestroyed | ActorState::SkipPerPixelCollisions;
+		SetState(ActorState::IsDestroyed | ActorState::SkipPerPixelCollisions, true);
 		return true;
 	}
 
@@ -302,7 +332,7 @@ namespace Jazz2::Actors
 							_speed.X = -(currentElasticity * _speed.X);
 							_externalForce.X = 0.0f;
 						}
-						OnHitWall(timeMult);
+						NotifyHit(ParallelPhysicsState::HitWall, timeMult);
 					}
 				}
 			} else {
@@ -355,12 +385,12 @@ namespace Jazz2::Actors
 							if (_internalForceY < 0.0f) {
 								_internalForceY = 0.0f;
 							}
-							OnHitCeiling(timeMult);
+							NotifyHit(ParallelPhysicsState::HitCeiling, timeMult);
 							hitCalled = true;
 						}
 					} else if (effectiveSpeedY > 0.0f && yDiff < effectiveSpeedY && currentGravity <= 0.0f) {
 						// If there is no gravity and actor is touching floor, the callback wouldn't be called otherwise
-						OnHitFloor(timeMult);
+						NotifyHit(ParallelPhysicsState::HitFloor, timeMult);
 						hitCalled = true;
 					}
 
@@ -373,7 +403,7 @@ namespace Jazz2::Actors
 
 						// Don't call OnHitWall() if OnHitFloor() or OnHitCeiling() was called this step
 						if (!hitCalled) {
-							OnHitWall(timeMult);
+							NotifyHit(ParallelPhysicsState::HitWall, timeMult);
 						}
 					}
 				}
@@ -401,7 +431,7 @@ namespace Jazz2::Actors
 					_speed.Y += GetGravityModifier(currentGravity, /*isRising:*/false) * timeMult;
 				} else {
 					// Actor is on the floor
-					OnHitFloor(timeMult);
+					NotifyHit(ParallelPhysicsState::HitFloor, timeMult);
 					if (currentElasticity != 0.0f) {
 						SetState(ActorState::CanJump, false);
 						_speed.Y = -(currentElasticity * effectiveSpeedY / timeMult);
@@ -719,14 +749,8 @@ namespace Jazz2::Actors
 	{
 		auto it = _metadata->Sounds.find(String::nullTerminatedView(identifier));
 		if (it != _metadata->Sounds.end()) {
-			AudioBuffer* buffer;
-			if (!it->second.Buffers.empty()) {
-				std::int32_t idx = (it->second.Buffers.size() > 1 ? Random().Next(0, (std::int32_t)it->second.Buffers.size()) : 0);
-				buffer = &it->second.Buffers[idx]->Buffer;
-			} else {
-				buffer = nullptr;
-			}
-
+			auto* variant = it->second.PickVariant();
+			AudioBuffer* buffer = (variant != nullptr ? &variant->Buffer : nullptr);
 			return _levelHandler->PlaySfx(this, identifier, buffer, Vector3f(_pos.X, _pos.Y, 0.0f), false, gain, pitch);
 		}
 
@@ -757,7 +781,7 @@ namespace Jazz2::Actors
 				if (_currentTransitionCallback) {
 					auto oldCallback = std::move(_currentTransitionCallback);
 					_currentTransitionCallback = nullptr;
-					oldCallback();
+					(*oldCallback)();
 				}
 			}
 
@@ -784,12 +808,13 @@ namespace Jazz2::Actors
 		if (_currentTransitionCallback) {
 			auto oldCallback = std::move(_currentTransitionCallback);
 			_currentTransitionCallback = nullptr;
-			oldCallback();
+			(*oldCallback)();
 		}
 
 		_currentTransition = anim;
 		_currentTransitionCancellable = cancellable;
-		_currentTransitionCallback = std::move(callback);		
+		// The callback is shared, so a rollback snapshot can keep it and put it back, see LevelHandler::SaveSnapshot()
+		_currentTransitionCallback = (callback ? std::make_shared<Function<void()>>(std::move(callback)) : nullptr);
 		RefreshAnimation();
 
 		return true;
@@ -801,7 +826,7 @@ namespace Jazz2::Actors
 			if (_currentTransitionCallback) {
 				auto oldCallback = std::move(_currentTransitionCallback);
 				_currentTransitionCallback = nullptr;
-				oldCallback();
+				(*oldCallback)();
 			}
 
 			_currentTransition = nullptr;
@@ -834,7 +859,7 @@ namespace Jazz2::Actors
 			if (_currentTransitionCallback) {
 				auto oldCallback = std::move(_currentTransitionCallback);
 				_currentTransitionCallback = nullptr;
-				oldCallback();
+				(*oldCallback)();
 			}
 		}
 	}
@@ -849,6 +874,149 @@ namespace Jazz2::Actors
 		_levelHandler->SendPacket(this, data);
 	}
 
+	void ActorBase::OnSaveSnapshot(Stream& dest)
+	{
+		dest.WriteValue<ActorState>(_state);
+		dest.WriteValue<float>(_pos.X);
+		dest.WriteValue<float>(_pos.Y);
+		dest.WriteValue<float>(_speed.X);
+		dest.WriteValue<float>(_speed.Y);
+		dest.WriteValue<float>(_externalForce.X);
+		dest.WriteValue<float>(_externalForce.Y);
+		dest.WriteValue<float>(_internalForceY);
+		dest.WriteValue<float>(_elasticity);
+		dest.WriteValue<float>(_friction);
+		dest.WriteValue<float>(_maxRiseSpeed);
+		dest.WriteValue<float>(_verticalSpeedLimit);
+		dest.WriteValue<float>(_unstuckCooldown);
+		dest.WriteValue<float>(_frozenTimeLeft);
+		dest.WriteValue<std::int32_t>(_maxHealth);
+		dest.WriteValue<std::int32_t>(_health);
+		dest.WriteValue<std::int32_t>(_originTile.X);
+		dest.WriteValue<std::int32_t>(_originTile.Y);
+		dest.WriteValue<float>(_spawnFrames);
+		dest.WriteValue<std::int32_t>(_collisionProxyID);
+		dest.WriteValue<float>(AABB.L);
+		dest.WriteValue<float>(AABB.T);
+		dest.WriteValue<float>(AABB.R);
+		dest.WriteValue<float>(AABB.B);
+		dest.WriteValue<float>(AABBInner.L);
+		dest.WriteValue<float>(AABBInner.T);
+		dest.WriteValue<float>(AABBInner.R);
+		dest.WriteValue<float>(AABBInner.B);
+		dest.WriteValue<std::uintptr_t>(reinterpret_cast<std::uintptr_t>(_currentAnimation));
+		dest.WriteValue<std::uintptr_t>(reinterpret_cast<std::uintptr_t>(_currentTransition));
+		dest.WriteValue<bool>(_currentTransitionCancellable);
+
+		dest.WriteValue<ActorRendererType>(_renderer._rendererType);
+		dest.WriteValue<float>(_renderer._rendererTransition);
+		dest.WriteValue<std::int32_t>(_renderer._paletteOffset);
+		dest.WriteValue<float>(_renderer._lastPos.X);
+		dest.WriteValue<float>(_renderer._lastPos.Y);
+		dest.WriteValue<bool>(_renderer.AnimPaused);
+		dest.WriteValue<AnimationLoopMode>(_renderer.LoopMode);
+		dest.WriteValue<std::int32_t>(_renderer.FirstFrame);
+		dest.WriteValue<std::int32_t>(_renderer.FrameCount);
+		dest.WriteValue<float>(_renderer.AnimDuration);
+		dest.WriteValue<float>(_renderer.AnimTime);
+		dest.WriteValue<bool>(_renderer.isDrawEnabled());
+		dest.WriteValue<bool>(_renderer.isFlippedY());
+		dest.WriteValue<float>(_renderer.rotation());
+		dest.WriteValue<float>(_renderer.scale().X);
+		dest.WriteValue<float>(_renderer.scale().Y);
+		Colorf color = _renderer.color();
+		dest.WriteValue<float>(color.R);
+		dest.WriteValue<float>(color.G);
+		dest.WriteValue<float>(color.B);
+		dest.WriteValue<float>(color.A);
+		dest.WriteValue<std::uint16_t>(_renderer.layer());
+	}
+
+	void ActorBase::OnRestoreSnapshot(Stream& src)
+	{
+		_state = src.ReadValue<ActorState>();
+		_pos.X = src.ReadValue<float>();
+		_pos.Y = src.ReadValue<float>();
+		_speed.X = src.ReadValue<float>();
+		_speed.Y = src.ReadValue<float>();
+		_externalForce.X = src.ReadValue<float>();
+		_externalForce.Y = src.ReadValue<float>();
+		_internalForceY = src.ReadValue<float>();
+		_elasticity = src.ReadValue<float>();
+		_friction = src.ReadValue<float>();
+		_maxRiseSpeed = src.ReadValue<float>();
+		_verticalSpeedLimit = src.ReadValue<float>();
+		_unstuckCooldown = src.ReadValue<float>();
+		_frozenTimeLeft = src.ReadValue<float>();
+		_maxHealth = src.ReadValue<std::int32_t>();
+		_health = src.ReadValue<std::int32_t>();
+		_originTile.X = src.ReadValue<std::int32_t>();
+		_originTile.Y = src.ReadValue<std::int32_t>();
+		_spawnFrames = src.ReadValue<float>();
+		_collisionProxyID = src.ReadValue<std::int32_t>();
+		AABB.L = src.ReadValue<float>();
+		AABB.T = src.ReadValue<float>();
+		AABB.R = src.ReadValue<float>();
+		AABB.B = src.ReadValue<float>();
+		AABBInner.L = src.ReadValue<float>();
+		AABBInner.T = src.ReadValue<float>();
+		AABBInner.R = src.ReadValue<float>();
+		AABBInner.B = src.ReadValue<float>();
+
+		GraphicResource* prevAnimation = _currentAnimation;
+		GraphicResource* prevTransition = _currentTransition;
+		_currentAnimation = reinterpret_cast<GraphicResource*>(src.ReadValue<std::uintptr_t>());
+		_currentTransition = reinterpret_cast<GraphicResource*>(src.ReadValue<std::uintptr_t>());
+		_currentTransitionCancellable = src.ReadValue<bool>();
+		// Completion callback of the transition is put back by LevelHandler::RestoreSnapshot(), it cannot be serialized
+
+		ActorRendererType rendererType = src.ReadValue<ActorRendererType>();
+		_renderer._rendererTransition = src.ReadValue<float>();
+		_renderer.SetPalette(src.ReadValue<std::int32_t>());
+		_renderer._lastPos.X = src.ReadValue<float>();
+		_renderer._lastPos.Y = src.ReadValue<float>();
+		_renderer.AnimPaused = src.ReadValue<bool>();
+		_renderer.LoopMode = src.ReadValue<AnimationLoopMode>();
+		_renderer.FirstFrame = src.ReadValue<std::int32_t>();
+		_renderer.FrameCount = src.ReadValue<std::int32_t>();
+		_renderer.AnimDuration = src.ReadValue<float>();
+		_renderer.AnimTime = src.ReadValue<float>();
+		_renderer.setDrawEnabled(src.ReadValue<bool>());
+		_renderer.setFlippedX(IsFacingLeft());
+		_renderer.setFlippedY(src.ReadValue<bool>());
+		_renderer.setRotation(src.ReadValue<float>());
+		Vector2f scale;
+		scale.X = src.ReadValue<float>();
+		scale.Y = src.ReadValue<float>();
+		_renderer.setScale(scale);
+		Colorf color;
+		color.R = src.ReadValue<float>();
+		color.G = src.ReadValue<float>();
+		color.B = src.ReadValue<float>();
+		color.A = src.ReadValue<float>();
+		_renderer.setColor(color);
+		_renderer.setLayer(src.ReadValue<std::uint16_t>());
+
+		GraphicResource* res = (_currentTransition != nullptr ? _currentTransition : _currentAnimation);
+		if (res != nullptr && (_currentAnimation != prevAnimation || _currentTransition != prevTransition)) {
+			// Only properties of the frame sheet are taken from the resource, the animation progress was restored above
+			_renderer.FrameConfiguration = res->Base->FrameConfiguration;
+			_renderer.FrameDimensions = res->Base->FrameDimensions;
+			_renderer.FrameSource = res->Base;
+			_renderer.Hotspot.X = static_cast<float>(res->Base->Hotspot.X);
+			_renderer.Hotspot.Y = static_cast<float>(res->Base->Hotspot.Y);
+			_renderer.setTexture(res->Base->TextureDiffuse.get());
+			_renderer.SetIndexed((res->Base->Flags & GenericGraphicResourceFlags::Indexed) == GenericGraphicResourceFlags::Indexed, res->PaletteOffset);
+		}
+		if (rendererType != (ActorRendererType)-1) {
+			_renderer.Initialize(rendererType);
+		}
+		if (_renderer.FrameCount > 0) {
+			_renderer.UpdateVisibleFrames();
+		}
+		_renderer.UpdatePosition(_pos);
+	}
+
 	bool ActorBase::IsCollidingWith(ActorBase* other)
 	{
 		bool perPixel1 = (_state & ActorState::SkipPerPixelCollisions) != ActorState::SkipPerPixelCollisions;
@@ -1348,7 +1516,7 @@ namespace Jazz2::Actors
 		OnAnimationStarted();
 
 		if ((_state & ActorState::ForceDisableCollisions) != ActorState::ForceDisableCollisions) {
-			_state |= ActorState::IsDirty;
+			SetState(ActorState::IsDirty, true);
 		}
 	}
 
@@ -1466,7 +1634,7 @@ namespace Jazz2::Actors
 			AABBInner = aabb;
 			_pos = newPos;
 			if ((_state & ActorState::ForceDisableCollisions) != ActorState::ForceDisableCollisions) {
-				_state |= ActorState::IsDirty;
+				SetState(ActorState::IsDirty, true);
 			}
 		}
 		return free;
@@ -1478,6 +1646,52 @@ namespace Jazz2::Actors
 		_externalForce.Y += y;
 	}
 
+	bool ActorBase::CanUpdatePhysicsInParallel() const
+	{
+		// Solid objects are looked up in the shared collision tree, while other actors may be moving
+		return (_state & (ActorState::ParallelPhysics | ActorState::CollideWithSolidObjects | ActorState::IsDestroyed)) == ActorState::ParallelPhysics;
+	}
+
+	void ActorBase::UpdatePhysicsInParallel(float timeMult)
+	{
+		// Tiles are never destroyed by standard movement, so the tile map is only read here
+		_parallelPhysics = ParallelPhysicsState::Updating;
+		// The position must be recorded before the movement, as in ActorRenderer::OnUpdate(), otherwise it's not interpolated
+		_renderer._lastPos = _pos;
+		TileCollisionParams params = { TileDestructType::None, _speed.Y >= 0.0f };
+		TryStandardMovement(timeMult, params);
+		_parallelPhysics = (_parallelPhysics & ~ParallelPhysicsState::Updating) | ParallelPhysicsState::Updated;
+	}
+
+	void ActorBase::NotifyHit(ParallelPhysicsState hit, float timeMult)
+	{
+		if ((_parallelPhysics & ParallelPhysicsState::Updating) == ParallelPhysicsState::Updating) {
+			_parallelPhysics |= hit;
+			return;
+		}
+
+		switch (hit) {
+			case ParallelPhysicsState::HitFloor: OnHitFloor(timeMult); break;
+			case ParallelPhysicsState::HitCeiling: OnHitCeiling(timeMult); break;
+			case ParallelPhysicsState::HitWall: OnHitWall(timeMult); break;
+			default: break;
+		}
+	}
+
+	void ActorBase::UpdateCoreFlags(ActorState flags) noexcept
+	{
+		ActorCoreFlags coreFlags = ActorCoreFlags::None;
+		if ((flags & ActorState::IsDirty) == ActorState::IsDirty) {
+			coreFlags |= ActorCoreFlags::IsDirty;
+		}
+		if ((flags & ActorState::IsDestroyed) == ActorState::IsDestroyed) {
+			coreFlags |= ActorCoreFlags::IsDestroyed;
+		}
+		if (coreFlags != ActorCoreFlags::None) {
+			_coreTable->_flags[_coreIndex] |= coreFlags;
+		}
+	}
+
 	ActorBase::ActorRenderer::ActorRenderer(ActorBase* owner)
 		: BaseSprite(nullptr, nullptr, 0.0f, 0.0f), AnimPaused(false), FrameSource(nullptr), LoopMode(AnimationLoopMode::Loop), FirstFrame(0),
 			FrameCount(0), AnimDuration(0.0f), AnimTime(0.0f), CurrentFrame(0), _owner(owner),
@@ -1589,14 +1803,13 @@ namespace Jazz2::Actors
 
 	void ActorBase::ActorRenderer::OnUpdate(float timeMult)
 	{
+		if ((_owner->_parallelPhysics & ParallelPhysicsState::Updated) != ParallelPhysicsState::Updated) {
+			// Otherwise, it was already recorded by UpdatePhysicsInParallel() before the actor was moved
+			_lastPos = _owner->_pos;
+		}
 		_owner->OnUpdate(timeMult);
 
-		Vector2f pos = _owner->_pos;
-		if (!PreferencesCache::UnalignedViewport || (_owner->_state & ActorState::IsDirty) != ActorState::IsDirty) {
-			pos.X = std::floor(pos.X);
-			pos.Y = std::floor(pos.Y);
-		}
-		setPosition(pos.X, pos.Y);
+		UpdatePosition(_owner->_pos);
 
 		if (IsAnimationRunning()) {
 			switch (LoopMode) {
@@ -1663,6 +1876,22 @@ namespace Jazz2::Actors
 		}
 	}
 
+	void ActorBase::ActorRenderer::Interpolate(float alpha)
+	{
+		UpdatePosition(_owner->GetInterpolatedPos(alpha));
+		// The scene graph is not updated between fixed steps, so the transformation has to be recalculated here
+		transform();
+	}
+
+	void ActorBase::ActorRenderer::UpdatePosition(Vector2f pos)
+	{
+		if (!PreferencesCache::UnalignedViewport || (_owner->_state & ActorState::IsDirty) != ActorState::IsDirty) {
+			pos.X = std::floor(pos.X);
+			pos.Y = std::floor(pos.Y);
+		}
+		setPosition(pos.X, pos.Y);
+	}
+
 	bool ActorBase::ActorRenderer::IsAnimationRunning()
 	{
 		if (FrameCount <= 0) {
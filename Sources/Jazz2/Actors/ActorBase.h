@@ -58,6 +58,7 @@ namespace Jazz2::UI::Multiplayer
 
 namespace Jazz2::Actors
 {
+	class ActorCoreTable;
 	class Player;
 
 	/**
@@ -98,7 +99,15 @@ namespace Jazz2::Actors
 		/** @brief Actor is facing left */
 		IsFacingLeft = 0x1000,
 
-		//Reserved = 0x2000,
+		/**
+		 * @brief Standard movement can be updated on a worker thread ahead of @ref ActorBase::OnUpdate()
+		 *
+		 * Set only by actors that call @ref ActorBase::OnUpdate() before anything else in their update. The movement
+		 * is then updated for all such actors at once before the scene, and @ref ActorBase::OnHitFloor(), @ref ActorBase::OnHitCeiling()
+		 * and @ref ActorBase::OnHitWall() are deferred until @ref ActorBase::OnUpdate() of the actor is called, each at most once.
+		 * Ignored for actors that collide with solid objects, because their movement depends on positions of other actors.
+		 */
+		ParallelPhysics = 0x2000,
 
 		/** @brief Actor should be preserved when state is rolled back to checkpoint */
 		PreserveOnRollback = 0x4000,
@@ -318,6 +327,7 @@ namespace Jazz2::Actors
 	{
 		DEATH_RUNTIME_OBJECT();
 
+		friend class ActorCoreTable;
 		friend class Player;
 		friend class Jazz2::LevelHandler;
 		friend class Jazz2::Rendering::LightingRenderer;
@@ -388,6 +398,13 @@ namespace Jazz2::Actors
 			return _speed;
 		}
 
+		/**
+		 * @brief Returns position between the position before and after the last update
+		 *
+		 * @param alpha  Fraction of the next fixed step that has already elapsed, see @ref LevelHandler::GetInterpolationFactor()
+		 */
+		Vector2f GetInterpolatedPos(float alpha);
+
 		/** @brief Returns actor state */
 		constexpr ActorState GetState() const noexcept {
 			return _state;
@@ -459,6 +476,14 @@ namespace Jazz2::Actors
 			void OnUpdate(float timeMult) override;
 			bool OnDraw(RenderQueue& renderQueue) override;
 
+			/**
+			 * @brief Places the sprite between the position of its owner before and after the last update
+			 *
+			 * Used if the level is simulated in fixed steps (see @ref LevelHandler::IsFixedTimestep()), so the movement
+			 * stays smooth even if the frame rate doesn't match the simulation rate.
+			 */
+			void Interpolate(float alpha);
+
 			/** @brief Returns `true` if animation is running */
 			bool IsAnimationRunning();
 			/** @brief Returns active renderer type */
@@ -487,7 +512,10 @@ namespace Jazz2::Actors
 			bool _baseIndexed;
 			// Palette offset of the current indexed graphic (the animation's PaletteOffset; 0 = default sprite palette)
 			std::int32_t _basePaletteOffset;
+			// Position of the owner before the last update, the sprite is interpolated from it
+			Vector2f _lastPos;
 
+			void UpdatePosition(Vector2f pos);
 			void UpdateVisibleFrames();
 			// Re-applies the current renderer type so a palette/indexed change swaps the shader and (re)binds the palette
 			void ReinitializeCurrentType();
@@ -616,6 +644,17 @@ namespace Jazz2::Actors
 		/** @brief Sends a packet to the other side of a non-local session */
 		void SendPacket(ArrayView<const std::uint8_t> data);
 
+		/**
+		 * @brief Called to save state of the object to a rollback snapshot, see @ref RollbackBuffer
+		 *
+		 * Derived classes with their own state that changes during the level should override it together with
+		 * @ref OnRestoreSnapshot() and call the base implementation first. Referenced actors remain alive as long as
+		 * the snapshot, so they can be saved as plain pointers.
+		 */
+		virtual void OnSaveSnapshot(Stream& dest);
+		/** @brief Called to restore state of the object saved by @ref OnSaveSnapshot() */
+		virtual void OnRestoreSnapshot(Stream& src);
+
 		/** @brief Preloads specified metadata and its linked assets to cache */
 		static void PreloadMetadataAsync(StringView path);
 		/**
@@ -639,7 +678,9 @@ namespace Jazz2::Actors
 					return false;
 				}
 				void await_suspend(std::coroutine_handle<> handle) {
-					// TODO: implement async
+					// Callers of OnActivated() expect the actor to be fully initialized when it returns, so the coroutine
+					// is resumed immediately. Metadata preloaded by PreloadMetadataAsync() are only finished here, the
+					// worker has usually done most of the work already.
 					auto metadata = ContentResolver::Get().RequestMetadata(path, forceIndexed);
 					actor->_metadata = metadata;
 					handle();
@@ -653,14 +694,20 @@ namespace Jazz2::Actors
 #endif
 
 		/** @brief Sets actor state */
-		constexpr void SetState(ActorState flags) noexcept {
+		void SetState(ActorState flags) noexcept {
 			_state = flags;
+			if (_coreTable != nullptr) {
+				UpdateCoreFlags(flags);
+			}
 		}
 
 		/** @overload */
-		constexpr void SetState(ActorState flag, bool value) noexcept {
+		void SetState(ActorState flag, bool value) noexcept {
 			if (value) {
 				_state = _state | flag;
+				if (_coreTable != nullptr) {
+					UpdateCoreFlags(flag);
+				}
 			} else {
 				_state = _state & (~flag);
 			}
@@ -672,11 +719,33 @@ namespace Jazz2::Actors
 
 		std::int32_t _collisionProxyID;
 		ActorState _state;
-		Function<void()> _currentTransitionCallback;
+		std::shared_ptr<Function<void()>> _currentTransitionCallback;
+		ActorCoreTable* _coreTable;
+		std::int32_t _coreIndex;
+
+		enum class ParallelPhysicsState : std::uint8_t {
+			None = 0x00,
+			Updating = 0x01,
+			Updated = 0x02,
+			HitFloor = 0x10,
+			HitCeiling = 0x20,
+			HitWall = 0x40
+		};
+
+		DEATH_PRIVATE_ENUM_FLAGS(ParallelPhysicsState);
+
+		ParallelPhysicsState _parallelPhysics;
 
 		bool IsCollidingWithAngled(ActorBase* other);
 		bool IsCollidingWithAngled(const AABBf& aabb);
 
 		void RefreshAnimation(bool skipAnimation = false);
+		void UpdateCoreFlags(ActorState flags) noexcept;
+
+		/** @brief Returns `true` if standard movement can be updated by @ref UpdatePhysicsInParallel() in this step */
+		bool CanUpdatePhysicsInParallel() const;
+		/** @brief Updates standard movement, called on a worker thread, see @ref ActorState::ParallelPhysics */
+		void UpdatePhysicsInParallel(float timeMult);
+		void NotifyHit(ParallelPhysicsState hit, float timeMult);
 	};
 }
\ No newline at end of file
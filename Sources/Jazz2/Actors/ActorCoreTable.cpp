@@ -0,0 +1,98 @@
+#include "ActorCoreTable.h"
+#include "ActorBase.h"
+
+namespace Jazz2::Actors
+{
+	namespace
+	{
+		ActorCoreFlags GetCoreFlags(ActorState state)
+		{
+			ActorCoreFlags flags = ActorCoreFlags::None;
+			if ((state & ActorState::IsDirty) == ActorState::IsDirty) {
+				flags |= ActorCoreFlags::IsDirty;
+			}
+			if ((state & ActorState::IsDestroyed) == ActorState::IsDestroyed) {
+				flags |= ActorCoreFlags::IsDestroyed;
+			}
+			if ((state & ActorState::IsCreatedFromEventMap) == ActorState::IsCreatedFromEventMap) {
+				flags |= ActorCoreFlags::IsCreatedFromEventMap;
+			}
+			if ((state & ActorState::IsFromGenerator) == ActorState::IsFromGenerator) {
+				flags |= ActorCoreFlags::IsFromGenerator;
+			}
+			return flags;
+		}
+	}
+
+	ActorCoreTable::ActorCoreTable()
+	{
+	}
+
+	ActorCoreTable::~ActorCoreTable()
+	{
+		// Actors can outlive the level (e.g. in rollback snapshots), they must not write to the table anymore
+		Clear();
+	}
+
+	void ActorCoreTable::Add(ActorBase* actor)
+	{
+		actor->_coreTable = this;
+		actor->_coreIndex = (std::int32_t)_actors.size();
+
+		_actors.push_back(actor);
+		_flags.push_back(GetCoreFlags(actor->_state));
+		_proxyIDs.push_back(actor->_collisionProxyID);
+		_originTiles.push_back(actor->_originTile);
+	}
+
+	void ActorCoreTable::RemoveUnordered(std::int32_t index)
+	{
+		Detach(_actors[index]);
+
+		std::int32_t last = (std::int32_t)_actors.size() - 1;
+		if (index != last) {
+			_actors[index] = _actors[last];
+			_flags[index] = _flags[last];
+			_proxyIDs[index] = _proxyIDs[last];
+			_originTiles[index] = _originTiles[last];
+			_actors[index]->_coreIndex = index;
+		}
+
+		_actors.pop_back();
+		_flags.pop_back();
+		_proxyIDs.pop_back();
+		_originTiles.pop_back();
+	}
+
+	void ActorCoreTable::Rebuild(ArrayView<const std::shared_ptr<ActorBase>> actors)
+	{
+		Clear();
+
+		_actors.reserve(actors.size());
+		_flags.reserve(actors.size());
+		_proxyIDs.reserve(actors.size());
+		_originTiles.reserve(actors.size());
+
+		for (const auto& actor : actors) {
+			Add(actor.get());
+		}
+	}
+
+	void ActorCoreTable::Clear()
+	{
+		for (ActorBase* actor : _actors) {
+			Detach(actor);
+		}
+
+		_actors.clear();
+		_flags.clear();
+		_proxyIDs.clear();
+		_originTiles.clear();
+	}
+
+	void ActorCoreTable::Detach(ActorBase* actor)
+	{
+		actor->_coreTable = nullptr;
+		actor->_coreIndex = -1;
+	}
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "../../Main.h"
+#include "../../nCine/Primitives/Vector2.h"
+
+#include <memory>
+
+#include <Containers/ArrayView.h>
+#include <Containers/SmallVector.h>
+
+using namespace Death::Containers;
+using namespace nCine;
+
+namespace Jazz2::Actors
+{
+	class ActorBase;
+
+	/** @brief Flags of an actor that are processed by the level once per step, see @ref ActorCoreTable */
+	enum class ActorCoreFlags : std::uint8_t
+	{
+		None = 0,
+
+		IsDirty = 0x01,					/**< Bounding box has to be updated in the broad-phase */
+		IsDestroyed = 0x02,				/**< Actor has to be removed from the level */
+		IsCreatedFromEventMap = 0x04,	/**< Actor was spawned by the event map */
+		IsFromGenerator = 0x08			/**< Actor was spawned by a generator */
+	};
+
+	DEATH_ENUM_FLAGS(ActorCoreFlags);
+
+	/**
+		@brief Hot per-actor data of a level stored as structure of arrays
+
+		Slots are kept in the same order as the list of actors of the level, so the level can walk both with the same
+		index, and each actor knows its own slot. Passes that run over all actors once per step (the broad-phase update
+		and deactivation of actors too far from all players) stream through the small arrays here and touch actors
+		themselves only if there is some work for them. Actors are still the owners of the data, the table is kept in
+		sync by @ref ActorBase::SetState(). The collision proxy of an actor is created before its slot is added and
+		destroyed when the slot is removed, so the proxy ID never changes in between. Position, speed and bounding box
+		are not part of the table, they stay in the actors, which update them in their own (virtual) code anyway.
+	*/
+	class ActorCoreTable
+	{
+	public:
+		ActorCoreTable();
+		~ActorCoreTable();
+
+		ActorCoreTable(const ActorCoreTable&) = delete;
+		ActorCoreTable& operator=(const ActorCoreTable&) = delete;
+
+		/** @brief Returns number of slots */
+		std::int32_t GetCount() const {
+			return (std::int32_t)_actors.size();
+		}
+
+		/** @brief Returns flags of the specified slot */
+		ActorCoreFlags GetFlags(std::int32_t index) const {
+			return _flags[index];
+		}
+		/** @brief Clears the specified flags of the specified slot */
+		void ClearFlags(std::int32_t index, ActorCoreFlags flags) {
+			_flags[index] &= ~flags;
+		}
+		/** @brief Returns collision proxy ID of the specified slot */
+		std::int32_t GetProxyID(std::int32_t index) const {
+			return _proxyIDs[index];
+		}
+		/** @brief Returns tile the actor was spawned at */
+		Vector2i GetOriginTile(std::int32_t index) const {
+			return _originTiles[index];
+		}
+
+		/** @brief Appends a slot for the specified actor */
+		void Add(ActorBase* actor);
+		/** @brief Removes the specified slot, the last slot is moved in its place */
+		void RemoveUnordered(std::int32_t index);
+		/** @brief Replaces all slots with the specified actors, their state is read again */
+		void Rebuild(ArrayView<const std::shared_ptr<ActorBase>> actors);
+		/** @brief Removes all slots */
+		void Clear();
+
+	private:
+		friend class ActorBase;
+
+		SmallVector<ActorBase*, 0> _actors;
+		SmallVector<ActorCoreFlags, 0> _flags;
+		SmallVector<std::int32_t, 0> _proxyIDs;
+		SmallVector<Vector2i, 0> _originTiles;
+
+		void Detach(ActorBase* actor);
+	};
+}
@@ -21,7 +21,7 @@ namespace Jazz2::Actors::Collectibles
 	{
 		_elasticity = 0.6f;
 
-		SetState(ActorState::SkipPerPixelCollisions, true);
+		SetState(ActorState::SkipPerPixelCollisions | ActorState::ParallelPhysics, true);
 
 		Vector2f pos = _pos;
 		_phase = ((pos.X / 32) + (pos.Y / 32)) * 2.0f;
@@ -76,6 +76,26 @@ namespace Jazz2::Actors::Collectibles
 		}
 	}
 
+	void CollectibleBase::OnSaveSnapshot(Stream& dest)
+	{
+		ActorBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<bool>(_untouched);
+		dest.WriteValue<float>(_timeLeft);
+		dest.WriteValue<float>(_phase);
+		dest.WriteValue<float>(_startingY);
+	}
+
+	void CollectibleBase::OnRestoreSnapshot(Stream& src)
+	{
+		ActorBase::OnRestoreSnapshot(src);
+
+		_untouched = src.ReadValue<bool>();
+		_timeLeft = src.ReadValue<float>();
+		_phase = src.ReadValue<float>();
+		_startingY = src.ReadValue<float>();
+	}
+
 	void CollectibleBase::OnEmitLights(SmallVectorImpl<LightEmitter>& lights)
 	{
 		for (auto& current : _illuminateLights) {
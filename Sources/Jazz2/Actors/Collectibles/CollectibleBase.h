@@ -50,6 +50,8 @@ namespace Jazz2::Actors::Collectibles
 
 		Task<bool> OnActivatedAsync(const ActorActivationDetails& details) override;
 		void OnUpdate(float timeMult) override;
+		void OnSaveSnapshot(Stream& dest) override;
+		void OnRestoreSnapshot(Stream& src) override;
 		void OnEmitLights(SmallVectorImpl<LightEmitter>& lights) override;
 
 		/** @brief Called when the collectible is collected */
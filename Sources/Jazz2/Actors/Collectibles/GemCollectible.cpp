@@ -67,6 +67,20 @@ namespace Jazz2::Actors::Collectibles
 		}
 	}
 
+	void GemCollectible::OnSaveSnapshot(Stream& dest)
+	{
+		CollectibleBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<float>(_ignoreTime);
+	}
+
+	void GemCollectible::OnRestoreSnapshot(Stream& src)
+	{
+		CollectibleBase::OnRestoreSnapshot(src);
+
+		_ignoreTime = src.ReadValue<float>();
+	}
+
 	void GemCollectible::OnUpdateHitbox()
 	{
 		UpdateHitbox(20, 20);
@@ -30,6 +30,8 @@ namespace Jazz2::Actors::Collectibles
 
 		Task<bool> OnActivatedAsync(const ActorActivationDetails& details) override;
 		void OnUpdate(float timeMult) override;
+		void OnSaveSnapshot(Stream& dest) override;
+		void OnRestoreSnapshot(Stream& src) override;
 		void OnUpdateHitbox() override;
 		void OnCollect(Player* player) override;
 	};
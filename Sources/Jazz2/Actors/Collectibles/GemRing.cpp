@@ -27,6 +27,8 @@ namespace Jazz2::Actors::Collectibles
 		_untouched = false;
 
 		SetState(ActorState::SkipPerPixelCollisions, true);
+		// The ring has no standard movement, it must not be updated ahead of OnUpdate()
+		SetState(ActorState::ParallelPhysics, false);
 
 		async_await RequestMetadataAsync("Collectible/Gems"_s);
 
@@ -81,6 +83,38 @@ namespace Jazz2::Actors::Collectibles
 		}
 	}
 
+	void GemRing::OnSaveSnapshot(Stream& dest)
+	{
+		CollectibleBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<float>(_speed);
+		dest.WriteValue<float>(_phase);
+		dest.WriteValue<bool>(_collected);
+		dest.WriteValue<float>(_collectedPhase);
+		for (const auto& piece : _pieces) {
+			dest.WriteValue<float>(piece.Pos.X);
+			dest.WriteValue<float>(piece.Pos.Y);
+			dest.WriteValue<float>(piece.Angle);
+			dest.WriteValue<float>(piece.Scale);
+		}
+	}
+
+	void GemRing::OnRestoreSnapshot(Stream& src)
+	{
+		CollectibleBase::OnRestoreSnapshot(src);
+
+		_speed = src.ReadValue<float>();
+		_phase = src.ReadValue<float>();
+		_collected = src.ReadValue<bool>();
+		_collectedPhase = src.ReadValue<float>();
+		for (auto& piece : _pieces) {
+			piece.Pos.X = src.ReadValue<float>();
+			piece.Pos.Y = src.ReadValue<float>();
+			piece.Angle = src.ReadValue<float>();
+			piece.Scale = src.ReadValue<float>();
+		}
+	}
+
 	void GemRing::OnUpdateHitbox()
 	{
 		AABBInner = AABBf(
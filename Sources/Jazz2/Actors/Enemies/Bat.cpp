@@ -113,6 +113,22 @@ namespace Jazz2::Actors::Enemies
 		}
 	}
 
+	void Bat::OnSaveSnapshot(Stream& dest)
+	{
+		EnemyBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<bool>(_attacking);
+		dest.WriteValue<float>(_noiseCooldown);
+	}
+
+	void Bat::OnRestoreSnapshot(Stream& src)
+	{
+		EnemyBase::OnRestoreSnapshot(src);
+
+		_attacking = src.ReadValue<bool>();
+		_noiseCooldown = src.ReadValue<float>();
+	}
+
 	void Bat::OnUpdateHitbox()
 	{
 		UpdateHitbox(24, 24);
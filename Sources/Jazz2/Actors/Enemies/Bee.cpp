@@ -93,6 +93,38 @@ namespace Jazz2::Actors::Enemies
 		MoveInstantly(_lastPos + Vector2f(cosf(_anglePhase) * 16.0f, sinf(_anglePhase) * -16.0f), MoveType::Absolute | MoveType::Force);
 	}
 
+	void Bee::OnSaveSnapshot(Stream& dest)
+	{
+		EnemyBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<float>(_lastPos.X);
+		dest.WriteValue<float>(_lastPos.Y);
+		dest.WriteValue<float>(_targetPos.X);
+		dest.WriteValue<float>(_targetPos.Y);
+		dest.WriteValue<float>(_lastSpeed.X);
+		dest.WriteValue<float>(_lastSpeed.Y);
+		dest.WriteValue<float>(_anglePhase);
+		dest.WriteValue<float>(_attackTime);
+		dest.WriteValue<bool>(_attacking);
+		dest.WriteValue<bool>(_returning);
+	}
+
+	void Bee::OnRestoreSnapshot(Stream& src)
+	{
+		EnemyBase::OnRestoreSnapshot(src);
+
+		_lastPos.X = src.ReadValue<float>();
+		_lastPos.Y = src.ReadValue<float>();
+		_targetPos.X = src.ReadValue<float>();
+		_targetPos.Y = src.ReadValue<float>();
+		_lastSpeed.X = src.ReadValue<float>();
+		_lastSpeed.Y = src.ReadValue<float>();
+		_anglePhase = src.ReadValue<float>();
+		_attackTime = src.ReadValue<float>();
+		_attacking = src.ReadValue<bool>();
+		_returning = src.ReadValue<bool>();
+	}
+
 	bool Bee::OnPerish(ActorBase* collider)
 	{
 		if (_noise != nullptr) {
@@ -26,6 +26,8 @@ namespace Jazz2::Actors::Enemies
 	protected:
 		Task<bool> OnActivatedAsync(const ActorActivationDetails& details) override;
 		void OnUpdate(float timeMult) override;
+		void OnSaveSnapshot(Stream& dest) override;
+		void OnRestoreSnapshot(Stream& src) override;
 		bool OnPerish(ActorBase* collider) override;
 
 	private:
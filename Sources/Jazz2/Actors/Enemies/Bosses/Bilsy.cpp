@@ -143,6 +143,22 @@ namespace Jazz2::Actors::Bosses
 		_stateTime -= timeMult;
 	}
 
+	void Bilsy::OnSaveSnapshot(Stream& dest)
+	{
+		BossBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<std::int32_t>(_state);
+		dest.WriteValue<float>(_stateTime);
+	}
+
+	void Bilsy::OnRestoreSnapshot(Stream& src)
+	{
+		BossBase::OnRestoreSnapshot(src);
+
+		_state = src.ReadValue<std::int32_t>();
+		_stateTime = src.ReadValue<float>();
+	}
+
 	void Bilsy::OnUpdateHitbox()
 	{
 		UpdateHitbox(20, 60);
@@ -261,6 +277,20 @@ namespace Jazz2::Actors::Bosses
 		// TODO: Spawn fire particles
 	}
 
+	void Bilsy::Fireball::OnSaveSnapshot(Stream& dest)
+	{
+		EnemyBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<float>(_timeLeft);
+	}
+
+	void Bilsy::Fireball::OnRestoreSnapshot(Stream& src)
+	{
+		EnemyBase::OnRestoreSnapshot(src);
+
+		_timeLeft = src.ReadValue<float>();
+	}
+
 	void Bilsy::Fireball::OnUpdateHitbox()
 	{
 		UpdateHitbox(18, 18);
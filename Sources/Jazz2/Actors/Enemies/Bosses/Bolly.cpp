@@ -182,6 +182,28 @@ namespace Jazz2::Actors::Bosses
 		_chainPhase += timeMult * 0.06f;
 	}
 
+	void Bolly::OnSaveSnapshot(Stream& dest)
+	{
+		BossBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<std::int32_t>(_state);
+		dest.WriteValue<float>(_stateTime);
+		dest.WriteValue<float>(_noiseCooldown);
+		dest.WriteValue<std::int32_t>(_rocketsLeft);
+		dest.WriteValue<float>(_chainPhase);
+	}
+
+	void Bolly::OnRestoreSnapshot(Stream& src)
+	{
+		BossBase::OnRestoreSnapshot(src);
+
+		_state = src.ReadValue<std::int32_t>();
+		_stateTime = src.ReadValue<float>();
+		_noiseCooldown = src.ReadValue<float>();
+		_rocketsLeft = src.ReadValue<std::int32_t>();
+		_chainPhase = src.ReadValue<float>();
+	}
+
 	bool Bolly::OnPerish(ActorBase* collider)
 	{
 		Explosion::Create(_levelHandler, Vector3i(std::int32_t(_pos.X), std::int32_t(_pos.Y), _renderer.layer() + 2), Explosion::Type::Large);
@@ -354,6 +376,20 @@ namespace Jazz2::Actors::Bosses
 		}
 	}
 
+	void Bolly::Rocket::OnSaveSnapshot(Stream& dest)
+	{
+		EnemyBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<float>(_timeLeft);
+	}
+
+	void Bolly::Rocket::OnRestoreSnapshot(Stream& src)
+	{
+		EnemyBase::OnRestoreSnapshot(src);
+
+		_timeLeft = src.ReadValue<float>();
+	}
+
 	void Bolly::Rocket::OnUpdateHitbox()
 	{
 		UpdateHitbox(20, 20);
@@ -155,6 +155,24 @@ namespace Jazz2::Actors::Bosses
 		_stateTime -= timeMult;
 	}
 
+	void Bubba::OnSaveSnapshot(Stream& dest)
+	{
+		BossBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<State>(_state);
+		dest.WriteValue<float>(_stateTime);
+		dest.WriteValue<float>(_tornadoCooldown);
+	}
+
+	void Bubba::OnRestoreSnapshot(Stream& src)
+	{
+		BossBase::OnRestoreSnapshot(src);
+
+		_state = src.ReadValue<State>();
+		_stateTime = src.ReadValue<float>();
+		_tornadoCooldown = src.ReadValue<float>();
+	}
+
 	void Bubba::OnUpdateHitbox()
 	{
 		UpdateHitbox(20, 24);
@@ -311,6 +329,20 @@ namespace Jazz2::Actors::Bosses
 		}
 	}
 
+	void Bubba::Fireball::OnSaveSnapshot(Stream& dest)
+	{
+		EnemyBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<float>(_timeLeft);
+	}
+
+	void Bubba::Fireball::OnRestoreSnapshot(Stream& src)
+	{
+		EnemyBase::OnRestoreSnapshot(src);
+
+		_timeLeft = src.ReadValue<float>();
+	}
+
 	void Bubba::Fireball::OnUpdateHitbox()
 	{
 		UpdateHitbox(18, 18);
@@ -26,6 +26,8 @@ namespace Jazz2::Actors::Bosses
 		Task<bool> OnActivatedAsync(const ActorActivationDetails& details) override;
 		bool OnActivatedBoss() override;
 		void OnUpdate(float timeMult) override;
+		void OnSaveSnapshot(Stream& dest) override;
+		void OnRestoreSnapshot(Stream& src) override;
 		void OnUpdateHitbox() override;
 		bool OnPerish(ActorBase* collider) override;
 		void OnHitWall(float timeMult) override;
@@ -50,6 +52,8 @@ namespace Jazz2::Actors::Bosses
 		protected:
 			Task<bool> OnActivatedAsync(const ActorActivationDetails& details) override;
 			void OnUpdate(float timeMult) override;
+			void OnSaveSnapshot(Stream& dest) override;
+			void OnRestoreSnapshot(Stream& src) override;
 			void OnUpdateHitbox() override;
 			void OnEmitLights(SmallVectorImpl<LightEmitter>& lights) override;
 			bool OnPerish(ActorBase* collider) override;
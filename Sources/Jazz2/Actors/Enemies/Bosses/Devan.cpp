@@ -275,6 +275,46 @@ namespace Jazz2::Actors::Bosses
 		_crouchCooldown -= timeMult;
 	}
 
+	void Devan::OnSaveSnapshot(Stream& dest)
+	{
+		BossBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<State>(_state);
+		dest.WriteValue<float>(_stateTime);
+		dest.WriteValue<float>(_attackTime);
+		dest.WriteValue<float>(_anglePhase);
+		dest.WriteValue<float>(_crouchCooldown);
+		dest.WriteValue<std::int32_t>(_shots);
+		dest.WriteValue<bool>(_isDemon);
+		dest.WriteValue<bool>(_isDead);
+		dest.WriteValue<float>(_lastPos.X);
+		dest.WriteValue<float>(_lastPos.Y);
+		dest.WriteValue<float>(_targetPos.X);
+		dest.WriteValue<float>(_targetPos.Y);
+		dest.WriteValue<float>(_lastSpeed.X);
+		dest.WriteValue<float>(_lastSpeed.Y);
+	}
+
+	void Devan::OnRestoreSnapshot(Stream& src)
+	{
+		BossBase::OnRestoreSnapshot(src);
+
+		_state = src.ReadValue<State>();
+		_stateTime = src.ReadValue<float>();
+		_attackTime = src.ReadValue<float>();
+		_anglePhase = src.ReadValue<float>();
+		_crouchCooldown = src.ReadValue<float>();
+		_shots = src.ReadValue<std::int32_t>();
+		_isDemon = src.ReadValue<bool>();
+		_isDead = src.ReadValue<bool>();
+		_lastPos.X = src.ReadValue<float>();
+		_lastPos.Y = src.ReadValue<float>();
+		_targetPos.X = src.ReadValue<float>();
+		_targetPos.Y = src.ReadValue<float>();
+		_lastSpeed.X = src.ReadValue<float>();
+		_lastSpeed.Y = src.ReadValue<float>();
+	}
+
 	void Devan::OnUpdateHitbox()
 	{
 		BossBase::OnUpdateHitbox();
@@ -503,6 +543,20 @@ namespace Jazz2::Actors::Bosses
 		}
 	}
 
+	void Devan::DisarmedGun::OnSaveSnapshot(Stream& dest)
+	{
+		ActorBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<float>(_timeLeft);
+	}
+
+	void Devan::DisarmedGun::OnRestoreSnapshot(Stream& src)
+	{
+		ActorBase::OnRestoreSnapshot(src);
+
+		_timeLeft = src.ReadValue<float>();
+	}
+
 	void Devan::DisarmedGun::OnUpdateHitbox()
 	{
 	}
@@ -516,7 +570,7 @@ namespace Jazz2::Actors::Bosses
 		SetFacingLeft(details.Params[0] != 0);
 		_speed.X = (IsFacingLeft() ? -8.0f : 8.0f);
 
-		SetState(ActorState::IsInvulnerable, true);
+		SetState(ActorState::IsInvulnerable | ActorState::ParallelPhysics, true);
 		SetState(ActorState::CanBeFrozen | ActorState::ApplyGravitation, false);
 		CanCollideWithShots = false;
 
@@ -579,7 +633,7 @@ namespace Jazz2::Actors::Bosses
 		_speed.Y = 3.5f;
 		_timeLeft = 50.0f;
 
-		SetState(ActorState::IsInvulnerable, true);
+		SetState(ActorState::IsInvulnerable | ActorState::ParallelPhysics, true);
 		SetState(ActorState::CanBeFrozen | ActorState::ApplyGravitation, false);
 
 		_health = INT32_MAX;
@@ -628,4 +682,18 @@ namespace Jazz2::Actors::Bosses
 	{
 		DecreaseHealth(INT32_MAX);
 	}
+
+	void Devan::Fireball::OnSaveSnapshot(Stream& dest)
+	{
+		EnemyBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<float>(_timeLeft);
+	}
+
+	void Devan::Fireball::OnRestoreSnapshot(Stream& src)
+	{
+		EnemyBase::OnRestoreSnapshot(src);
+
+		_timeLeft = src.ReadValue<float>();
+	}
 }
\ No newline at end of file
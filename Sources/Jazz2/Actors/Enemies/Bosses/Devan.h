@@ -27,6 +27,8 @@ namespace Jazz2::Actors::Bosses
 		Task<bool> OnActivatedAsync(const ActorActivationDetails& details) override;
 		bool OnActivatedBoss() override;
 		void OnUpdate(float timeMult) override;
+		void OnSaveSnapshot(Stream& dest) override;
+		void OnRestoreSnapshot(Stream& src) override;
 		void OnUpdateHitbox() override;
 		bool OnPerish(ActorBase* collider) override;
 
@@ -54,6 +56,8 @@ namespace Jazz2::Actors::Bosses
 		protected:
 			Task<bool> OnActivatedAsync(const ActorActivationDetails& details) override;
 			void OnUpdate(float timeMult) override;
+			void OnSaveSnapshot(Stream& dest) override;
+			void OnRestoreSnapshot(Stream& src) override;
 			void OnUpdateHitbox() override;
 
 		private:
@@ -88,6 +92,8 @@ namespace Jazz2::Actors::Bosses
 			void OnHitFloor(float timeMult) override;
 			void OnHitWall(float timeMult) override;
 			void OnHitCeiling(float timeMult) override;
+			void OnSaveSnapshot(Stream& dest) override;
+			void OnRestoreSnapshot(Stream& src) override;
 
 		private:
 			float _timeLeft;
@@ -97,4 +97,28 @@ namespace Jazz2::Actors::Bosses
 			}
 		}
 	}
+
+	void DevanRemote::OnSaveSnapshot(Stream& dest)
+	{
+		BossBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<std::uintptr_t>(reinterpret_cast<std::uintptr_t>(_robot.get()));
+	}
+
+	void DevanRemote::OnRestoreSnapshot(Stream& src)
+	{
+		BossBase::OnRestoreSnapshot(src);
+
+		// The robot is looked up among restored actors, it may no longer exist if it was already destroyed
+		Robot* robot = reinterpret_cast<Robot*>(src.ReadValue<std::uintptr_t>());
+		_robot = nullptr;
+		if (robot != nullptr) {
+			for (auto& actor : _levelHandler->GetActors()) {
+				if (actor.get() == robot) {
+					_robot = std::static_pointer_cast<Robot>(actor);
+					break;
+				}
+			}
+		}
+	}
 }
\ No newline at end of file
@@ -29,6 +29,8 @@ namespace Jazz2::Actors::Bosses
 		bool OnActivatedBoss() override;
 		bool OnPlayerDied() override;
 		void OnUpdate(float timeMult) override;
+		void OnSaveSnapshot(Stream& dest) override;
+		void OnRestoreSnapshot(Stream& src) override;
 
 	private:
 		std::uint8_t _introText, _endText;
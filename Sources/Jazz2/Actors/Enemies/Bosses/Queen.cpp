@@ -243,6 +243,28 @@ namespace Jazz2::Actors::Bosses
 		_stateTime -= timeMult;
 	}
 
+	void Queen::OnSaveSnapshot(Stream& dest)
+	{
+		BossBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<std::int32_t>(_state);
+		dest.WriteValue<float>(_stateTime);
+		dest.WriteValue<std::int32_t>(_lastHealth);
+		dest.WriteValue<bool>(_queuedBackstep);
+		dest.WriteValue<float>(_stepSize);
+	}
+
+	void Queen::OnRestoreSnapshot(Stream& src)
+	{
+		BossBase::OnRestoreSnapshot(src);
+
+		_state = src.ReadValue<std::int32_t>();
+		_stateTime = src.ReadValue<float>();
+		_lastHealth = src.ReadValue<std::int32_t>();
+		_queuedBackstep = src.ReadValue<bool>();
+		_stepSize = src.ReadValue<float>();
+	}
+
 	bool Queen::OnHandleCollision(ActorBase* other)
 	{
 		if (auto* spring = runtime_cast<Environment::Spring>(other)) {
@@ -281,7 +303,7 @@ namespace Jazz2::Actors::Bosses
 	{
 		_timeLeft = 50.0f;
 
-		SetState(ActorState::IsInvulnerable | ActorState::SkipPerPixelCollisions, true);
+		SetState(ActorState::IsInvulnerable | ActorState::SkipPerPixelCollisions | ActorState::ParallelPhysics, true);
 		SetState(ActorState::CollideWithTileset, false);
 
 		async_await RequestMetadataAsync("Boss/Queen"_s);
@@ -303,6 +325,20 @@ namespace Jazz2::Actors::Bosses
 		}
 	}
 
+	void Queen::Brick::OnSaveSnapshot(Stream& dest)
+	{
+		EnemyBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<float>(_timeLeft);
+	}
+
+	void Queen::Brick::OnRestoreSnapshot(Stream& src)
+	{
+		EnemyBase::OnRestoreSnapshot(src);
+
+		_timeLeft = src.ReadValue<float>();
+	}
+
 	bool Queen::Brick::OnPerish(ActorBase* collider)
 	{
 		if (collider != nullptr) {
@@ -29,6 +29,8 @@ namespace Jazz2::Actors::Bosses
 		Task<bool> OnActivatedAsync(const ActorActivationDetails& details) override;
 		bool OnActivatedBoss() override;
 		void OnUpdate(float timeMult) override;
+		void OnSaveSnapshot(Stream& dest) override;
+		void OnRestoreSnapshot(Stream& src) override;
 
 	private:
 		static constexpr std::int32_t StateTransition = -1;
@@ -46,6 +48,8 @@ namespace Jazz2::Actors::Bosses
 		protected:
 			Task<bool> OnActivatedAsync(const ActorActivationDetails& details) override;
 			void OnUpdate(float timeMult) override;
+			void OnSaveSnapshot(Stream& dest) override;
+			void OnRestoreSnapshot(Stream& src) override;
 			bool OnPerish(ActorBase* collider) override;
 
 		private:
@@ -109,6 +109,24 @@ namespace Jazz2::Actors::Bosses
 		_stateTime -= timeMult;
 	}
 
+	void Robot::OnSaveSnapshot(Stream& dest)
+	{
+		EnemyBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<std::int32_t>(_state);
+		dest.WriteValue<float>(_stateTime);
+		dest.WriteValue<std::int32_t>(_shots);
+	}
+
+	void Robot::OnRestoreSnapshot(Stream& src)
+	{
+		EnemyBase::OnRestoreSnapshot(src);
+
+		_state = src.ReadValue<std::int32_t>();
+		_stateTime = src.ReadValue<float>();
+		_shots = src.ReadValue<std::int32_t>();
+	}
+
 	void Robot::OnHealthChanged(ActorBase* collider)
 	{
 		EnemyBase::OnHealthChanged(collider);
@@ -117,6 +117,24 @@ namespace Jazz2::Actors::Bosses
 		_stateTime -= timeMult;
 	}
 
+	void TurtleBoss::OnSaveSnapshot(Stream& dest)
+	{
+		BossBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<std::int32_t>(_state);
+		dest.WriteValue<float>(_stateTime);
+		dest.WriteValue<float>(_maceTime);
+	}
+
+	void TurtleBoss::OnRestoreSnapshot(Stream& src)
+	{
+		BossBase::OnRestoreSnapshot(src);
+
+		_state = src.ReadValue<std::int32_t>();
+		_stateTime = src.ReadValue<float>();
+		_maceTime = src.ReadValue<float>();
+	}
+
 	bool TurtleBoss::OnHandleCollision(ActorBase* other)
 	{
 		if (_state == StateAttacking && _stateTime <= 0.0f) {
@@ -266,6 +284,30 @@ namespace Jazz2::Actors::Bosses
 		}
 	}
 
+	void TurtleBoss::Mace::OnSaveSnapshot(Stream& dest)
+	{
+		EnemyBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<float>(_targetPos.X);
+		dest.WriteValue<float>(_targetPos.Y);
+		dest.WriteValue<bool>(_returning);
+		dest.WriteValue<float>(_returnTime);
+		dest.WriteValue<float>(_targetSpeed.X);
+		dest.WriteValue<float>(_targetSpeed.Y);
+	}
+
+	void TurtleBoss::Mace::OnRestoreSnapshot(Stream& src)
+	{
+		EnemyBase::OnRestoreSnapshot(src);
+
+		_targetPos.X = src.ReadValue<float>();
+		_targetPos.Y = src.ReadValue<float>();
+		_returning = src.ReadValue<bool>();
+		_returnTime = src.ReadValue<float>();
+		_targetSpeed.X = src.ReadValue<float>();
+		_targetSpeed.Y = src.ReadValue<float>();
+	}
+
 	void TurtleBoss::Mace::OnUpdateHitbox()
 	{
 		UpdateHitbox(18, 18);
@@ -168,6 +168,32 @@ namespace Jazz2::Actors::Bosses
 		OnUpdateHitbox();
 	}
 
+	void Uterus::OnSaveSnapshot(Stream& dest)
+	{
+		BossBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<std::int32_t>(_state);
+		dest.WriteValue<float>(_stateTime);
+		dest.WriteValue<float>(_lastPos.X);
+		dest.WriteValue<float>(_lastPos.Y);
+		dest.WriteValue<float>(_spawnCrabTime);
+		dest.WriteValue<float>(_anglePhase);
+		dest.WriteValue<bool>(_hasShield);
+	}
+
+	void Uterus::OnRestoreSnapshot(Stream& src)
+	{
+		BossBase::OnRestoreSnapshot(src);
+
+		_state = src.ReadValue<std::int32_t>();
+		_stateTime = src.ReadValue<float>();
+		_lastPos.X = src.ReadValue<float>();
+		_lastPos.Y = src.ReadValue<float>();
+		_spawnCrabTime = src.ReadValue<float>();
+		_anglePhase = src.ReadValue<float>();
+		_hasShield = src.ReadValue<bool>();
+	}
+
 	void Uterus::OnUpdateHitbox()
 	{
 		UpdateHitbox(38, 60);
@@ -249,6 +275,22 @@ namespace Jazz2::Actors::Bosses
 		}
 	}
 
+	void Uterus::ShieldPart::OnSaveSnapshot(Stream& dest)
+	{
+		EnemyBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<float>(Phase);
+		dest.WriteValue<float>(FallTime);
+	}
+
+	void Uterus::ShieldPart::OnRestoreSnapshot(Stream& src)
+	{
+		EnemyBase::OnRestoreSnapshot(src);
+
+		Phase = src.ReadValue<float>();
+		FallTime = src.ReadValue<float>();
+	}
+
 	void Uterus::ShieldPart::OnUpdateHitbox()
 	{
 		UpdateHitbox(6, 6);
@@ -86,6 +86,24 @@ namespace Jazz2::Actors::Enemies
 		}
 	}
 
+	void Caterpillar::OnSaveSnapshot(Stream& dest)
+	{
+		EnemyBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<std::int32_t>(_state);
+		dest.WriteValue<std::int32_t>(_smokesLeft);
+		dest.WriteValue<float>(_attackTime);
+	}
+
+	void Caterpillar::OnRestoreSnapshot(Stream& src)
+	{
+		EnemyBase::OnRestoreSnapshot(src);
+
+		_state = src.ReadValue<std::int32_t>();
+		_smokesLeft = src.ReadValue<std::int32_t>();
+		_attackTime = src.ReadValue<float>();
+	}
+
 	bool Caterpillar::OnHandleCollision(ActorBase* other)
 	{
 		if (auto* shotBase = runtime_cast<Weapons::ShotBase>(other)) {
@@ -146,6 +164,24 @@ namespace Jazz2::Actors::Enemies
 		}
 	}
 
+	void Caterpillar::Smoke::OnSaveSnapshot(Stream& dest)
+	{
+		EnemyBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<float>(_time);
+		dest.WriteValue<float>(_baseSpeed.X);
+		dest.WriteValue<float>(_baseSpeed.Y);
+	}
+
+	void Caterpillar::Smoke::OnRestoreSnapshot(Stream& src)
+	{
+		EnemyBase::OnRestoreSnapshot(src);
+
+		_time = src.ReadValue<float>();
+		_baseSpeed.X = src.ReadValue<float>();
+		_baseSpeed.Y = src.ReadValue<float>();
+	}
+
 	bool Caterpillar::Smoke::OnHandleCollision(ActorBase* other)
 	{
 		if (auto* player = runtime_cast<Player>(other)) {
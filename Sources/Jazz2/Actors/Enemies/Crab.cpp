@@ -83,6 +83,26 @@ namespace Jazz2::Actors::Enemies
 		}
 	}
 
+	void Crab::OnSaveSnapshot(Stream& dest)
+	{
+		EnemyBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<float>(_noiseCooldown);
+		dest.WriteValue<float>(_stepCooldown);
+		dest.WriteValue<bool>(_canJumpPrev);
+		dest.WriteValue<bool>(_stuck);
+	}
+
+	void Crab::OnRestoreSnapshot(Stream& src)
+	{
+		EnemyBase::OnRestoreSnapshot(src);
+
+		_noiseCooldown = src.ReadValue<float>();
+		_stepCooldown = src.ReadValue<float>();
+		_canJumpPrev = src.ReadValue<bool>();
+		_stuck = src.ReadValue<bool>();
+	}
+
 	void Crab::OnUpdateHitbox()
 	{
 		UpdateHitbox(26, 20);
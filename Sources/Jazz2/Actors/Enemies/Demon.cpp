@@ -105,6 +105,26 @@ namespace Jazz2::Actors::Enemies
 		_turnCooldown -= timeMult;
 	}
 
+	void Demon::OnSaveSnapshot(Stream& dest)
+	{
+		EnemyBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<float>(_attackTime);
+		dest.WriteValue<bool>(_attacking);
+		dest.WriteValue<bool>(_stuck);
+		dest.WriteValue<float>(_turnCooldown);
+	}
+
+	void Demon::OnRestoreSnapshot(Stream& src)
+	{
+		EnemyBase::OnRestoreSnapshot(src);
+
+		_attackTime = src.ReadValue<float>();
+		_attacking = src.ReadValue<bool>();
+		_stuck = src.ReadValue<bool>();
+		_turnCooldown = src.ReadValue<float>();
+	}
+
 	void Demon::OnUpdateHitbox()
 	{
 		UpdateHitbox(28, 26);
@@ -101,6 +101,26 @@ namespace Jazz2::Actors::Enemies
 		}
 	}
 
+	void Doggy::OnSaveSnapshot(Stream& dest)
+	{
+		EnemyBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<float>(_attackSpeed);
+		dest.WriteValue<float>(_attackTime);
+		dest.WriteValue<float>(_noiseCooldown);
+		dest.WriteValue<bool>(_stuck);
+	}
+
+	void Doggy::OnRestoreSnapshot(Stream& src)
+	{
+		EnemyBase::OnRestoreSnapshot(src);
+
+		_attackSpeed = src.ReadValue<float>();
+		_attackTime = src.ReadValue<float>();
+		_noiseCooldown = src.ReadValue<float>();
+		_stuck = src.ReadValue<bool>();
+	}
+
 	void Doggy::OnUpdateHitbox()
 	{
 		UpdateHitbox(50, 30);
@@ -118,6 +118,24 @@ namespace Jazz2::Actors::Enemies
 		}
 	}
 
+	void Dragon::OnSaveSnapshot(Stream& dest)
+	{
+		EnemyBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<bool>(_attacking);
+		dest.WriteValue<float>(_stateTime);
+		dest.WriteValue<float>(_attackTime);
+	}
+
+	void Dragon::OnRestoreSnapshot(Stream& src)
+	{
+		EnemyBase::OnRestoreSnapshot(src);
+
+		_attacking = src.ReadValue<bool>();
+		_stateTime = src.ReadValue<float>();
+		_attackTime = src.ReadValue<float>();
+	}
+
 	bool Dragon::OnPerish(ActorBase* collider)
 	{
 		CreateParticleDebrisOnPerish(collider);
@@ -162,6 +180,20 @@ namespace Jazz2::Actors::Enemies
 		}
 	}
 
+	void Dragon::Fire::OnSaveSnapshot(Stream& dest)
+	{
+		EnemyBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<float>(_timeLeft);
+	}
+
+	void Dragon::Fire::OnRestoreSnapshot(Stream& src)
+	{
+		EnemyBase::OnRestoreSnapshot(src);
+
+		_timeLeft = src.ReadValue<float>();
+	}
+
 	void Dragon::Fire::OnEmitLights(SmallVectorImpl<LightEmitter>& lights)
 	{
 		auto& light1 = lights.emplace_back();
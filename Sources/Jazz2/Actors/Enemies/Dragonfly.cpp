@@ -141,6 +141,28 @@ namespace Jazz2::Actors::Enemies
 		}
 	}
 
+	void Dragonfly::OnSaveSnapshot(Stream& dest)
+	{
+		EnemyBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<std::int32_t>(_state);
+		dest.WriteValue<float>(_idleTime);
+		dest.WriteValue<float>(_attackCooldown);
+		dest.WriteValue<float>(_direction.X);
+		dest.WriteValue<float>(_direction.Y);
+	}
+
+	void Dragonfly::OnRestoreSnapshot(Stream& src)
+	{
+		EnemyBase::OnRestoreSnapshot(src);
+
+		_state = src.ReadValue<std::int32_t>();
+		_idleTime = src.ReadValue<float>();
+		_attackCooldown = src.ReadValue<float>();
+		_direction.X = src.ReadValue<float>();
+		_direction.Y = src.ReadValue<float>();
+	}
+
 	void Dragonfly::OnHitWall(float timeMult)
 	{
 	}
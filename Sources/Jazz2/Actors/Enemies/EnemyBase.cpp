@@ -32,6 +32,24 @@ namespace Jazz2::Actors::Enemies
 		HandleBlinking(timeMult);
 	}
 
+	void EnemyBase::OnSaveSnapshot(Stream& dest)
+	{
+		ActorBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<bool>(CanCollideWithShots);
+		dest.WriteValue<bool>(_canHurtPlayer);
+		dest.WriteValue<float>(_blinkingTimeout);
+	}
+
+	void EnemyBase::OnRestoreSnapshot(Stream& src)
+	{
+		ActorBase::OnRestoreSnapshot(src);
+
+		CanCollideWithShots = src.ReadValue<bool>();
+		_canHurtPlayer = src.ReadValue<bool>();
+		_blinkingTimeout = src.ReadValue<float>();
+	}
+
 	void EnemyBase::AddScoreToCollider(ActorBase* collider)
 	{
 		if (_scoreValue > 0) {
@@ -82,6 +82,22 @@ namespace Jazz2::Actors::Enemies
 		}
 	}
 
+	void FatChick::OnSaveSnapshot(Stream& dest)
+	{
+		EnemyBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<bool>(_isAttacking);
+		dest.WriteValue<bool>(_stuck);
+	}
+
+	void FatChick::OnRestoreSnapshot(Stream& src)
+	{
+		EnemyBase::OnRestoreSnapshot(src);
+
+		_isAttacking = src.ReadValue<bool>();
+		_stuck = src.ReadValue<bool>();
+	}
+
 	void FatChick::OnUpdateHitbox()
 	{
 		UpdateHitbox(20, 24);
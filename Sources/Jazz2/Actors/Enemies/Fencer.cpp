@@ -65,6 +65,20 @@ namespace Jazz2::Actors::Enemies
 		EnemyBase::OnUpdate(timeMult);
 	}
 
+	void Fencer::OnSaveSnapshot(Stream& dest)
+	{
+		EnemyBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<float>(_stateTime);
+	}
+
+	void Fencer::OnRestoreSnapshot(Stream& src)
+	{
+		EnemyBase::OnRestoreSnapshot(src);
+
+		_stateTime = src.ReadValue<float>();
+	}
+
 	bool Fencer::OnPerish(ActorBase* collider)
 	{
 		CreateParticleDebrisOnPerish(collider);
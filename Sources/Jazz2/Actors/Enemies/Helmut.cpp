@@ -83,6 +83,26 @@ namespace Jazz2::Actors::Enemies
 		_turnCooldown -= timeMult;
 	}
 
+	void Helmut::OnSaveSnapshot(Stream& dest)
+	{
+		EnemyBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<bool>(_idling);
+		dest.WriteValue<float>(_stateTime);
+		dest.WriteValue<bool>(_stuck);
+		dest.WriteValue<float>(_turnCooldown);
+	}
+
+	void Helmut::OnRestoreSnapshot(Stream& src)
+	{
+		EnemyBase::OnRestoreSnapshot(src);
+
+		_idling = src.ReadValue<bool>();
+		_stateTime = src.ReadValue<float>();
+		_stuck = src.ReadValue<bool>();
+		_turnCooldown = src.ReadValue<float>();
+	}
+
 	void Helmut::OnUpdateHitbox()
 	{
 		UpdateHitbox(28, 26);
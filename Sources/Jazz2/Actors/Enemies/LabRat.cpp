@@ -55,6 +55,32 @@ namespace Jazz2::Actors::Enemies
 		_turnCooldown -= timeMult;
 	}
 
+	void LabRat::OnSaveSnapshot(Stream& dest)
+	{
+		EnemyBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<bool>(_isAttacking);
+		dest.WriteValue<bool>(_canAttack);
+		dest.WriteValue<bool>(_idling);
+		dest.WriteValue<bool>(_canIdle);
+		dest.WriteValue<float>(_stateTime);
+		dest.WriteValue<float>(_attackTime);
+		dest.WriteValue<float>(_turnCooldown);
+	}
+
+	void LabRat::OnRestoreSnapshot(Stream& src)
+	{
+		EnemyBase::OnRestoreSnapshot(src);
+
+		_isAttacking = src.ReadValue<bool>();
+		_canAttack = src.ReadValue<bool>();
+		_idling = src.ReadValue<bool>();
+		_canIdle = src.ReadValue<bool>();
+		_stateTime = src.ReadValue<float>();
+		_attackTime = src.ReadValue<float>();
+		_turnCooldown = src.ReadValue<float>();
+	}
+
 	void LabRat::OnUpdateHitbox()
 	{
 		UpdateHitbox(30, 30);
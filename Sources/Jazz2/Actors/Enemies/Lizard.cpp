@@ -109,6 +109,22 @@ namespace Jazz2::Actors::Enemies
 		}
 	}
 
+	void Lizard::OnSaveSnapshot(Stream& dest)
+	{
+		EnemyBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<bool>(_stuck);
+		dest.WriteValue<bool>(_isFalling);
+	}
+
+	void Lizard::OnRestoreSnapshot(Stream& src)
+	{
+		EnemyBase::OnRestoreSnapshot(src);
+
+		_stuck = src.ReadValue<bool>();
+		_isFalling = src.ReadValue<bool>();
+	}
+
 	void Lizard::OnUpdateHitbox()
 	{
 		UpdateHitbox(30, 30);
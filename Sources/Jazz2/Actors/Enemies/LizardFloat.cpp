@@ -155,6 +155,22 @@ namespace Jazz2::Actors::Enemies
 		_moveTime -= timeMult;
 	}
 
+	void LizardFloat::OnSaveSnapshot(Stream& dest)
+	{
+		EnemyBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<float>(_attackTime);
+		dest.WriteValue<float>(_moveTime);
+	}
+
+	void LizardFloat::OnRestoreSnapshot(Stream& src)
+	{
+		EnemyBase::OnRestoreSnapshot(src);
+
+		_attackTime = src.ReadValue<float>();
+		_moveTime = src.ReadValue<float>();
+	}
+
 	bool LizardFloat::OnPerish(ActorBase* collider)
 	{
 		if (_copter != nullptr) {
@@ -32,6 +32,8 @@ namespace Jazz2::Actors::Enemies
 		Task<bool> OnActivatedAsync(const ActorActivationDetails& details) override;
 		bool OnTileDeactivated() override;
 		void OnUpdate(float timeMult) override;
+		void OnSaveSnapshot(Stream& dest) override;
+		void OnRestoreSnapshot(Stream& src) override;
 		bool OnPerish(ActorBase* collider) override;
 
 	private:
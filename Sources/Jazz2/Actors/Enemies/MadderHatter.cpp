@@ -102,6 +102,22 @@ namespace Jazz2::Actors::Enemies
 		}
 	}
 
+	void MadderHatter::OnSaveSnapshot(Stream& dest)
+	{
+		EnemyBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<float>(_attackTime);
+		dest.WriteValue<bool>(_stuck);
+	}
+
+	void MadderHatter::OnRestoreSnapshot(Stream& src)
+	{
+		EnemyBase::OnRestoreSnapshot(src);
+
+		_attackTime = src.ReadValue<float>();
+		_stuck = src.ReadValue<bool>();
+	}
+
 	void MadderHatter::OnUpdateHitbox()
 	{
 		UpdateHitbox(30, 30);
@@ -165,6 +181,20 @@ namespace Jazz2::Actors::Enemies
 		_renderer.setRotation(angle);
 	}
 
+	void MadderHatter::BulletSpit::OnSaveSnapshot(Stream& dest)
+	{
+		EnemyBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<float>(_timeLeft);
+	}
+
+	void MadderHatter::BulletSpit::OnRestoreSnapshot(Stream& src)
+	{
+		EnemyBase::OnRestoreSnapshot(src);
+
+		_timeLeft = src.ReadValue<float>();
+	}
+
 	void MadderHatter::BulletSpit::OnUpdateHitbox()
 	{
 		UpdateHitbox(8, 8);
@@ -66,6 +66,22 @@ namespace Jazz2::Actors::Enemies
 		}
 	}
 
+	void Monkey::OnSaveSnapshot(Stream& dest)
+	{
+		EnemyBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<bool>(_isWalking);
+		dest.WriteValue<bool>(_stuck);
+	}
+
+	void Monkey::OnRestoreSnapshot(Stream& src)
+	{
+		EnemyBase::OnRestoreSnapshot(src);
+
+		_isWalking = src.ReadValue<bool>();
+		_stuck = src.ReadValue<bool>();
+	}
+
 	void Monkey::OnUpdateHitbox()
 	{
 		UpdateHitbox(30, 30);
@@ -91,6 +91,38 @@ namespace Jazz2::Actors::Enemies
 		MoveInstantly(_lastPos + Vector2f(cosf(_anglePhase) * 10.0f, sinf(_anglePhase * 2.0f) * 10.0f), MoveType::Absolute | MoveType::Force);
 	}
 
+	void Rapier::OnSaveSnapshot(Stream& dest)
+	{
+		EnemyBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<float>(_lastPos.X);
+		dest.WriteValue<float>(_lastPos.Y);
+		dest.WriteValue<float>(_targetPos.X);
+		dest.WriteValue<float>(_targetPos.Y);
+		dest.WriteValue<float>(_lastSpeed.X);
+		dest.WriteValue<float>(_lastSpeed.Y);
+		dest.WriteValue<float>(_anglePhase);
+		dest.WriteValue<float>(_attackTime);
+		dest.WriteValue<bool>(_attacking);
+		dest.WriteValue<float>(_noiseCooldown);
+	}
+
+	void Rapier::OnRestoreSnapshot(Stream& src)
+	{
+		EnemyBase::OnRestoreSnapshot(src);
+
+		_lastPos.X = src.ReadValue<float>();
+		_lastPos.Y = src.ReadValue<float>();
+		_targetPos.X = src.ReadValue<float>();
+		_targetPos.Y = src.ReadValue<float>();
+		_lastSpeed.X = src.ReadValue<float>();
+		_lastSpeed.Y = src.ReadValue<float>();
+		_anglePhase = src.ReadValue<float>();
+		_attackTime = src.ReadValue<float>();
+		_attacking = src.ReadValue<bool>();
+		_noiseCooldown = src.ReadValue<float>();
+	}
+
 	bool Rapier::OnPerish(ActorBase* collider)
 	{
 		CreateParticleDebrisOnPerish(ParticleDebrisEffect::Dissolve, Vector2f::Zero);
@@ -84,6 +84,36 @@ namespace Jazz2::Actors::Enemies
 		MoveInstantly(_lastPos + Vector2f(0.0f, sinf(_anglePhase) * 6.0f), MoveType::Absolute | MoveType::Force);
 	}
 
+	void Raven::OnSaveSnapshot(Stream& dest)
+	{
+		EnemyBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<float>(_lastPos.X);
+		dest.WriteValue<float>(_lastPos.Y);
+		dest.WriteValue<float>(_targetPos.X);
+		dest.WriteValue<float>(_targetPos.Y);
+		dest.WriteValue<float>(_lastSpeed.X);
+		dest.WriteValue<float>(_lastSpeed.Y);
+		dest.WriteValue<float>(_anglePhase);
+		dest.WriteValue<float>(_attackTime);
+		dest.WriteValue<bool>(_attacking);
+	}
+
+	void Raven::OnRestoreSnapshot(Stream& src)
+	{
+		EnemyBase::OnRestoreSnapshot(src);
+
+		_lastPos.X = src.ReadValue<float>();
+		_lastPos.Y = src.ReadValue<float>();
+		_targetPos.X = src.ReadValue<float>();
+		_targetPos.Y = src.ReadValue<float>();
+		_lastSpeed.X = src.ReadValue<float>();
+		_lastSpeed.Y = src.ReadValue<float>();
+		_anglePhase = src.ReadValue<float>();
+		_attackTime = src.ReadValue<float>();
+		_attacking = src.ReadValue<bool>();
+	}
+
 	bool Raven::OnPerish(ActorBase* collider)
 	{
 		CreateParticleDebrisOnPerish(collider);
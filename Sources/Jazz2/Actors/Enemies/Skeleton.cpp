@@ -57,6 +57,20 @@ namespace Jazz2::Actors::Enemies
 		}
 	}
 
+	void Skeleton::OnSaveSnapshot(Stream& dest)
+	{
+		EnemyBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<bool>(_stuck);
+	}
+
+	void Skeleton::OnRestoreSnapshot(Stream& src)
+	{
+		EnemyBase::OnRestoreSnapshot(src);
+
+		_stuck = src.ReadValue<bool>();
+	}
+
 	void Skeleton::OnUpdateHitbox()
 	{
 		UpdateHitbox(30, 30);
@@ -102,6 +102,24 @@ namespace Jazz2::Actors::Enemies
 		}
 	}
 
+	void Sucker::OnSaveSnapshot(Stream& dest)
+	{
+		EnemyBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<std::int32_t>(_cycle);
+		dest.WriteValue<float>(_cycleTimer);
+		dest.WriteValue<bool>(_stuck);
+	}
+
+	void Sucker::OnRestoreSnapshot(Stream& src)
+	{
+		EnemyBase::OnRestoreSnapshot(src);
+
+		_cycle = src.ReadValue<std::int32_t>();
+		_cycleTimer = src.ReadValue<float>();
+		_stuck = src.ReadValue<bool>();
+	}
+
 	bool Sucker::OnPerish(ActorBase* collider)
 	{
 		CreateParticleDebrisOnPerish(collider);
@@ -49,6 +49,20 @@ namespace Jazz2::Actors::Enemies
 		EnemyBase::OnUpdate(timeMult);
 	}
 
+	void SuckerFloat::OnSaveSnapshot(Stream& dest)
+	{
+		EnemyBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<float>(_phase);
+	}
+
+	void SuckerFloat::OnRestoreSnapshot(Stream& src)
+	{
+		EnemyBase::OnRestoreSnapshot(src);
+
+		_phase = src.ReadValue<float>();
+	}
+
 	bool SuckerFloat::OnPerish(ActorBase* collider)
 	{
 		bool shouldDestroy = (_frozenTimeLeft > 0.0f);
@@ -129,6 +129,28 @@ namespace Jazz2::Actors::Enemies
 		}
 	}
 
+	void Turtle::OnSaveSnapshot(Stream& dest)
+	{
+		EnemyBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<bool>(_isAttacking);
+		dest.WriteValue<bool>(_isTurning);
+		dest.WriteValue<bool>(_isWithdrawn);
+		dest.WriteValue<bool>(_isDodging);
+		dest.WriteValue<float>(_dodgeCooldown);
+	}
+
+	void Turtle::OnRestoreSnapshot(Stream& src)
+	{
+		EnemyBase::OnRestoreSnapshot(src);
+
+		_isAttacking = src.ReadValue<bool>();
+		_isTurning = src.ReadValue<bool>();
+		_isWithdrawn = src.ReadValue<bool>();
+		_isDodging = src.ReadValue<bool>();
+		_dodgeCooldown = src.ReadValue<float>();
+	}
+
 	void Turtle::OnUpdateHitbox()
 	{
 		UpdateHitbox(24, 24);
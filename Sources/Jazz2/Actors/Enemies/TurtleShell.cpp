@@ -104,6 +104,20 @@ namespace Jazz2::Actors::Enemies
 		}
 	}
 
+	void TurtleShell::OnSaveSnapshot(Stream& dest)
+	{
+		EnemyBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<float>(_lastAngle);
+	}
+
+	void TurtleShell::OnRestoreSnapshot(Stream& src)
+	{
+		EnemyBase::OnRestoreSnapshot(src);
+
+		_lastAngle = src.ReadValue<float>();
+	}
+
 	void TurtleShell::OnUpdateHitbox()
 	{
 		UpdateHitbox(30, 16);
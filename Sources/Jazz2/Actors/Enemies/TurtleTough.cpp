@@ -61,6 +61,20 @@ namespace Jazz2::Actors::Enemies
 		}
 	}
 
+	void TurtleTough::OnSaveSnapshot(Stream& dest)
+	{
+		EnemyBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<bool>(_stuck);
+	}
+
+	void TurtleTough::OnRestoreSnapshot(Stream& src)
+	{
+		EnemyBase::OnRestoreSnapshot(src);
+
+		_stuck = src.ReadValue<bool>();
+	}
+
 	void TurtleTough::OnUpdateHitbox()
 	{
 		UpdateHitbox(30, 40);
@@ -72,6 +72,22 @@ namespace Jazz2::Actors::Enemies
 		}
 	}
 
+	void TurtleTube::OnSaveSnapshot(Stream& dest)
+	{
+		EnemyBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<bool>(_onWater);
+		dest.WriteValue<float>(_phase);
+	}
+
+	void TurtleTube::OnRestoreSnapshot(Stream& src)
+	{
+		EnemyBase::OnRestoreSnapshot(src);
+
+		_onWater = src.ReadValue<bool>();
+		_phase = src.ReadValue<float>();
+	}
+
 	bool TurtleTube::OnPerish(ActorBase* collider)
 	{
 		CreateParticleDebrisOnPerish(collider);
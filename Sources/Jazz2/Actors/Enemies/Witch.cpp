@@ -103,6 +103,22 @@ namespace Jazz2::Actors::Enemies
 		_speed.Y = 0.0f;
 	}
 
+	void Witch::OnSaveSnapshot(Stream& dest)
+	{
+		EnemyBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<float>(_attackTime);
+		dest.WriteValue<bool>(_playerHit);
+	}
+
+	void Witch::OnRestoreSnapshot(Stream& src)
+	{
+		EnemyBase::OnRestoreSnapshot(src);
+
+		_attackTime = src.ReadValue<float>();
+		_playerHit = src.ReadValue<bool>();
+	}
+
 	void Witch::OnUpdateHitbox()
 	{
 		UpdateHitbox(30, 30);
@@ -167,6 +183,20 @@ namespace Jazz2::Actors::Enemies
 		}
 	}
 
+	void Witch::MagicBullet::OnSaveSnapshot(Stream& dest)
+	{
+		ActorBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<float>(_time);
+	}
+
+	void Witch::MagicBullet::OnRestoreSnapshot(Stream& src)
+	{
+		ActorBase::OnRestoreSnapshot(src);
+
+		_time = src.ReadValue<float>();
+	}
+
 	void Witch::MagicBullet::OnUpdateHitbox()
 	{
 		UpdateHitbox(10, 10);
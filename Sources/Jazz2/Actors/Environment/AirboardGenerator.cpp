@@ -36,6 +36,22 @@ namespace Jazz2::Actors::Environment
 		}
 	}
 
+	void AirboardGenerator::OnSaveSnapshot(Stream& dest)
+	{
+		ActorBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<float>(_timeLeft);
+		dest.WriteValue<bool>(_active);
+	}
+
+	void AirboardGenerator::OnRestoreSnapshot(Stream& src)
+	{
+		ActorBase::OnRestoreSnapshot(src);
+
+		_timeLeft = src.ReadValue<float>();
+		_active = src.ReadValue<bool>();
+	}
+
 	bool AirboardGenerator::OnHandleCollision(ActorBase* other)
 	{
 		if (auto* player = runtime_cast<Player>(other)) {
@@ -27,6 +27,8 @@ namespace Jazz2::Actors::Environment
 	protected:
 		Task<bool> OnActivatedAsync(const ActorActivationDetails& details) override;
 		void OnUpdate(float timeMult) override;
+		void OnSaveSnapshot(Stream& dest) override;
+		void OnRestoreSnapshot(Stream& src) override;
 
 	private:
 		std::uint8_t _delay;
@@ -45,6 +45,24 @@ namespace Jazz2::Actors::Environment
 		}
 	}
 
+	void AmbientBubbles::OnSaveSnapshot(Stream& dest)
+	{
+		ActorBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<float>(_cooldown);
+		dest.WriteValue<std::int32_t>(_bubblesLeft);
+		dest.WriteValue<float>(_delay);
+	}
+
+	void AmbientBubbles::OnRestoreSnapshot(Stream& src)
+	{
+		ActorBase::OnRestoreSnapshot(src);
+
+		_cooldown = src.ReadValue<float>();
+		_bubblesLeft = src.ReadValue<std::int32_t>();
+		_delay = src.ReadValue<float>();
+	}
+
 	void AmbientBubbles::SpawnBubbles(std::int32_t count)
 	{
 		if (count <= 0) {
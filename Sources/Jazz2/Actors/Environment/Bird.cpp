@@ -110,6 +110,24 @@ namespace Jazz2::Actors::Environment
 		}
 	}
 
+	void Bird::OnSaveSnapshot(Stream& dest)
+	{
+		ActorBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<std::uintptr_t>(reinterpret_cast<std::uintptr_t>(_owner));
+		dest.WriteValue<float>(_fireCooldown);
+		dest.WriteValue<float>(_attackTime);
+	}
+
+	void Bird::OnRestoreSnapshot(Stream& src)
+	{
+		ActorBase::OnRestoreSnapshot(src);
+
+		_owner = reinterpret_cast<Player*>(src.ReadValue<std::uintptr_t>());
+		_fireCooldown = src.ReadValue<float>();
+		_attackTime = src.ReadValue<float>();
+	}
+
 	void Bird::OnAnimationFinished()
 	{
 		ActorBase::OnAnimationFinished();
@@ -109,4 +109,18 @@ namespace Jazz2::Actors::Environment
 		}
 		return true;
 	}
+
+	void BirdCage::OnSaveSnapshot(Stream& dest)
+	{
+		SolidObjectBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<bool>(_activated);
+	}
+
+	void BirdCage::OnRestoreSnapshot(Stream& src)
+	{
+		SolidObjectBase::OnRestoreSnapshot(src);
+
+		_activated = src.ReadValue<bool>();
+	}
 }
\ No newline at end of file
@@ -30,6 +30,8 @@ namespace Jazz2::Actors::Environment
 		_health = INT32_MAX;
 		_elasticity = 0.3f;
 
+		SetState(ActorState::ParallelPhysics, true);
+
 		switch (theme) {
 			case 0: async_await RequestMetadataAsync("Object/Bomb"_s); break;
 			case 1: async_await RequestMetadataAsync("Enemy/LizardFloat"_s); break;
@@ -55,6 +57,20 @@ namespace Jazz2::Actors::Environment
 		}
 	}
 
+	void Bomb::OnSaveSnapshot(Stream& dest)
+	{
+		ActorBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<float>(_timeLeft);
+	}
+
+	void Bomb::OnRestoreSnapshot(Stream& src)
+	{
+		ActorBase::OnRestoreSnapshot(src);
+
+		_timeLeft = src.ReadValue<float>();
+	}
+
 	void Bomb::OnUpdateHitbox()
 	{
 		UpdateHitbox(6, 6);
@@ -89,4 +89,18 @@ namespace Jazz2::Actors::Environment
 
 		return false;
 	}
+
+	void Checkpoint::OnSaveSnapshot(Stream& dest)
+	{
+		ActorBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<bool>(_activated);
+	}
+
+	void Checkpoint::OnRestoreSnapshot(Stream& src)
+	{
+		ActorBase::OnRestoreSnapshot(src);
+
+		_activated = src.ReadValue<bool>();
+	}
 }
\ No newline at end of file
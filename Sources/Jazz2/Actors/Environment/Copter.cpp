@@ -70,6 +70,22 @@ namespace Jazz2::Actors::Environment
 #endif
 	}
 
+	void Copter::OnSaveSnapshot(Stream& dest)
+	{
+		ActorBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<float>(_phase);
+		dest.WriteValue<State>(_state);
+	}
+
+	void Copter::OnRestoreSnapshot(Stream& src)
+	{
+		ActorBase::OnRestoreSnapshot(src);
+
+		_phase = src.ReadValue<float>();
+		_state = src.ReadValue<State>();
+	}
+
 	void Copter::OnDetach(ActorBase* parent)
 	{
 		DecreaseHealth(INT32_MAX);
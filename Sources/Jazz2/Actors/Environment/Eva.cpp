@@ -36,6 +36,20 @@ namespace Jazz2::Actors::Environment
 		}
 	}
 
+	void Eva::OnSaveSnapshot(Stream& dest)
+	{
+		ActorBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<float>(_animationTime);
+	}
+
+	void Eva::OnRestoreSnapshot(Stream& src)
+	{
+		ActorBase::OnRestoreSnapshot(src);
+
+		_animationTime = src.ReadValue<float>();
+	}
+
 	bool Eva::OnHandleCollision(ActorBase* other)
 	{
 		if (auto* player = runtime_cast<Player>(other)) {
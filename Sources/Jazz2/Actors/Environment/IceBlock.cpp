@@ -72,6 +72,20 @@ namespace Jazz2::Actors::Environment
 		}
 	}
 
+	void IceBlock::OnSaveSnapshot(Stream& dest)
+	{
+		ActorBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<float>(_timeLeft);
+	}
+
+	void IceBlock::OnRestoreSnapshot(Stream& src)
+	{
+		ActorBase::OnRestoreSnapshot(src);
+
+		_timeLeft = src.ReadValue<float>();
+	}
+
 	void IceBlock::ResetTimeLeft()
 	{
 		if (_timeLeft > 0.0f) {
@@ -54,6 +54,22 @@ namespace Jazz2::Actors::Environment
 		}
 	}
 
+	void Moth::OnSaveSnapshot(Stream& dest)
+	{
+		ActorBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<float>(_timer);
+		dest.WriteValue<std::int32_t>(_direction);
+	}
+
+	void Moth::OnRestoreSnapshot(Stream& src)
+	{
+		ActorBase::OnRestoreSnapshot(src);
+
+		_timer = src.ReadValue<float>();
+		_direction = src.ReadValue<std::int32_t>();
+	}
+
 	bool Moth::OnHandleCollision(ActorBase* other)
 	{
 		if (auto* player = runtime_cast<Player>(other)) {
@@ -128,6 +128,24 @@ namespace Jazz2::Actors::Environment
 		}
 	}
 
+	void RollingRock::OnSaveSnapshot(Stream& dest)
+	{
+		EnemyBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<float>(_delayLeft);
+		dest.WriteValue<bool>(_triggered);
+		dest.WriteValue<float>(_soundCooldown);
+	}
+
+	void RollingRock::OnRestoreSnapshot(Stream& src)
+	{
+		EnemyBase::OnRestoreSnapshot(src);
+
+		_delayLeft = src.ReadValue<float>();
+		_triggered = src.ReadValue<bool>();
+		_soundCooldown = src.ReadValue<float>();
+	}
+
 	void RollingRock::OnUpdateHitbox()
 	{
 		UpdateHitbox(50, 50);
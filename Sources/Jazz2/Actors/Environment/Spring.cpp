@@ -152,6 +152,22 @@ namespace Jazz2::Actors::Environment
 		}
 	}
 
+	void Spring::OnSaveSnapshot(Stream& dest)
+	{
+		ActorBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<State>(_state);
+		dest.WriteValue<float>(_cooldown);
+	}
+
+	void Spring::OnRestoreSnapshot(Stream& src)
+	{
+		ActorBase::OnRestoreSnapshot(src);
+
+		_state = src.ReadValue<State>();
+		_cooldown = src.ReadValue<float>();
+	}
+
 	void Spring::OnUpdateHitbox()
 	{
 		switch (_orientation) {
@@ -58,6 +58,20 @@ namespace Jazz2::Actors::Environment
 		}
 	}
 
+	void SteamNote::OnSaveSnapshot(Stream& dest)
+	{
+		ActorBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<float>(_cooldown);
+	}
+
+	void SteamNote::OnRestoreSnapshot(Stream& src)
+	{
+		ActorBase::OnRestoreSnapshot(src);
+
+		_cooldown = src.ReadValue<float>();
+	}
+
 	void SteamNote::OnUpdateHitbox()
 	{
 		UpdateHitbox(6, 6);
@@ -15,6 +15,11 @@ namespace Jazz2::Actors::Environment
 
 	SwingingVine::~SwingingVine()
 	{
+		// Actors that were never activated don't belong to any level
+		if (_levelHandler == nullptr) {
+			return;
+		}
+
 		auto players = _levelHandler->GetPlayers();
 		for (auto* player : players) {
 			player->CancelCarryingObject(this);
@@ -105,6 +110,20 @@ namespace Jazz2::Actors::Environment
 		SetState(ActorState::IsDirty, true);
 	}
 
+	void SwingingVine::OnSaveSnapshot(Stream& dest)
+	{
+		ActorBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<bool>(_justTurned);
+	}
+
+	void SwingingVine::OnRestoreSnapshot(Stream& src)
+	{
+		ActorBase::OnRestoreSnapshot(src);
+
+		_justTurned = src.ReadValue<bool>();
+	}
+
 	void SwingingVine::OnUpdateHitbox()
 	{
 	}
@@ -143,6 +143,28 @@ namespace Jazz2::Actors
 		}
 	}
 
+	void Explosion::OnSaveSnapshot(Stream& dest)
+	{
+		ActorBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<float>(_time);
+		dest.WriteValue<float>(_lightBrightness);
+		dest.WriteValue<float>(_lightIntensity);
+		dest.WriteValue<float>(_lightRadiusNear);
+		dest.WriteValue<float>(_lightRadiusFar);
+	}
+
+	void Explosion::OnRestoreSnapshot(Stream& src)
+	{
+		ActorBase::OnRestoreSnapshot(src);
+
+		_time = src.ReadValue<float>();
+		_lightBrightness = src.ReadValue<float>();
+		_lightIntensity = src.ReadValue<float>();
+		_lightRadiusNear = src.ReadValue<float>();
+		_lightRadiusFar = src.ReadValue<float>();
+	}
+
 	void Explosion::OnUpdateHitbox()
 	{
 		UpdateHitbox(2, 2);
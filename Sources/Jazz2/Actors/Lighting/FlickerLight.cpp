@@ -53,6 +53,32 @@ namespace Jazz2::Actors::Lighting
 		}
 	}
 
+	void FlickerLight::OnSaveSnapshot(Stream& dest)
+	{
+		ActorBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<float>(_phase);
+		for (const auto& part : _parts) {
+			dest.WriteValue<float>(part.Pos.X);
+			dest.WriteValue<float>(part.Pos.Y);
+			dest.WriteValue<float>(part.Radius);
+			dest.WriteValue<float>(part.Phase);
+		}
+	}
+
+	void FlickerLight::OnRestoreSnapshot(Stream& src)
+	{
+		ActorBase::OnRestoreSnapshot(src);
+
+		_phase = src.ReadValue<float>();
+		for (auto& part : _parts) {
+			part.Pos.X = src.ReadValue<float>();
+			part.Pos.Y = src.ReadValue<float>();
+			part.Radius = src.ReadValue<float>();
+			part.Phase = src.ReadValue<float>();
+		}
+	}
+
 	void FlickerLight::OnEmitLights(SmallVectorImpl<LightEmitter>& lights)
 	{
 		auto& light = lights.emplace_back();
@@ -34,6 +34,20 @@ namespace Jazz2::Actors::Lighting
 		_phase += _speed * timeMult;
 	}
 
+	void PulsatingRadialLight::OnSaveSnapshot(Stream& dest)
+	{
+		ActorBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<float>(_phase);
+	}
+
+	void PulsatingRadialLight::OnRestoreSnapshot(Stream& src)
+	{
+		ActorBase::OnRestoreSnapshot(src);
+
+		_phase = src.ReadValue<float>();
+	}
+
 	void PulsatingRadialLight::OnEmitLights(SmallVectorImpl<LightEmitter>& lights)
 	{
 		auto& light = lights.emplace_back();
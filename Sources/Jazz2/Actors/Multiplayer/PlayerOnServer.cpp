@@ -40,6 +40,28 @@ namespace Jazz2::Actors::Multiplayer
 		}
 	}
 
+	void PlayerOnServer::OnSaveSnapshot(Stream& dest)
+	{
+		MpPlayer::OnSaveSnapshot(dest);
+
+		dest.WriteValue<std::uintptr_t>(reinterpret_cast<std::uintptr_t>(_lastAttacker.get()));
+		dest.WriteValue<float>(_lastAttackerTimeout);
+		dest.WriteValue<bool>(_canTakeDamage);
+		dest.WriteValue<float>(_bumpCooldown);
+	}
+
+	void PlayerOnServer::OnRestoreSnapshot(Stream& src)
+	{
+		MpPlayer::OnRestoreSnapshot(src);
+
+		// Players are not a part of snapshots, they are alive as long as the history is, see MpLevelHandler
+		ActorBase* lastAttacker = reinterpret_cast<ActorBase*>(src.ReadValue<std::uintptr_t>());
+		_lastAttacker = (lastAttacker != nullptr ? lastAttacker->shared_from_this() : nullptr);
+		_lastAttackerTimeout = src.ReadValue<float>();
+		_canTakeDamage = src.ReadValue<bool>();
+		_bumpCooldown = src.ReadValue<float>();
+	}
+
 	bool PlayerOnServer::OnHandleCollision(ActorBase* other)
 	{
 		// Players physically bump each other (team-independent). Attacking players deal damage instead
@@ -49,6 +49,8 @@ namespace Jazz2::Actors::Multiplayer
 		bool _bumpInitialized;
 
 		void OnUpdate(float timeMult) override;
+		void OnSaveSnapshot(Stream& dest) override;
+		void OnRestoreSnapshot(Stream& src) override;
 
 		/** @brief Returns `true` if the player is currently performing a damaging move */
 		bool IsAttacking() const;
@@ -4,6 +4,7 @@
 
 #include "../../ContentResolver.h"
 #include "../../ILevelHandler.h"
+#include "../../Multiplayer/MpLevelHandler.h"
 #include "../Player.h"
 #include "../../../nCine/Graphics/RenderQueue.h"
 
@@ -69,7 +70,7 @@ namespace Jazz2::Actors::Multiplayer
 		SetState(ActorState::PreserveOnRollback, true);
 		SetState(ActorState::CanBeFrozen | ActorState::CollideWithTileset | ActorState::ApplyGravitation, false);
 
-		_stateBuffer.Reset(Vector2f(details.Pos.X, details.Pos.Y), StateInterpolationBuffer::Now());
+		_stateBuffer.Reset(Vector2f(details.Pos.X, details.Pos.Y));
 
 		async_return true;
 	}
@@ -77,12 +78,8 @@ namespace Jazz2::Actors::Multiplayer
 	void RemoteActor::OnUpdate(float timeMult)
 	{
 		if (!_isAttachedLocally) {
-			std::int64_t renderTime = StateInterpolationBuffer::Now() - StateInterpolationBuffer::ServerDelay;
-
-			Vector2f pos;
-			if (_stateBuffer.Sample(renderTime, pos)) {
-				MoveInstantly(pos, MoveType::Absolute | MoveType::Force);
-			}
+			std::int64_t renderTime = static_cast<Jazz2::Multiplayer::MpLevelHandler*>(_levelHandler)->GetServerRenderTime();
+			MoveInstantly(_stateBuffer.Sample(renderTime), MoveType::Absolute | MoveType::Force);
 		}
 
 		// Shield time decays locally (the server sends only state changes, not per-frame expiry), so the decoration
@@ -172,9 +169,9 @@ namespace Jazz2::Actors::Multiplayer
 		RefreshColorPalette();
 	}
 
-	void RemoteActor::SyncPositionWithServer(Vector2f pos)
+	void RemoteActor::SyncPositionWithServer(Vector2f pos, std::int64_t serverTime)
 	{
-		_stateBuffer.Push(pos, StateInterpolationBuffer::Now(), _renderer.isDrawEnabled());
+		_stateBuffer.Push(pos, serverTime, _renderer.isDrawEnabled());
 	}
 
 	void RemoteActor::SyncAnimationWithServer(AnimState anim, float rotation, float scaleX, float scaleY, Actors::ActorRendererType rendererType)
@@ -199,7 +196,7 @@ namespace Jazz2::Actors::Multiplayer
 		bool justWarped = (flags & 0x40) != 0;
 		if (justWarped) {
 			// Collapse the buffer to the most recent position, so the actor teleports instead of interpolating
-			_stateBuffer.Reset(_stateBuffer.GetLatest(), StateInterpolationBuffer::Now());
+			_stateBuffer.Reset(_stateBuffer.GetLatest());
 		}
 	}
 
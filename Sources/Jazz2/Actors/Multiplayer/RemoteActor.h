@@ -30,8 +30,8 @@ namespace Jazz2::Actors::Multiplayer
 		void SetPlayerColor(std::uint32_t furColor);
 		/** @brief Changes the metadata (e.g., on character change), keeping the current recolor applied */
 		void ChangeMetadata(StringView path);
-		/** @brief Synchronizes the position with the server */
-		void SyncPositionWithServer(Vector2f pos);
+		/** @brief Synchronizes the position with the server, @p serverTime is the server tick time of the update */
+		void SyncPositionWithServer(Vector2f pos, std::int64_t serverTime);
 		/** @brief Synchronizes the animation and transform with the server */
 		void SyncAnimationWithServer(AnimState anim, float rotation, float scaleX, float scaleY, Actors::ActorRendererType rendererType);
 		/** @brief Synchronizes miscellaneous state flags with the server */
@@ -9,7 +9,7 @@ namespace Jazz2::Actors::Multiplayer
 {
 	RemotePlayerOnServer::RemotePlayerOnServer(std::shared_ptr<PeerDescriptor> peerDesc)
 		: Flags(PlayerFlags::None), PressedKeys(0),
-			PressedKeysLast(0), UpdatedFrame(0)
+			PressedKeysLast(0), UpdatedFrame(0), UpdatedStep(0)
 	{
 		_peerDesc = std::move(peerDesc);
 		_peerDesc->Player = this;
@@ -19,7 +19,7 @@ namespace Jazz2::Actors::Multiplayer
 
 	Task<bool> RemotePlayerOnServer::OnActivatedAsync(const ActorActivationDetails& details)
 	{
-		_stateBuffer.Reset(Vector2f(details.Pos.X, details.Pos.Y), StateInterpolationBuffer::Now());
+		_stateBuffer.Reset(Vector2f(details.Pos.X, details.Pos.Y));
 		// Seed the interpolated display position too, so a hitch before the first OnUpdate interpolation doesn't
 		// render the player at the level origin (0, 0)
 		_displayPos = Vector2f(details.Pos.X, details.Pos.Y);
@@ -29,8 +29,8 @@ namespace Jazz2::Actors::Multiplayer
 
 	void RemotePlayerOnServer::OnUpdate(float timeMult)
 	{
-		std::int64_t renderTime = StateInterpolationBuffer::Now() - StateInterpolationBuffer::ServerDelay;
-		_stateBuffer.Sample(renderTime, _displayPos);
+		std::int64_t renderTime = _peerDesc->PlayoutDelay.GetRenderTime(StateInterpolationBuffer::Now());
+		_displayPos = _stateBuffer.Sample(renderTime);
 
 		// Ground this server-side shadow on the player it stands on (if any) so it doesn't apply gravity and play a
 		// falling animation - its position comes from the owning client, so don't reposition it (snap = false).
@@ -58,6 +58,23 @@ namespace Jazz2::Actors::Multiplayer
 		}
 	}
 
+	void RemotePlayerOnServer::OnSaveSnapshot(Stream& dest)
+	{
+		PlayerOnServer::OnSaveSnapshot(dest);
+
+		// Input of the remote player is predicted, so it must be restored with the step it was used in
+		dest.WriteValue<std::uint64_t>(PressedKeys);
+		dest.WriteValue<std::uint64_t>(PressedKeysLast);
+	}
+
+	void RemotePlayerOnServer::OnRestoreSnapshot(Stream& src)
+	{
+		PlayerOnServer::OnRestoreSnapshot(src);
+
+		PressedKeys = src.ReadValue<std::uint64_t>();
+		PressedKeysLast = src.ReadValue<std::uint64_t>();
+	}
+
 	bool RemotePlayerOnServer::IsContinuousJumpAllowed() const
 	{
 		return (Flags & PlayerFlags::EnableContinuousJump) == PlayerFlags::EnableContinuousJump;
@@ -93,7 +110,7 @@ namespace Jazz2::Actors::Multiplayer
 		return PlayerCarryOver{};
 	}
 
-	void RemotePlayerOnServer::SyncWithServer(Vector2f pos, Vector2f speed, PlayerFlags flags)
+	void RemotePlayerOnServer::SyncWithServer(Vector2f pos, Vector2f speed, PlayerFlags flags, std::int64_t clientTime, std::int64_t receivedTime)
 	{
 		if (_health <= 0) {
 			// Don't sync dead players to avoid cheating
@@ -108,7 +125,8 @@ namespace Jazz2::Actors::Multiplayer
 		SetFacingLeft((flags & PlayerFlags::IsFacingLeft) == PlayerFlags::IsFacingLeft);
 		_isActivelyPushing = (flags & PlayerFlags::IsActivelyPushing) == PlayerFlags::IsActivelyPushing;
 
-		_stateBuffer.Push(pos, StateInterpolationBuffer::Now(), wasVisible);
+		_peerDesc->PlayoutDelay.AddSample(clientTime, receivedTime);
+		_stateBuffer.Push(pos, clientTime, wasVisible);
 
 		// TODO: Set actual pos and speed to the newest value
 		_pos = pos;
@@ -120,7 +138,7 @@ namespace Jazz2::Actors::Multiplayer
 		_pos = pos;
 		_speed = speed;
 
-		_stateBuffer.Reset(pos, StateInterpolationBuffer::Now());
+		_stateBuffer.Reset(pos);
 	}
 
 	void RemotePlayerOnServer::OnPushSolidObject(float timeMult, float pushSpeedX)
@@ -45,6 +45,8 @@ namespace Jazz2::Actors::Multiplayer
 		std::uint64_t PressedKeysLast;
 		/** @brief Last frame when pressed keys were updated */
 		std::uint32_t UpdatedFrame;
+		/** @brief Fixed step the last pressed keys were applied from, see @ref LevelHandler::ResimulateFrom() */
+		std::uint32_t UpdatedStep;
 
 		DEATH_PRIVATE_ENUM_FLAGS(PlayerFlags);
 
@@ -78,8 +80,13 @@ namespace Jazz2::Actors::Multiplayer
 		void EmitWeaponFlare() override;
 		void SetCurrentWeapon(WeaponType weaponType, SetCurrentWeaponReason reason) override;
 
-		/** @brief Synchronizes the player with server */
-		void SyncWithServer(Vector2f pos, Vector2f speed, PlayerFlags flags);
+		/**
+		 * @brief Synchronizes the player with server
+		 *
+		 * @p clientTime is the client's timestamp of the update and @p receivedTime is the local time when it was
+		 * received, both are used to adapt the interpolation delay to the link of this peer.
+		 */
+		void SyncWithServer(Vector2f pos, Vector2f speed, PlayerFlags flags, std::int64_t clientTime, std::int64_t receivedTime);
 
 		/** @brief Forcefully resynchronizes the player with server (e.g., after respawning or warping) */
 		void ForceResyncWithServer(Vector2f pos, Vector2f speed);
@@ -96,6 +103,8 @@ namespace Jazz2::Actors::Multiplayer
 
 		Task<bool> OnActivatedAsync(const ActorActivationDetails& details) override;
 		void OnUpdate(float timeMult) override;
+		void OnSaveSnapshot(Stream& dest) override;
+		void OnRestoreSnapshot(Stream& src) override;
 
 		void OnPushSolidObject(float timeMult, float pushSpeedX) override;
 		void OnHitSpring(Vector2f pos, Vector2f force, bool keepSpeedX, bool keepSpeedY, bool& removeSpecialMove) override;
@@ -5,33 +5,144 @@
 #include "../../../nCine/Base/Clock.h"
 #include "../../../nCine/Primitives/Vector2.h"
 
+#include <algorithm>
+#include <limits>
+
 using namespace nCine;
 
 namespace Jazz2::Actors::Multiplayer
 {
+	/**
+		@brief Estimates clock offset and jitter of a remote sender to pick an adaptive playout delay
+
+		Fed with the sender's tick timestamp and the local receive time of every update from a single peer.
+		The clock offset follows the fastest recent transit, so it isn't inflated by packets that were queued
+		somewhere, and slowly drifts towards later ones to follow clock skew. The playout delay then covers the
+		mean update interval plus a multiple of the measured jitter, so it shrinks on good links and grows on
+		bad ones. Changes of the delay are spread over time, so the displayed motion never jumps.
+	*/
+	class PlayoutDelayEstimator
+	{
+	public:
+		/** @brief Playout delay used until enough updates were received, in milliseconds */
+		static constexpr std::int64_t InitialDelay = 64;
+		/** @brief Lower bound of the playout delay, in milliseconds */
+		static constexpr std::int64_t MinDelay = 8;
+		/** @brief Upper bound of the playout delay, in milliseconds */
+		static constexpr std::int64_t MaxDelay = 250;
+
+		PlayoutDelayEstimator() {
+			Reset();
+		}
+
+		/** @brief Forgets all measurements, e.g. after reconnecting */
+		void Reset() {
+			_offset = 0.0;
+			_jitter = 0.0f;
+			_interval = 0.0f;
+			_delay = (float)InitialDelay;
+			_lastRemoteTime = 0;
+			_lastRenderLocalTime = 0;
+			_sampleCount = 0;
+		}
+
+		/** @brief Adds an update stamped with @p remoteTime by the sender and received at @p localTime */
+		void AddSample(std::int64_t remoteTime, std::int64_t localTime) {
+			double transit = (double)(localTime - remoteTime);
+			if (_sampleCount == 0) {
+				_offset = transit;
+			} else {
+				if (transit < _offset) {
+					// Faster than anything seen so far, the previous estimate included some queuing
+					_offset = transit;
+				} else {
+					_offset += std::min(transit - _offset, OffsetDriftPerSample);
+				}
+
+				std::int64_t interval = remoteTime - _lastRemoteTime;
+				if (interval > 0) {
+					_interval = (_sampleCount == 1 ? (float)interval : _interval + ((float)interval - _interval) * SmoothingFactor);
+				}
+			}
+
+			// Deviation from the fastest transit is the delay variation the playout delay must hide
+			float deviation = (float)(transit - _offset);
+			_jitter += (deviation - _jitter) * SmoothingFactor;
+
+			_lastRemoteTime = std::max(_lastRemoteTime, remoteTime);
+			if (_sampleCount < WarmUpSampleCount) {
+				_sampleCount++;
+			}
+		}
+
+		/**
+		 * @brief Returns time in the sender's timebase that should be displayed at @p localTime
+		 *
+		 * Must be called with non-decreasing @p localTime, the delay converges towards the target by slightly
+		 * speeding up or slowing down the playback.
+		 */
+		std::int64_t GetRenderTime(std::int64_t localTime) {
+			if (_sampleCount >= WarmUpSampleCount) {
+				float target = std::clamp(_interval + JitterFactor * _jitter + SafetyMargin, (float)MinDelay, (float)MaxDelay);
+				float maxChange = (float)std::max(localTime - _lastRenderLocalTime, std::int64_t(0)) * MaxTimeScaleChange;
+				_delay += std::clamp(target - _delay, -maxChange, maxChange);
+			}
+			_lastRenderLocalTime = localTime;
+			return localTime - (std::int64_t)_offset - (std::int64_t)_delay;
+		}
+
+		/** @brief Returns current playout delay, in milliseconds */
+		float GetDelay() const {
+			return _delay;
+		}
+
+		/** @brief Returns smoothed delay variation, in milliseconds */
+		float GetJitter() const {
+			return _jitter;
+		}
+
+	private:
+		static constexpr double OffsetDriftPerSample = 0.05;
+		static constexpr float SmoothingFactor = 1.0f / 16.0f;
+		static constexpr float JitterFactor = 3.0f;
+		static constexpr float SafetyMargin = 2.0f;
+		static constexpr float MaxTimeScaleChange = 0.1f;
+		static constexpr std::int32_t WarmUpSampleCount = 8;
+
+		double _offset;
+		float _jitter;
+		float _interval;
+		float _delay;
+		std::int64_t _lastRemoteTime;
+		std::int64_t _lastRenderLocalTime;
+		std::int32_t _sampleCount;
+	};
+
 	/**
 		@brief Interpolation buffer for actor positions received from a remote authority
 
-		Ring buffer of timestamped positions received over the network, sampled @ref ServerDelay milliseconds in
-		the past so movement stays smooth between (and across late) updates. Shared by the server-side shadow of
-		a remote player (@ref RemotePlayerOnServer) and by client-side remote actors (@ref RemoteActor).
+		Ring buffer of positions stamped with the sender's tick time, sampled at the render time provided by
+		a @ref PlayoutDelayEstimator of the sending peer, so movement stays smooth between (and across late)
+		updates. If updates stop arriving, the motion is extrapolated for at most @ref MaxExtrapolation
+		milliseconds. Shared by the server-side shadow of a remote player (@ref RemotePlayerOnServer) and by
+		client-side remote actors (@ref RemoteActor).
 	*/
 	class StateInterpolationBuffer
 	{
 	public:
-		/** @brief How far in the past the received state is displayed, in milliseconds */
-		static constexpr std::int64_t ServerDelay = 64;
+		/** @brief Maximum time the last known motion is extrapolated when updates are missing, in milliseconds */
+		static constexpr std::int64_t MaxExtrapolation = 100;
 
-		/** @brief Returns the current timestamp of the interpolation clock, in milliseconds */
+		/** @brief Returns the current timestamp of the local interpolation clock, in milliseconds */
 		static std::int64_t Now() {
 			Clock& c = nCine::clock();
 			return std::int64_t(c.now() * 1000 / c.frequency());
 		}
 
 		/** @brief Resets the whole buffer to a single position (spawn, warp, forced resync), disabling interpolation */
-		void Reset(Vector2f pos, std::int64_t now) {
+		void Reset(Vector2f pos) {
 			for (std::int32_t i = 0; i < BufferSize; i++) {
-				_frames[i].Time = now;
+				_frames[i].Time = ResetTime;
 				_frames[i].Pos = pos;
 			}
 		}
@@ -46,51 +157,59 @@ namespace Jazz2::Actors::Multiplayer
 		}
 
 		/**
-		 * @brief Pushes a newly received position
+		 * @brief Pushes a newly received position stamped with the sender's tick time
 		 *
-		 * When @p wasVisible is `false`, the actor was hidden before this update, so the previous and current
-		 * frames are collapsed to the new position to disable interpolation across the gap.
+		 * When @p wasVisible is `false`, the actor was hidden before this update, so the buffer is collapsed to
+		 * the new position to disable interpolation across the gap.
 		 */
-		void Push(Vector2f pos, std::int64_t now, bool wasVisible) {
-			if (wasVisible) {
-				// Actor is still visible, enable interpolation
-				_frames[_cursor].Time = now;
-				_frames[_cursor].Pos = pos;
-			} else {
-				// Actor was hidden before, reset state buffer to disable interpolation
-				std::int32_t prevIdx = _cursor - 1;
-				if (prevIdx < 0) {
-					prevIdx += BufferSize;
-				}
-
-				std::int64_t renderTime = now - ServerDelay;
+		void Push(Vector2f pos, std::int64_t remoteTime, bool wasVisible) {
+			if (!wasVisible) {
+				Reset(pos);
+			}
 
-				_frames[prevIdx].Time = renderTime;
-				_frames[prevIdx].Pos = pos;
-				_frames[_cursor].Time = renderTime;
-				_frames[_cursor].Pos = pos;
+			std::int32_t prevIdx = _cursor - 1;
+			if (prevIdx < 0) {
+				prevIdx += BufferSize;
+			}
+			if DEATH_UNLIKELY(remoteTime <= _frames[prevIdx].Time) {
+				// Duplicate or reordered update, only the newest state is kept for a given time
+				if (remoteTime == _frames[prevIdx].Time) {
+					_frames[prevIdx].Pos = pos;
+				}
+				return;
 			}
 
+			_frames[_cursor].Time = remoteTime;
+			_frames[_cursor].Pos = pos;
+
 			_cursor++;
 			if (_cursor >= BufferSize) {
 				_cursor = 0;
 			}
 		}
 
-		/**
-		 * @brief Samples the interpolated position at the given time
-		 *
-		 * @return `true` and writes @p result when @p renderTime is covered by the buffer; `false` when it is
-		 * ahead of the newest received state, in which case @p result is left untouched.
-		 */
-		bool Sample(std::int64_t renderTime, Vector2f& result) const {
+		/** @brief Returns the position at the given time in the sender's timebase */
+		Vector2f Sample(std::int64_t renderTime) const {
 			std::int32_t nextIdx = _cursor - 1;
 			if (nextIdx < 0) {
 				nextIdx += BufferSize;
 			}
 
-			if (renderTime > _frames[nextIdx].Time) {
-				return false;
+			if (renderTime >= _frames[nextIdx].Time) {
+				// Updates are late or lost, continue the last known motion for a while
+				std::int32_t prevIdx = nextIdx - 1;
+				if (prevIdx < 0) {
+					prevIdx += BufferSize;
+				}
+				// Reset positions must be excluded before subtracting, the difference would overflow otherwise
+				if (_frames[prevIdx].Time != ResetTime && _frames[nextIdx].Time != ResetTime) {
+					std::int64_t timeRange = (_frames[nextIdx].Time - _frames[prevIdx].Time);
+					if (timeRange > 0 && timeRange <= MaxExtrapolation) {
+						std::int64_t extrapolated = std::min(renderTime - _frames[nextIdx].Time, MaxExtrapolation);
+						return _frames[nextIdx].Pos + (_frames[nextIdx].Pos - _frames[prevIdx].Pos) * ((float)extrapolated / timeRange);
+					}
+				}
+				return _frames[nextIdx].Pos;
 			}
 
 			std::int32_t prevIdx;
@@ -107,14 +226,17 @@ namespace Jazz2::Actors::Multiplayer
 				nextIdx = prevIdx;
 			}
 
-			std::int64_t timeRange = (_frames[nextIdx].Time - _frames[prevIdx].Time);
-			if (timeRange > 0) {
-				float lerp = (float)(renderTime - _frames[prevIdx].Time) / timeRange;
-				result = _frames[prevIdx].Pos + (_frames[nextIdx].Pos - _frames[prevIdx].Pos) * lerp;
-			} else {
-				result = _frames[nextIdx].Pos;
+			if (_frames[prevIdx].Time > renderTime) {
+				// Older than anything retained
+				return _frames[prevIdx].Pos;
+			}
+			if (_frames[prevIdx].Time == ResetTime) {
+				// Never interpolate from a reset position
+				return _frames[nextIdx].Pos;
 			}
-			return true;
+
+			float lerp = (float)(renderTime - _frames[prevIdx].Time) / (_frames[nextIdx].Time - _frames[prevIdx].Time);
+			return _frames[prevIdx].Pos + (_frames[nextIdx].Pos - _frames[prevIdx].Pos) * lerp;
 		}
 
 	private:
@@ -123,7 +245,9 @@ namespace Jazz2::Actors::Multiplayer
 			Vector2f Pos;
 		};
 
-		static constexpr std::int32_t BufferSize = 8;
+		static constexpr std::int32_t BufferSize = 16;
+		// Older than any real timestamp, so a reset position is never interpolated from
+		static constexpr std::int64_t ResetTime = std::numeric_limits<std::int64_t>::min();
 
 		StateFrame _frames[BufferSize];
 		std::int32_t _cursor = 0;
@@ -1948,6 +1948,146 @@ namespace Jazz2::Actors
 		return handled;
 	}
 
+	void Player::OnSaveSnapshot(Stream& dest)
+	{
+		ActorBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<bool>(_isActivelyPushing);
+		dest.WriteValue<bool>(_wasActivelyPushing);
+		dest.WriteValue<bool>(_pushContactThisFrame);
+		dest.WriteValue<bool>(_controllable);
+		dest.WriteValue<bool>(_controllableExternal);
+		dest.WriteValue<float>(_controllableTimeout);
+		dest.WriteValue<bool>(_wasUpPressed);
+		dest.WriteValue<bool>(_wasDownPressed);
+		dest.WriteValue<bool>(_wasJumpPressed);
+		dest.WriteValue<bool>(_wasFirePressed);
+		dest.WriteValue<bool>(_isRunPressed);
+		dest.WriteValue<SpecialMoveType>(_currentSpecialMove);
+		dest.WriteValue<bool>(_isAttachedToPole);
+		dest.WriteValue<bool>(_canPushFurther);
+		dest.WriteValue<float>(_copterFramesLeft);
+		dest.WriteValue<float>(_fireFramesLeft);
+		dest.WriteValue<float>(_pushFramesLeft);
+		dest.WriteValue<float>(_waterCooldownLeft);
+		dest.WriteValue<LevelExitingState>(_levelExiting);
+		dest.WriteValue<bool>(_isFreefall);
+		dest.WriteValue<bool>(_inWater);
+		dest.WriteValue<bool>(_isLifting);
+		dest.WriteValue<bool>(_isSpring);
+		dest.WriteValue<std::int32_t>(_inShallowWater);
+		dest.WriteValue<bool>(_inIdleTransition);
+		dest.WriteValue<bool>(_inLedgeTransition);
+		dest.WriteValue<bool>(_canDoubleJump);
+		dest.WriteValue<bool>(_stackCarrying);
+		dest.WriteValue<bool>(_beingStoodOn);
+		dest.WriteValue<float>(_externalForceCooldown);
+		dest.WriteValue<float>(_springCooldown);
+		dest.WriteValue<std::int32_t>(_lives);
+		dest.WriteValue<std::int32_t>(_score);
+		dest.WriteValue<InventoryState>(_inventory);
+		dest.WriteValue<float>(_sugarRushLeft);
+		dest.WriteValue<float>(_sugarRushStarsTime);
+		dest.WriteValue<float>(_shieldSpawnTime);
+		dest.WriteValue<std::int32_t>(_gemsPitch);
+		dest.WriteValue<float>(_gemsTimer);
+		dest.WriteValue<float>(_bonusWarpTimer);
+		dest.WriteValue<SuspendType>(_suspendType);
+		dest.WriteValue<float>(_suspendTime);
+		dest.WriteValue<float>(_invulnerableTime);
+		dest.WriteValue<float>(_invulnerableBlinkTime);
+		dest.WriteValue<float>(_jumpTime);
+		dest.WriteValue<float>(_idleTime);
+		dest.WriteValue<float>(_hitFloorTime);
+		dest.WriteValue<float>(_keepRunningTime);
+		dest.WriteValue<float>(_lastPoleTime);
+		dest.WriteValue<std::int32_t>(_lastPolePos.X);
+		dest.WriteValue<std::int32_t>(_lastPolePos.Y);
+		dest.WriteValue<float>(_inTubeTime);
+		dest.WriteValue<float>(_dizzyTime);
+		dest.WriteValue<ShieldType>(_activeShield);
+		dest.WriteValue<float>(_activeShieldTime);
+		dest.WriteValue<float>(_weaponFlareTime);
+		dest.WriteValue<std::int32_t>(_weaponFlareFrame);
+		dest.WriteValue<float>(_weaponCooldown);
+		dest.WriteValue<WeaponType>(_currentWeapon);
+		dest.WriteValue<bool>(_weaponAllowed);
+		for (std::int32_t gems : _gemsTotal) {
+			dest.WriteValue<std::int32_t>(gems);
+		}
+		dest.WriteValue<std::uintptr_t>(reinterpret_cast<std::uintptr_t>(_carryingObject));
+	}
+
+	void Player::OnRestoreSnapshot(Stream& src)
+	{
+		ActorBase::OnRestoreSnapshot(src);
+
+		_isActivelyPushing = src.ReadValue<bool>();
+		_wasActivelyPushing = src.ReadValue<bool>();
+		_pushContactThisFrame = src.ReadValue<bool>();
+		_controllable = src.ReadValue<bool>();
+		_controllableExternal = src.ReadValue<bool>();
+		_controllableTimeout = src.ReadValue<float>();
+		_wasUpPressed = src.ReadValue<bool>();
+		_wasDownPressed = src.ReadValue<bool>();
+		_wasJumpPressed = src.ReadValue<bool>();
+		_wasFirePressed = src.ReadValue<bool>();
+		_isRunPressed = src.ReadValue<bool>();
+		_currentSpecialMove = src.ReadValue<SpecialMoveType>();
+		_isAttachedToPole = src.ReadValue<bool>();
+		_canPushFurther = src.ReadValue<bool>();
+		_copterFramesLeft = src.ReadValue<float>();
+		_fireFramesLeft = src.ReadValue<float>();
+		_pushFramesLeft = src.ReadValue<float>();
+		_waterCooldownLeft = src.ReadValue<float>();
+		_levelExiting = src.ReadValue<LevelExitingState>();
+		_isFreefall = src.ReadValue<bool>();
+		_inWater = src.ReadValue<bool>();
+		_isLifting = src.ReadValue<bool>();
+		_isSpring = src.ReadValue<bool>();
+		_inShallowWater = src.ReadValue<std::int32_t>();
+		_inIdleTransition = src.ReadValue<bool>();
+		_inLedgeTransition = src.ReadValue<bool>();
+		_canDoubleJump = src.ReadValue<bool>();
+		_stackCarrying = src.ReadValue<bool>();
+		_beingStoodOn = src.ReadValue<bool>();
+		_externalForceCooldown = src.ReadValue<float>();
+		_springCooldown = src.ReadValue<float>();
+		_lives = src.ReadValue<std::int32_t>();
+		_score = src.ReadValue<std::int32_t>();
+		_inventory = src.ReadValue<InventoryState>();
+		_sugarRushLeft = src.ReadValue<float>();
+		_sugarRushStarsTime = src.ReadValue<float>();
+		_shieldSpawnTime = src.ReadValue<float>();
+		_gemsPitch = src.ReadValue<std::int32_t>();
+		_gemsTimer = src.ReadValue<float>();
+		_bonusWarpTimer = src.ReadValue<float>();
+		_suspendType = src.ReadValue<SuspendType>();
+		_suspendTime = src.ReadValue<float>();
+		_invulnerableTime = src.ReadValue<float>();
+		_invulnerableBlinkTime = src.ReadValue<float>();
+		_jumpTime = src.ReadValue<float>();
+		_idleTime = src.ReadValue<float>();
+		_hitFloorTime = src.ReadValue<float>();
+		_keepRunningTime = src.ReadValue<float>();
+		_lastPoleTime = src.ReadValue<float>();
+		_lastPolePos.X = src.ReadValue<std::int32_t>();
+		_lastPolePos.Y = src.ReadValue<std::int32_t>();
+		_inTubeTime = src.ReadValue<float>();
+		_dizzyTime = src.ReadValue<float>();
+		_activeShield = src.ReadValue<ShieldType>();
+		_activeShieldTime = src.ReadValue<float>();
+		_weaponFlareTime = src.ReadValue<float>();
+		_weaponFlareFrame = src.ReadValue<std::int32_t>();
+		_weaponCooldown = src.ReadValue<float>();
+		_currentWeapon = src.ReadValue<WeaponType>();
+		_weaponAllowed = src.ReadValue<bool>();
+		for (std::int32_t& gems : _gemsTotal) {
+			gems = src.ReadValue<std::int32_t>();
+		}
+		_carryingObject = reinterpret_cast<ActorBase*>(src.ReadValue<std::uintptr_t>());
+	}
+
 	void Player::OnHitFloor(float timeMult)
 	{
 		if (_activeModifier == Modifier::None && (_currentAnimation->State & AnimState::Copter) == AnimState::Copter) {
@@ -3031,14 +3171,8 @@ namespace Jazz2::Actors
 	{
 		auto it = _metadata->Sounds.find(String::nullTerminatedView(identifier));
 		if (it != _metadata->Sounds.end()) {
-			AudioBuffer* buffer;
-			if (!it->second.Buffers.empty()) {
-				std::int32_t idx = (it->second.Buffers.size() > 1 ? Random().Next(0, (std::int32_t)it->second.Buffers.size()) : 0);
-				buffer = &it->second.Buffers[idx]->Buffer;
-			} else {
-				buffer = nullptr;
-			}
-			
+			auto* variant = it->second.PickVariant();
+			AudioBuffer* buffer = (variant != nullptr ? &variant->Buffer : nullptr);
 			return _levelHandler->PlaySfx(this, identifier, buffer, Vector3f::Zero, true, gain, pitch);
 		}
 
@@ -559,6 +559,8 @@ namespace Jazz2::Actors
 		void OnHitCeiling(float timeMult) override;
 		void OnHitWall(float timeMult) override;
 		float GetGravityModifier(float baseGravity, bool isRising) const override;
+		void OnSaveSnapshot(Stream& dest) override;
+		void OnRestoreSnapshot(Stream& src) override;
 
 		/**
 		 * @brief Keeps this player and @p other from overlapping (so they can't pass through) and bumps them apart
@@ -20,6 +20,11 @@ namespace Jazz2::Actors::Solid
 
 	Bridge::~Bridge()
 	{
+		// Actors that were never activated don't belong to any level
+		if (_levelHandler == nullptr) {
+			return;
+		}
+
 		auto players = _levelHandler->GetPlayers();
 		for (auto* player : players) {
 			player->CancelCarryingObject(this);
@@ -198,6 +203,30 @@ namespace Jazz2::Actors::Solid
 		}
 	}
 
+	void Bridge::OnSaveSnapshot(Stream& dest)
+	{
+		ActorBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<float>(_leftX);
+		dest.WriteValue<float>(_leftHeight);
+		dest.WriteValue<float>(_rightX);
+		dest.WriteValue<float>(_rightHeight);
+		dest.WriteValue<float>(_sagSyncTimer);
+		dest.WriteValue<bool>(_sagWasActive);
+	}
+
+	void Bridge::OnRestoreSnapshot(Stream& src)
+	{
+		ActorBase::OnRestoreSnapshot(src);
+
+		_leftX = src.ReadValue<float>();
+		_leftHeight = src.ReadValue<float>();
+		_rightX = src.ReadValue<float>();
+		_rightHeight = src.ReadValue<float>();
+		_sagSyncTimer = src.ReadValue<float>();
+		_sagWasActive = src.ReadValue<bool>();
+	}
+
 	float Bridge::GetDropAt(float widthCovered, float leftX, float leftHeight, float rightX, float rightHeight) const
 	{
 		if (leftHeight <= 0.001f && rightHeight <= 0.001f) {
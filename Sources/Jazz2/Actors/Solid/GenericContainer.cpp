@@ -101,4 +101,32 @@ namespace Jazz2::Actors::Solid
 			std::memset(EventParams + eventParamsSize, 0, 16 - eventParamsSize);
 		}
 	}
+
+	void GenericContainer::OnSaveSnapshot(Stream& dest)
+	{
+		SolidObjectBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<std::int32_t>((std::int32_t)_content.size());
+		for (const auto& item : _content) {
+			dest.WriteValue<EventType>(item.Type);
+			dest.WriteValue<std::int32_t>(item.Count);
+			dest.Write(item.EventParams, sizeof(item.EventParams));
+		}
+	}
+
+	void GenericContainer::OnRestoreSnapshot(Stream& src)
+	{
+		SolidObjectBase::OnRestoreSnapshot(src);
+
+		// Content is spawned and cleared when the container is destroyed, so it can be put back
+		_content.clear();
+		std::int32_t contentCount = src.ReadValue<std::int32_t>();
+		for (std::int32_t i = 0; i < contentCount; i++) {
+			EventType eventType = src.ReadValue<EventType>();
+			std::int32_t count = src.ReadValue<std::int32_t>();
+			std::uint8_t eventParams[sizeof(ContainerContent::EventParams)];
+			src.Read(eventParams, sizeof(eventParams));
+			_content.emplace_back(eventType, count, eventParams, std::int32_t(sizeof(eventParams)));
+		}
+	}
 }
\ No newline at end of file
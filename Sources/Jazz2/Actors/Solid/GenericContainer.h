@@ -38,6 +38,8 @@ namespace Jazz2::Actors::Solid
 		SmallVector<ContainerContent, 1> _content;
 
 		bool OnPerish(ActorBase* collider) override;
+		void OnSaveSnapshot(Stream& dest) override;
+		void OnRestoreSnapshot(Stream& src) override;
 
 		/** @brief Adds a content to the container */
 		void AddContent(EventType eventType, std::int32_t count, const std::uint8_t* eventParams, std::int32_t eventParamsSize);
@@ -15,6 +15,11 @@ namespace Jazz2::Actors::Solid
 
 	MovingPlatform::~MovingPlatform()
 	{
+		// Actors that were never activated don't belong to any level
+		if (_levelHandler == nullptr) {
+			return;
+		}
+
 		auto players = _levelHandler->GetPlayers();
 		for (auto* player : players) {
 			player->CancelCarryingObject(this);
@@ -175,6 +180,32 @@ namespace Jazz2::Actors::Solid
 		}
 	}
 
+	void MovingPlatform::OnSaveSnapshot(Stream& dest)
+	{
+		SolidObjectBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<float>(_phase);
+		dest.WriteValue<float>(_lastPos.X);
+		dest.WriteValue<float>(_lastPos.Y);
+		for (const auto& piece : _pieces) {
+			dest.WriteValue<float>(piece.Pos.X);
+			dest.WriteValue<float>(piece.Pos.Y);
+		}
+	}
+
+	void MovingPlatform::OnRestoreSnapshot(Stream& src)
+	{
+		SolidObjectBase::OnRestoreSnapshot(src);
+
+		_phase = src.ReadValue<float>();
+		_lastPos.X = src.ReadValue<float>();
+		_lastPos.Y = src.ReadValue<float>();
+		for (auto& piece : _pieces) {
+			piece.Pos.X = src.ReadValue<float>();
+			piece.Pos.Y = src.ReadValue<float>();
+		}
+	}
+
 	bool MovingPlatform::OnHandleCollision(ActorBase* other)
 	{
 		if (_type == PlatformType::SpikeBall && _health > 0) {
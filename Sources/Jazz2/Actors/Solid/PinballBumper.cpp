@@ -109,6 +109,24 @@ namespace Jazz2::Actors::Solid
 		}
 	}
 
+	void PinballBumper::OnSaveSnapshot(Stream& dest)
+	{
+		SolidObjectBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<float>(_cooldown);
+		dest.WriteValue<float>(_lightIntensity);
+		dest.WriteValue<float>(_lightBrightness);
+	}
+
+	void PinballBumper::OnRestoreSnapshot(Stream& src)
+	{
+		SolidObjectBase::OnRestoreSnapshot(src);
+
+		_cooldown = src.ReadValue<float>();
+		_lightIntensity = src.ReadValue<float>();
+		_lightBrightness = src.ReadValue<float>();
+	}
+
 	void PinballBumper::OnEmitLights(SmallVectorImpl<LightEmitter>& lights)
 	{
 		if (_lightIntensity > 0.0f) {
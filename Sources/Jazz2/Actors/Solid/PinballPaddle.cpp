@@ -84,6 +84,20 @@ namespace Jazz2::Actors::Solid
 		}
 	}
 
+	void PinballPaddle::OnSaveSnapshot(Stream& dest)
+	{
+		SolidObjectBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<float>(_cooldown);
+	}
+
+	void PinballPaddle::OnRestoreSnapshot(Stream& src)
+	{
+		SolidObjectBase::OnRestoreSnapshot(src);
+
+		_cooldown = src.ReadValue<float>();
+	}
+
 	void PinballPaddle::OnUpdateHitbox()
 	{
 		if (_currentAnimation != nullptr) {
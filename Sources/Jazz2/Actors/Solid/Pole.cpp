@@ -117,6 +117,28 @@ namespace Jazz2::Actors::Solid
 		}
 	}
 
+	void Pole::OnSaveSnapshot(Stream& dest)
+	{
+		ActorBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<FallDirection>(_fall);
+		dest.WriteValue<float>(_angleVel);
+		dest.WriteValue<float>(_angleVelLast);
+		dest.WriteValue<float>(_fallTime);
+		dest.WriteValue<std::int32_t>(_bouncesLeft);
+	}
+
+	void Pole::OnRestoreSnapshot(Stream& src)
+	{
+		ActorBase::OnRestoreSnapshot(src);
+
+		_fall = src.ReadValue<FallDirection>();
+		_angleVel = src.ReadValue<float>();
+		_angleVelLast = src.ReadValue<float>();
+		_fallTime = src.ReadValue<float>();
+		_bouncesLeft = src.ReadValue<std::int32_t>();
+	}
+
 	void Pole::OnPacketReceived(MemoryStream& packet)
 	{
 		FallDirection fall = (FallDirection)packet.ReadValue<std::uint8_t>();
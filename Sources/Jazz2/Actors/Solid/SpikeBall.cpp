@@ -84,6 +84,30 @@ namespace Jazz2::Actors::Solid
 		}
 	}
 
+	void SpikeBall::OnSaveSnapshot(Stream& dest)
+	{
+		EnemyBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<float>(_phase);
+		for (const auto& piece : _pieces) {
+			dest.WriteValue<float>(piece.Pos.X);
+			dest.WriteValue<float>(piece.Pos.Y);
+			dest.WriteValue<float>(piece.Scale);
+		}
+	}
+
+	void SpikeBall::OnRestoreSnapshot(Stream& src)
+	{
+		EnemyBase::OnRestoreSnapshot(src);
+
+		_phase = src.ReadValue<float>();
+		for (auto& piece : _pieces) {
+			piece.Pos.X = src.ReadValue<float>();
+			piece.Pos.Y = src.ReadValue<float>();
+			piece.Scale = src.ReadValue<float>();
+		}
+	}
+
 	void SpikeBall::OnUpdateHitbox()
 	{
 		EnemyBase::OnUpdateHitbox();
@@ -16,6 +16,11 @@ namespace Jazz2::Actors
 
 	SolidObjectBase::~SolidObjectBase()
 	{
+		// Actors that were never activated don't belong to any level
+		if (_levelHandler == nullptr) {
+			return;
+		}
+
 		auto players = _levelHandler->GetPlayers();
 		for (auto* player : players) {
 			player->CancelCarryingObject(this);
@@ -101,6 +106,22 @@ namespace Jazz2::Actors
 		}
 	}
 
+	void SolidObjectBase::OnSaveSnapshot(Stream& dest)
+	{
+		ActorBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<float>(_pushingSpeedX);
+		dest.WriteValue<float>(_pushingTime);
+	}
+
+	void SolidObjectBase::OnRestoreSnapshot(Stream& src)
+	{
+		ActorBase::OnRestoreSnapshot(src);
+
+		_pushingSpeedX = src.ReadValue<float>();
+		_pushingTime = src.ReadValue<float>();
+	}
+
 	bool SolidObjectBase::TryPushInternal(float timeMult, float speedX)
 	{
 		float farX = (speedX < 0.0f ? AABBInner.L : AABBInner.R);
@@ -38,6 +38,8 @@ namespace Jazz2::Actors
 		/** @} */
 
 		void OnUpdate(float timeMult) override;
+		void OnSaveSnapshot(Stream& dest) override;
+		void OnRestoreSnapshot(Stream& src) override;
 
 	private:
 		float _pushingSpeedX;
@@ -96,6 +96,20 @@ namespace Jazz2::Actors::Weapons
 		}
 	}
 
+	void BlasterShot::OnSaveSnapshot(Stream& dest)
+	{
+		ShotBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<std::int32_t>(_fired);
+	}
+
+	void BlasterShot::OnRestoreSnapshot(Stream& src)
+	{
+		ShotBase::OnRestoreSnapshot(src);
+
+		_fired = src.ReadValue<std::int32_t>();
+	}
+
 	void BlasterShot::OnUpdateHitbox()
 	{
 		AABBInner = AABBf(_pos.X - 3, _pos.Y - 2, _pos.X + 3, _pos.Y + 4);
@@ -100,6 +100,24 @@ namespace Jazz2::Actors::Weapons
 		}
 	}
 
+	void BouncerShot::OnSaveSnapshot(Stream& dest)
+	{
+		ShotBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<std::int32_t>(_fired);
+		dest.WriteValue<float>(_targetSpeedX);
+		dest.WriteValue<float>(_hitLimit);
+	}
+
+	void BouncerShot::OnRestoreSnapshot(Stream& src)
+	{
+		ShotBase::OnRestoreSnapshot(src);
+
+		_fired = src.ReadValue<std::int32_t>();
+		_targetSpeedX = src.ReadValue<float>();
+		_hitLimit = src.ReadValue<float>();
+	}
+
 	void BouncerShot::OnEmitLights(SmallVectorImpl<LightEmitter>& lights)
 	{
 		if (_fired >= 2) {
@@ -134,6 +134,24 @@ namespace Jazz2::Actors::Weapons
 		}
 	}
 
+	void ElectroShot::OnSaveSnapshot(Stream& dest)
+	{
+		ShotBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<std::int32_t>(_fired);
+		dest.WriteValue<float>(_currentStep);
+		dest.WriteValue<float>(_particleSpawnTime);
+	}
+
+	void ElectroShot::OnRestoreSnapshot(Stream& src)
+	{
+		ShotBase::OnRestoreSnapshot(src);
+
+		_fired = src.ReadValue<std::int32_t>();
+		_currentStep = src.ReadValue<float>();
+		_particleSpawnTime = src.ReadValue<float>();
+	}
+
 	void ElectroShot::OnUpdateHitbox()
 	{
 		UpdateHitbox(4, 4);
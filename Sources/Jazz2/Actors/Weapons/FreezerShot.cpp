@@ -131,6 +131,22 @@ namespace Jazz2::Actors::Weapons
 		}
 	}
 
+	void FreezerShot::OnSaveSnapshot(Stream& dest)
+	{
+		ShotBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<std::int32_t>(_fired);
+		dest.WriteValue<float>(_particlesTime);
+	}
+
+	void FreezerShot::OnRestoreSnapshot(Stream& src)
+	{
+		ShotBase::OnRestoreSnapshot(src);
+
+		_fired = src.ReadValue<std::int32_t>();
+		_particlesTime = src.ReadValue<float>();
+	}
+
 	void FreezerShot::OnUpdateHitbox()
 	{
 		// TODO: This is a quick fix for player cannot freeze springs
@@ -89,6 +89,20 @@ namespace Jazz2::Actors::Weapons
 			_renderer.setDrawEnabled(true);
 		}
 	}
+
+	void PepperShot::OnSaveSnapshot(Stream& dest)
+	{
+		ShotBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<std::int32_t>(_fired);
+	}
+
+	void PepperShot::OnRestoreSnapshot(Stream& src)
+	{
+		ShotBase::OnRestoreSnapshot(src);
+
+		_fired = src.ReadValue<std::int32_t>();
+	}
 	
 	void PepperShot::OnEmitLights(SmallVectorImpl<LightEmitter>& lights)
 	{
@@ -92,6 +92,22 @@ namespace Jazz2::Actors::Weapons
 		}
 	}
 
+	void RFShot::OnSaveSnapshot(Stream& dest)
+	{
+		ShotBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<std::int32_t>(_fired);
+		dest.WriteValue<float>(_smokeTimer);
+	}
+
+	void RFShot::OnRestoreSnapshot(Stream& src)
+	{
+		ShotBase::OnRestoreSnapshot(src);
+
+		_fired = src.ReadValue<std::int32_t>();
+		_smokeTimer = src.ReadValue<float>();
+	}
+
 	void RFShot::OnEmitLights(SmallVectorImpl<LightEmitter>& lights)
 	{
 		if (_fired >= 2) {
@@ -95,6 +95,24 @@ namespace Jazz2::Actors::Weapons
 		ShotBase::OnUpdate(timeMult);
 	}
 
+	void SeekerShot::OnSaveSnapshot(Stream& dest)
+	{
+		ShotBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<std::int32_t>(_fired);
+		dest.WriteValue<float>(_defaultRecomputeTime);
+		dest.WriteValue<float>(_followRecomputeTime);
+	}
+
+	void SeekerShot::OnRestoreSnapshot(Stream& src)
+	{
+		ShotBase::OnRestoreSnapshot(src);
+
+		_fired = src.ReadValue<std::int32_t>();
+		_defaultRecomputeTime = src.ReadValue<float>();
+		_followRecomputeTime = src.ReadValue<float>();
+	}
+
 	void SeekerShot::OnEmitLights(SmallVectorImpl<LightEmitter>& lights)
 	{
 		if (_fired >= 2) {
@@ -86,6 +86,20 @@ namespace Jazz2::Actors::Weapons
 		}
 	}
 
+	void ShieldFireShot::OnSaveSnapshot(Stream& dest)
+	{
+		ShotBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<std::int32_t>(_fired);
+	}
+
+	void ShieldFireShot::OnRestoreSnapshot(Stream& src)
+	{
+		ShotBase::OnRestoreSnapshot(src);
+
+		_fired = src.ReadValue<std::int32_t>();
+	}
+
 	void ShieldFireShot::OnUpdateHitbox()
 	{
 		AABBInner = AABBf(_pos.X - 3, _pos.Y - 2, _pos.X + 3, _pos.Y + 4);
@@ -103,6 +103,20 @@ namespace Jazz2::Actors::Weapons
 #endif
 	}
 
+	void ShieldLightningShot::OnSaveSnapshot(Stream& dest)
+	{
+		ShotBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<std::int32_t>(_fired);
+	}
+
+	void ShieldLightningShot::OnRestoreSnapshot(Stream& src)
+	{
+		ShotBase::OnRestoreSnapshot(src);
+
+		_fired = src.ReadValue<std::int32_t>();
+	}
+
 	void ShieldLightningShot::OnUpdateHitbox()
 	{
 		AABBInner = AABBf(_pos.X - 3, _pos.Y - 2, _pos.X + 3, _pos.Y + 4);
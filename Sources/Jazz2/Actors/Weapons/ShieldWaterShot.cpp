@@ -85,6 +85,20 @@ namespace Jazz2::Actors::Weapons
 		}
 	}
 
+	void ShieldWaterShot::OnSaveSnapshot(Stream& dest)
+	{
+		ShotBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<std::int32_t>(_fired);
+	}
+
+	void ShieldWaterShot::OnRestoreSnapshot(Stream& src)
+	{
+		ShotBase::OnRestoreSnapshot(src);
+
+		_fired = src.ReadValue<std::int32_t>();
+	}
+
 	void ShieldWaterShot::OnUpdateHitbox()
 	{
 		AABBInner = AABBf(_pos.X - 3, _pos.Y - 2, _pos.X + 3, _pos.Y + 4);
@@ -6,15 +6,18 @@
 #include "../SolidObjectBase.h"
 #include "../Enemies/EnemyBase.h"
 
+#include "../../../nCine/Base/FrameTimer.h"
 #include "../../../nCine/Base/Random.h"
 #include "../../../nCine/Application.h"
 
+#include <float.h>
+
 using namespace Jazz2::Tiles;
 
 namespace Jazz2::Actors::Weapons
 {
 	ShotBase::ShotBase()
-		: _timeLeft(0), _upgrades(0), _strength(0), _lastRicochet(nullptr)
+		: _timeLeft(0), _upgrades(0), _strength(0), _lastRicochet(nullptr), _lastRicochetFrames(-FLT_MAX)
 	{
 	}
 
@@ -37,20 +40,21 @@ namespace Jazz2::Actors::Weapons
 
 	void ShotBase::TriggerRicochet(ActorBase* other)
 	{
-		TimeStamp now = TimeStamp::now();
+		// Level time is used instead of wall-clock time, so the result doesn't depend on the frame rate
+		float now = _levelHandler->GetElapsedFrames();
 
 		if (other == nullptr) {
-			if ((now - _lastRicochetTime).seconds() > 1.0f) {
+			if (now - _lastRicochetFrames > FrameTimer::FramesPerSecond) {
 				_lastRicochet = nullptr;
-				_lastRicochetTime = now;
+				_lastRicochetFrames = now;
 				OnRicochet();
 			}
 		} else {
 			if (_lastRicochet != other) {
 				_lastRicochet = other;
-				_lastRicochetTime = now;
+				_lastRicochetFrames = now;
 				OnRicochet();
-			} else if ((now - _lastRicochetTime).seconds() < 1.0f) {
+			} else if (now - _lastRicochetFrames < FrameTimer::FramesPerSecond) {
 				DecreaseHealth(INT32_MAX);
 			}
 		}
@@ -64,6 +68,26 @@ namespace Jazz2::Actors::Weapons
 		}
 	}
 
+	void ShotBase::OnSaveSnapshot(Stream& dest)
+	{
+		ActorBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<float>(_timeLeft);
+		dest.WriteValue<std::int32_t>(_strength);
+		dest.WriteValue<std::uintptr_t>(reinterpret_cast<std::uintptr_t>(_lastRicochet));
+		dest.WriteValue<float>(_lastRicochetFrames);
+	}
+
+	void ShotBase::OnRestoreSnapshot(Stream& src)
+	{
+		ActorBase::OnRestoreSnapshot(src);
+
+		_timeLeft = src.ReadValue<float>();
+		_strength = src.ReadValue<std::int32_t>();
+		_lastRicochet = reinterpret_cast<ActorBase*>(src.ReadValue<std::uintptr_t>());
+		_lastRicochetFrames = src.ReadValue<float>();
+	}
+
 	bool ShotBase::OnHandleCollision(ActorBase* other)
 	{
 		if (auto* enemyBase = runtime_cast<Enemies::EnemyBase>(other)) {
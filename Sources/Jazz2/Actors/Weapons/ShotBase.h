@@ -3,8 +3,6 @@
 #include "../ActorBase.h"
 #include "../../WeaponType.h"
 
-#include "../../../nCine/Base/TimeStamp.h"
-
 namespace Jazz2::Actors
 {
 	class Player;
@@ -52,12 +50,14 @@ namespace Jazz2::Actors::Weapons
 
 		Task<bool> OnActivatedAsync(const ActorActivationDetails& details) override;
 		void OnUpdate(float timeMult) override;
+		void OnSaveSnapshot(Stream& dest) override;
+		void OnRestoreSnapshot(Stream& src) override;
 		/** @brief Called on shot ricochet */
 		virtual void OnRicochet();
 
 		void TryMovement(float timeMult, Tiles::TileCollisionParams& params);
 
 	private:
-		TimeStamp _lastRicochetTime;
+		float _lastRicochetFrames;
 	};
 }
\ No newline at end of file
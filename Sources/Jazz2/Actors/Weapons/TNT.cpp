@@ -130,6 +130,26 @@ namespace Jazz2::Actors::Weapons
 		}
 	}
 
+	void TNT::OnSaveSnapshot(Stream& dest)
+	{
+		ActorBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<float>(_timeLeft);
+		dest.WriteValue<float>(_lightIntensity);
+		dest.WriteValue<bool>(_isExploded);
+		dest.WriteValue<std::int32_t>(_preexplosionTime);
+	}
+
+	void TNT::OnRestoreSnapshot(Stream& src)
+	{
+		ActorBase::OnRestoreSnapshot(src);
+
+		_timeLeft = src.ReadValue<float>();
+		_lightIntensity = src.ReadValue<float>();
+		_isExploded = src.ReadValue<bool>();
+		_preexplosionTime = src.ReadValue<std::int32_t>();
+	}
+
 	void TNT::OnEmitLights(SmallVectorImpl<LightEmitter>& lights)
 	{
 		if (_lightIntensity > 0.0f) {
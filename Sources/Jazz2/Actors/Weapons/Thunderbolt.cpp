@@ -110,6 +110,28 @@ namespace Jazz2::Actors::Weapons
 		_renderer.setLayer((uint16_t)(_initialLayer - _lightProgress * 10.0f));
 	}
 
+	void Thunderbolt::OnSaveSnapshot(Stream& dest)
+	{
+		ShotBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<bool>(_hit);
+		dest.WriteValue<float>(_lightProgress);
+		dest.WriteValue<float>(_farPoint.X);
+		dest.WriteValue<float>(_farPoint.Y);
+		dest.WriteValue<bool>(_firedUp);
+	}
+
+	void Thunderbolt::OnRestoreSnapshot(Stream& src)
+	{
+		ShotBase::OnRestoreSnapshot(src);
+
+		_hit = src.ReadValue<bool>();
+		_lightProgress = src.ReadValue<float>();
+		_farPoint.X = src.ReadValue<float>();
+		_farPoint.Y = src.ReadValue<float>();
+		_firedUp = src.ReadValue<bool>();
+	}
+
 	void Thunderbolt::OnUpdateHitbox()
 	{
 		constexpr float Size = 10.0f;
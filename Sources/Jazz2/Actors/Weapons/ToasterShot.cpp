@@ -102,6 +102,20 @@ namespace Jazz2::Actors::Weapons
 		ShotBase::OnUpdate(timeMult);
 	}
 
+	void ToasterShot::OnSaveSnapshot(Stream& dest)
+	{
+		ShotBase::OnSaveSnapshot(dest);
+
+		dest.WriteValue<std::int32_t>(_fired);
+	}
+
+	void ToasterShot::OnRestoreSnapshot(Stream& src)
+	{
+		ShotBase::OnRestoreSnapshot(src);
+
+		_fired = src.ReadValue<std::int32_t>();
+	}
+
 	void ToasterShot::OnUpdateHitbox()
 	{
 		AABBInner = AABBf(_pos.X - 3, _pos.Y - 3, _pos.X + 3, _pos.Y + 3);
@@ -51,6 +51,49 @@ namespace Jazz2::Collisions
 		delete[] _nodes;
 	}
 
+	void DynamicTree::CopyFrom(const DynamicTree& other)
+	{
+		if (_nodeCapacity != other._nodeCapacity) {
+			delete[] _nodes;
+			_nodeCapacity = other._nodeCapacity;
+			_nodes = new TreeNode[_nodeCapacity];
+		}
+
+		// Free nodes are copied too, they form the free list
+		std::memcpy(_nodes, other._nodes, _nodeCapacity * sizeof(TreeNode));
+		_root = other._root;
+		_nodeCount = other._nodeCount;
+		_freeList = other._freeList;
+		_insertionCount = other._insertionCount;
+	}
+
+	void DynamicTree::SaveSnapshot(Stream& dest) const
+	{
+		dest.WriteValue<std::int32_t>(_nodeCapacity);
+		dest.WriteValue<std::int32_t>(_root);
+		dest.WriteValue<std::int32_t>(_nodeCount);
+		dest.WriteValue<std::int32_t>(_freeList);
+		dest.WriteValue<std::int32_t>(_insertionCount);
+		// Free nodes are written too, they form the free list
+		dest.Write(_nodes, _nodeCapacity * sizeof(TreeNode));
+	}
+
+	void DynamicTree::RestoreSnapshot(Stream& src)
+	{
+		std::int32_t nodeCapacity = src.ReadValue<std::int32_t>();
+		if (_nodeCapacity != nodeCapacity) {
+			delete[] _nodes;
+			_nodeCapacity = nodeCapacity;
+			_nodes = new TreeNode[_nodeCapacity];
+		}
+
+		_root = src.ReadValue<std::int32_t>();
+		_nodeCount = src.ReadValue<std::int32_t>();
+		_freeList = src.ReadValue<std::int32_t>();
+		_insertionCount = src.ReadValue<std::int32_t>();
+		src.Read(_nodes, _nodeCapacity * sizeof(TreeNode));
+	}
+
 	// Allocate a node from the pool. Grow the pool if necessary.
 	std::int32_t DynamicTree::AllocateNode()
 	{
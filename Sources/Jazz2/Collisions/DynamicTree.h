@@ -26,8 +26,10 @@
 #include "../../nCine/Primitives/Vector2.h"
 
 #include <Containers/SmallVector.h>
+#include <IO/Stream.h>
 
 using namespace Death::Containers;
+using namespace Death::IO;
 
 namespace Jazz2::Collisions
 {
@@ -106,6 +108,21 @@ namespace Jazz2::Collisions
 		/** @brief Destroys the tree, freeing the node pool */
 		~DynamicTree();
 
+		DynamicTree(const DynamicTree&) = delete;
+		DynamicTree& operator=(const DynamicTree&) = delete;
+
+		/**
+		 * @brief Replaces the whole tree with a copy of another one
+		 *
+		 * Node IDs (and so proxy IDs) are preserved. The node pool is reallocated only if its capacity differs.
+		 */
+		void CopyFrom(const DynamicTree& other);
+
+		/** @brief Writes the whole tree to a stream, user data are written as pointers, so it can be read only in this process */
+		void SaveSnapshot(Stream& dest) const;
+		/** @brief Replaces the whole tree with one written by @ref SaveSnapshot() */
+		void RestoreSnapshot(Stream& src);
+
 		/** @brief Creates a proxy */
 		std::int32_t CreateProxy(const AABBf& aabb, void* userData);
 
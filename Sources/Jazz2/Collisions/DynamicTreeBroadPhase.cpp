@@ -43,6 +43,49 @@ namespace Jazz2::Collisions
 		delete[] _pairBuffer;
 	}
 
+	void DynamicTreeBroadPhase::CopyFrom(const DynamicTreeBroadPhase& other)
+	{
+		_tree.CopyFrom(other._tree);
+		_proxyCount = other._proxyCount;
+
+		if (_moveCapacity < other._moveCount) {
+			delete[] _moveBuffer;
+			_moveCapacity = other._moveCapacity;
+			_moveBuffer = new std::int32_t[_moveCapacity];
+		}
+		std::memcpy(_moveBuffer, other._moveBuffer, other._moveCount * sizeof(std::int32_t));
+		_moveCount = other._moveCount;
+
+		// Pairs are only valid during UpdatePairs()
+		_pairCount = 0;
+	}
+
+	void DynamicTreeBroadPhase::SaveSnapshot(Stream& dest) const
+	{
+		_tree.SaveSnapshot(dest);
+		dest.WriteValue<std::int32_t>(_proxyCount);
+		dest.WriteValue<std::int32_t>(_moveCount);
+		dest.Write(_moveBuffer, _moveCount * sizeof(std::int32_t));
+	}
+
+	void DynamicTreeBroadPhase::RestoreSnapshot(Stream& src)
+	{
+		_tree.RestoreSnapshot(src);
+		_proxyCount = src.ReadValue<std::int32_t>();
+
+		std::int32_t moveCount = src.ReadValue<std::int32_t>();
+		if (_moveCapacity < moveCount) {
+			delete[] _moveBuffer;
+			_moveCapacity = moveCount;
+			_moveBuffer = new std::int32_t[_moveCapacity];
+		}
+		src.Read(_moveBuffer, moveCount * sizeof(std::int32_t));
+		_moveCount = moveCount;
+
+		// Pairs are only valid during UpdatePairs()
+		_pairCount = 0;
+	}
+
 	int32_t DynamicTreeBroadPhase::CreateProxy(const AABBf& aabb, void* userData)
 	{
 		std::int32_t proxyId = _tree.CreateProxy(aabb, userData);
@@ -58,6 +58,22 @@ namespace Jazz2::Collisions
 		DynamicTreeBroadPhase();
 		~DynamicTreeBroadPhase();
 
+		DynamicTreeBroadPhase(const DynamicTreeBroadPhase&) = delete;
+		DynamicTreeBroadPhase& operator=(const DynamicTreeBroadPhase&) = delete;
+
+		/**
+		 * @brief Replaces all proxies with a copy of another broad-phase
+		 *
+		 * Proxy IDs and user data are preserved, so it can be used to save and restore the state cheaply.
+		 * Buffers are reused if they are large enough.
+		 */
+		void CopyFrom(const DynamicTreeBroadPhase& other);
+
+		/** @brief Writes all proxies to a stream, see @ref DynamicTree::SaveSnapshot() */
+		void SaveSnapshot(Stream& dest) const;
+		/** @brief Replaces all proxies with ones written by @ref SaveSnapshot() */
+		void RestoreSnapshot(Stream& src);
+
 		/**
 		 * @brief Creates a proxy with an initial AABB
 		 * 
@@ -1,4 +1,5 @@
 ﻿#include "AssetConverter.h"
+#include "AssetManifest.h"
 #include "EventConverter.h"
 #include "JJ2Anims.h"
 #include "JJ2Data.h"
@@ -13,6 +14,10 @@
 #include <IO/FileSystem.h>
 #include <IO/PakFile.h>
 
+#if defined(WITH_THREADS)
+#	include "../../nCine/Threading/ParallelFor.h"
+#endif
+
 using namespace Death::Containers::Literals;
 using namespace Death::IO;
 
@@ -103,6 +108,32 @@ namespace Jazz2::Compatibility
 			whatever it points at next, and so on. Levels are keyed by file name because that is what the exits
 			refer to - a level's own recorded name is not always the same thing.
 		*/
+		/** @brief Level to convert, and what the converted level needs from the rest of the source directory */
+		struct LevelJob
+		{
+			String SourcePath;
+			String OutputPath;
+			String TargetPath;
+			SmallVector<String, 0> UsedTilesets;
+			String UsedMusic;
+			std::uint64_t SourceHash = 0;
+			bool IsConverted = false;
+		};
+
+		/** @brief Tileset to convert, if it's not up-to-date already */
+		struct TilesetJob
+		{
+			StringView Name;
+			std::uint64_t SourceHash = 0;
+			bool IsConverted = false;
+		};
+
+		/** @brief Returns the combined hash of all source files the package is converted from */
+		std::uint64_t HashSourceAssets(StringView animsPath, StringView sourcePath)
+		{
+			return AssetManifest::HashFile(fs::CombinePath(sourcePath, "Data.j2d"_s), AssetManifest::HashFile(animsPath));
+		}
+
 		void CollectEpisodeLevels(const HashMap<String, String>& levelFiles, StringView firstLevel,
 			HashMap<String, bool>& reachable)
 		{
@@ -146,7 +177,21 @@ namespace Jazz2::Compatibility
 			return Result::CannotWriteTarget;
 		}
 
-		return ConvertSourceAssets(animsPath, sourcePath, pakWriter, version);
+		Result result = ConvertSourceAssets(animsPath, sourcePath, pakWriter, version);
+		if (result == Result::Success) {
+			pakWriter.Finalize();
+
+			AssetManifest manifest(targetPath);
+			manifest.Update(packageName, HashSourceAssets(animsPath, sourcePath));
+			manifest.Save();
+		}
+		return result;
+	}
+
+	bool AssetConverter::IsSourceAssetsUpToDate(StringView animsPath, StringView sourcePath, StringView targetPath, StringView packageName)
+	{
+		AssetManifest manifest(targetPath);
+		return manifest.IsUpToDate(packageName, HashSourceAssets(animsPath, sourcePath));
 	}
 
 	AssetConverter::Result AssetConverter::ConvertSourceAssets(StringView animsPath, StringView sourcePath,
@@ -168,6 +213,7 @@ namespace Jazz2::Compatibility
 	void AssetConverter::ConvertLevels(StringView sourcePath, StringView targetPath, bool recreateAll)
 	{
 		ConversionOptions everything;
+		everything.TrackChanges = true;
 		ConvertLevels(sourcePath, targetPath, recreateAll, everything);
 	}
 
@@ -326,6 +372,9 @@ namespace Jazz2::Compatibility
 	}
 
 	HashMap<String, bool> usedTilesets, usedMusic;
+	// Levels are only collected while walking the directory and converted all at once afterwards
+	SmallVector<LevelJob, 0> levelJobs;
+	HashMap<String, std::uint32_t> levelJobIndices;
 
 	// What the filter allows through is decided up front, because it depends on the directory as a whole:
 	// which levels each episode can reach can only be answered once every level's file is known
@@ -428,65 +477,38 @@ namespace Jazz2::Compatibility
 					}
 				}
 
-				if (!recreateAll) {
-					StringUtils::lowercaseInPlace(levelName);
+				// The converted level is named after the lowercase file name (see JJ2Level::Open()), so where it goes
+				// is known before it is opened
+				StringUtils::lowercaseInPlace(levelName);
 
-					String fullPath;
-					auto it = knownLevels.find(levelName);
-					if (it != knownLevels.end()) {
-						if (it->second.second().empty()) {
-							fullPath = fs::CombinePath({ episodesPath, it->second.first(), String(levelName + ".j2l"_s) });
-						} else {
-							fullPath = fs::CombinePath({ episodesPath, it->second.first(), String(it->second.second() + '_' + levelName + ".j2l"_s) });
-						}
+				String outputPath;
+				auto it = knownLevels.find(levelName);
+				if (it != knownLevels.end()) {
+					if (it->second.second().empty()) {
+						outputPath = fs::CombinePath({ "Episodes"_s, it->second.first(), String(levelName + ".j2l"_s) });
 					} else {
-						fullPath = fs::CombinePath({ episodesPath, "unknown"_s, String(levelName + ".j2l"_s) });
-					}
-
-					if (fs::FileExists(fullPath)) {
-						continue;
+						outputPath = fs::CombinePath({ "Episodes"_s, it->second.first(), String(it->second.second() + '_' + levelName + ".j2l"_s) });
 					}
+				} else {
+					outputPath = fs::CombinePath({ "Episodes"_s, "unknown"_s, String(levelName + ".j2l"_s) });
 				}
 
-				Compatibility::JJ2Level level;
-				if (level.Open(item, false)) {
-					String fullPath;
-					auto it = knownLevels.find(level.LevelName);
-					if (it != knownLevels.end()) {
-						if (it->second.second().empty()) {
-							fullPath = fs::CombinePath({ episodesPath, it->second.first(), String(level.LevelName + ".j2l"_s) });
-						} else {
-							fullPath = fs::CombinePath({ episodesPath, it->second.first(), String(it->second.second() + '_' + level.LevelName + ".j2l"_s) });
-						}
-					} else {
-						fullPath = fs::CombinePath({ episodesPath, "unknown"_s, String(level.LevelName + ".j2l"_s) });
-					}
-
-					fs::CreateDirectories(fs::GetDirectoryName(fullPath));
-					level.Convert(fullPath, eventConverter, LevelTokenConversion);
-
-					usedTilesets.emplace(level.Tileset, true);
-					for (auto& extraTileset : level.ExtraTilesets) {
-						usedTilesets.emplace(extraTileset.Name, true);
-					}
-					if (!level.Music.empty()) {
-						// Recorded exactly as the converted level will ask for it: the original data leaves the
-						// extension off its own music, and JJ2Level::Convert fills in ".j2b" (see there)
-						String music = StringUtils::lowercase(level.Music);
-						if (music.find('.') == nullptr) {
-							music += ".j2b"_s;
-						}
-						usedMusic.emplace(std::move(music), true);
-					}
+				String fullPath = fs::CombinePath(targetPath, outputPath);
+				// With the manifest, existing levels are checked for changes later, all at once
+				if (!recreateAll && !options.TrackChanges && fs::FileExists(fullPath)) {
+					continue;
+				}
 
-					// Also copy level script file if exists
-					StringView foundDot = item.findLastOr('.', item.end());
-					String scriptPath = item.prefix(foundDot.begin()) + ".j2as"_s;
-					auto adjustedPath = fs::FindPathCaseInsensitive(scriptPath);
-					if (fs::IsReadableFile(adjustedPath)) {
-						foundDot = fullPath.findLastOr('.', fullPath.end());
-						fs::Copy(adjustedPath, String(fullPath.prefix(foundDot.begin()) + ".j2as"_s));
-					}
+				// If more files lead to the same level, the last one was always the one that ended up there
+				auto jobIt = levelJobIndices.find(outputPath);
+				if (jobIt != levelJobIndices.end()) {
+					levelJobs[jobIt->second].SourcePath = item;
+				} else {
+					levelJobIndices.emplace(outputPath, std::uint32_t(levelJobs.size()));
+					auto& job = levelJobs.emplace_back();
+					job.SourcePath = item;
+					job.OutputPath = std::move(outputPath);
+					job.TargetPath = std::move(fullPath);
 				}
 			}
 		}
@@ -503,6 +525,85 @@ namespace Jazz2::Compatibility
 #endif
 	}
 
+	std::unique_ptr<AssetManifest> manifest;
+	if (options.TrackChanges) {
+		manifest = std::make_unique<AssetManifest>(targetPath);
+	}
+
+	if (!levelJobs.empty()) {
+		LOGI("Converting levels...");
+
+		// Directories are created up front, so concurrent jobs never race to create the same one
+		for (auto& job : levelJobs) {
+			fs::CreateDirectories(fs::GetDirectoryName(job.TargetPath));
+		}
+
+		RunJobs(std::uint32_t(levelJobs.size()), [&levelJobs, &eventConverter, &LevelTokenConversion, &manifest](std::uint32_t index) {
+			LevelJob& job = levelJobs[index];
+
+			// The level script is copied alongside, so it's a part of the level too
+			StringView foundDot = job.SourcePath.findLastOr('.', job.SourcePath.end());
+			String scriptPath = job.SourcePath.prefix(foundDot.begin()) + ".j2as"_s;
+			auto adjustedScriptPath = fs::FindPathCaseInsensitive(scriptPath);
+			bool hasScript = fs::IsReadableFile(adjustedScriptPath);
+
+			if (manifest != nullptr) {
+				job.SourceHash = AssetManifest::HashFile(job.SourcePath);
+				if (hasScript) {
+					job.SourceHash = AssetManifest::HashFile(adjustedScriptPath, job.SourceHash);
+				}
+				if (manifest->IsUpToDate(job.OutputPath, job.SourceHash)) {
+					return;
+				}
+			}
+
+			Compatibility::JJ2Level level;
+			if (!level.Open(job.SourcePath, false)) {
+				return;
+			}
+
+			level.Convert(job.TargetPath, eventConverter, LevelTokenConversion);
+			job.IsConverted = true;
+
+			job.UsedTilesets.push_back(level.Tileset);
+			for (auto& extraTileset : level.ExtraTilesets) {
+				job.UsedTilesets.push_back(extraTileset.Name);
+			}
+			if (!level.Music.empty()) {
+				// Recorded exactly as the converted level will ask for it: the original data leaves the
+				// extension off its own music, and JJ2Level::Convert fills in ".j2b" (see there)
+				job.UsedMusic = StringUtils::lowercase(level.Music);
+				if (job.UsedMusic.find('.') == nullptr) {
+					job.UsedMusic += ".j2b"_s;
+				}
+			}
+
+			// Also copy level script file if exists
+			if (hasScript) {
+				foundDot = job.TargetPath.findLastOr('.', job.TargetPath.end());
+				fs::Copy(adjustedScriptPath, String(job.TargetPath.prefix(foundDot.begin()) + ".j2as"_s));
+			}
+		});
+
+		std::int32_t convertedCount = 0;
+		for (auto& job : levelJobs) {
+			if (!job.IsConverted) {
+				continue;
+			}
+			convertedCount++;
+			if (manifest != nullptr) {
+				manifest->Update(job.OutputPath, job.SourceHash);
+			}
+			for (auto& tileset : job.UsedTilesets) {
+				usedTilesets.emplace(std::move(tileset), true);
+			}
+			if (!job.UsedMusic.empty()) {
+				usedMusic.emplace(std::move(job.UsedMusic), true);
+			}
+		}
+		LOGI("{} levels converted, {} up-to-date", convertedCount, std::int32_t(levelJobs.size()) - convertedCount);
+	}
+
 	if (options.CopyUsedMusic && !usedMusic.empty()) {
 		// The music is not converted, only carried over - but only what the levels that survived the filter
 		// ask for, the same way the tilesets are. The game looks for it in a "Music" directory of its own,
@@ -527,25 +628,74 @@ namespace Jazz2::Compatibility
 		LOGI("{} music files copied", copied);
 	}
 
+	String tilesetsPath = fs::CombinePath(targetPath, "Tilesets"_s);
+	if (manifest != nullptr && !recreateAll) {
+		// Tilesets converted before are checked too, their source could have changed even if no level did
+		for (auto item : fs::Directory(tilesetsPath, fs::EnumerationOptions::SkipDirectories)) {
+			if (fs::GetExtension(item) == "j2t"_s) {
+				usedTilesets.emplace(String(fs::GetFileNameWithoutExtension(item)), true);
+			}
+		}
+	}
+
 	if (recreateAll || !usedTilesets.empty()) {
 		// Convert only used tilesets
 		LOGI("Converting used tilesets...");
-		String tilesetsPath = fs::CombinePath(targetPath, "Tilesets"_s);
 		if (recreateAll) {
 			fs::RemoveDirectoryRecursive(tilesetsPath);
 			fs::CreateDirectories(tilesetsPath);
 		}
 
+		SmallVector<TilesetJob, 0> tilesetJobs;
+		tilesetJobs.reserve(usedTilesets.size());
 		for (auto& pair : usedTilesets) {
-			String tilesetPath = fs::CombinePath(sourcePath, String(pair.first + ".j2t"_s));
-			auto adjustedPath = fs::FindPathCaseInsensitive(tilesetPath);
-			if (fs::IsReadableFile(adjustedPath)) {
-				Compatibility::JJ2Tileset tileset;
-				if (tileset.Open(adjustedPath, false)) {
-					tileset.Convert(fs::CombinePath({ tilesetsPath, String(pair.first + ".j2t"_s) }));
+			tilesetJobs.emplace_back().Name = pair.first;
+		}
+
+		RunJobs(std::uint32_t(tilesetJobs.size()), [&tilesetJobs, sourcePath, &tilesetsPath, &manifest](std::uint32_t index) {
+			TilesetJob& job = tilesetJobs[index];
+			String fileName = job.Name + ".j2t"_s;
+			auto adjustedPath = fs::FindPathCaseInsensitive(fs::CombinePath(sourcePath, fileName));
+			if (!fs::IsReadableFile(adjustedPath)) {
+				return;
+			}
+
+			if (manifest != nullptr) {
+				job.SourceHash = AssetManifest::HashFile(adjustedPath);
+				if (manifest->IsUpToDate(fs::CombinePath("Tilesets"_s, fileName), job.SourceHash)) {
+					return;
+				}
+			}
+
+			Compatibility::JJ2Tileset tileset;
+			if (tileset.Open(adjustedPath, false)) {
+				tileset.Convert(fs::CombinePath(tilesetsPath, fileName));
+				job.IsConverted = true;
+			}
+		});
+
+		if (manifest != nullptr) {
+			for (auto& job : tilesetJobs) {
+				if (job.IsConverted) {
+					manifest->Update(fs::CombinePath("Tilesets"_s, String(job.Name + ".j2t"_s)), job.SourceHash);
 				}
 			}
 		}
 	}
+
+	if (manifest != nullptr) {
+		manifest->Save();
+	}
+	}
+
+	void AssetConverter::RunJobs(std::uint32_t count, Function<void(std::uint32_t)>&& job)
+	{
+#if defined(WITH_THREADS)
+		nCine::ParallelFor(count, std::move(job));
+#else
+		for (std::uint32_t i = 0; i < count; i++) {
+			job(i);
+		}
+#endif
 	}
 }
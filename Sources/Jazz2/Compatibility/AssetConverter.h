@@ -2,6 +2,7 @@
 
 #include "JJ2Version.h"
 
+#include <Containers/Function.h>
 #include <Containers/SmallVector.h>
 #include <Containers/String.h>
 #include <Containers/StringView.h>
@@ -71,6 +72,14 @@ namespace Jazz2::Compatibility
 				files, and never looks in the cache - so copying it there would only take up space.
 			*/
 			bool CopyUsedMusic = false;
+			/**
+				@brief Keep a manifest of converted files, so only what changed is converted next time
+
+				Levels and tilesets whose source files still hash the same as when they were last converted, by
+				the same converter, are skipped. Without it, a level is skipped whenever its output exists, even if
+				its source has changed since. See @ref AssetManifest.
+			*/
+			bool TrackChanges = false;
 			/** @brief Receives the name of every level that was skipped, so a caller can report them */
 			SmallVectorImpl<String>* SkippedLevels = nullptr;
 		};
@@ -103,10 +112,33 @@ namespace Jazz2::Compatibility
 		*/
 		static Result ConvertSourceAssets(StringView animsPath, StringView sourcePath,
 			Death::IO::PakWriter& pakWriter, JJ2Version& version);
+		/**
+			@brief Returns `true` if the package was converted from the same source files by the same converter
 
-		/** @brief Converts every episode, level and used tileset into the output directory */
+			Only a package written by @ref ConvertSourceAssets(StringView, StringView, StringView, JJ2Version&, StringView)
+			is recorded, so it's always `false` for a package that was not converted into @p targetPath.
+		*/
+		static bool IsSourceAssetsUpToDate(StringView animsPath, StringView sourcePath, StringView targetPath,
+			StringView packageName = SourcePackage);
+
+		/**
+			@brief Converts every episode, level and used tileset into the output directory
+
+			Changes are tracked (see @ref ConversionOptions::TrackChanges), so unless @p recreateAll is set,
+			only levels and tilesets whose source files changed since the last run are converted again.
+		*/
 		static void ConvertLevels(StringView sourcePath, StringView targetPath, bool recreateAll);
 		/** @brief Converts the episodes, levels and used tilesets that @p options allow into the output directory */
 		static void ConvertLevels(StringView sourcePath, StringView targetPath, bool recreateAll, const ConversionOptions& options);
+
+		/**
+			@brief Runs @p job for every index in range `[0, count)`, on the thread pool if there is one
+
+			Conversion jobs are independent of each other and each of them writes only its own output, so they can
+			be spread across threads. Whatever has to end up in a shared place (like a .pak file) is expected
+			to be collected per index and written afterwards in index order, so the output does not depend on
+			how the jobs were scheduled. Without threading support, the jobs simply run one after another.
+		*/
+		static void RunJobs(std::uint32_t count, Function<void(std::uint32_t)>&& job);
 	};
 }
@@ -0,0 +1,122 @@
+﻿#include "AssetManifest.h"
+#include "JJ2Anims.h"
+#include "../ContentFileTypes.h"
+#include "../EventType.h"
+
+#include <memory>
+
+#include <Cryptography/xxHash.h>
+#include <IO/FileSystem.h>
+
+using namespace Death::IO;
+
+namespace Jazz2::Compatibility
+{
+	AssetManifest::AssetManifest(StringView targetPath)
+		: _targetPath(targetPath), _isDirty(false)
+	{
+		auto s = fs::Open(fs::CombinePath(targetPath, FileName), FileAccess::Read);
+		if (s->GetSize() < 16) {
+			return;
+		}
+
+		std::uint64_t signature = s->ReadValueAsLE<std::uint64_t>();
+		std::uint8_t fileType = s->ReadValue<std::uint8_t>();
+		std::uint16_t version = s->ReadValueAsLE<std::uint16_t>();
+		if (signature != 0x2095A59FF0BFBBEF || fileType != ContentFileType::CacheManifest || version != FormatVersion) {
+			LOGW("Manifest in \"{}\" is not supported, all outputs will be converted again", targetPath);
+			return;
+		}
+
+		std::uint32_t entryCount = s->ReadValueAsLE<std::uint32_t>();
+		for (std::uint32_t i = 0; i < entryCount; i++) {
+			std::uint16_t pathLength = s->ReadValueAsLE<std::uint16_t>();
+			String path{NoInit, pathLength};
+			if (s->Read(path.data(), pathLength) != pathLength) {
+				LOGW("Manifest in \"{}\" is truncated", targetPath);
+				break;
+			}
+			Entry entry;
+			entry.SourceHash = s->ReadValueAsLE<std::uint64_t>();
+			entry.ConverterVersion = s->ReadValueAsLE<std::uint64_t>();
+			_entries.emplace(std::move(path), entry);
+		}
+	}
+
+	bool AssetManifest::IsUpToDate(StringView outputPath, std::uint64_t sourceHash) const
+	{
+		auto it = _entries.find(String::nullTerminatedView(outputPath));
+		if (it == _entries.end() || it->second.SourceHash != sourceHash || it->second.ConverterVersion != GetConverterVersion()) {
+			return false;
+		}
+
+		return fs::FileExists(fs::CombinePath(_targetPath, outputPath));
+	}
+
+	void AssetManifest::Update(StringView outputPath, std::uint64_t sourceHash)
+	{
+		Entry& entry = _entries[String(outputPath)];
+		entry.SourceHash = sourceHash;
+		entry.ConverterVersion = GetConverterVersion();
+		_isDirty = true;
+	}
+
+	bool AssetManifest::Save()
+	{
+		for (auto it = _entries.begin(); it != _entries.end(); ) {
+			if (!fs::FileExists(fs::CombinePath(_targetPath, it->first))) {
+				_entries.erase(it++);
+				_isDirty = true;
+			} else {
+				++it;
+			}
+		}
+
+		if (!_isDirty) {
+			return true;
+		}
+
+		auto so = fs::Open(fs::CombinePath(_targetPath, FileName), FileAccess::Write);
+		if (!so->IsValid()) {
+			LOGW("Cannot open manifest in \"{}\" for writing", _targetPath);
+			return false;
+		}
+
+		so->WriteValueAsLE<std::uint64_t>(0x2095A59FF0BFBBEF);	// Signature
+		so->WriteValue<std::uint8_t>(ContentFileType::CacheManifest);
+		so->WriteValueAsLE<std::uint16_t>(FormatVersion);
+		so->WriteValueAsLE<std::uint32_t>(std::uint32_t(_entries.size()));
+
+		for (auto& [path, entry] : _entries) {
+			so->WriteValueAsLE<std::uint16_t>(std::uint16_t(path.size()));
+			so->Write(path.data(), std::int64_t(path.size()));
+			so->WriteValueAsLE<std::uint64_t>(entry.SourceHash);
+			so->WriteValueAsLE<std::uint64_t>(entry.ConverterVersion);
+		}
+
+		_isDirty = false;
+		return true;
+	}
+
+	std::uint64_t AssetManifest::GetConverterVersion()
+	{
+		// Converted levels depend also on the list of known events, see EventConverter
+		return (std::uint64_t(JJ2Anims::CacheVersion) << 32) | (std::uint64_t(EventType::Count) << 16) | FormatVersion;
+	}
+
+	std::uint64_t AssetManifest::HashFile(StringView path, std::uint64_t seed)
+	{
+		auto s = fs::Open(path, FileAccess::Read);
+		std::int64_t size = s->GetSize();
+		if (size <= 0) {
+			return seed;
+		}
+
+		std::unique_ptr<std::uint8_t[]> buffer = std::make_unique<std::uint8_t[]>(size);
+		if (s->Read(buffer.get(), size) != size) {
+			return seed;
+		}
+
+		return Death::Cryptography::xxHash3(buffer.get(), std::size_t(size), seed);
+	}
+}
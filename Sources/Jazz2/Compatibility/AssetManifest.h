@@ -0,0 +1,59 @@
+﻿#pragma once
+
+#include "../../Main.h"
+#include "../../nCine/Base/HashMap.h"
+
+#include <Containers/String.h>
+#include <Containers/StringView.h>
+
+using namespace Death::Containers;
+using namespace Death::Containers::Literals;
+using namespace nCine;
+
+namespace Jazz2::Compatibility
+{
+	/**
+		@brief Records which source files and converter version each converted output came from
+
+		Every entry is keyed by the output path relative to the target directory and holds an **xxHash3**
+		digest of the source files it was converted from, together with @ref GetConverterVersion() at that
+		time. An output is considered up-to-date only if it still exists, its sources hash to the same value
+		and the converter has not changed since, so only what has actually changed has to be converted again.
+	*/
+	class AssetManifest
+	{
+	public:
+		/** @brief Name of the manifest file inside the target directory */
+		static constexpr StringView FileName = "Manifest.idx"_s;
+
+		/** @brief Loads the manifest of the specified target directory, it's empty if there is none yet */
+		explicit AssetManifest(StringView targetPath);
+
+		AssetManifest(const AssetManifest&) = delete;
+		AssetManifest& operator=(const AssetManifest&) = delete;
+
+		/** @brief Returns `true` if the output exists and was converted from the same sources by the current converter */
+		bool IsUpToDate(StringView outputPath, std::uint64_t sourceHash) const;
+		/** @brief Records that the output was just converted from sources with the specified hash */
+		void Update(StringView outputPath, std::uint64_t sourceHash);
+		/** @brief Writes the manifest back if it was changed, entries of outputs that no longer exist are dropped */
+		bool Save();
+
+		/** @brief Returns version of the converter, outputs converted by any other version are out of date */
+		static std::uint64_t GetConverterVersion();
+		/** @brief Returns hash of the file contents mixed with @p seed, or @p seed if the file cannot be read */
+		static std::uint64_t HashFile(StringView path, std::uint64_t seed = 0);
+
+	private:
+		static constexpr std::uint16_t FormatVersion = 1;
+
+		struct Entry {
+			std::uint64_t SourceHash;
+			std::uint64_t ConverterVersion;
+		};
+
+		String _targetPath;
+		HashMap<String, Entry> _entries;
+		bool _isDirty;
+	};
+}
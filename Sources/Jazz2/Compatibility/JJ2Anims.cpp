@@ -2,8 +2,10 @@
 #include "JJ2Anims.Palettes.h"
 #include "JJ2Block.h"
 #include "AnimSetMapping.h"
+#include "AssetConverter.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdlib>
 
 #include <Containers/GrowableArray.h>
@@ -174,6 +176,9 @@ namespace Jazz2::Compatibility
 		// Read content
 		bool isStreamComplete = true;
 
+		SmallVector<SetSection, 0> sets;
+		sets.reserve(setCount);
+
 		for (std::int32_t i = 0; i < setCount; i++) {
 			if (s->GetPosition() >= s->GetSize()) {
 				isStreamComplete = false;
@@ -186,192 +191,50 @@ namespace Jazz2::Compatibility
 			std::uint8_t sndCount = s->ReadValue<std::uint8_t>();
 			/*std::uint16_t frameCount =*/ s->ReadValueAsLE<std::uint16_t>();
 			/*std::uint32_t cumulativeSndIndex =*/ s->ReadValueAsLE<std::uint32_t>();
-			std::int32_t infoBlockLenC = s->ReadValueAsLE<std::int32_t>();
-			std::int32_t infoBlockLenU = s->ReadValueAsLE<std::int32_t>();
-			std::int32_t frameDataBlockLenC = s->ReadValueAsLE<std::int32_t>();
-			std::int32_t frameDataBlockLenU = s->ReadValueAsLE<std::int32_t>();
-			std::int32_t imageDataBlockLenC = s->ReadValueAsLE<std::int32_t>();
-			std::int32_t imageDataBlockLenU = s->ReadValueAsLE<std::int32_t>();
-			std::int32_t sampleDataBlockLenC = s->ReadValueAsLE<std::int32_t>();
-			std::int32_t sampleDataBlockLenU = s->ReadValueAsLE<std::int32_t>();
-
-			JJ2Block infoBlock(s, infoBlockLenC, infoBlockLenU);
-			JJ2Block frameDataBlock(s, frameDataBlockLenC, frameDataBlockLenU);
-			JJ2Block imageDataBlock(s, imageDataBlockLenC, imageDataBlockLenU);
-			JJ2Block sampleDataBlock(s, sampleDataBlockLenC, sampleDataBlockLenU);
+
+			SetSection set;
+			set.Index = i;
+			set.AnimCount = animCount;
+			set.SampleCount = sndCount;
+			for (std::int32_t j = 0; j < 4; j++) {
+				set.BlockLength[j] = std::max(s->ReadValueAsLE<std::int32_t>(), 0);
+				set.BlockUncompressedLength[j] = s->ReadValueAsLE<std::int32_t>();
+			}
+			// Only raw bytes are read here, blocks are decompressed and parsed later, independently of each other
+			for (std::int32_t j = 0; j < 4; j++) {
+				set.BlockData[j] = std::make_unique<std::uint8_t[]>(set.BlockLength[j]);
+				s->Read(set.BlockData[j].get(), set.BlockLength[j]);
+			}
 
 			if (magicANIM != 0x4D494E41) {
 				LOGD("Header for set {} is incorrect (bad magic value), skipping", i);
 				continue;
 			}
 
-			for (std::uint16_t j = 0; j < animCount; j++) {
-				AnimSection& anim = anims.emplace_back();
-				anim.Set = i;
-				anim.Anim = j;
-				anim.FrameCount = infoBlock.ReadUInt16();
-				anim.FrameRate = infoBlock.ReadUInt16();
-				anim.Frames.resize(anim.FrameCount);
-
-				// Skip the rest, seems to be 0x00000000 for all headers
-				infoBlock.DiscardBytes(4);
-
-				if (anim.FrameCount > 0) {
-					for (std::uint16_t k = 0; k < anim.FrameCount; k++) {
-						AnimFrameSection& frame = anim.Frames[k];
-
-						frame.SizeX = frameDataBlock.ReadInt16();
-						frame.SizeY = frameDataBlock.ReadInt16();
-						frame.ColdspotX = frameDataBlock.ReadInt16();
-						frame.ColdspotY = frameDataBlock.ReadInt16();
-						frame.HotspotX = frameDataBlock.ReadInt16();
-						frame.HotspotY = frameDataBlock.ReadInt16();
-						frame.GunspotX = frameDataBlock.ReadInt16();
-						frame.GunspotY = frameDataBlock.ReadInt16();
-
-						frame.ImageAddr = frameDataBlock.ReadInt32();
-						frame.MaskAddr = frameDataBlock.ReadInt32();
-
-						// Adjust normalized position
-						// In the output images, we want to make the hotspot and image size constant.
-						anim.NormalizedHotspotX = std::max((std::int16_t)-frame.HotspotX, anim.NormalizedHotspotX);
-						anim.NormalizedHotspotY = std::max((std::int16_t)-frame.HotspotY, anim.NormalizedHotspotY);
-
-						anim.LargestOffsetX = std::max((std::int16_t)(frame.SizeX + frame.HotspotX), anim.LargestOffsetX);
-						anim.LargestOffsetY = std::max((std::int16_t)(frame.SizeY + frame.HotspotY), anim.LargestOffsetY);
-
-						anim.AdjustedSizeX = std::max(
-							(std::int16_t)(anim.NormalizedHotspotX + anim.LargestOffsetX),
-							anim.AdjustedSizeX
-						);
-						anim.AdjustedSizeY = std::max(
-							(std::int16_t)(anim.NormalizedHotspotY + anim.LargestOffsetY),
-							anim.AdjustedSizeY
-						);
-
-						std::int32_t dpos = (frame.ImageAddr + 4);
-
-						imageDataBlock.SeekTo(dpos - 4);
-						std::uint16_t width2 = imageDataBlock.ReadUInt16();
-						imageDataBlock.SeekTo(dpos - 2);
-						/*std::uint16_t height2 =*/ imageDataBlock.ReadUInt16();
-
-						frame.DrawTransparent = (width2 & 0x8000) > 0;
-
-						std::int32_t pxRead = 0;
-						std::int32_t pxTotal = (frame.SizeX * frame.SizeY);
-						bool lastOpEmpty = true;
-
-						frame.ImageData = std::make_unique<std::uint8_t[]>(pxTotal);
-
-						imageDataBlock.SeekTo(dpos);
-
-						while (pxRead < pxTotal) {
-							std::uint8_t op = imageDataBlock.ReadByte();
-							if (op < 0x80) {
-								// Skip the given number of pixels, writing them with the transparent color 0, array should be already zeroed
-								pxRead += op;
-							} else if (op == 0x80) {
-								// Skip until the end of the line, array should be already zeroed
-								std::uint16_t linePxLeft = (std::uint16_t)(frame.SizeX - pxRead % frame.SizeX);
-								if (pxRead % frame.SizeX == 0 && !lastOpEmpty) {
-									linePxLeft = 0;
-								}
-
-								pxRead += linePxLeft;
-							} else {
-								// Copy specified amount of pixels (ignoring the high bit)
-								std::uint16_t bytesToRead = (std::uint16_t)(op & 0x7F);
-								imageDataBlock.ReadRawBytes(frame.ImageData.get() + pxRead, bytesToRead);
-								pxRead += bytesToRead;
-							}
-
-							lastOpEmpty = (op == 0x80);
-						}
-
-						// TODO: Sprite mask
-						/*frame.MaskData = std::make_unique<std::uint8_t[]>(pxTotal);
-
-						if (frame.MaskAddr != 0xFFFFFFFF) {
-							imageDataBlock.SeekTo(frame.MaskAddr);
-							pxRead = 0;
-							while (pxRead < pxTotal) {
-								std::uint8_t b = imageDataBlock.ReadByte();
-								for (std::uint8_t bit = 0; bit < 8 && (pxRead + bit) < pxTotal; ++bit) {
-									frame.MaskData[pxRead + bit] = ((b & (1 << (7 - bit))) != 0);
-								}
-								pxRead += 8;
-							}
-						}*/
-					}
-				}
-			}
-
 			if (i == 65 && animCount > 5) {
 				seemsLikeCC = true;
 			}
 
-			for (std::uint16_t j = 0; j < sndCount; j++) {
-				SampleSection& sample = samples.emplace_back();
-				sample.IdInSet = j;
-				sample.Set = i;
-
-				std::int32_t totalSize = sampleDataBlock.ReadInt32();
-				std::uint32_t magicRIFF = sampleDataBlock.ReadUInt32();
-				std::int32_t chunkSize = sampleDataBlock.ReadInt32();
-				// "ASFF" for 1.20, "AS  " for 1.24
-				std::uint32_t format = sampleDataBlock.ReadUInt32();
-				DEATH_ASSERT(format == 0x46465341 || format == 0x20205341, "Invalid sound format", JJ2Version::Unknown);
-				bool isASFF = (format == 0x46465341);
-
-				std::uint32_t magicSAMP = sampleDataBlock.ReadUInt32();
-				/*std::uint32_t sampSize =*/ sampleDataBlock.ReadUInt32();
-				DEATH_ASSERT(magicRIFF == 0x46464952 && magicSAMP == 0x504D4153, "Invalid sound format", JJ2Version::Unknown);
-
-				// Padding/unknown data #1
-				// For set 0 sample 0:
-				//       1.20                           1.24
-				//  +00  00 00 00 00 00 00 00 00   +00  40 00 00 00 00 00 00 00
-				//  +08  00 00 00 00 00 00 00 00   +08  00 00 00 00 00 00 00 00
-				//  +10  00 00 00 00 00 00 00 00   +10  00 00 00 00 00 00 00 00
-				//  +18  00 00 00 00               +18  00 00 00 00 00 00 00 00
-				//                                 +20  00 00 00 00 00 40 FF 7F
-				sampleDataBlock.DiscardBytes(40 - (isASFF ? 12 : 0));
-				if (isASFF) {
-					// All 1.20 samples seem to be 8-bit. Some of them are among those
-					// for which 1.24 reads as 24-bit but that might just be a mistake.
-					sampleDataBlock.DiscardBytes(2);
-					sample.Multiplier = 0;
-				} else {
-					// for 1.24. 1.20 has "20 40" instead in s0s0 which makes no sense
-					sample.Multiplier = sampleDataBlock.ReadUInt16();
-				}
-				// Unknown. s0s0 1.20: 00 80, 1.24: 80 00
-				sampleDataBlock.DiscardBytes(2);
-
-				/*uint32_t payloadSize =*/ sampleDataBlock.ReadUInt32();
-				// Padding #2, all zeroes in both
-				sampleDataBlock.DiscardBytes(8);
-
-				sample.SampleRate = sampleDataBlock.ReadUInt32();
-				sample.DataSize = chunkSize - 76 + (isASFF ? 12 : 0);
-
-				sample.Data = std::make_unique<std::uint8_t[]>(sample.DataSize);
-				sampleDataBlock.ReadRawBytes(sample.Data.get(), sample.DataSize);
-				// Padding #3
-				sampleDataBlock.DiscardBytes(4);
-
-				/*if (sample.Data.Length < actualDataSize) {
-					Log.Write(LogType.Warning, "Sample " + j + " in set " + i + " was shorter than expected! Expected "
-						+ actualDataSize + " bytes, but read " + sample.Data.Length + " instead.");
-				}*/
+			sets.push_back(std::move(set));
+		}
 
-				if (totalSize > chunkSize + 12) {
-					// Sample data is probably aligned to X bytes since the next sample doesn't always appear right after the first ends.
-					LOGW("Adjusting read offset of sample {} in set {} by {} bytes.", j, i, (totalSize - chunkSize - 12));
+		std::atomic_bool isSetInvalid{false};
+		AssetConverter::RunJobs(std::uint32_t(sets.size()), [&sets, &isSetInvalid](std::uint32_t index) {
+			if (!ParseSet(sets[index])) {
+				isSetInvalid = true;
+			}
+		});
+		if (isSetInvalid) {
+			return JJ2Version::Unknown;
+		}
 
-					sampleDataBlock.DiscardBytes(totalSize - chunkSize - 12);
-				}
+		// Sets are merged in the original order, so the output doesn't depend on how they were scheduled
+		for (auto& set : sets) {
+			for (auto& anim : set.Anims) {
+				anims.push_back(std::move(anim));
+			}
+			for (auto& sample : set.Samples) {
+				samples.push_back(std::move(sample));
 			}
 		}
 
@@ -417,6 +280,191 @@ namespace Jazz2::Compatibility
 		return version;
 	}
 
+	bool JJ2Anims::ParseSet(SetSection& set)
+	{
+		std::unique_ptr<Stream> blockStreams[4];
+		for (std::int32_t j = 0; j < 4; j++) {
+			blockStreams[j] = std::make_unique<MemoryStream>(set.BlockData[j].get(), set.BlockLength[j]);
+		}
+
+		JJ2Block infoBlock(blockStreams[0], set.BlockLength[0], set.BlockUncompressedLength[0]);
+		JJ2Block frameDataBlock(blockStreams[1], set.BlockLength[1], set.BlockUncompressedLength[1]);
+		JJ2Block imageDataBlock(blockStreams[2], set.BlockLength[2], set.BlockUncompressedLength[2]);
+		JJ2Block sampleDataBlock(blockStreams[3], set.BlockLength[3], set.BlockUncompressedLength[3]);
+
+		// Compressed data are no longer needed
+		for (std::int32_t j = 0; j < 4; j++) {
+			set.BlockData[j] = nullptr;
+		}
+
+		for (std::uint16_t j = 0; j < set.AnimCount; j++) {
+			AnimSection& anim = set.Anims.emplace_back();
+			anim.Set = set.Index;
+			anim.Anim = j;
+			anim.FrameCount = infoBlock.ReadUInt16();
+			anim.FrameRate = infoBlock.ReadUInt16();
+			anim.Frames.resize(anim.FrameCount);
+
+			// Skip the rest, seems to be 0x00000000 for all headers
+			infoBlock.DiscardBytes(4);
+
+			if (anim.FrameCount > 0) {
+				for (std::uint16_t k = 0; k < anim.FrameCount; k++) {
+					AnimFrameSection& frame = anim.Frames[k];
+
+					frame.SizeX = frameDataBlock.ReadInt16();
+					frame.SizeY = frameDataBlock.ReadInt16();
+					frame.ColdspotX = frameDataBlock.ReadInt16();
+					frame.ColdspotY = frameDataBlock.ReadInt16();
+					frame.HotspotX = frameDataBlock.ReadInt16();
+					frame.HotspotY = frameDataBlock.ReadInt16();
+					frame.GunspotX = frameDataBlock.ReadInt16();
+					frame.GunspotY = frameDataBlock.ReadInt16();
+
+					frame.ImageAddr = frameDataBlock.ReadInt32();
+					frame.MaskAddr = frameDataBlock.ReadInt32();
+
+					// Adjust normalized position
+					// In the output images, we want to make the hotspot and image size constant.
+					anim.NormalizedHotspotX = std::max((std::int16_t)-frame.HotspotX, anim.NormalizedHotspotX);
+					anim.NormalizedHotspotY = std::max((std::int16_t)-frame.HotspotY, anim.NormalizedHotspotY);
+
+					anim.LargestOffsetX = std::max((std::int16_t)(frame.SizeX + frame.HotspotX), anim.LargestOffsetX);
+					anim.LargestOffsetY = std::max((std::int16_t)(frame.SizeY + frame.HotspotY), anim.LargestOffsetY);
+
+					anim.AdjustedSizeX = std::max(
+						(std::int16_t)(anim.NormalizedHotspotX + anim.LargestOffsetX),
+						anim.AdjustedSizeX
+					);
+					anim.AdjustedSizeY = std::max(
+						(std::int16_t)(anim.NormalizedHotspotY + anim.LargestOffsetY),
+						anim.AdjustedSizeY
+					);
+
+					std::int32_t dpos = (frame.ImageAddr + 4);
+
+					imageDataBlock.SeekTo(dpos - 4);
+					std::uint16_t width2 = imageDataBlock.ReadUInt16();
+					imageDataBlock.SeekTo(dpos - 2);
+					/*std::uint16_t height2 =*/ imageDataBlock.ReadUInt16();
+
+					frame.DrawTransparent = (width2 & 0x8000) > 0;
+
+					std::int32_t pxRead = 0;
+					std::int32_t pxTotal = (frame.SizeX * frame.SizeY);
+					bool lastOpEmpty = true;
+
+					frame.ImageData = std::make_unique<std::uint8_t[]>(pxTotal);
+
+					imageDataBlock.SeekTo(dpos);
+
+					while (pxRead < pxTotal) {
+						std::uint8_t op = imageDataBlock.ReadByte();
+						if (op < 0x80) {
+							// Skip the given number of pixels, writing them with the transparent color 0, array should be already zeroed
+							pxRead += op;
+						} else if (op == 0x80) {
+							// Skip until the end of the line, array should be already zeroed
+							std::uint16_t linePxLeft = (std::uint16_t)(frame.SizeX - pxRead % frame.SizeX);
+							if (pxRead % frame.SizeX == 0 && !lastOpEmpty) {
+								linePxLeft = 0;
+							}
+
+							pxRead += linePxLeft;
+						} else {
+							// Copy specified amount of pixels (ignoring the high bit)
+							std::uint16_t bytesToRead = (std::uint16_t)(op & 0x7F);
+							imageDataBlock.ReadRawBytes(frame.ImageData.get() + pxRead, bytesToRead);
+							pxRead += bytesToRead;
+						}
+
+						lastOpEmpty = (op == 0x80);
+					}
+
+					// TODO: Sprite mask
+					/*frame.MaskData = std::make_unique<std::uint8_t[]>(pxTotal);
+
+					if (frame.MaskAddr != 0xFFFFFFFF) {
+						imageDataBlock.SeekTo(frame.MaskAddr);
+						pxRead = 0;
+						while (pxRead < pxTotal) {
+							std::uint8_t b = imageDataBlock.ReadByte();
+							for (std::uint8_t bit = 0; bit < 8 && (pxRead + bit) < pxTotal; ++bit) {
+								frame.MaskData[pxRead + bit] = ((b & (1 << (7 - bit))) != 0);
+							}
+							pxRead += 8;
+						}
+					}*/
+				}
+			}
+		}
+
+		for (std::uint16_t j = 0; j < set.SampleCount; j++) {
+			SampleSection& sample = set.Samples.emplace_back();
+			sample.IdInSet = j;
+			sample.Set = set.Index;
+
+			std::int32_t totalSize = sampleDataBlock.ReadInt32();
+			std::uint32_t magicRIFF = sampleDataBlock.ReadUInt32();
+			std::int32_t chunkSize = sampleDataBlock.ReadInt32();
+			// "ASFF" for 1.20, "AS  " for 1.24
+			std::uint32_t format = sampleDataBlock.ReadUInt32();
+			DEATH_ASSERT(format == 0x46465341 || format == 0x20205341, "Invalid sound format", false);
+			bool isASFF = (format == 0x46465341);
+
+			std::uint32_t magicSAMP = sampleDataBlock.ReadUInt32();
+			/*std::uint32_t sampSize =*/ sampleDataBlock.ReadUInt32();
+			DEATH_ASSERT(magicRIFF == 0x46464952 && magicSAMP == 0x504D4153, "Invalid sound format", false);
+
+			// Padding/unknown data #1
+			// For set 0 sample 0:
+			//       1.20                           1.24
+			//  +00  00 00 00 00 00 00 00 00   +00  40 00 00 00 00 00 00 00
+			//  +08  00 00 00 00 00 00 00 00   +08  00 00 00 00 00 00 00 00
+			//  +10  00 00 00 00 00 00 00 00   +10  00 00 00 00 00 00 00 00
+			//  +18  00 00 00 00               +18  00 00 00 00 00 00 00 00
+			//                                 +20  00 00 00 00 00 40 FF 7F
+			sampleDataBlock.DiscardBytes(40 - (isASFF ? 12 : 0));
+			if (isASFF) {
+				// All 1.20 samples seem to be 8-bit. Some of them are among those
+				// for which 1.24 reads as 24-bit but that might just be a mistake.
+				sampleDataBlock.DiscardBytes(2);
+				sample.Multiplier = 0;
+			} else {
+				// for 1.24. 1.20 has "20 40" instead in s0s0 which makes no sense
+				sample.Multiplier = sampleDataBlock.ReadUInt16();
+			}
+			// Unknown. s0s0 1.20: 00 80, 1.24: 80 00
+			sampleDataBlock.DiscardBytes(2);
+
+			/*uint32_t payloadSize =*/ sampleDataBlock.ReadUInt32();
+			// Padding #2, all zeroes in both
+			sampleDataBlock.DiscardBytes(8);
+
+			sample.SampleRate = sampleDataBlock.ReadUInt32();
+			sample.DataSize = chunkSize - 76 + (isASFF ? 12 : 0);
+
+			sample.Data = std::make_unique<std::uint8_t[]>(sample.DataSize);
+			sampleDataBlock.ReadRawBytes(sample.Data.get(), sample.DataSize);
+			// Padding #3
+			sampleDataBlock.DiscardBytes(4);
+
+			/*if (sample.Data.Length < actualDataSize) {
+				Log.Write(LogType.Warning, "Sample " + j + " in set " + i + " was shorter than expected! Expected "
+					+ actualDataSize + " bytes, but read " + sample.Data.Length + " instead.");
+			}*/
+
+			if (totalSize > chunkSize + 12) {
+				// Sample data is probably aligned to X bytes since the next sample doesn't always appear right after the first ends.
+				LOGW("Adjusting read offset of sample {} in set {} by {} bytes.", j, set.Index, (totalSize - chunkSize - 12));
+
+				sampleDataBlock.DiscardBytes(totalSize - chunkSize - 12);
+			}
+		}
+
+		return true;
+	}
+
 	void JJ2Anims::ImportAnimations(PakWriter& pakWriter, JJ2Version version, SmallVectorImpl<AnimSection>& anims)
 	{
 		if (anims.empty()) {
@@ -427,14 +475,17 @@ namespace Jazz2::Compatibility
 
 		AnimSetMapping animMapping = AnimSetMapping::GetAnimMapping(version);
 
-		for (auto& anim : anims) {
+		// Animations are converted in parallel, but added to the .pak file in the original order
+		SmallVector<ImportedFile, 0> files(anims.size());
+		AssetConverter::RunJobs(std::uint32_t(anims.size()), [&anims, &animMapping, &files](std::uint32_t index) {
+			AnimSection& anim = anims[index];
 			if (anim.FrameCount == 0) {
-				continue;
+				return;
 			}
 
 			AnimSetMapping::Entry* entry = animMapping.Get(anim.Set, anim.Anim);
 			if (entry == nullptr || entry->Category == AnimSetMapping::Discard) {
-				continue;
+				return;
 			}
 
 			std::int32_t sizeX = (anim.AdjustedSizeX + AddBorder * 2);
@@ -520,14 +571,11 @@ namespace Jazz2::Compatibility
 				LOGI("Applying \"Player Flare\" image fix to {}:{}", anim.Set, anim.Anim);
 			}
 
-			String filename;
 			if (entry->Name.empty()) {
 				LOGE("Entry name is empty");
-				continue;
+				return;
 			}
 
-			filename = fs::CombinePath({ "Animations"_s, entry->Category, String(entry->Name + ".aura"_s) });
-
 			// Pack the frames tightly when they fit that way, otherwise keep the regular grid
 			SmallVector<PackedFrame, 0> packedFrames;
 			std::int32_t sheetWidth = 0, sheetHeight = 0;
@@ -663,8 +711,8 @@ namespace Jazz2::Compatibility
 			}
 			WriteImageToStream(so, outData, sizeX, sizeY, outChannels, anim, entry, packedSheet);
 			so.Seek(0, SeekOrigin::Begin);
-			bool success = pakWriter.AddFile(so, filename, PakPreferredCompression::Deflate);
-			DEATH_ASSERT(success, "Failed to add file to .pak container", );
+			files[index].Path = fs::CombinePath({ "Animations"_s, entry->Category, String(entry->Name + ".aura"_s) });
+			files[index].File = PakWriter::PrepareFile(so, PakPreferredCompression::Deflate);
 
 			/*if (!string.IsNullOrEmpty(data.Name) && !data.SkipNormalMap) {
 				PngWriter normalMap = NormalMapGenerator.FromSprite(img,
@@ -673,6 +721,13 @@ namespace Jazz2::Compatibility
 
 				normalMap.Save(filename.Replace(".png", ".n.png"));
 			}*/
+		});
+
+		for (auto& file : files) {
+			if (!file.Path.empty()) {
+				bool success = pakWriter.AddFile(std::move(file.File), file.Path);
+				DEATH_ASSERT(success, "Failed to add file to .pak container", );
+			}
 		}
 	}
 
@@ -686,20 +741,20 @@ namespace Jazz2::Compatibility
 
 		AnimSetMapping mapping = AnimSetMapping::GetSampleMapping(version);
 
-		for (auto& sample : samples) {
+		// Samples are converted in parallel, but added to the .pak file in the original order
+		SmallVector<ImportedFile, 0> files(samples.size());
+		AssetConverter::RunJobs(std::uint32_t(samples.size()), [&samples, &mapping, &files](std::uint32_t index) {
+			SampleSection& sample = samples[index];
 			AnimSetMapping::Entry* entry = mapping.Get(sample.Set, sample.IdInSet);
 			if (entry == nullptr || entry->Category == AnimSetMapping::Discard) {
-				continue;
+				return;
 			}
 
-			String filename;
 			if (entry->Name.empty()) {
 				LOGE("Entry name is empty");
-				continue;
+				return;
 			}
 
-			filename = fs::CombinePath({ "Animations"_s, entry->Category, String(entry->Name + ".wav"_s) });
-
 			MemoryStream so(16384);
 
 			// TODO: The modulo here essentially clips the sample to 8- or 16-bit.
@@ -739,8 +794,15 @@ namespace Jazz2::Compatibility
 			}
 
 			so.Seek(0, SeekOrigin::Begin);
-			bool success = pakWriter.AddFile(so, filename, PakPreferredCompression::Deflate);
-			DEATH_ASSERT(success, "Failed to add file to .pak container", );
+			files[index].Path = fs::CombinePath({ "Animations"_s, entry->Category, String(entry->Name + ".wav"_s) });
+			files[index].File = PakWriter::PrepareFile(so, PakPreferredCompression::Deflate);
+		});
+
+		for (auto& file : files) {
+			if (!file.Path.empty()) {
+				bool success = pakWriter.AddFile(std::move(file.File), file.Path);
+				DEATH_ASSERT(success, "Failed to add file to .pak container", );
+			}
 		}
 	}
 
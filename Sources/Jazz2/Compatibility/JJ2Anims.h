@@ -7,6 +7,7 @@
 #include <memory>
 
 #include <Containers/SmallVector.h>
+#include <Containers/String.h>
 #include <Containers/StringView.h>
 #include <IO/Stream.h>
 #include <IO/PakFile.h>
@@ -103,6 +104,24 @@ namespace Jazz2::Compatibility
 			std::unique_ptr<std::uint8_t[]> Data;
 			std::uint16_t Multiplier;
 		};
+
+		struct SetSection {
+			std::int32_t Index;
+			std::uint8_t AnimCount;
+			std::uint8_t SampleCount;
+			// Info, frame data, image data and sample data blocks, still compressed as they were read
+			std::unique_ptr<std::uint8_t[]> BlockData[4];
+			std::int32_t BlockLength[4];
+			std::int32_t BlockUncompressedLength[4];
+
+			SmallVector<AnimSection, 0> Anims;
+			SmallVector<SampleSection, 0> Samples;
+		};
+
+		struct ImportedFile {
+			String Path;
+			PakWriter::PreparedFile File;
+		};
 #endif
 
 		JJ2Anims();
@@ -117,6 +136,9 @@ namespace Jazz2::Compatibility
 		static bool PackFramesTightly(const AnimSection& anim, std::int32_t border,
 			SmallVector<PackedFrame, 0>& packed, std::int32_t& sheetWidth, std::int32_t& sheetHeight);
 
+		/** @brief Decompresses blocks of one set and parses its animations and samples, it doesn't depend on other sets */
+		static bool ParseSet(SetSection& set);
+
 		static void ImportAnimations(PakWriter& pakWriter, JJ2Version version, SmallVectorImpl<AnimSection>& anims);
 		static void ImportAudioSamples(PakWriter& pakWriter, JJ2Version version, SmallVectorImpl<SampleSection>& samples);
 
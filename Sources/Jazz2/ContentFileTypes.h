@@ -22,5 +22,7 @@ namespace Jazz2
 		static constexpr std::uint8_t Highscores = 7;
 		static constexpr std::uint8_t Video = 8;
 		static constexpr std::uint8_t Font = 9;
+		static constexpr std::uint8_t CacheManifest = 10;
+		static constexpr std::uint8_t Replay = 11;
 	};
 }
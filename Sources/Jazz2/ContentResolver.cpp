@@ -15,6 +15,7 @@
 #include "../nCine/Graphics/RenderResources.h"
 #include "../nCine/Graphics/RenderCommand.h"
 #include "../nCine/Base/Random.h"
+#include "../nCine/Threading/ThreadSync.h"
 
 #if defined(DEATH_TARGET_ANDROID)
 #	include "../nCine/Backends/Android/AndroidJniHelper.h"
@@ -23,6 +24,7 @@
 #	include <Environment.h>
 #endif
 
+#include <atomic>
 #include <cmath>
 
 #include <Containers/StringConcatenable.h>
@@ -66,6 +68,9 @@ namespace Jazz2
 #endif
 			_palettes{}, _paletteDirtyFirstRow(0), _paletteDirtyLastRow(PaletteCount - 1), _paletteRowRefCount{},
 			_paletteRowColor{}, _paletteRowScheme{}
+#if defined(WITH_THREADS)
+			, _finishingPreloadJob(nullptr)
+#endif
 	{
 		InitializePaths();
 	}
@@ -76,6 +81,10 @@ namespace Jazz2
 
 	void ContentResolver::Release()
 	{
+#if defined(WITH_THREADS)
+		CancelPreloadJobs();
+#endif
+
 		_cachedMetadata.clear();
 		_cachedGraphics.clear();
 #if defined(WITH_AUDIO)
@@ -403,6 +412,11 @@ namespace Jazz2
 #if !defined(DEATH_TARGET_EMSCRIPTEN)
 	void ContentResolver::RemountPaks()
 	{
+#if defined(WITH_THREADS)
+		// Preloading workers could still read from the mounted .paks
+		CancelPreloadJobs();
+#endif
+
 		// Unload all already loaded .paks
 		_mountedPaks.clear();
 
@@ -413,7 +427,7 @@ namespace Jazz2
 				continue;
 			}
 
-			auto& pak = _mountedPaks.emplace_back(std::make_unique<PakFile>(item));
+			auto& pak = _mountedPaks.emplace_back(std::make_unique<PakFile>(item, true));
 			if (pak->IsValid()) {
 				LOGI("File \"{}\" mounted successfully", item);
 			} else {
@@ -428,7 +442,7 @@ namespace Jazz2
 				continue;
 			}
 
-			auto& pak = _mountedPaks.emplace_back(std::make_unique<PakFile>(item));
+			auto& pak = _mountedPaks.emplace_back(std::make_unique<PakFile>(item, true));
 			if (pak->IsValid()) {
 				LOGI("File \"{}\" mounted successfully", item);
 			} else {
@@ -436,6 +450,55 @@ namespace Jazz2
 				_mountedPaks.pop_back();
 			}
 		}
+
+		IndexMountedPaks();
+	}
+
+	void ContentResolver::IndexMountedPaks()
+	{
+		_pakIndices.clear();
+
+		// .paks are indexed in mount order, so the first one that contains a file wins as before
+		for (std::uint32_t i = 0; i < std::uint32_t(_mountedPaks.size()); i++) {
+			auto mountPoint = _mountedPaks[i]->GetMountPoint();
+			PakMountIndex* index = nullptr;
+			for (auto& existing : _pakIndices) {
+				if (existing.MountPoint == mountPoint) {
+					index = &existing;
+					break;
+				}
+			}
+			if (index == nullptr) {
+				index = &_pakIndices.emplace_back();
+				index->MountPoint = mountPoint;
+			}
+
+			auto hashes = _mountedPaks[i]->GetFileHashes();
+			index->Files.reserve(index->Files.size() + hashes.size());
+			for (std::uint64_t hash : hashes) {
+				index->Files.emplace(hash, i);
+			}
+		}
+	}
+
+	PakFile* ContentResolver::FindPakFile(StringView path, std::uint64_t& hashedPath)
+	{
+		// Mount points can overlap, so the file is looked up under each matching one and the earliest .pak wins
+		std::uint32_t foundIndex = UINT32_MAX;
+		for (auto& index : _pakIndices) {
+			if (!path.hasPrefix(index.MountPoint)) {
+				continue;
+			}
+
+			std::uint64_t hash = PakFile::HashPath(path.exceptPrefix(index.MountPoint.size()));
+			auto it = index.Files.find(hash);
+			if (it != index.Files.end() && it->second < foundIndex) {
+				foundIndex = it->second;
+				hashedPath = hash;
+			}
+		}
+
+		return (foundIndex != UINT32_MAX ? _mountedPaks[foundIndex].get() : nullptr);
 	}
 #endif
 
@@ -443,13 +506,11 @@ namespace Jazz2
 	{
 		// Search .paks first, then Content directory and Cache directory
 #if !defined(DEATH_TARGET_EMSCRIPTEN)
-		for (std::size_t i = 0; i < _mountedPaks.size(); i++) {
-			auto mountPoint = _mountedPaks[i]->GetMountPoint();
-			if (path.hasPrefix(mountPoint)) {
-				auto packedFile = _mountedPaks[i]->OpenFile(path.exceptPrefix(mountPoint.size()), bufferSize);
-				if (packedFile != nullptr && packedFile->IsValid()) {
-					return packedFile;
-				}
+		std::uint64_t hashedPath;
+		if (PakFile* pak = FindPakFile(path, hashedPath)) {
+			auto packedFile = pak->OpenFile(hashedPath, bufferSize);
+			if (packedFile != nullptr && packedFile->IsValid()) {
+				return packedFile;
 			}
 		}
 #endif
@@ -466,6 +527,31 @@ namespace Jazz2
 		return fs::Open(fullPath, FileAccess::Read, bufferSize);
 	}
 
+	ArrayView<const char> ContentResolver::ReadContentFile(StringView path, std::int64_t maxSize, std::unique_ptr<char[]>& buffer, std::int64_t& fileSize)
+	{
+#if !defined(DEATH_TARGET_EMSCRIPTEN)
+		std::uint64_t hashedPath;
+		if (PakFile* pak = FindPakFile(path, hashedPath)) {
+			// If the file is compressed, it has to be read through a stream
+			auto mappedFile = pak->GetMappedFile(hashedPath);
+			if (!mappedFile.empty()) {
+				fileSize = std::int64_t(mappedFile.size());
+				return { reinterpret_cast<const char*>(mappedFile.data()), mappedFile.size() };
+			}
+		}
+#endif
+
+		auto s = OpenContentFile(path);
+		fileSize = (s->IsValid() ? s->GetSize() : -1);
+		if (fileSize <= 0 || fileSize > maxSize) {
+			return {};
+		}
+
+		buffer = std::make_unique<char[]>(fileSize);
+		fileSize = s->Read(buffer.get(), fileSize);
+		return { buffer.get(), std::size_t(std::max(fileSize, std::int64_t(0))) };
+	}
+
 	std::unique_ptr<Stream> ContentResolver::OpenSourceFile(StringView path, std::int32_t bufferSize)
 	{
 		String fullPath = fs::FindPathCaseInsensitive(fs::CombinePath(GetSourcePath(), path));
@@ -474,6 +560,9 @@ namespace Jazz2
 
 	void ContentResolver::BeginLoading()
 	{
+		// Already preloaded metadata are finished now, so they can be released at the end of loading if not needed anymore
+		FlushPreloadedMetadata();
+
 		_isLoading = true;
 
 		// Reset Referenced flag
@@ -567,12 +656,209 @@ namespace Jazz2
 		_pathHandler = std::move(callback);
 	}
 
+	struct ContentResolver::DecodedGraphics
+	{
+		std::unique_ptr<GenericGraphicResource> Resource;
+		// Sheets in the `.aura` format are decoded into `Data`, pixels of other images are owned by their `Loader`
+		std::unique_ptr<std::uint8_t[]> Data;
+		std::unique_ptr<ITextureLoader> Loader;
+		std::uint8_t* Pixels = nullptr;
+		String TextureName;
+		std::int32_t Width = 0;
+		std::int32_t Height = 0;
+		std::int32_t ChannelCount = 0;
+		bool LinearSampling = false;
+	};
+
+#if defined(WITH_THREADS)
+	struct ContentResolver::PreloadJob
+	{
+		String Path;
+		Json::Value Doc;
+		bool Found = false;
+		bool Parsed = false;
+		// Sheets of all non-deferred animations, always decoded as indexed
+		SmallVector<Pair<String, DecodedGraphics>, 0> Graphics;
+
+		// Whoever claims the job first executes it, so the main thread doesn't have to wait for a job that
+		// is still queued behind others in the thread pool
+		std::atomic<bool> IsClaimed{false};
+		std::atomic<bool> IsDone{false};
+		Mutex DoneMutex;
+		CondVariable DoneCV;
+
+		bool TryClaim()
+		{
+			return !IsClaimed.exchange(true, std::memory_order_acq_rel);
+		}
+
+		void MarkDone()
+		{
+			DoneMutex.Lock();
+			IsDone.store(true, std::memory_order_release);
+			DoneCV.Broadcast();
+			DoneMutex.Unlock();
+		}
+
+		void Wait()
+		{
+			DoneMutex.Lock();
+			while (!IsDone.load(std::memory_order_acquire)) {
+				DoneCV.Wait(DoneMutex);
+			}
+			DoneMutex.Unlock();
+		}
+	};
+
+	class ContentResolver::PreloadCommand : public IThreadCommand
+	{
+	public:
+		PreloadCommand(ContentResolver* resolver, std::shared_ptr<PreloadJob> job)
+			: _resolver(resolver), _job(std::move(job)) {}
+
+		~PreloadCommand() override
+		{
+			// The thread pool drops commands that weren't executed when it's destroyed, so nobody must wait for them
+			if (_job->TryClaim()) {
+				_job->MarkDone();
+			}
+		}
+
+		void Execute() override
+		{
+			if (_job->TryClaim()) {
+				_resolver->ExecutePreloadJob(*_job);
+				_job->MarkDone();
+			}
+		}
+
+	private:
+		ContentResolver* _resolver;
+		std::shared_ptr<PreloadJob> _job;
+	};
+#endif
+
 	void ContentResolver::PreloadMetadataAsync(StringView path)
 	{
-		// TODO: Reimplement async preloading
+#if defined(WITH_THREADS)
+		IThreadPool& threadPool = theServiceLocator().GetThreadPool();
+		if (threadPool.GetThreadCount() > 0) {
+			String pathNormalized = fs::ToNativeSeparators(path);
+			if (_cachedMetadata.find(pathNormalized) != _cachedMetadata.end()) {
+				// Already loaded, it only needs to be marked as referenced
+				RequestMetadata(pathNormalized);
+				return;
+			}
+			for (const auto& job : _preloadJobs) {
+				if (job->Path == pathNormalized) {
+					return;
+				}
+			}
+
+			auto job = std::make_shared<PreloadJob>();
+			job->Path = std::move(pathNormalized);
+			_preloadJobs.push_back(job);
+			threadPool.EnqueueCommand(std::make_unique<PreloadCommand>(this, std::move(job)));
+			return;
+		}
+#endif
+
 		RequestMetadata(path);
 	}
 
+	void ContentResolver::FlushPreloadedMetadata()
+	{
+#if defined(WITH_THREADS)
+		std::size_t i = 0;
+		while (i < _preloadJobs.size()) {
+			if (_preloadJobs[i]->IsDone.load(std::memory_order_acquire)) {
+				std::shared_ptr<PreloadJob> job = std::move(_preloadJobs[i]);
+				_preloadJobs.erase(_preloadJobs.begin() + i);
+				FinishPreloadJob(*job);
+			} else {
+				i++;
+			}
+		}
+#endif
+	}
+
+#if defined(WITH_THREADS)
+	void ContentResolver::ExecutePreloadJob(PreloadJob& job)
+	{
+		job.Found = ReadMetadataFile(job.Path, job.Doc, job.Parsed);
+		if (!job.Parsed) {
+			return;
+		}
+
+		const Json::Value& doc = job.Doc;
+		bool deferredByDefault = false;
+		doc["Deferred"].get(deferredByDefault);
+
+		const auto& animations = doc["Animations"];
+		if (!animations.isObject()) {
+			return;
+		}
+
+		for (auto it = animations.begin(); it != animations.end(); ++it) {
+			std::string_view assetPath;
+			if ((*it)["Path"].get(assetPath) != Json::SUCCESS || assetPath.empty()) {
+				continue;
+			}
+
+			bool deferred = deferredByDefault;
+			(*it)["Deferred"].get(deferred);
+			if (deferred) {
+				// Deferred animations are loaded on their first lookup, not together with the metadata
+				continue;
+			}
+
+			String assetPathNormalized = fs::ToNativeSeparators(assetPath);
+			bool alreadyDecoded = false;
+			for (const auto& graphics : job.Graphics) {
+				if (graphics.first() == assetPathNormalized) {
+					alreadyDecoded = true;
+					break;
+				}
+			}
+			if (alreadyDecoded) {
+				continue;
+			}
+
+			// CreateMetadata() always keeps the sprites indexed, so the palette is never touched from this thread
+			DecodedGraphics decoded;
+			if (DecodeGraphics(assetPathNormalized, 0, true, decoded)) {
+				job.Graphics.emplace_back(std::move(assetPathNormalized), std::move(decoded));
+			}
+		}
+	}
+
+	Metadata* ContentResolver::FinishPreloadJob(PreloadJob& job)
+	{
+		if (!job.Found) {
+			return nullptr;
+		}
+
+		// Sheets decoded by the worker are picked up by RequestGraphics() and only their textures are created here
+		_finishingPreloadJob = &job;
+		Metadata* metadata = CreateMetadata(job.Path, job.Path, job.Parsed ? &job.Doc : nullptr);
+		_finishingPreloadJob = nullptr;
+		return metadata;
+	}
+
+	void ContentResolver::CancelPreloadJobs()
+	{
+		for (const auto& job : _preloadJobs) {
+			if (job->TryClaim()) {
+				// Not started yet, so it can be just skipped
+				job->MarkDone();
+			} else {
+				job->Wait();
+			}
+		}
+		_preloadJobs.clear();
+	}
+#endif
+
 	Metadata* ContentResolver::RequestMetadata(StringView path, bool forceIndexed)
 	{
 		auto pathNormalized = fs::ToNativeSeparators(path);
@@ -604,32 +890,69 @@ namespace Jazz2
 			return it->second.get();
 		}
 
+#if defined(WITH_THREADS)
+		// Preloading always uses the default cache key
+		if (!forceIndexed) {
+			for (std::size_t i = 0; i < _preloadJobs.size(); i++) {
+				if (_preloadJobs[i]->Path == pathNormalized) {
+					std::shared_ptr<PreloadJob> job = std::move(_preloadJobs[i]);
+					_preloadJobs.erase(_preloadJobs.begin() + i);
+					if (job->TryClaim()) {
+						// The worker hasn't started yet, so it's faster to do it right here
+						ExecutePreloadJob(*job);
+						job->MarkDone();
+					} else {
+						job->Wait();
+					}
+					return FinishPreloadJob(*job);
+				}
+			}
+		}
+#endif
+
 		// Try to load it
-		auto s = OpenContentFile(fs::CombinePath("Metadata"_s, String(pathNormalized + ".res"_s)));
-		auto fileSize = s->GetSize();
+		Json::Value doc; bool parsed;
+		if (!ReadMetadataFile(pathNormalized, doc, parsed)) {
+			return nullptr;
+		}
+
+		return CreateMetadata(String(pathNormalized), std::move(cacheKey), parsed ? &doc : nullptr);
+	}
+
+	bool ContentResolver::ReadMetadataFile(StringView path, Json::Value& doc, bool& parsed)
+	{
+		parsed = false;
+
+		std::unique_ptr<char[]> buffer;
+		std::int64_t fileSize;
+		auto data = ReadContentFile(fs::CombinePath("Metadata"_s, String(path + ".res"_s)), 64 * 1024 * 1024, buffer, fileSize);
 		if (fileSize < 4 || fileSize > 64 * 1024 * 1024) {
 			// 64 MB file size limit
-			if (s->IsValid()) {
+			if (fileSize >= 0) {
 				LOGE("Cannot load metadata \"{}\" with unexpected file size of {} bytes", path, fileSize);
 			}
-			return nullptr;
+			return false;
 		}
 
-		auto buffer = std::make_unique<char[]>(fileSize);
-		s->Read(buffer.get(), fileSize);
+		Json::CharReaderBuilder builder;
+		auto reader = std::unique_ptr<Json::CharReader>(builder.newCharReader());
+		std::string errors;
+		parsed = reader->parse(data.begin(), data.end(), &doc, &errors);
+		return true;
+	}
 
+	Metadata* ContentResolver::CreateMetadata(String path, String cacheKey, const Json::Value* docPtr)
+	{
 		bool multipleAnimsNoStatesWarning = false;
 
 		std::unique_ptr<Metadata> metadata = std::make_unique<Metadata>();
-		metadata->Path = std::move(pathNormalized);
+		metadata->Path = std::move(path);
 		// The cache key references this string (the map key is a non-owning Reference), so it lives inside the value
 		metadata->CacheKey = std::move(cacheKey);
 		metadata->Flags |= MetadataFlags::Referenced;
 
-		Json::CharReaderBuilder builder;
-		auto reader = std::unique_ptr<Json::CharReader>(builder.newCharReader());
-		Json::Value doc; std::string errors;
-		if (reader->parse(buffer.get(), buffer.get() + fileSize, &doc, &errors)) {
+		if (docPtr != nullptr) {
+			const Json::Value& doc = *docPtr;
 			metadata->BoundingBox = GetVector2iFromJson(doc["BoundingBox"], Vector2i(InvalidValue, InvalidValue));
 
 			// A file can declare all of its animations deferred at once, and any single entry can opt in or out
@@ -737,7 +1060,7 @@ namespace Jazz2
 								// Additional checks only for Debug configuration
 								for (const auto& anim : metadata->Animations) {
 									if (anim.State == (AnimState)state) {
-										LOGW("Animation state {} defined twice in file \"{}\"", state, path);
+										LOGW("Animation state {} defined twice in file \"{}\"", state, metadata->Path);
 										break;
 									}
 								}
@@ -749,7 +1072,7 @@ namespace Jazz2
 					} else if (count > 1) {
 						if (!multipleAnimsNoStatesWarning) {
 							multipleAnimsNoStatesWarning = true;
-							LOGW("Multiple animations defined but no states specified in file \"{}\"", path);
+							LOGW("Multiple animations defined but no states specified in file \"{}\"", metadata->Path);
 						}
 					} else {
 						graphics.State = AnimState::Default;
@@ -844,38 +1167,58 @@ namespace Jazz2
 			return it->second.get();
 		}
 
-		if (fs::GetExtension(pathNormalized) == "aura"_s) {
-			return RequestGraphicsAura(pathNormalized, paletteOffset, keepIndexed);
+		DecodedGraphics decoded;
+		bool isDecoded = false;
+#if defined(WITH_THREADS)
+		if (_finishingPreloadJob != nullptr && keepIndexed) {
+			// The sheet was already decoded by the preloading worker
+			for (auto& graphics : _finishingPreloadJob->Graphics) {
+				if (graphics.first() == pathNormalized && graphics.second().Resource != nullptr) {
+					decoded = std::move(graphics.second());
+					isDecoded = true;
+					break;
+				}
+			}
+		}
+#endif
+		if (!isDecoded && !DecodeGraphics(pathNormalized, paletteOffset, keepIndexed, decoded)) {
+			return nullptr;
 		}
 
-		auto s = OpenContentFile(fs::CombinePath("Animations"_s, String(pathNormalized + ".res"_s)));
-		auto fileSize = s->GetSize();
+		return FinishGraphics(pathNormalized, paletteOffset, cacheKeyOffset, decoded);
+	}
+
+	bool ContentResolver::DecodeGraphics(StringView path, std::uint16_t paletteOffset, bool keepIndexed, DecodedGraphics& decoded)
+	{
+		if (fs::GetExtension(path) == "aura"_s) {
+			return DecodeGraphicsAura(path, paletteOffset, keepIndexed, decoded);
+		}
+
+		std::unique_ptr<char[]> buffer;
+		std::int64_t fileSize;
+		auto data = ReadContentFile(fs::CombinePath("Animations"_s, String(path + ".res"_s)), 64 * 1024 * 1024, buffer, fileSize);
 		if (fileSize < 4 || fileSize > 64 * 1024 * 1024) {
 			// 64 MB file size limit, also if not found try to use cache
-			if (s->IsValid()) {
+			if (fileSize >= 0) {
 				LOGE("Cannot load animation \"{}\" with unexpected file size of {} bytes", path, fileSize);
 			}
-			return nullptr;
+			return false;
 		}
 
-		auto buffer = std::make_unique<char[]>(fileSize);
-		s->Read(buffer.get(), fileSize);
-		s->Dispose();
-
 		Json::CharReaderBuilder builder;
 		auto reader = std::unique_ptr<Json::CharReader>(builder.newCharReader());
 		Json::Value doc; std::string errors;
-		if (reader->parse(buffer.get(), buffer.get() + fileSize, &doc, &errors)) {
+		if (reader->parse(data.begin(), data.end(), &doc, &errors)) {
 			// Try to load it
 			std::unique_ptr<GenericGraphicResource> graphics = std::make_unique<GenericGraphicResource>();
 			graphics->Flags |= GenericGraphicResourceFlags::Referenced;
 
-			String fullPath = fs::CombinePath("Animations"_s, pathNormalized);
+			String fullPath = fs::CombinePath("Animations"_s, path);
 			std::unique_ptr<ITextureLoader> texLoader = ITextureLoader::createFromStream(OpenContentFile(fullPath), fullPath);
 			if (texLoader->hasLoaded()) {
 				auto texFormat = texLoader->texFormat().pixelFormat();
 				if (texFormat != PixelFormat::RGBA8 && texFormat != PixelFormat::RGB8) {
-					return nullptr;
+					return false;
 				}
 
 				std::int32_t w = texLoader->width();
@@ -936,19 +1279,6 @@ namespace Jazz2
 					}
 				}
 
-				if (!_isHeadless) {
-					// Don't load textures in headless mode, only collision masks
-					if ((graphics->Flags & GenericGraphicResourceFlags::Indexed) == GenericGraphicResourceFlags::Indexed) {
-						bool paletteBaseTransparent = (((_palettes[paletteOffset] >> 24) & 0xFF) == 0);
-						graphics->TextureDiffuse = CreateIndexedTexture(fullPath.data(), pixels, w, h, PixelSize, paletteBaseTransparent);
-					} else {
-						graphics->TextureDiffuse = std::make_unique<Texture>(fullPath.data(), Texture::Format::RGBA8, w, h);
-						graphics->TextureDiffuse->LoadFromTexels(pixels, 0, 0, w, h);
-					}
-					graphics->TextureDiffuse->SetMinFiltering(linearSampling ? SamplerFilter::Linear : SamplerFilter::Nearest);
-					graphics->TextureDiffuse->SetMagFiltering(linearSampling ? SamplerFilter::Linear : SamplerFilter::Nearest);
-				}
-
 				double animDuration;
 				if (doc["Duration"].get(animDuration) != Json::SUCCESS) {
 					animDuration = 0.0;
@@ -968,24 +1298,29 @@ namespace Jazz2
 				graphics->Coldspot = GetVector2iFromJson(doc["Coldspot"], Vector2i(InvalidValue, InvalidValue));
 				graphics->Gunspot = GetVector2iFromJson(doc["Gunspot"], Vector2i(InvalidValue, InvalidValue));
 
-#if defined(DEATH_DEBUG)
-				MigrateGraphics(pathNormalized);
-#endif
-				return _cachedGraphics.emplace(Pair(String(pathNormalized), cacheKeyOffset), std::move(graphics)).first->second.get();
+				decoded.Resource = std::move(graphics);
+				decoded.Loader = std::move(texLoader);
+				decoded.Pixels = pixels;
+				decoded.TextureName = std::move(fullPath);
+				decoded.Width = w;
+				decoded.Height = h;
+				decoded.ChannelCount = PixelSize;
+				decoded.LinearSampling = linearSampling;
+				return true;
 			}
 		}
 
-		return nullptr;
+		return false;
 	}
 
-	GenericGraphicResource* ContentResolver::RequestGraphicsAura(StringView path, std::uint16_t paletteOffset, bool keepIndexed)
+	bool ContentResolver::DecodeGraphicsAura(StringView path, std::uint16_t paletteOffset, bool keepIndexed, DecodedGraphics& decoded)
 	{
 		auto s = OpenContentFile(fs::CombinePath("Animations"_s, path));
 
 		auto fileSize = s->GetSize();
 		if (fileSize < 16 || fileSize > 64 * 1024 * 1024) {
 			// 64 MB file size limit, also if not found try to use cache
-			return nullptr;
+			return false;
 		}
 
 		std::uint64_t signature1 = s->ReadValueAsLE<std::uint64_t>();
@@ -994,7 +1329,7 @@ namespace Jazz2
 		std::uint8_t flags = s->ReadValue<std::uint8_t>();
 
 		if (signature1 != 0xB8EF8498E2BFBBEF || signature2 != 0x208F || version != 2 || (flags & 0x80) != 0x80) {
-			return nullptr;
+			return false;
 		}
 
 		std::uint8_t channelCount = s->ReadValue<std::uint8_t>();
@@ -1126,19 +1461,6 @@ namespace Jazz2
 			}
 		}
 
-		if (!_isHeadless) {
-			// Don't load textures in headless mode, only collision masks
-			if ((graphics->Flags & GenericGraphicResourceFlags::Indexed) == GenericGraphicResourceFlags::Indexed) {
-				bool paletteBaseTransparent = (((_palettes[paletteOffset] >> 24) & 0xFF) == 0);
-				graphics->TextureDiffuse = CreateIndexedTexture(path.data(), pixels.get(), width, height, channelCount, paletteBaseTransparent);
-			} else {
-				graphics->TextureDiffuse = std::make_unique<Texture>(path.data(), Texture::Format::RGBA8, width, height);
-				graphics->TextureDiffuse->LoadFromTexels(pixels.get(), 0, 0, width, height);
-			}
-			graphics->TextureDiffuse->SetMinFiltering(linearSampling ? SamplerFilter::Linear : SamplerFilter::Nearest);
-			graphics->TextureDiffuse->SetMagFiltering(linearSampling ? SamplerFilter::Linear : SamplerFilter::Nearest);
-		}
-
 		// AnimDuration is multiplied by 256 before saving, so divide it here back
 		graphics->AnimDuration = animDuration / 256.0f;
 		graphics->FrameDimensions = Vector2i(frameDimensionsX, frameDimensionsY);
@@ -1166,9 +1488,43 @@ namespace Jazz2
 			graphics->Gunspot = Vector2i(InvalidValue, InvalidValue);
 		}
 
+		decoded.Resource = std::move(graphics);
+		decoded.Data = std::move(pixels);
+		decoded.Pixels = decoded.Data.get();
+		decoded.TextureName = path;
+		decoded.Width = (std::int32_t)width;
+		decoded.Height = (std::int32_t)height;
+		decoded.ChannelCount = channelCount;
+		decoded.LinearSampling = linearSampling;
+		return true;
+	}
+
+	GenericGraphicResource* ContentResolver::FinishGraphics(StringView path, std::uint16_t paletteOffset, std::uint16_t cacheKeyOffset, DecodedGraphics& decoded)
+	{
+		std::unique_ptr<GenericGraphicResource>& graphics = decoded.Resource;
+
+		if (!_isHeadless) {
+			// Don't load textures in headless mode, only collision masks
+			const char* name = decoded.TextureName.data();
+			if ((graphics->Flags & GenericGraphicResourceFlags::Indexed) == GenericGraphicResourceFlags::Indexed) {
+				bool paletteBaseTransparent = (((_palettes[paletteOffset] >> 24) & 0xFF) == 0);
+				graphics->TextureDiffuse = CreateIndexedTexture(name, decoded.Pixels, decoded.Width, decoded.Height, decoded.ChannelCount, paletteBaseTransparent);
+			} else {
+				graphics->TextureDiffuse = std::make_unique<Texture>(name, Texture::Format::RGBA8, decoded.Width, decoded.Height);
+				graphics->TextureDiffuse->LoadFromTexels(decoded.Pixels, 0, 0, decoded.Width, decoded.Height);
+			}
+			graphics->TextureDiffuse->SetMinFiltering(decoded.LinearSampling ? SamplerFilter::Linear : SamplerFilter::Nearest);
+			graphics->TextureDiffuse->SetMagFiltering(decoded.LinearSampling ? SamplerFilter::Linear : SamplerFilter::Nearest);
+		}
+
+#if defined(DEATH_DEBUG)
+		if (decoded.Loader != nullptr) {
+			MigrateGraphics(path);
+		}
+#endif
+
 		// Indexed sprites are cached under a dedicated key (matching the lookup in RequestGraphics) so they don't
 		// collide with the baked variant of the same sprite
-		std::uint16_t cacheKeyOffset = (keepIndexed ? IndexedGraphicsCacheKey : paletteOffset);
 		return _cachedGraphics.emplace(Pair(String(path), cacheKeyOffset), std::move(graphics)).first->second.get();
 	}
 
@@ -2115,10 +2471,9 @@ namespace Jazz2
 		_precompiledShaders[(std::int32_t)PrecompiledShader::BatchedShieldLightning] = CompileShader("BatchedShieldLightning", ShadersGen::BatchedShieldLightning, Shader::Introspection::NoUniformsInBlocks);
 		_precompiledShaders[(std::int32_t)PrecompiledShader::ShieldLightning]->RegisterBatchedShader(*_precompiledShaders[(int32_t)PrecompiledShader::BatchedShieldLightning]);
 
-#if defined(TILEMAP_USE_SINGLE_DRAW)
-		// Tile-layer mesh shaders (used by TileMap when TILEMAP_USE_SINGLE_DRAW is enabled; cheap to keep compiled
-		// either way). Define the interleaved per-vertex format (position.xy, texcoords.xy, color.rgba = 8 floats /
-		// 32 bytes) shared by both, filled in TileMap::DrawLayer.
+		// Mesh shaders (used by TileMap when TILEMAP_USE_SINGLE_DRAW is enabled and by Canvas::DrawMesh() for text).
+		// Define the interleaved per-vertex format (position.xy, texcoords.xy, color.rgba = 8 floats / 32 bytes)
+		// shared by both, filled in TileMap::DrawLayer and Font::DrawString.
 		_precompiledShaders[(std::int32_t)PrecompiledShader::TileMapMesh] = CompileShader("TileMapMesh", ShadersGen::TileMapMesh);
 		_precompiledShaders[(std::int32_t)PrecompiledShader::TileMapMeshPalette] = CompileShader("TileMapMeshPalette", ShadersGen::TileMapMeshPalette);
 		for (PrecompiledShader meshShader : { PrecompiledShader::TileMapMesh, PrecompiledShader::TileMapMeshPalette }) {
@@ -2128,7 +2483,6 @@ namespace Jazz2
 			shader->SetAttribute(Material::TexCoordsAttributeName, Stride, reinterpret_cast<void*>(2 * sizeof(float)));
 			shader->SetAttribute(Material::ColorAttributeName, Stride, reinterpret_cast<void*>(4 * sizeof(float)));
 		}
-#endif
 
 #if !defined(DISABLE_RESCALE_SHADERS)
 		_precompiledShaders[(std::int32_t)PrecompiledShader::ResizeHQ2x] = CompileShader("ResizeHQ2x", ShadersGen::ResizeHQ2x);
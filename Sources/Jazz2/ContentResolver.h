@@ -33,6 +33,11 @@ namespace nCine
 	class RenderCommand;
 }
 
+namespace Json
+{
+	class Value;
+}
+
 using namespace Death::Containers;
 using namespace Death::Containers::Literals;
 using namespace Death::IO;
@@ -172,7 +177,14 @@ namespace Jazz2
 		/** @brief Overrides the default path handler */
 		void OverridePathHandler(Function<String(StringView)>&& callback);
 
-		/** @brief Preloads specified metadata and its linked assets to cache */
+		/**
+		 * @brief Preloads specified metadata and its linked assets to cache
+		 *
+		 * Reading and parsing of the metadata and decoding of its linked sprite sheets run on a worker thread of
+		 * the registered thread pool, only the texture upload is left for the main thread. It's done either by
+		 * @ref FlushPreloadedMetadata() once the worker finished, or by @ref RequestMetadata() of the same path, which
+		 * waits for the worker if needed. Without a thread pool, the metadata are loaded immediately.
+		 */
 		void PreloadMetadataAsync(StringView path);
 		/**
 		 * @brief Loads specified metadata and its linked assets (cached)
@@ -182,6 +194,13 @@ namespace Jazz2
 		 *                      time - used for the player so each player can have a custom color scheme
 		 */
 		Metadata* RequestMetadata(StringView path, bool forceIndexed = false);
+		/**
+		 * @brief Finishes all metadata whose background preloading already completed
+		 *
+		 * Textures of all of them are uploaded in one batch, so it should be called once per frame on the main thread.
+		 * Preloads that are still in progress are left untouched.
+		 */
+		void FlushPreloadedMetadata();
 		/**
 		 * @brief Loads specified graphics asset (cached)
 		 *
@@ -353,7 +372,48 @@ namespace Jazz2
 		// from any real paletteOffset so indexed and baked variants of the same sprite are cached separately
 		static constexpr std::uint16_t IndexedGraphicsCacheKey = UINT16_MAX;
 
-		GenericGraphicResource* RequestGraphicsAura(StringView path, std::uint16_t paletteOffset, bool keepIndexed = false);
+		// Sprite sheet that was read and decoded, but its texture wasn't created yet
+		struct DecodedGraphics;
+#if defined(WITH_THREADS)
+		// Metadata loaded by PreloadMetadataAsync() on a worker thread, shared by the worker and the main thread
+		struct PreloadJob;
+		class PreloadCommand;
+#endif
+
+#if !defined(DEATH_TARGET_EMSCRIPTEN)
+		// Files of all mounted .paks with the same mount point, keyed by PakFile::HashPath() of the path relative
+		// to the mount point, each file points to the first .pak that contains it, so overrides are resolved once
+		struct PakMountIndex {
+			String MountPoint;
+			HashMap<std::uint64_t, std::uint32_t> Files;
+		};
+
+		// Rebuilds `_pakIndices` from `_mountedPaks`
+		void IndexMountedPaks();
+		// Returns the mounted .pak that contains the file and the hash to open it with, or `nullptr`
+		PakFile* FindPakFile(StringView path, std::uint64_t& hashedPath);
+#endif
+		// Reads the whole content file, stored files in memory-mapped .paks are returned directly without any copy,
+		// otherwise the file is read into `buffer`. Returns an empty view if the file is missing (then `fileSize`
+		// is negative) or if it's larger than `maxSize`.
+		ArrayView<const char> ReadContentFile(StringView path, std::int64_t maxSize, std::unique_ptr<char[]>& buffer, std::int64_t& fileSize);
+		// Reads the metadata file, `doc` is left empty if it cannot be parsed. Returns `false` if the file is missing.
+		bool ReadMetadataFile(StringView path, Json::Value& doc, bool& parsed);
+		// Creates metadata from a parsed file (or empty metadata if `doc` is `nullptr`) and puts it into the cache
+		Metadata* CreateMetadata(String path, String cacheKey, const Json::Value* doc);
+		// Reads, decodes and converts a sprite sheet, doesn't touch any GPU resources. Palette is read only to bake
+		// it into non-indexed sheets, so with `keepIndexed` it's safe to call from a worker thread.
+		bool DecodeGraphics(StringView path, std::uint16_t paletteOffset, bool keepIndexed, DecodedGraphics& decoded);
+		bool DecodeGraphicsAura(StringView path, std::uint16_t paletteOffset, bool keepIndexed, DecodedGraphics& decoded);
+		// Creates the texture of a decoded sprite sheet (main thread only) and puts it into the cache
+		GenericGraphicResource* FinishGraphics(StringView path, std::uint16_t paletteOffset, std::uint16_t cacheKeyOffset, DecodedGraphics& decoded);
+#if defined(WITH_THREADS)
+		// Runs on a worker thread
+		void ExecutePreloadJob(PreloadJob& job);
+		Metadata* FinishPreloadJob(PreloadJob& job);
+		// Blocks until all preloading workers finish and drops their results
+		void CancelPreloadJobs();
+#endif
 		static void ReadImageFromFile(std::unique_ptr<Stream>& s, std::uint8_t* data, std::int32_t width, std::int32_t height, std::int32_t channelCount);
 		// Copies a tile's edge pixels into its 1px atlas padding (so sampling never bleeds across tiles); `bytesPerPixel`
 		// is 1 for an indexed (R8) atlas or 4 for a baked RGBA atlas
@@ -434,8 +494,14 @@ namespace Jazz2
 		std::unique_ptr<Shader> _precompiledShaders[(std::int32_t)PrecompiledShader::Count];
 #if !defined(DEATH_TARGET_EMSCRIPTEN)
 		SmallVector<std::unique_ptr<PakFile>> _mountedPaks;
+		SmallVector<PakMountIndex, 1> _pakIndices;
 #endif
 		Function<String(StringView)> _pathHandler;
+#if defined(WITH_THREADS)
+		SmallVector<std::shared_ptr<PreloadJob>, 0> _preloadJobs;
+		// Job whose metadata are just being created, so its decoded sheets are used instead of loading them again
+		PreloadJob* _finishingPreloadJob;
+#endif
 
 #if defined(DEATH_TARGET_UNIX) || defined(DEATH_TARGET_WINDOWS_RT)
 		String _contentPath;
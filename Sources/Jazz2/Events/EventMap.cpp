@@ -9,7 +9,8 @@
 namespace Jazz2::Events
 {
 	EventMap::EventMap(Vector2i layoutSize)
-		: _levelHandler(nullptr), _layoutSize(layoutSize), _pitType(PitType::FallForever), _hasRollbackCheckpoint(false)
+		: _levelHandler(nullptr), _layoutSize(layoutSize), _pitType(PitType::FallForever), _hasRollbackCheckpoint(false),
+			_snapshotJournalOffset(0), _hasSnapshotJournal(false)
 	{
 	}
 
@@ -158,6 +159,107 @@ namespace Jazz2::Events
 		}
 	}
 
+	std::uint64_t EventMap::SaveSnapshot(Stream& dest, SmallVectorImpl<std::shared_ptr<Actors::ActorBase>>& generatorActors)
+	{
+		// Only active flags are saved, the rest of a tile changes only in StoreTileEvent(), which is journaled instead
+		std::int32_t layoutSize = _layoutSize.X * _layoutSize.Y;
+		std::uint8_t bits = 0;
+		for (std::int32_t i = 0; i < layoutSize; i++) {
+			if (_eventLayout[i].IsEventActive) {
+				bits |= (1 << (i & 7));
+			}
+			if ((i & 7) == 7 || i == layoutSize - 1) {
+				dest.WriteValue<std::uint8_t>(bits);
+				bits = 0;
+			}
+		}
+
+		for (const auto& generator : _generators) {
+			dest.WriteValue<float>(generator.TimeLeft);
+			generatorActors.push_back(generator.SpawnedActor);
+		}
+
+		_hasSnapshotJournal = true;
+		return _snapshotJournalOffset + _snapshotJournal.size();
+	}
+
+	void EventMap::RestoreSnapshot(Stream& src, ArrayView<const std::shared_ptr<Actors::ActorBase>> generatorActors, std::uint64_t journalPos)
+	{
+		// Consumed tiles are reverted from the newest, so each ends up with the value it had at the given position
+		DEATH_ASSERT(journalPos >= _snapshotJournalOffset, "Snapshot journal was already trimmed", );
+		std::size_t keepCount = (std::size_t)(journalPos - _snapshotJournalOffset);
+		for (std::size_t i = _snapshotJournal.size(); i > keepCount; i--) {
+			const RollbackTile& entry = _snapshotJournal[i - 1];
+			_eventLayout[entry.TileIndex] = entry.Tile;
+		}
+		if (_snapshotJournal.size() > keepCount) {
+			_snapshotJournal.erase(_snapshotJournal.begin() + keepCount, _snapshotJournal.end());
+		}
+
+		std::int32_t layoutSize = _layoutSize.X * _layoutSize.Y;
+		std::uint8_t bits = 0;
+		for (std::int32_t i = 0; i < layoutSize; i++) {
+			if ((i & 7) == 0) {
+				bits = src.ReadValue<std::uint8_t>();
+			}
+			_eventLayout[i].IsEventActive = (bits & (1 << (i & 7))) != 0;
+		}
+
+		DEATH_DEBUG_ASSERT(generatorActors.size() == _generators.size());
+		for (std::size_t i = 0; i < _generators.size(); i++) {
+			_generators[i].TimeLeft = src.ReadValue<float>();
+			_generators[i].SpawnedActor = generatorActors[i];
+		}
+	}
+
+	void EventMap::TrimSnapshotJournal(std::uint64_t journalPos)
+	{
+		if (journalPos <= _snapshotJournalOffset) {
+			return;
+		}
+
+		std::size_t count = std::min((std::size_t)(journalPos - _snapshotJournalOffset), _snapshotJournal.size());
+		_snapshotJournal.erase(_snapshotJournal.begin(), _snapshotJournal.begin() + count);
+		_snapshotJournalOffset += count;
+	}
+
+	void EventMap::SaveSnapshotJournal(Stream& dest) const
+	{
+		dest.WriteValue<std::uint64_t>(_snapshotJournalOffset);
+		dest.WriteValue<std::uint32_t>((std::uint32_t)_snapshotJournal.size());
+		for (const RollbackTile& entry : _snapshotJournal) {
+			dest.WriteValue<RollbackTile>(entry);
+			dest.WriteValue<EventTile>(_eventLayout[entry.TileIndex]);
+		}
+	}
+
+	bool EventMap::RestoreSnapshotJournal(Stream& src)
+	{
+		std::uint64_t journalOffset = src.ReadValue<std::uint64_t>();
+		std::uint32_t count = src.ReadValue<std::uint32_t>();
+		// Entries trimmed since the state was saved are still contained in the state, unless they were consumed after it
+		if (journalOffset > _snapshotJournalOffset || journalOffset + count < _snapshotJournalOffset) {
+			return false;
+		}
+
+		// All consumed tiles are reverted first, so tiles consumed only after the state was saved are reverted too
+		for (std::size_t i = _snapshotJournal.size(); i > 0; i--) {
+			const RollbackTile& entry = _snapshotJournal[i - 1];
+			_eventLayout[entry.TileIndex] = entry.Tile;
+		}
+
+		_snapshotJournalOffset = journalOffset;
+		_snapshotJournal.clear();
+		_snapshotJournal.reserve(count);
+		for (std::uint32_t i = 0; i < count; i++) {
+			RollbackTile entry = src.ReadValue<RollbackTile>();
+			_eventLayout[entry.TileIndex] = src.ReadValue<EventTile>();
+			_snapshotJournal.push_back(entry);
+		}
+		_hasSnapshotJournal = true;
+		return true;
+	}
+
 	void EventMap::StoreTileEvent(std::int32_t x, std::int32_t y, EventType eventType, Actors::ActorState eventFlags, std::uint8_t* tileParams)
 	{
 		if (eventType == EventType::Empty && (x < 0 || y < 0 || x >= _layoutSize.X || y >= _layoutSize.Y)) {
@@ -171,6 +273,9 @@ namespace Jazz2::Events
 		if (_hasRollbackCheckpoint) {
 			SaveTileForRollback((std::uint32_t)tileIndex, previousEvent);
 		}
+		if (_hasSnapshotJournal) {
+			_snapshotJournal.push_back(RollbackTile { (std::uint32_t)tileIndex, previousEvent });
+		}
 
 		EventTile newEvent = {};
 		newEvent.Event = eventType,
@@ -66,6 +66,27 @@ namespace Jazz2::Events
 		/** @brief Rolls back to the last checkpoint */
 		void RollbackToCheckpoint();
 
+		/**
+		 * @brief Saves state that can change in any frame to a rollback snapshot, see @ref RollbackBuffer
+		 *
+		 * Actors spawned by generators are appended to @p generatorActors, they have to be kept alive by the snapshot.
+		 * Returns position in the journal of consumed event tiles, which has to be passed to @ref RestoreSnapshot().
+		 */
+		std::uint64_t SaveSnapshot(Stream& dest, SmallVectorImpl<std::shared_ptr<Actors::ActorBase>>& generatorActors);
+		/** @brief Restores state saved by @ref SaveSnapshot(), no events are respawned */
+		void RestoreSnapshot(Stream& src, ArrayView<const std::shared_ptr<Actors::ActorBase>> generatorActors, std::uint64_t journalPos);
+		/** @brief Discards journal entries that are older than the specified position, no snapshot can restore them anymore */
+		void TrimSnapshotJournal(std::uint64_t journalPos);
+		/** @brief Saves all event tiles consumed since the oldest snapshot with their current value, see @ref LevelHandler::SaveFrameState() */
+		void SaveSnapshotJournal(Stream& dest) const;
+		/**
+		 * @brief Replaces consumed event tiles with ones saved by @ref SaveSnapshotJournal()
+		 *
+		 * Unlike the journal position, it restores the right tiles even if they were consumed differently after the state was saved.
+		 * Returns `false` without any change if tiles consumed after the state was saved were already trimmed from the journal.
+		 */
+		bool RestoreSnapshotJournal(Stream& src);
+
 		/** @brief Stores tile event description */
 		void StoreTileEvent(std::int32_t x, std::int32_t y, EventType eventType, Actors::ActorState eventFlags = Actors::ActorState::None, std::uint8_t* tileParams = nullptr);
 		/** @brief Preloads assets of all contained events */
@@ -156,6 +177,11 @@ namespace Jazz2::Events
 		/// Whether a checkpoint was ever taken. Not implied by the two members above having contents --- a
 		/// checkpoint starts out with an empty tile list, and a level may have no event tiles at all.
 		bool _hasRollbackCheckpoint;
+		/// Event tiles consumed by @ref StoreTileEvent() since the oldest rollback snapshot, with their previous value.
+		/// Positions returned by @ref SaveSnapshot() are absolute, the first entry is at @ref _snapshotJournalOffset.
+		SmallVector<RollbackTile, 0> _snapshotJournal;
+		std::uint64_t _snapshotJournalOffset;
+		bool _hasSnapshotJournal;
 		SmallVector<GeneratorInfo, 0> _generators;
 		SmallVector<SpawnPoint, 0> _spawnPoints;
 		SmallVector<WarpTarget, 0> _warpTargets;
@@ -21,6 +21,7 @@
 #include "../nCine/Graphics/Texture.h"
 #include "../nCine/Graphics/Viewport.h"
 #include "../nCine/Input/JoyMapping.h"
+#include "../nCine/Threading/ParallelFor.h"
 
 #include "Actors/Player.h"
 #include "Actors/SolidObjectBase.h"
@@ -31,6 +32,8 @@
 
 #include <Containers/StaticArray.h>
 #include <Containers/StringConcatenable.h>
+#include <Cryptography/xxHash.h>
+#include <IO/FileSystem.h>
 #include <Utf8.h>
 
 using namespace nCine;
@@ -46,6 +49,9 @@ namespace Jazz2
 
 	using namespace Jazz2::Resources;
 
+	// Frame states of different level instances must not be mixed up, see LevelHandler::SaveFrameState()
+	static std::uint32_t FrameStateSessionCount = 0;
+
 #if defined(WITH_AUDIO)
 	class AudioBufferPlayerForSplitscreen : public AudioBufferPlayer
 	{
@@ -113,13 +119,34 @@ namespace Jazz2
 			_eventSpawner(this), _difficulty(GameDifficulty::Default), _isReforged(false),
 			_cheatsUsed(false), _checkpointCreated(false), _nextLevelType(ExitType::None),
 			_nextLevelTime(0.0f), _elapsedMillisecondsBegin(0), _elapsedFrames(0.0f), _checkpointFrames(0.0f),
-			_waterLevel(FLT_MAX), _weatherType(WeatherType::None), _pressedKeys(ValueInit, (std::size_t)Keys::Count),
+			_waterLevel(FLT_MAX), _fixedTimestep(false), _isResimulating(false), _stepAccumulator(0.0f),
+			_interpolationFactor(0.0f), _stepIndex(0), _stepChecksum(0), _parallelActorUpdate(false), _parallelPhaseTime(0.0f),
+			_frameStateSession(++FrameStateSessionCount), _frameStateSaveCount(0),
+			_weatherType(WeatherType::None), _pressedKeys(ValueInit, (std::size_t)Keys::Count),
 			_overrideActions(0), _overrideMovement(0.0f, 0.0f)
 	{
 	}
 
 	LevelHandler::~LevelHandler()
 	{
+		if (_replayRecorder != nullptr) {
+			// The final state is always recorded, so the playback can verify that it ends the same way
+			if (_stepIndex > 0 && (_stepIndex % ReplayRecorder::ChecksumInterval) != 0) {
+				_replayRecorder->RecordChecksum(_stepIndex, _stepChecksum);
+			}
+			_replayRecorder->Finish(_stepIndex);
+		}
+		if (_replayPlayer != nullptr) {
+			// The recording usually ends with a level change, anything else means that the playback diverged
+			if (_replayPlayer->FetchStep(_stepIndex)) {
+				LOGW("Level ended before the end of the replay, the simulation is not deterministic");
+			}
+			if (_stepIndex > 0) {
+				_replayPlayer->VerifyChecksum(_stepIndex, _stepChecksum);
+			}
+			EndReplay();
+		}
+
 		_players.clear();
 
 		// Remove nodes from UpscaleRenderPass
@@ -164,8 +191,21 @@ namespace Jazz2
 
 		_console->WriteLine(UI::MessageLevel::Debug, _f("Level \"{}\" initialized", descriptor.DisplayName));
 
+		InitializeSimulation();
 		AttachComponents(std::move(descriptor));
-		SpawnPlayers(levelInit);		
+		SpawnPlayers(levelInit);
+
+		if (_fixedTimestep && _replayPlayer == nullptr && !PreferencesCache::ReplayRecordPath.empty()) {
+			// Only the first started level is recorded
+			_replayRecorder = std::make_unique<ReplayRecorder>(fs::Open(PreferencesCache::ReplayRecordPath, FileAccess::Write), levelInit, GetSimulationSeed());
+			if (_replayRecorder->IsValid()) {
+				LOGI("Recording replay to \"{}\"", PreferencesCache::ReplayRecordPath);
+			} else {
+				LOGE("Cannot open \"{}\" for recording", PreferencesCache::ReplayRecordPath);
+				_replayRecorder = nullptr;
+			}
+			PreferencesCache::ReplayRecordPath = {};
+		}
 
 		OnInitialized();
 		resolver.EndLoading();
@@ -215,6 +255,7 @@ namespace Jazz2
 
 		_console->WriteLine(UI::MessageLevel::Debug, _f("Level \"{}\" initialized", descriptor.DisplayName));
 
+		InitializeSimulation();
 		AttachComponents(std::move(descriptor));
 
 		// All components are ready, deserialize the rest of state
@@ -573,6 +614,11 @@ namespace Jazz2
 		return std::make_shared<Actors::Player>();
 	}
 
+	bool LevelHandler::IsFixedTimestepAllowed()
+	{
+		return true;
+	}
+
 	bool LevelHandler::IsCheatingAllowed()
 	{
 		return PreferencesCache::AllowCheats;
@@ -587,10 +633,15 @@ namespace Jazz2
 	{
 		ZoneScopedC(0x4876AF);
 
+		// Textures of metadata preloaded in the background are uploaded here in one batch
+		ContentResolver::Get().FlushPreloadedMetadata();
+
 		float timeMult = theApplication().GetTimeMult();
 
 		if (_pauseMenu == nullptr) {
-			UpdatePressedActions();
+			if (_replayPlayer == nullptr) {
+				UpdatePressedActions();
+			}
 
 			bool isGamepad;
 			if (PlayerActionHit(nullptr, PlayerAction::Menu)) {
@@ -614,6 +665,13 @@ namespace Jazz2
 				BeginLevelChange(nullptr, ExitType::Warp | ExitType::FastTransition);
 			}
 #endif
+
+			if (_fixedTimestep) {
+				// Menu and console are handled once per frame, so they must not be reported as hit again in the next frame
+				for (auto& input : _playerInputs) {
+					input.PressedActionsLast = (input.PressedActionsLast & ~FrameActions) | (input.PressedActions & FrameActions);
+				}
+			}
 		}
 
 #if defined(WITH_AUDIO)
@@ -636,25 +694,12 @@ namespace Jazz2
 #endif
 
 		if (!IsPausable() || _pauseMenu == nullptr) {
-			if (_nextLevelType != ExitType::None) {
-				_nextLevelTime -= timeMult;
-				ProcessQueuedNextLevel();
-			}
-
-			ProcessEvents(timeMult);
-			ProcessWeather(timeMult);
-
-			// Active Boss
-			if (_activeBoss != nullptr && _activeBoss->GetHealth() <= 0) {
-				_activeBoss = nullptr;
-				BeginLevelChange(nullptr, ExitType::Boss);
-			}
-
-#if defined(WITH_ANGELSCRIPT)
-			if (_scripts != nullptr) {
-				_scripts->OnLevelUpdate(timeMult);
+			if (_fixedTimestep) {
+				// Recording is played back one step per frame regardless of elapsed time
+				RunFixedSteps(_replayPlayer != nullptr ? 1.0f : timeMult);
+			} else {
+				BeginStep(timeMult);
 			}
-#endif
 		}
 	}
 
@@ -668,7 +713,9 @@ namespace Jazz2
 		_tileMap->OnEndFrame();
 
 		if (!IsPausable() || _pauseMenu == nullptr) {
-			ResolveCollisions(timeMult);
+			if (!_fixedTimestep) {
+				EndStep(timeMult);
+			}
 
 			if (!resolver.IsHeadless()) {
 #if defined(NCINE_HAS_GAMEPAD_RUMBLE)
@@ -699,8 +746,6 @@ namespace Jazz2
 				}
 #endif
 			}
-
-			_elapsedFrames += timeMult;
 		}
 
 		if (!resolver.IsHeadless()) {
@@ -933,13 +978,15 @@ namespace Jazz2
 			actor->_collisionProxyID = _collisions.CreateProxy(actor->AABB, actor.get());
 		}
 
+		_actorCore.Add(actor.get());
 		_actors.push_back(std::move(actor));
 	}
 
 	std::shared_ptr<AudioBufferPlayer> LevelHandler::PlaySfx(Actors::ActorBase* self, StringView identifier, AudioBuffer* buffer, const Vector3f& pos, bool sourceRelative, float gain, float pitch)
 	{
 #if defined(WITH_AUDIO)
-		if (buffer != nullptr) {
+		// Sounds of simulated steps were already played
+		if (buffer != nullptr && !_isResimulating) {
 			auto& player = _playingSounds.emplace_back(_assignedViewports.size() > 1
 				? std::make_shared<AudioBufferPlayerForSplitscreen>(buffer, _assignedViewports)
 				: std::make_shared<AudioBufferPlayer>(buffer));
@@ -966,8 +1013,11 @@ namespace Jazz2
 #if defined(WITH_AUDIO)
 		auto it = _commonResources->Sounds.find(String::nullTerminatedView(identifier));
 		if (it != _commonResources->Sounds.end() && !it->second.Buffers.empty()) {
-			std::int32_t idx = (it->second.Buffers.size() > 1 ? Random().Next(0, (std::int32_t)it->second.Buffers.size()) : 0);
-			auto* buffer = &it->second.Buffers[idx]->Buffer;
+			if (_isResimulating) {
+				// Sounds of simulated steps were already played
+				return nullptr;
+			}
+			auto* buffer = &it->second.PickVariant()->Buffer;
 			auto& player = _playingSounds.emplace_back(_assignedViewports.size() > 1
 				? std::make_shared<AudioBufferPlayerForSplitscreen>(buffer, _assignedViewports)
 				: std::make_shared<AudioBufferPlayer>(buffer));
@@ -1345,7 +1395,7 @@ namespace Jazz2
 						_eventMap->Deactivate(originTile.X, originTile.Y);
 					}
 
-					actor->_state |= Actors::ActorState::IsDestroyed;
+					actor->SetState(Actors::ActorState::IsDestroyed, true);
 				}
 			}
 
@@ -1372,9 +1422,8 @@ namespace Jazz2
 		}
 
 		auto it = _commonResources->Sounds.find(String::nullTerminatedView("SugarRush"_s));
-		if (it != _commonResources->Sounds.end()) {
-			std::int32_t idx = (it->second.Buffers.size() > 1 ? Random().Next(0, (std::int32_t)it->second.Buffers.size()) : 0);
-			_sugarRushMusic = _playingSounds.emplace_back(std::make_shared<AudioBufferPlayer>(&it->second.Buffers[idx]->Buffer));
+		if (it != _commonResources->Sounds.end() && !it->second.Buffers.empty()) {
+			_sugarRushMusic = _playingSounds.emplace_back(std::make_shared<AudioBufferPlayer>(&it->second.PickVariant()->Buffer));
 			_sugarRushMusic->setPosition(Vector3f(0.0f, 0.0f, 100.0f));
 			_sugarRushMusic->setGain(PreferencesCache::MasterVolume * PreferencesCache::MusicVolume);
 			_sugarRushMusic->setSourceRelative(true);
@@ -1522,6 +1571,11 @@ namespace Jazz2
 	void LevelHandler::PlayerExecuteRumble(Actors::Player* player, StringView rumbleEffect)
 	{
 #if defined(NCINE_HAS_GAMEPAD_RUMBLE)
+		if (_isResimulating) {
+			// Effects of simulated steps were already executed
+			return;
+		}
+
 		auto it = _rumbleEffects.find(String::nullTerminatedView(rumbleEffect));
 		if (it == _rumbleEffects.end()) {
 			return;
@@ -1600,6 +1654,16 @@ namespace Jazz2
 		// Nothing to do here
 	}
 
+	void LevelHandler::OnSnapshotRestored()
+	{
+		// Nothing to do here
+	}
+
+	void LevelHandler::OnResimulated()
+	{
+		// Nothing to do here
+	}
+
 	void LevelHandler::ProcessEvents(float timeMult)
 	{
 		ZoneScopedC(0x4876AF);
@@ -1617,9 +1681,11 @@ namespace Jazz2
 				playerZones.emplace_back(activationRange.L - 4, activationRange.T - 4, activationRange.R + 4, activationRange.B + 4);
 			}
 
-			for (auto& actor : _actors) {
-				if ((actor->_state & (Actors::ActorState::IsCreatedFromEventMap | Actors::ActorState::IsFromGenerator)) != Actors::ActorState::None) {
-					Vector2i originTile = actor->_originTile;
+			// Only origin tiles and flags are needed to find actors out of range, actors themselves are touched only then
+			for (std::int32_t j = 0; j < _actorCore.GetCount(); j++) {
+				Actors::ActorCoreFlags flags = _actorCore.GetFlags(j);
+				if ((flags & (Actors::ActorCoreFlags::IsCreatedFromEventMap | Actors::ActorCoreFlags::IsFromGenerator)) != Actors::ActorCoreFlags::None) {
+					Vector2i originTile = _actorCore.GetOriginTile(j);
 					bool isInside = false;
 					for (std::size_t i = 1; i < playerZones.size(); i += 2) {
 						if (playerZones[i].Contains(originTile)) {
@@ -1628,13 +1694,19 @@ namespace Jazz2
 						}
 					}
 
-					if (!isInside && actor->OnTileDeactivated()) {
+					if (isInside) {
+						continue;
+					}
+
+					Actors::ActorBase* actor = _actors[j].get();
+					if ((actor->_state & (Actors::ActorState::IsCreatedFromEventMap | Actors::ActorState::IsFromGenerator)) != Actors::ActorState::None &&
+						actor->OnTileDeactivated()) {
 						if ((actor->_state & Actors::ActorState::IsFromGenerator) == Actors::ActorState::IsFromGenerator) {
 							_eventMap->ResetGenerator(originTile.X, originTile.Y);
 						}
 
 						_eventMap->Deactivate(originTile.X, originTile.Y);
-						actor->_state |= Actors::ActorState::IsDestroyed;
+						actor->SetState(Actors::ActorState::IsDestroyed, true);
 					}
 				}
 			}
@@ -1785,17 +1857,17 @@ namespace Jazz2
 				if ((_weatherType & WeatherType::OutdoorsOnly) == WeatherType::OutdoorsOnly) {
 					debrisFlags = TileMap::DebrisFlags::Disappear;
 				} else {
-					debrisFlags = (Random().FastFloat() > 0.7f
+					debrisFlags = (_weatherRandom.FastFloat() > 0.7f
 						? TileMap::DebrisFlags::None
 						: TileMap::DebrisFlags::Disappear);
 				}
 
-				Vector2f debrisPos = Vector2f(zone.X + Random().FastFloat(zone.W * -1.0f, zone.W * 2.0f),
-					zone.Y + Random().NextFloat(zone.H * -1.0f, zone.H * 2.0f));
+				Vector2f debrisPos = Vector2f(zone.X + _weatherRandom.FastFloat(zone.W * -1.0f, zone.W * 2.0f),
+					zone.Y + _weatherRandom.NextFloat(zone.H * -1.0f, zone.H * 2.0f));
 
-				float scale = Random().FastFloat(0.4f, 1.1f);
+				float scale = _weatherRandom.FastFloat(0.4f, 1.1f);
 
-				std::uint32_t curAnimFrame = res->FrameOffset + Random().Next(0, res->FrameCount);
+				std::uint32_t curAnimFrame = res->FrameOffset + _weatherRandom.Next(0, res->FrameCount);
 				Recti frameRect = resBase->GetFrameRect(curAnimFrame);
 				Vector2i frameOffset = resBase->GetFrameOffset(curAnimFrame);
 
@@ -1809,19 +1881,19 @@ namespace Jazz2
 					frameOffset.Y + (frameRect.H - resBase->FrameDimensions.Y) * 0.5f);
 
 				if (isRain) {
-					float speedX = Random().FastFloat(2.2f, 2.7f) * scale;
-					float speedY = Random().FastFloat(7.6f, 8.6f) * scale;
+					float speedX = _weatherRandom.FastFloat(2.2f, 2.7f) * scale;
+					float speedY = _weatherRandom.FastFloat(7.6f, 8.6f) * scale;
 					debris.Speed = Vector2f(speedX, speedY);
 					debris.Acceleration = Vector2f(0.0f, 0.0f);
 					debris.Angle = atan2f(speedY, speedX);
 					debris.AngleSpeed = 0.0f;
 				} else {
-					float speedX = Random().FastFloat(-1.6f, -1.2f) * scale;
-					float speedY = Random().FastFloat(3.0f, 4.0f) * scale;
-					float accel = Random().FastFloat(-0.008f, 0.008f) * scale;
+					float speedX = _weatherRandom.FastFloat(-1.6f, -1.2f) * scale;
+					float speedY = _weatherRandom.FastFloat(3.0f, 4.0f) * scale;
+					float accel = _weatherRandom.FastFloat(-0.008f, 0.008f) * scale;
 					debris.Speed = Vector2f(speedX, speedY);
 					debris.Acceleration = Vector2f(accel, -std::abs(accel));
-					debris.Angle = Random().FastFloat(0.0f, fTwoPi);
+					debris.Angle = _weatherRandom.FastFloat(0.0f, fTwoPi);
 					debris.AngleSpeed = speedX * 0.02f;
 				}
 
@@ -1850,29 +1922,44 @@ namespace Jazz2
 	{
 		ZoneScopedC(0x4876AF);
 
-		auto it = _actors.begin();
-		while (it != _actors.end()) {
-			Actors::ActorBase* actor = it->get();
+		// Most actors neither moved nor were destroyed, so only the flags are scanned and actors are touched only if needed
+		std::int32_t i = 0;
+		while (i < _actorCore.GetCount()) {
+			Actors::ActorCoreFlags flags = _actorCore.GetFlags(i);
+			if ((flags & (Actors::ActorCoreFlags::IsDirty | Actors::ActorCoreFlags::IsDestroyed)) == Actors::ActorCoreFlags::None) {
+				i++;
+				continue;
+			}
+
+			// Flags are only set by the table, the actor state is authoritative
+			Actors::ActorBase* actor = _actors[i].get();
 			if (actor->GetState(Actors::ActorState::IsDestroyed)) {
 				BeforeActorDestroyed(actor);
-				if (actor->_collisionProxyID != Collisions::NullNode) {
-					_collisions.DestroyProxy(actor->_collisionProxyID);
+				std::int32_t proxyId = _actorCore.GetProxyID(i);
+				if (proxyId != Collisions::NullNode) {
+					_collisions.DestroyProxy(proxyId);
 					actor->_collisionProxyID = Collisions::NullNode;
 				}
-				it = _actors.eraseUnordered(it);
+				if (_rollback != nullptr || _frameState != nullptr) {
+					// Snapshots can keep the actor alive for a while, so it must leave the scene now, otherwise it's removed
+					// when the last reference is released, which can be later if another actor still holds it
+					actor->SetParent(nullptr);
+				}
+				_actorCore.RemoveUnordered(i);
+				_actors.eraseUnordered(_actors.begin() + i);
 				continue;
 			}
-			
+
 			if (actor->GetState(Actors::ActorState::IsDirty)) {
-				if (actor->_collisionProxyID == Collisions::NullNode) {
-					continue;
+				std::int32_t proxyId = _actorCore.GetProxyID(i);
+				if (proxyId != Collisions::NullNode) {
+					actor->UpdateAABB();
+					_collisions.MoveProxy(proxyId, actor->AABB, actor->_speed * timeMult);
+					actor->SetState(Actors::ActorState::IsDirty, false);
 				}
-
-				actor->UpdateAABB();
-				_collisions.MoveProxy(actor->_collisionProxyID, actor->AABB, actor->_speed * timeMult);
-				actor->SetState(Actors::ActorState::IsDirty, false);
 			}
-			++it;
+			_actorCore.ClearFlags(i, Actors::ActorCoreFlags::IsDirty | Actors::ActorCoreFlags::IsDestroyed);
+			i++;
 		}
 
 		struct UpdatePairsHelper {
@@ -2152,6 +2239,731 @@ namespace Jazz2
 		return result;
 	}
 
+	void LevelHandler::InitializeSimulation()
+	{
+		_fixedTimestep = ((PreferencesCache::FixedTimestep || _replayPlayer != nullptr) && IsFixedTimestepAllowed());
+		_stepAccumulator = 0.0f;
+		_interpolationFactor = 0.0f;
+		_stepIndex = 0;
+		_rollback = (_fixedTimestep && PreferencesCache::EnableRollback ? std::make_unique<RollbackBuffer>() : nullptr);
+		_parallelActorUpdate = PreferencesCache::ParallelActorUpdate;
+		if (_parallelActorUpdate) {
+			LOGI("Movement of eligible actors is updated in parallel");
+		}
+
+		// In fixed-timestep mode, the scene is updated only by RunFixedSteps()
+		_rootNode->setUpdateEnabled(!_fixedTimestep);
+
+		if (_fixedTimestep) {
+			// The same level on the same difficulty always starts with the same random sequence
+			Random().Init(GetSimulationSeed(), (std::uint64_t)_difficulty);
+			if (_rollback != nullptr) {
+				LOGI("Level \"{}\" is simulated with fixed timestep and rollback of the last {} steps", _levelName, RollbackBuffer::Capacity);
+			} else {
+				LOGI("Level \"{}\" is simulated with fixed timestep", _levelName);
+			}
+		}
+	}
+
+	void LevelHandler::BeginStep(float timeMult)
+	{
+		if (_nextLevelType != ExitType::None) {
+			_nextLevelTime -= timeMult;
+			ProcessQueuedNextLevel();
+		}
+
+		ProcessEvents(timeMult);
+		ProcessWeather(timeMult);
+
+		// Active Boss
+		if (_activeBoss != nullptr && _activeBoss->GetHealth() <= 0) {
+			_activeBoss = nullptr;
+			BeginLevelChange(nullptr, ExitType::Boss);
+		}
+
+#if defined(WITH_ANGELSCRIPT)
+		if (_scripts != nullptr) {
+			_scripts->OnLevelUpdate(timeMult);
+		}
+#endif
+
+		if (_parallelActorUpdate) {
+			TimeStamp parallelStart = TimeStamp::now();
+			UpdateActorPhysicsInParallel(timeMult);
+			_parallelPhaseTime = parallelStart.microsecondsSince();
+			TracyPlot("Actor Update Parallel (us)", _parallelPhaseTime);
+		}
+	}
+
+	void LevelHandler::EndStep(float timeMult)
+	{
+		ResolveCollisions(timeMult);
+
+		_elapsedFrames += timeMult;
+	}
+
+	void LevelHandler::UpdateActorPhysicsInParallel(float timeMult)
+	{
+		ZoneScopedC(0x4876AF);
+
+		// Actors are processed in batches, because movement of a single actor is too short to be worth a job
+		constexpr std::uint32_t BatchSize = 32;
+
+		_parallelPhysicsActors.clear();
+		for (auto& actor : _actors) {
+			if (actor->CanUpdatePhysicsInParallel()) {
+				_parallelPhysicsActors.push_back(actor.get());
+			}
+		}
+
+		// Each actor writes only its own state and reads only the tile map, which is not modified until the serial phase
+		std::uint32_t actorCount = (std::uint32_t)_parallelPhysicsActors.size();
+		ParallelFor((actorCount + BatchSize - 1) / BatchSize, [this, actorCount, timeMult](std::uint32_t index) {
+			std::uint32_t end = std::min((index + 1) * BatchSize, actorCount);
+			for (std::uint32_t i = index * BatchSize; i < end; i++) {
+				_parallelPhysicsActors[i]->UpdatePhysicsInParallel(timeMult);
+			}
+		});
+	}
+
+	void LevelHandler::RunFixedSteps(float timeMult)
+	{
+		ZoneScopedC(0x4876AF);
+
+		constexpr float StepTimeMult = 1.0f;
+
+		_stepAccumulator += timeMult;
+
+		std::int32_t stepCount = std::min((std::int32_t)(_stepAccumulator / StepTimeMult), MaxFixedStepsPerFrame);
+		_stepAccumulator -= stepCount * StepTimeMult;
+		if (_stepAccumulator >= StepTimeMult) {
+			// The frame rate is too low to keep up, so the remaining time is dropped and the game slows down instead
+			_stepAccumulator = std::fmod(_stepAccumulator, StepTimeMult);
+		}
+
+		for (std::int32_t i = 0; i < stepCount; i++) {
+			TimeStamp stepStart;
+			if (_replayPlayer != nullptr) {
+				bool hasStep = _replayPlayer->FetchStep(_stepIndex);
+				if (_stepIndex > 0) {
+					_replayPlayer->VerifyChecksum(_stepIndex, _stepChecksum);
+				}
+				if (!hasStep) {
+					EndReplay();
+					break;
+				}
+				for (std::int32_t j = 0; j < ControlScheme::MaxSupportedPlayers; j++) {
+					auto& input = _playerInputs[j];
+					input.PressedActions = _replayPlayer->GetPressedActions(j);
+					input.RequiredMovement = _replayPlayer->GetRequiredMovement(j);
+				}
+				stepStart = TimeStamp::now();
+			} else if (_replayRecorder != nullptr) {
+				// Menu and console are handled outside of the simulation, so they are not recorded
+				for (std::int32_t j = 0; j < ControlScheme::MaxSupportedPlayers; j++) {
+					const auto& input = _playerInputs[j];
+					_replayRecorder->RecordInput(_stepIndex, j, input.PressedActions & ~FrameActions, input.RequiredMovement);
+				}
+			}
+
+			if (_rollback != nullptr) {
+				SaveSnapshot(_rollback->Acquire(_stepIndex));
+				TrimEventJournal();
+			}
+
+			SimulateStep();
+
+			if (_replayPlayer != nullptr) {
+				_replayPlayer->AddStepTime(stepStart.microsecondsSince());
+			}
+			if (_replayRecorder != nullptr || _replayPlayer != nullptr) {
+				// The state is taken right after the step, so nothing that runs between frames can affect it
+				_stepChecksum = ComputeSimulationChecksum();
+				if (_replayRecorder != nullptr && (_stepIndex % ReplayRecorder::ChecksumInterval) == 0) {
+					_replayRecorder->RecordChecksum(_stepIndex, _stepChecksum);
+				}
+			}
+
+			if (_nextLevelType != ExitType::None && _nextLevelTime <= 0.0f) {
+				// Level change was just handed over, no more steps should follow
+				_stepAccumulator = 0.0f;
+				break;
+			}
+		}
+
+		_interpolationFactor = _stepAccumulator / StepTimeMult;
+		for (auto& actor : _actors) {
+			actor->_renderer.Interpolate(_interpolationFactor);
+		}
+	}
+
+	void LevelHandler::SimulateStep()
+	{
+		constexpr float StepTimeMult = 1.0f;
+
+		BeginStep(StepTimeMult);
+
+		// The scene is updated only here, in fixed steps, the regular update with variable timestep is suppressed
+		TimeStamp serialStart = TimeStamp::now();
+		_rootNode->setUpdateEnabled(true);
+		_rootNode->OnUpdate(StepTimeMult);
+		_rootNode->setUpdateEnabled(false);
+		float serialPhaseTime = serialStart.microsecondsSince();
+		TracyPlot("Actor Update Serial (us)", serialPhaseTime);
+		if (_replayPlayer != nullptr) {
+			_replayPlayer->AddActorUpdateTime(_parallelActorUpdate ? _parallelPhaseTime : 0.0f, serialPhaseTime);
+		}
+
+		EndStep(StepTimeMult);
+		_stepIndex++;
+
+		// Input is sampled once per frame, so actions hit in this frame are reported only in the first step
+		for (auto& input : _playerInputs) {
+			input.PressedActionsLast = input.PressedActions;
+		}
+	}
+
+	std::uint64_t LevelHandler::GetSimulationSeed() const
+	{
+		if (_replayPlayer != nullptr) {
+			return _replayPlayer->GetSeed();
+		}
+		return Death::Cryptography::xxHash3(_levelName.data(), _levelName.size());
+	}
+
+	void LevelHandler::SetReplayPlayer(std::unique_ptr<ReplayPlayer> replayPlayer)
+	{
+		_replayPlayer = std::move(replayPlayer);
+	}
+
+	std::uint64_t LevelHandler::ComputeSimulationChecksum() const
+	{
+		// Any difference in calls to the shared random generator changes its state, actors cover the rest
+		SmallVector<float, 0> state;
+		state.reserve(_actors.size() * 5 + 2);
+		state.push_back((float)_actors.size());
+		state.push_back(_elapsedFrames);
+		for (const auto& actor : _actors) {
+			state.push_back(actor->_pos.X);
+			state.push_back(actor->_pos.Y);
+			state.push_back(actor->_speed.X);
+			state.push_back(actor->_speed.Y);
+			state.push_back((float)actor->_health);
+		}
+
+		const RandomGenerator& random = Random();
+		std::uint64_t actorsHash = Death::Cryptography::xxHash3(state.data(), state.size() * sizeof(float));
+		return Death::Cryptography::xxHash3(&random, sizeof(random), actorsHash);
+	}
+
+	void LevelHandler::EndReplay()
+	{
+		_replayPlayer->ReportResults();
+		_replayPlayer = nullptr;
+		theApplication().Quit();
+	}
+
+	void LevelHandler::SaveSnapshot(RollbackBuffer::Snapshot& snapshot)
+	{
+		ZoneScopedC(0x4876AF);
+
+		for (std::int32_t i = 0; i < ControlScheme::MaxSupportedPlayers; i++) {
+			const auto& input = _playerInputs[i];
+			snapshot.Inputs[i] = { input.PressedActions, input.PressedActionsLast, input.RequiredMovement, input.FrozenMovement, input.Frozen };
+		}
+
+		snapshot.Actors.clear();
+		snapshot.Actors.append(_actors.begin(), _actors.end());
+		// Callbacks cannot be serialized, so the snapshot keeps them instead
+		snapshot.TransitionCallbacks.clear();
+		for (auto& actor : _actors) {
+			snapshot.TransitionCallbacks.push_back(actor->_currentTransitionCallback);
+		}
+		snapshot.RootChildren.clear();
+		snapshot.RootChildren.append(_rootNode->children().begin(), _rootNode->children().end());
+		snapshot.GeneratorActors.clear();
+		snapshot.ActiveBoss = _activeBoss;
+		snapshot.Collisions.CopyFrom(_collisions);
+		snapshot.Random = Random();
+
+		MemoryStream& s = snapshot.Data;
+		s.Seek(0, SeekOrigin::Begin);
+		s.WriteValue<float>(_elapsedFrames);
+		s.WriteValue<float>(_waterLevel);
+		s.WriteValue<WeatherType>(_weatherType);
+		s.WriteValue<std::uint8_t>(_weatherIntensity);
+		_tileMap->SaveSnapshot(s);
+		snapshot.EventJournalPos = _eventMap->SaveSnapshot(s, snapshot.GeneratorActors);
+		for (auto& actor : _actors) {
+			actor->OnSaveSnapshot(s);
+		}
+	}
+
+	void LevelHandler::RestoreSnapshot(RollbackBuffer::Snapshot& snapshot)
+	{
+		ZoneScopedC(0x4876AF);
+
+		for (std::int32_t i = 0; i < ControlScheme::MaxSupportedPlayers; i++) {
+			const auto& saved = snapshot.Inputs[i];
+			auto& input = _playerInputs[i];
+			input.PressedActions = saved.PressedActions;
+			input.PressedActionsLast = saved.PressedActionsLast;
+			input.RequiredMovement = saved.RequiredMovement;
+			input.FrozenMovement = saved.FrozenMovement;
+			input.Frozen = saved.Frozen;
+		}
+
+		// Actors spawned since are dropped without notification, as if they never existed, and destroyed ones are put back
+		_actors.clear();
+		_actors.append(snapshot.Actors.begin(), snapshot.Actors.end());
+		_rootNode->removeAllChildrenNodes();
+		for (SceneNode* node : snapshot.RootChildren) {
+			_rootNode->addChildNode(node);
+		}
+		_activeBoss = std::static_pointer_cast<Actors::Bosses::BossBase>(snapshot.ActiveBoss);
+		_collisions.CopyFrom(snapshot.Collisions);
+		Random() = snapshot.Random;
+
+		MemoryStream& s = snapshot.Data;
+		s.Seek(0, SeekOrigin::Begin);
+		_elapsedFrames = s.ReadValue<float>();
+		_waterLevel = s.ReadValue<float>();
+		_weatherType = s.ReadValue<WeatherType>();
+		_weatherIntensity = s.ReadValue<std::uint8_t>();
+		_tileMap->RestoreSnapshot(s);
+		_eventMap->RestoreSnapshot(s, snapshot.GeneratorActors, snapshot.EventJournalPos);
+		for (std::size_t i = 0; i < _actors.size(); i++) {
+			_actors[i]->OnRestoreSnapshot(s);
+			_actors[i]->_currentTransitionCallback = snapshot.TransitionCallbacks[i];
+		}
+		_actorCore.Rebuild(_actors);
+
+		OnSnapshotRestored();
+	}
+
+	bool LevelHandler::SaveFrameState(Stream& dest)
+	{
+		ZoneScopedC(0x4876AF);
+
+		if (_nextLevelType != ExitType::None) {
+			// Level change has side effects outside of the simulation, so it cannot be undone
+			return false;
+		}
+
+		if (_frameState == nullptr) {
+			_frameState = std::make_unique<RollbackBuffer::Snapshot>();
+		}
+		RollbackBuffer::Snapshot& snapshot = *_frameState;
+		SaveSnapshot(snapshot);
+
+		// Actors are written as addresses of their renderers, which are also the nodes in the scene
+		std::uint32_t saveIndex = ++_frameStateSaveCount;
+		if (_frameStateJournalPos == nullptr) {
+			_frameStateJournalPos = std::make_unique<std::uint64_t[]>(FrameStateRetention);
+			std::fill_n(_frameStateJournalPos.get(), FrameStateRetention, snapshot.EventJournalPos);
+		}
+		_frameStateJournalPos[saveIndex % FrameStateRetention] = snapshot.EventJournalPos;
+		TrimEventJournal();
+
+		auto writeActor = [this, &dest, saveIndex](const std::shared_ptr<Actors::ActorBase>& actor) {
+			SceneNode* node = nullptr;
+			if (actor != nullptr) {
+				node = &actor->_renderer;
+				auto it = _frameStateActors.find(node);
+				if (it != _frameStateActors.end()) {
+					it->second.LastSave = saveIndex;
+				} else {
+					_frameStateActors.emplace(node, FrameStateActor{actor, saveIndex, saveIndex});
+				}
+			}
+			dest.WriteValue<std::uint64_t>((std::uint64_t)(std::uintptr_t)node);
+		};
+		auto writeCallback = [this, &dest, saveIndex](const std::shared_ptr<Function<void()>>& callback) {
+			if (callback != nullptr) {
+				auto it = _frameStateCallbacks.find(callback.get());
+				if (it != _frameStateCallbacks.end()) {
+					it->second.LastSave = saveIndex;
+				} else {
+					_frameStateCallbacks.emplace(callback.get(), FrameStateCallback{callback, saveIndex, saveIndex});
+				}
+			}
+			dest.WriteValue<std::uint64_t>((std::uint64_t)(std::uintptr_t)callback.get());
+		};
+
+		dest.WriteValue<std::uint32_t>(_frameStateSession);
+		dest.WriteValue<std::uint32_t>(saveIndex);
+		dest.WriteValue<std::uint32_t>((std::uint32_t)_assignedViewports.size());
+		dest.WriteValue<std::uint32_t>(_stepIndex);
+		dest.WriteValue<float>(_stepAccumulator);
+		dest.WriteValue<float>(_interpolationFactor);
+
+		for (const auto& input : snapshot.Inputs) {
+			dest.WriteValue<std::uint64_t>(input.PressedActions);
+			dest.WriteValue<std::uint64_t>(input.PressedActionsLast);
+			dest.WriteValue<float>(input.RequiredMovement.X);
+			dest.WriteValue<float>(input.RequiredMovement.Y);
+			dest.WriteValue<float>(input.FrozenMovement.X);
+			dest.WriteValue<float>(input.FrozenMovement.Y);
+			dest.WriteValue<std::uint8_t>(input.Frozen ? 1 : 0);
+		}
+
+		dest.WriteValue<std::uint32_t>((std::uint32_t)snapshot.Actors.size());
+		for (const auto& actor : snapshot.Actors) {
+			writeActor(actor);
+		}
+		for (const auto& callback : snapshot.TransitionCallbacks) {
+			writeCallback(callback);
+		}
+		dest.WriteValue<std::uint32_t>((std::uint32_t)snapshot.RootChildren.size());
+		for (SceneNode* node : snapshot.RootChildren) {
+			dest.WriteValue<std::uint64_t>((std::uint64_t)(std::uintptr_t)node);
+		}
+		dest.WriteValue<std::uint32_t>((std::uint32_t)snapshot.GeneratorActors.size());
+		for (const auto& actor : snapshot.GeneratorActors) {
+			writeActor(actor);
+		}
+		writeActor(snapshot.ActiveBoss);
+
+		snapshot.Collisions.SaveSnapshot(dest);
+		dest.WriteValue<RandomGenerator>(snapshot.Random);
+		dest.WriteValue<std::uint64_t>(snapshot.EventJournalPos);
+
+		std::uint32_t dataSize = (std::uint32_t)snapshot.Data.GetPosition();
+		dest.WriteValue<std::uint32_t>(dataSize);
+		dest.Write(snapshot.Data.GetBuffer(), dataSize);
+		_eventMap->SaveSnapshotJournal(dest);
+
+		for (const auto& viewport : _assignedViewports) {
+			dest.WriteValue<float>(viewport->_viewBounds.X);
+			dest.WriteValue<float>(viewport->_viewBounds.Y);
+			dest.WriteValue<float>(viewport->_viewBounds.W);
+			dest.WriteValue<float>(viewport->_viewBounds.H);
+			dest.WriteValue<float>(viewport->_cameraPos.X);
+			dest.WriteValue<float>(viewport->_cameraPos.Y);
+			dest.WriteValue<float>(viewport->_cameraLastPos.X);
+			dest.WriteValue<float>(viewport->_cameraLastPos.Y);
+			dest.WriteValue<float>(viewport->_cameraDistanceFactor.X);
+			dest.WriteValue<float>(viewport->_cameraDistanceFactor.Y);
+			dest.WriteValue<float>(viewport->_cameraViewCenterY);
+			dest.WriteValue<float>(viewport->_shakeDuration);
+			dest.WriteValue<float>(viewport->_shakeOffset.X);
+			dest.WriteValue<float>(viewport->_shakeOffset.Y);
+		}
+
+		// References are held by the tables below instead, so destroyed actors can be freed once they are too old
+		snapshot.Actors.clear();
+		snapshot.TransitionCallbacks.clear();
+		snapshot.RootChildren.clear();
+		snapshot.GeneratorActors.clear();
+		snapshot.ActiveBoss = nullptr;
+
+		if ((saveIndex % 64) == 0) {
+			for (auto it = _frameStateActors.begin(); it != _frameStateActors.end(); ) {
+				if (saveIndex - it->second.LastSave > FrameStateRetention) {
+					_frameStateActors.erase(it++);
+				} else {
+					++it;
+				}
+			}
+			for (auto it = _frameStateCallbacks.begin(); it != _frameStateCallbacks.end(); ) {
+				if (saveIndex - it->second.LastSave > FrameStateRetention) {
+					_frameStateCallbacks.erase(it++);
+				} else {
+					++it;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	bool LevelHandler::LoadFrameState(Stream& src)
+	{
+		ZoneScopedC(0x4876AF);
+
+		if (_nextLevelType != ExitType::None || _replayRecorder != nullptr || _replayPlayer != nullptr || _frameState == nullptr) {
+			return false;
+		}
+
+		std::uint32_t session = src.ReadValue<std::uint32_t>();
+		std::uint32_t saveIndex = src.ReadValue<std::uint32_t>();
+		std::uint32_t viewportCount = src.ReadValue<std::uint32_t>();
+		if (session != _frameStateSession || saveIndex == 0 || saveIndex > _frameStateSaveCount || viewportCount != _assignedViewports.size()) {
+			return false;
+		}
+
+		RollbackBuffer::Snapshot& snapshot = *_frameState;
+		auto releaseReferences = [&snapshot]() {
+			snapshot.Actors.clear();
+			snapshot.TransitionCallbacks.clear();
+			snapshot.RootChildren.clear();
+			snapshot.GeneratorActors.clear();
+			snapshot.ActiveBoss = nullptr;
+		};
+		// Address of a destroyed actor can be reused by a newer one, so the actor must be known since the state was saved
+		auto readActor = [this, &src, saveIndex](std::shared_ptr<Actors::ActorBase>& actor) -> bool {
+			std::uint64_t address = src.ReadValue<std::uint64_t>();
+			if (address == 0) {
+				actor = nullptr;
+				return true;
+			}
+			auto it = _frameStateActors.find((SceneNode*)(std::uintptr_t)address);
+			if (it == _frameStateActors.end() || it->second.FirstSave > saveIndex) {
+				return false;
+			}
+			actor = it->second.Actor;
+			return true;
+		};
+		auto readCallback = [this, &src, saveIndex](std::shared_ptr<Function<void()>>& callback) -> bool {
+			std::uint64_t address = src.ReadValue<std::uint64_t>();
+			if (address == 0) {
+				callback = nullptr;
+				return true;
+			}
+			auto it = _frameStateCallbacks.find((Function<void()>*)(std::uintptr_t)address);
+			if (it == _frameStateCallbacks.end() || it->second.FirstSave > saveIndex) {
+				return false;
+			}
+			callback = it->second.Callback;
+			return true;
+		};
+
+		std::uint32_t stepIndex = src.ReadValue<std::uint32_t>();
+		float stepAccumulator = src.ReadValue<float>();
+		float interpolationFactor = src.ReadValue<float>();
+
+		for (auto& input : snapshot.Inputs) {
+			input.PressedActions = src.ReadValue<std::uint64_t>();
+			input.PressedActionsLast = src.ReadValue<std::uint64_t>();
+			input.RequiredMovement.X = src.ReadValue<float>();
+			input.RequiredMovement.Y = src.ReadValue<float>();
+			input.FrozenMovement.X = src.ReadValue<float>();
+			input.FrozenMovement.Y = src.ReadValue<float>();
+			input.Frozen = (src.ReadValue<std::uint8_t>() != 0);
+		}
+
+		std::uint32_t actorCount = src.ReadValue<std::uint32_t>();
+		snapshot.Actors.resize(actorCount);
+		for (auto& actor : snapshot.Actors) {
+			if (!readActor(actor)) {
+				releaseReferences();
+				return false;
+			}
+		}
+		snapshot.TransitionCallbacks.resize(actorCount);
+		for (auto& callback : snapshot.TransitionCallbacks) {
+			if (!readCallback(callback)) {
+				releaseReferences();
+				return false;
+			}
+		}
+
+		std::uint32_t rootChildCount = src.ReadValue<std::uint32_t>();
+		const auto& currentChildren = _rootNode->children();
+		for (std::uint32_t i = 0; i < rootChildCount; i++) {
+			SceneNode* node = (SceneNode*)(std::uintptr_t)src.ReadValue<std::uint64_t>();
+			// Nodes that are not actors (e.g. HUD) are never removed from the scene while the level is running
+			auto it = _frameStateActors.find(node);
+			bool isKnown = (it != _frameStateActors.end()
+				? it->second.FirstSave <= saveIndex
+				: std::find(currentChildren.begin(), currentChildren.end(), node) != currentChildren.end());
+			if (!isKnown) {
+				releaseReferences();
+				return false;
+			}
+			snapshot.RootChildren.push_back(node);
+		}
+
+		std::uint32_t generatorCount = src.ReadValue<std::uint32_t>();
+		snapshot.GeneratorActors.resize(generatorCount);
+		for (auto& actor : snapshot.GeneratorActors) {
+			if (!readActor(actor)) {
+				releaseReferences();
+				return false;
+			}
+		}
+		if (!readActor(snapshot.ActiveBoss)) {
+			releaseReferences();
+			return false;
+		}
+
+		snapshot.Collisions.RestoreSnapshot(src);
+		snapshot.Random = src.ReadValue<RandomGenerator>();
+		snapshot.EventJournalPos = src.ReadValue<std::uint64_t>();
+
+		std::uint32_t dataSize = src.ReadValue<std::uint32_t>();
+		snapshot.Data.Seek(0, SeekOrigin::Begin);
+		std::uint8_t buffer[4096];
+		while (dataSize > 0) {
+			std::uint32_t chunkSize = std::min(dataSize, (std::uint32_t)sizeof(buffer));
+			if (src.Read(buffer, chunkSize) != chunkSize) {
+				releaseReferences();
+				return false;
+			}
+			snapshot.Data.Write(buffer, chunkSize);
+			dataSize -= chunkSize;
+		}
+
+		// Consumed event tiles are the only part of the level that is changed before the state is fully validated
+		if (!_eventMap->RestoreSnapshotJournal(src)) {
+			releaseReferences();
+			return false;
+		}
+
+		for (auto& viewport : _assignedViewports) {
+			viewport->_viewBounds.X = src.ReadValue<float>();
+			viewport->_viewBounds.Y = src.ReadValue<float>();
+			viewport->_viewBounds.W = src.ReadValue<float>();
+			viewport->_viewBounds.H = src.ReadValue<float>();
+			viewport->_cameraPos.X = src.ReadValue<float>();
+			viewport->_cameraPos.Y = src.ReadValue<float>();
+			viewport->_cameraLastPos.X = src.ReadValue<float>();
+			viewport->_cameraLastPos.Y = src.ReadValue<float>();
+			viewport->_cameraDistanceFactor.X = src.ReadValue<float>();
+			viewport->_cameraDistanceFactor.Y = src.ReadValue<float>();
+			viewport->_cameraViewCenterY = src.ReadValue<float>();
+			viewport->_shakeDuration = src.ReadValue<float>();
+			viewport->_shakeOffset.X = src.ReadValue<float>();
+			viewport->_shakeOffset.Y = src.ReadValue<float>();
+		}
+
+		RestoreSnapshot(snapshot);
+		releaseReferences();
+
+		_stepIndex = stepIndex;
+		_stepAccumulator = stepAccumulator;
+		_interpolationFactor = interpolationFactor;
+		// Positions saved after this state belong to a different timeline, they must not cause it to be trimmed
+		for (std::uint32_t i = 0; i < FrameStateRetention; i++) {
+			_frameStateJournalPos[i] = std::min(_frameStateJournalPos[i], snapshot.EventJournalPos);
+		}
+		if (_rollback != nullptr) {
+			// Snapshots of the steps that were just undone belong to a different timeline
+			_rollback->Clear();
+		}
+		if (_fixedTimestep) {
+			for (auto& actor : _actors) {
+				actor->_renderer.Interpolate(_interpolationFactor);
+			}
+		}
+
+		return true;
+	}
+
+	void LevelHandler::TrimEventJournal()
+	{
+		// Consumed event tiles are needed only as long as some snapshot or frame state refers to them
+		std::uint64_t journalPos = UINT64_MAX;
+		if (_rollback != nullptr) {
+			if (RollbackBuffer::Snapshot* oldest = _rollback->GetOldest()) {
+				journalPos = oldest->EventJournalPos;
+			}
+		}
+		if (_frameStateJournalPos != nullptr) {
+			// The oldest slot is overwritten by the next save, so it's the oldest one that can still be loaded
+			journalPos = std::min(journalPos, _frameStateJournalPos[(_frameStateSaveCount + 1) % FrameStateRetention]);
+		}
+		if (journalPos != UINT64_MAX) {
+			_eventMap->TrimSnapshotJournal(journalPos);
+		}
+	}
+
+	bool LevelHandler::ApplyLateInput(std::uint32_t step, std::int32_t playerIndex, std::uint64_t pressedActions, Vector2f requiredMovement)
+	{
+		ZoneScopedC(0x4876AF);
+
+		if (_rollback == nullptr || playerIndex < 0 || playerIndex >= ControlScheme::MaxSupportedPlayers || step > _stepIndex) {
+			return false;
+		}
+
+		if (step < _stepIndex) {
+			if (!CanResimulateFrom(step)) {
+				return false;
+			}
+
+			// The input replaces the prediction in all following steps
+			for (std::uint32_t i = step; i < _stepIndex; i++) {
+				auto& input = _rollback->Find(i)->Inputs[playerIndex];
+				input.PressedActions = pressedActions;
+				input.RequiredMovement = requiredMovement;
+				if (i > step) {
+					input.PressedActionsLast = pressedActions;
+				}
+			}
+
+			ResimulateFrom(step, {});
+
+			// The last simulated step already reported actions of the input as hit
+			_playerInputs[playerIndex].PressedActionsLast = pressedActions;
+		}
+
+		// The input is also the prediction for all following steps
+		auto& input = _playerInputs[playerIndex];
+		input.PressedActions = pressedActions;
+		input.RequiredMovement = requiredMovement;
+		return true;
+	}
+
+	bool LevelHandler::CanResimulateFrom(std::uint32_t step)
+	{
+		// Level change has side effects outside of the simulation, so it cannot be undone
+		return (_rollback != nullptr && step < _stepIndex && _rollback->Find(step) != nullptr && _nextLevelType == ExitType::None);
+	}
+
+	void LevelHandler::ResimulateFrom(std::uint32_t step, Function<void(std::uint32_t)>&& applyInput)
+	{
+		// Input of the current frame was already sampled, it must survive the simulation
+		PlayerInput currentInputs[ControlScheme::MaxSupportedPlayers];
+		std::copy(std::begin(_playerInputs), std::end(_playerInputs), currentInputs);
+
+		std::uint32_t lastStep = _stepIndex;
+		RollbackBuffer::Snapshot* snapshot = _rollback->Find(step);
+		RestoreSnapshot(*snapshot);
+		_stepIndex = step;
+
+		_isResimulating = true;
+		while (_stepIndex < lastStep) {
+			snapshot = _rollback->Find(_stepIndex);
+			if (_stepIndex != step) {
+				for (std::int32_t i = 0; i < ControlScheme::MaxSupportedPlayers; i++) {
+					const auto& saved = snapshot->Inputs[i];
+					auto& input = _playerInputs[i];
+					input.PressedActions = saved.PressedActions;
+					input.PressedActionsLast = saved.PressedActionsLast;
+					input.RequiredMovement = saved.RequiredMovement;
+				}
+			}
+			if (applyInput) {
+				applyInput(_stepIndex);
+			}
+			if (_stepIndex != step) {
+				SaveSnapshot(*snapshot);
+			}
+			SimulateStep();
+
+			if (_nextLevelType != ExitType::None) {
+				// Snapshots of the following steps belong to the mispredicted branch
+				_rollback->DiscardFrom(_stepIndex);
+				break;
+			}
+		}
+		_isResimulating = false;
+
+		std::copy(std::begin(currentInputs), std::end(currentInputs), _playerInputs);
+		OnResimulated();
+
+		for (auto& actor : _actors) {
+			actor->_renderer.Interpolate(_interpolationFactor);
+		}
+	}
+
+	void LevelHandler::DiscardRollbackHistory()
+	{
+		if (_rollback != nullptr) {
+			_rollback->Clear();
+		}
+	}
+
 	void LevelHandler::UpdatePressedActions()
 	{
 		ZoneScopedC(0x4876AF);
@@ -2172,7 +2984,11 @@ namespace Jazz2
 				_pressedKeys, ArrayView(joyStates, joyStatesCount), input.PressedActions,
 				_hud == nullptr || !_hud->IsWeaponWheelVisible(i));
 
-			input.PressedActionsLast = input.PressedActions;
+			if (!_fixedTimestep) {
+				// In fixed-timestep mode, actions are marked as handled only once a step was simulated,
+				// so actions hit in a frame without any step are not lost
+				input.PressedActionsLast = input.PressedActions;
+			}
 			input.PressedActions = processedInput.PressedActions;
 			input.RequiredMovement = processedInput.Movement;
 		}
@@ -2382,8 +3198,8 @@ namespace Jazz2
 
 	void LevelHandler::ResumeGame()
 	{
-		// Resume all level objects
-		_rootNode->setUpdateEnabled(true);
+		// Resume all level objects, in fixed-timestep mode they are updated only by RunFixedSteps()
+		_rootNode->setUpdateEnabled(!_fixedTimestep);
 		// Hide in-game pause menu
 		_pauseMenu = nullptr;
 
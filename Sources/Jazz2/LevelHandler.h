@@ -5,7 +5,10 @@
 #include "IStateHandler.h"
 #include "IRootController.h"
 #include "LevelDescriptor.h"
+#include "Replay.h"
+#include "RollbackBuffer.h"
 #include "WeatherType.h"
+#include "Actors/ActorCoreTable.h"
 #include "Events/EventMap.h"
 #include "Events/EventSpawner.h"
 #include "Tiles/ITileMapOwner.h"
@@ -93,6 +96,12 @@ namespace Jazz2
 		static constexpr std::int32_t DefaultHeight = 405;
 		/** @brief Range of tile activation */
 		static constexpr std::int32_t ActivateTileRange = 26;
+		/** @brief Maximum number of fixed steps simulated in one frame, the game slows down if the frame rate drops further */
+		static constexpr std::int32_t MaxFixedStepsPerFrame = 4;
+		/** @brief Actions that are handled once per frame outside of the simulation (in fixed-timestep mode) */
+		static constexpr std::uint64_t FrameActions = (1ull << (std::int32_t)PlayerAction::Menu) | (1ull << (std::int32_t)PlayerAction::Console);
+		/** @brief Number of saved frame states a destroyed actor is kept alive for, see @ref SaveFrameState() */
+		static constexpr std::uint32_t FrameStateRetention = 3600;
 
 		/** @} */
 
@@ -143,6 +152,64 @@ namespace Jazz2
 			_levelDisplayName = value;
 		}
 
+		/**
+			@brief Returns `true` if the level is simulated in fixed steps independently of the frame rate
+
+			Every step advances the level by exactly one nominal frame (`timeMult` is always 1.0) and the shared
+			random generator is seeded from the level, so the same input always leads to the same state. Steps are
+			accumulated from the real frame time and actors are rendered interpolated between the last two steps.
+		*/
+		bool IsFixedTimestep() const {
+			return _fixedTimestep;
+		}
+		/** @brief Returns how much of the next fixed step has already elapsed (0.0 to 1.0), see @ref IsFixedTimestep() */
+		float GetInterpolationFactor() const {
+			return _interpolationFactor;
+		}
+		/** @brief Returns index of the next fixed step, see @ref IsFixedTimestep() */
+		std::uint32_t GetStepIndex() const {
+			return _stepIndex;
+		}
+		/** @brief Returns `true` if the last fixed steps can be simulated again, see @ref ApplyLateInput() */
+		bool IsRollbackEnabled() const {
+			return (_rollback != nullptr);
+		}
+
+		/**
+			@brief Applies input of a player that arrived late and simulates all following steps again
+
+			Input of other sources than the local devices is predicted by repeating the last known one. Once the real
+			input of a past step arrives, the level is restored to the snapshot taken before that step, the input replaces
+			the prediction from that step on, and all steps up to the current one are simulated again without sounds.
+			Returns `false` if rollback is not enabled or the step is older than @ref RollbackBuffer::Capacity steps.
+		*/
+		bool ApplyLateInput(std::uint32_t step, std::int32_t playerIndex, std::uint64_t pressedActions, Vector2f requiredMovement);
+
+		/**
+			@brief Plays back the specified recording instead of the input of local devices
+
+			Must be called before @ref Initialize(), the level is always simulated with fixed timestep and one step per frame,
+			so it runs as fast as possible if frames are not limited. Once the recording ends, the results are reported
+			and the application quits.
+		*/
+		void SetReplayPlayer(std::unique_ptr<ReplayPlayer> replayPlayer);
+		/** @brief Returns `true` if a recording is played back, see @ref SetReplayPlayer() */
+		bool IsReplaying() const {
+			return (_replayPlayer != nullptr);
+		}
+
+		/**
+			@brief Saves the whole simulation state between two frames
+
+			Unlike @ref SerializeResumableToStream(), the state is exact and uncompressed and it's restored synchronously,
+			so it's suitable for run-ahead and rewind. Actors are only referenced, not serialized, so the state can be restored
+			only by this instance and only while destroyed actors it refers to are kept alive, see @ref FrameStateRetention.
+			Returns `false` if a level change is in progress.
+		*/
+		bool SaveFrameState(Stream& dest);
+		/** @brief Restores the simulation state saved by @ref SaveFrameState(), returns `false` without any change if it's not possible */
+		bool LoadFrameState(Stream& src);
+
 		float GetDefaultAmbientLight() const override;
 		float GetAmbientLight(Actors::Player* player) const override;
 		void SetAmbientLight(Actors::Player* player, float value) override;
@@ -231,6 +298,26 @@ namespace Jazz2
 			PlayerInput();
 		};
 
+		/** @brief Actor referenced by a frame state, see @ref SaveFrameState() */
+		struct FrameStateActor {
+			/** @brief Actor, kept alive while it can be restored */
+			std::shared_ptr<Actors::ActorBase> Actor;
+			/** @brief Index of the first save that referenced the actor */
+			std::uint32_t FirstSave;
+			/** @brief Index of the last save that referenced the actor */
+			std::uint32_t LastSave;
+		};
+
+		/** @brief Completion callback of a transition referenced by a frame state, see @ref SaveFrameState() */
+		struct FrameStateCallback {
+			/** @brief Callback, kept alive while it can be restored */
+			std::shared_ptr<Function<void()>> Callback;
+			/** @brief Index of the first save that referenced the callback */
+			std::uint32_t FirstSave;
+			/** @brief Index of the last save that referenced the callback */
+			std::uint32_t LastSave;
+		};
+
 #ifndef DOXYGEN_GENERATING_OUTPUT
 		// Hide these members from documentation before refactoring
 		IRootController* _root;
@@ -265,6 +352,7 @@ namespace Jazz2
 		std::unique_ptr<Scripting::LevelScriptLoader> _scripts;
 #endif
 		SmallVector<std::shared_ptr<Actors::ActorBase>, 0> _actors;
+		Actors::ActorCoreTable _actorCore;
 		SmallVector<Actors::Player*, LevelInitialization::MaxPlayerCount> _players;
 
 		String _levelName;
@@ -274,6 +362,8 @@ namespace Jazz2
 		GameDifficulty _difficulty;
 		WeatherType _weatherType;
 		std::uint8_t _weatherIntensity;
+		// Weather particles are spawned only around viewports (none in headless mode), so they can't use the shared generator
+		RandomGenerator _weatherRandom;
 		ExitType _nextLevelType;
 		float _nextLevelTime;
 		String _nextLevelName;
@@ -294,6 +384,24 @@ namespace Jazz2
 		float _elapsedFrames;
 		float _checkpointFrames;
 		float _waterLevel;
+		bool _fixedTimestep;
+		bool _isResimulating;
+		float _stepAccumulator;
+		float _interpolationFactor;
+		std::uint32_t _stepIndex;
+		std::unique_ptr<RollbackBuffer> _rollback;
+		std::unique_ptr<ReplayRecorder> _replayRecorder;
+		std::unique_ptr<ReplayPlayer> _replayPlayer;
+		std::uint64_t _stepChecksum;	// Checksum of the state after the last step, only while recording or playing back
+		bool _parallelActorUpdate;
+		float _parallelPhaseTime;
+		SmallVector<Actors::ActorBase*, 0> _parallelPhysicsActors;
+		std::unique_ptr<RollbackBuffer::Snapshot> _frameState;
+		HashMap<SceneNode*, FrameStateActor> _frameStateActors;
+		HashMap<Function<void()>*, FrameStateCallback> _frameStateCallbacks;
+		std::uint32_t _frameStateSession;
+		std::uint32_t _frameStateSaveCount;
+		std::unique_ptr<std::uint64_t[]> _frameStateJournalPos;	// Journal position of the last FrameStateRetention saves
 		Vector4f _defaultAmbientLight;
 #if defined(WITH_AUDIO)
 		std::unique_ptr<AudioStreamPlayer> _music;
@@ -330,11 +438,17 @@ namespace Jazz2
 		virtual std::shared_ptr<Actors::Player> CreateResumablePlayer(std::int32_t index);
 		/** @brief Returns `true` if cheats are enabled */
 		virtual bool IsCheatingAllowed();
+		/** @brief Returns `true` if the level can be simulated in fixed steps, see @ref IsFixedTimestep() */
+		virtual bool IsFixedTimestepAllowed();
 
 		/** @brief Called after the level is loaded and all players were spawned */
 		virtual void OnInitialized();
 		/** @brief Called before an actor (object) is destroyed */
 		virtual void BeforeActorDestroyed(Actors::ActorBase* actor);
+		/** @brief Called after the simulation state was restored from a rollback snapshot or a frame state */
+		virtual void OnSnapshotRestored();
+		/** @brief Called after all steps were simulated again in @ref ResimulateFrom() */
+		virtual void OnResimulated();
 		/** @brief Processes events */
 		virtual void ProcessEvents(float timeMult);
 		/** @brief Processes transition to the next level if queued */
@@ -348,6 +462,42 @@ namespace Jazz2
 		void ProcessWeather(float timeMult);
 		/** @brief Resolves collisions */
 		void ResolveCollisions(float timeMult);
+		/** @brief Seeds the shared random generator and prepares fixed-step simulation if enabled */
+		void InitializeSimulation();
+		/** @brief Advances the level logic that runs before the scene is updated */
+		void BeginStep(float timeMult);
+		/** @brief Advances the level logic that runs after the scene is updated */
+		void EndStep(float timeMult);
+		/** @brief Updates movement of actors with @ref Actors::ActorState::ParallelPhysics on worker threads */
+		void UpdateActorPhysicsInParallel(float timeMult);
+		/** @brief Simulates all fixed steps accumulated since the last frame */
+		void RunFixedSteps(float timeMult);
+		/** @brief Simulates one fixed step with current input */
+		void SimulateStep();
+		/** @brief Returns seed of the shared random generator in fixed-timestep mode */
+		std::uint64_t GetSimulationSeed() const;
+		/** @brief Returns checksum of the simulation state to verify that a replay is in sync with its recording */
+		std::uint64_t ComputeSimulationChecksum() const;
+		/** @brief Reports results of the recording played back and quits the application */
+		void EndReplay();
+		/** @brief Saves the whole simulation state and current input to a rollback snapshot */
+		void SaveSnapshot(RollbackBuffer::Snapshot& snapshot);
+		/** @brief Restores the whole simulation state from a rollback snapshot */
+		void RestoreSnapshot(RollbackBuffer::Snapshot& snapshot);
+		/** @brief Discards consumed event tiles that neither a rollback snapshot nor a retained frame state can restore */
+		void TrimEventJournal();
+		/** @brief Returns `true` if the level can be restored to the snapshot taken before @p step, see @ref ResimulateFrom() */
+		bool CanResimulateFrom(std::uint32_t step);
+		/**
+			@brief Restores the level to the snapshot taken before @p step and simulates all steps up to the current one again
+
+			Input of local devices is taken from the snapshots. Input of other sources, which is a part of the simulation
+			state (e.g., pressed keys of a remote player), can be replaced in @p applyInput, which is called with the index
+			of each step before it's simulated again. Sounds are not played during the simulation.
+		*/
+		void ResimulateFrom(std::uint32_t step, Function<void(std::uint32_t)>&& applyInput);
+		/** @brief Discards all rollback snapshots, called after a change outside of the simulation that cannot be undone */
+		void DiscardRollbackHistory();
 		/** @brief Assigns viewport */
 		void AssignViewport(Actors::Player* player);
 		/** @brief Unassigns viewport */
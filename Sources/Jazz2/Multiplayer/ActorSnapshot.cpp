@@ -0,0 +1,458 @@
+#include "ActorSnapshot.h"
+
+#if defined(WITH_MULTIPLAYER)
+
+#include <algorithm>
+#include <cmath>
+
+namespace Jazz2::Multiplayer
+{
+	namespace
+	{
+		// Bit widths selected by the 2-bit class prefix of variable-length fields
+		constexpr std::int32_t VariableBitWidths[4] = { 4, 8, 16, 32 };
+
+		enum ChangeMask : std::uint32_t {
+			PositionChanged = 0x01,
+			AnimationChanged = 0x02,
+			TransformChanged = 0x04,
+			FlagsChanged = 0x08,
+
+			ChangeMaskBits = 4
+		};
+
+		std::uint32_t GetChangeMask(const ActorSnapshotEntry& current, const ActorSnapshotEntry& baseline)
+		{
+			std::uint32_t mask = 0;
+			if (current.PosX != baseline.PosX || current.PosY != baseline.PosY) {
+				mask |= PositionChanged;
+			}
+			if (current.Animation != baseline.Animation) {
+				mask |= AnimationChanged;
+			}
+			if (current.Rotation != baseline.Rotation || current.ScaleX != baseline.ScaleX ||
+				current.ScaleY != baseline.ScaleY || current.RendererType != baseline.RendererType) {
+				mask |= TransformChanged;
+			}
+			if (current.Flags != baseline.Flags) {
+				mask |= FlagsChanged;
+			}
+			return mask;
+		}
+
+		void WriteEntryFields(SnapshotBitWriter& writer, const ActorSnapshotEntry& entry, const ActorSnapshotEntry* baseline, std::uint32_t mask)
+		{
+			if (mask & PositionChanged) {
+				if (baseline != nullptr) {
+					writer.WriteSignedVariableBits(entry.PosX - baseline->PosX);
+					writer.WriteSignedVariableBits(entry.PosY - baseline->PosY);
+				} else {
+					writer.WriteSignedVariableBits(entry.PosX);
+					writer.WriteSignedVariableBits(entry.PosY);
+				}
+			}
+			if (mask & AnimationChanged) {
+				writer.WriteVariableBits(entry.Animation);
+			}
+			if (mask & TransformChanged) {
+				writer.WriteBits(entry.Rotation, 16);
+				writer.WriteBits(entry.ScaleX, 16);
+				writer.WriteBits(entry.ScaleY, 16);
+				writer.WriteBits(entry.RendererType, 8);
+			}
+			if (mask & FlagsChanged) {
+				writer.WriteBits(entry.Flags, 8);
+			}
+		}
+
+		void ReadEntryFields(SnapshotBitReader& reader, ActorSnapshotEntry& entry, const ActorSnapshotEntry* baseline, std::uint32_t mask)
+		{
+			if (mask & PositionChanged) {
+				if (baseline != nullptr) {
+					entry.PosX = baseline->PosX + reader.ReadSignedVariableBits();
+					entry.PosY = baseline->PosY + reader.ReadSignedVariableBits();
+				} else {
+					entry.PosX = reader.ReadSignedVariableBits();
+					entry.PosY = reader.ReadSignedVariableBits();
+				}
+			}
+			if (mask & AnimationChanged) {
+				entry.Animation = reader.ReadVariableBits();
+			}
+			if (mask & TransformChanged) {
+				entry.Rotation = (std::uint16_t)reader.ReadBits(16);
+				entry.ScaleX = (std::uint16_t)reader.ReadBits(16);
+				entry.ScaleY = (std::uint16_t)reader.ReadBits(16);
+				entry.RendererType = (std::uint8_t)reader.ReadBits(8);
+			}
+			if (mask & FlagsChanged) {
+				entry.Flags = (std::uint8_t)reader.ReadBits(8);
+			}
+		}
+	}
+
+	const ActorSnapshotEntry* ActorSnapshot::Find(std::uint32_t actorId) const
+	{
+		auto it = std::lower_bound(Entries.begin(), Entries.end(), actorId, [](const ActorSnapshotEntry& entry, std::uint32_t id) {
+			return entry.ActorID < id;
+		});
+		return (it != Entries.end() && it->ActorID == actorId ? &*it : nullptr);
+	}
+
+	void ActorSnapshot::Sort()
+	{
+		std::sort(Entries.begin(), Entries.end(), [](const ActorSnapshotEntry& a, const ActorSnapshotEntry& b) {
+			return a.ActorID < b.ActorID;
+		});
+	}
+
+	ActorSnapshot& ActorSnapshotHistory::Allocate(std::uint32_t sequence)
+	{
+		ActorSnapshot& snapshot = _snapshots[sequence % Capacity];
+		snapshot.Sequence = sequence;
+		snapshot.Entries.clear();
+		return snapshot;
+	}
+
+	const ActorSnapshot* ActorSnapshotHistory::Find(std::uint32_t sequence) const
+	{
+		const ActorSnapshot& snapshot = _snapshots[sequence % Capacity];
+		return (sequence != 0 && snapshot.Sequence == sequence ? &snapshot : nullptr);
+	}
+
+	void ActorSnapshotHistory::Clear()
+	{
+		for (auto& snapshot : _snapshots) {
+			snapshot.Sequence = 0;
+			snapshot.Entries.clear();
+		}
+	}
+
+	ActorInterestGrid::ActorInterestGrid()
+		: _snapshot(nullptr), _originX(0), _originY(0), _width(0), _height(0)
+	{
+	}
+
+	void ActorInterestGrid::Build(const ActorSnapshot& snapshot, std::uint8_t alwaysRelevantFlags)
+	{
+		_snapshot = &snapshot;
+		_alwaysRelevant.clear();
+		_cellStart.clear();
+		_cellEntries.clear();
+
+		std::int32_t minX = INT32_MAX, minY = INT32_MAX, maxX = INT32_MIN, maxY = INT32_MIN;
+		for (std::size_t i = 0; i < snapshot.Entries.size(); i++) {
+			const ActorSnapshotEntry& entry = snapshot.Entries[i];
+			if (entry.Flags & alwaysRelevantFlags) {
+				_alwaysRelevant.push_back((std::uint32_t)i);
+				continue;
+			}
+			std::int32_t x = GetCell(entry.PosX), y = GetCell(entry.PosY);
+			minX = std::min(minX, x); maxX = std::max(maxX, x);
+			minY = std::min(minY, y); maxY = std::max(maxY, y);
+		}
+
+		if (minX > maxX) {
+			_width = 0;
+			_height = 0;
+			return;
+		}
+
+		if ((std::int64_t)(maxX - minX + 1) * (maxY - minY + 1) <= MaxCellCount) {
+			_originX = minX;
+			_originY = minY;
+			_width = maxX - minX + 1;
+			_height = maxY - minY + 1;
+		} else {
+			// Some actors are far outside of the level, queries still test exact positions
+			_originX = 0;
+			_originY = 0;
+			_width = 1;
+			_height = 1;
+		}
+
+		// Counting sort of entry indices by cell, indices within a cell stay sorted by actor ID
+		_cellStart.resize_for_overwrite((std::size_t)(_width * _height) + 1);
+		std::fill(_cellStart.begin(), _cellStart.end(), 0u);
+		auto getCellIndex = [this](const ActorSnapshotEntry& entry) -> std::size_t {
+			if (_width == 1 && _height == 1) {
+				return 0;
+			}
+			return (std::size_t)((GetCell(entry.PosY) - _originY) * _width + (GetCell(entry.PosX) - _originX));
+		};
+
+		for (std::size_t i = 0; i < snapshot.Entries.size(); i++) {
+			const ActorSnapshotEntry& entry = snapshot.Entries[i];
+			if ((entry.Flags & alwaysRelevantFlags) == 0) {
+				_cellStart[getCellIndex(entry) + 1]++;
+			}
+		}
+		for (std::size_t i = 1; i < _cellStart.size(); i++) {
+			_cellStart[i] += _cellStart[i - 1];
+		}
+
+		_cellEntries.resize_for_overwrite(_cellStart.back());
+		SmallVector<std::uint32_t, 0> cellFill;
+		cellFill.append(_cellStart.begin(), _cellStart.end() - 1);
+		for (std::size_t i = 0; i < snapshot.Entries.size(); i++) {
+			const ActorSnapshotEntry& entry = snapshot.Entries[i];
+			if ((entry.Flags & alwaysRelevantFlags) == 0) {
+				_cellEntries[cellFill[getCellIndex(entry)]++] = (std::uint32_t)i;
+			}
+		}
+	}
+
+	void ActorInterestGrid::Query(const Rectf& rect, SmallVectorImpl<std::uint32_t>& indices) const
+	{
+		std::size_t firstIndex = indices.size();
+		indices.append(_alwaysRelevant.begin(), _alwaysRelevant.end());
+
+		if (_width > 0 && _height > 0) {
+			std::int32_t left = (std::int32_t)std::floor(rect.X * ActorSnapshotEntry::PositionScale);
+			std::int32_t top = (std::int32_t)std::floor(rect.Y * ActorSnapshotEntry::PositionScale);
+			std::int32_t right = (std::int32_t)std::ceil((rect.X + rect.W) * ActorSnapshotEntry::PositionScale);
+			std::int32_t bottom = (std::int32_t)std::ceil((rect.Y + rect.H) * ActorSnapshotEntry::PositionScale);
+
+			std::int32_t x1 = 0, y1 = 0, x2 = 0, y2 = 0;
+			if (_width > 1 || _height > 1) {
+				x1 = std::max(GetCell(left) - _originX, 0);
+				y1 = std::max(GetCell(top) - _originY, 0);
+				x2 = std::min(GetCell(right) - _originX, _width - 1);
+				y2 = std::min(GetCell(bottom) - _originY, _height - 1);
+			}
+
+			for (std::int32_t y = y1; y <= y2; y++) {
+				for (std::int32_t x = x1; x <= x2; x++) {
+					std::size_t cellIndex = (std::size_t)(y * _width + x);
+					for (std::uint32_t k = _cellStart[cellIndex]; k < _cellStart[cellIndex + 1]; k++) {
+						const ActorSnapshotEntry& entry = _snapshot->Entries[_cellEntries[k]];
+						if (entry.PosX >= left && entry.PosX < right && entry.PosY >= top && entry.PosY < bottom) {
+							indices.push_back(_cellEntries[k]);
+						}
+					}
+				}
+			}
+		}
+
+		std::sort(indices.begin() + firstIndex, indices.end());
+	}
+
+	std::int32_t ActorInterestGrid::GetCell(std::int32_t quantizedPos)
+	{
+		constexpr std::int32_t CellUnits = CellSize * (std::int32_t)ActorSnapshotEntry::PositionScale;
+		return (quantizedPos >= 0 ? quantizedPos / CellUnits : (quantizedPos - CellUnits + 1) / CellUnits);
+	}
+
+	void SnapshotBitWriter::WriteBits(std::uint32_t value, std::int32_t bitCount)
+	{
+		if (bitCount < 32) {
+			value &= (1u << bitCount) - 1;
+		}
+		_pending |= (std::uint64_t)value << _pendingBits;
+		_pendingBits += bitCount;
+		_bitCount += bitCount;
+
+		while (_pendingBits >= 8) {
+			_buffer.push_back((std::uint8_t)_pending);
+			_pending >>= 8;
+			_pendingBits -= 8;
+		}
+	}
+
+	void SnapshotBitWriter::WriteVariableBits(std::uint32_t value)
+	{
+		std::uint32_t widthClass = 0;
+		while (widthClass < 3 && value >= (1u << VariableBitWidths[widthClass])) {
+			widthClass++;
+		}
+		WriteBits(widthClass, 2);
+		WriteBits(value, VariableBitWidths[widthClass]);
+	}
+
+	void SnapshotBitWriter::WriteSignedVariableBits(std::int32_t value)
+	{
+		WriteVariableBits(((std::uint32_t)value << 1) ^ (std::uint32_t)(value >> 31));
+	}
+
+	void SnapshotBitWriter::FlushTo(Stream& dest)
+	{
+		if (_pendingBits > 0) {
+			_buffer.push_back((std::uint8_t)_pending);
+			_pending = 0;
+			_pendingBits = 0;
+		}
+		dest.Write(_buffer.data(), (std::int64_t)_buffer.size());
+	}
+
+	SnapshotBitReader::SnapshotBitReader(ArrayView<const std::uint8_t> data)
+		: _data(data), _bytePos(0), _pending(0), _pendingBits(0), _failed(false)
+	{
+	}
+
+	std::uint32_t SnapshotBitReader::ReadBits(std::int32_t bitCount)
+	{
+		while (_pendingBits < bitCount) {
+			std::uint64_t nextByte = 0;
+			if DEATH_LIKELY(_bytePos < _data.size()) {
+				nextByte = _data[_bytePos++];
+			} else {
+				_failed = true;
+			}
+			_pending |= nextByte << _pendingBits;
+			_pendingBits += 8;
+		}
+
+		std::uint32_t value = (bitCount < 32 ? (std::uint32_t)(_pending & ((1ull << bitCount) - 1)) : (std::uint32_t)_pending);
+		_pending >>= bitCount;
+		_pendingBits -= bitCount;
+		return value;
+	}
+
+	std::uint32_t SnapshotBitReader::ReadVariableBits()
+	{
+		std::uint32_t widthClass = ReadBits(2);
+		return ReadBits(VariableBitWidths[widthClass]);
+	}
+
+	std::int32_t SnapshotBitReader::ReadSignedVariableBits()
+	{
+		std::uint32_t value = ReadVariableBits();
+		return (std::int32_t)(value >> 1) ^ -(std::int32_t)(value & 1);
+	}
+
+	void EncodeSnapshotDelta(SnapshotBitWriter& writer, const ActorSnapshot& current, const ActorSnapshot* baseline)
+	{
+		// Both lists are sorted by actor ID, so changed and removed entries can be found with a single merge
+		SmallVector<std::uint32_t, 64> changedIndices;
+		SmallVector<std::uint32_t, 16> removedIds;
+		SmallVector<std::uint32_t, 64> changedMasks;
+
+		std::size_t j = 0;
+		std::size_t baselineCount = (baseline != nullptr ? baseline->Entries.size() : 0);
+		for (std::size_t i = 0; i < current.Entries.size(); i++) {
+			const ActorSnapshotEntry& entry = current.Entries[i];
+			while (j < baselineCount && baseline->Entries[j].ActorID < entry.ActorID) {
+				removedIds.push_back(baseline->Entries[j].ActorID);
+				j++;
+			}
+
+			if (j < baselineCount && baseline->Entries[j].ActorID == entry.ActorID) {
+				std::uint32_t mask = GetChangeMask(entry, baseline->Entries[j]);
+				if (mask != 0) {
+					changedIndices.push_back((std::uint32_t)i);
+					changedMasks.push_back(mask);
+				}
+				j++;
+			} else {
+				changedIndices.push_back((std::uint32_t)i);
+				changedMasks.push_back(0);
+			}
+		}
+		for (; j < baselineCount; j++) {
+			removedIds.push_back(baseline->Entries[j].ActorID);
+		}
+
+		writer.WriteVariableBits((std::uint32_t)changedIndices.size());
+		std::uint32_t prevId = 0;
+		for (std::size_t k = 0; k < changedIndices.size(); k++) {
+			const ActorSnapshotEntry& entry = current.Entries[changedIndices[k]];
+			writer.WriteVariableBits(entry.ActorID - prevId);
+			prevId = entry.ActorID;
+
+			std::uint32_t mask = changedMasks[k];
+			if (mask != 0) {
+				// Entry is present in the baseline, the decoder finds it there too, so only the mask is needed
+				writer.WriteBits(mask, ChangeMaskBits);
+				WriteEntryFields(writer, entry, baseline->Find(entry.ActorID), mask);
+			} else {
+				WriteEntryFields(writer, entry, nullptr, PositionChanged | AnimationChanged | TransformChanged | FlagsChanged);
+			}
+		}
+
+		writer.WriteVariableBits((std::uint32_t)removedIds.size());
+		prevId = 0;
+		for (std::uint32_t actorId : removedIds) {
+			writer.WriteVariableBits(actorId - prevId);
+			prevId = actorId;
+		}
+	}
+
+	bool DecodeSnapshotDelta(SnapshotBitReader& reader, const ActorSnapshot* baseline, ActorSnapshot& result)
+	{
+		DEATH_DEBUG_ASSERT(&result != baseline);
+
+		SmallVector<ActorSnapshotEntry, 64> changedEntries;
+		std::uint32_t changedCount = reader.ReadVariableBits();
+		if DEATH_UNLIKELY(changedCount > UINT16_MAX) {
+			return false;
+		}
+
+		std::uint32_t actorId = 0;
+		for (std::uint32_t k = 0; k < changedCount; k++) {
+			std::uint32_t idDelta = reader.ReadVariableBits();
+			if DEATH_UNLIKELY(k > 0 && idDelta == 0) {
+				return false;
+			}
+			actorId += idDelta;
+
+			const ActorSnapshotEntry* prevEntry = (baseline != nullptr ? baseline->Find(actorId) : nullptr);
+			ActorSnapshotEntry& entry = changedEntries.emplace_back();
+			if (prevEntry != nullptr) {
+				entry = *prevEntry;
+				ReadEntryFields(reader, entry, prevEntry, reader.ReadBits(ChangeMaskBits));
+			} else {
+				entry.ActorID = actorId;
+				ReadEntryFields(reader, entry, nullptr, PositionChanged | AnimationChanged | TransformChanged | FlagsChanged);
+			}
+
+			if DEATH_UNLIKELY(reader.HasFailed()) {
+				return false;
+			}
+		}
+
+		SmallVector<std::uint32_t, 16> removedIds;
+		std::uint32_t removedCount = reader.ReadVariableBits();
+		if DEATH_UNLIKELY(removedCount > UINT16_MAX) {
+			return false;
+		}
+		actorId = 0;
+		for (std::uint32_t k = 0; k < removedCount; k++) {
+			actorId += reader.ReadVariableBits();
+			removedIds.push_back(actorId);
+		}
+
+		if DEATH_UNLIKELY(reader.HasFailed()) {
+			return false;
+		}
+
+		// Merge unchanged baseline entries with the changed ones, skipping removed actors
+		result.Entries.clear();
+
+		std::size_t baselineCount = (baseline != nullptr ? baseline->Entries.size() : 0);
+		std::size_t i = 0, r = 0;
+		for (std::size_t j = 0; j < baselineCount; j++) {
+			const ActorSnapshotEntry& prevEntry = baseline->Entries[j];
+			while (i < changedEntries.size() && changedEntries[i].ActorID < prevEntry.ActorID) {
+				result.Entries.push_back(changedEntries[i++]);
+			}
+			while (r < removedIds.size() && removedIds[r] < prevEntry.ActorID) {
+				r++;
+			}
+
+			if (i < changedEntries.size() && changedEntries[i].ActorID == prevEntry.ActorID) {
+				result.Entries.push_back(changedEntries[i++]);
+			} else if (r < removedIds.size() && removedIds[r] == prevEntry.ActorID) {
+				r++;
+			} else {
+				result.Entries.push_back(prevEntry);
+			}
+		}
+		for (; i < changedEntries.size(); i++) {
+			result.Entries.push_back(changedEntries[i]);
+		}
+
+		return true;
+	}
+}
+
+#endif
@@ -0,0 +1,203 @@
+#pragma once
+
+#if defined(WITH_MULTIPLAYER) || defined(DOXYGEN_GENERATING_OUTPUT)
+
+#include "../../Main.h"
+#include "../../nCine/Primitives/Rect.h"
+
+#include <Containers/ArrayView.h>
+#include <Containers/SmallVector.h>
+#include <IO/MemoryStream.h>
+
+using namespace Death::Containers;
+using namespace Death::IO;
+using namespace nCine;
+
+namespace Jazz2::Multiplayer
+{
+	/**
+		@brief Replicated state of a single actor in @ref ActorSnapshot
+
+		Already quantized to its wire representation, so equal entries produce no delta and the server and
+		the client reconstruct bit-identical snapshots from the same packet.
+	*/
+	struct ActorSnapshotEntry
+	{
+		/** @brief Position quantization, positions are stored in 1/512 pixel units like in the other packets */
+		static constexpr float PositionScale = 512.0f;
+
+		/** @brief Remote actor ID (player index for players) */
+		std::uint32_t ActorID;
+		/** @brief Quantized X coordinate */
+		std::int32_t PosX;
+		/** @brief Quantized Y coordinate */
+		std::int32_t PosY;
+		/** @brief Current animation state */
+		std::uint32_t Animation;
+		/** @brief Rotation mapped to full 16-bit range */
+		std::uint16_t Rotation;
+		/** @brief Horizontal scale as half-float */
+		std::uint16_t ScaleX;
+		/** @brief Vertical scale as half-float */
+		std::uint16_t ScaleY;
+		/** @brief Renderer type */
+		std::uint8_t RendererType;
+		/** @brief Miscellaneous flags (visibility, flipping, warping), see @ref RemoteActor::SyncMiscWithServer() */
+		std::uint8_t Flags;
+	};
+
+	/**
+		@brief Snapshot of all replicated actors at a given server update
+
+		Entries are kept sorted by @ref ActorSnapshotEntry::ActorID, so two snapshots can be diffed with a single
+		linear merge and lookups are a binary search.
+	*/
+	struct ActorSnapshot
+	{
+		/** @brief Sequence number of the server update, `0` if the snapshot slot is empty */
+		std::uint32_t Sequence = 0;
+		/** @brief Sorted list of actor states */
+		SmallVector<ActorSnapshotEntry, 0> Entries;
+
+		/** @brief Returns the entry of the specified actor or `nullptr` if the actor is not present */
+		const ActorSnapshotEntry* Find(std::uint32_t actorId) const;
+		/** @brief Sorts entries by actor ID, must be called after entries are added out of order */
+		void Sort();
+	};
+
+	/**
+		@brief Ring of recently sent or received snapshots, indexed by sequence number
+
+		The server keeps one per peer to look up the last acknowledged baseline, the client keeps one to
+		reconstruct the full state from a delta. Slots are reused, so no allocations happen once warmed up.
+	*/
+	class ActorSnapshotHistory
+	{
+	public:
+		/** @brief Number of snapshots retained, about one second of updates */
+		static constexpr std::uint32_t Capacity = 32;
+
+		/** @brief Returns a cleared slot for the specified sequence number, overwriting the oldest one */
+		ActorSnapshot& Allocate(std::uint32_t sequence);
+		/** @brief Returns the snapshot with the specified sequence number if it's still retained */
+		const ActorSnapshot* Find(std::uint32_t sequence) const;
+		/** @brief Drops all retained snapshots */
+		void Clear();
+
+	private:
+		ActorSnapshot _snapshots[Capacity];
+	};
+
+	/**
+		@brief Coarse uniform grid over @ref ActorSnapshot entries used for area-of-interest queries
+
+		Rebuilt once per update from the world snapshot, so filtering it for each peer only visits cells that
+		overlap the peer's area of interest instead of the whole snapshot. Entries with any of the always-relevant
+		flags are not bucketed and are returned by every query.
+	*/
+	class ActorInterestGrid
+	{
+	public:
+		/** @brief Cell size in pixels */
+		static constexpr std::int32_t CellSize = 512;
+		/** @brief Maximum number of cells, the grid degrades to a single cell if the entries span more */
+		static constexpr std::int32_t MaxCellCount = 64 * 1024;
+
+		ActorInterestGrid();
+
+		/** @brief Rebuilds the grid from the specified snapshot, which must outlive all subsequent queries */
+		void Build(const ActorSnapshot& snapshot, std::uint8_t alwaysRelevantFlags);
+		/** @brief Appends indices of always-relevant entries and entries inside @p rect (in pixels) sorted by actor ID */
+		void Query(const Rectf& rect, SmallVectorImpl<std::uint32_t>& indices) const;
+
+	private:
+		const ActorSnapshot* _snapshot;
+		std::int32_t _originX, _originY;
+		std::int32_t _width, _height;
+		SmallVector<std::uint32_t, 0> _cellStart;
+		SmallVector<std::uint32_t, 0> _cellEntries;
+		SmallVector<std::uint32_t, 0> _alwaysRelevant;
+
+		static std::int32_t GetCell(std::int32_t quantizedPos);
+	};
+
+	/**
+		@brief Bit-packed writer used by @ref ActorSnapshot delta encoding
+
+		Values are appended LSB-first into a growable buffer. Variable-length fields use a 2-bit width class,
+		so small deltas (the common case for moving actors) take only a few bits.
+	*/
+	class SnapshotBitWriter
+	{
+	public:
+		/** @brief Appends the lowest @p bitCount bits of @p value */
+		void WriteBits(std::uint32_t value, std::int32_t bitCount);
+		/** @brief Appends an unsigned value using the variable-length encoding */
+		void WriteVariableBits(std::uint32_t value);
+		/** @brief Appends a signed value using zig-zag and the variable-length encoding */
+		void WriteSignedVariableBits(std::int32_t value);
+		/** @brief Flushes remaining bits to the target stream, padding to whole bytes */
+		void FlushTo(Stream& dest);
+		/** @brief Returns number of bits written so far */
+		std::int64_t GetBitCount() const {
+			return _bitCount;
+		}
+
+	private:
+		SmallVector<std::uint8_t, 0> _buffer;
+		std::uint64_t _pending = 0;
+		std::int32_t _pendingBits = 0;
+		std::int64_t _bitCount = 0;
+	};
+
+	/**
+		@brief Bit-packed reader counterpart of @ref SnapshotBitWriter
+
+		Reading past the end of the buffer yields zeros and marks the reader as failed, so malformed packets
+		can be rejected after decoding without per-field checks.
+	*/
+	class SnapshotBitReader
+	{
+	public:
+		explicit SnapshotBitReader(ArrayView<const std::uint8_t> data);
+
+		/** @brief Reads @p bitCount bits */
+		std::uint32_t ReadBits(std::int32_t bitCount);
+		/** @brief Reads an unsigned value using the variable-length encoding */
+		std::uint32_t ReadVariableBits();
+		/** @brief Reads a signed value using zig-zag and the variable-length encoding */
+		std::int32_t ReadSignedVariableBits();
+		/** @brief Returns `true` if the reader ran past the end of the buffer */
+		bool HasFailed() const {
+			return _failed;
+		}
+
+	private:
+		ArrayView<const std::uint8_t> _data;
+		std::size_t _bytePos;
+		std::uint64_t _pending;
+		std::int32_t _pendingBits;
+		bool _failed;
+	};
+
+	/**
+	 * @brief Encodes @p current as a delta against @p baseline
+	 *
+	 * Only entries that are new or differ from the baseline are written, each with a mask of changed field
+	 * groups, followed by the list of actors that disappeared since the baseline. If @p baseline is `nullptr`,
+	 * the whole snapshot is written.
+	 */
+	void EncodeSnapshotDelta(SnapshotBitWriter& writer, const ActorSnapshot& current, const ActorSnapshot* baseline);
+
+	/**
+	 * @brief Reconstructs a full snapshot from a delta written by @ref EncodeSnapshotDelta()
+	 *
+	 * @param reader     Source of the bit-packed delta
+	 * @param baseline   The same baseline the server encoded against, or `nullptr` for a full snapshot
+	 * @param result     Reconstructed snapshot (must not be @p baseline), its sequence number is left untouched
+	 * @return `false` if the packet is malformed
+	 */
+	bool DecodeSnapshotDelta(SnapshotBitReader& reader, const ActorSnapshot* baseline, ActorSnapshot& result);
+}
+
+#endif
@@ -0,0 +1,35 @@
+﻿#pragma once
+
+#if defined(WITH_MULTIPLAYER) || defined(DOXYGEN_GENERATING_OUTPUT)
+
+#include "Peer.h"
+#include "Reason.h"
+
+#include <Containers/ArrayView.h>
+
+using namespace Death::Containers;
+
+namespace Jazz2::Multiplayer
+{
+	enum class NetworkChannel : std::uint8_t;
+
+	/**
+		@brief Interface to handle packets sent to in-process loopback peers
+		
+		Callback interface that a @ref NetworkManagerBase in a loopback session invokes instead of sending packets
+		over a socket. Packets can be delivered from any thread that sends them, so implementations should only
+		queue them and process them later.
+
+		@experimental
+	*/
+	class ILoopbackHandler
+	{
+	public:
+		/** @brief Called when a packet is sent to a loopback peer, @p data is valid only during the call */
+		virtual void OnLoopbackPacket(const Peer& peer, NetworkChannel channel, std::uint8_t packetType, ArrayView<const std::uint8_t> data) = 0;
+		/** @brief Called when a loopback peer is disconnected by the server */
+		virtual void OnLoopbackDisconnected(const Peer& peer, Reason reason) = 0;
+	};
+}
+
+#endif
\ No newline at end of file
@@ -19,6 +19,7 @@
 #include "../../nCine/I18n.h"
 #include "../../nCine/Base/Random.h"
 #include "../../nCine/Primitives/Half.h"
+#include "../../nCine/Threading/ParallelFor.h"
 
 #include "../Actors/Player.h"
 #include "../Actors/Multiplayer/LocalPlayerOnServer.h"
@@ -50,10 +51,8 @@
 #include <Containers/StringConcatenable.h>
 #include <Containers/StringUtils.h>
 #include <IO/MemoryStream.h>
-#include <IO/Compression/DeflateStream.h>
 #include <Utf8.h>
 
-using namespace Death::IO::Compression;
 using namespace nCine;
 using namespace Jazz2::Actors::Multiplayer;
 using namespace Jazz2::Multiplayer::GameModes;
@@ -118,8 +117,8 @@ namespace Jazz2::Multiplayer
 	// TODO: levelState is unused, it needs to be set after LevelState::InitialUpdatePending is processed
 	MpLevelHandler::MpLevelHandler(IRootController* root, NetworkManager* networkManager, MpLevelHandler::LevelState levelState, bool enableLedgeClimb)
 		: LevelHandler(root), _networkManager(networkManager), _updateTimeLeft(1.0f), _gameTimeLeft(0.0f),
-			_levelState(LevelState::InitialUpdatePending), _forceResyncPending(true), _enableSpawning(true), _enqueuedPlaylistChange(false), _lastSpawnedActorId(-1), _waitingForPlayerCount(0),
-			_lastUpdated(0), _seqNumWarped(0), _suppressRemoting(false), _ignorePackets(false), _changingCharacterInLobby(false), _enableLedgeClimb(enableLedgeClimb),
+			_levelState(LevelState::InitialUpdatePending), _enableSpawning(true), _enqueuedPlaylistChange(false), _lastSpawnedActorId(-1), _waitingForPlayerCount(0),
+			_lastUpdated(0), _lastUpdatedTime(0), _updatedStepsCount(0), _lastSnapshotTimeUs(0.0f), _serverRenderTime(0), _seqNumWarped(0), _suppressRemoting(false), _ignorePackets(false), _changingCharacterInLobby(false), _enableLedgeClimb(enableLedgeClimb),
 			_controllableExternal(true), _autoWeightTreasure(false), _activePoll(VoteType::None), _activePollTimeLeft(0.0f), _recalcPositionInRoundTime(0.0f),
 			_overtimeTimeLeft(0.0f), _overtimeStarted(false), _overtimeFinishers(0),
 			_limitCameraLeft(0), _limitCameraWidth(0), _totalTreasureCount(0), _raceCheckpointsOrdered(false), _ctfCaptures{}, _teamKills{}, _scoreboardSyncTime(0.0f),
@@ -129,7 +128,7 @@ namespace Jazz2::Multiplayer
 #endif
 #if defined(DEATH_DEBUG) && defined(WITH_IMGUI)
 			, _plotIndex(0), _actorsMaxCount(0.0f), _actorsCount{}, _remoteActorsCount{}, _remotingActorsCount{},
-			_mirroredActorsCount{}, _updatePacketMaxSize(0.0f), _updatePacketSize{}, _compressedUpdatePacketSize{}
+			_mirroredActorsCount{}, _updatePacketMaxSize(0.0f), _updatePacketSize{}, _averageUpdatePacketSize{}
 #endif
 	{
 		NetworkState state = networkManager->GetState();
@@ -359,11 +358,19 @@ namespace Jazz2::Multiplayer
 			}
 			_pendingSfx.clear();
 		} else {
+			{
+				// All remote actors are sampled at the same server time, so they stay in sync with each other
+				std::unique_lock lock(_lock);
+				_serverRenderTime = _serverPlayoutDelay.GetRenderTime(StateInterpolationBuffer::Now());
+			}
+
 			auto& input = _playerInputs[0];
 			if (input.PressedActions != input.PressedActionsLast) {
-				MemoryStream packet(12);
+				MemoryStream packet(21);
 				packet.WriteVariableUint32(_lastSpawnedActorId);
 				packet.WriteVariableUint64(_console->IsVisible() ? 0 : input.PressedActions);
+				// The player reacted to the state displayed now, so the server can apply the input to the same step
+				packet.WriteVariableInt64(_serverRenderTime);
 				_networkManager->SendTo(AllPeers, NetworkChannel::UnreliableUpdates, (std::uint8_t)ClientPacketType::PlayerKeyPress, packet);
 			}
 		}
@@ -683,175 +690,28 @@ namespace Jazz2::Multiplayer
 
 			if (_isServer) {
 				if (_networkManager->HasInboundConnections()) {
-					std::uint32_t playerCount = GetNonSpectatePlayerCount();
-					std::uint32_t actorCount = playerCount + (std::uint32_t)_remotingActors.size();
-
-					MemoryStream packet(8 + actorCount * 24);
-					packet.WriteVariableUint32(_lastUpdated);
-					packet.WriteVariableUint64((std::uint64_t)_elapsedFrames);
-					packet.WriteVariableUint32((actorCount << 1) | (_forceResyncPending ? 1 : 0));
-
-					for (Actors::Player* player : _players) {
-						auto* mpPlayer = static_cast<PlayerOnServer*>(player);
+					TimeStamp snapshotStart = TimeStamp::now();
 
-						// Skip spectate players - don't send their position to other clients
-						if (mpPlayer->_playerType == PlayerType::Spectate) {
-							continue;
-						}
-
-						/*Vector2f pos;
-						auto it = _playerStates.find(player->_playerIndex);
-						if (it != _playerStates.end()) {
-							// Remote players
-							pos = player->_pos;
-
-							// TODO: This should be WarpUpdatesLeft
-							if (it->second.WarpTimeLeft > 0.0f) {
-								it->second.WarpTimeLeft -= timeMult;
-								if (it->second.WarpTimeLeft <= 0.0f) {
-									it->second.WarpTimeLeft = 0.0f;
-									LOGW("Player warped without permission (possible cheating attempt)");
-								}
-							} else if (it->second.WarpTimeLeft < 0.0f) {
-								it->second.WarpTimeLeft += timeMult;
-								if (it->second.WarpTimeLeft >= 0.0f) {
-									it->second.WarpTimeLeft = 0.0f;
-									LOGW("Player failed to warp in time (possible cheating attempt)");
-								}
-							}
-						} else {
-							// Local players
-							pos = player->_pos;
-						}*/
-						Vector2f pos = player->_pos;
-
-						packet.WriteVariableUint32(player->_playerIndex);
-
-						std::uint8_t flags = 0x01 | 0x02; // PositionChanged | AnimationChanged
-						if (player->_renderer.isDrawEnabled()) {
-							flags |= 0x04;
-						}
-						if (player->_renderer.AnimPaused) {
-							flags |= 0x08;
-						}
-						if (player->_renderer.isFlippedX()) {
-							flags |= 0x10;
-						}
-						if (player->_renderer.isFlippedY()) {
-							flags |= 0x20;
-						}
-						if (mpPlayer->_justWarped) {
-							mpPlayer->_justWarped = false;
-							flags |= 0x40;
-						}
-						packet.WriteValue<std::uint8_t>(flags);
-
-						packet.WriteValue<std::int32_t>((std::int32_t)(pos.X * 512.0f));
-						packet.WriteValue<std::int32_t>((std::int32_t)(pos.Y * 512.0f));
-						packet.WriteVariableUint32((std::uint32_t)(player->_currentTransition != nullptr ? player->_currentTransition->State : player->_currentAnimation->State));
-
-						float rotation = player->_renderer.rotation();
-						if (rotation < 0.0f) rotation += fRadAngle360;
-						packet.WriteValue<std::uint16_t>((std::uint16_t)(rotation * UINT16_MAX / fRadAngle360));
-						Vector2f scale = player->_renderer.scale();
-						packet.WriteValue<std::uint16_t>((std::uint16_t)Half{scale.X});
-						packet.WriteValue<std::uint16_t>((std::uint16_t)Half{scale.Y});
-						Actors::ActorRendererType rendererType = player->_renderer.GetRendererType();
-						if (rendererType == Actors::ActorRendererType::Outline) {
-							// Outline renderer type is local-only
-							rendererType = Actors::ActorRendererType::Default;
-						}
-						packet.WriteValue<std::uint8_t>((std::uint8_t)rendererType);
-					}
-
-					// TODO: Does this need to be locked?
+					// Sequence number 0 is reserved for "no baseline", so the first update is 1. Acknowledgements are
+					// validated against it on the network thread, see HandleClientPacketAckUpdateAllActors()
 					{
 						std::unique_lock lock(_lock);
-						for (auto& [remotingActor, remotingActorInfo] : _remotingActors) {
-							packet.WriteVariableUint32(remotingActorInfo.ActorID);
-
-							std::int32_t newPosX = (std::int32_t)(remotingActor->_pos.X * 512.0f);
-							std::int32_t newPosY = (std::int32_t)(remotingActor->_pos.Y * 512.0f);
-							bool positionChanged = (_forceResyncPending || newPosX != remotingActorInfo.LastPosX || newPosY != remotingActorInfo.LastPosY);
-
-							std::uint32_t newAnimation = (std::uint32_t)(remotingActor->_currentTransition != nullptr ? remotingActor->_currentTransition->State : (remotingActor->_currentAnimation != nullptr ? remotingActor->_currentAnimation->State : AnimState::Idle));
-							float rotation = remotingActor->_renderer.rotation();
-							if (rotation < 0.0f) rotation += fRadAngle360;
-							std::uint16_t newRotation = (std::uint16_t)(rotation * UINT16_MAX / fRadAngle360);
-							Vector2f newScale = remotingActor->_renderer.scale();
-							std::uint16_t newScaleX = (std::uint16_t)Half{newScale.X};
-							std::uint16_t newScaleY = (std::uint16_t)Half{newScale.Y};
-							std::uint8_t newRendererType = (std::uint8_t)remotingActor->_renderer.GetRendererType();
-							bool animationChanged = (_forceResyncPending || newAnimation != remotingActorInfo.LastAnimation || newRotation != remotingActorInfo.LastRotation ||
-								newScaleX != remotingActorInfo.LastScaleX || newScaleY != remotingActorInfo.LastScaleY || newRendererType != remotingActorInfo.LastRendererType);
-
-							std::uint8_t flags = 0;
-							if (positionChanged) {
-								flags |= 0x01;
-							}
-							if (animationChanged) {
-								flags |= 0x02;
-							}
-							if (remotingActor->_renderer.isDrawEnabled()) {
-								flags |= 0x04;
-							}
-							if (remotingActor->_renderer.AnimPaused) {
-								flags |= 0x08;
-							}
-							if (remotingActor->_renderer.isFlippedX()) {
-								flags |= 0x10;
-							}
-							if (remotingActor->_renderer.isFlippedY()) {
-								flags |= 0x20;
-							}
-							packet.WriteValue<std::uint8_t>(flags);
-
-							if (positionChanged) {
-								packet.WriteValue<std::int32_t>(newPosX);
-								packet.WriteValue<std::int32_t>(newPosY);
-
-								remotingActorInfo.LastPosX = newPosX;
-								remotingActorInfo.LastPosY = newPosY;
-							}
-							if (animationChanged) {
-								packet.WriteVariableUint32(newAnimation);
-								packet.WriteValue<std::uint16_t>(newRotation);
-								packet.WriteValue<std::uint16_t>(newScaleX);
-								packet.WriteValue<std::uint16_t>(newScaleY);
-								packet.WriteValue<std::uint8_t>(newRendererType);
-
-								remotingActorInfo.LastAnimation = newAnimation;
-								remotingActorInfo.LastRotation = newRotation;
-								remotingActorInfo.LastScaleX = newScaleX;
-								remotingActorInfo.LastScaleY = newScaleY;
-								remotingActorInfo.LastRendererType = newRendererType;
-							}
-						}
+						_lastUpdated++;
 					}
-
-					MemoryStream packetCompressed(1024);
-					{
-						DeflateWriter dw(packetCompressed);
-						dw.Write(packet.GetBuffer(), packet.GetSize());
+					_lastUpdatedTime = StateInterpolationBuffer::Now();
+					if (IsRollbackEnabled()) {
+						// Clients stamp their input with the time of the displayed update, see HandleClientPacketPlayerKeyPress()
+						_updatedSteps[_updatedStepsCount % std::uint32_t(arraySize(_updatedSteps))] = { _lastUpdatedTime, GetStepIndex() };
+						_updatedStepsCount++;
 					}
+					BuildWorldSnapshot();
+					DEATH_UNUSED std::uint32_t averagePacketSize = SendSnapshotsToPeers();
+					_lastSnapshotTimeUs = snapshotStart.microsecondsSince();
 
 #if defined(DEATH_DEBUG)
-					_debugAverageUpdatePacketSize = lerp(_debugAverageUpdatePacketSize, (std::int32_t)(packet.GetSize() * UpdatesPerSecond), 0.04f * timeMult);
-#endif
-#if defined(DEATH_DEBUG) && defined(WITH_IMGUI)
-					_updatePacketSize[_plotIndex] = packet.GetSize();
-					_updatePacketMaxSize = std::max(_updatePacketMaxSize, _updatePacketSize[_plotIndex]);
-					_compressedUpdatePacketSize[_plotIndex] = packetCompressed.GetSize();
+					_debugAverageUpdatePacketSize = lerp(_debugAverageUpdatePacketSize, (std::int32_t)(averagePacketSize * UpdatesPerSecond), 0.04f * timeMult);
 #endif
 
-					_networkManager->SendTo([this](const Peer& peer) {
-						auto peerDesc = _networkManager->GetPeerDescriptor(peer);
-						return (peerDesc && peerDesc->LevelState >= PeerLevelState::LevelSynchronized);
-					}, _forceResyncPending ? NetworkChannel::Main : NetworkChannel::UnreliableUpdates, (std::uint8_t)ServerPacketType::UpdateAllActors, packetCompressed);
-
-					_lastUpdated++;
-					_forceResyncPending = false;
-
 					SynchronizePeers(timeMult);
 				} else {
 #if defined(DEATH_DEBUG)
@@ -888,7 +748,7 @@ namespace Jazz2::Multiplayer
 						flags |= RemotePlayerOnServer::PlayerFlags::InConsole;
 					}
 
-					MemoryStream packet(20);
+					OutgoingPacket packet((std::uint8_t)ClientPacketType::PlayerUpdate, 32);
 					packet.WriteVariableUint32(_lastSpawnedActorId);
 					packet.WriteVariableUint64(now);
 					packet.WriteValue<std::int32_t>((std::int32_t)(player->_pos.X * 512.0f));
@@ -903,11 +763,11 @@ namespace Jazz2::Multiplayer
 
 #if defined(DEATH_DEBUG) && defined(WITH_IMGUI)
 					_updatePacketSize[_plotIndex] = packet.GetSize();
-					_compressedUpdatePacketSize[_plotIndex] = _updatePacketSize[_plotIndex];
+					_averageUpdatePacketSize[_plotIndex] = _updatePacketSize[_plotIndex];
 					_updatePacketMaxSize = std::max(_updatePacketMaxSize, _updatePacketSize[_plotIndex]);
 #endif
 
-					_networkManager->SendTo(AllPeers, NetworkChannel::UnreliableUpdates, (std::uint8_t)ClientPacketType::PlayerUpdate, packet);
+					_networkManager->SendTo(AllPeers, NetworkChannel::UnreliableUpdates, std::move(packet));
 				}
 			}
 		}
@@ -1068,35 +928,15 @@ namespace Jazz2::Multiplayer
 
 				// Store only used IDs on server-side
 				_remoteActors[actorId] = nullptr;
-			}
-
-			if (ActorShouldBeMirrored(actorPtr)) {
-				Vector2i originTile = actorPtr->_originTile;
-				const auto& eventTile = _eventMap->GetEventTile(originTile.X, originTile.Y);
-				if (eventTile.Event != EventType::Empty) {
-					MemoryStream packet(24 + Events::EventSpawner::SpawnParamsSize);
-					packet.WriteVariableUint32(actorId);
-					packet.WriteVariableUint32((std::uint32_t)eventTile.Event);
-					packet.Write(eventTile.EventParams, Events::EventSpawner::SpawnParamsSize);
-					packet.WriteVariableUint32((std::uint32_t)eventTile.EventFlags);
-					packet.WriteVariableInt32((std::int32_t)originTile.X);
-					packet.WriteVariableInt32((std::int32_t)originTile.Y);
-					packet.WriteVariableInt32((std::int32_t)actorPtr->_renderer.layer());
 
-					_networkManager->SendTo([this](const Peer& peer) {
-						auto peerDesc = _networkManager->GetPeerDescriptor(peer);
-						return (peerDesc && peerDesc->LevelState >= PeerLevelState::LevelSynchronized);
-					}, NetworkChannel::Main, (std::uint8_t)ServerPacketType::CreateMirroredActor, packet);
+				if (_isResimulating) {
+					// The actor may not survive the resimulation, so it's announced only after it ends, see OnResimulated()
+					_pendingRemotingActors.push_back(actorPtr);
+					return;
 				}
-			} else {
-				MemoryStream packet;
-				InitializeCreateRemoteActorPacket(packet, actorId, actorPtr);
-
-				_networkManager->SendTo([this](const Peer& peer) {
-					auto peerDesc = _networkManager->GetPeerDescriptor(peer);
-					return (peerDesc && peerDesc->LevelState >= PeerLevelState::LevelSynchronized);
-				}, NetworkChannel::Main, (std::uint8_t)ServerPacketType::CreateRemoteActor, packet);
 			}
+
+			AnnounceRemotingActor(actorPtr, actorId);
 		}
 	}
 
@@ -1104,8 +944,9 @@ namespace Jazz2::Multiplayer
 	{
 		Vector3f adjustedPos = pos;
 
-		// Nothing to broadcast in a local session (and no RemotePlayerOnServer can exist there either)
-		if (_isServer && !_isLocalSession) {
+		// Nothing to broadcast in a local session (and no RemotePlayerOnServer can exist there either),
+		// sounds of resimulated steps were already broadcasted
+		if (_isServer && !_isLocalSession && !_isResimulating) {
 			std::uint32_t actorId; bool excludeSelf;
 			if (auto* player = runtime_cast<Actors::Player>(self)) {
 				actorId = player->_playerIndex;
@@ -1153,7 +994,8 @@ namespace Jazz2::Multiplayer
 
 	std::shared_ptr<AudioBufferPlayer> MpLevelHandler::PlayCommonSfx(StringView identifier, const Vector3f& pos, float gain, float pitch)
 	{
-		if (_isServer && !_isLocalSession) {
+		// Sounds of resimulated steps were already broadcasted
+		if (_isServer && !_isLocalSession && !_isResimulating) {
 			MemoryStream packet(16 + identifier.size());
 			packet.WriteVariableInt32((std::int32_t)pos.X);
 			packet.WriteVariableInt32((std::int32_t)pos.Y);
@@ -1729,7 +1571,8 @@ namespace Jazz2::Multiplayer
 	{
 		LevelHandler::HandleCreateParticleDebrisOnPerish(self, effect, speed);
 
-		if (_isServer && !_isLocalSession) {
+		// Debris of resimulated steps were already broadcasted
+		if (_isServer && !_isLocalSession && !_isResimulating) {
 			std::uint32_t targetActorId = 0;
 			{
 				std::unique_lock lock(_lock);
@@ -1759,7 +1602,8 @@ namespace Jazz2::Multiplayer
 	{
 		LevelHandler::HandleCreateSpriteDebris(self, state, count);
 
-		if (_isServer && !_isLocalSession) {
+		// Debris of resimulated steps were already broadcasted
+		if (_isServer && !_isLocalSession && !_isResimulating) {
 			std::uint32_t targetActorId = 0;
 			{
 				std::unique_lock lock(_lock);
@@ -1866,7 +1710,7 @@ namespace Jazz2::Multiplayer
 	{
 		LevelHandler::ShakeCameraView(player, duration);
 
-		if (_isServer) {
+		if (_isServer && !_isResimulating) {
 			if (auto* mpPlayer = runtime_cast<RemotePlayerOnServer>(player)) {
 				MemoryStream packet(9);
 				packet.WriteValue<std::uint8_t>((std::uint8_t)PlayerPropertyType::ShakeCameraView);
@@ -1884,7 +1728,7 @@ namespace Jazz2::Multiplayer
 
 		constexpr float MaxDistance = 800.0f;
 
-		if (_isServer) {
+		if (_isServer && !_isResimulating) {
 			for (auto& [peer, peerDesc] : *_networkManager->GetPeers()) {
 				if (peerDesc->RemotePeer && peerDesc->Player && (peerDesc->Player->_pos - pos).Length() <= MaxDistance) {
 					MemoryStream packet(9);
@@ -2361,6 +2205,34 @@ namespace Jazz2::Multiplayer
 				}
 				return true;
 			}
+		} else if (line == "/netstats"_s) {
+			if (isAdmin) {
+				// Peers are collected first, so the peer list and _lock are never held at the same time
+				SmallVector<std::pair<Peer, String>, 32> remotePeers;
+				for (auto& [playerPeer, peerDesc] : *_networkManager->GetPeers()) {
+					if (peerDesc->RemotePeer) {
+						remotePeers.emplace_back(playerPeer, peerDesc->PlayerName);
+					}
+				}
+
+				SendMessage(peer, UI::MessageLevel::Confirm, "Actor update statistics:"_s);
+				for (const auto& [playerPeer, playerName] : remotePeers) {
+					PeerSnapshotStats stats;
+					if (!GetPeerSnapshotStats(playerPeer, stats)) {
+						continue;
+					}
+					std::size_t length = formatInto(infoBuffer, "{}\t │ {} B (avg. {:.0f} B)\t │ {:.0f} µs (avg. {:.0f} µs)\t │ F: {}\t │ D: {}\t │ Ack: {}",
+						playerName, stats.LastPacketSize, stats.AveragePacketSize, stats.LastEncodeTimeUs, stats.AverageEncodeTimeUs,
+						stats.FullUpdatesSent, stats.DeltaUpdatesSent, stats.LastAckedSequence);
+					SendMessage(peer, UI::MessageLevel::Confirm, { infoBuffer, length });
+				}
+
+				NetworkQueueStats queueStats = _networkManager->GetQueueStats();
+				std::size_t length = formatInto(infoBuffer, "Network queue: {} sent\t │ {} dropped\t │ {} stalled\t │ {} inbound stalled\t │ Peak: {}",
+					queueStats.OutgoingQueued, queueStats.OutgoingDropped, queueStats.OutgoingStalls, queueStats.InboundStalls, queueStats.OutgoingPeakDepth);
+				SendMessage(peer, UI::MessageLevel::Confirm, { infoBuffer, length });
+				return true;
+			}
 		} else if (line == "/info"_s) {
 			auto& serverConfig = _networkManager->GetServerConfiguration();
 
@@ -3014,6 +2886,8 @@ namespace Jazz2::Multiplayer
 				break;
 			}
 		}
+		// Players are not a part of rollback snapshots
+		DiscardRollbackHistory();
 
 		// Destroy the previous player actor
 		Vector2f playerPos = player->_pos;
@@ -3082,6 +2956,8 @@ namespace Jazz2::Multiplayer
 
 		peerDesc->Player = ptr;
 		_players.push_back(ptr);
+		// Players are not a part of rollback snapshots
+		DiscardRollbackHistory();
 
 		_suppressRemoting = true;
 		AddActor(newPlayer);
@@ -3232,6 +3108,11 @@ namespace Jazz2::Multiplayer
 		constexpr Vector2f OutOfBounds = Vector2f(-1000000.0f, -1000000.0f);
 
 		if (_isServer) {
+			{
+				std::unique_lock lock(_lock);
+				_peerSnapshots.erase(peer);
+			}
+
 			if (auto peerDesc = _networkManager->GetPeerDescriptor(peer)) {
 				peerDesc->IsAuthenticated = false;
 				peerDesc->LevelState = PeerLevelState::Unknown;
@@ -3268,6 +3149,8 @@ namespace Jazz2::Multiplayer
 							break;
 						}
 					}
+					// Players are not a part of rollback snapshots
+					DiscardRollbackHistory();
 
 					// Move the player out of the bounds to avoid triggering events
 					player->_pos = OutOfBounds;
@@ -3419,6 +3302,7 @@ namespace Jazz2::Multiplayer
 				case ClientPacketType::ValidateAssetsResponse: return HandleClientPacketValidateAssetsResponse(peer, data);
 				case ClientPacketType::PlayerReady: return HandleClientPacketPlayerReady(peer, data);
 				case ClientPacketType::ForceResyncActors: return HandleClientPacketForceResyncActors(peer, data);
+				case ClientPacketType::AckUpdateAllActors: return HandleClientPacketAckUpdateAllActors(peer, data);
 				case ClientPacketType::PlayerUpdate: return HandleClientPacketPlayerUpdate(peer, data);
 				case ClientPacketType::PlayerKeyPress: return HandleClientPacketPlayerKeyPress(peer, data);
 				case ClientPacketType::PlayerChangeWeaponRequest: return HandleClientPacketPlayerChangeWeaponRequest(peer, data);
@@ -3814,7 +3698,30 @@ namespace Jazz2::Multiplayer
 	bool MpLevelHandler::HandleClientPacketForceResyncActors(const Peer& peer, ArrayView<const std::uint8_t> data)
 	{
 		LOGD("[MP] ClientPacketType::ForceResyncActors [{}] - update: {}", peer, _lastUpdated);
-		_forceResyncPending = true;
+
+		std::unique_lock lock(_lock);
+		auto it = _peerSnapshots.find(peer);
+		if (it != _peerSnapshots.end()) {
+			it->second->ForceFullUpdate = true;
+		}
+		return true;
+	}
+
+	bool MpLevelHandler::HandleClientPacketAckUpdateAllActors(const Peer& peer, ArrayView<const std::uint8_t> data)
+	{
+		MemoryStream packet(data);
+		std::uint32_t sequence = packet.ReadVariableUint32();
+
+		std::unique_lock lock(_lock);
+		auto it = _peerSnapshots.find(peer);
+		if (it != _peerSnapshots.end()) {
+			// Acknowledgements are unsequenced, so an older one can arrive after a newer one. The history is owned
+			// by the encoding job, so the sequence number is validated there before it's used as a baseline.
+			auto& state = *it->second;
+			if (sequence > state.LastAckedSequence && sequence <= _lastUpdated) {
+				state.LastAckedSequence = sequence;
+			}
+		}
 		return true;
 	}
 
@@ -3831,9 +3738,12 @@ namespace Jazz2::Multiplayer
 
 		// TODO: Special move
 
+		// Taken before the update waits for the main thread, so the queuing there doesn't count as network jitter
+		std::int64_t receivedTime = StateInterpolationBuffer::Now();
+
 		// The packet is parsed here (its backing buffer is freed as soon as this returns), but the state
 		// is applied on the main thread so it doesn't race the simulation - only plain values are captured.
-		InvokeAsync([this, peer, playerIndex, now, posX, posY, speedX, speedY, flags]() mutable {
+		InvokeAsync([this, peer, playerIndex, now, receivedTime, posX, posY, speedX, speedY, flags]() mutable {
 			auto peerDesc = _networkManager->GetPeerDescriptor(peer);
 			if DEATH_UNLIKELY(peerDesc == nullptr || peerDesc->Player == nullptr || peerDesc->Player->_playerIndex != playerIndex) {
 				return;
@@ -3908,7 +3818,7 @@ namespace Jazz2::Multiplayer
 			bool wasIdle = (remotePlayerOnServer->Flags & IdleFlags) != RemotePlayerOnServer::PlayerFlags::None;
 			bool isIdle = (flags & IdleFlags) != RemotePlayerOnServer::PlayerFlags::None;
 
-			remotePlayerOnServer->SyncWithServer(Vector2f(acceptedX, acceptedY), Vector2f(acceptedSpeedX, acceptedSpeedY), flags);
+			remotePlayerOnServer->SyncWithServer(Vector2f(acceptedX, acceptedY), Vector2f(acceptedSpeedX, acceptedSpeedY), flags, (std::int64_t)now, receivedTime);
 
 			if (wasIdle != isIdle) {
 				// Broadcast idle state to all other players
@@ -3934,9 +3844,11 @@ namespace Jazz2::Multiplayer
 		MemoryStream packet(data);
 		std::uint32_t playerIndex = packet.ReadVariableUint32();
 		std::uint64_t pressedKeys = packet.ReadVariableUint64();
+		// Server time of the update displayed by the client when the keys were pressed, older clients don't send it
+		std::int64_t renderTime = (packet.GetPosition() < packet.GetSize() ? packet.ReadVariableInt64() : INT64_MIN);
 
 		// Applied on the main thread; the remote player's input is read by the simulation there
-		InvokeAsync([this, peer, playerIndex, pressedKeys]() mutable {
+		InvokeAsync([this, peer, playerIndex, pressedKeys, renderTime]() mutable {
 			auto peerDesc = _networkManager->GetPeerDescriptor(peer);
 			if DEATH_UNLIKELY(peerDesc == nullptr || peerDesc->Player == nullptr || peerDesc->Player->_playerIndex != playerIndex) {
 				return;
@@ -3944,6 +3856,29 @@ namespace Jazz2::Multiplayer
 
 			if (auto* remotePlayerOnServer = runtime_cast<RemotePlayerOnServer>(peerDesc->Player)) {
 				std::uint32_t frameCount = theApplication().GetFrameCount();
+				std::uint32_t step;
+				if (renderTime != INT64_MIN && FindStepByUpdateTime(renderTime, step)) {
+					if DEATH_UNLIKELY(step < remotePlayerOnServer->UpdatedStep) {
+						// Keys of a later step were already applied, the packets arrived out of order
+						return;
+					}
+					remotePlayerOnServer->UpdatedStep = step;
+
+					if (CanResimulateFrom(step)) {
+						// The keys were pressed in the past, so they replace the predicted input from that step on
+						ResimulateFrom(step, [remotePlayerOnServer, step, pressedKeys](std::uint32_t i) {
+							if (i != step) {
+								remotePlayerOnServer->PressedKeysLast = remotePlayerOnServer->PressedKeys;
+							}
+							remotePlayerOnServer->PressedKeys = pressedKeys;
+						});
+						// The last simulated step already reported the keys as hit
+						remotePlayerOnServer->UpdatedFrame = frameCount;
+						remotePlayerOnServer->PressedKeysLast = pressedKeys;
+						return;
+					}
+				}
+
 				if (remotePlayerOnServer->UpdatedFrame != frameCount) {
 					remotePlayerOnServer->UpdatedFrame = frameCount;
 					remotePlayerOnServer->PressedKeysLast = remotePlayerOnServer->PressedKeys;
@@ -4888,80 +4823,122 @@ namespace Jazz2::Multiplayer
 
 	bool MpLevelHandler::HandleServerPacketUpdateAllActors(const Peer& peer, ArrayView<const std::uint8_t> data)
 	{
-		MemoryStream packetCompressed(data);
-		DeflateStream packet(packetCompressed);
+		std::int64_t receivedTime = StateInterpolationBuffer::Now();
+
+		MemoryStream packet(data);
 		std::uint32_t now = packet.ReadVariableUint32();
+		std::uint32_t baselineSeq = packet.ReadVariableUint32();
 		float elapsedFrames = (float)packet.ReadVariableUint64();
-		std::uint32_t actorCount = packet.ReadVariableUint32();
+		std::int64_t serverTime = (std::int64_t)packet.ReadVariableUint64();
+		std::uint8_t packetFlags = packet.ReadValue<std::uint8_t>();
 
-		bool forceResyncInvoked = (actorCount & 1) == 1;
+		bool forceResyncInvoked = (packetFlags & 0x01) != 0;
 		if DEATH_UNLIKELY(!forceResyncInvoked && _lastUpdated >= now) {
 			return true;
 		}
 
-		bool forceResyncRequired = (!forceResyncInvoked && _lastUpdated + 1 < now);
-		if (forceResyncRequired) {
-			LOGD("[MP] ServerPacketType::UpdateAllActors - Force re-sync required ({} -> {})", _lastUpdated, now);
-		} else if (forceResyncInvoked) {
+		if (forceResyncInvoked) {
 			LOGD("[MP] ServerPacketType::UpdateAllActors - Force re-sync invoked ({} -> {})", _lastUpdated, now);
 		}
 
 		std::unique_lock lock(_lock);
 
-		_lastUpdated = now;
-		_elapsedFrames = lerp(_elapsedFrames, elapsedFrames + _networkManager->GetRoundTripTimeMs() * FrameTimer::FramesPerSecond * 0.002f, 0.05f);
+		const ActorSnapshot* baseline = nullptr;
+		if (baselineSeq != 0) {
+			if (now - baselineSeq < ActorSnapshotHistory::Capacity) {
+				baseline = _receivedSnapshots.Find(baselineSeq);
+			}
+			if (baseline == nullptr) {
+				// The baseline was never received or is already too old, only a full update can recover from it
+				LOGD("[MP] ServerPacketType::UpdateAllActors - Force re-sync required ({} -> {}, baseline {})", _lastUpdated, now, baselineSeq);
+				lock.unlock();
+				_networkManager->SendTo(AllPeers, NetworkChannel::Main, (std::uint8_t)ClientPacketType::ForceResyncActors, {});
+				return true;
+			}
+		}
 
-		actorCount >>= 1;
+		// Changes are applied against the last applied snapshot, which can be newer than the baseline
+		const ActorSnapshot* previous = nullptr;
+		if (now > _lastUpdated && now - _lastUpdated < ActorSnapshotHistory::Capacity) {
+			previous = _receivedSnapshots.Find(_lastUpdated);
+		}
+		const ActorSnapshot* lastApplied = (forceResyncInvoked ? nullptr : previous);
 
-		for (std::uint32_t i = 0; i < actorCount; i++) {
-			std::uint32_t actorId = packet.ReadVariableUint32();
-			std::uint8_t flags = packet.ReadValue<std::uint8_t>();
+		SnapshotBitReader reader(data.exceptPrefix((std::size_t)packet.GetPosition()));
+		ActorSnapshot& snapshot = _receivedSnapshots.Allocate(now);
+		if DEATH_UNLIKELY(!DecodeSnapshotDelta(reader, baseline, snapshot)) {
+			snapshot.Sequence = 0;
+			LOGW("[MP] ServerPacketType::UpdateAllActors - Malformed packet");
+			return true;
+		}
 
-			bool positionChanged = (flags & 0x01) != 0;
-			bool animationChanged = (flags & 0x02) != 0;
+		_lastUpdated = now;
+		_serverPlayoutDelay.AddSample(serverTime, receivedTime);
+		_elapsedFrames = lerp(_elapsedFrames, elapsedFrames + _networkManager->GetRoundTripTimeMs() * FrameTimer::FramesPerSecond * 0.002f, 0.05f);
 
-			float posX, posY, rotation, scaleX, scaleY;
-			AnimState anim; Actors::ActorRendererType rendererType;
+		// The server replicates only actors in the area of interest of this client, so actors that are missing from
+		// the snapshot now are hidden until they return, otherwise they would stay frozen at their last position
+		auto hideRemoteActor = [this](const ActorSnapshotEntry& prevEntry) {
+			auto it = _remoteActors.find(prevEntry.ActorID);
+			if (it != _remoteActors.end()) {
+				if (auto* remoteActor = runtime_cast<Actors::Multiplayer::RemoteActor>(it->second.get())) {
+					remoteActor->SyncMiscWithServer((std::uint8_t)(prevEntry.Flags & ~(0x04 | 0x40)));
+				}
+			}
+		};
 
-			if (positionChanged) {
-				posX = packet.ReadValue<std::int32_t>() / 512.0f;
-				posY = packet.ReadValue<std::int32_t>() / 512.0f;
-			} else {
-				posX = 0.0f;
-				posY = 0.0f;
+		std::size_t j = 0;
+		std::size_t prevCount = (previous != nullptr ? previous->Entries.size() : 0);
+		for (const auto& entry : snapshot.Entries) {
+			while (j < prevCount && previous->Entries[j].ActorID < entry.ActorID) {
+				hideRemoteActor(previous->Entries[j]);
+				j++;
+			}
+			const ActorSnapshotEntry* prevEntry = nullptr;
+			if (j < prevCount && previous->Entries[j].ActorID == entry.ActorID) {
+				prevEntry = &previous->Entries[j];
+				j++;
+			}
+			// An actor that returned to the area of interest must not interpolate from where it was last seen
+			bool hasReturned = (previous != nullptr && prevEntry == nullptr);
+			if (lastApplied == nullptr) {
+				prevEntry = nullptr;
 			}
 
-			if (animationChanged) {
-				anim = (AnimState)packet.ReadVariableUint32();
-				rotation = packet.ReadValue<std::uint16_t>() * fRadAngle360 / UINT16_MAX;
-				scaleX = (float)Half{packet.ReadValue<std::uint16_t>()};
-				scaleY = (float)Half{packet.ReadValue<std::uint16_t>()};
-				rendererType = (Actors::ActorRendererType)packet.ReadValue<std::uint8_t>();
-			} else {
-				anim = AnimState::Idle;
-				rotation = 0.0f;
-				scaleX = 0.0f;
-				scaleY = 0.0f;
-				rendererType = Actors::ActorRendererType::Default;
+			auto it = _remoteActors.find(entry.ActorID);
+			if (it == _remoteActors.end()) {
+				continue;
+			}
+			auto* remoteActor = runtime_cast<Actors::Multiplayer::RemoteActor>(it->second.get());
+			if (remoteActor == nullptr) {
+				continue;
 			}
 
-			auto it = _remoteActors.find(actorId);
-			if (it != _remoteActors.end()) {
-				if (auto* remoteActor = runtime_cast<Actors::Multiplayer::RemoteActor>(it->second.get())) {
-					if (positionChanged) {
-						remoteActor->SyncPositionWithServer(Vector2f(posX, posY));
-					}
-					if (animationChanged) {
-						remoteActor->SyncAnimationWithServer(anim, rotation, scaleX, scaleY, rendererType);
-					}
-					remoteActor->SyncMiscWithServer(flags);
-				}
+			// Positions are pushed every update, so the interpolation buffer stays dense even if the actor stands still
+			// and a missing update can be told apart from no movement
+			remoteActor->SyncPositionWithServer(Vector2f(entry.PosX / ActorSnapshotEntry::PositionScale, entry.PosY / ActorSnapshotEntry::PositionScale), serverTime);
+
+			bool animationChanged = (prevEntry == nullptr || prevEntry->Animation != entry.Animation || prevEntry->Rotation != entry.Rotation ||
+				prevEntry->ScaleX != entry.ScaleX || prevEntry->ScaleY != entry.ScaleY || prevEntry->RendererType != entry.RendererType);
+			if (animationChanged) {
+				remoteActor->SyncAnimationWithServer((AnimState)entry.Animation, entry.Rotation * fRadAngle360 / UINT16_MAX,
+					(float)Half{entry.ScaleX}, (float)Half{entry.ScaleY}, (Actors::ActorRendererType)entry.RendererType);
 			}
-		}
 
-		if (forceResyncRequired) {
-			_networkManager->SendTo(AllPeers, NetworkChannel::Main, (std::uint8_t)ClientPacketType::ForceResyncActors, {});
+			// Warp flag is one-shot, it must not be applied again while the server keeps it in unchanged entries
+			bool flagsChanged = (prevEntry == nullptr || prevEntry->Flags != entry.Flags);
+			std::uint8_t flags = (flagsChanged ? entry.Flags : (std::uint8_t)(entry.Flags & ~0x40));
+			remoteActor->SyncMiscWithServer(hasReturned ? (std::uint8_t)(flags | 0x40) : flags);
+		}
+		for (; j < prevCount; j++) {
+			hideRemoteActor(previous->Entries[j]);
 		}
+
+		lock.unlock();
+
+		MemoryStream ack(5);
+		ack.WriteVariableUint32(now);
+		_networkManager->SendTo(AllPeers, NetworkChannel::UnreliableUpdates, (std::uint8_t)ClientPacketType::AckUpdateAllActors, ack);
 		return true;
 	}
 
@@ -6132,6 +6109,27 @@ namespace Jazz2::Multiplayer
 		return (PreferencesCache::AllowCheats && serverConfig.GameMode == MpGameMode::Cooperation);
 	}
 
+	bool MpLevelHandler::IsFixedTimestepAllowed()
+	{
+		// Peers are not stepped in lockstep yet, so only the server can run in fixed steps to roll back late input
+		// of remote players, see HandleClientPacketPlayerKeyPress()
+		return (_isServer && !_isLocalSession && PreferencesCache::EnableRollback);
+	}
+
+	bool MpLevelHandler::FindStepByUpdateTime(std::int64_t updateTime, std::uint32_t& step) const
+	{
+		std::uint32_t count = std::min(_updatedStepsCount, std::uint32_t(arraySize(_updatedSteps)));
+		for (std::uint32_t i = 1; i <= count; i++) {
+			const auto& updatedStep = _updatedSteps[(_updatedStepsCount - i) % std::uint32_t(arraySize(_updatedSteps))];
+			if (updatedStep.Time <= updateTime) {
+				// Input of the update was applied with the step that followed it
+				step = updatedStep.Step;
+				return true;
+			}
+		}
+		return false;
+	}
+
 	void MpLevelHandler::BeforeActorDestroyed(Actors::ActorBase* actor)
 	{
 		if (!_isServer || _isLocalSession) {
@@ -6150,6 +6148,25 @@ namespace Jazz2::Multiplayer
 			actorId = it->second.ActorID;
 			_remotingActors.erase(it);
 			_remoteActors.erase(actorId);
+
+			if (_rollback != nullptr) {
+				// The actor can be put back by a rollback, then it has to be remoted again, see OnSnapshotRestored()
+				for (auto destroyed = _destroyedRemotingActors.begin(); destroyed != _destroyedRemotingActors.end(); ) {
+					if (destroyed->second.expired()) {
+						_destroyedRemotingActors.erase(destroyed++);
+					} else {
+						++destroyed;
+					}
+				}
+				_destroyedRemotingActors.emplace(actor, actor->shared_from_this());
+			}
+
+			auto pending = std::find(_pendingRemotingActors.begin(), _pendingRemotingActors.end(), actor);
+			if (pending != _pendingRemotingActors.end()) {
+				// The actor was never announced to peers
+				_pendingRemotingActors.erase(pending);
+				return;
+			}
 		}
 
 		MemoryStream packet(4);
@@ -6161,6 +6178,94 @@ namespace Jazz2::Multiplayer
 		}, NetworkChannel::Main, (std::uint8_t)ServerPacketType::DestroyRemoteActor, packet);
 	}
 
+	void MpLevelHandler::OnSnapshotRestored()
+	{
+		if (!_isServer || _isLocalSession) {
+			return;
+		}
+
+		// Only the restored actors are alive now, so an address of a dropped actor cannot be reused by another one yet
+		SmallVector<Actors::ActorBase*, 0> restoredActors;
+		restoredActors.reserve(_actors.size());
+		for (const auto& actor : _actors) {
+			restoredActors.push_back(actor.get());
+		}
+		std::sort(restoredActors.begin(), restoredActors.end());
+		auto isRestored = [&restoredActors](Actors::ActorBase* actor) {
+			return std::binary_search(restoredActors.begin(), restoredActors.end(), actor);
+		};
+
+		SmallVector<std::uint32_t, 0> droppedActorIds;
+		{
+			std::unique_lock lock(_lock);
+			// Actors spawned on the mispredicted branch no longer exist
+			for (auto it = _remotingActors.begin(); it != _remotingActors.end(); ) {
+				if (!isRestored(it->first)) {
+					droppedActorIds.push_back(it->second.ActorID);
+					_remoteActors.erase(it->second.ActorID);
+					_remotingActors.erase(it++);
+				} else {
+					++it;
+				}
+			}
+			_pendingRemotingActors.clear();
+
+			// Actors destroyed on the mispredicted branch are back, they are announced after the resimulation
+			for (auto it = _destroyedRemotingActors.begin(); it != _destroyedRemotingActors.end(); ) {
+				if (it->second.expired()) {
+					_destroyedRemotingActors.erase(it++);
+				} else if (isRestored(it->first)) {
+					std::uint32_t actorId = FindFreeActorId();
+					_remotingActors[it->first] = { actorId };
+					_remoteActors[actorId] = nullptr;
+					_pendingRemotingActors.push_back(it->first);
+					_destroyedRemotingActors.erase(it++);
+				} else {
+					++it;
+				}
+			}
+		}
+
+		for (std::size_t i = 0; i < _pendingSfx.size(); ) {
+			if (!isRestored(_pendingSfx[i].Actor)) {
+				_pendingSfx.erase(_pendingSfx.begin() + i);
+			} else {
+				i++;
+			}
+		}
+
+		for (std::uint32_t actorId : droppedActorIds) {
+			MemoryStream packet(4);
+			packet.WriteVariableUint32(actorId);
+
+			_networkManager->SendTo([this](const Peer& peer) {
+				auto peerDesc = _networkManager->GetPeerDescriptor(peer);
+				return (peerDesc && peerDesc->LevelState >= PeerLevelState::LevelSynchronized);
+			}, NetworkChannel::Main, (std::uint8_t)ServerPacketType::DestroyRemoteActor, packet);
+		}
+	}
+
+	void MpLevelHandler::OnResimulated()
+	{
+		if (!_isServer || _isLocalSession) {
+			return;
+		}
+
+		for (Actors::ActorBase* actor : _pendingRemotingActors) {
+			std::uint32_t actorId;
+			{
+				std::unique_lock lock(_lock);
+				auto it = _remotingActors.find(actor);
+				if (it == _remotingActors.end()) {
+					continue;
+				}
+				actorId = it->second.ActorID;
+			}
+			AnnounceRemotingActor(actor, actorId);
+		}
+		_pendingRemotingActors.clear();
+	}
+
 	void MpLevelHandler::ProcessEvents(float timeMult)
 	{
 		// Process events only by server
@@ -6891,6 +6996,234 @@ namespace Jazz2::Multiplayer
 		}
 	}
 
+	void MpLevelHandler::BuildWorldSnapshot()
+	{
+		_worldSnapshot.Sequence = _lastUpdated;
+		_worldSnapshot.Entries.clear();
+
+		for (Actors::Player* player : _players) {
+			auto* mpPlayer = static_cast<PlayerOnServer*>(player);
+
+			// Skip spectate players - don't send their position to other clients
+			if (mpPlayer->_playerType == PlayerType::Spectate) {
+				continue;
+			}
+
+			auto& entry = _worldSnapshot.Entries.emplace_back();
+			FillSnapshotEntry(entry, player->_playerIndex, player);
+
+			// Outline renderer type is local-only
+			if (entry.RendererType == (std::uint8_t)Actors::ActorRendererType::Outline) {
+				entry.RendererType = (std::uint8_t)Actors::ActorRendererType::Default;
+			}
+			entry.Flags |= 0x80; // IsPlayer
+			if (mpPlayer->_justWarped) {
+				mpPlayer->_justWarped = false;
+				entry.Flags |= 0x40;
+			}
+		}
+
+		{
+			std::unique_lock lock(_lock);
+			for (auto& [remotingActor, remotingActorInfo] : _remotingActors) {
+				auto& entry = _worldSnapshot.Entries.emplace_back();
+				FillSnapshotEntry(entry, remotingActorInfo.ActorID, remotingActor);
+			}
+		}
+
+		_worldSnapshot.Sort();
+	}
+
+	void MpLevelHandler::FillSnapshotEntry(ActorSnapshotEntry& entry, std::uint32_t actorId, Actors::ActorBase* actor)
+	{
+		entry.ActorID = actorId;
+		entry.PosX = (std::int32_t)std::round(actor->_pos.X * ActorSnapshotEntry::PositionScale);
+		entry.PosY = (std::int32_t)std::round(actor->_pos.Y * ActorSnapshotEntry::PositionScale);
+		entry.Animation = (std::uint32_t)(actor->_currentTransition != nullptr ? actor->_currentTransition->State : (actor->_currentAnimation != nullptr ? actor->_currentAnimation->State : AnimState::Idle));
+
+		float rotation = actor->_renderer.rotation();
+		if (rotation < 0.0f) rotation += fRadAngle360;
+		entry.Rotation = (std::uint16_t)(rotation * UINT16_MAX / fRadAngle360);
+		Vector2f scale = actor->_renderer.scale();
+		entry.ScaleX = (std::uint16_t)Half{scale.X};
+		entry.ScaleY = (std::uint16_t)Half{scale.Y};
+		entry.RendererType = (std::uint8_t)actor->_renderer.GetRendererType();
+
+		entry.Flags = 0;
+		if (actor->_renderer.isDrawEnabled()) {
+			entry.Flags |= 0x04;
+		}
+		if (actor->_renderer.AnimPaused) {
+			entry.Flags |= 0x08;
+		}
+		if (actor->_renderer.isFlippedX()) {
+			entry.Flags |= 0x10;
+		}
+		if (actor->_renderer.isFlippedY()) {
+			entry.Flags |= 0x20;
+		}
+	}
+
+	std::uint32_t MpLevelHandler::SendSnapshotsToPeers()
+	{
+		std::uint32_t jobCount = 0;
+		for (auto& [peer, peerDesc] : *_networkManager->GetPeers()) {
+			if (peerDesc->RemotePeer && peerDesc->LevelState >= PeerLevelState::LevelSynchronized) {
+				if (jobCount >= _snapshotJobs.size()) {
+					_snapshotJobs.emplace_back();
+				}
+				auto& job = _snapshotJobs[jobCount++];
+				job.RemotePeer = peer;
+
+				// Peers without a player or spectating ones can look anywhere, so they receive all actors
+				MpPlayer* player = peerDesc->Player;
+				job.HasView = (player != nullptr && player->_playerType != PlayerType::Spectate &&
+					!player->GetState(Actors::ActorState::IsDestroyed));
+				job.ViewPos = (job.HasView ? player->_pos : Vector2f::Zero);
+			}
+		}
+
+		{
+			std::unique_lock lock(_lock);
+			for (std::uint32_t i = 0; i < jobCount; i++) {
+				auto& job = _snapshotJobs[i];
+				auto& state = _peerSnapshots[job.RemotePeer];
+				if (state == nullptr) {
+					// Spread reduced-rate updates of different peers across updates
+					state = std::make_shared<PeerSnapshotState>((std::uint32_t)_peerSnapshots.size() % InterestFarUpdateInterval);
+				}
+				job.State = state;
+				job.AckedSequence = state->LastAckedSequence;
+				job.ForceFullUpdate = state->ForceFullUpdate;
+				state->ForceFullUpdate = false;
+			}
+		}
+
+		// Players are always replicated, they are shown in HUD even if they are off-screen
+		_interestGrid.Build(_worldSnapshot, 0x80);
+
+		// World snapshot and interest grid are immutable from now on, so each peer can be encoded independently
+		ParallelFor(jobCount, [this](std::uint32_t index) {
+			EncodeSnapshotForPeer(_snapshotJobs[index]);
+		});
+
+		std::uint32_t totalPacketSize = 0;
+#if defined(DEATH_DEBUG) && defined(WITH_IMGUI)
+		std::uint32_t maxPacketSize = 0;
+#endif
+
+		{
+			std::unique_lock lock(_lock);
+			for (std::uint32_t i = 0; i < jobCount; i++) {
+				auto& job = _snapshotJobs[i];
+				auto& stats = job.State->Stats;
+				stats.LastPacketSize = (std::uint32_t)job.Packet.GetSize();
+				stats.LastEncodeTimeUs = job.EncodeTimeUs;
+				if (stats.FullUpdatesSent + stats.DeltaUpdatesSent == 0) {
+					stats.AveragePacketSize = (float)stats.LastPacketSize;
+					stats.AverageEncodeTimeUs = stats.LastEncodeTimeUs;
+				} else {
+					stats.AveragePacketSize = lerp(stats.AveragePacketSize, (float)stats.LastPacketSize, 0.05f);
+					stats.AverageEncodeTimeUs = lerp(stats.AverageEncodeTimeUs, stats.LastEncodeTimeUs, 0.05f);
+				}
+				if (job.IsFullUpdate) {
+					stats.FullUpdatesSent++;
+				} else {
+					stats.DeltaUpdatesSent++;
+				}
+				stats.LastAckedSequence = job.AckedSequence;
+			}
+		}
+
+		for (std::uint32_t i = 0; i < jobCount; i++) {
+			auto& job = _snapshotJobs[i];
+			std::uint32_t packetSize = (std::uint32_t)job.Packet.GetSize();
+			totalPacketSize += packetSize;
+#if defined(DEATH_DEBUG) && defined(WITH_IMGUI)
+			maxPacketSize = std::max(maxPacketSize, packetSize);
+#endif
+
+			// Forced updates are sent reliably, so the client will eventually acknowledge one of them
+			_networkManager->SendTo(job.RemotePeer, job.ForceFullUpdate ? NetworkChannel::Main : NetworkChannel::UnreliableUpdates,
+				std::move(job.Packet));
+
+			// Don't keep state of disconnected peers alive longer than necessary
+			job.State = nullptr;
+		}
+
+		std::uint32_t averagePacketSize = (jobCount > 0 ? totalPacketSize / jobCount : 0);
+
+#if defined(DEATH_DEBUG) && defined(WITH_IMGUI)
+		_updatePacketSize[_plotIndex] = (float)maxPacketSize;
+		_updatePacketMaxSize = std::max(_updatePacketMaxSize, _updatePacketSize[_plotIndex]);
+		_averageUpdatePacketSize[_plotIndex] = (float)averagePacketSize;
+#endif
+
+		return averagePacketSize;
+	}
+
+	void MpLevelHandler::EncodeSnapshotForPeer(PeerSnapshotJob& job)
+	{
+		TimeStamp encodeStart = TimeStamp::now();
+		PeerSnapshotState& state = *job.State;
+
+		// Baseline has to be looked up before allocating the new slot, it could be overwritten otherwise
+		const ActorSnapshot* baseline = nullptr;
+		if (!job.ForceFullUpdate && _lastUpdated - job.AckedSequence < ActorSnapshotHistory::Capacity) {
+			baseline = state.History.Find(job.AckedSequence);
+		}
+		job.IsFullUpdate = (baseline == nullptr);
+
+		const ActorSnapshot* lastSent = state.History.Find(_lastUpdated - 1);
+		ActorSnapshot& snapshot = state.History.Allocate(_lastUpdated);
+		if (job.HasView) {
+			job.InterestIndices.clear();
+			_interestGrid.Query(Rectf::FromCenterSize(job.ViewPos, InterestFarExtent * 2.0f), job.InterestIndices);
+
+			Rectf nearRect = Rectf::FromCenterSize(job.ViewPos, InterestNearExtent * 2.0f);
+			bool isFarUpdate = (job.IsFullUpdate || (_lastUpdated + state.FarUpdatePhase) % InterestFarUpdateInterval == 0);
+			for (std::uint32_t index : job.InterestIndices) {
+				const ActorSnapshotEntry& entry = _worldSnapshot.Entries[index];
+				if (!isFarUpdate && (entry.Flags & 0x80) == 0 && lastSent != nullptr &&
+					!nearRect.Contains(Vector2f(entry.PosX / ActorSnapshotEntry::PositionScale, entry.PosY / ActorSnapshotEntry::PositionScale))) {
+					// Repeat the last sent state of distant actors, so they produce no delta in this update
+					if (const ActorSnapshotEntry* lastSentEntry = lastSent->Find(entry.ActorID)) {
+						snapshot.Entries.push_back(*lastSentEntry);
+						continue;
+					}
+				}
+				snapshot.Entries.push_back(entry);
+			}
+		} else {
+			snapshot.Entries = _worldSnapshot.Entries;
+		}
+
+		// Written straight into the transport buffer, so sending it doesn't copy the payload again
+		job.Packet = OutgoingPacket((std::uint8_t)ServerPacketType::UpdateAllActors, 16 + snapshot.Entries.size() * 8);
+		job.Packet.WriteVariableUint32(_lastUpdated);
+		job.Packet.WriteVariableUint32(baseline != nullptr ? baseline->Sequence : 0);
+		job.Packet.WriteVariableUint64((std::uint64_t)_elapsedFrames);
+		job.Packet.WriteVariableUint64((std::uint64_t)_lastUpdatedTime);
+		job.Packet.WriteValue<std::uint8_t>(job.ForceFullUpdate ? 0x01 : 0x00);
+
+		SnapshotBitWriter writer;
+		EncodeSnapshotDelta(writer, snapshot, baseline);
+		writer.FlushTo(job.Packet);
+
+		job.EncodeTimeUs = encodeStart.microsecondsSince();
+	}
+
+	bool MpLevelHandler::GetPeerSnapshotStats(const Peer& peer, PeerSnapshotStats& stats)
+	{
+		std::unique_lock lock(_lock);
+		auto it = _peerSnapshots.find(peer);
+		if (it == _peerSnapshots.end()) {
+			return false;
+		}
+		stats = it->second->Stats;
+		return true;
+	}
+
 	void MpLevelHandler::SynchronizePeers(float timeMult)
 	{
 		for (auto& [peer, peerDesc] : *_networkManager->GetPeers()) {
@@ -7098,6 +7431,8 @@ namespace Jazz2::Multiplayer
 
 					Actors::Multiplayer::RemotePlayerOnServer* ptr = player.get();
 					_players.push_back(ptr);
+					// Players are not a part of rollback snapshots
+					DiscardRollbackHistory();
 
 					_suppressRemoting = true;
 					AddActor(player);
@@ -7240,6 +7575,8 @@ namespace Jazz2::Multiplayer
 
 					Actors::Multiplayer::RemotePlayerOnServer* ptr = player.get();
 					_players.push_back(ptr);
+					// Players are not a part of rollback snapshots
+					DiscardRollbackHistory();
 
 					_suppressRemoting = true;
 					AddActor(player);
@@ -7318,6 +7655,37 @@ namespace Jazz2::Multiplayer
 		return UINT32_MAX;
 	}
 
+	void MpLevelHandler::AnnounceRemotingActor(Actors::ActorBase* actor, std::uint32_t actorId)
+	{
+		if (ActorShouldBeMirrored(actor)) {
+			Vector2i originTile = actor->_originTile;
+			const auto& eventTile = _eventMap->GetEventTile(originTile.X, originTile.Y);
+			if (eventTile.Event != EventType::Empty) {
+				MemoryStream packet(24 + Events::EventSpawner::SpawnParamsSize);
+				packet.WriteVariableUint32(actorId);
+				packet.WriteVariableUint32((std::uint32_t)eventTile.Event);
+				packet.Write(eventTile.EventParams, Events::EventSpawner::SpawnParamsSize);
+				packet.WriteVariableUint32((std::uint32_t)eventTile.EventFlags);
+				packet.WriteVariableInt32((std::int32_t)originTile.X);
+				packet.WriteVariableInt32((std::int32_t)originTile.Y);
+				packet.WriteVariableInt32((std::int32_t)actor->_renderer.layer());
+
+				_networkManager->SendTo([this](const Peer& peer) {
+					auto peerDesc = _networkManager->GetPeerDescriptor(peer);
+					return (peerDesc && peerDesc->LevelState >= PeerLevelState::LevelSynchronized);
+				}, NetworkChannel::Main, (std::uint8_t)ServerPacketType::CreateMirroredActor, packet);
+			}
+		} else {
+			MemoryStream packet;
+			InitializeCreateRemoteActorPacket(packet, actorId, actor);
+
+			_networkManager->SendTo([this](const Peer& peer) {
+				auto peerDesc = _networkManager->GetPeerDescriptor(peer);
+				return (peerDesc && peerDesc->LevelState >= PeerLevelState::LevelSynchronized);
+			}, NetworkChannel::Main, (std::uint8_t)ServerPacketType::CreateRemoteActor, packet);
+		}
+	}
+
 	std::uint8_t MpLevelHandler::FindFreePlayerId()
 	{
 		// Reserve ID 0 for the local player
@@ -8611,7 +8979,7 @@ namespace Jazz2::Multiplayer
 					_eventMap->Deactivate(originTile.X, originTile.Y);
 				}
 
-				actor->_state |= Actors::ActorState::IsDestroyed;
+				actor->SetState(Actors::ActorState::IsDestroyed, true);
 			}
 		}
 	}
@@ -9620,9 +9988,9 @@ namespace Jazz2::Multiplayer
 		ImGui::SameLine(600.0f);
 		ImGui::Text("%.0f bytes", _updatePacketSize[_plotIndex]);
 
-		ImGui::PlotLines("Update Packet Size Compressed", _compressedUpdatePacketSize, PlotValueCount, _plotIndex, nullptr, 0.0f, _updatePacketMaxSize, ImVec2(appWidth * 0.2f, 40.0f));
+		ImGui::PlotLines("Update Packet Size Average", _averageUpdatePacketSize, PlotValueCount, _plotIndex, nullptr, 0.0f, _updatePacketMaxSize, ImVec2(appWidth * 0.2f, 40.0f));
 		ImGui::SameLine(600.0f);
-		ImGui::Text("%.0f bytes", _compressedUpdatePacketSize[_plotIndex]);
+		ImGui::Text("%.0f bytes", _averageUpdatePacketSize[_plotIndex]);
 
 		ImGui::Separator();
 
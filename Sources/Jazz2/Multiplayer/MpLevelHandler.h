@@ -3,11 +3,13 @@
 #if defined(WITH_MULTIPLAYER) || defined(DOXYGEN_GENERATING_OUTPUT)
 
 #include "../LevelHandler.h"
+#include "ActorSnapshot.h"
 #include "MpGameMode.h"
 #include "Teams.h"
 #include "NetworkManager.h"
 #include "GameModes/GameModeFactory.h"
 #include "../Actors/Player.h"
+#include "../Actors/Multiplayer/StateInterpolationBuffer.h"
 #include "../UI/InGameConsole.h"
 
 #include <Threading/Spinlock.h>
@@ -243,6 +245,37 @@ namespace Jazz2::Multiplayer
 		/** @brief Returns owner of the specified object or the player itself */
 		static Actors::Multiplayer::MpPlayer* GetWeaponOwner(Actors::ActorBase* actor);
 
+		/** @brief Per-peer statistics of @ref ServerPacketType::UpdateAllActors encoding */
+		struct PeerSnapshotStats {
+			/** @brief Size of the last sent packet in bytes */
+			std::uint32_t LastPacketSize;
+			/** @brief Exponential moving average of the packet size in bytes */
+			float AveragePacketSize;
+			/** @brief Time spent encoding the last packet in microseconds */
+			float LastEncodeTimeUs;
+			/** @brief Exponential moving average of the encoding time in microseconds */
+			float AverageEncodeTimeUs;
+			/** @brief Total number of full (non-delta) snapshots sent */
+			std::uint32_t FullUpdatesSent;
+			/** @brief Total number of delta snapshots sent */
+			std::uint32_t DeltaUpdatesSent;
+			/** @brief Sequence number of the last acknowledged snapshot */
+			std::uint32_t LastAckedSequence;
+		};
+
+		/** @brief Returns snapshot encoding statistics of the specified peer (server-side) */
+		bool GetPeerSnapshotStats(const Peer& peer, PeerSnapshotStats& stats);
+		/** @brief Returns time spent building and sending the last world snapshot in microseconds (server-side) */
+		float GetLastSnapshotTimeUs() const {
+			return _lastSnapshotTimeUs;
+		}
+
+		// Client-only methods
+		/** @brief Returns server tick time at which remote actors should be displayed in the current frame */
+		std::int64_t GetServerRenderTime() const {
+			return _serverRenderTime;
+		}
+
 		// Server-only methods
 		/** @brief Processes the specified server command */
 		bool ProcessCommand(const Peer& peer, StringView line, bool isAdmin);
@@ -277,8 +310,11 @@ namespace Jazz2::Multiplayer
 		std::shared_ptr<Actors::Player> CreateResumablePlayer(std::int32_t index) override;
 		void PrepareNextLevelInitialization(LevelInitialization& levelInit) override;
 		bool IsCheatingAllowed() override;
+		bool IsFixedTimestepAllowed() override;
 
 		void BeforeActorDestroyed(Actors::ActorBase* actor) override;
+		void OnSnapshotRestored() override;
+		void OnResimulated() override;
 		void ProcessEvents(float timeMult) override;
 
 		void PauseGame() override;
@@ -354,13 +390,33 @@ namespace Jazz2::Multiplayer
 		// Doxygen 1.12.0 outputs also private structs/unions even if it shouldn't
 		struct RemotingActorInfo {
 			std::uint32_t ActorID;
-			std::int32_t LastPosX;
-			std::int32_t LastPosY;
-			std::uint32_t LastAnimation;
-			std::uint16_t LastRotation;
-			std::uint16_t LastScaleX;
-			std::uint16_t LastScaleY;
-			std::uint8_t LastRendererType;
+		};
+
+		// Server: snapshots sent to a single peer, deltas are always encoded against the last acknowledged one
+		struct PeerSnapshotState {
+			ActorSnapshotHistory History;		// Accessed only by the encoding job of this peer
+			std::uint32_t LastAckedSequence;	// Guarded by _lock
+			std::uint32_t FarUpdatePhase;
+			bool ForceFullUpdate;				// Guarded by _lock
+			PeerSnapshotStats Stats;			// Guarded by _lock
+
+			PeerSnapshotState(std::uint32_t farUpdatePhase)
+				: LastAckedSequence(0), FarUpdatePhase(farUpdatePhase), ForceFullUpdate(true), Stats{} {}
+		};
+
+		// Server: encoding of a single peer packet in SendSnapshotsToPeers(), jobs of all peers run in parallel
+		struct PeerSnapshotJob {
+			Peer RemotePeer;
+			std::shared_ptr<PeerSnapshotState> State;
+			Vector2f ViewPos;
+			bool HasView;
+			bool ForceFullUpdate;
+			std::uint32_t AckedSequence;
+
+			bool IsFullUpdate;
+			float EncodeTimeUs;
+			OutgoingPacket Packet;
+			SmallVector<std::uint32_t, 0> InterestIndices;
 		};
 
 		struct PlayerName {
@@ -413,6 +469,11 @@ namespace Jazz2::Multiplayer
 				: Actor(actor), Identifier(std::move(identifier)), Gain(gain), Pitch(pitch) {}
 		};
 
+		struct UpdatedStep {
+			std::int64_t Time;
+			std::uint32_t Step;
+		};
+
 		struct RequiredAsset {
 			AssetType Type;
 			std::uint32_t Crc32;
@@ -435,10 +496,14 @@ namespace Jazz2::Multiplayer
 
 		//static constexpr float UpdatesPerSecond = 16.0f; // ~62 ms interval
 		static constexpr float UpdatesPerSecond = 30.0f; // ~33 ms interval
-		static constexpr std::int64_t ServerDelay = 64;
 		static constexpr float EndingDuration = 10 * FrameTimer::FramesPerSecond;
 		static constexpr float TeamSwitchCooldownFrames = 5.0f * FrameTimer::FramesPerSecond;
 		static constexpr float CtfTouchRadius = 40.0f;	// Pixel radius for picking up / returning / capturing flags
+		// Area of interest of each peer in pixels (half-extents around its player), actors outside of the far area are not
+		// replicated, actors between the near and the far area are replicated only every FarUpdateInterval-th update
+		static constexpr Vector2f InterestNearExtent = Vector2f((float)DefaultWidth, (float)DefaultHeight);
+		static constexpr Vector2f InterestFarExtent = Vector2f((float)DefaultWidth * 2.0f, (float)DefaultHeight * 2.0f);
+		static constexpr std::uint32_t InterestFarUpdateInterval = 4;
 
 		NetworkManager* _networkManager;
 		std::unique_ptr<GameModes::IGameMode> _gameMode;
@@ -447,11 +512,12 @@ namespace Jazz2::Multiplayer
 		LevelState _levelState;
 		bool _isServer;
 		bool _isLocalSession;	// Local splitscreen session - there are no peers, so no packets are ever built
-		bool _forceResyncPending;
 		bool _enableSpawning;
 		bool _enqueuedPlaylistChange; // Server: apply the next playlist entry once the end-of-level transition finishes
 		HashMap<std::uint32_t, std::shared_ptr<Actors::ActorBase>> _remoteActors; // Client: Actor ID -> Remote Actor created by server
 		HashMap<Actors::ActorBase*, RemotingActorInfo> _remotingActors; // Server: Local Actor created by server -> Info
+		HashMap<Actors::ActorBase*, std::weak_ptr<Actors::ActorBase>> _destroyedRemotingActors; // Server: remoted actors destroyed while a rollback snapshot can still restore them
+		SmallVector<Actors::ActorBase*, 0> _pendingRemotingActors; // Server: remoted actors not announced to peers until the resimulation ends
 		HashMap<std::uint32_t, PlayerName> _playerNames; // Client: Actor ID -> Player name (and flags)
 		SmallVector<PlayerPositionInRound, 0> _positionsInRound; // Client: Actor ID -> Position In Round
 		SmallVector<std::uint32_t, 0> _teamScores;	// Server: computed each check; Client: mirrored for the HUD (index = team id)
@@ -471,9 +537,20 @@ namespace Jazz2::Multiplayer
 		Vector2i _raceBoundsMax;
 		bool _raceCheckpointsOrdered;								// Whether _orderedRaceCheckpoints come from authored waypoints (trusted for progress-based ranking)
 		SmallVector<PendingSfx, 0> _pendingSfx;
+		ActorSnapshot _worldSnapshot;	// Server: state of all replicated actors captured in the current update
+		ActorInterestGrid _interestGrid;	// Server: spatial index of _worldSnapshot for per-peer area of interest
+		HashMap<Peer, std::shared_ptr<PeerSnapshotState>> _peerSnapshots;	// Server: per-peer snapshot history (guarded by _lock)
+		SmallVector<PeerSnapshotJob, 0> _snapshotJobs;	// Server: reused across updates to keep allocated buffers
+		ActorSnapshotHistory _receivedSnapshots;	// Client: reconstructed snapshots, used as baselines for incoming deltas
 		std::uint32_t _lastSpawnedActorId;	// Server: last assigned actor/player ID, Client: ID assigned by server
 		std::int32_t _waitingForPlayerCount;	// Client: number of players needed to start the game
 		std::uint32_t _lastUpdated; // Server/Client: last update from the server
+		std::int64_t _lastUpdatedTime; // Server: tick time of _lastUpdated, stamped into snapshots
+		UpdatedStep _updatedSteps[RollbackBuffer::Capacity]; // Server: steps that followed the last updates, only with rollback
+		std::uint32_t _updatedStepsCount; // Server: number of updates written to _updatedSteps
+		float _lastSnapshotTimeUs; // Server: duration of the last BuildWorldSnapshot() and SendSnapshotsToPeers()
+		Actors::Multiplayer::PlayoutDelayEstimator _serverPlayoutDelay; // Client: adaptive delay of server updates (guarded by _lock)
+		std::int64_t _serverRenderTime; // Client: server tick time displayed in the current frame
 		std::uint64_t _seqNumWarped; // Client: set to _seqNum from HandlePlayerWarped() when warped
 		Threading::Spinlock _lock;
 		bool _suppressRemoting; // Server: if true, actor will not be automatically remoted to other players
@@ -505,8 +582,14 @@ namespace Jazz2::Multiplayer
 
 		void InitializeRequiredAssets();
 		void SynchronizePeers(float timeMult);
+		void BuildWorldSnapshot();
+		std::uint32_t SendSnapshotsToPeers();
+		void EncodeSnapshotForPeer(PeerSnapshotJob& job);
+		static void FillSnapshotEntry(ActorSnapshotEntry& entry, std::uint32_t actorId, Actors::ActorBase* actor);
 		std::uint32_t FindFreeActorId();
+		void AnnounceRemotingActor(Actors::ActorBase* actor, std::uint32_t actorId);
 		std::uint8_t FindFreePlayerId();
+		bool FindStepByUpdateTime(std::int64_t updateTime, std::uint32_t& step) const;
 		std::int32_t GetNonSpectatePlayerCount();
 		bool IsLocalPlayer(Actors::ActorBase* actor);
 		void ApplyGameModeToAllPlayers(MpGameMode gameMode);
@@ -571,6 +654,7 @@ namespace Jazz2::Multiplayer
 		bool HandleClientPacketValidateAssetsResponse(const Peer& peer, ArrayView<const std::uint8_t> data);
 		bool HandleClientPacketPlayerReady(const Peer& peer, ArrayView<const std::uint8_t> data);
 		bool HandleClientPacketForceResyncActors(const Peer& peer, ArrayView<const std::uint8_t> data);
+		bool HandleClientPacketAckUpdateAllActors(const Peer& peer, ArrayView<const std::uint8_t> data);
 		bool HandleClientPacketPlayerUpdate(const Peer& peer, ArrayView<const std::uint8_t> data);
 		bool HandleClientPacketPlayerKeyPress(const Peer& peer, ArrayView<const std::uint8_t> data);
 		bool HandleClientPacketPlayerChangeWeaponRequest(const Peer& peer, ArrayView<const std::uint8_t> data);
@@ -626,7 +710,7 @@ namespace Jazz2::Multiplayer
 		float _mirroredActorsCount[PlotValueCount];
 		float _updatePacketMaxSize;
 		float _updatePacketSize[PlotValueCount];
-		float _compressedUpdatePacketSize[PlotValueCount];
+		float _averageUpdatePacketSize[PlotValueCount];
 
 		void ShowDebugWindow();
 #endif
@@ -98,6 +98,21 @@ namespace Jazz2::Multiplayer
 		return true;
 	}
 
+#if !defined(DEATH_TARGET_EMSCRIPTEN)
+	bool NetworkManager::CreateLoopbackServer(INetworkHandler* handler, ILoopbackHandler* loopback, ServerConfiguration&& serverConfig)
+	{
+		_peerDesc.emplace(Peer{}, std::make_shared<PeerDescriptor>());
+		_serverConfig = std::make_unique<ServerConfiguration>(std::move(serverConfig));
+
+		std::memcpy(&_serverConfig->UniqueServerID[0], &PreferencesCache::UniqueServerID[0], arraySize(_serverConfig->UniqueServerID));
+		_serverConfig->StartUnixTimestamp = DateTime::UtcNow().ToUnixMilliseconds() / 1000;
+
+		// Clients run in the same process, so there is no server discovery
+		NetworkManagerBase::CreateLoopbackSession(handler, loopback);
+		return true;
+	}
+#endif
+
 	void NetworkManager::Dispose()
 	{
 		_discovery = nullptr;
@@ -47,6 +47,17 @@ namespace Jazz2::Multiplayer
 		 */
 		bool CreateLocalServer(INetworkHandler* handler, ServerConfiguration&& serverConfig);
 
+#if !defined(DEATH_TARGET_EMSCRIPTEN) || defined(DOXYGEN_GENERATING_OUTPUT)
+		/**
+		 * @brief Creates a socket-less server whose peers are in-process loopback clients
+		 *
+		 * Behaves like a regular server (@ref NetworkState::Listening), but binds no socket and is not announced
+		 * on the local network. Clients are connected with @ref ConnectLoopbackPeer() and their traffic is routed
+		 * through @p loopback, which is used to benchmark the server without any network.
+		 */
+		bool CreateLoopbackServer(INetworkHandler* handler, ILoopbackHandler* loopback, ServerConfiguration&& serverConfig);
+#endif
+
 		void Dispose() override;
 
 		/** @brief Returns server configuration */
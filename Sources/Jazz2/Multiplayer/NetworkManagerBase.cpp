@@ -5,6 +5,7 @@
 
 #if defined(WITH_MULTIPLAYER)
 
+#include "ILoopbackHandler.h"
 #include "INetworkHandler.h"
 #include "PacketTypes.h"
 #include "../../nCine/Base/Algorithms.h"
@@ -165,7 +166,7 @@ namespace Jazz2::Multiplayer
 	NetworkManagerBase::NetworkManagerBase()
 		:
 #if !defined(DEATH_TARGET_EMSCRIPTEN)
-		_host(nullptr),
+		_host(nullptr), _loopback(nullptr), _loopbackLastIndex(0),
 #endif
 		_state(NetworkState::None), _handler(nullptr)
 	{
@@ -188,6 +189,9 @@ namespace Jazz2::Multiplayer
 		_state = NetworkState::Connecting;
 		_clientData = clientData;
 		_handler = handler;
+#if defined(WITH_ONLINE_MULTIPLAYER) && !defined(DEATH_TARGET_EMSCRIPTEN)
+		_gameThreadId = Thread::GetCurrentId();
+#endif
 
 #if defined(WITH_ONLINE_MULTIPLAYER)
 #	if defined(DEATH_TARGET_EMSCRIPTEN) && defined(WITH_WEBSOCKET)
@@ -244,6 +248,10 @@ namespace Jazz2::Multiplayer
 		if (firstEndpoint.hasPrefix("ws://"_s) || firstEndpoint.hasPrefix("wss://"_s)) {
 			LOGI("Connecting to \"{}\" via WebSocket transport", firstEndpoint);
 
+			// The previous connection was already stopped and its events dropped by its client thread, the only
+			// consumer of the queue, see OnClientWsThread()
+			_wsClient = nullptr;
+
 			_wsClient = std::make_unique<ix::WebSocket>();
 			_wsClient->setUrl(firstEndpoint);
 			_wsClient->addSubProtocol(MakeClientSubProtocol(clientData));
@@ -251,24 +259,27 @@ namespace Jazz2::Multiplayer
 				{"User-Agent", "Jazz2 Resurrection"}
 			});
 			_wsClient->disableAutomaticReconnection();
-			_wsClient->setOnMessageCallback([this](const ix::WebSocketMessagePtr& msg) {
-				ix::WebSocket* ws = _wsClient.get();
+			_wsClient->setOnMessageCallback([this, ws = _wsClient.get()](const ix::WebSocketMessagePtr& msg) {
+				// The client connection has a single callback thread, so events are passed through a lock-free queue
 				if (msg->type == ix::WebSocketMessageType::Open) {
-					std::unique_lock<Spinlock> lock(_wsLock);
-					_wsPeers.emplace(ws, WsPeerInfo{});
-					_wsPendingEvents.push_back({WsQueuedEvent::Type::Open, ws, {}, _clientData, 0});
+					{
+						std::unique_lock<Spinlock> lock(_wsLock);
+						_wsPeers.emplace(ws, WsPeerInfo{});
+					}
+					PushWsClientEvent({WsQueuedEvent::Type::Open, ws, {}, _clientData, 0});
 				} else if (msg->type == ix::WebSocketMessageType::Close) {
-					std::unique_lock<Spinlock> lock(_wsLock);
-					_wsPeers.erase(ws);
-					_wsPendingEvents.push_back({WsQueuedEvent::Type::Close, ws, {}, 0, msg->closeInfo.code});
+					{
+						std::unique_lock<Spinlock> lock(_wsLock);
+						_wsPeers.erase(ws);
+					}
+					PushWsClientEvent({WsQueuedEvent::Type::Close, ws, {}, 0, msg->closeInfo.code});
 				} else if (msg->type == ix::WebSocketMessageType::Message && msg->binary) {
 					if (!msg->str.empty()) {
-						std::unique_lock<Spinlock> lock(_wsLock);
-						_wsPendingEvents.push_back({WsQueuedEvent::Type::Message, ws, msg->str, 0, 0});
+						PushWsClientEvent({WsQueuedEvent::Type::Message, ws, msg->str, 0, 0});
 					}
 				} else if (msg->type == ix::WebSocketMessageType::Error) {
 					LOGE("WebSocket transport error: {}", StringView{msg->errorInfo.reason});
-					_wsPendingEvents.push_back({WsQueuedEvent::Type::Close, ws, {}, 0, 0});
+					PushWsClientEvent({WsQueuedEvent::Type::Close, ws, {}, 0, 0});
 				}
 			});
 			_wsClient->start();
@@ -364,6 +375,7 @@ namespace Jazz2::Multiplayer
 
 		_handler = handler;
 		_state = NetworkState::Listening;
+		_gameThreadId = Thread::GetCurrentId();
 		_thread = Thread(NetworkManagerBase::OnServerThread, this);
 		return true;
 #else
@@ -379,8 +391,124 @@ namespace Jazz2::Multiplayer
 		_handler = handler;
 	}
 
+#if !defined(DEATH_TARGET_EMSCRIPTEN)
+	void NetworkManagerBase::CreateLoopbackSession(INetworkHandler* handler, ILoopbackHandler* loopback)
+	{
+		// Everything runs on the calling thread, so the manager only reports a listening state
+		_state = NetworkState::Listening;
+		_handler = handler;
+		_loopback = loopback;
+		_loopbackLastIndex = 0;
+	}
+
+	Peer NetworkManagerBase::ConnectLoopbackPeer(std::uint32_t clientData)
+	{
+		DEATH_ASSERT(_loopback != nullptr, "Loopback session is not active", nullptr);
+
+		Peer peer = Peer::Loopback(++_loopbackLastIndex);
+		ConnectionResult result = OnPeerConnected(peer, clientData);
+		if DEATH_UNLIKELY(!result.IsSuccessful()) {
+			_loopback->OnLoopbackDisconnected(peer, result.FailureReason);
+			return nullptr;
+		}
+
+		std::unique_lock lock(_lock);
+		_connectedPeers.push_back(peer);
+		return peer;
+	}
+
+	void NetworkManagerBase::ReceiveFromLoopbackPeer(const Peer& peer, NetworkChannel channel, std::uint8_t packetType, ArrayView<const std::uint8_t> data)
+	{
+		if DEATH_LIKELY(_loopback != nullptr && _handler != nullptr) {
+			_handler->OnPacketReceived(peer, std::uint8_t(channel), packetType, data);
+		}
+	}
+
+	void NetworkManagerBase::ServiceLoopback()
+	{
+		if (_loopback == nullptr) {
+			return;
+		}
+
+		SmallVector<Pair<Peer, Reason>, 0> kicks;
+		{
+			std::unique_lock lock(_lock);
+			kicks = std::move(_loopbackKicks);
+			_loopbackKicks.clear();
+		}
+
+		for (auto& [peer, reason] : kicks) {
+			bool connected = false;
+			{
+				std::unique_lock lock(_lock);
+				for (const Peer& p : _connectedPeers) {
+					if (p == peer) {
+						connected = true;
+						break;
+					}
+				}
+			}
+			// A peer can be kicked more than once before the disconnection is delivered
+			if (connected) {
+				OnPeerDisconnected(peer, reason);
+				_loopback->OnLoopbackDisconnected(peer, reason);
+			}
+		}
+	}
+
+	void NetworkManagerBase::SendToLoopbackPeer(const Peer& peer, NetworkChannel channel, std::uint8_t packetType, ArrayView<const std::uint8_t> data)
+	{
+		// Loopback session is server-only, so there is no remote server to send to
+		if (peer == nullptr) {
+			return;
+		}
+
+		bool connected = false;
+		{
+			std::unique_lock lock(_lock);
+			for (const Peer& p : _connectedPeers) {
+				if (p == peer) {
+					connected = true;
+					break;
+				}
+			}
+		}
+		if (connected) {
+			_loopback->OnLoopbackPacket(peer, channel, packetType, data);
+		}
+	}
+
+	void NetworkManagerBase::SendToLoopbackPeers(Function<bool(const Peer&)>&& predicate, NetworkChannel channel, std::uint8_t packetType, ArrayView<const std::uint8_t> data)
+	{
+		// See SendTo() for why the predicate is evaluated without holding _lock
+		SmallVector<Peer, 16> targets;
+		{
+			std::unique_lock lock(_lock);
+			targets.assign(_connectedPeers.begin(), _connectedPeers.end());
+		}
+
+		for (const Peer& p : targets) {
+			if (!predicate || predicate(p)) {
+				_loopback->OnLoopbackPacket(p, channel, packetType, data);
+			}
+		}
+	}
+#endif
+
 	void NetworkManagerBase::Dispose()
 	{
+#if !defined(DEATH_TARGET_EMSCRIPTEN)
+		if (_loopback != nullptr) {
+			std::unique_lock lock(_lock);
+			_loopback = nullptr;
+			_loopbackKicks.clear();
+			_connectedPeers.clear();
+			_state = NetworkState::None;
+			_handler = nullptr;
+			return;
+		}
+#endif
+
 #if defined(WITH_ONLINE_MULTIPLAYER)
 #	if defined(DEATH_TARGET_EMSCRIPTEN) && defined(WITH_WEBSOCKET)
 		if (_emWsSocket <= 0) {
@@ -414,6 +542,8 @@ namespace Jazz2::Multiplayer
 		_thread.Join();
 
 		_host = nullptr;
+		// The network thread is gone, so anything queued after its last flush can be dropped from here
+		DiscardOutgoingQueue();
 #	endif
 #endif
 
@@ -451,6 +581,9 @@ namespace Jazz2::Multiplayer
 #if defined(DEATH_TARGET_EMSCRIPTEN) || !defined(WITH_ONLINE_MULTIPLAYER)
 		return 0;
 #else
+		if DEATH_UNLIKELY(_loopback != nullptr) {
+			return 0;
+		}
 #	if defined(WITH_WEBSOCKET)
 		if DEATH_UNLIKELY(peer.IsWebSocket()) {
 			std::unique_lock<Spinlock> lock(_wsLock);
@@ -472,6 +605,10 @@ namespace Jazz2::Multiplayer
 		return {};
 #else
 		Array<String> result;
+		if (_loopback != nullptr) {
+			// Loopback session has no endpoints
+			return result;
+		}
 
 		// _host and _connectedPeers are torn down by the network thread under _lock
 		std::unique_lock lock(_lock);
@@ -599,6 +736,10 @@ namespace Jazz2::Multiplayer
 		// Creating a server is not supported on Emscripten
 		return 0;
 #else
+		if (_loopback != nullptr) {
+			return 0;
+		}
+
 		// _host and _connectedPeers are torn down by the network thread under _lock
 		std::unique_lock lock(_lock);
 		if (_state == NetworkState::Listening && _host != nullptr) {
@@ -621,6 +762,12 @@ namespace Jazz2::Multiplayer
 			// Local session has no peers to send to
 			return;
 		}
+#if !defined(DEATH_TARGET_EMSCRIPTEN)
+		if DEATH_UNLIKELY(_loopback != nullptr) {
+			SendToLoopbackPeer(peer, channel, packetType, data);
+			return;
+		}
+#endif
 #if defined(WITH_ONLINE_MULTIPLAYER)
 #	if defined(DEATH_TARGET_EMSCRIPTEN) && defined(WITH_WEBSOCKET)
 		if DEATH_LIKELY(_emWsSocket > 0) {
@@ -648,11 +795,18 @@ namespace Jazz2::Multiplayer
 
 		ENetPacket* packet = enet_packet_create(packetType, data.data(), data.size(), flags);
 
+		if (ShouldEnqueueOutgoing()) {
+			ENetPeer* target = peer._enet;
+			EnqueueOutgoing({ &target, 1 }, channel, packet, 0);
+			return;
+		}
+
 		bool success = false;
 		{
 			// The target is resolved under the lock too, so the network thread can't tear down
 			// _connectedPeers/_host between the check and the send
 			std::unique_lock lock(_lock);
+			FlushOutgoingQueue();
 			ENetPeer* target;
 			if (peer == nullptr) {
 				target = (_state == NetworkState::Connected && !_connectedPeers.empty()
@@ -681,6 +835,12 @@ namespace Jazz2::Multiplayer
 			// Local session has no peers to send to
 			return;
 		}
+#if !defined(DEATH_TARGET_EMSCRIPTEN)
+		if DEATH_UNLIKELY(_loopback != nullptr) {
+			SendToLoopbackPeers(std::move(predicate), channel, packetType, data);
+			return;
+		}
+#endif
 #if defined(WITH_ONLINE_MULTIPLAYER)
 #	if defined(DEATH_TARGET_EMSCRIPTEN) && defined(WITH_WEBSOCKET)
 		if DEATH_LIKELY(_emWsSocket > 0) {
@@ -730,8 +890,17 @@ namespace Jazz2::Multiplayer
 
 		ENetPacket* enetPacket = nullptr;
 		bool enetPacketSent = false;
-		if (!enetTargets.empty()) {
+		if (!enetTargets.empty() && ShouldEnqueueOutgoing()) {
+			// The network thread re-checks that the peers are still connected when the packet is sent
+			SmallVector<ENetPeer*, 16> enetPeers;
+			for (const Peer& p : enetTargets) {
+				enetPeers.push_back(p._enet);
+			}
+			EnqueueOutgoing(enetPeers, channel, enet_packet_create(packetType, data.data(), data.size(), flags),
+				OutgoingCommand::CheckConnected);
+		} else if (!enetTargets.empty()) {
 			std::unique_lock lock(_lock);
+			FlushOutgoingQueue();
 			for (const Peer& p : enetTargets) {
 				// Re-check the peer is still connected - it may have been torn down while the predicate ran unlocked
 				bool stillConnected = false;
@@ -784,6 +953,12 @@ namespace Jazz2::Multiplayer
 			// Local session has no peers to send to
 			return;
 		}
+#if !defined(DEATH_TARGET_EMSCRIPTEN)
+		if DEATH_UNLIKELY(_loopback != nullptr) {
+			SendToLoopbackPeers(nullptr, channel, packetType, data);
+			return;
+		}
+#endif
 #if defined(WITH_ONLINE_MULTIPLAYER)
 #	if defined(DEATH_TARGET_EMSCRIPTEN) && defined(WITH_WEBSOCKET)
 		if DEATH_LIKELY(_emWsSocket > 0) {
@@ -802,6 +977,13 @@ namespace Jazz2::Multiplayer
 			flags = ENET_PACKET_FLAG_UNSEQUENCED;
 		}
 
+		if (ShouldEnqueueOutgoing()) {
+			// The network thread sends it to all peers, including WebSocket ones
+			EnqueueOutgoing({}, channel, enet_packet_create(packetType, data.data(), data.size(), flags),
+				OutgoingCommand::Broadcast);
+			return;
+		}
+
 		ENetPacket* enetPacket = nullptr;
 		bool enetPacketSent = false;
 #		if defined(WITH_WEBSOCKET)
@@ -810,6 +992,7 @@ namespace Jazz2::Multiplayer
 
 		{
 			std::unique_lock lock(_lock);
+			FlushOutgoingQueue();
 			for (const Peer& p : _connectedPeers) {
 #		if defined(WITH_WEBSOCKET)
 				if DEATH_UNLIKELY(p.IsWebSocket()) {
@@ -852,12 +1035,178 @@ namespace Jazz2::Multiplayer
 #endif
 	}
 
+	void NetworkManagerBase::SendTo(const Peer& peer, NetworkChannel channel, OutgoingPacket&& packet)
+	{
+		if DEATH_UNLIKELY(_state == NetworkState::Local || !packet.IsValid()) {
+			return;
+		}
+#if !defined(DEATH_TARGET_EMSCRIPTEN)
+		if DEATH_UNLIKELY(_loopback != nullptr) {
+			// The packet buffer is released when it goes out of scope
+			SendToLoopbackPeer(peer, channel, packet.GetPacketType(), packet.GetPayload());
+			return;
+		}
+#endif
+#if defined(WITH_ONLINE_MULTIPLAYER)
+#	if defined(DEATH_TARGET_EMSCRIPTEN)
+		SendTo(peer, channel, packet.GetPacketType(), packet.GetPayload());
+#	else
+#		if defined(WITH_WEBSOCKET)
+		if DEATH_UNLIKELY(peer.IsWebSocket()) {
+			SendToWsPeer(peer._ws, packet.GetPacketType(), packet.GetPayload());
+			return;
+		}
+#		endif
+
+		ENetPacket* enetPacket = packet.Release(channel == NetworkChannel::Main
+			? ENET_PACKET_FLAG_RELIABLE : ENET_PACKET_FLAG_UNSEQUENCED);
+
+		if (ShouldEnqueueOutgoing()) {
+			ENetPeer* target = peer._enet;
+			EnqueueOutgoing({ &target, 1 }, channel, enetPacket, 0);
+			return;
+		}
+
+		bool success = false;
+		{
+			std::unique_lock lock(_lock);
+			FlushOutgoingQueue();
+			ENetPeer* target;
+			if (peer == nullptr) {
+				target = (_state == NetworkState::Connected && !_connectedPeers.empty()
+#		if defined(WITH_WEBSOCKET)
+					&& !_connectedPeers[0].IsWebSocket()
+#		endif
+					? _connectedPeers[0]._enet : nullptr);
+			} else {
+				target = peer._enet;
+			}
+			if DEATH_LIKELY(target != nullptr) {
+				success = enet_peer_send(target, std::uint8_t(channel), enetPacket) >= 0;
+			}
+		}
+
+		if DEATH_UNLIKELY(!success) {
+			enet_packet_destroy(enetPacket);
+		}
+#	endif
+#endif
+	}
+
+	void NetworkManagerBase::SendTo(Function<bool(const Peer&)>&& predicate, NetworkChannel channel, OutgoingPacket&& packet)
+	{
+		if DEATH_UNLIKELY(_state == NetworkState::Local || !packet.IsValid()) {
+			return;
+		}
+#if !defined(DEATH_TARGET_EMSCRIPTEN)
+		if DEATH_UNLIKELY(_loopback != nullptr) {
+			SendToLoopbackPeers(std::move(predicate), channel, packet.GetPacketType(), packet.GetPayload());
+			return;
+		}
+#endif
+#if defined(WITH_ONLINE_MULTIPLAYER)
+#	if defined(DEATH_TARGET_EMSCRIPTEN)
+		SendTo(std::move(predicate), channel, packet.GetPacketType(), packet.GetPayload());
+#	else
+		// See the ArrayView overload for why the predicate is evaluated without holding _lock
+		SmallVector<Peer, 16> targets;
+		{
+			std::unique_lock lock(_lock);
+			targets.assign(_connectedPeers.begin(), _connectedPeers.end());
+		}
+
+		SmallVector<Peer, 16> enetTargets;
+#		if defined(WITH_WEBSOCKET)
+		SmallVector<ix::WebSocket*, 16> wsTargets;
+#		endif
+		for (const Peer& p : targets) {
+			if (predicate(p)) {
+#		if defined(WITH_WEBSOCKET)
+				if DEATH_UNLIKELY(p.IsWebSocket()) {
+					wsTargets.push_back(p._ws);
+				} else
+#		endif
+				{
+					enetTargets.push_back(p);
+				}
+			}
+		}
+
+#		if defined(WITH_WEBSOCKET)
+		// WebSocket peers need their own copy, so they must be served before the buffer is handed over to ENet
+		for (ix::WebSocket* ws : wsTargets) {
+			SendToWsPeer(ws, packet.GetPacketType(), packet.GetPayload());
+		}
+#		endif
+
+		if (enetTargets.empty()) {
+			return;
+		}
+
+		// All recipients share the same reference-counted buffer
+		ENetPacket* enetPacket = packet.Release(channel == NetworkChannel::Main
+			? ENET_PACKET_FLAG_RELIABLE : ENET_PACKET_FLAG_UNSEQUENCED);
+
+		if (ShouldEnqueueOutgoing()) {
+			SmallVector<ENetPeer*, 16> enetPeers;
+			for (const Peer& p : enetTargets) {
+				enetPeers.push_back(p._enet);
+			}
+			EnqueueOutgoing(enetPeers, channel, enetPacket, OutgoingCommand::CheckConnected);
+			return;
+		}
+
+		bool enetPacketSent = false;
+		{
+			std::unique_lock lock(_lock);
+			FlushOutgoingQueue();
+			for (const Peer& p : enetTargets) {
+				bool stillConnected = false;
+				for (const Peer& c : _connectedPeers) {
+					if (c == p) {
+						stillConnected = true;
+						break;
+					}
+				}
+				if DEATH_LIKELY(stillConnected && enet_peer_send(p._enet, std::uint8_t(channel), enetPacket) >= 0) {
+					enetPacketSent = true;
+				}
+			}
+		}
+
+		if (!enetPacketSent) {
+			enet_packet_destroy(enetPacket);
+		}
+#	endif
+#endif
+	}
+
+	void NetworkManagerBase::SendTo(AllPeersT, NetworkChannel channel, OutgoingPacket&& packet)
+	{
+#if defined(WITH_ONLINE_MULTIPLAYER) && !defined(DEATH_TARGET_EMSCRIPTEN)
+		if (ShouldEnqueueOutgoing() && packet.IsValid()) {
+			EnqueueOutgoing({}, channel, packet.Release(channel == NetworkChannel::Main
+				? ENET_PACKET_FLAG_RELIABLE : ENET_PACKET_FLAG_UNSEQUENCED), OutgoingCommand::Broadcast);
+			return;
+		}
+#endif
+		SendTo([](const Peer&) { return true; }, channel, std::move(packet));
+	}
+
 	void NetworkManagerBase::Kick(const Peer& peer, Reason reason)
 	{
 		if DEATH_UNLIKELY(_state == NetworkState::Local) {
 			// Local session has no peers to kick
 			return;
 		}
+#if !defined(DEATH_TARGET_EMSCRIPTEN)
+		if DEATH_UNLIKELY(_loopback != nullptr) {
+			// Kicks are usually requested from packet handlers, so the disconnection is deferred to ServiceLoopback()
+			std::unique_lock lock(_lock);
+			_loopbackKicks.emplace_back(peer, reason);
+			return;
+		}
+#endif
 #if defined(WITH_ONLINE_MULTIPLAYER)
 #	if defined(WITH_WEBSOCKET) && !defined(DEATH_TARGET_EMSCRIPTEN)
 		if DEATH_UNLIKELY(peer.IsWebSocket()) {
@@ -872,13 +1221,164 @@ namespace Jazz2::Multiplayer
 #	endif
 #	if !defined(DEATH_TARGET_EMSCRIPTEN)
 		if DEATH_LIKELY(peer != nullptr) {
+			if (ShouldEnqueueOutgoing()) {
+				// Queued too, so packets sent before the kick still go out before the disconnect
+				OutgoingCommand command;
+				command.Target = peer._enet;
+				command.Reason = std::uint32_t(reason);
+				command.Flags = OutgoingCommand::Disconnect;
+				while DEATH_UNLIKELY(!_outgoingQueue.TryPush(std::move(command))) {
+					if (!_outgoingQueueActive.load(std::memory_order_acquire)) {
+						return;
+					}
+					Thread::YieldExecution();
+				}
+				return;
+			}
+
 			std::unique_lock lock(_lock);
+			FlushOutgoingQueue();
 			enet_peer_disconnect(peer._enet, std::uint32_t(reason));
 		}
 #	endif
 #endif
 	}
 
+	NetworkQueueStats NetworkManagerBase::GetQueueStats() const
+	{
+		NetworkQueueStats stats{};
+#if defined(WITH_ONLINE_MULTIPLAYER) && !defined(DEATH_TARGET_EMSCRIPTEN)
+		stats.OutgoingQueued = _outgoingQueued.load(std::memory_order_relaxed);
+		stats.OutgoingDropped = _outgoingDropped.load(std::memory_order_relaxed);
+		stats.OutgoingStalls = _outgoingStalls.load(std::memory_order_relaxed);
+		stats.OutgoingPeakDepth = _outgoingPeakDepth.load(std::memory_order_relaxed);
+#	if defined(WITH_WEBSOCKET)
+		stats.InboundStalls = _inboundStalls.load(std::memory_order_relaxed);
+#	endif
+#endif
+		return stats;
+	}
+
+#if defined(WITH_ONLINE_MULTIPLAYER) && !defined(DEATH_TARGET_EMSCRIPTEN)
+	bool NetworkManagerBase::ShouldEnqueueOutgoing() const
+	{
+		// Sends from the network thread itself (packet handlers) and from other threads take the locked path
+		return (_outgoingQueueActive.load(std::memory_order_acquire) && Thread::GetCurrentId() == _gameThreadId);
+	}
+
+	void NetworkManagerBase::EnqueueOutgoing(ArrayView<ENetPeer* const> targets, NetworkChannel channel, ENetPacket* packet, std::uint8_t flags)
+	{
+		std::uint32_t count = std::max(std::uint32_t(targets.size()), 1u);
+
+		// All commands of the packet are pushed at once, so it's never released while some of them are missing
+		if DEATH_UNLIKELY(_outgoingQueue.GetFreeCount() < count) {
+			if (channel != NetworkChannel::Main) {
+				// Unreliable packets can be lost anyway, so drop it rather than wait for the network thread
+				_outgoingDropped.fetch_add(1, std::memory_order_relaxed);
+				enet_packet_destroy(packet);
+				return;
+			}
+
+			// Reliable packets must not be lost or reordered, wait until the network thread catches up
+			_outgoingStalls.fetch_add(1, std::memory_order_relaxed);
+			do {
+				if (!_outgoingQueueActive.load(std::memory_order_acquire)) {
+					enet_packet_destroy(packet);
+					return;
+				}
+				Thread::YieldExecution();
+			} while (_outgoingQueue.GetFreeCount() < count);
+		}
+
+		for (std::uint32_t i = 0; i < count; i++) {
+			OutgoingCommand command;
+			command.Target = (i < targets.size() ? targets[i] : nullptr);
+			command.Packet = packet;
+			command.Channel = std::uint8_t(channel);
+			command.Flags = flags | (i == count - 1 ? OutgoingCommand::ReleasePacket : 0);
+			_outgoingQueue.TryPush(std::move(command));
+		}
+
+		_outgoingQueued.fetch_add(1, std::memory_order_relaxed);
+		std::uint32_t depth = _outgoingQueue.GetCount();
+		if DEATH_UNLIKELY(depth > _outgoingPeakDepth.load(std::memory_order_relaxed)) {
+			_outgoingPeakDepth.store(depth, std::memory_order_relaxed);
+		}
+	}
+
+	void NetworkManagerBase::ProcessOutgoingQueue()
+	{
+		OutgoingCommand command;
+		while (_outgoingQueue.TryPop(command)) {
+			if DEATH_UNLIKELY(command.Flags & OutgoingCommand::Disconnect) {
+				enet_peer_disconnect(command.Target, command.Reason);
+				continue;
+			}
+
+			if (command.Flags & OutgoingCommand::Broadcast) {
+				for (const Peer& p : _connectedPeers) {
+#	if defined(WITH_WEBSOCKET)
+					if DEATH_UNLIKELY(p.IsWebSocket()) {
+						SendToWsPeer(p._ws, command.Packet->data[0],
+							arrayView(command.Packet->data + 1, command.Packet->dataLength - 1));
+						continue;
+					}
+#	endif
+					enet_peer_send(p._enet, command.Channel, command.Packet);
+				}
+			} else {
+				ENetPeer* target = command.Target;
+				if (target == nullptr) {
+					target = (_state == NetworkState::Connected && !_connectedPeers.empty()
+#	if defined(WITH_WEBSOCKET)
+						&& !_connectedPeers[0].IsWebSocket()
+#	endif
+						? _connectedPeers[0]._enet : nullptr);
+				} else if (command.Flags & OutgoingCommand::CheckConnected) {
+					// The peer may have been torn down since the game thread evaluated the predicate
+					bool stillConnected = false;
+					for (const Peer& c : _connectedPeers) {
+						if (c == Peer(target)) {
+							stillConnected = true;
+							break;
+						}
+					}
+					if DEATH_UNLIKELY(!stillConnected) {
+						target = nullptr;
+					}
+				}
+				if DEATH_LIKELY(target != nullptr) {
+					enet_peer_send(target, command.Channel, command.Packet);
+				}
+			}
+
+			// ENet holds its own references to the packet once it's queued for sending
+			if ((command.Flags & OutgoingCommand::ReleasePacket) && command.Packet->referenceCount == 0) {
+				enet_packet_destroy(command.Packet);
+			}
+		}
+	}
+
+	void NetworkManagerBase::FlushOutgoingQueue()
+	{
+		// Direct sends (from packet handlers on the network thread or from other threads) must not overtake packets
+		// the game thread queued earlier. Consumers are serialized by _lock, so the queue can be drained from here too.
+		if (_outgoingQueueActive.load(std::memory_order_acquire)) {
+			ProcessOutgoingQueue();
+		}
+	}
+
+	void NetworkManagerBase::DiscardOutgoingQueue()
+	{
+		OutgoingCommand command;
+		while (_outgoingQueue.TryPop(command)) {
+			if ((command.Flags & OutgoingCommand::ReleasePacket) && command.Packet->referenceCount == 0) {
+				enet_packet_destroy(command.Packet);
+			}
+		}
+	}
+#endif
+
 
 	String NetworkManagerBase::AddressToString(const struct in_addr& address, std::uint16_t port)
 	{
@@ -964,6 +1464,9 @@ namespace Jazz2::Multiplayer
 #if defined(DEATH_TARGET_EMSCRIPTEN) && defined(WITH_WEBSOCKET)
 		return ExtractHostFromWsUrl(_emWsUrl);
 #else
+		if DEATH_UNLIKELY(_loopback != nullptr) {
+			return "loopback"_s;
+		}
 #	if defined(WITH_WEBSOCKET)
 		if DEATH_UNLIKELY(peer.IsWebSocket()) {
 			std::unique_lock<Spinlock> lock(_wsLock);
@@ -1309,21 +1812,20 @@ namespace Jazz2::Multiplayer
 				{
 					std::unique_lock<Spinlock> lock(_wsLock);
 					_wsPeers.emplace(&ws, WsPeerInfo{String(remoteIp.data(), remoteIp.size()), 0});
-					_wsPendingEvents.push_back({WsQueuedEvent::Type::Open, &ws, {}, peerClientData, 0});
 				}
+				PushWsServerEvent({WsQueuedEvent::Type::Open, &ws, {}, peerClientData, 0});
 				LOGD("WebSocket client connected [{}] from {}", Peer::FromWebSocket(&ws), StringView{remoteIp});
 
 			} else if (msg->type == ix::WebSocketMessageType::Close) {
 				{
 					std::unique_lock<Spinlock> lock(_wsLock);
 					_wsPeers.erase(&ws);
-					_wsPendingEvents.push_back({WsQueuedEvent::Type::Close, &ws, {}, 0, std::uint16_t(msg->closeInfo.code)});
 				}
+				PushWsServerEvent({WsQueuedEvent::Type::Close, &ws, {}, 0, std::uint16_t(msg->closeInfo.code)});
 				LOGD("WebSocket client disconnected [{}]", Peer::FromWebSocket(&ws));
 			} else if (msg->type == ix::WebSocketMessageType::Message && msg->binary) {
 				if (!msg->str.empty()) {
-					std::unique_lock<Spinlock> lock(_wsLock);
-					_wsPendingEvents.push_back({WsQueuedEvent::Type::Message, &ws, msg->str});
+					PushWsServerEvent({WsQueuedEvent::Type::Message, &ws, msg->str});
 				}
 
 			} else if (msg->type == ix::WebSocketMessageType::Error) {
@@ -1342,15 +1844,39 @@ namespace Jazz2::Multiplayer
 		return true;
 	}
 
-	void NetworkManagerBase::ProcessWsQueue(INetworkHandler* handler)
+	void NetworkManagerBase::PushWsClientEvent(WsQueuedEvent&& ev)
 	{
-		SmallVector<WsQueuedEvent, 0> pending;
-		{
-			std::unique_lock<Spinlock> lock(_wsLock);
-			std::swap(pending, _wsPendingEvents);
+		if DEATH_UNLIKELY(!_wsClientEvents.TryPush(std::move(ev))) {
+			// The queue is full, wait for the client thread to catch up
+			_inboundStalls.fetch_add(1, std::memory_order_relaxed);
+			do {
+				if (_state == NetworkState::None) {
+					return;
+				}
+				Thread::YieldExecution();
+			} while (!_wsClientEvents.TryPush(std::move(ev)));
 		}
+	}
 
-		for (auto& ev : pending) {
+	void NetworkManagerBase::PushWsServerEvent(WsQueuedEvent&& ev)
+	{
+		// Server connections run on separate threads each, so they push into a multi-producer queue
+		if DEATH_UNLIKELY(!_wsServerEvents.TryPush(std::move(ev))) {
+			// The queue is full, wait for the server thread to catch up
+			_inboundStalls.fetch_add(1, std::memory_order_relaxed);
+			do {
+				if (_state == NetworkState::None) {
+					return;
+				}
+				Thread::YieldExecution();
+			} while (!_wsServerEvents.TryPush(std::move(ev)));
+		}
+	}
+
+	void NetworkManagerBase::ProcessWsQueue(INetworkHandler* handler)
+	{
+		WsQueuedEvent ev;
+		while (_wsServerEvents.TryPop(ev)) {
 			switch (ev.type) {
 				case WsQueuedEvent::Type::Open: {
 					Peer wsPeer = Peer::FromWebSocket(ev.peer);
@@ -1440,13 +1966,8 @@ namespace Jazz2::Multiplayer
 		while (_this->_state != NetworkState::None) {
 			Thread::Sleep(ProcessingIntervalMs);
 
-			SmallVector<WsQueuedEvent, 0> pending;
-			{
-				std::unique_lock<Spinlock> lock(_this->_wsLock);
-				std::swap(pending, _this->_wsPendingEvents);
-			}
-
-			for (auto& ev : pending) {
+			WsQueuedEvent ev;
+			while (_this->_wsClientEvents.TryPop(ev)) {
 				switch (ev.type) {
 					case WsQueuedEvent::Type::Open: {
 						wasConnected = true;
@@ -1515,6 +2036,12 @@ namespace Jazz2::Multiplayer
 			_this->OnPeerDisconnected({}, disconnectReason);
 		}
 
+		// This thread is the only consumer of the queue, so the connection is stopped and its remaining events
+		// are dropped here, before a new client can be created
+		_this->_wsClient->stop();
+		WsQueuedEvent staleEvent;
+		while (_this->_wsClientEvents.TryPop(staleEvent)) {}
+
 		_this->_wsRtt.store(0, std::memory_order_relaxed);
 		_this->_handler = nullptr;
 		_this->_thread.Detach();
@@ -1589,6 +2116,8 @@ namespace Jazz2::Multiplayer
 			reason = Reason::ConnectionTimedOut;
 		} else {
 			_this->_state = NetworkState::Connected;
+			_this->DiscardOutgoingQueue();
+			_this->_outgoingQueueActive.store(true, std::memory_order_release);
 			_this->OnPeerConnected(ev.peer, ev.data);
 			reason = Reason::Unknown;
 
@@ -1596,6 +2125,7 @@ namespace Jazz2::Multiplayer
 				std::int32_t result;
 				{
 					std::unique_lock lock(_this->_lock);
+					_this->ProcessOutgoingQueue();
 					result = enet_host_service(host, &ev, 0);
 				}
 
@@ -1644,6 +2174,8 @@ namespace Jazz2::Multiplayer
 		{
 			// Serialize the teardown with the main-thread send paths, which use _connectedPeers/_host under _lock
 			std::unique_lock lock(_this->_lock);
+			_this->_outgoingQueueActive.store(false, std::memory_order_release);
+			_this->DiscardOutgoingQueue();
 			for (const Peer& p : _this->_connectedPeers) {
 				enet_peer_disconnect_now(p._enet, (std::uint32_t)Reason::Disconnected);
 			}
@@ -1668,12 +2200,15 @@ namespace Jazz2::Multiplayer
 		ENetHost* host = _this->_host;
 
 		_this->_connectedPeers.reserve(16);
+		_this->DiscardOutgoingQueue();
+		_this->_outgoingQueueActive.store(true, std::memory_order_release);
 
 		ENetEvent ev{};
 		while DEATH_LIKELY(_this->_state != NetworkState::None) {
 			std::int32_t result;
 			{
 				std::unique_lock lock(_this->_lock);
+				_this->ProcessOutgoingQueue();
 				result = enet_host_service(host, &ev, 0);
 			}
 
@@ -1698,6 +2233,8 @@ namespace Jazz2::Multiplayer
 					ENetAddress addr = host->address;
 					{
 						std::unique_lock lock(_this->_lock);
+						// Queued commands may still reference peers of the old host
+						_this->DiscardOutgoingQueue();
 						enet_host_destroy(host);
 						host = enet_host_create(&addr, MaxPeerCount, std::size_t(NetworkChannel::Count), 0, 0);
 						_this->_host = host;
@@ -1766,6 +2303,8 @@ namespace Jazz2::Multiplayer
 		{
 			// Serialize the teardown with the main-thread send paths, which use _connectedPeers/_host under _lock
 			std::unique_lock lock(_this->_lock);
+			_this->_outgoingQueueActive.store(false, std::memory_order_release);
+			_this->DiscardOutgoingQueue();
 			for (const Peer& p : _this->_connectedPeers) {
 #		if defined(WITH_WEBSOCKET)
 				if DEATH_LIKELY(!p.IsWebSocket())
@@ -1793,8 +2332,10 @@ namespace Jazz2::Multiplayer
 		{
 			std::unique_lock<Spinlock> lock(_this->_wsLock);
 			_this->_wsPeers.clear();
-			_this->_wsPendingEvents.clear();
 		}
+		// All connections are stopped, so nothing can be pushed anymore and this thread is still the only consumer
+		WsQueuedEvent staleEvent;
+		while (_this->_wsServerEvents.TryPop(staleEvent)) {}
 #		endif
 
 		_this->_thread.Detach();
@@ -3,14 +3,18 @@
 #if defined(WITH_MULTIPLAYER) || defined(DOXYGEN_GENERATING_OUTPUT)
 
 #include "ConnectionResult.h"
+#include "OutgoingPacket.h"
 #include "Peer.h"
 #include "Reason.h"
 #include "ServerDiscovery.h"
+#include "../../nCine/Threading/MpscQueue.h"
+#include "../../nCine/Threading/SpscQueue.h"
 #include "../../nCine/Threading/Thread.h"
 #include "../../nCine/Threading/ThreadSync.h"
 
 #include <Base/IDisposable.h>
 #include <Containers/Function.h>
+#include <Containers/Pair.h>
 #include <Containers/SmallVector.h>
 #include <Containers/StringView.h>
 #include <IO/MemoryStream.h>
@@ -27,6 +31,7 @@
 
 #if !defined(DEATH_TARGET_EMSCRIPTEN)
 struct _ENetHost;
+struct _ENetPacket;
 #endif
 
 using namespace Death::Containers;
@@ -36,6 +41,7 @@ using namespace nCine;
 
 namespace Jazz2::Multiplayer
 {
+	class ILoopbackHandler;
 	class INetworkHandler;
 
 	/**
@@ -95,6 +101,23 @@ namespace Jazz2::Multiplayer
 	*/
 	constexpr AllPeersT AllPeers{AllPeersT::Init{}};
 
+	/**
+		@brief Backpressure counters of the queues between the game thread and the network thread
+	*/
+	struct NetworkQueueStats
+	{
+		/** @brief Number of packets handed over to the network thread */
+		std::uint64_t OutgoingQueued;
+		/** @brief Number of unreliable packets dropped because the outgoing queue was full */
+		std::uint64_t OutgoingDropped;
+		/** @brief Number of reliable packets that had to wait for free space in the outgoing queue */
+		std::uint64_t OutgoingStalls;
+		/** @brief Number of received WebSocket events that had to wait for free space in the inbound queue */
+		std::uint64_t InboundStalls;
+		/** @brief Highest observed number of commands in the outgoing queue */
+		std::uint32_t OutgoingPeakDepth;
+	};
+
 	/**
 		@brief Local peer tag
 	*/
@@ -151,8 +174,25 @@ namespace Jazz2::Multiplayer
 		void SendTo(Function<bool(const Peer&)>&& predicate, NetworkChannel channel, std::uint8_t packetType, ArrayView<const std::uint8_t> data);
 		/** @brief Sends a packet to all connected peers or the remote server peer */
 		void SendTo(AllPeersT, NetworkChannel channel, std::uint8_t packetType, ArrayView<const std::uint8_t> data);
+		/** @brief Sends a packet to a given peer without copying its payload, the packet is consumed */
+		void SendTo(const Peer& peer, NetworkChannel channel, OutgoingPacket&& packet);
+		/** @brief Sends a packet to all connected peers that match a given predicate without copying its payload, the packet is consumed */
+		void SendTo(Function<bool(const Peer&)>&& predicate, NetworkChannel channel, OutgoingPacket&& packet);
+		/** @brief Sends a packet to all connected peers or the remote server peer without copying its payload, the packet is consumed */
+		void SendTo(AllPeersT, NetworkChannel channel, OutgoingPacket&& packet);
 		/** @brief Kicks a given peer from the server */
 		void Kick(const Peer& peer, Reason reason);
+		/** @brief Returns backpressure counters of the queues between the game thread and the network thread */
+		NetworkQueueStats GetQueueStats() const;
+
+#if !defined(DEATH_TARGET_EMSCRIPTEN) || defined(DOXYGEN_GENERATING_OUTPUT)
+		/** @brief Connects a new loopback peer to the loopback session, returns an empty peer if it was rejected */
+		Peer ConnectLoopbackPeer(std::uint32_t clientData);
+		/** @brief Delivers a packet from the specified loopback peer as if it was received from the network */
+		void ReceiveFromLoopbackPeer(const Peer& peer, NetworkChannel channel, std::uint8_t packetType, ArrayView<const std::uint8_t> data);
+		/** @brief Disconnects loopback peers that were kicked since the last call, should be called once per frame */
+		void ServiceLoopback();
+#endif
 
 		/** @brief Converts the specified IPv4 endpoint to the string representation */
 		static String AddressToString(const struct in_addr& address, std::uint16_t port = 0);
@@ -186,6 +226,17 @@ namespace Jazz2::Multiplayer
 		 */
 		void CreateLocalSession(INetworkHandler* handler);
 
+#if !defined(DEATH_TARGET_EMSCRIPTEN) || defined(DOXYGEN_GENERATING_OUTPUT)
+		/**
+		 * @brief Puts the manager into a listening state served by an in-process loopback transport
+		 *
+		 * No socket is bound and no background thread is started. Peers are connected with @ref ConnectLoopbackPeer(),
+		 * packets addressed to them are handed over to @p loopback instead of being sent, and their packets are
+		 * injected with @ref ReceiveFromLoopbackPeer(). Used to load the server without any network.
+		 */
+		void CreateLoopbackSession(INetworkHandler* handler, ILoopbackHandler* loopback);
+#endif
+
 		/** @brief Called when a peer connects to the local server or the local client connects to a server */
 		virtual ConnectionResult OnPeerConnected(const Peer& peer, std::uint32_t clientData);
 		/** @brief Called when a peer disconnects from the local server or the local client disconnects from a server */
@@ -203,6 +254,9 @@ namespace Jazz2::Multiplayer
 		_ENetHost* _host;
 		Thread _thread;
 		SmallVector<Peer, 1> _connectedPeers;
+		ILoopbackHandler* _loopback;
+		SmallVector<Pair<Peer, Reason>, 0> _loopbackKicks;	// Guarded by _lock
+		std::uint32_t _loopbackLastIndex;
 #	if defined(WITH_ONLINE_MULTIPLAYER)
 		SmallVector<ENetAddress, 0> _desiredEndpoints;
 #	endif
@@ -212,6 +266,47 @@ namespace Jazz2::Multiplayer
 		INetworkHandler* _handler;
 		mutable Spinlock _lock;
 
+#if defined(WITH_ONLINE_MULTIPLAYER) && !defined(DEATH_TARGET_EMSCRIPTEN)
+		/** @brief ENet send queued by the game thread and executed by the network thread */
+		struct OutgoingCommand {
+			enum : std::uint8_t {
+				Broadcast = 0x01,		/**< Send to all connected peers, @ref Target is ignored */
+				CheckConnected = 0x02,	/**< Skip the target if it's no longer in the list of connected peers */
+				ReleasePacket = 0x04,	/**< Last command referencing the packet, destroy it if it wasn't sent */
+				Disconnect = 0x08		/**< Disconnect the target with @ref Reason instead of sending a packet */
+			};
+
+			_ENetPeer* Target = nullptr;	/**< Target peer, `nullptr` for the remote server */
+			_ENetPacket* Packet = nullptr;
+			std::uint32_t Reason = 0;
+			std::uint8_t Channel = 0;
+			std::uint8_t Flags = 0;
+		};
+
+		static constexpr std::uint32_t OutgoingQueueCapacity = 1024;
+
+		// Sends from the game thread (the one that created the client or server) are handed over through
+		// the queue, so the game thread never waits for _lock held by the network thread during servicing
+		SpscQueue<OutgoingCommand, OutgoingQueueCapacity> _outgoingQueue;
+		std::uintptr_t _gameThreadId = 0;
+		std::atomic_bool _outgoingQueueActive{false};
+		std::atomic<std::uint64_t> _outgoingQueued{0};
+		std::atomic<std::uint64_t> _outgoingDropped{0};
+		std::atomic<std::uint64_t> _outgoingStalls{0};
+		std::atomic<std::uint32_t> _outgoingPeakDepth{0};
+
+		/** @brief Returns `true` if sends from the calling thread should be handed over to the network thread */
+		bool ShouldEnqueueOutgoing() const;
+		/** @brief Hands a packet over to the network thread, empty @p targets means the remote server (or all peers with @ref OutgoingCommand::Broadcast) */
+		void EnqueueOutgoing(ArrayView<_ENetPeer* const> targets, NetworkChannel channel, _ENetPacket* packet, std::uint8_t flags);
+		/** @brief Executes all queued sends, must be called with @ref _lock held */
+		void ProcessOutgoingQueue();
+		/** @brief Executes all queued sends before a direct send, so packets leave in the order they were sent in, must be called with @ref _lock held */
+		void FlushOutgoingQueue();
+		/** @brief Drops all queued sends, must be called from the network thread or after it exited */
+		void DiscardOutgoingQueue();
+#endif
+
 #if defined(WITH_WEBSOCKET) && !defined(DEATH_TARGET_EMSCRIPTEN)
 		/** @brief Queued event from WebSocket callbacks to the main processing thread */
 		struct WsQueuedEvent {
@@ -232,11 +327,18 @@ namespace Jazz2::Multiplayer
 		std::unique_ptr<ix::WebSocketServer> _wsServer;
 		std::unique_ptr<ix::WebSocket> _wsClient;
 		HashMap<ix::WebSocket*, WsPeerInfo> _wsPeers;	/**< Maps ix::WebSocket* → peer info; also acts as lifetime guard */
-		SmallVector<WsQueuedEvent, 0> _wsPendingEvents;
+		MpscQueue<WsQueuedEvent, 1024> _wsServerEvents;	/**< Events from WebSocket server connections, each one has its own thread */
+		SpscQueue<WsQueuedEvent, 256> _wsClientEvents;	/**< Events from the WebSocket client connection */
+		std::atomic<std::uint64_t> _inboundStalls{0};
 		std::uint64_t _wsPingLastTime = 0;		/**< Timestamp (ms) of the last outgoing Ping on the client thread */
 		std::atomic<std::uint32_t> _wsRtt{0};	/**< Client-side measured RTT for the WebSocket server connection */
 		mutable Spinlock _wsLock;
 
+		/** @brief Queues an event of the client connection, called from its callback thread */
+		void PushWsClientEvent(WsQueuedEvent&& ev);
+		/** @brief Queues an event of a server connection, called from the callback thread of the connection */
+		void PushWsServerEvent(WsQueuedEvent&& ev);
+		/** @brief Handles queued events of server connections, called only from the server thread */
 		void ProcessWsQueue(INetworkHandler* handler);
 		bool SendToWsPeer(ix::WebSocket* ws, std::uint8_t packetType, ArrayView<const std::uint8_t> data);
 #elif defined(WITH_WEBSOCKET) && defined(DEATH_TARGET_EMSCRIPTEN)
@@ -259,6 +361,13 @@ namespace Jazz2::Multiplayer
 		static void InitializeBackend();
 		static void ReleaseBackend();
 
+#if !defined(DEATH_TARGET_EMSCRIPTEN)
+		/** @brief Hands a packet over to the loopback handler if the specified peer is still connected */
+		void SendToLoopbackPeer(const Peer& peer, NetworkChannel channel, std::uint8_t packetType, ArrayView<const std::uint8_t> data);
+		/** @brief Hands a packet over to the loopback handler for all connected peers that match a given predicate */
+		void SendToLoopbackPeers(Function<bool(const Peer&)>&& predicate, NetworkChannel channel, std::uint8_t packetType, ArrayView<const std::uint8_t> data);
+#endif
+
 #if !defined(DEATH_TARGET_EMSCRIPTEN)
 		static void OnClientThread(void* param);
 		static void OnServerThread(void* param);
@@ -0,0 +1,201 @@
+#include "OutgoingPacket.h"
+
+#if defined(WITH_MULTIPLAYER)
+
+#include "NetworkManagerBase.h"
+
+#include <cstring>
+
+namespace Jazz2::Multiplayer
+{
+	OutgoingPacket::OutgoingPacket()
+		:
+#if defined(WITH_ONLINE_MULTIPLAYER) && !defined(DEATH_TARGET_EMSCRIPTEN)
+			_packet(nullptr),
+#endif
+			_data(nullptr), _size(0), _pos(0), _capacity(0)
+	{
+	}
+
+	OutgoingPacket::OutgoingPacket(std::uint8_t packetType, std::int64_t initialCapacity)
+		: OutgoingPacket()
+	{
+		Grow(std::max(initialCapacity, std::int64_t(16)));
+		_data[0] = packetType;
+	}
+
+	OutgoingPacket::~OutgoingPacket()
+	{
+		Dispose();
+	}
+
+	OutgoingPacket::OutgoingPacket(OutgoingPacket&& other) noexcept
+		: OutgoingPacket()
+	{
+		*this = std::move(other);
+	}
+
+	OutgoingPacket& OutgoingPacket::operator=(OutgoingPacket&& other) noexcept
+	{
+		if (this != &other) {
+			Dispose();
+#if defined(WITH_ONLINE_MULTIPLAYER) && !defined(DEATH_TARGET_EMSCRIPTEN)
+			_packet = other._packet;
+			other._packet = nullptr;
+#else
+			_storage = std::move(other._storage);
+#endif
+			_data = other._data;
+			_size = other._size;
+			_pos = other._pos;
+			_capacity = other._capacity;
+			other._data = nullptr;
+			other._size = 0;
+			other._pos = 0;
+			other._capacity = 0;
+		}
+		return *this;
+	}
+
+	void OutgoingPacket::Dispose()
+	{
+#if defined(WITH_ONLINE_MULTIPLAYER) && !defined(DEATH_TARGET_EMSCRIPTEN)
+		if (_packet != nullptr) {
+			enet_packet_destroy(_packet);
+			_packet = nullptr;
+		}
+#else
+		_storage = nullptr;
+#endif
+		_data = nullptr;
+		_size = 0;
+		_pos = 0;
+		_capacity = 0;
+	}
+
+	std::int64_t OutgoingPacket::Seek(std::int64_t offset, SeekOrigin origin)
+	{
+		std::int64_t newPos;
+		switch (origin) {
+			case SeekOrigin::Begin: newPos = offset; break;
+			case SeekOrigin::Current: newPos = _pos + offset; break;
+			case SeekOrigin::End: newPos = _size + offset; break;
+			default: return Stream::OutOfRange;
+		}
+
+		if (newPos < 0 || newPos > _size) {
+			return Stream::OutOfRange;
+		}
+		_pos = newPos;
+		return newPos;
+	}
+
+	std::int64_t OutgoingPacket::GetPosition() const
+	{
+		return _pos;
+	}
+
+	std::int64_t OutgoingPacket::Read(void* destination, std::int64_t bytesToRead)
+	{
+		return 0;
+	}
+
+	std::int64_t OutgoingPacket::Write(const void* source, std::int64_t bytesToWrite)
+	{
+		if (bytesToWrite <= 0 || _data == nullptr) {
+			return 0;
+		}
+
+		if (_pos + bytesToWrite > _capacity) {
+			Grow(_pos + bytesToWrite);
+		}
+
+		std::memcpy(_data + 1 + _pos, source, bytesToWrite);
+		_pos += bytesToWrite;
+		if (_size < _pos) {
+			_size = _pos;
+		}
+		return bytesToWrite;
+	}
+
+	bool OutgoingPacket::Flush()
+	{
+		return true;
+	}
+
+	bool OutgoingPacket::IsValid()
+	{
+		return (_data != nullptr);
+	}
+
+	std::int64_t OutgoingPacket::GetSize() const
+	{
+		return _size;
+	}
+
+	std::int64_t OutgoingPacket::SetSize(std::int64_t size)
+	{
+		if (_data == nullptr || size < 0) {
+			return Stream::Invalid;
+		}
+		if (size > _capacity) {
+			Grow(size);
+		}
+		_size = size;
+		if (_pos > _size) {
+			_pos = _size;
+		}
+		return _size;
+	}
+
+	void OutgoingPacket::Grow(std::int64_t requiredCapacity)
+	{
+		std::int64_t newCapacity = std::max(requiredCapacity, _capacity * 2);
+
+		// The buffer is not shared until it's sent, so it can be reallocated freely
+#if defined(WITH_ONLINE_MULTIPLAYER) && !defined(DEATH_TARGET_EMSCRIPTEN)
+		ENetPacket* newPacket = enet_packet_create_raw(nullptr, std::size_t(1 + newCapacity), 0);
+		DEATH_ASSERT(newPacket != nullptr, "Failed to allocate packet", );
+		std::uint8_t* newData = newPacket->data;
+#else
+		std::unique_ptr<std::uint8_t[]> newStorage = std::make_unique<std::uint8_t[]>(std::size_t(1 + newCapacity));
+		std::uint8_t* newData = newStorage.get();
+#endif
+
+		if (_data != nullptr) {
+			std::memcpy(newData, _data, std::size_t(1 + _size));
+		}
+
+#if defined(WITH_ONLINE_MULTIPLAYER) && !defined(DEATH_TARGET_EMSCRIPTEN)
+		if (_packet != nullptr) {
+			enet_packet_destroy(_packet);
+		}
+		_packet = newPacket;
+#else
+		_storage = std::move(newStorage);
+#endif
+		_data = newData;
+		_capacity = newCapacity;
+	}
+
+#if defined(WITH_ONLINE_MULTIPLAYER) && !defined(DEATH_TARGET_EMSCRIPTEN)
+	ENetPacket* OutgoingPacket::Release(std::uint32_t flags)
+	{
+		ENetPacket* packet = _packet;
+		if (packet != nullptr) {
+			// Shrinking doesn't reallocate, only the written part is sent
+			enet_packet_resize(packet, std::size_t(1 + _size));
+			packet->flags = flags;
+		}
+
+		_packet = nullptr;
+		_data = nullptr;
+		_size = 0;
+		_pos = 0;
+		_capacity = 0;
+		return packet;
+	}
+#endif
+}
+
+#endif
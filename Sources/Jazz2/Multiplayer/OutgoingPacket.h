@@ -0,0 +1,87 @@
+#pragma once
+
+#if defined(WITH_MULTIPLAYER) || defined(DOXYGEN_GENERATING_OUTPUT)
+
+#include "../../Main.h"
+
+#include <memory>
+
+#include <Containers/ArrayView.h>
+#include <IO/Stream.h>
+
+#if (defined(WITH_ONLINE_MULTIPLAYER) && !defined(DEATH_TARGET_EMSCRIPTEN)) || defined(DOXYGEN_GENERATING_OUTPUT)
+struct _ENetPacket;
+#endif
+
+using namespace Death::Containers;
+using namespace Death::IO;
+
+namespace Jazz2::Multiplayer
+{
+	class NetworkManagerBase;
+
+	/**
+		@brief Outgoing packet written directly into the transport buffer
+
+		The payload is written into the same buffer that is later handed over to ENet, prefixed with the packet
+		type, so @ref NetworkManagerBase::SendTo() doesn't copy it again. ENet reference-counts the buffer, so
+		a broadcast to any number of peers shares a single allocation. The packet is consumed by sending it.
+	*/
+	class OutgoingPacket : public Stream
+	{
+		friend class NetworkManagerBase;
+
+	public:
+		/** @brief Creates an empty invalid packet */
+		OutgoingPacket();
+		/** @brief Creates a packet of the specified type with an initial payload capacity */
+		explicit OutgoingPacket(std::uint8_t packetType, std::int64_t initialCapacity = 64);
+		~OutgoingPacket() override;
+
+		OutgoingPacket(const OutgoingPacket&) = delete;
+		OutgoingPacket& operator=(const OutgoingPacket&) = delete;
+		OutgoingPacket(OutgoingPacket&& other) noexcept;
+		OutgoingPacket& operator=(OutgoingPacket&& other) noexcept;
+
+		void Dispose() override;
+		std::int64_t Seek(std::int64_t offset, SeekOrigin origin) override;
+		std::int64_t GetPosition() const override;
+		/** @brief Reading is not supported, always returns `0` */
+		std::int64_t Read(void* destination, std::int64_t bytesToRead) override;
+		std::int64_t Write(const void* source, std::int64_t bytesToWrite) override;
+		bool Flush() override;
+		bool IsValid() override;
+		/** @brief Returns size of the payload without the packet type */
+		std::int64_t GetSize() const override;
+		std::int64_t SetSize(std::int64_t size) override;
+
+		/** @brief Returns packet type */
+		std::uint8_t GetPacketType() const {
+			return (_data != nullptr ? _data[0] : 0);
+		}
+
+		/** @brief Returns payload written so far without the packet type */
+		ArrayView<const std::uint8_t> GetPayload() const {
+			return { _data != nullptr ? _data + 1 : nullptr, std::size_t(_size) };
+		}
+
+	private:
+#if (defined(WITH_ONLINE_MULTIPLAYER) && !defined(DEATH_TARGET_EMSCRIPTEN)) || defined(DOXYGEN_GENERATING_OUTPUT)
+		_ENetPacket* _packet;
+#else
+		std::unique_ptr<std::uint8_t[]> _storage;
+#endif
+		std::uint8_t* _data;		// Packet type followed by the payload
+		std::int64_t _size;
+		std::int64_t _pos;
+		std::int64_t _capacity;
+
+		void Grow(std::int64_t requiredCapacity);
+#if (defined(WITH_ONLINE_MULTIPLAYER) && !defined(DEATH_TARGET_EMSCRIPTEN)) || defined(DOXYGEN_GENERATING_OUTPUT)
+		/** @brief Transfers ownership of the underlying ENet packet to the caller, the packet becomes invalid */
+		_ENetPacket* Release(std::uint32_t flags);
+#endif
+	};
+}
+
+#endif
@@ -38,6 +38,7 @@ namespace Jazz2::Multiplayer
 		ValidateAssetsResponse,		/**< Response to a server request to validate required assets */
 
 		ForceResyncActors = 20,		/**< Requests the server to resynchronize all actors */
+		AckUpdateAllActors,			/**< Acknowledges a received @ref ServerPacketType::UpdateAllActors snapshot */
 
 		PlayerReady = 30,			/**< Notifies the server that the player is ready to spawn */
 		PlayerUpdate,				/**< Periodic update of the local player state */
@@ -87,7 +88,7 @@ namespace Jazz2::Multiplayer
 		CreateRemoteActor,				/**< Creates a remote actor on the client */
 		CreateMirroredActor,			/**< Creates a mirrored actor on the client */
 		DestroyRemoteActor,				/**< Destroys a remote actor on the client */
-		UpdateAllActors,				/**< Periodic update of all remote actors */
+		UpdateAllActors,				/**< Periodic update of all remote actors, delta-encoded against the last acknowledged snapshot */
 		ChangeRemoteActorMetadata,		/**< Changes metadata of a remote actor */
 		MarkRemoteActorAsPlayer,		/**< Marks a remote actor as another player */
 		UpdatePositionsInRound,			/**< Updates player positions in the current round */
@@ -72,6 +72,26 @@ namespace Jazz2::Multiplayer
 			return p;
 		}
 
+#if !defined(DEATH_TARGET_EMSCRIPTEN)
+		/**
+		 * @brief Creates a synthetic peer identifying an in-process loopback client
+		 *
+		 * Loopback peers have no transport handle, all packets addressed to them are handed to the loopback handler
+		 * of the owning @ref NetworkManagerBase. Sentinel values are offset from the local splitscreen ones, so both
+		 * kinds of synthetic peers can never collide.
+		 *
+		 * @param index  Loopback client index
+		 */
+		static Peer Loopback(std::uint32_t index) {
+			Peer p;
+			p._enet = reinterpret_cast<_ENetPeer*>(static_cast<std::uintptr_t>(0x10000u + index));
+#	if defined(WITH_WEBSOCKET)
+			p._ws = reinterpret_cast<ix::WebSocket*>(static_cast<std::uintptr_t>(0x10000u + index));
+#	endif
+			return p;
+		}
+#endif
+
 #if defined(WITH_WEBSOCKET)
 		/** @brief Creates a WebSocket peer from a native WebSocket pointer */
 		static Peer FromWebSocket(
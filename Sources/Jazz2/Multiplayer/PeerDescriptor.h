@@ -7,6 +7,7 @@
 #include "../LevelInitialization.h"
 #include "../PlayerType.h"
 #include "../PreferencesCache.h"
+#include "../Actors/Multiplayer/StateInterpolationBuffer.h"
 #include "../../nCine/Base/TimeStamp.h"
 
 #include <Containers/String.h>
@@ -97,6 +98,8 @@ namespace Jazz2::Multiplayer
 		Actors::Multiplayer::MpPlayer* Player;
 		/** @brief Last update of the player from client */
 		std::uint64_t LastUpdated;
+		/** @brief Playout delay of player updates received from client, used to interpolate its position on the server */
+		Actors::Multiplayer::PlayoutDelayEstimator PlayoutDelay;
 
 		/** @brief Start of the current inbound packet-rate window in milliseconds (server-side flood mitigation) */
 		std::uint64_t PacketRateWindowStart = 0;
@@ -0,0 +1,654 @@
+#include "ServerBenchmark.h"
+
+#if defined(WITH_MULTIPLAYER) && !defined(DEATH_TARGET_EMSCRIPTEN)
+
+#include "MpLevelHandler.h"
+#include "PacketTypes.h"
+#include "../ContentFileTypes.h"
+#include "../ContentResolver.h"
+#include "../EventType.h"
+#include "../LevelFlags.h"
+#include "../PlayerAction.h"
+#include "../PlayerType.h"
+#include "../PreferencesCache.h"
+#include "../Actors/Multiplayer/RemotePlayerOnServer.h"
+#include "../Compatibility/JJ2Anims.h"
+
+#include "../../nCine/Base/Algorithms.h"
+#include "../../nCine/Base/Clock.h"
+#include "../../nCine/Base/FrameTimer.h"
+
+#include <algorithm>
+
+#include <IO/FileSystem.h>
+#include <IO/MemoryStream.h>
+#include <IO/Compression/DeflateStream.h>
+
+using namespace Death::IO;
+using namespace Death::IO::Compression;
+using namespace Jazz2::Actors::Multiplayer;
+
+/** @brief @ref Death::Containers::StringView from @ref NCINE_PROTOCOL_VERSION */
+#define NCINE_PROTOCOL_VERSION_s DEATH_PASTE(NCINE_PROTOCOL_VERSION, _s)
+
+namespace Jazz2::Multiplayer
+{
+	ServerBenchmark::ServerBenchmark(std::int32_t peerCount, std::int32_t durationSecs, std::uint32_t clientData)
+		: _networkManager(nullptr), _durationSecs(durationSecs), _clientData(clientData), _frameCount(0),
+			_measureStartFrame(-1), _isMeasuring(false), _currentTick{}, _phaseTotals{}, _snapshotTotal(0.0), _maxActorCount(0)
+	{
+		_clients.resize(std::max(peerCount, 1));
+	}
+
+	String ServerBenchmark::CreateSyntheticLevel()
+	{
+		// Tile 0 is empty, tile 1 is solid
+		constexpr std::int32_t TileSize = Tiles::TileSet::DefaultTileSize;
+		constexpr std::uint16_t TileCount = 2;
+		constexpr std::int32_t Width = 64;
+		constexpr std::int32_t Height = 24;
+
+		auto& resolver = ContentResolver::Get();
+		String tileSetPath = fs::CombinePath({ resolver.GetCachePath(), "Tilesets"_s, "_benchmark.j2t"_s });
+		String levelPath = fs::CombinePath({ resolver.GetCachePath(), "Episodes"_s, "_benchmark"_s, "arena.j2l"_s });
+		fs::CreateDirectories(fs::GetDirectoryName(tileSetPath));
+		fs::CreateDirectories(fs::GetDirectoryName(levelPath));
+
+		{
+			auto so = fs::Open(tileSetPath, FileAccess::Write);
+			if (!so->IsValid()) {
+				LOGE("Cannot open file \"{}\" for writing", tileSetPath);
+				return {};
+			}
+
+			// Same layout as JJ2Tileset::Convert() writes, with a single index channel
+			constexpr std::int32_t width = TileCount * TileSize;
+			constexpr std::int32_t height = TileSize;
+			so->WriteValueAsLE<std::uint64_t>(0xB8EF8498E2BFBBEF);
+			so->WriteValueAsLE<std::uint16_t>(0x208F);
+			so->WriteValue<std::uint8_t>(2);
+			so->WriteValue<std::uint8_t>(0x20 | 0x40);
+			so->WriteValue<std::uint8_t>(1);
+			so->WriteValueAsLE<std::uint32_t>(width);
+			so->WriteValueAsLE<std::uint32_t>(height);
+			so->WriteValueAsLE<std::uint16_t>(TileCount);
+
+			MemoryStream ms(4096);
+			{
+				DeflateWriter co(ms);
+				for (std::int32_t i = 0; i < ContentResolver::ColorsPerPalette; i++) {
+					co.WriteValueAsLE<std::uint32_t>(i == 0 ? 0x00000000 : (0xFF000000 | (i * 0x010101)));
+				}
+				co.WriteValue<std::uint8_t>(0);		// No 32-bit tiles
+
+				constexpr std::uint32_t maskBytesPerTile = TileSize * TileSize / 8;
+				std::uint8_t mask[maskBytesPerTile];
+				co.WriteValueAsLE<std::uint32_t>(TileCount * maskBytesPerTile);
+				std::memset(mask, 0x00, sizeof(mask));
+				co.Write(mask, sizeof(mask));
+				std::memset(mask, 0xFF, sizeof(mask));
+				co.Write(mask, sizeof(mask));
+			}
+			so->WriteValueAsLE<std::int32_t>(std::int32_t(ms.GetSize()));
+			so->Write(ms.GetBuffer(), ms.GetSize());
+
+			std::uint8_t pixels[width * height];
+			for (std::int32_t y = 0; y < height; y++) {
+				for (std::int32_t x = 0; x < width; x++) {
+					pixels[y * width + x] = (x < TileSize ? 0 : 15);
+				}
+			}
+			Compatibility::JJ2Anims::WriteImageContent(*so, pixels, width, height, 1);
+		}
+
+		auto so = fs::Open(levelPath, FileAccess::Write);
+		if (!so->IsValid()) {
+			LOGE("Cannot open file \"{}\" for writing", levelPath);
+			return {};
+		}
+
+		// Same layout as JJ2Level::Convert() writes
+		so->WriteValueAsLE<std::uint64_t>(0x2095A59FF0BFBBEF);
+		so->WriteValue<std::uint8_t>(ContentFileType::Level);
+		so->WriteValueAsLE<std::uint16_t>(std::uint16_t(LevelFlags::None));
+
+		auto isSolid = [](std::int32_t x, std::int32_t y) {
+			// Walls and floor, with a few platforms to jump on
+			return (x == 0 || x == Width - 1 || y >= Height - 2 ||
+				(y == Height - 7 && (x % 16) >= 4 && (x % 16) < 12) ||
+				(y == Height - 12 && (x % 16) >= 10 && (x % 16) < 14));
+		};
+
+		MemoryStream ms(64 * 1024);
+		{
+			DeflateWriter co(ms);
+
+			auto writeString = [&co](StringView value) {
+				co.WriteValue<std::uint8_t>(std::uint8_t(value.size()));
+				co.Write(value.data(), value.size());
+			};
+
+			writeString("Benchmark Arena"_s);
+			writeString({});						// Next level
+			writeString({});						// Secret level
+			writeString({});						// Bonus level
+			writeString("_benchmark"_s);			// Tile set
+			writeString({});						// Music
+			co.WriteValueAsLE<std::uint32_t>(0xFF000000);	// Ambient color
+			co.WriteValue<std::uint8_t>(0);			// Weather
+			co.WriteValue<std::uint8_t>(0);			// Weather intensity
+			co.WriteValueAsLE<std::uint16_t>(32767);	// No water
+			co.WriteValueAsLE<std::uint16_t>(0);	// Caption tile
+			co.WriteValue<std::uint8_t>(0);			// Additional palettes
+			co.WriteValue<std::uint8_t>(0);			// Extra tile sets
+			co.WriteVariableUint32(0);				// Overriden tile diffuses
+			co.WriteVariableUint32(0);				// Overriden tile masks
+			co.WriteValue<std::uint8_t>(0);			// Text event strings
+			co.WriteValueAsLE<std::uint16_t>(TileCount);	// Animated tiles offset
+			co.WriteValueAsLE<std::uint16_t>(0);	// Animated tiles
+
+			// Only the sprite layer
+			co.WriteValue<std::uint8_t>(1);
+			co.WriteValue<std::uint8_t>(2);			// LayerType::Sprite
+			co.WriteValueAsLE<std::uint16_t>(0x08);	// Visible
+			co.WriteValueAsLE<std::int32_t>(Width);
+			co.WriteValueAsLE<std::int32_t>(Height);
+			for (std::int32_t y = 0; y < Height; y++) {
+				for (std::int32_t x = 0; x < Width; x++) {
+					co.WriteValue<std::uint8_t>(0);
+					co.WriteValueAsLE<std::uint16_t>(isSolid(x, y) ? 1 : 0);
+				}
+			}
+
+			// Events, a spawn point for all characters on top of every other floor tile
+			for (std::int32_t y = 0; y < Height; y++) {
+				for (std::int32_t x = 0; x < Width; x++) {
+					if (y == Height - 3 && x > 1 && x < Width - 2 && (x % 2) == 0) {
+						std::uint8_t eventParams[16] {};
+						eventParams[0] = 0xFF;
+						co.WriteValueAsLE<std::uint16_t>(std::uint16_t(EventType::LevelStart));
+						co.WriteValue<std::uint8_t>(0x70);	// All difficulties, parameters follow
+						co.Write(eventParams, sizeof(eventParams));
+					} else {
+						co.WriteValueAsLE<std::uint16_t>(std::uint16_t(EventType::Empty));
+						co.WriteValue<std::uint8_t>(0x01);	// No parameters
+					}
+				}
+			}
+			co.WriteVariableUint32(0);				// Off-grid events
+		}
+
+		so->WriteValueAsLE<std::int32_t>(std::int32_t(ms.GetSize()));
+		so->Write(ms.GetBuffer(), ms.GetSize());
+
+		return "_benchmark/arena"_s;
+	}
+
+	void ServerBenchmark::BeginTick(NetworkManager* networkManager)
+	{
+		_phaseStart = TimeStamp::now();
+		for (std::int32_t i = 0; i < (std::int32_t)TickPhase::Count; i++) {
+			_currentTick[i] = 0.0f;
+		}
+
+		if DEATH_UNLIKELY(_networkManager == nullptr) {
+			_networkManager = networkManager;
+			ConnectClients();
+		}
+
+		_networkManager->ServiceLoopback();
+		ProcessPackets();
+
+		for (std::uint32_t i = 0; i < _clients.size(); i++) {
+			UpdateClient(i, _clients[i]);
+		}
+
+		MarkPhase(TickPhase::Clients);
+	}
+
+	void ServerBenchmark::MarkPhase(TickPhase phase)
+	{
+		TimeStamp now = TimeStamp::now();
+		_currentTick[(std::int32_t)phase] += (now - _phaseStart).microseconds();
+		_phaseStart = now;
+	}
+
+	bool ServerBenchmark::EndTick(MpLevelHandler* levelHandler)
+	{
+		MarkPhase(TickPhase::EndFrame);
+		_frameCount++;
+
+		_maxActorCount = std::max(_maxActorCount, (std::uint32_t)levelHandler->GetActors().size());
+
+		if (!_isMeasuring) {
+			bool allPlaying = true;
+			for (auto& client : _clients) {
+				if (client.State != ClientState::Playing) {
+					allPlaying = false;
+					break;
+				}
+			}
+
+			if (allPlaying) {
+				if (_measureStartFrame < 0) {
+					_measureStartFrame = _frameCount + WarmUpFrames;
+					LOGI("[Benchmark] All {} clients spawned in {} frames, warming up", _clients.size(), _frameCount);
+				}
+			} else if (_frameCount == SpawnTimeoutFrames) {
+				std::int32_t playingCount = 0;
+				for (auto& client : _clients) {
+					if (client.State == ClientState::Playing) {
+						playingCount++;
+					}
+				}
+				LOGW("[Benchmark] Only {}/{} clients spawned in {} frames, measuring anyway", playingCount, _clients.size(), _frameCount);
+				_measureStartFrame = _frameCount;
+			}
+
+			if (_measureStartFrame >= 0 && _frameCount >= _measureStartFrame) {
+				StartMeasurement();
+			}
+			return false;
+		}
+
+		float tickTime = 0.0f;
+		for (std::int32_t i = 0; i < (std::int32_t)TickPhase::Count; i++) {
+			tickTime += _currentTick[i];
+			_phaseTotals[i] += (double)_currentTick[i];
+		}
+		_tickTimes.push_back(tickTime);
+		_snapshotTotal += (double)levelHandler->GetLastSnapshotTimeUs();
+
+		float elapsedSecs = _measureStart.secondsSince();
+		if (elapsedSecs < (float)_durationSecs) {
+			return false;
+		}
+
+		ReportResults(elapsedSecs);
+		return true;
+	}
+
+	void ServerBenchmark::OnLoopbackPacket(const Peer& peer, NetworkChannel channel, std::uint8_t packetType, ArrayView<const std::uint8_t> data)
+	{
+		std::int32_t clientIndex = FindClient(peer);
+		if DEATH_UNLIKELY(clientIndex < 0) {
+			return;
+		}
+
+		auto& client = _clients[clientIndex];
+
+		std::unique_lock lock(_lock);
+		if (_isMeasuring) {
+			client.BytesDown += 1 + data.size();
+			client.PacketsDown++;
+		}
+
+		switch ((ServerPacketType)packetType) {
+			case ServerPacketType::UpdateAllActors: {
+				if (_isMeasuring) {
+					client.SnapshotBytes += 1 + data.size();
+					client.SnapshotCount++;
+				}
+				MemoryStream packet(data);
+				client.PendingAcks.push_back(packet.ReadVariableUint32());
+				break;
+			}
+			case ServerPacketType::ValidateAssets:
+			case ServerPacketType::LoadLevel:
+			case ServerPacketType::ShowInGameLobby:
+			case ServerPacketType::CreateControllablePlayer:
+			case ServerPacketType::PlayerRespawn:
+			case ServerPacketType::PlayerMoveInstantly: {
+				// The server is still in the middle of processing, so the response is deferred to the next tick
+				auto& pending = _pendingPackets.emplace_back();
+				pending.ClientIndex = (std::uint32_t)clientIndex;
+				pending.PacketType = packetType;
+				pending.Data.append(data.begin(), data.end());
+				break;
+			}
+			default: {
+				// Other packets don't need any response, they are only counted
+				break;
+			}
+		}
+	}
+
+	void ServerBenchmark::OnLoopbackDisconnected(const Peer& peer, Reason reason)
+	{
+		std::int32_t clientIndex = FindClient(peer);
+		if (clientIndex >= 0) {
+			LOGW("[Benchmark] Client {} was disconnected by the server ({})", clientIndex, reason);
+			_clients[clientIndex].State = ClientState::Disconnected;
+		}
+	}
+
+	void ServerBenchmark::ConnectClients()
+	{
+		const auto& serverConfig = _networkManager->GetServerConfiguration();
+		constexpr std::uint64_t currentVersion = parseVersion(NCINE_PROTOCOL_VERSION_s);
+
+		for (std::uint32_t i = 0; i < _clients.size(); i++) {
+			auto& client = _clients[i];
+			client.RemotePeer = _networkManager->ConnectLoopbackPeer(_clientData);
+			if (!client.RemotePeer) {
+				continue;
+			}
+
+			client.State = ClientState::Authenticating;
+
+			// Each client needs its own unique player ID, otherwise the server would treat them as the same player
+			Uuid uuid = PreferencesCache::UniquePlayerID;
+			uuid[Uuid::Size - 2] ^= (std::uint8_t)(i >> 8);
+			uuid[Uuid::Size - 1] ^= (std::uint8_t)(i + 1);
+
+			String playerName = format("Bot {}", i + 1);
+
+			MemoryStream packet(64 + playerName.size());
+			packet.Write("J2R ", 4);
+			packet.WriteVariableUint64(currentVersion);
+			packet.Write(uuid.data(), uuid.size());
+			packet.WriteVariableUint32((std::uint32_t)serverConfig.ServerPassword.size());
+			packet.Write(serverConfig.ServerPassword.data(), (std::uint32_t)serverConfig.ServerPassword.size());
+			packet.WriteValue<std::uint8_t>((std::uint8_t)playerName.size());
+			packet.Write(playerName.data(), (std::uint32_t)playerName.size());
+			packet.WriteValue<std::uint8_t>(0);		// Device ID
+			packet.WriteVariableUint64(0);			// User ID
+			packet.WriteValueAsLE<std::uint32_t>(0);	// Fur color
+			SendToServer(client, NetworkChannel::Main, (std::uint8_t)ClientPacketType::Auth, packet);
+		}
+
+		LOGI("[Benchmark] Connected {} clients", _clients.size());
+	}
+
+	void ServerBenchmark::ProcessPackets()
+	{
+		{
+			std::unique_lock lock(_lock);
+			std::swap(_pendingPackets, _processingPackets);
+		}
+
+		for (auto& pending : _processingPackets) {
+			auto& client = _clients[pending.ClientIndex];
+			if (client.State != ClientState::Disconnected) {
+				ProcessPacket(client, pending.PacketType, pending.Data);
+			}
+		}
+
+		_processingPackets.clear();
+	}
+
+	void ServerBenchmark::ProcessPacket(SyntheticClient& client, std::uint8_t packetType, ArrayView<const std::uint8_t> data)
+	{
+		MemoryStream packet(data);
+
+		switch ((ServerPacketType)packetType) {
+			case ServerPacketType::ValidateAssets: {
+				// Clients share the content with the server, so all assets always match
+				std::uint32_t assetCount = packet.ReadVariableUint32();
+
+				MemoryStream packetOut(8 + assetCount * 64);
+				packetOut.WriteVariableUint32(assetCount);
+				for (std::uint32_t i = 0; i < assetCount; i++) {
+					MpLevelHandler::AssetType type = (MpLevelHandler::AssetType)packet.ReadValue<std::uint8_t>();
+					std::uint32_t pathLength = packet.ReadVariableUint32();
+					String path{NoInit, pathLength};
+					packet.Read(path.data(), pathLength);
+
+					packetOut.WriteValue<std::uint8_t>((std::uint8_t)type);
+					packetOut.WriteVariableUint32((std::uint32_t)path.size());
+					packetOut.Write(path.data(), (std::int64_t)path.size());
+
+					auto fullPath = MpLevelHandler::GetAssetFullPath(type, path);
+					auto s = (!fullPath.empty() ? fs::Open(fullPath, FileAccess::Read) : nullptr);
+					if (s != nullptr && s->IsValid()) {
+						packetOut.WriteVariableInt64(s->GetSize());
+						packetOut.WriteValue<std::uint32_t>(nCine::crc32(*s));
+					} else {
+						packetOut.WriteVariableInt64(0);
+						packetOut.WriteValue<std::uint32_t>(0);
+					}
+				}
+
+				client.State = ClientState::LoadingLevel;
+				SendToServer(client, NetworkChannel::Main, (std::uint8_t)ClientPacketType::ValidateAssetsResponse, packetOut);
+				break;
+			}
+			case ServerPacketType::LoadLevel: {
+				std::uint8_t flags = 0;
+				SendToServer(client, NetworkChannel::Main, (std::uint8_t)ClientPacketType::LevelReady, { &flags, 1 });
+				break;
+			}
+			case ServerPacketType::ShowInGameLobby: {
+				if (client.State == ClientState::LoadingLevel) {
+					client.State = ClientState::WaitingForSpawn;
+
+					std::uint32_t clientIndex = (std::uint32_t)(&client - _clients.data());
+					std::uint8_t playerReady[2];
+					playerReady[0] = (std::uint8_t)((clientIndex % 2) == 0 ? PlayerType::Jazz : PlayerType::Spaz);
+					playerReady[1] = 0;	// Team
+					SendToServer(client, NetworkChannel::Main, (std::uint8_t)ClientPacketType::PlayerReady, playerReady);
+				}
+				break;
+			}
+			case ServerPacketType::CreateControllablePlayer: {
+				client.PlayerIndex = packet.ReadVariableUint32();
+				packet.ReadValue<std::uint8_t>();	// Player type
+				packet.ReadVariableInt32();			// Health
+				packet.ReadValue<std::uint8_t>();	// Flags
+				packet.ReadValue<std::uint8_t>();	// Team
+				std::int32_t posX = packet.ReadVariableInt32();
+				std::int32_t posY = packet.ReadVariableInt32();
+
+				client.Pos = Vector2f((float)posX, (float)posY);
+				client.Speed = Vector2f::Zero;
+				client.PressedKeys = 0;
+				client.State = ClientState::Playing;
+				break;
+			}
+			case ServerPacketType::PlayerRespawn: {
+				std::uint32_t playerIndex = packet.ReadVariableUint32();
+				if (playerIndex == client.PlayerIndex) {
+					float posX = packet.ReadValue<std::int32_t>() / 512.0f;
+					float posY = packet.ReadValue<std::int32_t>() / 512.0f;
+					client.Pos = Vector2f(posX, posY);
+					client.Speed = Vector2f::Zero;
+					SendPlayerAckWarped(client);
+				}
+				break;
+			}
+			case ServerPacketType::PlayerMoveInstantly: {
+				std::uint32_t playerIndex = packet.ReadVariableUint32();
+				if (playerIndex == client.PlayerIndex) {
+					float posX = packet.ReadValue<std::int32_t>() / 512.0f;
+					float posY = packet.ReadValue<std::int32_t>() / 512.0f;
+					float speedX = packet.ReadValue<std::int16_t>() / 512.0f;
+					float speedY = packet.ReadValue<std::int16_t>() / 512.0f;
+					client.Pos = Vector2f(posX, posY);
+					client.Speed = Vector2f(speedX, speedY);
+					SendPlayerAckWarped(client);
+				}
+				break;
+			}
+			default: {
+				break;
+			}
+		}
+	}
+
+	void ServerBenchmark::UpdateClient(std::uint32_t index, SyntheticClient& client)
+	{
+		if (client.State == ClientState::Disconnected) {
+			return;
+		}
+
+		SmallVector<std::uint32_t, 0> pendingAcks;
+		{
+			std::unique_lock lock(_lock);
+			std::swap(pendingAcks, client.PendingAcks);
+		}
+		for (std::uint32_t seqNum : pendingAcks) {
+			MemoryStream ack(4);
+			ack.WriteVariableUint32(seqNum);
+			SendToServer(client, NetworkChannel::UnreliableUpdates, (std::uint8_t)ClientPacketType::AckUpdateAllActors, ack);
+		}
+
+		if (client.State != ClientState::Playing) {
+			return;
+		}
+
+		// Walk back and forth around the spawn point, jumping and shooting from time to time,
+		// each client is shifted in phase, so they don't all change direction in the same frame
+		std::int32_t frame = _frameCount + (std::int32_t)index * 17;
+		bool isFacingLeft = ((frame / 120) % 2) != 0;
+		client.Speed = Vector2f(isFacingLeft ? -WalkSpeed : WalkSpeed, 0.0f);
+		client.Pos += client.Speed;
+
+		std::uint64_t pressedKeys = (1ull << (std::int32_t)(isFacingLeft ? PlayerAction::Left : PlayerAction::Right));
+		if ((frame % 90) < 10) {
+			pressedKeys |= (1ull << (std::int32_t)PlayerAction::Jump);
+		}
+		if ((frame % 40) < 8) {
+			pressedKeys |= (1ull << (std::int32_t)PlayerAction::Fire);
+		}
+
+		if (client.PressedKeys != pressedKeys) {
+			client.PressedKeys = pressedKeys;
+
+			MemoryStream packet(12);
+			packet.WriteVariableUint32(client.PlayerIndex);
+			packet.WriteVariableUint64(pressedKeys);
+			SendToServer(client, NetworkChannel::UnreliableUpdates, (std::uint8_t)ClientPacketType::PlayerKeyPress, packet);
+		}
+
+		if ((frame % PlayerUpdateInterval) == 0) {
+			Clock& c = nCine::clock();
+			std::uint64_t now = c.now() * 1000 / c.frequency();
+			// Server drops updates that are not newer than the last one
+			client.LastUpdateTime = std::max(now, client.LastUpdateTime + 1);
+
+			std::uint32_t flags = (std::uint32_t)RemotePlayerOnServer::PlayerFlags::IsVisible;
+			if (isFacingLeft) {
+				flags |= (std::uint32_t)RemotePlayerOnServer::PlayerFlags::IsFacingLeft;
+			}
+
+			MemoryStream packet(32);
+			packet.WriteVariableUint32(client.PlayerIndex);
+			packet.WriteVariableUint64(client.LastUpdateTime);
+			packet.WriteValue<std::int32_t>((std::int32_t)(client.Pos.X * 512.0f));
+			packet.WriteValue<std::int32_t>((std::int32_t)(client.Pos.Y * 512.0f));
+			packet.WriteValue<std::int16_t>((std::int16_t)(client.Speed.X * 512.0f));
+			packet.WriteValue<std::int16_t>((std::int16_t)(client.Speed.Y * 512.0f));
+			packet.WriteVariableUint32(flags);
+			SendToServer(client, NetworkChannel::UnreliableUpdates, (std::uint8_t)ClientPacketType::PlayerUpdate, packet);
+		}
+	}
+
+	void ServerBenchmark::SendToServer(SyntheticClient& client, NetworkChannel channel, std::uint8_t packetType, ArrayView<const std::uint8_t> data)
+	{
+		if (_isMeasuring) {
+			std::unique_lock lock(_lock);
+			client.BytesUp += 1 + data.size();
+			client.PacketsUp++;
+		}
+
+		// The lock must not be held here, because the server can respond immediately
+		_networkManager->ReceiveFromLoopbackPeer(client.RemotePeer, channel, packetType, data);
+	}
+
+	void ServerBenchmark::SendPlayerAckWarped(SyntheticClient& client)
+	{
+		Clock& c = nCine::clock();
+		std::uint64_t now = c.now() * 1000 / c.frequency();
+		client.LastUpdateTime = std::max(now, client.LastUpdateTime + 1);
+
+		MemoryStream packet(24);
+		packet.WriteVariableUint32(client.PlayerIndex);
+		packet.WriteVariableUint64(client.LastUpdateTime);
+		packet.WriteValue<std::int32_t>((std::int32_t)(client.Pos.X * 512.0f));
+		packet.WriteValue<std::int32_t>((std::int32_t)(client.Pos.Y * 512.0f));
+		packet.WriteValue<std::int16_t>((std::int16_t)(client.Speed.X * 512.0f));
+		packet.WriteValue<std::int16_t>((std::int16_t)(client.Speed.Y * 512.0f));
+		SendToServer(client, NetworkChannel::Main, (std::uint8_t)ClientPacketType::PlayerAckWarped, packet);
+	}
+
+	std::int32_t ServerBenchmark::FindClient(const Peer& peer) const
+	{
+		for (std::int32_t i = 0; i < (std::int32_t)_clients.size(); i++) {
+			if (_clients[i].RemotePeer == peer) {
+				return i;
+			}
+		}
+		return -1;
+	}
+
+	void ServerBenchmark::StartMeasurement()
+	{
+		std::unique_lock lock(_lock);
+
+		_isMeasuring = true;
+		_measureStart = TimeStamp::now();
+		_tickTimes.reserve((std::size_t)(_durationSecs * FrameTimer::FramesPerSecond) + 1);
+
+		for (auto& client : _clients) {
+			client.BytesDown = 0;
+			client.BytesUp = 0;
+			client.PacketsDown = 0;
+			client.PacketsUp = 0;
+			client.SnapshotBytes = 0;
+			client.SnapshotCount = 0;
+		}
+
+		LOGI("[Benchmark] Measuring for {} seconds", _durationSecs);
+	}
+
+	void ServerBenchmark::ReportResults(float elapsedSecs)
+	{
+		std::size_t tickCount = _tickTimes.size();
+		if (tickCount == 0) {
+			LOGW("[Benchmark] No ticks were measured");
+			return;
+		}
+
+		double total = 0.0;
+		for (float tickTime : _tickTimes) {
+			total += (double)tickTime;
+		}
+
+		std::sort(_tickTimes.begin(), _tickTimes.end());
+		auto percentile = [this, tickCount](float p) {
+			std::size_t i = std::min((std::size_t)(p * (tickCount - 1) + 0.5f), tickCount - 1);
+			return _tickTimes[i] / 1000.0f;
+		};
+
+		float mean = (float)(total / tickCount) / 1000.0f;
+		float budget = FrameTimer::SecondsPerFrame * 1000.0f;
+
+		LOGI("[Benchmark] {} peers, {} ticks in {:.1f} s, up to {} actors", _clients.size(), tickCount, elapsedSecs, _maxActorCount);
+		LOGI("[Benchmark] Tick time: mean {:.3f} ms ({:.1f} % of budget), p50 {:.3f} ms, p90 {:.3f} ms, p99 {:.3f} ms, max {:.3f} ms",
+			mean, mean * 100.0f / budget, percentile(0.5f), percentile(0.9f), percentile(0.99f), _tickTimes[tickCount - 1] / 1000.0f);
+		LOGI("[Benchmark] Phases: clients {:.3f} ms, begin frame {:.3f} ms, update {:.3f} ms, end frame {:.3f} ms (snapshots {:.3f} ms)",
+			_phaseTotals[(std::int32_t)TickPhase::Clients] / tickCount / 1000.0,
+			_phaseTotals[(std::int32_t)TickPhase::BeginFrame] / tickCount / 1000.0,
+			_phaseTotals[(std::int32_t)TickPhase::Update] / tickCount / 1000.0,
+			_phaseTotals[(std::int32_t)TickPhase::EndFrame] / tickCount / 1000.0,
+			_snapshotTotal / tickCount / 1000.0);
+
+		std::unique_lock lock(_lock);
+
+		std::uint64_t totalDown = 0, totalUp = 0;
+		for (std::int32_t i = 0; i < (std::int32_t)_clients.size(); i++) {
+			auto& client = _clients[i];
+			totalDown += client.BytesDown;
+			totalUp += client.BytesUp;
+			LOGI("[Benchmark] Peer {}: down {:.2f} kB/s ({:.1f} packets/s, snapshot {} B avg.), up {:.2f} kB/s ({:.1f} packets/s){}",
+				i, client.BytesDown / 1024.0f / elapsedSecs, client.PacketsDown / elapsedSecs,
+				client.SnapshotCount > 0 ? client.SnapshotBytes / client.SnapshotCount : 0,
+				client.BytesUp / 1024.0f / elapsedSecs, client.PacketsUp / elapsedSecs,
+				client.State != ClientState::Playing ? " - not playing"_s : ""_s);
+		}
+
+		LOGI("[Benchmark] Total: down {:.2f} kB/s, up {:.2f} kB/s", totalDown / 1024.0f / elapsedSecs, totalUp / 1024.0f / elapsedSecs);
+	}
+}
+
+#endif
@@ -0,0 +1,163 @@
+#pragma once
+
+#if (defined(WITH_MULTIPLAYER) && !defined(DEATH_TARGET_EMSCRIPTEN)) || defined(DOXYGEN_GENERATING_OUTPUT)
+
+#include "ILoopbackHandler.h"
+#include "NetworkManager.h"
+#include "../../nCine/Base/TimeStamp.h"
+#include "../../nCine/Primitives/Vector2.h"
+
+#include <Containers/SmallVector.h>
+#include <Containers/String.h>
+#include <Threading/Spinlock.h>
+
+using namespace Death::Containers;
+using namespace Death::Threading;
+using namespace nCine;
+
+namespace Jazz2::Multiplayer
+{
+	class MpLevelHandler;
+
+	/**
+		@brief Measures how many peers a server tick can sustain
+
+		Connects synthetic in-process clients to a loopback server (see @ref NetworkManager::CreateLoopbackServer()).
+		Each of them goes through the regular handshake, spawns, and then keeps sending @ref ClientPacketType::PlayerUpdate
+		and @ref ClientPacketType::PlayerKeyPress and acknowledging snapshots like a real client. Once all of them
+		are playing, duration of each server tick and its phases and traffic of each peer are recorded and summarized
+		in the log at the end. No socket, audio or graphics is needed, so it can run on any headless machine.
+
+		It's built only into the standalone `DEDICATED_SERVER_BENCHMARK` flavor of the dedicated server.
+
+		@experimental
+	*/
+	class ServerBenchmark : public ILoopbackHandler
+	{
+	public:
+		/** @brief Phase of a server tick */
+		enum class TickPhase {
+			Clients,		/**< Synthetic clients process received packets and send their input */
+			BeginFrame,		/**< Deferred callbacks (incl. applying received packets) and @ref IStateHandler::OnBeginFrame() */
+			Update,			/**< Update of the scene (all actors) */
+			EndFrame,		/**< @ref IStateHandler::OnEndFrame() (incl. snapshots) */
+
+			Count
+		};
+
+		/** @brief Default number of synthetic clients */
+		static constexpr std::int32_t DefaultPeerCount = 16;
+		/** @brief Default duration of the measurement in seconds */
+		static constexpr std::int32_t DefaultDurationSecs = 30;
+
+		/**
+		 * @brief Creates a new instance
+		 *
+		 * @param peerCount     Number of synthetic clients
+		 * @param durationSecs  Duration of the measurement in seconds
+		 * @param clientData    Client data sent by each synthetic client on connect
+		 */
+		ServerBenchmark(std::int32_t peerCount, std::int32_t durationSecs, std::uint32_t clientData);
+
+		ServerBenchmark(const ServerBenchmark&) = delete;
+		ServerBenchmark& operator=(const ServerBenchmark&) = delete;
+
+		/**
+		 * @brief Writes a small synthetic arena to the cache and returns its level name
+		 *
+		 * The arena only contains a solid frame with a few platforms and spawn points, so the benchmark doesn't
+		 * depend on any level from the game. Its tile set has no meaningful diffuse. Returns an empty string on failure.
+		 */
+		static String CreateSyntheticLevel();
+
+		/** @brief Returns number of synthetic clients */
+		std::int32_t GetPeerCount() const {
+			return (std::int32_t)_clients.size();
+		}
+
+		/** @brief Starts a server tick, must be called at the beginning of a frame once the level is loaded */
+		void BeginTick(NetworkManager* networkManager);
+		/** @brief Ends the specified phase of the current tick, the next phase starts immediately */
+		void MarkPhase(TickPhase phase);
+		/** @brief Ends the current tick, returns `true` once the benchmark finished and the results were reported */
+		bool EndTick(MpLevelHandler* levelHandler);
+
+		void OnLoopbackPacket(const Peer& peer, NetworkChannel channel, std::uint8_t packetType, ArrayView<const std::uint8_t> data) override;
+		void OnLoopbackDisconnected(const Peer& peer, Reason reason) override;
+
+	private:
+		/** @brief Number of frames measured after all clients spawned before the results are recorded */
+		static constexpr std::int32_t WarmUpFrames = 120;
+		/** @brief Maximum number of frames to wait for all clients to spawn */
+		static constexpr std::int32_t SpawnTimeoutFrames = 60 * 60;
+		/** @brief Player updates are sent every n-th frame, like the real client */
+		static constexpr std::int32_t PlayerUpdateInterval = 2;
+		/** @brief Walking speed of synthetic clients in pixels per frame */
+		static constexpr float WalkSpeed = 2.0f;
+
+		enum class ClientState : std::uint8_t {
+			Disconnected,
+			Authenticating,
+			LoadingLevel,
+			WaitingForSpawn,
+			Playing
+		};
+
+		struct SyntheticClient {
+			Peer RemotePeer;
+			ClientState State = ClientState::Disconnected;
+			std::uint32_t PlayerIndex = 0;
+			Vector2f Pos;
+			Vector2f Speed;
+			std::uint64_t PressedKeys = 0;
+			std::uint64_t LastUpdateTime = 0;
+			SmallVector<std::uint32_t, 0> PendingAcks;		// Guarded by _lock
+
+			// Measured traffic, guarded by _lock
+			std::uint64_t BytesDown = 0;
+			std::uint64_t BytesUp = 0;
+			std::uint32_t PacketsDown = 0;
+			std::uint32_t PacketsUp = 0;
+			std::uint64_t SnapshotBytes = 0;
+			std::uint32_t SnapshotCount = 0;
+		};
+
+		/** @brief Packet that needs a response from the client, it can't be answered while the server is sending it */
+		struct PendingPacket {
+			std::uint32_t ClientIndex;
+			std::uint8_t PacketType;
+			SmallVector<std::uint8_t, 0> Data;
+		};
+
+		NetworkManager* _networkManager;
+		SmallVector<SyntheticClient, 0> _clients;
+		SmallVector<PendingPacket, 0> _pendingPackets;		// Guarded by _lock
+		SmallVector<PendingPacket, 0> _processingPackets;
+		Spinlock _lock;
+
+		std::int32_t _durationSecs;
+		std::uint32_t _clientData;
+		std::int32_t _frameCount;
+		std::int32_t _measureStartFrame;
+		bool _isMeasuring;
+		TimeStamp _phaseStart;
+		TimeStamp _measureStart;
+		float _currentTick[(std::int32_t)TickPhase::Count];
+		double _phaseTotals[(std::int32_t)TickPhase::Count];
+		double _snapshotTotal;
+		SmallVector<float, 0> _tickTimes;
+		std::uint32_t _maxActorCount;
+
+		void ConnectClients();
+		void ProcessPackets();
+		void ProcessPacket(SyntheticClient& client, std::uint8_t packetType, ArrayView<const std::uint8_t> data);
+		void UpdateClient(std::uint32_t index, SyntheticClient& client);
+		void SendToServer(SyntheticClient& client, NetworkChannel channel, std::uint8_t packetType, ArrayView<const std::uint8_t> data);
+		void SendPlayerAckWarped(SyntheticClient& client);
+		std::int32_t FindClient(const Peer& peer) const;
+		void StartMeasurement();
+		void ReportResults(float elapsedSecs);
+	};
+}
+
+#endif
@@ -96,6 +96,10 @@ namespace Jazz2
 	EpisodeEndOverwriteMode PreferencesCache::OverwriteEpisodeEnd = EpisodeEndOverwriteMode::Always;
 	char PreferencesCache::Language[6]{};
 	bool PreferencesCache::BypassCache = false;
+	bool PreferencesCache::FixedTimestep = false;
+	bool PreferencesCache::EnableRollback = false;
+	String PreferencesCache::ReplayRecordPath;
+	bool PreferencesCache::ParallelActorUpdate = false;
 	float PreferencesCache::MasterVolume = 0.7f;
 	float PreferencesCache::SfxVolume = 0.8f;
 	float PreferencesCache::MusicVolume = 0.4f;
@@ -1202,6 +1206,20 @@ namespace
 			auto arg = config.argv(i);
 			if (arg == "/bypass-cache"_s) {
 				BypassCache = true;
+			} else if (arg == "/fixed-timestep"_s) {
+				// Fixed-timestep simulation can be enabled only with command-line parameter
+				FixedTimestep = true;
+			} else if (arg == "/rollback"_s) {
+				// Rollback requires fixed-timestep simulation
+				FixedTimestep = true;
+				EnableRollback = true;
+			} else if (arg == "/record"_s && i + 1 < config.argc()) {
+				// Replay can be recorded only with fixed-timestep simulation
+				FixedTimestep = true;
+				ReplayRecordPath = config.argv(i + 1);
+				i++;
+			} else if (arg == "/parallel-update"_s) {
+				ParallelActorUpdate = true;
 			} else if (arg == "/cheats"_s) {
 				AllowCheats = true;
 			} else if (arg == "/cheats-lives"_s) {
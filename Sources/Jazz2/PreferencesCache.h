@@ -331,6 +331,14 @@ namespace Jazz2
 		static char Language[6];
 		/** @brief Whether the cache should be bypassed */
 		static bool BypassCache;
+		/** @brief Whether levels are simulated in fixed steps, see @ref LevelHandler::IsFixedTimestep() */
+		static bool FixedTimestep;
+		/** @brief Whether the last fixed steps can be simulated again, see @ref LevelHandler::IsRollbackEnabled() */
+		static bool EnableRollback;
+		/** @brief Path of a replay file the next started level is recorded to, see @ref ReplayRecorder */
+		static String ReplayRecordPath;
+		/** @brief Whether physics of eligible actors is updated on worker threads, see @ref Actors::ActorState::ParallelPhysics */
+		static bool ParallelActorUpdate;
 
 		// Sounds
 		/** @brief Master sound volume */
@@ -188,8 +188,13 @@ namespace Jazz2::Rendering
 
 		if (fullyLit) {
 			// Water-only combine: no lightmap is needed, the device applies just the per-row water effect
+#if defined(WITH_RHI_SOFTWARE)
+			RHI::Device::SetPendingSoftwareLighting(nullptr, 0, 1.0f, 0, 0, 1, vpX, vpY, vpW, vpH, ambR, ambG, ambB,
+				true, viewWaterLevel, waterTime, _owner->_cameraPos.Y);
+#else
 			RHI::Device::SetPendingSoftwareLighting(nullptr, 0, 0, 1, vpX, vpY, vpW, vpH, ambR, ambG, ambB,
 				true, viewWaterLevel, waterTime, _owner->_cameraPos.Y);
+#endif
 			return true;
 		}
 
@@ -217,6 +222,11 @@ namespace Jazz2::Rendering
 #endif
 		const std::int32_t lmW = (vpW + Scale - 1) / Scale;
 		const std::int32_t lmH = (vpH + Scale - 1) / Scale;
+#if defined(WITH_RHI_SOFTWARE)
+		// The software device evaluates the lightmap itself, only the texels each of its screen tiles samples and
+		// only from the lights that reach them (see SwTileRenderer::SubmitLighting()), so just the lights are kept
+		_swLights.clear();
+#else
 		const std::size_t texelCount = (std::size_t)lmW * lmH;
 		// R (intensity) starts at the ambient level everywhere; G (brightness core) starts at zero. The
 		// reset writes both channels in one sequential pass - clearing the whole buffer first and then
@@ -227,6 +237,7 @@ namespace Jazz2::Rendering
 			lightmap[i * 2] = ambientLevel;
 			lightmap[i * 2 + 1] = 0.0f;
 		}
+#endif
 
 		// World -> screen pixel mapping of the scene camera (orthographic, unit scale, Y flipped by the
 		// projection): col = worldX - camX + vpW/2; row = camY - worldY + vpH/2. The lightmap is viewport-local
@@ -242,7 +253,6 @@ namespace Jazz2::Rendering
 				continue;
 			}
 			const float radiusNearNorm = light.RadiusNear / radiusFar;
-			const float denom = (1.0f - radiusNearNorm);
 			// Clamp each light's contribution to be non-negative, mirroring the GL/D3D11 lighting path: that
 			// buffer is an unsigned RG8 render target and blending clamps the shader's source colour to [0,1]
 			// before the additive blend, so a light whose Intensity/Brightness has ramped below zero (e.g. the
@@ -264,6 +274,23 @@ namespace Jazz2::Rendering
 			const std::int32_t y0 = std::max<std::int32_t>(0, (std::int32_t)(cy - rLm));
 			const std::int32_t y1 = std::min(lmH - 1, (std::int32_t)(cy + rLm));
 
+#if defined(WITH_RHI_SOFTWARE)
+			if (x0 > x1 || y0 > y1) {
+				continue;
+			}
+			RHI::Software::SwLight& swLight = _swLights.emplace_back();
+			swLight.CenterX = cx;
+			swLight.CenterY = cy;
+			swLight.Radius = rLm;
+			swLight.RadiusNearNorm = radiusNearNorm;
+			swLight.Intensity = intensity;
+			swLight.Brightness = brightness;
+			swLight.MinX = x0;
+			swLight.MinY = y0;
+			swLight.MaxX = x1;
+			swLight.MaxY = y1;
+#else
+			const float denom = (1.0f - radiusNearNorm);
 			for (std::int32_t y = y0; y <= y1; y++) {
 				const float dy = (y - cy) / rLm;
 				float* texelRow = &_swLightmap[((std::size_t)y * lmW + x0) * 2];
@@ -284,6 +311,7 @@ namespace Jazz2::Rendering
 					texelRow[1] += strength * brightness;
 				}
 			}
+#endif
 		}
 
 		// Hand the finished lightmap, this viewport's rectangle and the water parameters to the software device.
@@ -292,8 +320,13 @@ namespace Jazz2::Rendering
 		// the Draw phase, once the scene is in the screen buffer and before the HUD. The lightmap pointer must
 		// outlive this call: _swLightmap is a member reused across frames, and the device consumes the entry in
 		// the same frame's Draw phase (before the next PrepareSoftwareLighting reassigns it).
+#if defined(WITH_RHI_SOFTWARE)
+		RHI::Device::SetPendingSoftwareLighting(_swLights.data(), std::int32_t(_swLights.size()), ambientLevel, lmW, lmH, Scale,
+			vpX, vpY, vpW, vpH, ambR, ambG, ambB, viewHasWater, viewWaterLevel, waterTime, _owner->_cameraPos.Y);
+#else
 		RHI::Device::SetPendingSoftwareLighting(_swLightmap.data(), lmW, lmH, Scale, vpX, vpY, vpW, vpH, ambR, ambG, ambB,
 			viewHasWater, viewWaterLevel, waterTime, _owner->_cameraPos.Y);
+#endif
 		return true;
 	}
 #endif
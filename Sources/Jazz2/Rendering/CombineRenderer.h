@@ -11,6 +11,9 @@
 #if !defined(RHI_CAP_SHADERS) || !defined(RHI_CAP_FRAMEBUFFERS)
 #	include "../LightEmitter.h"
 #	include <vector>
+#	if defined(WITH_RHI_SOFTWARE)
+#		include "../../nCine/Graphics/RHI/Software/SwRaster.h"
+#	endif
 #endif
 
 using namespace nCine;
@@ -59,14 +62,20 @@ namespace Jazz2::Rendering
 		// alive after the Visit phase (the software device reads it during the later Draw phase), so it is a
 		// per-viewport member rather than a stack buffer.
 		SmallVector<LightEmitter, 0> _swLightsCache;
+#	if defined(WITH_RHI_SOFTWARE)
+		// Lights in lightmap space, the software device evaluates the lightmap itself, tile by tile
+		SmallVector<RHI::Software::SwLight, 0> _swLights;
+#	else
 		// Half-resolution accumulation buffer, 2 floats/texel: R=intensity, G=brightness
 		SmallVector<float, 0> _swLightmap;
+#	endif
 
 		/**
-		 * @brief Builds the half-resolution dynamic lightmap on the CPU and hands it plus the water parameters to the software device (software backend)
+		 * @brief Builds the half-resolution dynamic lighting on the CPU and hands it plus the water parameters to the software device (software backend)
 		 *
-		 * Runs in the Visit (queue-building) phase: collects the light emitters, splats them into @ref _swLightmap and
-		 * submits the map plus this viewport's rectangle, ambient colour and water parameters (waterline, wave time,
+		 * Runs in the Visit (queue-building) phase: collects the light emitters, splats them into @ref _swLightmap (or,
+		 * on the software RHI, only converts them to lightmap space, the device evaluates the map tile by tile) and
+		 * submits them plus this viewport's rectangle, ambient colour and water parameters (waterline, wave time,
 		 * camera Y) to the device (SetPendingSoftwareLighting). The device applies the actual in-place combine -
 		 * dynamic lighting and the lightweight per-row water effect that replaces the CombineWithWater shader
 		 * variants - during the Draw phase, after the scene has been rasterized into the screen buffer and before
@@ -206,7 +206,10 @@ namespace Jazz2::Rendering
 
 		// The position to focus on
 		Vector2i halfView = GetViewportSize() / 2;
-		Vector2f focusPos = _targetActor->GetPos();
+		// In fixed-timestep mode, the camera follows the target as it's rendered between two steps
+		Vector2f focusPos = (_levelHandler->IsFixedTimestep()
+			? _targetActor->GetInterpolatedPos(_levelHandler->GetInterpolationFactor())
+			: _targetActor->GetPos());
 
 		bool overridePosX = false, overridePosY = false;
 		// TODO: Not working correctly on some platforms
@@ -280,8 +283,8 @@ namespace Jazz2::Rendering
 				_shakeOffset = Vector2f::Zero;
 			} else {
 				float shakeFactor = 0.1f * timeMult;
-				_shakeOffset.X = lerp(_shakeOffset.X, nCine::Random().NextFloat(-0.2f, 0.2f) * halfView.X, shakeFactor) * std::min(_shakeDuration * 0.1f, 1.0f);
-				_shakeOffset.Y = lerp(_shakeOffset.Y, nCine::Random().NextFloat(-0.2f, 0.2f) * halfView.Y, shakeFactor) * std::min(_shakeDuration * 0.1f, 1.0f);
+				_shakeOffset.X = lerp(_shakeOffset.X, _shakeRandom.NextFloat(-0.2f, 0.2f) * halfView.X, shakeFactor) * std::min(_shakeDuration * 0.1f, 1.0f);
+				_shakeOffset.Y = lerp(_shakeOffset.Y, _shakeRandom.NextFloat(-0.2f, 0.2f) * halfView.Y, shakeFactor) * std::min(_shakeDuration * 0.1f, 1.0f);
 			}
 		}
 
@@ -5,6 +5,8 @@
 #include "CombineRenderer.h"
 #include "BlurRenderPass.h"
 
+#include "../../nCine/Base/Random.h"
+
 namespace Jazz2::Rendering
 {
 	/**
@@ -52,6 +54,8 @@ namespace Jazz2::Rendering
 		float _cameraViewCenterY;
 		float _shakeDuration;
 		Vector2f _shakeOffset;
+		// Camera shake runs once per rendered frame, so it must not draw from the seeded simulation generator
+		RandomGenerator _shakeRandom;
 		float _ambientLightTarget;
 		Vector4f _ambientLight;
 #endif
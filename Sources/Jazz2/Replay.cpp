@@ -0,0 +1,306 @@
+﻿#include "Replay.h"
+#include "ContentFileTypes.h"
+
+#include "../nCine/Base/FrameTimer.h"
+
+#include <algorithm>
+
+namespace Jazz2
+{
+	namespace
+	{
+		constexpr std::uint64_t FileSignature = 0x2095A59FF0BFBBEF;
+		/** @brief Player index that marks the end of the recording */
+		constexpr std::uint8_t EndOfReplay = 0xFF;
+		/** @brief Player index that marks checksum of the simulation state */
+		constexpr std::uint8_t ChecksumRecord = 0xFE;
+	}
+
+	ReplayRecorder::ReplayRecorder(std::unique_ptr<Stream> dest, const LevelInitialization& levelInit, std::uint64_t seed)
+		: _file(std::move(dest)), _lastStep(0), _stepCount(0), _lastPressedActions{}, _lastMovement{}
+	{
+		if (_file == nullptr || !_file->IsValid()) {
+			return;
+		}
+
+		_file->WriteValueAsLE<std::uint64_t>(FileSignature);
+		_file->WriteValue<std::uint8_t>(ContentFileType::Replay);
+		_file->WriteValueAsLE<std::uint16_t>(FileVersion);
+
+		_body = std::make_unique<DeflateWriter>(*_file);
+
+		std::uint8_t flags = 0;
+		if (levelInit.IsReforged) {
+			flags |= 0x01;
+		}
+		if (levelInit.CheatsUsed) {
+			flags |= 0x02;
+		}
+		_body->WriteValue<std::uint8_t>(flags);
+		_body->WriteValue<std::uint8_t>((std::uint8_t)levelInit.Difficulty);
+		_body->WriteValue<std::uint8_t>((std::uint8_t)levelInit.LastExitType);
+		_body->WriteValue<std::uint8_t>((std::uint8_t)levelInit.LevelName.size());
+		_body->Write(levelInit.LevelName.data(), (std::int64_t)levelInit.LevelName.size());
+		_body->WriteValueAsLE<std::uint64_t>(seed);
+
+		_body->WriteValue<std::uint8_t>((std::uint8_t)levelInit.GetPlayerCount());
+		for (std::int32_t i = 0; i < LevelInitialization::MaxPlayerCount; i++) {
+			const auto& carryOver = levelInit.PlayerCarryOvers[i];
+			if (carryOver.Type == PlayerType::None) {
+				continue;
+			}
+
+			_body->WriteValue<std::uint8_t>((std::uint8_t)i);
+			_body->WriteValue<std::uint8_t>((std::uint8_t)carryOver.Type);
+			_body->WriteValue<std::uint8_t>((std::uint8_t)carryOver.CurrentWeapon);
+			_body->WriteValue<std::uint8_t>(carryOver.Lives);
+			_body->WriteValue<std::uint8_t>(carryOver.FoodEaten);
+			_body->WriteVariableInt32(carryOver.Score);
+			for (std::int32_t j = 0; j < std::int32_t(carryOver.Gems.size()); j++) {
+				_body->WriteVariableInt32(carryOver.Gems[j]);
+			}
+			for (std::int32_t j = 0; j < PlayerCarryOver::WeaponCount; j++) {
+				_body->WriteVariableUint32(carryOver.Ammo[j]);
+			}
+			for (std::int32_t j = 0; j < PlayerCarryOver::WeaponCount; j++) {
+				_body->WriteValue<std::uint8_t>(carryOver.WeaponUpgrades[j]);
+			}
+		}
+	}
+
+	ReplayRecorder::~ReplayRecorder()
+	{
+		Finish(_stepCount);
+	}
+
+	void ReplayRecorder::RecordInput(std::uint32_t step, std::int32_t playerIndex, std::uint64_t pressedActions, Vector2f requiredMovement)
+	{
+		// Input of all players is reported in every step, even if it doesn't change
+		_stepCount = std::max(_stepCount, step + 1);
+
+		if (_body == nullptr || (_lastPressedActions[playerIndex] == pressedActions && _lastMovement[playerIndex] == requiredMovement)) {
+			return;
+		}
+
+		_lastPressedActions[playerIndex] = pressedActions;
+		_lastMovement[playerIndex] = requiredMovement;
+
+		_body->WriteVariableUint32(step - _lastStep);
+		_body->WriteValue<std::uint8_t>((std::uint8_t)playerIndex);
+		_body->WriteVariableUint64(pressedActions);
+		_body->WriteValueAsLE<float>(requiredMovement.X);
+		_body->WriteValueAsLE<float>(requiredMovement.Y);
+		_lastStep = step;
+	}
+
+	void ReplayRecorder::RecordChecksum(std::uint32_t step, std::uint64_t checksum)
+	{
+		if (_body == nullptr) {
+			return;
+		}
+
+		_body->WriteVariableUint32(step - _lastStep);
+		_body->WriteValue<std::uint8_t>(ChecksumRecord);
+		_body->WriteValueAsLE<std::uint64_t>(checksum);
+		_lastStep = step;
+	}
+
+	void ReplayRecorder::Finish(std::uint32_t stepCount)
+	{
+		if (_body == nullptr) {
+			return;
+		}
+
+		_body->WriteVariableUint32(stepCount - _lastStep);
+		_body->WriteValue<std::uint8_t>(EndOfReplay);
+		_body = nullptr;
+		_file = nullptr;
+
+		LOGI("Replay with {} steps recorded", stepCount);
+	}
+
+	ReplayPlayer::ReplayPlayer(std::unique_ptr<Stream> src)
+		: _file(std::move(src)), _seed(0), _nextChangeStep(0), _nextChangePlayer(EndOfReplay), _nextPressedActions(0),
+			_nextChecksum(0), _expectedChecksumStep(0), _expectedChecksum(0), _hasExpectedChecksum(false), _checksumsPassed(0),
+			_checksumsFailed(0), _firstFailedStep(0), _pressedActions{}, _movement{}, _parallelPhaseTotal(0.0), _serialPhaseTotal(0.0)
+	{
+		if (_file == nullptr || !_file->IsValid() || _file->GetSize() < 16) {
+			return;
+		}
+
+		std::uint64_t signature = _file->ReadValueAsLE<std::uint64_t>();
+		std::uint8_t fileType = _file->ReadValue<std::uint8_t>();
+		std::uint16_t version = _file->ReadValueAsLE<std::uint16_t>();
+		if (signature != FileSignature || fileType != ContentFileType::Replay || version != ReplayRecorder::FileVersion) {
+			LOGE("Replay is not supported");
+			return;
+		}
+
+		_body = std::make_unique<DeflateStream>(*_file);
+
+		std::uint8_t flags = _body->ReadValue<std::uint8_t>();
+		_levelInit.IsReforged = (flags & 0x01) != 0;
+		_levelInit.CheatsUsed = (flags & 0x02) != 0;
+		_levelInit.Difficulty = (GameDifficulty)_body->ReadValue<std::uint8_t>();
+		_levelInit.LastExitType = (ExitType)_body->ReadValue<std::uint8_t>();
+
+		std::uint8_t levelNameLength = _body->ReadValue<std::uint8_t>();
+		_levelInit.LevelName = String(NoInit, levelNameLength);
+		_body->Read(_levelInit.LevelName.data(), levelNameLength);
+		_seed = _body->ReadValueAsLE<std::uint64_t>();
+
+		for (std::int32_t i = 0; i < LevelInitialization::MaxPlayerCount; i++) {
+			_levelInit.PlayerCarryOvers[i].Type = PlayerType::None;
+		}
+
+		std::uint8_t playerCount = _body->ReadValue<std::uint8_t>();
+		for (std::uint8_t i = 0; i < playerCount; i++) {
+			std::uint8_t playerIndex = _body->ReadValue<std::uint8_t>();
+			if (playerIndex >= LevelInitialization::MaxPlayerCount) {
+				LOGE("Replay is corrupted");
+				_body = nullptr;
+				return;
+			}
+
+			auto& carryOver = _levelInit.PlayerCarryOvers[playerIndex];
+			carryOver.Type = (PlayerType)_body->ReadValue<std::uint8_t>();
+			carryOver.CurrentWeapon = (WeaponType)_body->ReadValue<std::uint8_t>();
+			carryOver.Lives = _body->ReadValue<std::uint8_t>();
+			carryOver.FoodEaten = _body->ReadValue<std::uint8_t>();
+			carryOver.Score = _body->ReadVariableInt32();
+			for (std::int32_t j = 0; j < std::int32_t(carryOver.Gems.size()); j++) {
+				carryOver.Gems[j] = _body->ReadVariableInt32();
+			}
+			for (std::int32_t j = 0; j < PlayerCarryOver::WeaponCount; j++) {
+				carryOver.Ammo[j] = (std::uint16_t)_body->ReadVariableUint32();
+			}
+			for (std::int32_t j = 0; j < PlayerCarryOver::WeaponCount; j++) {
+				carryOver.WeaponUpgrades[j] = _body->ReadValue<std::uint8_t>();
+			}
+		}
+
+		ReadNextChange();
+	}
+
+	bool ReplayPlayer::FetchStep(std::uint32_t step)
+	{
+		if (_body == nullptr) {
+			return false;
+		}
+
+		while (_nextChangeStep <= step) {
+			if (_nextChangePlayer == EndOfReplay) {
+				return false;
+			}
+
+			if (_nextChangePlayer == ChecksumRecord) {
+				_expectedChecksumStep = _nextChangeStep;
+				_expectedChecksum = _nextChecksum;
+				_hasExpectedChecksum = true;
+			} else {
+				_pressedActions[_nextChangePlayer] = _nextPressedActions;
+				_movement[_nextChangePlayer] = _nextMovement;
+			}
+			ReadNextChange();
+		}
+
+		if (_stepTimes.empty()) {
+			_startTime = TimeStamp::now();
+		}
+		return true;
+	}
+
+	bool ReplayPlayer::VerifyChecksum(std::uint32_t step, std::uint64_t checksum)
+	{
+		if (!_hasExpectedChecksum || _expectedChecksumStep != step) {
+			return true;
+		}
+
+		_hasExpectedChecksum = false;
+		if (checksum == _expectedChecksum) {
+			_checksumsPassed++;
+			return true;
+		}
+
+		if (_checksumsFailed == 0) {
+			_firstFailedStep = step;
+			LOGE("[Replay] Simulation diverged from the recording before step {}", step);
+		}
+		_checksumsFailed++;
+		return false;
+	}
+
+	void ReplayPlayer::AddStepTime(float microseconds)
+	{
+		_stepTimes.push_back(microseconds);
+	}
+
+	void ReplayPlayer::AddActorUpdateTime(float parallelMicroseconds, float serialMicroseconds)
+	{
+		_parallelPhaseTotal += (double)parallelMicroseconds;
+		_serialPhaseTotal += (double)serialMicroseconds;
+	}
+
+	void ReplayPlayer::ReportResults()
+	{
+		if (_checksumsFailed > 0) {
+			LOGE("[Replay] Playback is not in sync with the recording, {} of {} checksums differ, first before step {}",
+				_checksumsFailed, _checksumsPassed + _checksumsFailed, _firstFailedStep);
+		} else if (_checksumsPassed > 0) {
+			LOGI("[Replay] Playback is in sync with the recording, all {} checksums match", _checksumsPassed);
+		} else {
+			LOGW("[Replay] Recording contains no checksums, playback cannot be verified");
+		}
+
+		std::size_t stepCount = _stepTimes.size();
+		if (stepCount == 0) {
+			LOGW("[Replay] No steps were simulated");
+			return;
+		}
+
+		float elapsedSecs = _startTime.secondsSince();
+
+		double total = 0.0;
+		for (float stepTime : _stepTimes) {
+			total += (double)stepTime;
+		}
+
+		std::sort(_stepTimes.begin(), _stepTimes.end());
+		auto percentile = [this, stepCount](float p) {
+			std::size_t i = std::min((std::size_t)(p * (stepCount - 1) + 0.5f), stepCount - 1);
+			return _stepTimes[i] / 1000.0f;
+		};
+
+		float mean = (float)(total / stepCount) / 1000.0f;
+		float budget = FrameTimer::SecondsPerFrame * 1000.0f;
+
+		LOGI("[Replay] {} steps of \"{}\" in {:.2f} s ({:.1f}x real time)", stepCount, _levelInit.LevelName, elapsedSecs,
+			stepCount * FrameTimer::SecondsPerFrame / std::max(elapsedSecs, 0.001f));
+		LOGI("[Replay] Step time: mean {:.3f} ms ({:.1f} % of budget), p50 {:.3f} ms, p90 {:.3f} ms, p99 {:.3f} ms, max {:.3f} ms",
+			mean, mean * 100.0f / budget, percentile(0.5f), percentile(0.9f), percentile(0.99f), _stepTimes[stepCount - 1] / 1000.0f);
+		LOGI("[Replay] Actor update: parallel phase mean {:.3f} ms, serial phase mean {:.3f} ms",
+			(float)(_parallelPhaseTotal / stepCount) / 1000.0f, (float)(_serialPhaseTotal / stepCount) / 1000.0f);
+	}
+
+	void ReplayPlayer::ReadNextChange()
+	{
+		_nextChangeStep += _body->ReadVariableUint32();
+
+		std::uint8_t playerIndex;
+		if (_body->Read(&playerIndex, sizeof(playerIndex)) != sizeof(playerIndex) ||
+			(playerIndex >= Input::ControlScheme::MaxSupportedPlayers && playerIndex != EndOfReplay && playerIndex != ChecksumRecord)) {
+			// Recording was not finished properly, play it back as far as possible
+			_nextChangePlayer = EndOfReplay;
+			return;
+		}
+
+		_nextChangePlayer = playerIndex;
+		if (playerIndex == ChecksumRecord) {
+			_nextChecksum = _body->ReadValueAsLE<std::uint64_t>();
+		} else if (playerIndex != EndOfReplay) {
+			_nextPressedActions = _body->ReadVariableUint64();
+			_nextMovement.X = _body->ReadValueAsLE<float>();
+			_nextMovement.Y = _body->ReadValueAsLE<float>();
+		}
+	}
+}
@@ -0,0 +1,153 @@
+﻿#pragma once
+
+#include "LevelInitialization.h"
+#include "Input/ControlScheme.h"
+#include "../nCine/Base/TimeStamp.h"
+#include "../nCine/Primitives/Vector2.h"
+
+#include <memory>
+
+#include <Containers/SmallVector.h>
+#include <IO/Stream.h>
+#include <IO/Compression/DeflateStream.h>
+
+using namespace Death::Containers;
+using namespace Death::IO;
+using namespace Death::IO::Compression;
+using namespace nCine;
+
+namespace Jazz2
+{
+	/**
+		@brief Records input of a level simulated with fixed timestep to a replay file
+
+		The file contains only what is needed to simulate the level again --- level name, difficulty, seed of the shared
+		random generator and carry-over of all players, followed by input of all players in each step (see
+		@ref LevelHandler::IsFixedTimestep()). Input is written only when it changes and the stream is compressed,
+		so a player holding the same keys costs nothing. Checksums of the simulation state are interleaved every
+		@ref ChecksumInterval steps and at the end, so @ref ReplayPlayer can verify that the playback reaches the
+		same state as the recording.
+	*/
+	class ReplayRecorder
+	{
+	public:
+		/** @brief Version of the file format */
+		static constexpr std::uint16_t FileVersion = 2;
+		/** @brief Number of steps between two checksums of the simulation state */
+		static constexpr std::uint32_t ChecksumInterval = 60;
+
+		/** @brief Creates a new recording, header is written to the file immediately */
+		ReplayRecorder(std::unique_ptr<Stream> dest, const LevelInitialization& levelInit, std::uint64_t seed);
+		~ReplayRecorder();
+
+		ReplayRecorder(const ReplayRecorder&) = delete;
+		ReplayRecorder& operator=(const ReplayRecorder&) = delete;
+
+		/** @brief Returns `true` if the file could be opened */
+		bool IsValid() const {
+			return (_body != nullptr);
+		}
+
+		/** @brief Records input of the specified player used to simulate the specified step */
+		void RecordInput(std::uint32_t step, std::int32_t playerIndex, std::uint64_t pressedActions, Vector2f requiredMovement);
+		/** @brief Records checksum of the simulation state before the specified step is simulated */
+		void RecordChecksum(std::uint32_t step, std::uint64_t checksum);
+		/** @brief Finishes the recording, @p stepCount is number of all simulated steps */
+		void Finish(std::uint32_t stepCount);
+
+	private:
+		std::unique_ptr<Stream> _file;
+		std::unique_ptr<DeflateWriter> _body;
+		std::uint32_t _lastStep;
+		std::uint32_t _stepCount;
+		std::uint64_t _lastPressedActions[Input::ControlScheme::MaxSupportedPlayers];
+		Vector2f _lastMovement[Input::ControlScheme::MaxSupportedPlayers];
+	};
+
+	/**
+		@brief Plays back input recorded by @ref ReplayRecorder
+
+		Provides the level initialization and the seed the recording started with, and then input of all players step
+		by step. Checksums of the simulation state stored in the recording are compared with the playback, so the first
+		step where the simulation diverged is reported. Duration of each simulated step can be reported back, so the
+		playback also serves as a benchmark of the simulation, results are summarized in the log once the recording ends.
+	*/
+	class ReplayPlayer
+	{
+	public:
+		/** @brief Opens a recording, see @ref IsValid() */
+		explicit ReplayPlayer(std::unique_ptr<Stream> src);
+
+		ReplayPlayer(const ReplayPlayer&) = delete;
+		ReplayPlayer& operator=(const ReplayPlayer&) = delete;
+
+		/** @brief Returns `true` if the recording is supported and can be played back */
+		bool IsValid() const {
+			return (_body != nullptr);
+		}
+
+		/** @brief Returns initialization of the recorded level */
+		const LevelInitialization& GetLevelInitialization() const {
+			return _levelInit;
+		}
+		/** @brief Returns seed of the shared random generator */
+		std::uint64_t GetSeed() const {
+			return _seed;
+		}
+
+		/** @brief Reads input of the specified step, returns `false` once the recording ended */
+		bool FetchStep(std::uint32_t step);
+		/** @brief Returns actions pressed by the specified player in the last fetched step */
+		std::uint64_t GetPressedActions(std::int32_t playerIndex) const {
+			return _pressedActions[playerIndex];
+		}
+		/** @brief Returns movement of the specified player in the last fetched step */
+		Vector2f GetRequiredMovement(std::int32_t playerIndex) const {
+			return _movement[playerIndex];
+		}
+
+		/**
+		 * @brief Compares checksum of the simulation state before the specified step with the recording
+		 *
+		 * Must be called after @ref FetchStep() with the same step, returns `false` if the recording contains
+		 * a different checksum for the step.
+		 */
+		bool VerifyChecksum(std::uint32_t step, std::uint64_t checksum);
+		/** @brief Returns `true` if all checksums verified so far matched the recording */
+		bool IsInSync() const {
+			return (_checksumsFailed == 0);
+		}
+
+		/** @brief Adds duration of one simulated step to the results */
+		void AddStepTime(float microseconds);
+		/** @brief Adds duration of the parallel and serial phase of actor update in one simulated step to the results */
+		void AddActorUpdateTime(float parallelMicroseconds, float serialMicroseconds);
+		/** @brief Summarizes the results in the log */
+		void ReportResults();
+
+	private:
+		std::unique_ptr<Stream> _file;
+		std::unique_ptr<DeflateStream> _body;
+		LevelInitialization _levelInit;
+		std::uint64_t _seed;
+		std::uint32_t _nextChangeStep;
+		std::int32_t _nextChangePlayer;
+		std::uint64_t _nextPressedActions;
+		Vector2f _nextMovement;
+		std::uint64_t _nextChecksum;
+		std::uint32_t _expectedChecksumStep;
+		std::uint64_t _expectedChecksum;
+		bool _hasExpectedChecksum;
+		std::uint32_t _checksumsPassed;
+		std::uint32_t _checksumsFailed;
+		std::uint32_t _firstFailedStep;
+		std::uint64_t _pressedActions[Input::ControlScheme::MaxSupportedPlayers];
+		Vector2f _movement[Input::ControlScheme::MaxSupportedPlayers];
+		TimeStamp _startTime;
+		SmallVector<float, 0> _stepTimes;
+		double _parallelPhaseTotal;
+		double _serialPhaseTotal;
+
+		void ReadNextChange();
+	};
+}
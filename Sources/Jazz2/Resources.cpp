@@ -1,6 +1,8 @@
 ﻿#include "Resources.h"
 #include "ContentResolver.h"
 
+#include "../nCine/Base/Random.h"
+
 namespace Jazz2::Resources
 {
 	GenericGraphicResource::GenericGraphicResource() noexcept
@@ -27,6 +29,16 @@ namespace Jazz2::Resources
 	{
 	}
 
+	GenericSoundResource* SoundResource::PickVariant() const noexcept
+	{
+		static RandomGenerator variantRandom;
+
+		if (Buffers.empty()) {
+			return nullptr;
+		}
+		return Buffers[Buffers.size() > 1 ? variantRandom.Next(0, (std::uint32_t)Buffers.size()) : 0];
+	}
+
 	Metadata::Metadata() noexcept
 		: Flags(MetadataFlags::None)
 	{
@@ -294,6 +294,14 @@ namespace Jazz2::Resources
 
 		/** @brief Creates a new instance */
 		SoundResource() noexcept;
+
+		/**
+		 * @brief Returns a randomly chosen variant, or `nullptr` if no buffer is loaded (e.g., in headless mode)
+		 *
+		 * The variant is chosen by a generator separate from the shared one, so the simulation doesn't depend on
+		 * whether sounds are loaded or played.
+		 */
+		GenericSoundResource* PickVariant() const noexcept;
 	};
 
 	/**
@@ -464,12 +472,11 @@ namespace Jazz2::Resources
 		ShieldLightning,					/**< Lightning shield effect */
 		BatchedShieldLightning,				/**< Batched variant of @ref ShieldLightning */
 
-#if defined(TILEMAP_USE_SINGLE_DRAW)
-		// Whole-layer tile mesh: one draw call per tile layer instead of one per visible tile. Reads per-vertex
-		// position/texcoords/alpha; `TileMapMeshPalette` additionally recolors indexed tilesets via the palette texture.
+		// Mesh of textured quads: one draw call per tile layer (TILEMAP_USE_SINGLE_DRAW) or per string instead of one
+		// per visible tile or glyph. Reads per-vertex position/texcoords/color; `TileMapMeshPalette` additionally
+		// recolors indexed tilesets via the palette texture.
 		TileMapMesh,						/**< Tile-map aggregation shader */
 		TileMapMeshPalette,					/**< Batched variant of @ref TileMapMesh */
-#endif
 
 #if !defined(DISABLE_RESCALE_SHADERS)
 		ResizeHQ2x,							/**< HQ2× upscaling */
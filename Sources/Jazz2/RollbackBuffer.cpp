@@ -0,0 +1,67 @@
+﻿#include "RollbackBuffer.h"
+
+namespace Jazz2
+{
+	RollbackBuffer::Snapshot::Snapshot()
+		: Step(0), IsValid(false), Inputs{}, EventJournalPos(0), Data(64 * 1024)
+	{
+	}
+
+	RollbackBuffer::RollbackBuffer()
+	{
+	}
+
+	RollbackBuffer::Snapshot& RollbackBuffer::Acquire(std::uint32_t step)
+	{
+		// Steps are consecutive, so each of them has its own slot until it's Capacity steps old
+		Snapshot& snapshot = _slots[step % Capacity];
+		Release(snapshot);
+		snapshot.Step = step;
+		snapshot.IsValid = true;
+		return snapshot;
+	}
+
+	RollbackBuffer::Snapshot* RollbackBuffer::Find(std::uint32_t step)
+	{
+		Snapshot& snapshot = _slots[step % Capacity];
+		return (snapshot.IsValid && snapshot.Step == step ? &snapshot : nullptr);
+	}
+
+	RollbackBuffer::Snapshot* RollbackBuffer::GetOldest()
+	{
+		Snapshot* oldest = nullptr;
+		for (auto& snapshot : _slots) {
+			if (snapshot.IsValid && (oldest == nullptr || snapshot.Step < oldest->Step)) {
+				oldest = &snapshot;
+			}
+		}
+		return oldest;
+	}
+
+	void RollbackBuffer::DiscardFrom(std::uint32_t step)
+	{
+		for (auto& snapshot : _slots) {
+			if (snapshot.IsValid && snapshot.Step >= step) {
+				Release(snapshot);
+			}
+		}
+	}
+
+	void RollbackBuffer::Clear()
+	{
+		for (auto& snapshot : _slots) {
+			Release(snapshot);
+		}
+	}
+
+	void RollbackBuffer::Release(Snapshot& snapshot)
+	{
+		// Buffers are kept allocated, only references are released
+		snapshot.IsValid = false;
+		snapshot.Actors.clear();
+		snapshot.TransitionCallbacks.clear();
+		snapshot.RootChildren.clear();
+		snapshot.GeneratorActors.clear();
+		snapshot.ActiveBoss = nullptr;
+	}
+}
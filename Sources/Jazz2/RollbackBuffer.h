@@ -0,0 +1,104 @@
+﻿#pragma once
+
+#include "Actors/ActorBase.h"
+#include "Collisions/DynamicTreeBroadPhase.h"
+#include "Input/ControlScheme.h"
+#include "../nCine/Base/Random.h"
+
+#include <memory>
+
+#include <Containers/SmallVector.h>
+#include <IO/MemoryStream.h>
+
+using namespace Death::Containers;
+using namespace Death::IO;
+using namespace nCine;
+
+namespace Jazz2
+{
+	/**
+		@brief Ring of preallocated snapshots of the level simulation for rollback
+
+		Each slot holds the whole simulation state as it was before a fixed step (see @ref LevelHandler::IsFixedTimestep())
+		together with the input that step was simulated with. Actors are not copied, the slot only keeps references to
+		them, so destroyed actors stay alive and can be put back, and their state is serialized to a stream that is
+		reused across frames. Broad-phase is copied as a whole, so proxy IDs held by actors stay valid. Once all slots
+		are used, the oldest one is overwritten, so only the last @ref Capacity steps can be rolled back.
+
+		Because snapshots keep destroyed actors alive, the level removes destroyed actors from the scene immediately
+		while rollback or frame states (see @ref LevelHandler::SaveFrameState()) are in use. Otherwise, an actor leaves
+		the scene only when its last reference is released, so a destroyed actor that is still held by another one
+		(e.g. a part of a boss) stays in the scene until then.
+	*/
+	class RollbackBuffer
+	{
+	public:
+		/** @brief Number of steps that can be rolled back */
+		static constexpr std::int32_t Capacity = 8;
+
+		/** @brief Input of a player in one step */
+		struct PlayerInputState {
+			/** @brief Bitmask of actions pressed in the step */
+			std::uint64_t PressedActions;
+			/** @brief Bitmask of actions pressed in the previous step */
+			std::uint64_t PressedActionsLast;
+			/** @brief Desired movement vector */
+			Vector2f RequiredMovement;
+			/** @brief Movement vector applied while the input is frozen */
+			Vector2f FrozenMovement;
+			/** @brief Whether the input is frozen */
+			bool Frozen;
+		};
+
+		/** @brief State of the simulation before one step */
+		struct Snapshot {
+			/** @brief Index of the step */
+			std::uint32_t Step;
+			/** @brief Whether the slot contains a snapshot */
+			bool IsValid;
+			/** @brief Input the step was simulated with, it can be replaced by late input */
+			PlayerInputState Inputs[Input::ControlScheme::MaxSupportedPlayers];
+			/** @brief All actors in the update order, also keeps them alive */
+			SmallVector<std::shared_ptr<Actors::ActorBase>, 0> Actors;
+			/** @brief Completion callbacks of running transitions, one for each actor in @ref Actors */
+			SmallVector<std::shared_ptr<Function<void()>>, 0> TransitionCallbacks;
+			/** @brief Children of the root node in their order, all of them are either actors or persistent */
+			SmallVector<SceneNode*, 0> RootChildren;
+			/** @brief Actors spawned by generators */
+			SmallVector<std::shared_ptr<Actors::ActorBase>, 0> GeneratorActors;
+			/** @brief Active boss */
+			std::shared_ptr<Actors::ActorBase> ActiveBoss;
+			/** @brief Copy of the broad-phase */
+			Collisions::DynamicTreeBroadPhase Collisions;
+			/** @brief State of the shared random generator */
+			RandomGenerator Random;
+			/** @brief Position in the journal of consumed event tiles, see @ref Events::EventMap::SaveSnapshot() */
+			std::uint64_t EventJournalPos;
+			/** @brief Serialized state of the level, the tile map, the event map and all actors */
+			MemoryStream Data;
+
+			Snapshot();
+		};
+
+		RollbackBuffer();
+
+		RollbackBuffer(const RollbackBuffer&) = delete;
+		RollbackBuffer& operator=(const RollbackBuffer&) = delete;
+
+		/** @brief Returns a slot for the specified step, the oldest snapshot is discarded if no slot is free */
+		Snapshot& Acquire(std::uint32_t step);
+		/** @brief Returns snapshot of the specified step, or `nullptr` if it's not available */
+		Snapshot* Find(std::uint32_t step);
+		/** @brief Returns the oldest available snapshot, or `nullptr` if there is none */
+		Snapshot* GetOldest();
+		/** @brief Discards all snapshots of the specified step and newer */
+		void DiscardFrom(std::uint32_t step);
+		/** @brief Discards all snapshots and releases all references to actors */
+		void Clear();
+
+	private:
+		Snapshot _slots[Capacity];
+
+		static void Release(Snapshot& snapshot);
+	};
+}
@@ -62,7 +62,7 @@ namespace Jazz2::Tiles
 		: _owner(nullptr), _sprLayerIndex(-1), _pitType(PitType::FallForever), _hasRollbackCheckpoint(false),
 			_renderCommandsCount(0), _renderCommandsPeak(0), _renderCommandsPeakAge(0), _collapsingTimer(0.0f),
 			_animatedTilesOffset(0), _triggerState(ValueInit, TriggerCount), _triggerStateForRollback(ValueInit, TriggerCount),
-			_texturedBackgroundLayer(-1), _texturedBackgroundPass(this)
+			_hasSnapshotTiles(false), _texturedBackgroundLayer(-1), _texturedBackgroundPass(this)
 	{
 		auto& tileSetPart = _tileSets.emplace_back();
 		tileSetPart.Data = ContentResolver::Get().RequestTileSet(tileSetPath, captionTileId, applyPalette);
@@ -278,6 +278,9 @@ namespace Jazz2::Tiles
 #if defined(TILEMAP_USE_SINGLE_DRAW)
 		_meshVerticesCount = 0;
 		_meshCommandCount = 0;
+#endif
+#if defined(TILEMAP_USE_PERSISTENT_CHUNKS)
+		_layerMeshFrame++;
 #endif
 	}
 
@@ -876,6 +879,7 @@ namespace Jazz2::Tiles
 
 				tile.DestructFrameIndex = std::int16_t(tile.DestructFrameIndex + frameCount);
 				tile.TileID = anim.Tiles[tile.DestructFrameIndex].TileID;
+				InvalidateLayerMesh(_sprLayerIndex, tx, ty);
 				if (tile.DestructFrameIndex >= max) {
 					if (!soundName.empty()) {
 						_owner->PlayCommonSfx(soundName, Vector3f(tx * TileSet::DefaultTileSize + (TileSet::DefaultTileSize / 2),
@@ -894,6 +898,7 @@ namespace Jazz2::Tiles
 				std::int32_t frameCount = 1;
 				tile.DestructFrameIndex = std::int16_t(tile.DestructFrameIndex + frameCount);
 				tile.TileID = 0; // Set to empty tile
+				InvalidateLayerMesh(_sprLayerIndex, tx, ty);
 
 				if (!soundName.empty()) {
 					_owner->PlayCommonSfx(soundName, Vector3f(tx * TileSet::DefaultTileSize + (TileSet::DefaultTileSize / 2),
@@ -1044,6 +1049,15 @@ namespace Jazz2::Tiles
 					break;
 			}
 
+#if defined(TILEMAP_USE_PERSISTENT_CHUNKS)
+			if (rendererType == LayerRendererType::Default && _tileSets.size() == 1) {
+				// The walk below ends up drawing tile N of the layer (counting its repetitions) at x1 - xt + N * 32,
+				// so the persistent chunks only need the position of the first tile
+				DrawLayerChunks(renderQueue, std::int32_t(&layer - _layers.data()), Vector2f(x1 - xt, y1 - yt), cullingRect, layerColor);
+				return;
+			}
+#endif
+
 			// Calculate the index (on the layer map) of the first tile that needs to be drawn to the position determined earlier
 			std::int32_t tileX, tileY, tileAbsX, tileAbsY;
 
@@ -1270,6 +1284,264 @@ namespace Jazz2::Tiles
 		}
 	}
 
+#if defined(TILEMAP_USE_PERSISTENT_CHUNKS)
+	void TileMap::DrawLayerChunks(RenderQueue& renderQueue, std::int32_t layerIndex, Vector2f layerOrigin, const Rectf& cullingRect, const Vector4f& layerColor)
+	{
+		const TileMapLayer& layer = _layers[layerIndex];
+		const Vector2i tileCount = layer.LayoutSize;
+		if (tileCount.X <= 0 || tileCount.Y <= 0) {
+			return;
+		}
+
+		if (_layerMeshes.size() < _layers.size()) {
+			_layerMeshes.resize(_layers.size());
+		}
+		LayerMeshCache& cache = _layerMeshes[layerIndex];
+		if (cache.Chunks.empty()) {
+			cache.ChunkCount = Vector2i((tileCount.X + MeshChunkSize - 1) / MeshChunkSize, (tileCount.Y + MeshChunkSize - 1) / MeshChunkSize);
+			cache.Chunks.resize(cache.ChunkCount.X * cache.ChunkCount.Y);
+		}
+
+		if (!PreferencesCache::UnalignedViewport) {
+			layerOrigin.X = std::floor(layerOrigin.X);
+			layerOrigin.Y = std::floor(layerOrigin.Y);
+		}
+
+		// Visible tiles counted from the first tile of the layer, a repeating layer continues past its bounds
+		constexpr float TileSize = (float)TileSet::DefaultTileSize;
+		std::int32_t firstX = (std::int32_t)std::floor((cullingRect.X - layerOrigin.X) / TileSize);
+		std::int32_t lastX = (std::int32_t)std::floor((cullingRect.X + cullingRect.W - layerOrigin.X) / TileSize);
+		std::int32_t firstY = (std::int32_t)std::floor((cullingRect.Y - layerOrigin.Y) / TileSize);
+		std::int32_t lastY = (std::int32_t)std::floor((cullingRect.Y + cullingRect.H - layerOrigin.Y) / TileSize);
+		if (!layer.Description.RepeatX) {
+			firstX = std::max(firstX, 0);
+			lastX = std::min(lastX, tileCount.X - 1);
+		}
+		if (!layer.Description.RepeatY) {
+			firstY = std::max(firstY, 0);
+			lastY = std::min(lastY, tileCount.Y - 1);
+		}
+		if (firstX > lastX || firstY > lastY) {
+			return;
+		}
+
+		// Chunks don't straddle repetitions of the layer, the last chunk of a row or column is partial
+		// if the layout size isn't a multiple of the chunk size
+		auto floorDiv = [](std::int32_t value, std::int32_t divisor) {
+			return (value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor));
+		};
+
+		TileSet* tileSet = _tileSets[0].Data.get();
+		const bool indexed = tileSet->IsIndexed;
+
+		for (std::int32_t repY = floorDiv(firstY, tileCount.Y), lastRepY = floorDiv(lastY, tileCount.Y); repY <= lastRepY; repY++) {
+			const std::int32_t baseY = repY * tileCount.Y;
+			const std::int32_t lastCy = std::min(lastY - baseY, tileCount.Y - 1) / MeshChunkSize;
+			for (std::int32_t cy = std::max(firstY - baseY, 0) / MeshChunkSize; cy <= lastCy; cy++) {
+				const float chunkY = layerOrigin.Y + (baseY + cy * MeshChunkSize) * TileSize;
+
+				for (std::int32_t repX = floorDiv(firstX, tileCount.X), lastRepX = floorDiv(lastX, tileCount.X); repX <= lastRepX; repX++) {
+					const std::int32_t baseX = repX * tileCount.X;
+					const std::int32_t lastCx = std::min(lastX - baseX, tileCount.X - 1) / MeshChunkSize;
+					for (std::int32_t cx = std::max(firstX - baseX, 0) / MeshChunkSize; cx <= lastCx; cx++) {
+						const float chunkX = layerOrigin.X + (baseX + cx * MeshChunkSize) * TileSize;
+
+						LayerMeshChunk& chunk = cache.Chunks[cy * cache.ChunkCount.X + cx];
+						if (chunk.IsDirty || IsLayerMeshChunkStale(chunk)) {
+							RebuildLayerMeshChunk(layer, chunk, cx, cy);
+						}
+
+						for (std::int32_t i = 0; i < (std::int32_t)chunk.Parts.size(); i++) {
+							LayerMeshChunkPart& part = chunk.Parts[i];
+							if (part.Vertices.empty()) {
+								continue;
+							}
+
+							if (part.CommandsFrame != _layerMeshFrame) {
+								part.CommandsFrame = _layerMeshFrame;
+								part.CommandsUsed = 0;
+							}
+							if (part.CommandsUsed >= (std::int32_t)part.Commands.size()) {
+								RenderCommand* newCommand = part.Commands.emplace_back(std::make_unique<RenderCommand>()).get();
+								newCommand->SetType(RenderCommand::Type::TileMap);
+								newCommand->GetMaterial().SetBlendingEnabled(true);
+								newCommand->GetMaterial().SetBlendingFactors(BlendingFactor::SrcAlpha, BlendingFactor::OneMinusSrcAlpha);
+								if (newCommand->GetMaterial().SetShader(ContentResolver::Get().GetShader(
+									indexed ? PrecompiledShader::TileMapMeshPalette : PrecompiledShader::TileMapMesh))) {
+									newCommand->GetMaterial().ReserveUniformsDataMemory();
+
+									auto* textureUniform = newCommand->GetMaterial().Uniform(Material::TextureUniformName);
+									if (textureUniform != nullptr && textureUniform->GetIntValue(0) != 0) {
+										textureUniform->SetIntValue(0); // GL_TEXTURE0
+									}
+									auto* paletteUniform = newCommand->GetMaterial().Uniform("uTexturePalette");
+									if (paletteUniform != nullptr) {
+										paletteUniform->SetIntValue(1); // GL_TEXTURE1
+									}
+								}
+
+								auto& geometry = newCommand->GetGeometry();
+								geometry.SetElementsPerVertex(8);
+								geometry.CreateCustomVbo(part.BufferFloats, BufferUsage::StaticDraw);
+								geometry.SetHostVertexPointer(part.Vertices.data());
+								geometry.SetDrawParameters(PrimitiveType::Triangles, 0, (std::int32_t)(part.BufferFloats / 8));
+							}
+							RenderCommand* command = part.Commands[part.CommandsUsed++].get();
+
+							// Only the placement and the layer tint change from frame to frame, the vertices stay
+							// in the command's own buffer until the chunk is rebuilt
+							command->GetInstanceBlock()->GetUniform(Material::ColorUniformName)->SetFloatVector(layerColor.Data());
+							command->SetTransformation(Matrix4x4f::Translation(chunkX, chunkY, 0.0f));
+							command->SetLayer(layer.Description.Depth);
+							ContentResolver::Get().BindSpritePalette(*command, *tileSet->TextureDiffuse[i], indexed, 0);
+
+							renderQueue.AddCommand(command);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	void TileMap::RebuildLayerMeshChunk(const TileMapLayer& layer, LayerMeshChunk& chunk, std::int32_t cx, std::int32_t cy)
+	{
+		TileSet* meshTileSet = _tileSets[0].Data.get();
+		const std::int32_t textureCount = meshTileSet->GetTextureCount();
+		if ((std::int32_t)chunk.Parts.size() < textureCount) {
+			chunk.Parts.resize(textureCount);
+		}
+		for (auto& part : chunk.Parts) {
+			part.Vertices.clear();
+		}
+		chunk.AnimatedTiles.clear();
+
+		const std::int32_t x0 = cx * MeshChunkSize;
+		const std::int32_t y0 = cy * MeshChunkSize;
+		const std::int32_t x1 = std::min(x0 + MeshChunkSize, layer.LayoutSize.X);
+		const std::int32_t y1 = std::min(y0 + MeshChunkSize, layer.LayoutSize.Y);
+
+		for (std::int32_t ty = y0; ty < y1; ty++) {
+			for (std::int32_t tx = x0; tx < x1; tx++) {
+				const LayerTile& tile = layer.Layout[tx + ty * layer.LayoutSize.X];
+
+				// The chunk has to be rebuilt when any of its animated tiles moves to another frame
+				if (tile.TileID >= _animatedTilesOffset && tile.TileID - _animatedTilesOffset < _animatedTiles.size()) {
+					std::uint16_t animatedTile = std::uint16_t(tile.TileID - _animatedTilesOffset);
+					bool found = false;
+					for (const auto& entry : chunk.AnimatedTiles) {
+						if (entry.AnimatedTile == animatedTile) {
+							found = true;
+							break;
+						}
+					}
+					if (!found) {
+						chunk.AnimatedTiles.push_back(LayerMeshAnimatedTile { animatedTile, std::uint16_t(_animatedTiles[animatedTile].CurrentTileIdx) });
+					}
+				}
+
+				std::int32_t tileId = ResolveTileID(tile);
+				if (tileId == 0 || tile.Alpha == 0) {
+					continue;
+				}
+				TileSet* tileSet = ResolveTileSet(tileId);
+				if (tileSet == nullptr) {
+					continue;
+				}
+
+				// Has to be read before ResolveTextureDiffuse() rebases the ID into its texture, see DrawLayer()
+				const std::int32_t tileChunk = (tileSet->TilesPerTexture > 0 && tileId >= tileSet->TilesPerTexture
+					? tileId / tileSet->TilesPerTexture : 0);
+				Texture* tileTexture = tileSet->ResolveTextureDiffuse(tileId);
+				if DEATH_UNLIKELY(tileTexture == nullptr || tileChunk >= textureCount) {
+					continue;
+				}
+
+				Vector2i texSize = tileTexture->GetSize();
+				float texScaleX = TileSet::DefaultTileSize / float(texSize.X);
+				float texBiasX = ((tileId % tileSet->TilesPerRow) * (TileSet::DefaultTileSize + 2.0f) + 1.0f) / float(texSize.X);
+				float texScaleY = TileSet::DefaultTileSize / float(texSize.Y);
+				float texBiasY = ((tileId / tileSet->TilesPerRow) * (TileSet::DefaultTileSize + 2.0f) + 1.0f) / float(texSize.Y);
+
+				if ((tile.Flags & LayerTileFlags::FlipX) == LayerTileFlags::FlipX) {
+					texBiasX += texScaleX;
+					texScaleX *= -1;
+				}
+				if ((tile.Flags & LayerTileFlags::FlipY) == LayerTileFlags::FlipY) {
+					texBiasY += texScaleY;
+					texScaleY *= -1;
+				}
+
+				AppendTileQuad(chunk.Parts[tileChunk].Vertices, float((tx - x0) * TileSet::DefaultTileSize), float((ty - y0) * TileSet::DefaultTileSize),
+					(float)TileSet::DefaultTileSize, texScaleX, texBiasX, texScaleY, texBiasY, tile.Alpha / 255.0f);
+			}
+		}
+
+		for (auto& part : chunk.Parts) {
+			if (part.Vertices.empty()) {
+				continue;
+			}
+
+			// The buffers are sized exactly, because without buffer mapping the commit uploads the whole buffer
+			// from the host pointer. A rebuild mostly swaps a frame of an animated tile, which keeps the size.
+			const std::uint32_t numFloats = (std::uint32_t)part.Vertices.size();
+			const bool resized = (part.BufferFloats != numFloats);
+			part.BufferFloats = numFloats;
+			for (auto& command : part.Commands) {
+				auto& geometry = command->GetGeometry();
+				if (resized) {
+					geometry.CreateCustomVbo(numFloats, BufferUsage::StaticDraw);
+					geometry.SetDrawParameters(PrimitiveType::Triangles, 0, (std::int32_t)(numFloats / 8));
+				}
+				geometry.SetHostVertexPointer(part.Vertices.data());
+			}
+		}
+
+		chunk.IsDirty = false;
+	}
+
+	bool TileMap::IsLayerMeshChunkStale(const LayerMeshChunk& chunk) const
+	{
+		for (const auto& entry : chunk.AnimatedTiles) {
+			if (_animatedTiles[entry.AnimatedTile].CurrentTileIdx != entry.FrameIdx) {
+				return true;
+			}
+		}
+		return false;
+	}
+#endif
+
+	void TileMap::InvalidateLayerMesh(std::int32_t layerIndex, std::int32_t tx, std::int32_t ty)
+	{
+#if defined(TILEMAP_USE_PERSISTENT_CHUNKS)
+		// Chunks of a layer that wasn't drawn yet are created dirty
+		if (layerIndex < 0 || layerIndex >= (std::int32_t)_layerMeshes.size() || _layerMeshes[layerIndex].Chunks.empty()) {
+			return;
+		}
+
+		LayerMeshCache& cache = _layerMeshes[layerIndex];
+		cache.Chunks[(ty / MeshChunkSize) * cache.ChunkCount.X + (tx / MeshChunkSize)].IsDirty = true;
+#else
+		static_cast<void>(layerIndex);
+		static_cast<void>(tx);
+		static_cast<void>(ty);
+#endif
+	}
+
+	void TileMap::InvalidateLayerMeshes(std::int32_t layerIndex)
+	{
+#if defined(TILEMAP_USE_PERSISTENT_CHUNKS)
+		if (layerIndex < 0 || layerIndex >= (std::int32_t)_layerMeshes.size()) {
+			return;
+		}
+
+		for (auto& chunk : _layerMeshes[layerIndex].Chunks) {
+			chunk.IsDirty = true;
+		}
+#else
+		static_cast<void>(layerIndex);
+#endif
+	}
+
 	float TileMap::TranslateCoordinate(float coordinate, float speed, float offset, std::int32_t viewSize, bool isY)
 	{
 		std::int32_t alignment = ((isY ? (viewSize - 200) : (viewSize - 320)) / 2) + HardcodedOffset;
@@ -1653,6 +1925,8 @@ namespace Jazz2::Tiles
 				SetTileDestructibleEventParams(tile, TileDestructType::Collapse, tileParams[0]);
 				break;
 		}
+
+		InvalidateLayerMesh(_sprLayerIndex, x, y);
 	}
 
 	/** @brief Overrides the diffuse texture of the specified tile */
@@ -1814,13 +2088,13 @@ namespace Jazz2::Tiles
 			debris.Pos = Vector2f(x * TileSet::DefaultTileSize + (i % 2) * QuarterSize, y * TileSet::DefaultTileSize + (i / 2) * QuarterSize);
 			debris.Depth = z;
 			debris.Size = Vector2f(QuarterSize, QuarterSize);
-			debris.Speed = Vector2f(SpeedMultiplier[i] * Random().FastFloat(0.8f, 1.2f), -4.0f * Random().FastFloat(0.8f, 1.2f));
+			debris.Speed = Vector2f(SpeedMultiplier[i] * _debrisRandom.FastFloat(0.8f, 1.2f), -4.0f * _debrisRandom.FastFloat(0.8f, 1.2f));
 			debris.Acceleration = Vector2f(0.0f, 0.3f);
 
 			debris.Scale = 1.0f;
-			debris.ScaleSpeed = Random().FastFloat(-0.01f, -0.002f);
+			debris.ScaleSpeed = _debrisRandom.FastFloat(-0.01f, -0.002f);
 			debris.Angle = 0.0f;
-			debris.AngleSpeed = SpeedMultiplier[i] * Random().FastFloat(0.0f, 0.014f);
+			debris.AngleSpeed = SpeedMultiplier[i] * _debrisRandom.FastFloat(0.0f, 0.014f);
 
 			debris.Alpha = 1.0f;
 			debris.AlphaSpeed = -0.01f;
@@ -1864,14 +2138,14 @@ namespace Jazz2::Tiles
 				break;
 			}
 			for (std::int32_t fx = 0; fx < debrisRect.W; fx += step) {
-				float currentSize = particleSize * Random().FastFloat(0.2f, 1.1f);
+				float currentSize = particleSize * _debrisRandom.FastFloat(0.2f, 1.1f);
 
 				DestructibleDebris& debris = _debrisList.emplace_back();
 				debris.Pos = Vector2f(x + (isFacingLeft ? res->Base->FrameDimensions.X - frameOffset.X - fx : frameOffset.X + fx), y + frameOffset.Y + fy);
 				debris.Depth = (std::uint16_t)pos.Z;
 				debris.Size = Vector2f(currentSize, currentSize);
-				debris.Speed = Vector2f(force.X + ((fx - debrisRect.W / 2) + Random().FastFloat(-2.0f, 2.0f)) * (isFacingLeft ? -1.0f : 1.0f) * Random().FastFloat(2.0f, 8.0f) / debrisRect.W,
-						force.Y - 1.0f * Random().FastFloat(2.2f, 4.0f));
+				debris.Speed = Vector2f(force.X + ((fx - debrisRect.W / 2) + _debrisRandom.FastFloat(-2.0f, 2.0f)) * (isFacingLeft ? -1.0f : 1.0f) * _debrisRandom.FastFloat(2.0f, 8.0f) / debrisRect.W,
+						force.Y - 1.0f * _debrisRandom.FastFloat(2.2f, 4.0f));
 				debris.Acceleration = Vector2f(0.0f, 0.2f);
 
 				debris.Scale = 1.0f;
@@ -1914,9 +2188,9 @@ namespace Jazz2::Tiles
 		}
 
 		for (std::int32_t i = 0; i < count; i++) {
-			float speedX = Random().FastFloat(-1.0f, 1.0f) * Random().FastFloat(0.2f, 0.8f) * count;
+			float speedX = _debrisRandom.FastFloat(-1.0f, 1.0f) * _debrisRandom.FastFloat(0.2f, 0.8f) * count;
 
-			std::int32_t curAnimFrame = res->FrameOffset + Random().Next(0, res->FrameCount);
+			std::int32_t curAnimFrame = res->FrameOffset + _debrisRandom.Next(0, res->FrameCount);
 			Recti frameRect = res->Base->GetFrameRect(curAnimFrame);
 			Vector2i frameOffset = res->Base->GetFrameOffset(curAnimFrame);
 
@@ -1928,12 +2202,12 @@ namespace Jazz2::Tiles
 			debris.Size = Vector2f((float)frameRect.W, (float)frameRect.H);
 			debris.FrameOffset = Vector2f(frameOffset.X + (frameRect.W - res->Base->FrameDimensions.X) * 0.5f,
 				frameOffset.Y + (frameRect.H - res->Base->FrameDimensions.Y) * 0.5f);
-			debris.Speed = Vector2f(speedX, -1.0f * Random().FastFloat(2.2f, 4.0f));
+			debris.Speed = Vector2f(speedX, -1.0f * _debrisRandom.FastFloat(2.2f, 4.0f));
 			debris.Acceleration = Vector2f(0.0f, 0.2f);
 
 			debris.Scale = 1.0f;
 			debris.ScaleSpeed = -0.002f;
-			debris.Angle = Random().FastFloat(0.0f, fTwoPi);
+			debris.Angle = _debrisRandom.FastFloat(0.0f, fTwoPi);
 			debris.AngleSpeed = speedX * 0.02f;
 
 			debris.Alpha = 1.0f;
@@ -2177,6 +2451,7 @@ namespace Jazz2::Tiles
 					tile.DestructFrameIndex = (newState ? 1 : 0);
 					tile.TileID = (newState ? std::uint16_t(0) /*Empty*/ : std::uint16_t(tile.DestructAnimation));
 				}
+				InvalidateLayerMesh(_sprLayerIndex, i % layoutSize.X, i / layoutSize.X);
 			}
 		}
 	}
@@ -2253,6 +2528,7 @@ namespace Jazz2::Tiles
 			flags |= (std::uint8_t)LayerTileFlags::FlipY;
 		}
 		tile.Flags = (LayerTileFlags)flags;
+		InvalidateLayerMesh(layerIndex, x, y);
 		return true;
 	}
 
@@ -2308,10 +2584,71 @@ namespace Jazz2::Tiles
 		for (const auto& saved : _sprLayerForRollback) {
 			layout[saved.TileIndex] = saved.Tile;
 		}
+		InvalidateLayerMeshes(_sprLayerIndex);
 
 		std::memcpy(_triggerState.data(), _triggerStateForRollback.data(), _triggerState.sizeInBytes());
 	}
 
+	void TileMap::SaveSnapshot(Stream& dest)
+	{
+		if (_sprLayerIndex == -1) {
+			return;
+		}
+
+		const LayerTile* layout = _layers[_sprLayerIndex].Layout.get();
+
+		if (!_hasSnapshotTiles) {
+			// Only destructible tiles can change, see CreateCheckpointForRollback()
+			auto& sprLayer = _layers[_sprLayerIndex];
+			std::int32_t layoutSize = sprLayer.LayoutSize.X * sprLayer.LayoutSize.Y;
+			for (std::int32_t i = 0; i < layoutSize; i++) {
+				if (layout[i].DestructType != TileDestructType::None) {
+					_snapshotTiles.push_back((std::uint32_t)i);
+				}
+			}
+			_hasSnapshotTiles = true;
+		}
+
+		for (std::uint32_t tileIndex : _snapshotTiles) {
+			dest.WriteValue<LayerTile>(layout[tileIndex]);
+		}
+
+		dest.WriteValue<std::uint32_t>((std::uint32_t)_activeCollapsingTiles.size());
+		for (const auto& pos : _activeCollapsingTiles) {
+			dest.WriteValue<std::int32_t>(pos.X);
+			dest.WriteValue<std::int32_t>(pos.Y);
+		}
+		dest.WriteValue<float>(_collapsingTimer);
+		dest.Write(_triggerState.data(), _triggerState.sizeInBytes());
+	}
+
+	void TileMap::RestoreSnapshot(Stream& src)
+	{
+		if (_sprLayerIndex == -1) {
+			return;
+		}
+
+		LayerTile* layout = _layers[_sprLayerIndex].Layout.get();
+		const std::int32_t layoutWidth = _layers[_sprLayerIndex].LayoutSize.X;
+		for (std::uint32_t tileIndex : _snapshotTiles) {
+			LayerTile tile = src.ReadValue<LayerTile>();
+			// Snapshots are restored often, so only the chunks with a tile that actually differs are rebuilt
+			if (std::memcmp(&layout[tileIndex], &tile, sizeof(LayerTile)) != 0) {
+				layout[tileIndex] = tile;
+				InvalidateLayerMesh(_sprLayerIndex, std::int32_t(tileIndex) % layoutWidth, std::int32_t(tileIndex) / layoutWidth);
+			}
+		}
+
+		std::uint32_t collapsingCount = src.ReadValue<std::uint32_t>();
+		_activeCollapsingTiles.resize_for_overwrite(collapsingCount);
+		for (std::uint32_t i = 0; i < collapsingCount; i++) {
+			_activeCollapsingTiles[i].X = src.ReadValue<std::int32_t>();
+			_activeCollapsingTiles[i].Y = src.ReadValue<std::int32_t>();
+		}
+		_collapsingTimer = src.ReadValue<float>();
+		src.Read(_triggerState.data(), _triggerState.sizeInBytes());
+	}
+
 	void TileMap::InitializeFromStream(Stream& src)
 	{
 		std::int32_t layoutSize = src.ReadVariableInt32();
@@ -2354,6 +2691,8 @@ namespace Jazz2::Tiles
 			}
 		}
 
+		InvalidateLayerMeshes(_sprLayerIndex);
+
 		src.Read(_triggerState.data(), _triggerState.sizeInBytes());
 	}
 
@@ -7,6 +7,7 @@
 #include "LayerTypes.h"
 #include "TileSet.h"
 
+#include "../../nCine/Base/Random.h"
 #include "../../nCine/Graphics/Camera.h"
 #include "../../nCine/Graphics/Viewport.h"
 
@@ -14,6 +15,13 @@
 
 using namespace Death::IO;
 
+// Tile layers can keep their meshes between frames in chunks with their own vertex buffers, see TileMap::LayerMeshChunk.
+// It's opt-in (TILEMAP_USE_PERSISTENT_CHUNKS option) and only where a vertex buffer per chunk is cheap, the consoles
+// can't spare the memory and build the visible part anew.
+#if defined(TILEMAP_USE_PERSISTENT_CHUNKS) && !(defined(TILEMAP_USE_SINGLE_DRAW) && (defined(WITH_RHI_GL) || defined(WITH_RHI_VULKAN)))
+#	undef TILEMAP_USE_PERSISTENT_CHUNKS
+#endif
+
 namespace Jazz2
 {
 	class LevelHandler;
@@ -470,6 +478,11 @@ namespace Jazz2::Tiles
 		/** @brief Rolls back to the last checkpoint */
 		void RollbackToCheckpoint();
 
+		/** @brief Saves state that can change in any frame to a rollback snapshot, see @ref RollbackBuffer */
+		void SaveSnapshot(Stream& dest);
+		/** @brief Restores state saved by @ref SaveSnapshot() */
+		void RestoreSnapshot(Stream& src);
+
 		/** @brief Initializes tile map state from a stream */
 		void InitializeFromStream(Stream& src);
 		/** @brief Serializes tile map state to a stream */
@@ -544,6 +557,10 @@ namespace Jazz2::Tiles
 		std::uint32_t _animatedTilesOffset;
 		BitArray _triggerState;
 		BitArray _triggerStateForRollback;
+		/// Sprite-layer tiles saved to every rollback snapshot, collected on the first one. The same set of tiles
+		/// as in @ref CreateCheckpointForRollback(), it can only shrink during the level, so it's never rebuilt.
+		SmallVector<std::uint32_t, 0> _snapshotTiles;
+		bool _hasSnapshotTiles;
 
 		/// Cached instance-block uniforms of one pooled per-tile render command
 		struct TileCommandUniforms
@@ -555,6 +572,9 @@ namespace Jazz2::Tiles
 		};
 
 		SmallVector<DestructibleDebris, 0> _debrisList;
+		// Debris is purely visual and it's not created at all without textures (in headless mode), so it must not
+		// draw from the shared generator the simulation depends on
+		RandomGenerator _debrisRandom;
 		SmallVector<std::unique_ptr<RenderCommand>, 0> _renderCommands;
 		/// Instance-block uniforms of the correspondingly indexed pooled command. Resolving them by name costs
 		/// a linear scan of the block, which at one command per visible tile dominated the layer build - they
@@ -595,10 +615,65 @@ namespace Jazz2::Tiles
 		SmallVector<DebrisMeshGroup, 4> _debrisMeshGroups;
 #endif
 
+#if defined(TILEMAP_USE_PERSISTENT_CHUNKS)
+		/// Size of a persistent layer mesh chunk in tiles (in both directions)
+		static constexpr std::int32_t MeshChunkSize = 16;
+
+		/// Vertices of one chunk that sample one texture of the tileset, with the commands that draw them.
+		/// Each placement of the chunk in a frame needs its own command (a repeating layer can show the same
+		/// chunk several times, and every viewport draws it again), so the commands are rented per frame.
+		struct LayerMeshChunkPart
+		{
+			SmallVector<float, 0> Vertices;
+			SmallVector<std::unique_ptr<RenderCommand>, 0> Commands;
+			/// Size of the vertex buffers of the commands in floats
+			std::uint32_t BufferFloats = 0;
+			std::uint32_t CommandsFrame = 0;
+			std::int32_t CommandsUsed = 0;
+		};
+
+		/// Animated tile referenced by a chunk, together with the frame its vertices were built with
+		struct LayerMeshAnimatedTile
+		{
+			std::uint16_t AnimatedTile;
+			std::uint16_t FrameIdx;
+		};
+
+		/// Square of @ref MeshChunkSize tiles of a layer, whose vertices are in chunk-local coordinates and only
+		/// rebuilt when a tile inside changes - parallax then only moves the chunk. Tiles of a layer change rarely
+		/// (a destructible tile, a trigger, a script), and an animated tile advances a few times per second.
+		struct LayerMeshChunk
+		{
+			SmallVector<LayerMeshChunkPart, 1> Parts;
+			SmallVector<LayerMeshAnimatedTile, 0> AnimatedTiles;
+			bool IsDirty = true;
+		};
+
+		struct LayerMeshCache
+		{
+			SmallVector<LayerMeshChunk, 0> Chunks;
+			Vector2i ChunkCount;
+		};
+
+		/// Persistent chunk meshes of the correspondingly indexed layer, created on the first draw of the layer
+		SmallVector<LayerMeshCache, 0> _layerMeshes;
+		/// Incremented in @ref OnEndFrame(), chunks compare it to know when to start renting their commands again
+		std::uint32_t _layerMeshFrame = 1;
+#endif
+
 		std::int32_t _texturedBackgroundLayer;
 		TexturedBackgroundPass _texturedBackgroundPass;
 
 		void DrawLayer(RenderQueue& renderQueue, TileMapLayer& layer, const Rectf& cullingRect, Vector2f viewCenter);
+#if defined(TILEMAP_USE_PERSISTENT_CHUNKS)
+		// Draws the chunks of a layer visible in the culling rect, given the position of the layer's top-left tile
+		void DrawLayerChunks(RenderQueue& renderQueue, std::int32_t layerIndex, Vector2f layerOrigin, const Rectf& cullingRect, const Vector4f& layerColor);
+		void RebuildLayerMeshChunk(const TileMapLayer& layer, LayerMeshChunk& chunk, std::int32_t cx, std::int32_t cy);
+		bool IsLayerMeshChunkStale(const LayerMeshChunk& chunk) const;
+#endif
+		// Marks the persistent chunk mesh containing the tile for rebuild, or all chunks of the layer
+		void InvalidateLayerMesh(std::int32_t layerIndex, std::int32_t tx, std::int32_t ty);
+		void InvalidateLayerMeshes(std::int32_t layerIndex);
 		static float TranslateCoordinate(float coordinate, float speed, float offset, std::int32_t viewSize, bool isY);
 		RenderCommand* RentRenderCommand(LayerRendererType type, bool indexed = false, TileCommandUniforms** uniforms = nullptr);
 #if defined(TILEMAP_USE_SINGLE_DRAW)
@@ -2,12 +2,15 @@
 #include "../ContentResolver.h"
 
 #include "../../nCine/Graphics/RenderQueue.h"
+#include "../../nCine/Graphics/RenderResources.h"
+#include "../../nCine/Graphics/RenderBuffersManager.h"
 #include "../../nCine/Base/Random.h"
 
 namespace Jazz2::UI
 {
 	Canvas::Canvas()
 		: AnimTime(0.0f), _renderCommandsCount(0), _currentRenderQueue(nullptr)
+			, _meshCommandsCount(0), _meshVerticesCount(0)
 	{
 		setVisitOrderState(SceneNode::VisitOrderState::Disabled);
 	}
@@ -25,6 +28,8 @@ namespace Jazz2::UI
 
 		_renderCommandsCount = 0;
 		_currentRenderQueue = &renderQueue;
+		_meshCommandsCount = 0;
+		_meshVerticesCount = 0;
 
 		return false;
 	}
@@ -181,6 +186,72 @@ namespace Jazz2::UI
 		_currentRenderQueue->AddCommand(command);
 	}
 
+	SmallVector<float, 0>& Canvas::RentMeshVertices()
+	{
+		if (_meshVerticesCount >= std::int32_t(_meshVertices.size())) {
+			_meshVertices.emplace_back(std::make_unique<SmallVector<float, 0>>());
+		}
+		SmallVector<float, 0>& vertices = *_meshVertices[_meshVerticesCount++];
+		vertices.clear();
+		return vertices;
+	}
+
+	bool Canvas::DrawMesh(const SmallVector<float, 0>& vertices, const Texture& texture, std::uint16_t z, RenderCommand::Type type)
+	{
+		auto* shader = ContentResolver::Get().GetShader(PrecompiledShader::TileMapMesh);
+		if (shader == nullptr) {
+			return false;
+		}
+
+		// Split like TileMap::EmitMesh(), so a single command never needs more than the shared array buffer holds
+		constexpr std::uint32_t FloatsPerVertex = 8;
+		const std::uint32_t maxVertexDataSize = RenderResources::GetBuffersManager().Specs(RenderBuffersManager::BufferTypes::Array).maxSize;
+		std::uint32_t maxVerticesPerChunk = maxVertexDataSize / (FloatsPerVertex * sizeof(float));
+		maxVerticesPerChunk -= (maxVerticesPerChunk % 6);
+
+		const std::uint32_t totalVertices = std::uint32_t(vertices.size() / FloatsPerVertex);
+		for (std::uint32_t firstVertex = 0; firstVertex < totalVertices; firstVertex += maxVerticesPerChunk) {
+			const std::uint32_t count = std::min(maxVerticesPerChunk, totalVertices - firstVertex);
+
+			if (_meshCommandsCount >= std::int32_t(_meshCommands.size())) {
+				auto& newCommand = _meshCommands.emplace_back(std::make_unique<RenderCommand>());
+				newCommand->GetMaterial().SetBlendingEnabled(true);
+			}
+			RenderCommand* command = _meshCommands[_meshCommandsCount++].get();
+			command->SetType(type);
+
+			if (command->GetMaterial().SetShader(shader)) {
+				command->GetMaterial().ReserveUniformsDataMemory();
+
+				auto* textureUniform = command->GetMaterial().Uniform(Material::TextureUniformName);
+				if (textureUniform != nullptr && textureUniform->GetIntValue(0) != 0) {
+					textureUniform->SetIntValue(0); // GL_TEXTURE0
+				}
+			}
+
+			// Same separate alpha blend as DrawTexture()
+			command->GetMaterial().SetBlendingFactors(BlendingFactor::SrcAlpha, BlendingFactor::OneMinusSrcAlpha, BlendingFactor::One, BlendingFactor::OneMinusSrcAlpha);
+
+			// Every vertex carries its own color, so the instance color stays neutral
+			auto instanceBlock = command->GetInstanceBlock();
+			instanceBlock->GetUniform(Material::ColorUniformName)->SetFloatVector(Colorf::White.Data());
+
+			auto& geometry = command->GetGeometry();
+			geometry.SetElementsPerVertex(FloatsPerVertex);
+			geometry.SetVertexCount(count);
+			geometry.SetHostVertexPointer(vertices.data() + firstVertex * FloatsPerVertex);
+			geometry.SetDrawParameters(PrimitiveType::Triangles, 0, count);
+
+			// Vertex positions are already in screen space, so the model matrix is identity
+			command->SetTransformation(Matrix4x4f::Translation(0.0f, 0.0f, 0.0f));
+			command->SetLayer(z);
+			command->GetMaterial().SetTexture(0, texture);
+
+			_currentRenderQueue->AddCommand(command);
+		}
+		return true;
+	}
+
 	Vector2f Canvas::ApplyAlignment(Alignment align, Vector2f vec, Vector2f size)
 	{
 		Vector2f result = vec;
@@ -68,6 +68,19 @@ namespace Jazz2::UI
 		/** @brief Draws a raw render command */
 		void DrawRenderCommand(RenderCommand* command);
 
+		/** @brief Rents an empty vertex buffer for @ref DrawMesh(), it stays valid until the canvas is drawn again */
+		SmallVector<float, 0>& RentMeshVertices();
+		/**
+		 * @brief Draws a mesh of textured quads with a single render command
+		 *
+		 * Each vertex is 8 floats (screen-space position, texture coordinates and color) and each quad is 6 vertices
+		 * in the layout `TileMap::AppendTileQuad()` writes. The draw transform (@ref LayerOffset, @ref LayerScale
+		 * and @ref LayerColor) is not applied, the vertices are expected to include it already. The buffer is read
+		 * only when the render queue is drawn, so it has to come from @ref RentMeshVertices(). Returns `false`
+		 * without drawing anything if the mesh shader is not available.
+		 */
+		bool DrawMesh(const SmallVector<float, 0>& vertices, const Texture& texture, std::uint16_t z, RenderCommand::Type type);
+
 	protected:
 		/** @brief Multiplier of game time for canvas rendering */
 		static constexpr float AnimTimeMultiplier = 0.014f;
@@ -76,5 +89,10 @@ namespace Jazz2::UI
 		std::int32_t _renderCommandsCount;
 		SmallVector<std::unique_ptr<RenderCommand>, 0> _renderCommands;
 		RenderQueue* _currentRenderQueue;
+		std::int32_t _meshCommandsCount;
+		SmallVector<std::unique_ptr<RenderCommand>, 0> _meshCommands;
+		std::int32_t _meshVerticesCount;
+		// Held by pointer, so a buffer that was already handed out doesn't move when the pool grows
+		SmallVector<std::unique_ptr<SmallVector<float, 0>>, 0> _meshVertices;
 	};
 }
\ No newline at end of file
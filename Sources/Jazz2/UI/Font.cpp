@@ -8,15 +8,17 @@
 
 #include <IO/Compression/DeflateStream.h>
 
+#include <Cryptography/xxHash.h>
 #include <Utf8.h>
 
 using namespace Death;
+using namespace Death::Cryptography;
 using namespace Death::IO::Compression;
 
 namespace Jazz2::UI
 {
 	Font::Font(const std::unique_ptr<Stream>& s, StringView path, const std::uint32_t* palette)
-		: _asciiChars{}, _lineHeight(0), _baseSpacing(0)
+		: _asciiChars{}, _lineHeight(0), _baseSpacing(0), _mostRecentLayout(-1), _leastRecentLayout(-1)
 	{
 		if (!s->IsValid()) {
 			// A font that can't be opened at all used to fail silently here, which then looked like a
@@ -269,15 +271,84 @@ namespace Jazz2::UI
 		return Vector2f(ceilf(totalWidth), ceilf(totalHeight));
 	}
 
-	void Font::DrawString(Canvas* canvas, StringView text, std::int32_t& charOffset, float x, float y, std::uint16_t z, Alignment align, Colorf color, float scale, float angleOffset, float varianceX, float varianceY, float speed, float charSpacing, float lineSpacing)
+	const Font::TextLayout& Font::GetTextLayout(StringView text, float scale, float charSpacing, float lineSpacing, Alignment align)
 	{
-		std::size_t textLength = text.size();
-		if (textLength == 0 || _lineHeight <= 0) {
-			return;
+		// The layout parameters seed the hash of the text, so the same string drawn differently gets its own entry
+		const float params[4] = { scale, charSpacing, lineSpacing, float(align) };
+		const std::uint64_t key = xxHash3(text.data(), text.size(), xxHash3(params, sizeof(params)));
+
+		std::int32_t index;
+		auto it = _layoutLookup.find(key);
+		if (it != _layoutLookup.end()) {
+			index = it->second;
+			TouchTextLayout(index, true);
+			TextLayout& layout = _layoutCache[index];
+			if (layout.Scale == scale && layout.CharSpacing == charSpacing && layout.LineSpacing == lineSpacing &&
+				layout.Align == align && layout.Text == text) {
+				return layout;
+			}
+			// A different string with the same key, it takes the entry over
+		} else if (std::int32_t(_layoutCache.size()) < MaxCachedLayouts) {
+			index = std::int32_t(_layoutCache.size());
+			_layoutCache.emplace_back();
+			TouchTextLayout(index, false);
+			_layoutLookup.emplace(key, index);
+		} else {
+			// Strings that change every frame (timers, scores) only ever miss, they just cycle through the least recently
+			// used entries without pushing out the static text, which is drawn again and again
+			index = _leastRecentLayout;
+			_layoutLookup.erase(_layoutCache[index].Key);
+			TouchTextLayout(index, true);
+			_layoutLookup.emplace(key, index);
 		}
 
-		// TODO: Revise this
-		float phase = canvas->AnimTime * speed * 16.0f;
+		TextLayout& layout = _layoutCache[index];
+		layout.Key = key;
+		layout.Text = text;
+		layout.Scale = scale;
+		layout.CharSpacing = charSpacing;
+		layout.LineSpacing = lineSpacing;
+		layout.Align = align;
+		LayOutString(layout, text);
+		return layout;
+	}
+
+	void Font::TouchTextLayout(std::int32_t index, bool isLinked)
+	{
+		TextLayout& layout = _layoutCache[index];
+		if (isLinked) {
+			if (index == _mostRecentLayout) {
+				return;
+			}
+			// Not the most recent one, so there is always a more recent neighbour
+			_layoutCache[layout.MoreRecent].LessRecent = layout.LessRecent;
+			if (layout.LessRecent >= 0) {
+				_layoutCache[layout.LessRecent].MoreRecent = layout.MoreRecent;
+			} else {
+				_leastRecentLayout = layout.MoreRecent;
+			}
+		}
+
+		layout.MoreRecent = -1;
+		layout.LessRecent = _mostRecentLayout;
+		if (_mostRecentLayout >= 0) {
+			_layoutCache[_mostRecentLayout].MoreRecent = index;
+		} else {
+			_leastRecentLayout = index;
+		}
+		_mostRecentLayout = index;
+	}
+
+	void Font::LayOutString(TextLayout& layout, StringView text) const
+	{
+		layout.Glyphs.clear();
+		layout.CharCount = 0;
+
+		std::size_t textLength = text.size();
+		const float scale = layout.Scale;
+		const float lineSpacing = layout.LineSpacing;
+		const Alignment align = layout.Align;
+		float charSpacing = layout.CharSpacing;
 
 		// Maximum number of lines - center and right alignment starts to glitch if text has more lines, but it should be enough in most cases
 		constexpr std::int32_t MaxLines = 16;
@@ -285,8 +356,7 @@ namespace Jazz2::UI
 		// Preprocessing. Its whole output - the total extent and the per-line widths - exists to place
 		// text that is centred, right aligned or bottom aligned. Left/top aligned text reads none of it,
 		// so measuring for it means walking every character of the string a second time to compute
-		// numbers nothing goes on to use. The credits are one long left-aligned block redrawn every
-		// frame, which is exactly the case that pays for it.
+		// numbers nothing goes on to use.
 		const Alignment horizontalAlign = (align & Alignment::HorizontalMask);
 		const Alignment verticalAlign = (align & Alignment::VerticalMask);
 		const bool measureExtent = (horizontalAlign == Alignment::Center || horizontalAlign == Alignment::Right ||
@@ -378,12 +448,12 @@ namespace Jazz2::UI
 			lineWidths[line & (MaxLines - 1)] = lastWidth;
 			totalHeight += (_lineHeight * scale * lineSpacing);
 
-			// Format tags inside the walk above move this; the render pass has to start where the caller left it
+			// Format tags inside the walk above move this; the layout pass has to start where the caller left it
 			charSpacing = charSpacingPre;
 		}
 
-		// Rendering
-		Vector2f originPos = Vector2f(x, y);
+		// Layout, relative to the position the string is drawn at
+		Vector2f originPos = Vector2f::Zero;
 		switch (align & Alignment::HorizontalMask) {
 			case Alignment::Center: originPos.X -= totalWidth * 0.5f; break;
 			case Alignment::Right: originPos.X -= totalWidth; break;
@@ -400,22 +470,9 @@ namespace Jazz2::UI
 			case Alignment::Right: originPos.X += (totalWidth - lineWidths[0]); break;
 		}
 
-		Vector2i texSize = _texture->GetSize();
-		Shader* colorizeShader;
-		bool useRandomColor, isShadow;
-		float alpha;
-		if (color.R == DefaultColor.R && color.G == DefaultColor.G && color.B == DefaultColor.B) {
-			colorizeShader = nullptr;
-			useRandomColor = false;
-			isShadow = false;
-			alpha = color.A;
-			color = Colorf(1.0f, 1.0f, 1.0f, alpha);
-		} else {
-			colorizeShader = ContentResolver::Get().GetShader(PrecompiledShader::Colorized);
-			useRandomColor = (color.R == RandomColor.R && color.G == RandomColor.G && color.B == RandomColor.B);
-			isShadow = (color.R == 0.0f && color.G == 0.0f && color.B == 0.0f);
-			alpha = std::min(color.A * 2.0f, 1.0f);
-		}
+		// The color tags are only recorded here, whether they apply depends on the color the string is drawn with
+		LayoutColorTag colorTag = LayoutColorTag::None;
+		std::uint32_t tagColor = 0;
 
 		idx = 0;
 		line = 0;
@@ -459,16 +516,13 @@ namespace Jazz2::UI
 									idx = std::int32_t(cursor.second());
 								} while (idx < textLength);
 
-								if (paramLength > 0 && !useRandomColor && !isShadow) {
+								if (paramLength > 0) {
 									param[paramLength] = '\0';
 									char* end = &param[paramLength];
 									unsigned long paramValue = strtoul(param, &end, 16);
 									if (param != end) {
-										color = Color(paramValue);
-										color.SetAlpha(0.5f * alpha);
-										if (colorizeShader == nullptr) {
-											colorizeShader = ContentResolver::Get().GetShader(PrecompiledShader::Colorized);
-										}
+										colorTag = LayoutColorTag::Custom;
+										tagColor = std::uint32_t(paramValue);
 									}
 								}
 							}
@@ -505,10 +559,7 @@ namespace Jazz2::UI
 						cursor = Utf8::NextChar(text, idx);
 						if (cursor.first() == 'c') {
 							// Reset color
-							if (!useRandomColor && !isShadow) {
-								color = Colorf(1.0f, 1.0f, 1.0f, alpha);
-								colorizeShader = nullptr;
-							}
+							colorTag = LayoutColorTag::Reset;
 						} else if (cursor.first() == 'w') {
 							// Reset char spacing
 							charSpacing = charSpacingPre;
@@ -526,113 +577,222 @@ namespace Jazz2::UI
 					// A glyph is stored trimmed to the pixels it inks, so it draws at its bearing from the pen
 					// rather than at the pen itself. One with no pixels at all - a space - only moves the pen.
 					if (glyph.Width > 0 && glyph.Height > 0) {
-						if (useRandomColor) {
-							const Colorf& newColor = RandomColors[charOffset % std::int32_t(arraySize(RandomColors))];
-							color = Colorf(newColor.R, newColor.G, newColor.B, color.A);
-						}
+						LayoutGlyph& laidOut = layout.Glyphs.emplace_back();
+						laidOut.Pos = Vector2f(originPos.X + glyph.BearingX * scale, originPos.Y + glyph.BearingY * scale);
+						laidOut.CharIndex = layout.CharCount;
+						laidOut.Color = tagColor;
+						laidOut.TexX = glyph.X;
+						laidOut.TexY = glyph.Y;
+						laidOut.Width = glyph.Width;
+						laidOut.Height = glyph.Height;
+						laidOut.ColorTag = colorTag;
+					}
 
-						Vector2f pos = Vector2f(originPos.X + glyph.BearingX * scale, originPos.Y + glyph.BearingY * scale);
-
-						// A glyph outside the view is laid out but not drawn. Nothing above depends on this
-						// and nothing below it does either - the pen, the character counter and the wobble
-						// phase all advance regardless - so the text lays out identically either way, and a
-						// glyph that cannot be seen costs neither the two trigonometric calls of the wobble
-						// nor a render command, a material setup and a draw. That is the difference between
-						// the cost of a screen of text and the cost of all the text there is: the credits
-						// are one long block scrolled past a small window, and every line of it, on screen
-						// or not, used to be submitted every frame.
-						//
-						// Tested before the wobble rather than after, which is where the saving mostly is -
-						// a sine and a cosine per glyph is the dearest thing in this loop. That costs
-						// nothing in accuracy: the wobble is bounded by the variance, so a glyph further
-						// out than that cannot be brought back into view by it, and it is carried here as
-						// a margin. The transform is the glyph's TOP-LEFT corner, not its centre - the
-						// canvas_item vertex stage spans the quad from the model origin by spriteSize.
-						//
-						// Tested against the whole view rather than the caller's clip rectangle, which is
-						// the conservative choice: a section that clips more tightly still gets everything
-						// it asks for. A canvas that never set its view size fails open and draws
-						// everything, since culling against a zero view would silently swallow the text.
-						const float layerScale = canvas->LayerScale;
-						const Vector2f unwobbled = pos * layerScale + canvas->LayerOffset;
-						const float glyphW = glyph.Width * scale * layerScale;
-						const float glyphH = glyph.Height * scale * layerScale;
-						// One extra pixel covers the rounding to whole pixels below
-						const float marginX = (angleOffset > 0.0f ? std::abs(varianceX) * scale * layerScale : 0.0f) + 1.0f;
-						const float marginY = (angleOffset > 0.0f ? std::abs(varianceY) * scale * layerScale : 0.0f) + 1.0f;
-						const bool boundsKnown = (canvas->ViewSize.X > 0 && canvas->ViewSize.Y > 0);
-						const bool onScreen = (!boundsKnown ||
-							(unwobbled.X + glyphW + marginX >= 0.0f && unwobbled.Y + glyphH + marginY >= 0.0f &&
-							 unwobbled.X - marginX <= float(canvas->ViewSize.X) &&
-							 unwobbled.Y - marginY <= float(canvas->ViewSize.Y)));
-						if (onScreen) {
-							if (angleOffset > 0.0f) {
-								float currentPhase = (phase + charOffset) * angleOffset * fPi;
-								if (speed > 0.0f && (charOffset % 2) == 1) {
-									currentPhase = -currentPhase;
-								}
+					originPos.X += ((glyph.Advance + _baseSpacing) * scale * charSpacing);
+					layout.CharCount++;
+				}
+			}
 
-								pos.X += cosf(currentPhase) * varianceX * scale;
-								pos.Y += sinf(currentPhase) * varianceY * scale;
-							}
+			idx = std::int32_t(cursor.second());
+		} while (idx < textLength);
+	}
 
-							// Apply the canvas-wide draw transform (menu section transitions; identity by default)
-							pos = pos * layerScale + canvas->LayerOffset;
-							float glyphScale = scale * layerScale;
-							Colorf glyphColor = color * canvas->LayerColor;
-
-							pos.X = std::round(pos.X);
-							pos.Y = std::round(pos.Y);
-
-							Vector4f texCoords = Vector4f(
-								glyph.Width / float(texSize.X),
-								glyph.X / float(texSize.X),
-								glyph.Height / float(texSize.Y),
-								glyph.Y / float(texSize.Y)
-							);
-
-							auto command = canvas->RentRenderCommand();
-							command->SetType(RenderCommand::Type::Text);
-							bool shaderChanged = (colorizeShader
-								? command->GetMaterial().SetShader(colorizeShader)
-								: command->GetMaterial().SetShaderProgramType(Material::ShaderProgramType::Sprite));
-							if (shaderChanged) {
-								command->GetMaterial().ReserveUniformsDataMemory();
-								command->GetGeometry().SetDrawParameters(PrimitiveType::TriangleStrip, 0, 4);
-								// Required to reset render command properly
-								//command->SetTransformation(command->transformation());
-
-								auto* textureUniform = command->GetMaterial().Uniform(Material::TextureUniformName);
-								if (textureUniform && textureUniform->GetIntValue(0) != 0) {
-									textureUniform->SetIntValue(0); // GL_TEXTURE0
-								}
-							}
+	void Font::DrawString(Canvas* canvas, StringView text, std::int32_t& charOffset, float x, float y, std::uint16_t z, Alignment align, Colorf color, float scale, float angleOffset, float varianceX, float varianceY, float speed, float charSpacing, float lineSpacing)
+	{
+		if (text.empty() || _lineHeight <= 0) {
+			return;
+		}
 
-							// Separate alpha blend so text (e.g. semi-transparent shadows) accumulates correct alpha coverage
-							// when drawn into an RGBA render target, harmless for opaque/RGB targets
-							command->GetMaterial().SetBlendingFactors(BlendingFactor::SrcAlpha, BlendingFactor::OneMinusSrcAlpha, BlendingFactor::One, BlendingFactor::OneMinusSrcAlpha);
+		const TextLayout& layout = GetTextLayout(text, scale, charSpacing, lineSpacing, align);
 
-							auto* instanceBlock = command->GetInstanceBlock();
-							instanceBlock->GetUniform(Material::TexRectUniformName)->SetFloatVector(texCoords.Data());
-							instanceBlock->GetUniform(Material::SpriteSizeUniformName)->SetFloatValue(glyph.Width * glyphScale, glyph.Height * glyphScale);
-							instanceBlock->GetUniform(Material::ColorUniformName)->SetFloatVector(glyphColor.Data());
+		// TODO: Revise this
+		float phase = canvas->AnimTime * speed * 16.0f;
 
-							command->SetTransformation(Matrix4x4f::Translation(pos.X, pos.Y, 0.0f));
-							command->SetLayer(z - (charOffset & 1));
-							command->GetMaterial().SetTexture(*_texture.get());
+		Vector2i texSize = _texture->GetSize();
+		Shader* colorizeShader;
+		bool useRandomColor, isShadow;
+		float alpha;
+		if (color.R == DefaultColor.R && color.G == DefaultColor.G && color.B == DefaultColor.B) {
+			colorizeShader = nullptr;
+			useRandomColor = false;
+			isShadow = false;
+			alpha = color.A;
+			color = Colorf(1.0f, 1.0f, 1.0f, alpha);
+		} else {
+			colorizeShader = ContentResolver::Get().GetShader(PrecompiledShader::Colorized);
+			useRandomColor = (color.R == RandomColor.R && color.G == RandomColor.G && color.B == RandomColor.B);
+			isShadow = (color.R == 0.0f && color.G == 0.0f && color.B == 0.0f);
+			alpha = std::min(color.A * 2.0f, 1.0f);
+		}
 
-							canvas->_currentRenderQueue->AddCommand(command);
-						}
+		// Glyphs drawn with the plain sprite shader are collected into one mesh per layer (glyphs alternate between
+		// two layers, so overlapping neighbours always stack the same way) and submitted as a single command each,
+		// instead of renting, setting up and queueing a command per glyph. Colorized glyphs keep their own commands,
+		// the mesh shader has no colorization - except for shadows, see below.
+		const bool useGlyphRuns = (ContentResolver::Get().GetShader(PrecompiledShader::TileMapMesh) != nullptr);
+		SmallVector<float, 0>* runVertices[2] = {};
+
+		for (const LayoutGlyph& glyph : layout.Glyphs) {
+			const std::int32_t glyphCharOffset = charOffset + glyph.CharIndex;
+
+			// Random and shadow colors ignore the color tags
+			Colorf glyphColor = color;
+			Shader* glyphShader = colorizeShader;
+			if (!useRandomColor && !isShadow) {
+				if (glyph.ColorTag == LayoutColorTag::Custom) {
+					glyphColor = Color(glyph.Color);
+					glyphColor.SetAlpha(0.5f * alpha);
+					if (glyphShader == nullptr) {
+						glyphShader = ContentResolver::Get().GetShader(PrecompiledShader::Colorized);
+					}
+				} else if (glyph.ColorTag == LayoutColorTag::Reset) {
+					glyphColor = Colorf(1.0f, 1.0f, 1.0f, alpha);
+					glyphShader = nullptr;
+				}
+			}
+			if (useRandomColor) {
+				const Colorf& newColor = RandomColors[glyphCharOffset % std::int32_t(arraySize(RandomColors))];
+				glyphColor = Colorf(newColor.R, newColor.G, newColor.B, glyphColor.A);
+			}
+
+			Vector2f pos = Vector2f(x + glyph.Pos.X, y + glyph.Pos.Y);
+
+			// A glyph outside the view is laid out but not drawn. Nothing depends on this - the character counter
+			// and the wobble phase come from the layout - so the text lays out identically either way, and a glyph
+			// that cannot be seen costs neither the two trigonometric calls of the wobble nor a draw. That is the
+			// difference between the cost of a screen of text and the cost of all the text there is: the credits
+			// are one long block scrolled past a small window.
+			//
+			// Tested before the wobble rather than after, which is where the saving mostly is - a sine and a
+			// cosine per glyph is the dearest thing in this loop. That costs nothing in accuracy: the wobble is
+			// bounded by the variance, so a glyph further out than that cannot be brought back into view by it,
+			// and it is carried here as a margin. The transform is the glyph's TOP-LEFT corner, not its centre -
+			// the canvas_item vertex stage spans the quad from the model origin by spriteSize.
+			//
+			// Tested against the whole view rather than the caller's clip rectangle, which is the conservative
+			// choice: a section that clips more tightly still gets everything it asks for. A canvas that never
+			// set its view size fails open and draws everything, since culling against a zero view would
+			// silently swallow the text.
+			const float layerScale = canvas->LayerScale;
+			const Vector2f unwobbled = pos * layerScale + canvas->LayerOffset;
+			const float glyphW = glyph.Width * scale * layerScale;
+			const float glyphH = glyph.Height * scale * layerScale;
+			// One extra pixel covers the rounding to whole pixels below
+			const float marginX = (angleOffset > 0.0f ? std::abs(varianceX) * scale * layerScale : 0.0f) + 1.0f;
+			const float marginY = (angleOffset > 0.0f ? std::abs(varianceY) * scale * layerScale : 0.0f) + 1.0f;
+			const bool boundsKnown = (canvas->ViewSize.X > 0 && canvas->ViewSize.Y > 0);
+			const bool onScreen = (!boundsKnown ||
+				(unwobbled.X + glyphW + marginX >= 0.0f && unwobbled.Y + glyphH + marginY >= 0.0f &&
+				 unwobbled.X - marginX <= float(canvas->ViewSize.X) &&
+				 unwobbled.Y - marginY <= float(canvas->ViewSize.Y)));
+			if (!onScreen) {
+				continue;
+			}
+
+			if (angleOffset > 0.0f) {
+				float currentPhase = (phase + glyphCharOffset) * angleOffset * fPi;
+				if (speed > 0.0f && (glyphCharOffset % 2) == 1) {
+					currentPhase = -currentPhase;
+				}
+
+				pos.X += cosf(currentPhase) * varianceX * scale;
+				pos.Y += sinf(currentPhase) * varianceY * scale;
+			}
+
+			// Apply the canvas-wide draw transform (menu section transitions; identity by default)
+			pos = pos * layerScale + canvas->LayerOffset;
+			float glyphScale = scale * layerScale;
+			glyphColor = glyphColor * canvas->LayerColor;
+
+			pos.X = std::round(pos.X);
+			pos.Y = std::round(pos.Y);
+
+			if (useGlyphRuns) {
+				bool inRun = (glyphShader == nullptr);
+				Colorf vertexColor = glyphColor;
+				if (!inRun && isShadow) {
+					// A shadow is colorized black, and the colorization (dye = 1 + (COLOR - 0.5) * 4, multiplied into the
+					// texel's gray) turns every channel of black negative, so the result is black whatever the texel is.
+					// Only the alpha remains, the texel's times dye.a - which the mesh shader reproduces exactly as long
+					// as dye.a doesn't exceed 1, where the colorization would saturate the product instead.
+					const float dyeAlpha = 1.0f + (glyphColor.A - 0.5f) * 4.0f;
+					if (dyeAlpha <= 1.0f) {
+						inRun = true;
+						vertexColor = Colorf(0.0f, 0.0f, 0.0f, std::max(dyeAlpha, 0.0f));
 					}
+				}
+				if (inRun) {
+					SmallVector<float, 0>*& vertices = runVertices[glyphCharOffset & 1];
+					if (vertices == nullptr) {
+						vertices = &canvas->RentMeshVertices();
+					}
+					const float xr = pos.X + glyph.Width * glyphScale;
+					const float yr = pos.Y + glyph.Height * glyphScale;
+					const float u0 = glyph.TexX / float(texSize.X);
+					const float u1 = (glyph.TexX + glyph.Width) / float(texSize.X);
+					const float v0 = glyph.TexY / float(texSize.Y);
+					const float v1 = (glyph.TexY + glyph.Height) / float(texSize.Y);
+					const float r = vertexColor.R, g = vertexColor.G, b = vertexColor.B, a = vertexColor.A;
+					// Same six vertices as TileMap::AppendTileQuad(), the layout the mesh shader consumers expect
+					vertices->append({
+						pos.X, pos.Y, u0, v0, r, g, b, a,
+						xr, pos.Y, u1, v0, r, g, b, a,
+						xr, yr, u1, v1, r, g, b, a,
+						pos.X, pos.Y, u0, v0, r, g, b, a,
+						xr, yr, u1, v1, r, g, b, a,
+						pos.X, yr, u0, v1, r, g, b, a
+					});
+					continue;
+				}
+			}
 
-					originPos.X += ((glyph.Advance + _baseSpacing) * scale * charSpacing);
-					charOffset++;
+			Vector4f texCoords = Vector4f(
+				glyph.Width / float(texSize.X),
+				glyph.TexX / float(texSize.X),
+				glyph.Height / float(texSize.Y),
+				glyph.TexY / float(texSize.Y)
+			);
+
+			auto command = canvas->RentRenderCommand();
+			command->SetType(RenderCommand::Type::Text);
+			bool shaderChanged = (glyphShader
+				? command->GetMaterial().SetShader(glyphShader)
+				: command->GetMaterial().SetShaderProgramType(Material::ShaderProgramType::Sprite));
+			if (shaderChanged) {
+				command->GetMaterial().ReserveUniformsDataMemory();
+				command->GetGeometry().SetDrawParameters(PrimitiveType::TriangleStrip, 0, 4);
+				// Required to reset render command properly
+				//command->SetTransformation(command->transformation());
+
+				auto* textureUniform = command->GetMaterial().Uniform(Material::TextureUniformName);
+				if (textureUniform && textureUniform->GetIntValue(0) != 0) {
+					textureUniform->SetIntValue(0); // GL_TEXTURE0
 				}
 			}
 
-			idx = std::int32_t(cursor.second());
-		} while (idx < textLength);
-		charOffset++;
+			// Separate alpha blend so text (e.g. semi-transparent shadows) accumulates correct alpha coverage
+			// when drawn into an RGBA render target, harmless for opaque/RGB targets
+			command->GetMaterial().SetBlendingFactors(BlendingFactor::SrcAlpha, BlendingFactor::OneMinusSrcAlpha, BlendingFactor::One, BlendingFactor::OneMinusSrcAlpha);
+
+			auto* instanceBlock = command->GetInstanceBlock();
+			instanceBlock->GetUniform(Material::TexRectUniformName)->SetFloatVector(texCoords.Data());
+			instanceBlock->GetUniform(Material::SpriteSizeUniformName)->SetFloatValue(glyph.Width * glyphScale, glyph.Height * glyphScale);
+			instanceBlock->GetUniform(Material::ColorUniformName)->SetFloatVector(glyphColor.Data());
+
+			command->SetTransformation(Matrix4x4f::Translation(pos.X, pos.Y, 0.0f));
+			command->SetLayer(z - (glyphCharOffset & 1));
+			command->GetMaterial().SetTexture(*_texture.get());
+
+			canvas->_currentRenderQueue->AddCommand(command);
+		}
+
+		for (std::int32_t i = 0; i < std::int32_t(arraySize(runVertices)); i++) {
+			if (runVertices[i] != nullptr) {
+				canvas->DrawMesh(*runVertices[i], *_texture, z - i, RenderCommand::Type::Text);
+			}
+		}
+
+		charOffset += layout.CharCount + 1;
 	}
 
 	String Font::StripFormatting(StringView text)
@@ -30,6 +30,13 @@ namespace Jazz2::UI
 		-   @cpp "\f[w:XX]" @ce --- Sets the character spacing as a percentage, recommended range is 80% to 120%
 		-   @cpp "\f[/w]" @ce --- Resets the character spacing
 
+		@section Jazz2-UI-Font-layout Layout cache
+
+		Menus, the console and the credits redraw the same strings every frame, so the result of parsing and
+		aligning a string is kept in a small cache keyed by the text and every parameter that affects the layout
+		(scale, spacing and alignment). Only what depends on the frame --- the position, the wobble, the colors and
+		the canvas draw transform --- is applied on each call. Glyphs drawn with the plain sprite shader are then
+		submitted as one mesh per string instead of one render command per glyph.
 	*/
 	class Font
 	{
@@ -85,14 +92,70 @@ namespace Jazz2::UI
 			Colorf(0.56f, 0.50f, 0.42f, 0.5f),
 		};
 
+#ifndef DOXYGEN_GENERATING_OUTPUT
+		// Doxygen 1.12.0 outputs also private structs/unions even if it shouldn't
+
+		/** @brief Maximum number of laid out strings kept by @ref _layoutCache */
+		static constexpr std::int32_t MaxCachedLayouts = 64;
+
+		/** @brief Color tag in effect at a glyph, see @ref LayoutGlyph::ColorTag */
+		enum class LayoutColorTag : std::uint8_t {
+			None,		/**< No color tag precedes the glyph, the color passed to @ref DrawString() applies */
+			Custom,		/**< The glyph follows @cpp "\f[c:#RRGGBB]" @ce, see @ref LayoutGlyph::Color */
+			Reset		/**< The glyph follows @cpp "\f[/c]" @ce */
+		};
+
+		/** @brief Visible glyph of a laid out string */
+		struct LayoutGlyph {
+			/** @brief Top-left corner relative to the position passed to @ref DrawString(), already aligned and scaled */
+			Vector2f Pos;
+			/** @brief Index of the character among the characters that advance the pen, offsets `charOffset` */
+			std::int32_t CharIndex;
+			/** @brief Color from the @cpp "\f[c:#RRGGBB]" @ce tag in effect */
+			std::uint32_t Color;
+			/** @brief Position of the glyph in the atlas */
+			std::uint16_t TexX, TexY;
+			/** @brief Size of the glyph in the atlas */
+			std::uint8_t Width, Height;
+			/** @brief Color tag in effect */
+			LayoutColorTag ColorTag;
+		};
+
+		/** @brief Laid out string */
+		struct TextLayout {
+			/** @brief Key of the layout in @ref _layoutLookup */
+			std::uint64_t Key;
+			String Text;
+			float Scale;
+			float CharSpacing;
+			float LineSpacing;
+			Alignment Align;
+			/** @brief Neighbours in the usage order of @ref _layoutCache, `-1` at either end */
+			std::int32_t MoreRecent, LessRecent;
+			/** @brief Number of characters that advance the pen */
+			std::int32_t CharCount;
+			SmallVector<LayoutGlyph, 0> Glyphs;
+		};
+#endif
+
 		FontFormat::Glyph _asciiChars[128];
 		HashMap<std::uint32_t, FontFormat::Glyph> _unicodeChars;
 		/** @brief How far one line of text sits below the previous one */
 		std::int32_t _lineHeight;
 		std::int32_t _baseSpacing;
 		std::unique_ptr<Texture> _texture;
+		SmallVector<TextLayout, 0> _layoutCache;
+		HashMap<std::uint64_t, std::int32_t> _layoutLookup;
+		std::int32_t _mostRecentLayout;
+		std::int32_t _leastRecentLayout;
 
 		/** @brief Returns the glyph of the specified character, or the placeholder if the font doesn't have it */
 		const FontFormat::Glyph& GetGlyph(char32_t c) const;
+		/** @brief Returns the layout of a string from the cache, laying it out first if it's not there */
+		const TextLayout& GetTextLayout(StringView text, float scale, float charSpacing, float lineSpacing, Alignment align);
+		/** @brief Moves a cached layout to the front of the usage order, or inserts a new one there */
+		void TouchTextLayout(std::int32_t index, bool isLinked);
+		/** @brief Parses the formatting of a string and places its glyphs */
+		void LayOutString(TextLayout& layout, StringView text) const;
 	};
 }
\ No newline at end of file
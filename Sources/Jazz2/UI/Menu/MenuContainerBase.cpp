@@ -5,7 +5,6 @@
 #include "../../Input/ControlScheme.h"
 
 #include "../../../nCine/Application.h"
-#include "../../../nCine/Base/Random.h"
 #include "../../../nCine/Input/JoyMapping.h"
 
 #include <algorithm>
@@ -303,13 +302,15 @@ namespace Jazz2::UI::Menu
 #if defined(WITH_AUDIO)
 		auto it = _metadata->Sounds.find(String::nullTerminatedView(identifier));
 		if (it != _metadata->Sounds.end()) {
-			std::int32_t idx = (it->second.Buffers.size() > 1 ? Random().Next(0, (std::int32_t)it->second.Buffers.size()) : 0);
-			auto& player = _playingSounds.emplace_back(std::make_shared<AudioBufferPlayer>(&it->second.Buffers[idx]->Buffer));
-			player->setPosition(Vector3f(0.0f, 0.0f, 100.0f));
-			player->setGain(gain * PreferencesCache::MasterVolume * PreferencesCache::SfxVolume);
-			player->setSourceRelative(true);
-
-			player->play();
+			// The pause menu is shown during a level, so it must not advance the generator the simulation depends on
+			if (auto* variant = it->second.PickVariant()) {
+				auto& player = _playingSounds.emplace_back(std::make_shared<AudioBufferPlayer>(&variant->Buffer));
+				player->setPosition(Vector3f(0.0f, 0.0f, 100.0f));
+				player->setGain(gain * PreferencesCache::MasterVolume * PreferencesCache::SfxVolume);
+				player->setSourceRelative(true);
+
+				player->play();
+			}
 		} else {
 			LOGE("Sound effect \"{}\" was not found", identifier);
 		}
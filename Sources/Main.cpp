@@ -49,6 +49,9 @@
 #	include "Jazz2/Multiplayer/INetworkHandler.h"
 #	include "Jazz2/Multiplayer/MpLevelHandler.h"
 #	include "Jazz2/Multiplayer/PacketTypes.h"
+#	if defined(DEDICATED_SERVER_BENCHMARK)
+#		include "Jazz2/Multiplayer/ServerBenchmark.h"
+#	endif
 using namespace Jazz2::Multiplayer;
 #endif
 
@@ -146,6 +149,8 @@ public:
 #if defined(WITH_LIBRETRO)
 	bool OnSaveState(Stream& dest) override;
 	bool OnLoadState(std::shared_ptr<Stream> src) override;
+	bool OnSaveFrameState(Stream& dest) override;
+	bool OnLoadFrameState(Stream& src) override;
 #endif
 	void ResumeSavedState() override;
 	bool SaveCurrentStateIfAny() override;
@@ -187,6 +192,9 @@ private:
 #if defined(WITH_MULTIPLAYER)
 	std::unique_ptr<NetworkManager> _networkManager;
 	std::unique_ptr<Stream> _streamedAsset;
+#	if defined(DEDICATED_SERVER_BENCHMARK)
+	std::unique_ptr<ServerBenchmark> _benchmark;
+#	endif
 #endif
 
 	void OnBeginInitialize();
@@ -201,6 +209,9 @@ private:
 	void CheckUpdates();
 #endif
 	bool SetLevelHandler(const LevelInitialization& levelInit);
+#if defined(DEATH_TARGET_APPLE) || defined(DEATH_TARGET_UNIX) || (defined(DEATH_TARGET_WINDOWS) && !defined(DEATH_TARGET_WINDOWS_RT))
+	void RunReplay(StringView path);
+#endif
 	void HandleEndOfGame(const LevelInitialization& levelInit, bool playerDied);
 	void RemoveResumableStateIfAny();
 #if defined(DEATH_TARGET_ANDROID)
@@ -208,6 +219,9 @@ private:
 #endif
 #if defined(WITH_MULTIPLAYER) && defined(WITH_THREADS) && !defined(DEATH_TARGET_EMSCRIPTEN)
 	void RunDedicatedServer(StringView configPath);
+#	if defined(DEDICATED_SERVER_BENCHMARK)
+	void RunServerBenchmark(const AppConfiguration& config);
+#	endif
 	void StartProcessingStdin();
 #endif
 	static void WriteCacheDescriptor(StringView path, std::uint64_t currentVersion, std::int64_t animsModified);
@@ -320,9 +334,11 @@ void GameEventHandler::OnPreInitialize(AppConfiguration& config)
 
 #if defined(WITH_MULTIPLAYER) && defined(DEDICATED_SERVER)
 	constexpr bool isServer = true;
+	constexpr bool isReplay = false;
 #elif defined(DEATH_TARGET_APPLE) || defined(DEATH_TARGET_UNIX) || (defined(DEATH_TARGET_WINDOWS) && !defined(DEATH_TARGET_WINDOWS_RT))
 	// Allow `/extract-pak` and `/server` only on PC platforms
 	bool isServer = false;
+	bool isReplay = false;
 	for (std::int32_t i = 0; i < config.argc(); i++) {
 		auto arg = config.argv(i);
 		if (arg == "/extract-pak"_s && i + 2 < config.argc()) {
@@ -345,9 +361,13 @@ void GameEventHandler::OnPreInitialize(AppConfiguration& config)
 			isServer = true;
 		}
 #	endif
+		if (arg == "/replay"_s) {
+			isReplay = true;
+		}
 	}
 #else
 	constexpr bool isServer = false;
+	constexpr bool isReplay = false;
 #endif
 
 	PreferencesCache::Initialize(config);
@@ -361,6 +381,17 @@ void GameEventHandler::OnPreInitialize(AppConfiguration& config)
 		config.withAudio = false;
 		config.withVSync = false;
 		config.frameLimit = (std::uint32_t)FrameTimer::FramesPerSecond;
+		// Worker threads are used to encode actor updates for many peers in parallel
+		config.withThreads = true;
+
+		auto& resolver = ContentResolver::Get();
+		resolver.SetHeadless(true);
+	} else if (isReplay) {
+		config.withGraphics = false;
+		config.withAudio = false;
+		config.withVSync = false;
+		// Replay is played back as fast as possible, see RunReplay()
+		config.frameLimit = 0;
 
 		auto& resolver = ContentResolver::Get();
 		resolver.SetHeadless(true);
@@ -431,7 +462,9 @@ void GameEventHandler::OnInitialize()
 #	endif
 #endif
 
-#if defined(WITH_MULTIPLAYER) && defined(DEDICATED_SERVER)
+#if defined(WITH_MULTIPLAYER) && defined(DEDICATED_SERVER_BENCHMARK)
+	RunServerBenchmark(theApplication().GetAppConfiguration());
+#elif defined(WITH_MULTIPLAYER) && defined(DEDICATED_SERVER)
 	const AppConfiguration& config = theApplication().GetAppConfiguration();
 	StringView configPath;
 	if (config.argc() > 0) {
@@ -478,6 +511,10 @@ void GameEventHandler::OnInitialize()
 			}
 		}
 #		endif
+		if (arg == "/replay"_s && i + 1 < config.argc()) {
+			RunReplay(config.argv(i + 1));
+			return;
+		}
 #		if defined(WITH_MULTIPLAYER)
 		if ((arg == "/connect"_s || arg == "--connect"_s || arg == "-c"_s) && i + 1 < config.argc()) {
 			auto endpoint = config.argv(i + 1);
@@ -543,6 +580,12 @@ void GameEventHandler::OnInitialize()
 
 void GameEventHandler::OnBeginFrame()
 {
+#if defined(WITH_MULTIPLAYER) && defined(DEDICATED_SERVER_BENCHMARK)
+	if DEATH_UNLIKELY(_benchmark != nullptr && runtime_cast<MpLevelHandler>(_currentHandler) != nullptr) {
+		_benchmark->BeginTick(_networkManager.get());
+	}
+#endif
+
 	if (!_pendingCallbacks.empty()) {
 		ZoneScopedNC("Pending callbacks", 0x888888);
 
@@ -580,12 +623,37 @@ void GameEventHandler::OnBeginFrame()
 	}
 
 	_currentHandler->OnBeginFrame();
+
+#if defined(WITH_MULTIPLAYER) && defined(DEDICATED_SERVER_BENCHMARK)
+	if DEATH_UNLIKELY(_benchmark != nullptr) {
+		_benchmark->MarkPhase(ServerBenchmark::TickPhase::BeginFrame);
+	}
+#endif
 }
 
 void GameEventHandler::OnPostUpdate()
 {
+#if defined(WITH_MULTIPLAYER) && defined(DEDICATED_SERVER_BENCHMARK)
+	if DEATH_UNLIKELY(_benchmark != nullptr) {
+		_benchmark->MarkPhase(ServerBenchmark::TickPhase::Update);
+	}
+#endif
+
 	_currentHandler->OnEndFrame();
 
+#if defined(WITH_MULTIPLAYER) && defined(DEDICATED_SERVER_BENCHMARK)
+	if DEATH_UNLIKELY(_benchmark != nullptr) {
+		if (auto mpLevelHandler = runtime_cast<MpLevelHandler>(_currentHandler)) {
+			if (_benchmark->EndTick(mpLevelHandler.get())) {
+				_networkManager->Dispose();
+				_networkManager = nullptr;
+				_benchmark = nullptr;
+				theApplication().Quit();
+			}
+		}
+	}
+#endif
+
 	if (_backInvokedTimeLeft > 0) {
 		_backInvokedTimeLeft--;
 		if (_backInvokedTimeLeft <= 0) {
@@ -629,6 +697,9 @@ void GameEventHandler::OnShutdown()
 		_networkManager = nullptr;
 		_streamedAsset = nullptr;
 	}
+#	if defined(DEDICATED_SERVER_BENCHMARK)
+	_benchmark = nullptr;
+#	endif
 #endif
 
 	if ((_flags & Flags::IsInitialized) == Flags::IsInitialized) {
@@ -1034,6 +1105,36 @@ bool GameEventHandler::OnLoadState(std::shared_ptr<Stream> src)
 	ResumeStateFromStream(std::move(src));
 	return true;
 }
+
+bool GameEventHandler::OnSaveFrameState(Stream& dest)
+{
+	auto* levelHandler = runtime_cast<LevelHandler>(_currentHandler.get());
+	if (levelHandler == nullptr || !levelHandler->IsLocalSession()) {
+		return false;
+	}
+#if defined(WITH_MULTIPLAYER)
+	// Multiplayer handler keeps additional state that is not part of the snapshot
+	if (runtime_cast<MpLevelHandler>(levelHandler) != nullptr) {
+		return false;
+	}
+#endif
+	return levelHandler->SaveFrameState(dest);
+}
+
+bool GameEventHandler::OnLoadFrameState(Stream& src)
+{
+	// The state is bound to the level handler instance that saved it, it's validated by the handler itself
+	auto* levelHandler = runtime_cast<LevelHandler>(_currentHandler.get());
+	if (levelHandler == nullptr) {
+		return false;
+	}
+#if defined(WITH_MULTIPLAYER)
+	if (runtime_cast<MpLevelHandler>(levelHandler) != nullptr) {
+		return false;
+	}
+#endif
+	return levelHandler->LoadFrameState(src);
+}
 #endif
 
 bool GameEventHandler::SaveCurrentStateIfAny()
@@ -1128,6 +1229,70 @@ void GameEventHandler::RunDedicatedServer(StringView configPath)
 	StartProcessingStdin();
 }
 
+#	if defined(DEDICATED_SERVER_BENCHMARK)
+void GameEventHandler::RunServerBenchmark(const AppConfiguration& config)
+{
+	// Usage: jazz2_server_benchmark [peers] [seconds] [level]
+	std::int32_t peerCount = ServerBenchmark::DefaultPeerCount;
+	if (config.argc() > 0) {
+		auto arg = config.argv(0);
+		peerCount = std::clamp((std::int32_t)stou32(arg.data(), arg.size()), 1, (std::int32_t)NetworkManagerBase::MaxPeerCount);
+	}
+	std::int32_t durationSecs = ServerBenchmark::DefaultDurationSecs;
+	if (config.argc() > 1) {
+		auto arg = config.argv(1);
+		durationSecs = std::max((std::int32_t)stou32(arg.data(), arg.size()), 1);
+	}
+
+	// Players are simulated with their real animations, so the converted game data are required even for the synthetic arena
+	WaitForVerify();
+	if ((_flags & Flags::IsPlayable) != Flags::IsPlayable) {
+		LOGE("Server benchmark requires Jazz Jackrabbit 2 files to be converted first");
+		theApplication().Quit();
+		return;
+	}
+
+	String levelName;
+	if (config.argc() > 2) {
+		levelName = config.argv(2);
+		StringUtils::lowercaseInPlace(levelName);
+		if (!levelName.contains('/')) {
+			levelName = "unknown/"_s + levelName;
+		}
+	} else {
+		// Without a level, a synthetic arena is used, so no level files from the game are needed. It's written
+		// to the cache, which is already verified at this point, so it's not overwritten by the refresh.
+		levelName = ServerBenchmark::CreateSyntheticLevel();
+		if (levelName.empty()) {
+			theApplication().Quit();
+			return;
+		}
+	}
+
+	LOGI("Running server benchmark on \"{}\" with {} peers for {} seconds...", levelName, peerCount, durationSecs);
+
+	ServerInitialization serverInit;
+	serverInit.Configuration = NetworkManager::CreateDefaultServerConfiguration();
+	serverInit.Configuration.ServerName = "Benchmark"_s;
+	serverInit.Configuration.IsPrivate = true;
+	serverInit.Configuration.MaxPlayerCount = (std::uint32_t)peerCount;
+	serverInit.Configuration.IdleKickTimeSecs = 0;
+	serverInit.Configuration.GameMode = MpGameMode::Cooperation;
+	serverInit.Configuration.Playlist.clear();
+	serverInit.InitialLevel.LevelName = levelName;
+	serverInit.InitialLevel.IsLocalSession = false;
+
+	_benchmark = std::make_unique<ServerBenchmark>(peerCount, durationSecs, 0xDEA00000 | (MultiplayerProtocolVersion & 0x000FFFFF));
+
+	WaitForVerify();
+	if (!CreateServer(std::move(serverInit))) {
+		LOGE("Benchmark cannot be started because of invalid configuration");
+		_benchmark = nullptr;
+		theApplication().Quit();
+	}
+}
+#	endif
+
 void GameEventHandler::StartProcessingStdin()
 {
 	Thread thread([](void* arg) {
@@ -1236,6 +1401,13 @@ bool GameEventHandler::CreateServer(ServerInitialization&& serverInit)
 
 	serverInit.InitialLevel.IsReforged = serverInit.Configuration.ReforgedGameplay;
 
+#		if defined(DEDICATED_SERVER_BENCHMARK)
+	if (_benchmark != nullptr) {
+		if (!_networkManager->CreateLoopbackServer(this, _benchmark.get(), std::move(serverInit.Configuration))) {
+			return false;
+		}
+	} else
+#		endif
 	if (!_networkManager->CreateServer(this, std::move(serverInit.Configuration))) {
 		return false;
 	}
@@ -1819,6 +1991,35 @@ void GameEventHandler::SetStateHandler(std::shared_ptr<IStateHandler>&& handler)
 #endif
 }
 
+#if defined(DEATH_TARGET_APPLE) || defined(DEATH_TARGET_UNIX) || (defined(DEATH_TARGET_WINDOWS) && !defined(DEATH_TARGET_WINDOWS_RT))
+void GameEventHandler::RunReplay(StringView path)
+{
+	// Usage: /replay <file>
+	auto replayPlayer = std::make_unique<ReplayPlayer>(fs::Open(path, FileAccess::Read));
+	if (!replayPlayer->IsValid()) {
+		LOGE("Replay \"{}\" cannot be played back", path);
+		theApplication().Quit();
+		return;
+	}
+
+	LOGI("Playing back replay of \"{}\"...", replayPlayer->GetLevelInitialization().LevelName);
+
+	WaitForVerify();
+	InvokeAsync([this, replayPlayer = std::move(replayPlayer)]() mutable {
+		LevelInitialization levelInit = replayPlayer->GetLevelInitialization();
+
+		auto levelHandler = std::make_shared<LevelHandler>(this);
+		levelHandler->SetReplayPlayer(std::move(replayPlayer));
+		if (!levelHandler->Initialize(levelInit)) {
+			LOGE("Replay cannot be played back because level \"{}\" cannot be loaded", levelInit.LevelName);
+			theApplication().Quit();
+			return;
+		}
+		SetStateHandler(std::move(levelHandler));
+	});
+}
+#endif
+
 void GameEventHandler::WaitForVerify()
 {
 	if ((_flags & Flags::IsVerified) != Flags::IsVerified) {
@@ -1852,6 +2053,9 @@ void GameEventHandler::RefreshCache()
 	constexpr std::uint64_t currentVersion = parseVersion(NCINE_VERSION_s);
 
 	auto cachePath = fs::CombinePath(resolver.GetCachePath(), "Source.idx"_s);
+	// Everything is converted from scratch only if the cache is missing or was created by an incompatible version,
+	// otherwise the manifest decides what has to be converted again (see Compatibility::AssetManifest)
+	bool recreateAll = true;
 
 	// Check cache state
 	{
@@ -1881,14 +2085,20 @@ void GameEventHandler::RefreshCache()
 		}
 		std::int64_t animsCached = s->ReadValueAsLE<std::int64_t>();
 		std::int64_t animsModified = fs::GetLastModificationTime(animsPath).ToUnixMilliseconds();
+		bool updateDescriptor = false;
 		if (animsModified != 0 && animsCached != animsModified) {
-			goto RecreateCache;
+			// The modification time alone doesn't mean that the content has changed (e.g., files were copied again)
+			if (!Compatibility::AssetConverter::IsSourceAssetsUpToDate(animsPath, resolver.GetSourcePath(), resolver.GetCachePath())) {
+				recreateAll = false;
+				goto RecreateCache;
+			}
+			updateDescriptor = true;
 		}
 
-		// If some events were added, recreate cache
+		// If some events were added, levels are converted again because the converter version changed
 		std::uint16_t eventTypeCount = s->ReadValueAsLE<std::uint16_t>();
 		if (eventTypeCount != (std::uint16_t)EventType::Count) {
-			goto RecreateCache;
+			updateDescriptor = true;
 		}
 
 		// Cache is up-to-date
@@ -1913,6 +2123,9 @@ void GameEventHandler::RefreshCache()
 				LOGI("Pruning binary shader cache (removed {} directories)...", filesRemoved);
 			}
 		} else {
+			if (updateDescriptor) {
+				WriteCacheDescriptor(cachePath, currentVersion, animsModified);
+			}
 			LOGI("Cache is already up-to-date");
 		}
 
@@ -1967,9 +2180,13 @@ RecreateCache:
 		}
 	}
 
-	RefreshCacheLevels(true);
+	RefreshCacheLevels(recreateAll);
 
-	LOGI("Cache was recreated");
+	if (recreateAll) {
+		LOGI("Cache was recreated");
+	} else {
+		LOGI("Cache was updated");
+	}
 	std::int64_t animsModified = fs::GetLastModificationTime(animsPath).ToUnixMilliseconds();
 	WriteCacheDescriptor(cachePath, currentVersion, animsModified);
 
@@ -22,7 +22,7 @@
 	still play together.
 */
 #if !defined(NCINE_PROTOCOL_VERSION)
-#	define NCINE_PROTOCOL_VERSION "3.7.1"
+#	define NCINE_PROTOCOL_VERSION "3.9.0"
 #endif
 /** @brief Application build year */
 #if !defined(NCINE_BUILD_YEAR)
@@ -9,6 +9,12 @@
 #include <cstdint>
 #include <cstring>
 
+#if defined(SW_WIDE8)
+#	define SW_GENERATED_FRAGMENT8(name) &name
+#else
+#	define SW_GENERATED_FRAGMENT8(name) nullptr
+#endif
+
 namespace nCine::RHI::Software
 {
 	namespace
@@ -81,6 +87,128 @@ void BatchedShieldFire_Fragment(const nCine::RHI::Software::FragmentShaderInput&
 	packColor(COLOR, in.rgba);
 }
 
+static nCine::RHI::Software::sw::wide4::vfloat BatchedShieldFire_aastep4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vfloat threshold, nCine::RHI::Software::sw::wide4::vfloat value)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const BatchedShieldFire_Uniforms* unis = static_cast<const BatchedShieldFire_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vfloat afwidth = length(vvec2(dFdx(value), dFdy(value))) * 0.70710678118654757f;
+	return smoothstep(threshold - afwidth, threshold + afwidth, value);
+}
+
+static nCine::RHI::Software::sw::wide4::vfloat BatchedShieldFire_triangleWave4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vfloat x, nCine::RHI::Software::sw::wide4::vfloat period)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const BatchedShieldFire_Uniforms* unis = static_cast<const BatchedShieldFire_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vfloat p = x / period;
+	vfloat f = fract(p);
+	return abs(f - 0.5f) * 2.0f;
+}
+
+void BatchedShieldFire_Fragment4(const nCine::RHI::Software::FragmentShaderInput4& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const BatchedShieldFire_Uniforms* unis = static_cast<const BatchedShieldFire_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	vec2 scale = vec4(in.color[0], in.color[1], in.color[2], in.color[3]).xy();
+	vec2 shift1 = unis->vShieldRect.xy();
+	vec2 shift2 = unis->vShieldRect.zw();
+	vvec2 vPos = swTexCoords(in).xy() * vec2(2.0f) - vec2(1.0f);
+	float darkness = vec4(in.color[0], in.color[1], in.color[2], in.color[3]).z;
+	float alpha = vec4(in.color[0], in.color[1], in.color[2], in.color[3]).w;
+	vfloat dist = length(vPos);
+	const vmask _cond0 = vmask(dist > 1.0f);
+	const vmask _mask0 = _cond0;
+	if (any(_mask0)) {
+		COLOR = select(_mask0, vec4(0.0f, 0.0f, 0.0f, 0.0f), COLOR);
+	}
+	const vmask _else0 = !_cond0;
+	if (any(_else0)) {
+		vvec3 v = vvec3(vPos.x, vPos.y, sqrt(1.0f - vPos.x * vPos.x - vPos.y * vPos.y));
+		vvec3 n = normalize(v);
+		vfloat b = dot(n, vec3(0.0f, 0.0f, 1.0f));
+		vvec2 q = vvec2(0.5f - 0.5f * atan(n.z, n.x) / 3.1415926f, -acos(vPos.y) / 3.1415926f);
+		vfloat isNearBorder = 1.0f - BatchedShieldFire_aastep4(in, 0.96f, dist);
+		vfloat mask1 = swTexture(in, 0, mod(shift1 + q * scale, 1.0f)).x;
+		vfloat maskNormalized1 = max(1.0f - abs(BatchedShieldFire_triangleWave4(in, shift2.y + 0.5f, 2.0f) - mask1) * 6.0f, 0.0f);
+		vfloat mask2 = swTexture(in, 0, mod(shift2 + q * scale, 1.0f)).x;
+		vfloat maskNormalized2 = max(1.0f - abs(BatchedShieldFire_triangleWave4(in, shift1.x, 1.333f) - mask2) * 6.0f, 0.0f);
+		vfloat maskSum = min(maskNormalized1 + maskNormalized2, 1.0f);
+		COLOR = select(_else0, vvec4(mix(vec3(1.0f, 0.3f, 0.0f), vec3(1.0f, 1.0f, 1.0f), max(maskSum * 2.0f - 1.0f, 0.0f)) * darkness, min(maskSum * b * isNearBorder * 1.3f + 0.1f, 1.0f) * alpha), COLOR);
+	}
+	packColor(COLOR, in.rgba);
+}
+
+#if defined(SW_WIDE8)
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vfloat BatchedShieldFire_aastep8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vfloat threshold, nCine::RHI::Software::sw::wide8::vfloat value)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const BatchedShieldFire_Uniforms* unis = static_cast<const BatchedShieldFire_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vfloat afwidth = length(vvec2(dFdx(value), dFdy(value))) * 0.70710678118654757f;
+	return smoothstep(threshold - afwidth, threshold + afwidth, value);
+}
+
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vfloat BatchedShieldFire_triangleWave8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vfloat x, nCine::RHI::Software::sw::wide8::vfloat period)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const BatchedShieldFire_Uniforms* unis = static_cast<const BatchedShieldFire_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vfloat p = x / period;
+	vfloat f = fract(p);
+	return abs(f - 0.5f) * 2.0f;
+}
+
+DEATH_ENABLE_AVX2 void BatchedShieldFire_Fragment8(const nCine::RHI::Software::FragmentShaderInput8& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const BatchedShieldFire_Uniforms* unis = static_cast<const BatchedShieldFire_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	vec2 scale = vec4(in.color[0], in.color[1], in.color[2], in.color[3]).xy();
+	vec2 shift1 = unis->vShieldRect.xy();
+	vec2 shift2 = unis->vShieldRect.zw();
+	vvec2 vPos = swTexCoords(in).xy() * vec2(2.0f) - vec2(1.0f);
+	float darkness = vec4(in.color[0], in.color[1], in.color[2], in.color[3]).z;
+	float alpha = vec4(in.color[0], in.color[1], in.color[2], in.color[3]).w;
+	vfloat dist = length(vPos);
+	const vmask _cond0 = vmask(dist > 1.0f);
+	const vmask _mask0 = _cond0;
+	if (any(_mask0)) {
+		COLOR = select(_mask0, vec4(0.0f, 0.0f, 0.0f, 0.0f), COLOR);
+	}
+	const vmask _else0 = !_cond0;
+	if (any(_else0)) {
+		vvec3 v = vvec3(vPos.x, vPos.y, sqrt(1.0f - vPos.x * vPos.x - vPos.y * vPos.y));
+		vvec3 n = normalize(v);
+		vfloat b = dot(n, vec3(0.0f, 0.0f, 1.0f));
+		vvec2 q = vvec2(0.5f - 0.5f * atan(n.z, n.x) / 3.1415926f, -acos(vPos.y) / 3.1415926f);
+		vfloat isNearBorder = 1.0f - BatchedShieldFire_aastep8(in, 0.96f, dist);
+		vfloat mask1 = swTexture(in, 0, mod(shift1 + q * scale, 1.0f)).x;
+		vfloat maskNormalized1 = max(1.0f - abs(BatchedShieldFire_triangleWave8(in, shift2.y + 0.5f, 2.0f) - mask1) * 6.0f, 0.0f);
+		vfloat mask2 = swTexture(in, 0, mod(shift2 + q * scale, 1.0f)).x;
+		vfloat maskNormalized2 = max(1.0f - abs(BatchedShieldFire_triangleWave8(in, shift1.x, 1.333f) - mask2) * 6.0f, 0.0f);
+		vfloat maskSum = min(maskNormalized1 + maskNormalized2, 1.0f);
+		COLOR = select(_else0, vvec4(mix(vec3(1.0f, 0.3f, 0.0f), vec3(1.0f, 1.0f, 1.0f), max(maskSum * 2.0f - 1.0f, 0.0f)) * darkness, min(maskSum * b * isNearBorder * 1.3f + 0.1f, 1.0f) * alpha), COLOR);
+	}
+	packColor(COLOR, in.rgba);
+}
+#endif
+
 		// --- BatchedShieldLightning ---
 struct BatchedShieldLightning_Uniforms
 {
@@ -148,6 +276,126 @@ void BatchedShieldLightning_Fragment(const nCine::RHI::Software::FragmentShaderI
 	packColor(COLOR, in.rgba);
 }
 
+static nCine::RHI::Software::sw::wide4::vfloat BatchedShieldLightning_aastep4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vfloat threshold, nCine::RHI::Software::sw::wide4::vfloat value)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const BatchedShieldLightning_Uniforms* unis = static_cast<const BatchedShieldLightning_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vfloat afwidth = length(vvec2(dFdx(value), dFdy(value))) * 0.70710678118654757f;
+	return smoothstep(threshold - afwidth, threshold + afwidth, value);
+}
+
+static nCine::RHI::Software::sw::wide4::vfloat BatchedShieldLightning_triangleWave4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vfloat x, nCine::RHI::Software::sw::wide4::vfloat period)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const BatchedShieldLightning_Uniforms* unis = static_cast<const BatchedShieldLightning_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vfloat p = x / period;
+	vfloat f = fract(p);
+	return abs(f - 0.5f) * 2.0f;
+}
+
+void BatchedShieldLightning_Fragment4(const nCine::RHI::Software::FragmentShaderInput4& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const BatchedShieldLightning_Uniforms* unis = static_cast<const BatchedShieldLightning_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	vec2 scale = vec4(in.color[0], in.color[1], in.color[2], in.color[3]).xy();
+	vec2 shift1 = unis->vShieldRect.xy();
+	vec2 shift2 = unis->vShieldRect.zw();
+	vvec2 vPos = swTexCoords(in).xy() * vec2(2.0f) - vec2(1.0f);
+	float darkness = vec4(in.color[0], in.color[1], in.color[2], in.color[3]).z;
+	float alpha = vec4(in.color[0], in.color[1], in.color[2], in.color[3]).w;
+	vfloat dist = length(vPos);
+	const vmask _cond0 = vmask(dist > 1.0f);
+	const vmask _mask0 = _cond0;
+	if (any(_mask0)) {
+		COLOR = select(_mask0, vec4(0.0f, 0.0f, 0.0f, 0.0f), COLOR);
+	}
+	const vmask _else0 = !_cond0;
+	if (any(_else0)) {
+		vvec3 v = vvec3(vPos.x, vPos.y, sqrt(1.0f - vPos.x * vPos.x - vPos.y * vPos.y));
+		vvec3 n = normalize(v);
+		vfloat b = dot(n, vec3(0.0f, 0.0f, 1.0f));
+		vvec2 q = vvec2(0.5f - 0.5f * atan(n.z, n.x) / 3.1415926f, -acos(vPos.y) / 3.1415926f);
+		vfloat isNearBorder = 1.0f - BatchedShieldLightning_aastep4(in, 0.96f, dist);
+		vfloat mask = swTexture(in, 0, mod(shift1 + q * scale, 1.0f)).x;
+		vfloat maskNormalized = max(1.0f - abs(BatchedShieldLightning_triangleWave4(in, shift2.y + 0.5f, 2.0f) - mask) * 8.0f, 0.0f);
+		vfloat isVeryNearBorder = 1.0f - BatchedShieldLightning_aastep4(in, 0.024f, abs(dist - 0.94f));
+		vfloat maskSum = max(maskNormalized, isVeryNearBorder);
+		COLOR = select(_else0, vvec4(mix(vec3(0.1f, 1.0f, 0.0f), vec3(1.0f, 1.0f, 1.0f), max(maskSum * 2.0f - 1.0f, 0.0f)) * darkness, min(maskSum * b * isNearBorder * 1.3f + 0.1f, 1.0f) * alpha), COLOR);
+	}
+	packColor(COLOR, in.rgba);
+}
+
+#if defined(SW_WIDE8)
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vfloat BatchedShieldLightning_aastep8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vfloat threshold, nCine::RHI::Software::sw::wide8::vfloat value)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const BatchedShieldLightning_Uniforms* unis = static_cast<const BatchedShieldLightning_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vfloat afwidth = length(vvec2(dFdx(value), dFdy(value))) * 0.70710678118654757f;
+	return smoothstep(threshold - afwidth, threshold + afwidth, value);
+}
+
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vfloat BatchedShieldLightning_triangleWave8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vfloat x, nCine::RHI::Software::sw::wide8::vfloat period)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const BatchedShieldLightning_Uniforms* unis = static_cast<const BatchedShieldLightning_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vfloat p = x / period;
+	vfloat f = fract(p);
+	return abs(f - 0.5f) * 2.0f;
+}
+
+DEATH_ENABLE_AVX2 void BatchedShieldLightning_Fragment8(const nCine::RHI::Software::FragmentShaderInput8& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const BatchedShieldLightning_Uniforms* unis = static_cast<const BatchedShieldLightning_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	vec2 scale = vec4(in.color[0], in.color[1], in.color[2], in.color[3]).xy();
+	vec2 shift1 = unis->vShieldRect.xy();
+	vec2 shift2 = unis->vShieldRect.zw();
+	vvec2 vPos = swTexCoords(in).xy() * vec2(2.0f) - vec2(1.0f);
+	float darkness = vec4(in.color[0], in.color[1], in.color[2], in.color[3]).z;
+	float alpha = vec4(in.color[0], in.color[1], in.color[2], in.color[3]).w;
+	vfloat dist = length(vPos);
+	const vmask _cond0 = vmask(dist > 1.0f);
+	const vmask _mask0 = _cond0;
+	if (any(_mask0)) {
+		COLOR = select(_mask0, vec4(0.0f, 0.0f, 0.0f, 0.0f), COLOR);
+	}
+	const vmask _else0 = !_cond0;
+	if (any(_else0)) {
+		vvec3 v = vvec3(vPos.x, vPos.y, sqrt(1.0f - vPos.x * vPos.x - vPos.y * vPos.y));
+		vvec3 n = normalize(v);
+		vfloat b = dot(n, vec3(0.0f, 0.0f, 1.0f));
+		vvec2 q = vvec2(0.5f - 0.5f * atan(n.z, n.x) / 3.1415926f, -acos(vPos.y) / 3.1415926f);
+		vfloat isNearBorder = 1.0f - BatchedShieldLightning_aastep8(in, 0.96f, dist);
+		vfloat mask = swTexture(in, 0, mod(shift1 + q * scale, 1.0f)).x;
+		vfloat maskNormalized = max(1.0f - abs(BatchedShieldLightning_triangleWave8(in, shift2.y + 0.5f, 2.0f) - mask) * 8.0f, 0.0f);
+		vfloat isVeryNearBorder = 1.0f - BatchedShieldLightning_aastep8(in, 0.024f, abs(dist - 0.94f));
+		vfloat maskSum = max(maskNormalized, isVeryNearBorder);
+		COLOR = select(_else0, vvec4(mix(vec3(0.1f, 1.0f, 0.0f), vec3(1.0f, 1.0f, 1.0f), max(maskSum * 2.0f - 1.0f, 0.0f)) * darkness, min(maskSum * b * isNearBorder * 1.3f + 0.1f, 1.0f) * alpha), COLOR);
+	}
+	packColor(COLOR, in.rgba);
+}
+#endif
+
 		// --- Blur ---
 struct Blur_Uniforms
 {
@@ -174,6 +422,48 @@ void Blur_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
 	packColor(COLOR, in.rgba);
 }
 
+void Blur_Fragment4(const nCine::RHI::Software::FragmentShaderInput4& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const Blur_Uniforms* unis = static_cast<const Blur_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	vvec4 color = vec4(0.0f);
+	vec2 off1 = vec2(1.3846153846f) * unis->uPixelOffset * unis->uDirection;
+	vec2 off2 = vec2(3.2307692308f) * unis->uPixelOffset * unis->uDirection;
+	color += swTexturePrimary(in, 0) * 0.2270270270f;
+	color += swTexture(in, 0, swTexCoords(in) + off1) * 0.3162162162f;
+	color += swTexture(in, 0, swTexCoords(in) - off1) * 0.3162162162f;
+	color += swTexture(in, 0, swTexCoords(in) + off2) * 0.0702702703f;
+	color += swTexture(in, 0, swTexCoords(in) - off2) * 0.0702702703f;
+	COLOR = color;
+	packColor(COLOR, in.rgba);
+}
+
+#if defined(SW_WIDE8)
+DEATH_ENABLE_AVX2 void Blur_Fragment8(const nCine::RHI::Software::FragmentShaderInput8& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const Blur_Uniforms* unis = static_cast<const Blur_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	vvec4 color = vec4(0.0f);
+	vec2 off1 = vec2(1.3846153846f) * unis->uPixelOffset * unis->uDirection;
+	vec2 off2 = vec2(3.2307692308f) * unis->uPixelOffset * unis->uDirection;
+	color += swTexturePrimary(in, 0) * 0.2270270270f;
+	color += swTexture(in, 0, swTexCoords(in) + off1) * 0.3162162162f;
+	color += swTexture(in, 0, swTexCoords(in) - off1) * 0.3162162162f;
+	color += swTexture(in, 0, swTexCoords(in) + off2) * 0.0702702703f;
+	color += swTexture(in, 0, swTexCoords(in) - off2) * 0.0702702703f;
+	COLOR = color;
+	packColor(COLOR, in.rgba);
+}
+#endif
+
 		// --- Colorized ---
 struct Colorized_Uniforms
 {
@@ -195,6 +485,42 @@ void Colorized_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
 	packColor(COLOR, in.rgba);
 }
 
+void Colorized_Fragment4(const nCine::RHI::Software::FragmentShaderInput4& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const Colorized_Uniforms* unis = static_cast<const Colorized_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vvec4 dye = vec4(1.0f) + (COLOR - vec4(0.5f)) * vec4(4.0f);
+	vvec4 original = swTexturePrimary(in, 0);
+	vfloat average = (original.x + original.y + original.z) * 0.5f;
+	vvec4 gray = vvec4(average, average, average, original.w);
+	COLOR = gray * dye;
+	packColor(COLOR, in.rgba);
+}
+
+#if defined(SW_WIDE8)
+DEATH_ENABLE_AVX2 void Colorized_Fragment8(const nCine::RHI::Software::FragmentShaderInput8& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const Colorized_Uniforms* unis = static_cast<const Colorized_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vvec4 dye = vec4(1.0f) + (COLOR - vec4(0.5f)) * vec4(4.0f);
+	vvec4 original = swTexturePrimary(in, 0);
+	vfloat average = (original.x + original.y + original.z) * 0.5f;
+	vvec4 gray = vvec4(average, average, average, original.w);
+	COLOR = gray * dye;
+	packColor(COLOR, in.rgba);
+}
+#endif
+
 		// --- BatchedColorized ---
 struct BatchedColorized_Uniforms
 {
@@ -216,6 +542,42 @@ void BatchedColorized_Fragment(const nCine::RHI::Software::FragmentShaderInput&
 	packColor(COLOR, in.rgba);
 }
 
+void BatchedColorized_Fragment4(const nCine::RHI::Software::FragmentShaderInput4& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const BatchedColorized_Uniforms* unis = static_cast<const BatchedColorized_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vvec4 dye = vec4(1.0f) + (COLOR - vec4(0.5f)) * vec4(4.0f);
+	vvec4 original = swTexturePrimary(in, 0);
+	vfloat average = (original.x + original.y + original.z) * 0.5f;
+	vvec4 gray = vvec4(average, average, average, original.w);
+	COLOR = gray * dye;
+	packColor(COLOR, in.rgba);
+}
+
+#if defined(SW_WIDE8)
+DEATH_ENABLE_AVX2 void BatchedColorized_Fragment8(const nCine::RHI::Software::FragmentShaderInput8& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const BatchedColorized_Uniforms* unis = static_cast<const BatchedColorized_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vvec4 dye = vec4(1.0f) + (COLOR - vec4(0.5f)) * vec4(4.0f);
+	vvec4 original = swTexturePrimary(in, 0);
+	vfloat average = (original.x + original.y + original.z) * 0.5f;
+	vvec4 gray = vvec4(average, average, average, original.w);
+	COLOR = gray * dye;
+	packColor(COLOR, in.rgba);
+}
+#endif
+
 		// --- Combine ---
 struct Combine_Uniforms
 {
@@ -266,15 +628,103 @@ void Combine_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
 	vec4 main = swTexturePrimary(in, 0);
 	vec4 light = swTexture(in, 1, Combine_noiseTexCoords(in, vec2(in.u, in.v)));
 	vec4 blur = (blur1 + blur2) * vec4(0.5f);
-	float gray = dot(blur.rgb(), vec3(0.299f, 0.587f, 0.114f));
+	float gray = dot(blur.xyz(), vec3(0.299f, 0.587f, 0.114f));
 	blur = vec4(gray, gray, gray, blur.a);
 	COLOR = mix(mix(main * (1.0f + light.g) + max(light.g - 0.7f, 0.0f) * vec4(1.0f), blur, vec4(clamp((1.0f - light.r) / sqrt(max(unis->uAmbientColor.w, 0.35f)), 0.0f, 1.0f))), unis->uAmbientColor, vec4(1.0f - light.r));
 	COLOR.a = 1.0f;
 	packColor(COLOR, in.rgba);
 }
 
-		// --- CombineWithWaterLow ---
-struct CombineWithWaterLow_Uniforms
+static nCine::RHI::Software::sw::wide4::vvec2 Combine_hash2D4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec2 p)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const Combine_Uniforms* unis = static_cast<const Combine_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vfloat h = dot(p, vec2(12.9898f, 78.233f));
+	vfloat h2 = dot(p, vec2(37.271f, 377.632f));
+	return -1.0f + 2.0f * vvec2(fract(sin(h) * 43758.5453f), fract(sin(h2) * 43758.5453f));
+}
+
+static nCine::RHI::Software::sw::wide4::vvec2 Combine_noiseTexCoords4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec2 position)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const Combine_Uniforms* unis = static_cast<const Combine_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec2 seed = position + fract(unis->uTime * 0.01f);
+	return clamp(position + Combine_hash2D4(in, seed) * unis->vViewSizeInv * 1.4f, vec2(0.0f), vec2(1.0f));
+}
+
+void Combine_Fragment4(const nCine::RHI::Software::FragmentShaderInput4& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const Combine_Uniforms* unis = static_cast<const Combine_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	vvec4 blur1 = swTexture(in, 2, swTexCoords(in));
+	vvec4 blur2 = swTexture(in, 3, swTexCoords(in));
+	vvec4 main = swTexturePrimary(in, 0);
+	vvec4 light = swTexture(in, 1, Combine_noiseTexCoords4(in, swTexCoords(in)));
+	vvec4 blur = (blur1 + blur2) * vec4(0.5f);
+	vfloat gray = dot(blur.xyz(), vec3(0.299f, 0.587f, 0.114f));
+	blur = vvec4(gray, gray, gray, blur.w);
+	COLOR = mix(mix(main * (1.0f + light.y) + max(light.y - 0.7f, 0.0f) * vec4(1.0f), blur, vvec4(clamp((1.0f - light.x) / sqrt(max(unis->uAmbientColor.w, 0.35f)), 0.0f, 1.0f))), unis->uAmbientColor, vvec4(1.0f - light.x));
+	COLOR.w = 1.0f;
+	packColor(COLOR, in.rgba);
+}
+
+#if defined(SW_WIDE8)
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vvec2 Combine_hash2D8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec2 p)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const Combine_Uniforms* unis = static_cast<const Combine_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vfloat h = dot(p, vec2(12.9898f, 78.233f));
+	vfloat h2 = dot(p, vec2(37.271f, 377.632f));
+	return -1.0f + 2.0f * vvec2(fract(sin(h) * 43758.5453f), fract(sin(h2) * 43758.5453f));
+}
+
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vvec2 Combine_noiseTexCoords8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec2 position)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const Combine_Uniforms* unis = static_cast<const Combine_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec2 seed = position + fract(unis->uTime * 0.01f);
+	return clamp(position + Combine_hash2D8(in, seed) * unis->vViewSizeInv * 1.4f, vec2(0.0f), vec2(1.0f));
+}
+
+DEATH_ENABLE_AVX2 void Combine_Fragment8(const nCine::RHI::Software::FragmentShaderInput8& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const Combine_Uniforms* unis = static_cast<const Combine_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	vvec4 blur1 = swTexture(in, 2, swTexCoords(in));
+	vvec4 blur2 = swTexture(in, 3, swTexCoords(in));
+	vvec4 main = swTexturePrimary(in, 0);
+	vvec4 light = swTexture(in, 1, Combine_noiseTexCoords8(in, swTexCoords(in)));
+	vvec4 blur = (blur1 + blur2) * vec4(0.5f);
+	vfloat gray = dot(blur.xyz(), vec3(0.299f, 0.587f, 0.114f));
+	blur = vvec4(gray, gray, gray, blur.w);
+	COLOR = mix(mix(main * (1.0f + light.y) + max(light.y - 0.7f, 0.0f) * vec4(1.0f), blur, vvec4(clamp((1.0f - light.x) / sqrt(max(unis->uAmbientColor.w, 0.35f)), 0.0f, 1.0f))), unis->uAmbientColor, vvec4(1.0f - light.x));
+	COLOR.w = 1.0f;
+	packColor(COLOR, in.rgba);
+}
+#endif
+
+		// --- CombineWithWater ---
+struct CombineWithWater_Uniforms
 {
 	nCine::RHI::Software::sw::vec4 uAmbientColor;
 	float uTime;
@@ -283,19 +733,19 @@ struct CombineWithWaterLow_Uniforms
 	nCine::RHI::Software::sw::vec2 vViewSizeInv;
 };
 
-void CombineWithWaterLow_ComputeVaryings(void* inputs, const std::uint8_t* instanceBlock)
+void CombineWithWater_ComputeVaryings(void* inputs, const std::uint8_t* instanceBlock)
 {
 	using namespace nCine::RHI::Software::sw;
-	CombineWithWaterLow_Uniforms* io = static_cast<CombineWithWaterLow_Uniforms*>(inputs);
+	CombineWithWater_Uniforms* io = static_cast<CombineWithWater_Uniforms*>(inputs);
 	(void)io;
 	(void)instanceBlock;
 	io->vViewSizeInv = (vec2(1.0f) / (*reinterpret_cast<const vec2*>(instanceBlock + 96)));
 }
 
-static nCine::RHI::Software::sw::vec2 CombineWithWaterLow_hash2D(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 p)
+static nCine::RHI::Software::sw::vec2 CombineWithWater_hash2D(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 p)
 {
 	using namespace nCine::RHI::Software::sw;
-	const CombineWithWaterLow_Uniforms* unis = static_cast<const CombineWithWaterLow_Uniforms*>(in.userData);
+	const CombineWithWater_Uniforms* unis = static_cast<const CombineWithWater_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
 	float h = dot(p, vec2(12.9898f, 78.233f));
@@ -303,41 +753,138 @@ static nCine::RHI::Software::sw::vec2 CombineWithWaterLow_hash2D(const nCine::RH
 	return -1.0f + 2.0f * vec2(fract(sin(h) * 43758.5453f), fract(sin(h2) * 43758.5453f));
 }
 
-static nCine::RHI::Software::sw::vec2 CombineWithWaterLow_noiseTexCoords(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 position)
+static nCine::RHI::Software::sw::vec2 CombineWithWater_noiseTexCoords(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 position)
 {
 	using namespace nCine::RHI::Software::sw;
-	const CombineWithWaterLow_Uniforms* unis = static_cast<const CombineWithWaterLow_Uniforms*>(in.userData);
+	const CombineWithWater_Uniforms* unis = static_cast<const CombineWithWater_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
 	vec2 seed = position + fract(unis->uTime * 0.01f);
-	return clamp(position + CombineWithWaterLow_hash2D(in, seed) * unis->vViewSizeInv * 1.4f, vec2(0.0f), vec2(1.0f));
+	return clamp(position + CombineWithWater_hash2D(in, seed) * unis->vViewSizeInv * 1.4f, vec2(0.0f), vec2(1.0f));
 }
 
-void CombineWithWaterLow_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
+static float CombineWithWater_wave(const nCine::RHI::Software::FragmentShaderInput& in, float x, float time)
 {
 	using namespace nCine::RHI::Software::sw;
-	const CombineWithWaterLow_Uniforms* unis = static_cast<const CombineWithWaterLow_Uniforms*>(in.userData);
+	const CombineWithWater_Uniforms* unis = static_cast<const CombineWithWater_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	vec4 COLOR;
-	vec3 waterColor = vec3(0.4f, 0.6f, 0.8f);
-	vec2 uvLocal = vec2(in.u, in.v);
-	vec2 uvWorldCenter = unis->uCameraPos.xy() * unis->vViewSizeInv.xy();
-	vec2 uvWorld = uvLocal + uvWorldCenter;
-	float isTexelBelow = 1.0f - step(uvLocal.y, unis->uWaterLevel);
+	float waveOffset = cos((x - time) * 60.0f) * 0.004f + cos((x - 2.0f * time) * 20.0f) * 0.008f + sin((x + 2.0f * time) * 35.0f) * 0.01f + cos((x + 4.0f * time) * 70.0f) * 0.001f;
+	return waveOffset * 0.4f;
+}
+
+static float CombineWithWater_aastep(const nCine::RHI::Software::FragmentShaderInput& in, float threshold, float value)
+{
+	using namespace nCine::RHI::Software::sw;
+	const CombineWithWater_Uniforms* unis = static_cast<const CombineWithWater_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	float afwidth = length(vec2(dFdx(value), dFdy(value))) * 0.70710678118654757f;
+	return smoothstep(threshold - afwidth, threshold + afwidth, value);
+}
+
+static nCine::RHI::Software::sw::vec3 CombineWithWater_permute(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec3 x)
+{
+	using namespace nCine::RHI::Software::sw;
+	const CombineWithWater_Uniforms* unis = static_cast<const CombineWithWater_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	return mod((x * 34.0f + 1.0f) * x, 289.0f);
+}
+
+static float CombineWithWater_snoise(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 v)
+{
+	using namespace nCine::RHI::Software::sw;
+	const CombineWithWater_Uniforms* unis = static_cast<const CombineWithWater_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vec4 C = vec4(0.211324865405187f, 0.366025403784439f, -0.577350269189626f, 0.024390243902439f);
+	vec2 i = floor(v + dot(v, C.yy()));
+	vec2 x0 = v - i + dot(i, C.xx());
+	vec2 i1 = x0.x > x0.y ? vec2(1.0f, 0.0f) : vec2(0.0f, 1.0f);
+	vec4 x12 = x0.xyxy() + C.xxzz();
+	{
+		const vec2 _w = vec2(i1);
+		x12.x -= _w.x;
+		x12.y -= _w.y;
+	}
+	i = mod(i, 289.0f);
+	vec3 p = CombineWithWater_permute(in, CombineWithWater_permute(in, i.y + vec3(0.0f, i1.y, 1.0f)) + i.x + vec3(0.0f, i1.x, 1.0f));
+	vec3 m = max(0.5f - vec3(dot(x0, x0), dot(x12.xy(), x12.xy()), dot(x12.zw(), x12.zw())), 0.0f);
+	m = m * m;
+	m = m * m;
+	vec3 x = 2.0f * fract(p * C.www()) - 1.0f;
+	vec3 h = abs(x) - 0.5f;
+	vec3 ox = floor(x + 0.5f);
+	vec3 a0 = x - ox;
+	m *= 1.79284291400159f - 0.85373472095314f * (a0 * a0 + h * h);
+	vec3 g;
+	g.x = a0.x * x0.x + h.x * x0.y;
+	{
+		const vec2 _w = vec2(a0.yz() * x12.xz() + h.yz() * x12.yw());
+		g.y = _w.x;
+		g.z = _w.y;
+	}
+	return 130.0f * dot(m, g);
+}
+
+void CombineWithWater_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	const CombineWithWater_Uniforms* unis = static_cast<const CombineWithWater_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vec4 COLOR;
+	vec3 waterColor = vec3(0.4f, 0.6f, 0.8f);
+	vec2 uvLocal = vec2(in.u, in.v);
+	vec2 uvWorldCenter = unis->uCameraPos.xy() * unis->vViewSizeInv.xy();
+	vec2 uvWorld = uvLocal + uvWorldCenter;
+	float waveHeight = CombineWithWater_wave(in, uvWorld.x, unis->uTime);
+	float isTexelBelow = CombineWithWater_aastep(in, waveHeight, uvLocal.y - unis->uWaterLevel);
 	float isTexelAbove = 1.0f - isTexelBelow;
-	vec2 uv = clamp(uvLocal + vec2(0.008f * sin(unis->uTime * 16.0f + uvWorld.y * 20.0f) * isTexelBelow, 0.0f), vec2(0.0f), vec2(1.0f));
+	vec2 disPos = uvWorld * vec2(0.1f) + vec2(mod(unis->uTime * 0.4f, 2.0f));
+	vec2 dis = (swTexture(in, 4, disPos).xy() - vec2(0.5f)) * vec2(0.01f);
+	vec2 uv = clamp(uvLocal + (vec2(0.004f * sin(unis->uTime * 16.0f + uvWorld.y * 20.0f), 0.0f) + dis) * vec2(isTexelBelow), vec2(0.0f), vec2(1.0f));
 	vec4 main = swTexture(in, 0, uv);
-	float topDist = abs(uvLocal.y - unis->uWaterLevel);
-	float topGradient = max(1.0f - topDist, 0.0f);
-	float isNearTop = 0.2f * topGradient * topGradient;
-	float isVeryNearTop = 1.0f - step(unis->vViewSizeInv.y, topDist);
-	main.rgb() = mix(main.rgb(), waterColor, vec3(isTexelBelow * 0.4f)) + vec3((isNearTop + 0.2f * isVeryNearTop) * isTexelBelow);
+	float aberration = abs(uvLocal.x - 0.5f) * 0.012f;
+	float red = swTexture(in, 0, vec2(uv.x - aberration, uv.y)).r;
+	float blue = swTexture(in, 0, vec2(uv.x + aberration, uv.y)).b;
+	{
+		const vec3 _w = vec3(mix(main.xyz(), waterColor * (0.4f + 1.2f * vec3(red, main.g, blue)), vec3(isTexelBelow * 0.5f)));
+		main.r = _w.x;
+		main.g = _w.y;
+		main.b = _w.z;
+	}
+	vec2 uvNormalized = mod(uvLocal / unis->vViewSizeInv, 720.0f) / 720.0f;
+	float noisePos = uvWorldCenter.x * 6.0f + uvLocal.x * 1.4f + uvWorldCenter.y * 0.5f + (1.0f - uvNormalized.x * 1.2f - uvNormalized.y) * -5.0f;
+	float rays = CombineWithWater_snoise(in, vec2(noisePos, unis->uTime * 5.0f + uvWorldCenter.y)) * 0.55f + 0.3f;
+	{
+		const vec3 _w = vec3(vec3(rays * isTexelBelow * max(1.0f - uvLocal.y * 1.4f, 0.0f) * 0.6f));
+		main.r += _w.x;
+		main.g += _w.y;
+		main.b += _w.z;
+	}
+	float topDist = abs(uvLocal.y - unis->uWaterLevel - waveHeight);
+	float isNearTop = 1.0f - CombineWithWater_aastep(in, unis->vViewSizeInv.y * 2.8f, topDist);
+	float isVeryNearTop = 1.0f - CombineWithWater_aastep(in, unis->vViewSizeInv.y * (0.8f - 100.0f * waveHeight), topDist);
+	float topColorBlendFac = isNearTop * isTexelBelow * 0.6f;
+	{
+		const vec3 _w = vec3(mix(main.xyz(), swTexture(in, 0, vec2(uvLocal.x, (unis->uWaterLevel - uvLocal.y + unis->uWaterLevel) * 0.97f - waveHeight + unis->vViewSizeInv.y)).xyz(), vec3(topColorBlendFac)));
+		main.r = _w.x;
+		main.g = _w.y;
+		main.b = _w.z;
+	}
+	{
+		const vec3 _w = vec3(vec3(0.2f * isVeryNearTop));
+		main.r += _w.x;
+		main.g += _w.y;
+		main.b += _w.z;
+	}
 	vec4 blur1 = swTexture(in, 2, uv);
 	vec4 blur2 = swTexture(in, 3, uv);
-	vec4 light = swTexture(in, 1, CombineWithWaterLow_noiseTexCoords(in, uv));
+	vec4 light = swTexture(in, 1, CombineWithWater_noiseTexCoords(in, uv));
 	vec4 blur = (blur1 + blur2) * vec4(0.5f);
-	float gray = dot(blur.rgb(), vec3(0.299f, 0.587f, 0.114f));
+	float gray = dot(blur.xyz(), vec3(0.299f, 0.587f, 0.114f));
 	blur = vec4(gray, gray, gray, blur.a);
 	float darknessStrength = 1.0f - light.r;
 	if (unis->uWaterLevel < 0.4f) {
@@ -349,1558 +896,5515 @@ void CombineWithWaterLow_Fragment(const nCine::RHI::Software::FragmentShaderInpu
 	packColor(COLOR, in.rgba);
 }
 
-		// --- DefaultBatchedMeshSprites ---
-struct DefaultBatchedMeshSprites_Uniforms
-{
-};
-
-void DefaultBatchedMeshSprites_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
+static nCine::RHI::Software::sw::wide4::vvec2 CombineWithWater_hash2D4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec2 p)
 {
 	using namespace nCine::RHI::Software::sw;
-	const DefaultBatchedMeshSprites_Uniforms* unis = static_cast<const DefaultBatchedMeshSprites_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide4;
+	const CombineWithWater_Uniforms* unis = static_cast<const CombineWithWater_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	vec4 COLOR;
-	COLOR = swTexturePrimary(in, 0) * vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
-	packColor(COLOR, in.rgba);
+	vfloat h = dot(p, vec2(12.9898f, 78.233f));
+	vfloat h2 = dot(p, vec2(37.271f, 377.632f));
+	return -1.0f + 2.0f * vvec2(fract(sin(h) * 43758.5453f), fract(sin(h2) * 43758.5453f));
 }
 
-		// --- DefaultBatchedMeshSpritesNoTexture ---
-struct DefaultBatchedMeshSpritesNoTexture_Uniforms
-{
-};
-
-void DefaultBatchedMeshSpritesNoTexture_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
+static nCine::RHI::Software::sw::wide4::vvec2 CombineWithWater_noiseTexCoords4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec2 position)
 {
 	using namespace nCine::RHI::Software::sw;
-	const DefaultBatchedMeshSpritesNoTexture_Uniforms* unis = static_cast<const DefaultBatchedMeshSpritesNoTexture_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide4;
+	const CombineWithWater_Uniforms* unis = static_cast<const CombineWithWater_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	vec4 COLOR;
-	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
-	packColor(COLOR, in.rgba);
+	vvec2 seed = position + fract(unis->uTime * 0.01f);
+	return clamp(position + CombineWithWater_hash2D4(in, seed) * unis->vViewSizeInv * 1.4f, vec2(0.0f), vec2(1.0f));
 }
 
-		// --- DefaultBatchedSpritesNoTexture ---
-struct DefaultBatchedSpritesNoTexture_Uniforms
-{
-};
-
-void DefaultBatchedSpritesNoTexture_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
+static nCine::RHI::Software::sw::wide4::vfloat CombineWithWater_wave4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vfloat x, nCine::RHI::Software::sw::wide4::vfloat time)
 {
 	using namespace nCine::RHI::Software::sw;
-	const DefaultBatchedSpritesNoTexture_Uniforms* unis = static_cast<const DefaultBatchedSpritesNoTexture_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide4;
+	const CombineWithWater_Uniforms* unis = static_cast<const CombineWithWater_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	vec4 COLOR;
-	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
-	packColor(COLOR, in.rgba);
+	vfloat waveOffset = cos((x - time) * 60.0f) * 0.004f + cos((x - 2.0f * time) * 20.0f) * 0.008f + sin((x + 2.0f * time) * 35.0f) * 0.01f + cos((x + 4.0f * time) * 70.0f) * 0.001f;
+	return waveOffset * 0.4f;
 }
 
-		// --- DefaultImGui ---
-struct DefaultImGui_Uniforms
-{
-};
-
-void DefaultImGui_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
+static nCine::RHI::Software::sw::wide4::vfloat CombineWithWater_aastep4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vfloat threshold, nCine::RHI::Software::sw::wide4::vfloat value)
 {
 	using namespace nCine::RHI::Software::sw;
-	const DefaultImGui_Uniforms* unis = static_cast<const DefaultImGui_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide4;
+	const CombineWithWater_Uniforms* unis = static_cast<const CombineWithWater_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	vec4 COLOR;
-	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]) * swTexturePrimary(in, 0);
-	packColor(COLOR, in.rgba);
+	vfloat afwidth = length(vvec2(dFdx(value), dFdy(value))) * 0.70710678118654757f;
+	return smoothstep(threshold - afwidth, threshold + afwidth, value);
 }
 
-		// --- DefaultMeshSprite ---
-struct DefaultMeshSprite_Uniforms
-{
-};
-
-void DefaultMeshSprite_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
+static nCine::RHI::Software::sw::wide4::vvec3 CombineWithWater_permute4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec3 x)
 {
 	using namespace nCine::RHI::Software::sw;
-	const DefaultMeshSprite_Uniforms* unis = static_cast<const DefaultMeshSprite_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide4;
+	const CombineWithWater_Uniforms* unis = static_cast<const CombineWithWater_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	vec4 COLOR;
-	COLOR = swTexturePrimary(in, 0) * vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
-	packColor(COLOR, in.rgba);
+	return mod((x * 34.0f + 1.0f) * x, 289.0f);
 }
 
-		// --- DefaultMeshSpriteNoTexture ---
-struct DefaultMeshSpriteNoTexture_Uniforms
-{
-};
-
-void DefaultMeshSpriteNoTexture_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
+static nCine::RHI::Software::sw::wide4::vfloat CombineWithWater_snoise4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec2 v)
 {
 	using namespace nCine::RHI::Software::sw;
-	const DefaultMeshSpriteNoTexture_Uniforms* unis = static_cast<const DefaultMeshSpriteNoTexture_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide4;
+	const CombineWithWater_Uniforms* unis = static_cast<const CombineWithWater_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	vec4 COLOR;
-	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
-	packColor(COLOR, in.rgba);
+	vec4 C = vec4(0.211324865405187f, 0.366025403784439f, -0.577350269189626f, 0.024390243902439f);
+	vvec2 i = floor(v + dot(v, C.yy()));
+	vvec2 x0 = v - i + dot(i, C.xx());
+	vvec2 i1 = select(vmask(x0.x > x0.y), vec2(1.0f, 0.0f), vec2(0.0f, 1.0f));
+	vvec4 x12 = x0.xyxy() + C.xxzz();
+	{
+		const vvec2 _w = vvec2(i1);
+		x12.x -= _w.x;
+		x12.y -= _w.y;
+	}
+	i = mod(i, 289.0f);
+	vvec3 p = CombineWithWater_permute4(in, CombineWithWater_permute4(in, i.y + vvec3(0.0f, i1.y, 1.0f)) + i.x + vvec3(0.0f, i1.x, 1.0f));
+	vvec3 m = max(0.5f - vvec3(dot(x0, x0), dot(x12.xy(), x12.xy()), dot(x12.zw(), x12.zw())), 0.0f);
+	m = m * m;
+	m = m * m;
+	vvec3 x = 2.0f * fract(p * C.www()) - 1.0f;
+	vvec3 h = abs(x) - 0.5f;
+	vvec3 ox = floor(x + 0.5f);
+	vvec3 a0 = x - ox;
+	m *= 1.79284291400159f - 0.85373472095314f * (a0 * a0 + h * h);
+	vvec3 g;
+	g.x = a0.x * x0.x + h.x * x0.y;
+	{
+		const vvec2 _w = vvec2(a0.yz() * x12.xz() + h.yz() * x12.yw());
+		g.y = _w.x;
+		g.z = _w.y;
+	}
+	return 130.0f * dot(m, g);
 }
 
-		// --- DefaultSprite ---
-struct DefaultSprite_Uniforms
-{
-};
-
-void DefaultSprite_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
+void CombineWithWater_Fragment4(const nCine::RHI::Software::FragmentShaderInput4& in)
 {
 	using namespace nCine::RHI::Software::sw;
-	const DefaultSprite_Uniforms* unis = static_cast<const DefaultSprite_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide4;
+	const CombineWithWater_Uniforms* unis = static_cast<const CombineWithWater_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	vec4 COLOR;
-	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
-	COLOR = swTexturePrimary(in, 0) * COLOR;
+	vvec4 COLOR;
+	vec3 waterColor = vec3(0.4f, 0.6f, 0.8f);
+	vvec2 uvLocal = swTexCoords(in);
+	vec2 uvWorldCenter = unis->uCameraPos.xy() * unis->vViewSizeInv.xy();
+	vvec2 uvWorld = uvLocal + uvWorldCenter;
+	vfloat waveHeight = CombineWithWater_wave4(in, uvWorld.x, unis->uTime);
+	vfloat isTexelBelow = CombineWithWater_aastep4(in, waveHeight, uvLocal.y - unis->uWaterLevel);
+	vfloat isTexelAbove = 1.0f - isTexelBelow;
+	vvec2 disPos = uvWorld * vec2(0.1f) + vec2(mod(unis->uTime * 0.4f, 2.0f));
+	vvec2 dis = (swTexture(in, 4, disPos).xy() - vec2(0.5f)) * vec2(0.01f);
+	vvec2 uv = clamp(uvLocal + (vvec2(0.004f * sin(unis->uTime * 16.0f + uvWorld.y * 20.0f), 0.0f) + dis) * vvec2(isTexelBelow), vec2(0.0f), vec2(1.0f));
+	vvec4 main = swTexture(in, 0, uv);
+	vfloat aberration = abs(uvLocal.x - 0.5f) * 0.012f;
+	vfloat red = swTexture(in, 0, vvec2(uv.x - aberration, uv.y)).x;
+	vfloat blue = swTexture(in, 0, vvec2(uv.x + aberration, uv.y)).z;
+	{
+		const vvec3 _w = vvec3(mix(main.xyz(), waterColor * (0.4f + 1.2f * vvec3(red, main.y, blue)), vvec3(isTexelBelow * 0.5f)));
+		main.x = _w.x;
+		main.y = _w.y;
+		main.z = _w.z;
+	}
+	vvec2 uvNormalized = mod(uvLocal / unis->vViewSizeInv, 720.0f) / 720.0f;
+	vfloat noisePos = uvWorldCenter.x * 6.0f + uvLocal.x * 1.4f + uvWorldCenter.y * 0.5f + (1.0f - uvNormalized.x * 1.2f - uvNormalized.y) * -5.0f;
+	vfloat rays = CombineWithWater_snoise4(in, vvec2(noisePos, unis->uTime * 5.0f + uvWorldCenter.y)) * 0.55f + 0.3f;
+	{
+		const vvec3 _w = vvec3(vvec3(rays * isTexelBelow * max(1.0f - uvLocal.y * 1.4f, 0.0f) * 0.6f));
+		main.x += _w.x;
+		main.y += _w.y;
+		main.z += _w.z;
+	}
+	vfloat topDist = abs(uvLocal.y - unis->uWaterLevel - waveHeight);
+	vfloat isNearTop = 1.0f - CombineWithWater_aastep4(in, unis->vViewSizeInv.y * 2.8f, topDist);
+	vfloat isVeryNearTop = 1.0f - CombineWithWater_aastep4(in, unis->vViewSizeInv.y * (0.8f - 100.0f * waveHeight), topDist);
+	vfloat topColorBlendFac = isNearTop * isTexelBelow * 0.6f;
+	{
+		const vvec3 _w = vvec3(mix(main.xyz(), swTexture(in, 0, vvec2(uvLocal.x, (unis->uWaterLevel - uvLocal.y + unis->uWaterLevel) * 0.97f - waveHeight + unis->vViewSizeInv.y)).xyz(), vvec3(topColorBlendFac)));
+		main.x = _w.x;
+		main.y = _w.y;
+		main.z = _w.z;
+	}
+	{
+		const vvec3 _w = vvec3(vvec3(0.2f * isVeryNearTop));
+		main.x += _w.x;
+		main.y += _w.y;
+		main.z += _w.z;
+	}
+	vvec4 blur1 = swTexture(in, 2, uv);
+	vvec4 blur2 = swTexture(in, 3, uv);
+	vvec4 light = swTexture(in, 1, CombineWithWater_noiseTexCoords4(in, uv));
+	vvec4 blur = (blur1 + blur2) * vec4(0.5f);
+	vfloat gray = dot(blur.xyz(), vec3(0.299f, 0.587f, 0.114f));
+	blur = vvec4(gray, gray, gray, blur.w);
+	vfloat darknessStrength = 1.0f - light.x;
+	if (unis->uWaterLevel < 0.4f) {
+		vfloat aboveWaterDarkness = isTexelAbove * (0.4f - unis->uWaterLevel);
+		darknessStrength = min(1.0f, darknessStrength + aboveWaterDarkness);
+	}
+	COLOR = mix(mix(main * (1.0f + light.y) + max(light.y - 0.7f, 0.0f) * vec4(1.0f), blur, vvec4(clamp((1.0f - light.x) / sqrt(max(unis->uAmbientColor.w, 0.35f)), 0.0f, 1.0f))), unis->uAmbientColor, vvec4(darknessStrength));
+	COLOR.w = 1.0f;
 	packColor(COLOR, in.rgba);
 }
 
-		// --- DefaultBatchedSprites ---
-struct DefaultBatchedSprites_Uniforms
-{
-};
-
-void DefaultBatchedSprites_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
+#if defined(SW_WIDE8)
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vvec2 CombineWithWater_hash2D8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec2 p)
 {
 	using namespace nCine::RHI::Software::sw;
-	const DefaultBatchedSprites_Uniforms* unis = static_cast<const DefaultBatchedSprites_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide8;
+	const CombineWithWater_Uniforms* unis = static_cast<const CombineWithWater_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	vec4 COLOR;
-	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
-	COLOR = swTexturePrimary(in, 0) * COLOR;
-	packColor(COLOR, in.rgba);
+	vfloat h = dot(p, vec2(12.9898f, 78.233f));
+	vfloat h2 = dot(p, vec2(37.271f, 377.632f));
+	return -1.0f + 2.0f * vvec2(fract(sin(h) * 43758.5453f), fract(sin(h2) * 43758.5453f));
 }
 
-		// --- DefaultSpriteNoTexture ---
-struct DefaultSpriteNoTexture_Uniforms
-{
-};
-
-void DefaultSpriteNoTexture_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vvec2 CombineWithWater_noiseTexCoords8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec2 position)
 {
 	using namespace nCine::RHI::Software::sw;
-	const DefaultSpriteNoTexture_Uniforms* unis = static_cast<const DefaultSpriteNoTexture_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide8;
+	const CombineWithWater_Uniforms* unis = static_cast<const CombineWithWater_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	vec4 COLOR;
-	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
-	packColor(COLOR, in.rgba);
+	vvec2 seed = position + fract(unis->uTime * 0.01f);
+	return clamp(position + CombineWithWater_hash2D8(in, seed) * unis->vViewSizeInv * 1.4f, vec2(0.0f), vec2(1.0f));
 }
 
-		// --- Downsample ---
-struct Downsample_Uniforms
-{
-	nCine::RHI::Software::sw::vec2 uPixelOffset;
-};
-
-void Downsample_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vfloat CombineWithWater_wave8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vfloat x, nCine::RHI::Software::sw::wide8::vfloat time)
 {
 	using namespace nCine::RHI::Software::sw;
-	const Downsample_Uniforms* unis = static_cast<const Downsample_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide8;
+	const CombineWithWater_Uniforms* unis = static_cast<const CombineWithWater_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	vec4 COLOR;
-	vec4 color = swTexturePrimary(in, 0);
-	color += swTexture(in, 0, vec2(in.u, in.v) + vec2(0.0f, unis->uPixelOffset.y));
-	color += swTexture(in, 0, vec2(in.u, in.v) + vec2(unis->uPixelOffset.x, 0.0f));
-	color += swTexture(in, 0, vec2(in.u, in.v) + unis->uPixelOffset);
-	COLOR = vec4(0.25f) * color;
-	packColor(COLOR, in.rgba);
+	vfloat waveOffset = cos((x - time) * 60.0f) * 0.004f + cos((x - 2.0f * time) * 20.0f) * 0.008f + sin((x + 2.0f * time) * 35.0f) * 0.01f + cos((x + 4.0f * time) * 70.0f) * 0.001f;
+	return waveOffset * 0.4f;
 }
 
-		// --- FrozenMask ---
-struct FrozenMask_Uniforms
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vfloat CombineWithWater_aastep8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vfloat threshold, nCine::RHI::Software::sw::wide8::vfloat value)
 {
-};
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const CombineWithWater_Uniforms* unis = static_cast<const CombineWithWater_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vfloat afwidth = length(vvec2(dFdx(value), dFdy(value))) * 0.70710678118654757f;
+	return smoothstep(threshold - afwidth, threshold + afwidth, value);
+}
 
-static float FrozenMask_aastep(const nCine::RHI::Software::FragmentShaderInput& in, float threshold, float value)
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vvec3 CombineWithWater_permute8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec3 x)
 {
 	using namespace nCine::RHI::Software::sw;
-	const FrozenMask_Uniforms* unis = static_cast<const FrozenMask_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide8;
+	const CombineWithWater_Uniforms* unis = static_cast<const CombineWithWater_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	float afwidth = length(vec2(dFdx(value), dFdy(value))) * 0.70710678118654757f;
-	return smoothstep(threshold - afwidth, threshold + afwidth, value);
+	return mod((x * 34.0f + 1.0f) * x, 289.0f);
 }
 
-static nCine::RHI::Software::sw::vec4 FrozenMask_maskSample(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 uv)
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vfloat CombineWithWater_snoise8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec2 v)
 {
 	using namespace nCine::RHI::Software::sw;
-	const FrozenMask_Uniforms* unis = static_cast<const FrozenMask_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide8;
+	const CombineWithWater_Uniforms* unis = static_cast<const CombineWithWater_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	vec4 src = swTexture(in, 0, uv);
-	return src;
+	vec4 C = vec4(0.211324865405187f, 0.366025403784439f, -0.577350269189626f, 0.024390243902439f);
+	vvec2 i = floor(v + dot(v, C.yy()));
+	vvec2 x0 = v - i + dot(i, C.xx());
+	vvec2 i1 = select(vmask(x0.x > x0.y), vec2(1.0f, 0.0f), vec2(0.0f, 1.0f));
+	vvec4 x12 = x0.xyxy() + C.xxzz();
+	{
+		const vvec2 _w = vvec2(i1);
+		x12.x -= _w.x;
+		x12.y -= _w.y;
+	}
+	i = mod(i, 289.0f);
+	vvec3 p = CombineWithWater_permute8(in, CombineWithWater_permute8(in, i.y + vvec3(0.0f, i1.y, 1.0f)) + i.x + vvec3(0.0f, i1.x, 1.0f));
+	vvec3 m = max(0.5f - vvec3(dot(x0, x0), dot(x12.xy(), x12.xy()), dot(x12.zw(), x12.zw())), 0.0f);
+	m = m * m;
+	m = m * m;
+	vvec3 x = 2.0f * fract(p * C.www()) - 1.0f;
+	vvec3 h = abs(x) - 0.5f;
+	vvec3 ox = floor(x + 0.5f);
+	vvec3 a0 = x - ox;
+	m *= 1.79284291400159f - 0.85373472095314f * (a0 * a0 + h * h);
+	vvec3 g;
+	g.x = a0.x * x0.x + h.x * x0.y;
+	{
+		const vvec2 _w = vvec2(a0.yz() * x12.xz() + h.yz() * x12.yw());
+		g.y = _w.x;
+		g.z = _w.y;
+	}
+	return 130.0f * dot(m, g);
 }
 
-void FrozenMask_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
+DEATH_ENABLE_AVX2 void CombineWithWater_Fragment8(const nCine::RHI::Software::FragmentShaderInput8& in)
 {
 	using namespace nCine::RHI::Software::sw;
-	const FrozenMask_Uniforms* unis = static_cast<const FrozenMask_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide8;
+	const CombineWithWater_Uniforms* unis = static_cast<const CombineWithWater_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	vec4 COLOR;
-	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
-	vec2 size = COLOR.xy() * COLOR.a * 2.0f;
-	vec4 tex = FrozenMask_maskSample(in, vec2(in.u, in.v));
-	vec4 tex1 = FrozenMask_maskSample(in, vec2(in.u, in.v) + vec2(-size.x, 0));
-	vec4 tex2 = FrozenMask_maskSample(in, vec2(in.u, in.v) + vec2(0, size.y));
-	vec4 tex3 = FrozenMask_maskSample(in, vec2(in.u, in.v) + vec2(size.x, 0));
-	vec4 tex4 = FrozenMask_maskSample(in, vec2(in.u, in.v) + vec2(0, -size.y));
-	float outline = tex1.a;
-	outline += tex2.a;
-	outline += tex3.a;
-	outline += tex4.a;
-	outline += FrozenMask_maskSample(in, vec2(in.u, in.v) + vec2(-size.x, size.y)).a;
-	outline += FrozenMask_maskSample(in, vec2(in.u, in.v) + vec2(size.x, size.y)).a;
-	outline += FrozenMask_maskSample(in, vec2(in.u, in.v) + vec2(-size.x, -size.y)).a;
-	outline += FrozenMask_maskSample(in, vec2(in.u, in.v) + vec2(size.x, -size.y)).a;
-	outline = FrozenMask_aastep(in, 1.0f, outline);
-	vec4 color = (tex + tex + tex1 + tex2 + tex3 + tex4) / 6.0f;
-	float grey = min((0.299f * color.r + 0.587f * color.g + 0.114f * color.b) * 2.6f, 1.0f);
-	COLOR = mix(tex, vec4(0.2f * grey, 0.2f + grey * 0.62f, 0.6f + 0.2f * grey, outline * 0.95f), COLOR.a);
+	vvec4 COLOR;
+	vec3 waterColor = vec3(0.4f, 0.6f, 0.8f);
+	vvec2 uvLocal = swTexCoords(in);
+	vec2 uvWorldCenter = unis->uCameraPos.xy() * unis->vViewSizeInv.xy();
+	vvec2 uvWorld = uvLocal + uvWorldCenter;
+	vfloat waveHeight = CombineWithWater_wave8(in, uvWorld.x, unis->uTime);
+	vfloat isTexelBelow = CombineWithWater_aastep8(in, waveHeight, uvLocal.y - unis->uWaterLevel);
+	vfloat isTexelAbove = 1.0f - isTexelBelow;
+	vvec2 disPos = uvWorld * vec2(0.1f) + vec2(mod(unis->uTime * 0.4f, 2.0f));
+	vvec2 dis = (swTexture(in, 4, disPos).xy() - vec2(0.5f)) * vec2(0.01f);
+	vvec2 uv = clamp(uvLocal + (vvec2(0.004f * sin(unis->uTime * 16.0f + uvWorld.y * 20.0f), 0.0f) + dis) * vvec2(isTexelBelow), vec2(0.0f), vec2(1.0f));
+	vvec4 main = swTexture(in, 0, uv);
+	vfloat aberration = abs(uvLocal.x - 0.5f) * 0.012f;
+	vfloat red = swTexture(in, 0, vvec2(uv.x - aberration, uv.y)).x;
+	vfloat blue = swTexture(in, 0, vvec2(uv.x + aberration, uv.y)).z;
+	{
+		const vvec3 _w = vvec3(mix(main.xyz(), waterColor * (0.4f + 1.2f * vvec3(red, main.y, blue)), vvec3(isTexelBelow * 0.5f)));
+		main.x = _w.x;
+		main.y = _w.y;
+		main.z = _w.z;
+	}
+	vvec2 uvNormalized = mod(uvLocal / unis->vViewSizeInv, 720.0f) / 720.0f;
+	vfloat noisePos = uvWorldCenter.x * 6.0f + uvLocal.x * 1.4f + uvWorldCenter.y * 0.5f + (1.0f - uvNormalized.x * 1.2f - uvNormalized.y) * -5.0f;
+	vfloat rays = CombineWithWater_snoise8(in, vvec2(noisePos, unis->uTime * 5.0f + uvWorldCenter.y)) * 0.55f + 0.3f;
+	{
+		const vvec3 _w = vvec3(vvec3(rays * isTexelBelow * max(1.0f - uvLocal.y * 1.4f, 0.0f) * 0.6f));
+		main.x += _w.x;
+		main.y += _w.y;
+		main.z += _w.z;
+	}
+	vfloat topDist = abs(uvLocal.y - unis->uWaterLevel - waveHeight);
+	vfloat isNearTop = 1.0f - CombineWithWater_aastep8(in, unis->vViewSizeInv.y * 2.8f, topDist);
+	vfloat isVeryNearTop = 1.0f - CombineWithWater_aastep8(in, unis->vViewSizeInv.y * (0.8f - 100.0f * waveHeight), topDist);
+	vfloat topColorBlendFac = isNearTop * isTexelBelow * 0.6f;
+	{
+		const vvec3 _w = vvec3(mix(main.xyz(), swTexture(in, 0, vvec2(uvLocal.x, (unis->uWaterLevel - uvLocal.y + unis->uWaterLevel) * 0.97f - waveHeight + unis->vViewSizeInv.y)).xyz(), vvec3(topColorBlendFac)));
+		main.x = _w.x;
+		main.y = _w.y;
+		main.z = _w.z;
+	}
+	{
+		const vvec3 _w = vvec3(vvec3(0.2f * isVeryNearTop));
+		main.x += _w.x;
+		main.y += _w.y;
+		main.z += _w.z;
+	}
+	vvec4 blur1 = swTexture(in, 2, uv);
+	vvec4 blur2 = swTexture(in, 3, uv);
+	vvec4 light = swTexture(in, 1, CombineWithWater_noiseTexCoords8(in, uv));
+	vvec4 blur = (blur1 + blur2) * vec4(0.5f);
+	vfloat gray = dot(blur.xyz(), vec3(0.299f, 0.587f, 0.114f));
+	blur = vvec4(gray, gray, gray, blur.w);
+	vfloat darknessStrength = 1.0f - light.x;
+	if (unis->uWaterLevel < 0.4f) {
+		vfloat aboveWaterDarkness = isTexelAbove * (0.4f - unis->uWaterLevel);
+		darknessStrength = min(1.0f, darknessStrength + aboveWaterDarkness);
+	}
+	COLOR = mix(mix(main * (1.0f + light.y) + max(light.y - 0.7f, 0.0f) * vec4(1.0f), blur, vvec4(clamp((1.0f - light.x) / sqrt(max(unis->uAmbientColor.w, 0.35f)), 0.0f, 1.0f))), unis->uAmbientColor, vvec4(darknessStrength));
+	COLOR.w = 1.0f;
 	packColor(COLOR, in.rgba);
 }
+#endif
 
-		// --- FrozenMask_USE_PALETTE ---
-struct FrozenMask_USE_PALETTE_Uniforms
+		// --- CombineWithWaterLow ---
+struct CombineWithWaterLow_Uniforms
 {
-	float vPaletteOffset;
+	nCine::RHI::Software::sw::vec4 uAmbientColor;
+	float uTime;
+	nCine::RHI::Software::sw::vec2 uCameraPos;
+	float uWaterLevel;
+	nCine::RHI::Software::sw::vec2 vViewSizeInv;
 };
 
-void FrozenMask_USE_PALETTE_ComputeVaryings(void* inputs, const std::uint8_t* instanceBlock)
+void CombineWithWaterLow_ComputeVaryings(void* inputs, const std::uint8_t* instanceBlock)
 {
 	using namespace nCine::RHI::Software::sw;
-	FrozenMask_USE_PALETTE_Uniforms* io = static_cast<FrozenMask_USE_PALETTE_Uniforms*>(inputs);
+	CombineWithWaterLow_Uniforms* io = static_cast<CombineWithWaterLow_Uniforms*>(inputs);
 	(void)io;
 	(void)instanceBlock;
-	io->vPaletteOffset = (*reinterpret_cast<const float*>(instanceBlock + 104));
+	io->vViewSizeInv = (vec2(1.0f) / (*reinterpret_cast<const vec2*>(instanceBlock + 96)));
 }
 
-static float FrozenMask_USE_PALETTE_aastep(const nCine::RHI::Software::FragmentShaderInput& in, float threshold, float value)
+static nCine::RHI::Software::sw::vec2 CombineWithWaterLow_hash2D(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 p)
 {
 	using namespace nCine::RHI::Software::sw;
-	const FrozenMask_USE_PALETTE_Uniforms* unis = static_cast<const FrozenMask_USE_PALETTE_Uniforms*>(in.userData);
+	const CombineWithWaterLow_Uniforms* unis = static_cast<const CombineWithWaterLow_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	float afwidth = length(vec2(dFdx(value), dFdy(value))) * 0.70710678118654757f;
-	return smoothstep(threshold - afwidth, threshold + afwidth, value);
+	float h = dot(p, vec2(12.9898f, 78.233f));
+	float h2 = dot(p, vec2(37.271f, 377.632f));
+	return -1.0f + 2.0f * vec2(fract(sin(h) * 43758.5453f), fract(sin(h2) * 43758.5453f));
 }
 
-static nCine::RHI::Software::sw::vec4 FrozenMask_USE_PALETTE_maskSample(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 uv)
+static nCine::RHI::Software::sw::vec2 CombineWithWaterLow_noiseTexCoords(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 position)
 {
 	using namespace nCine::RHI::Software::sw;
-	const FrozenMask_USE_PALETTE_Uniforms* unis = static_cast<const FrozenMask_USE_PALETTE_Uniforms*>(in.userData);
+	const CombineWithWaterLow_Uniforms* unis = static_cast<const CombineWithWaterLow_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	vec4 src = swTexture(in, 0, uv);
-	float palIndex = floor(unis->vPaletteOffset + 0.5f) + floor(src.r * 255.0f + 0.5f);
-	float palX = (mod(palIndex, 256.0f) + 0.5f) / 256.0f;
-	float palY = (floor(palIndex / 256.0f) + 0.5f) / 256.0f;
-	vec4 c = swTexture(in, 1, vec2(palX, palY));
-	return vec4(c.rgb(), c.a * src.a);
+	vec2 seed = position + fract(unis->uTime * 0.01f);
+	return clamp(position + CombineWithWaterLow_hash2D(in, seed) * unis->vViewSizeInv * 1.4f, vec2(0.0f), vec2(1.0f));
 }
 
-void FrozenMask_USE_PALETTE_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
+void CombineWithWaterLow_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
 {
 	using namespace nCine::RHI::Software::sw;
-	const FrozenMask_USE_PALETTE_Uniforms* unis = static_cast<const FrozenMask_USE_PALETTE_Uniforms*>(in.userData);
+	const CombineWithWaterLow_Uniforms* unis = static_cast<const CombineWithWaterLow_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
 	vec4 COLOR;
-	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
-	vec2 size = COLOR.xy() * COLOR.a * 2.0f;
-	vec4 tex = FrozenMask_USE_PALETTE_maskSample(in, vec2(in.u, in.v));
-	vec4 tex1 = FrozenMask_USE_PALETTE_maskSample(in, vec2(in.u, in.v) + vec2(-size.x, 0));
-	vec4 tex2 = FrozenMask_USE_PALETTE_maskSample(in, vec2(in.u, in.v) + vec2(0, size.y));
-	vec4 tex3 = FrozenMask_USE_PALETTE_maskSample(in, vec2(in.u, in.v) + vec2(size.x, 0));
-	vec4 tex4 = FrozenMask_USE_PALETTE_maskSample(in, vec2(in.u, in.v) + vec2(0, -size.y));
-	float outline = tex1.a;
-	outline += tex2.a;
-	outline += tex3.a;
-	outline += tex4.a;
-	outline += FrozenMask_USE_PALETTE_maskSample(in, vec2(in.u, in.v) + vec2(-size.x, size.y)).a;
-	outline += FrozenMask_USE_PALETTE_maskSample(in, vec2(in.u, in.v) + vec2(size.x, size.y)).a;
-	outline += FrozenMask_USE_PALETTE_maskSample(in, vec2(in.u, in.v) + vec2(-size.x, -size.y)).a;
-	outline += FrozenMask_USE_PALETTE_maskSample(in, vec2(in.u, in.v) + vec2(size.x, -size.y)).a;
-	outline = FrozenMask_USE_PALETTE_aastep(in, 1.0f, outline);
-	vec4 color = (tex + tex + tex1 + tex2 + tex3 + tex4) / 6.0f;
-	float grey = min((0.299f * color.r + 0.587f * color.g + 0.114f * color.b) * 2.6f, 1.0f);
-	COLOR = mix(tex, vec4(0.2f * grey, 0.2f + grey * 0.62f, 0.6f + 0.2f * grey, outline * 0.95f), COLOR.a);
+	vec3 waterColor = vec3(0.4f, 0.6f, 0.8f);
+	vec2 uvLocal = vec2(in.u, in.v);
+	vec2 uvWorldCenter = unis->uCameraPos.xy() * unis->vViewSizeInv.xy();
+	vec2 uvWorld = uvLocal + uvWorldCenter;
+	float isTexelBelow = 1.0f - step(uvLocal.y, unis->uWaterLevel);
+	float isTexelAbove = 1.0f - isTexelBelow;
+	vec2 uv = clamp(uvLocal + vec2(0.008f * sin(unis->uTime * 16.0f + uvWorld.y * 20.0f) * isTexelBelow, 0.0f), vec2(0.0f), vec2(1.0f));
+	vec4 main = swTexture(in, 0, uv);
+	float topDist = abs(uvLocal.y - unis->uWaterLevel);
+	float topGradient = max(1.0f - topDist, 0.0f);
+	float isNearTop = 0.2f * topGradient * topGradient;
+	float isVeryNearTop = 1.0f - step(unis->vViewSizeInv.y, topDist);
+	{
+		const vec3 _w = vec3(mix(main.xyz(), waterColor, vec3(isTexelBelow * 0.4f)) + vec3((isNearTop + 0.2f * isVeryNearTop) * isTexelBelow));
+		main.r = _w.x;
+		main.g = _w.y;
+		main.b = _w.z;
+	}
+	vec4 blur1 = swTexture(in, 2, uv);
+	vec4 blur2 = swTexture(in, 3, uv);
+	vec4 light = swTexture(in, 1, CombineWithWaterLow_noiseTexCoords(in, uv));
+	vec4 blur = (blur1 + blur2) * vec4(0.5f);
+	float gray = dot(blur.xyz(), vec3(0.299f, 0.587f, 0.114f));
+	blur = vec4(gray, gray, gray, blur.a);
+	float darknessStrength = 1.0f - light.r;
+	if (unis->uWaterLevel < 0.4f) {
+		float aboveWaterDarkness = isTexelAbove * (0.4f - unis->uWaterLevel);
+		darknessStrength = min(1.0f, darknessStrength + aboveWaterDarkness);
+	}
+	COLOR = mix(mix(main * (1.0f + light.g) + max(light.g - 0.7f, 0.0f) * vec4(1.0f), blur, vec4(clamp((1.0f - light.r) / sqrt(max(unis->uAmbientColor.w, 0.35f)), 0.0f, 1.0f))), unis->uAmbientColor, vec4(darknessStrength));
+	COLOR.a = 1.0f;
 	packColor(COLOR, in.rgba);
 }
 
-		// --- BatchedFrozenMask ---
-struct BatchedFrozenMask_Uniforms
+static nCine::RHI::Software::sw::wide4::vvec2 CombineWithWaterLow_hash2D4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec2 p)
 {
-};
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const CombineWithWaterLow_Uniforms* unis = static_cast<const CombineWithWaterLow_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vfloat h = dot(p, vec2(12.9898f, 78.233f));
+	vfloat h2 = dot(p, vec2(37.271f, 377.632f));
+	return -1.0f + 2.0f * vvec2(fract(sin(h) * 43758.5453f), fract(sin(h2) * 43758.5453f));
+}
 
-static float BatchedFrozenMask_aastep(const nCine::RHI::Software::FragmentShaderInput& in, float threshold, float value)
+static nCine::RHI::Software::sw::wide4::vvec2 CombineWithWaterLow_noiseTexCoords4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec2 position)
 {
 	using namespace nCine::RHI::Software::sw;
-	const BatchedFrozenMask_Uniforms* unis = static_cast<const BatchedFrozenMask_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide4;
+	const CombineWithWaterLow_Uniforms* unis = static_cast<const CombineWithWaterLow_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	float afwidth = length(vec2(dFdx(value), dFdy(value))) * 0.70710678118654757f;
-	return smoothstep(threshold - afwidth, threshold + afwidth, value);
+	vvec2 seed = position + fract(unis->uTime * 0.01f);
+	return clamp(position + CombineWithWaterLow_hash2D4(in, seed) * unis->vViewSizeInv * 1.4f, vec2(0.0f), vec2(1.0f));
 }
 
-static nCine::RHI::Software::sw::vec4 BatchedFrozenMask_maskSample(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 uv)
+void CombineWithWaterLow_Fragment4(const nCine::RHI::Software::FragmentShaderInput4& in)
 {
 	using namespace nCine::RHI::Software::sw;
-	const BatchedFrozenMask_Uniforms* unis = static_cast<const BatchedFrozenMask_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide4;
+	const CombineWithWaterLow_Uniforms* unis = static_cast<const CombineWithWaterLow_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	vec4 src = swTexture(in, 0, uv);
-	return src;
+	vvec4 COLOR;
+	vec3 waterColor = vec3(0.4f, 0.6f, 0.8f);
+	vvec2 uvLocal = swTexCoords(in);
+	vec2 uvWorldCenter = unis->uCameraPos.xy() * unis->vViewSizeInv.xy();
+	vvec2 uvWorld = uvLocal + uvWorldCenter;
+	vfloat isTexelBelow = 1.0f - step(uvLocal.y, unis->uWaterLevel);
+	vfloat isTexelAbove = 1.0f - isTexelBelow;
+	vvec2 uv = clamp(uvLocal + vvec2(0.008f * sin(unis->uTime * 16.0f + uvWorld.y * 20.0f) * isTexelBelow, 0.0f), vec2(0.0f), vec2(1.0f));
+	vvec4 main = swTexture(in, 0, uv);
+	vfloat topDist = abs(uvLocal.y - unis->uWaterLevel);
+	vfloat topGradient = max(1.0f - topDist, 0.0f);
+	vfloat isNearTop = 0.2f * topGradient * topGradient;
+	vfloat isVeryNearTop = 1.0f - step(unis->vViewSizeInv.y, topDist);
+	{
+		const vvec3 _w = vvec3(mix(main.xyz(), waterColor, vvec3(isTexelBelow * 0.4f)) + vvec3((isNearTop + 0.2f * isVeryNearTop) * isTexelBelow));
+		main.x = _w.x;
+		main.y = _w.y;
+		main.z = _w.z;
+	}
+	vvec4 blur1 = swTexture(in, 2, uv);
+	vvec4 blur2 = swTexture(in, 3, uv);
+	vvec4 light = swTexture(in, 1, CombineWithWaterLow_noiseTexCoords4(in, uv));
+	vvec4 blur = (blur1 + blur2) * vec4(0.5f);
+	vfloat gray = dot(blur.xyz(), vec3(0.299f, 0.587f, 0.114f));
+	blur = vvec4(gray, gray, gray, blur.w);
+	vfloat darknessStrength = 1.0f - light.x;
+	if (unis->uWaterLevel < 0.4f) {
+		vfloat aboveWaterDarkness = isTexelAbove * (0.4f - unis->uWaterLevel);
+		darknessStrength = min(1.0f, darknessStrength + aboveWaterDarkness);
+	}
+	COLOR = mix(mix(main * (1.0f + light.y) + max(light.y - 0.7f, 0.0f) * vec4(1.0f), blur, vvec4(clamp((1.0f - light.x) / sqrt(max(unis->uAmbientColor.w, 0.35f)), 0.0f, 1.0f))), unis->uAmbientColor, vvec4(darknessStrength));
+	COLOR.w = 1.0f;
+	packColor(COLOR, in.rgba);
 }
 
-void BatchedFrozenMask_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
+#if defined(SW_WIDE8)
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vvec2 CombineWithWaterLow_hash2D8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec2 p)
 {
 	using namespace nCine::RHI::Software::sw;
-	const BatchedFrozenMask_Uniforms* unis = static_cast<const BatchedFrozenMask_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide8;
+	const CombineWithWaterLow_Uniforms* unis = static_cast<const CombineWithWaterLow_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	vec4 COLOR;
-	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
-	vec2 size = COLOR.xy() * COLOR.a * 2.0f;
-	vec4 tex = BatchedFrozenMask_maskSample(in, vec2(in.u, in.v));
-	vec4 tex1 = BatchedFrozenMask_maskSample(in, vec2(in.u, in.v) + vec2(-size.x, 0));
-	vec4 tex2 = BatchedFrozenMask_maskSample(in, vec2(in.u, in.v) + vec2(0, size.y));
-	vec4 tex3 = BatchedFrozenMask_maskSample(in, vec2(in.u, in.v) + vec2(size.x, 0));
-	vec4 tex4 = BatchedFrozenMask_maskSample(in, vec2(in.u, in.v) + vec2(0, -size.y));
-	float outline = tex1.a;
-	outline += tex2.a;
-	outline += tex3.a;
-	outline += tex4.a;
-	outline += BatchedFrozenMask_maskSample(in, vec2(in.u, in.v) + vec2(-size.x, size.y)).a;
-	outline += BatchedFrozenMask_maskSample(in, vec2(in.u, in.v) + vec2(size.x, size.y)).a;
-	outline += BatchedFrozenMask_maskSample(in, vec2(in.u, in.v) + vec2(-size.x, -size.y)).a;
-	outline += BatchedFrozenMask_maskSample(in, vec2(in.u, in.v) + vec2(size.x, -size.y)).a;
-	outline = BatchedFrozenMask_aastep(in, 1.0f, outline);
-	vec4 color = (tex + tex + tex1 + tex2 + tex3 + tex4) / 6.0f;
-	float grey = min((0.299f * color.r + 0.587f * color.g + 0.114f * color.b) * 2.6f, 1.0f);
-	COLOR = mix(tex, vec4(0.2f * grey, 0.2f + grey * 0.62f, 0.6f + 0.2f * grey, outline * 0.95f), COLOR.a);
+	vfloat h = dot(p, vec2(12.9898f, 78.233f));
+	vfloat h2 = dot(p, vec2(37.271f, 377.632f));
+	return -1.0f + 2.0f * vvec2(fract(sin(h) * 43758.5453f), fract(sin(h2) * 43758.5453f));
+}
+
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vvec2 CombineWithWaterLow_noiseTexCoords8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec2 position)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const CombineWithWaterLow_Uniforms* unis = static_cast<const CombineWithWaterLow_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec2 seed = position + fract(unis->uTime * 0.01f);
+	return clamp(position + CombineWithWaterLow_hash2D8(in, seed) * unis->vViewSizeInv * 1.4f, vec2(0.0f), vec2(1.0f));
+}
+
+DEATH_ENABLE_AVX2 void CombineWithWaterLow_Fragment8(const nCine::RHI::Software::FragmentShaderInput8& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const CombineWithWaterLow_Uniforms* unis = static_cast<const CombineWithWaterLow_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	vec3 waterColor = vec3(0.4f, 0.6f, 0.8f);
+	vvec2 uvLocal = swTexCoords(in);
+	vec2 uvWorldCenter = unis->uCameraPos.xy() * unis->vViewSizeInv.xy();
+	vvec2 uvWorld = uvLocal + uvWorldCenter;
+	vfloat isTexelBelow = 1.0f - step(uvLocal.y, unis->uWaterLevel);
+	vfloat isTexelAbove = 1.0f - isTexelBelow;
+	vvec2 uv = clamp(uvLocal + vvec2(0.008f * sin(unis->uTime * 16.0f + uvWorld.y * 20.0f) * isTexelBelow, 0.0f), vec2(0.0f), vec2(1.0f));
+	vvec4 main = swTexture(in, 0, uv);
+	vfloat topDist = abs(uvLocal.y - unis->uWaterLevel);
+	vfloat topGradient = max(1.0f - topDist, 0.0f);
+	vfloat isNearTop = 0.2f * topGradient * topGradient;
+	vfloat isVeryNearTop = 1.0f - step(unis->vViewSizeInv.y, topDist);
+	{
+		const vvec3 _w = vvec3(mix(main.xyz(), waterColor, vvec3(isTexelBelow * 0.4f)) + vvec3((isNearTop + 0.2f * isVeryNearTop) * isTexelBelow));
+		main.x = _w.x;
+		main.y = _w.y;
+		main.z = _w.z;
+	}
+	vvec4 blur1 = swTexture(in, 2, uv);
+	vvec4 blur2 = swTexture(in, 3, uv);
+	vvec4 light = swTexture(in, 1, CombineWithWaterLow_noiseTexCoords8(in, uv));
+	vvec4 blur = (blur1 + blur2) * vec4(0.5f);
+	vfloat gray = dot(blur.xyz(), vec3(0.299f, 0.587f, 0.114f));
+	blur = vvec4(gray, gray, gray, blur.w);
+	vfloat darknessStrength = 1.0f - light.x;
+	if (unis->uWaterLevel < 0.4f) {
+		vfloat aboveWaterDarkness = isTexelAbove * (0.4f - unis->uWaterLevel);
+		darknessStrength = min(1.0f, darknessStrength + aboveWaterDarkness);
+	}
+	COLOR = mix(mix(main * (1.0f + light.y) + max(light.y - 0.7f, 0.0f) * vec4(1.0f), blur, vvec4(clamp((1.0f - light.x) / sqrt(max(unis->uAmbientColor.w, 0.35f)), 0.0f, 1.0f))), unis->uAmbientColor, vvec4(darknessStrength));
+	COLOR.w = 1.0f;
 	packColor(COLOR, in.rgba);
 }
+#endif
 
-		// --- BatchedFrozenMask_USE_PALETTE ---
-struct BatchedFrozenMask_USE_PALETTE_Uniforms
+		// --- DefaultBatchedMeshSprites ---
+struct DefaultBatchedMeshSprites_Uniforms
 {
-	float vPaletteOffset;
 };
 
-void BatchedFrozenMask_USE_PALETTE_ComputeVaryings(void* inputs, const std::uint8_t* instanceBlock)
+void DefaultBatchedMeshSprites_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
 {
 	using namespace nCine::RHI::Software::sw;
-	BatchedFrozenMask_USE_PALETTE_Uniforms* io = static_cast<BatchedFrozenMask_USE_PALETTE_Uniforms*>(inputs);
-	(void)io;
-	(void)instanceBlock;
-	io->vPaletteOffset = (*reinterpret_cast<const float*>(instanceBlock + 104));
+	const DefaultBatchedMeshSprites_Uniforms* unis = static_cast<const DefaultBatchedMeshSprites_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vec4 COLOR;
+	COLOR = swTexturePrimary(in, 0) * vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	packColor(COLOR, in.rgba);
 }
 
-static float BatchedFrozenMask_USE_PALETTE_aastep(const nCine::RHI::Software::FragmentShaderInput& in, float threshold, float value)
+void DefaultBatchedMeshSprites_Fragment4(const nCine::RHI::Software::FragmentShaderInput4& in)
 {
 	using namespace nCine::RHI::Software::sw;
-	const BatchedFrozenMask_USE_PALETTE_Uniforms* unis = static_cast<const BatchedFrozenMask_USE_PALETTE_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide4;
+	const DefaultBatchedMeshSprites_Uniforms* unis = static_cast<const DefaultBatchedMeshSprites_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	float afwidth = length(vec2(dFdx(value), dFdy(value))) * 0.70710678118654757f;
-	return smoothstep(threshold - afwidth, threshold + afwidth, value);
+	vvec4 COLOR;
+	COLOR = swTexturePrimary(in, 0) * vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	packColor(COLOR, in.rgba);
 }
 
-static nCine::RHI::Software::sw::vec4 BatchedFrozenMask_USE_PALETTE_maskSample(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 uv)
+#if defined(SW_WIDE8)
+DEATH_ENABLE_AVX2 void DefaultBatchedMeshSprites_Fragment8(const nCine::RHI::Software::FragmentShaderInput8& in)
 {
 	using namespace nCine::RHI::Software::sw;
-	const BatchedFrozenMask_USE_PALETTE_Uniforms* unis = static_cast<const BatchedFrozenMask_USE_PALETTE_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide8;
+	const DefaultBatchedMeshSprites_Uniforms* unis = static_cast<const DefaultBatchedMeshSprites_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	vec4 src = swTexture(in, 0, uv);
-	float palIndex = floor(unis->vPaletteOffset + 0.5f) + floor(src.r * 255.0f + 0.5f);
-	float palX = (mod(palIndex, 256.0f) + 0.5f) / 256.0f;
-	float palY = (floor(palIndex / 256.0f) + 0.5f) / 256.0f;
-	vec4 c = swTexture(in, 1, vec2(palX, palY));
-	return vec4(c.rgb(), c.a * src.a);
+	vvec4 COLOR;
+	COLOR = swTexturePrimary(in, 0) * vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	packColor(COLOR, in.rgba);
 }
+#endif
 
-void BatchedFrozenMask_USE_PALETTE_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
+		// --- DefaultBatchedMeshSpritesNoTexture ---
+struct DefaultBatchedMeshSpritesNoTexture_Uniforms
+{
+};
+
+void DefaultBatchedMeshSpritesNoTexture_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
 {
 	using namespace nCine::RHI::Software::sw;
-	const BatchedFrozenMask_USE_PALETTE_Uniforms* unis = static_cast<const BatchedFrozenMask_USE_PALETTE_Uniforms*>(in.userData);
+	const DefaultBatchedMeshSpritesNoTexture_Uniforms* unis = static_cast<const DefaultBatchedMeshSpritesNoTexture_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
 	vec4 COLOR;
 	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
-	vec2 size = COLOR.xy() * COLOR.a * 2.0f;
-	vec4 tex = BatchedFrozenMask_USE_PALETTE_maskSample(in, vec2(in.u, in.v));
-	vec4 tex1 = BatchedFrozenMask_USE_PALETTE_maskSample(in, vec2(in.u, in.v) + vec2(-size.x, 0));
-	vec4 tex2 = BatchedFrozenMask_USE_PALETTE_maskSample(in, vec2(in.u, in.v) + vec2(0, size.y));
-	vec4 tex3 = BatchedFrozenMask_USE_PALETTE_maskSample(in, vec2(in.u, in.v) + vec2(size.x, 0));
-	vec4 tex4 = BatchedFrozenMask_USE_PALETTE_maskSample(in, vec2(in.u, in.v) + vec2(0, -size.y));
-	float outline = tex1.a;
-	outline += tex2.a;
-	outline += tex3.a;
-	outline += tex4.a;
-	outline += BatchedFrozenMask_USE_PALETTE_maskSample(in, vec2(in.u, in.v) + vec2(-size.x, size.y)).a;
-	outline += BatchedFrozenMask_USE_PALETTE_maskSample(in, vec2(in.u, in.v) + vec2(size.x, size.y)).a;
-	outline += BatchedFrozenMask_USE_PALETTE_maskSample(in, vec2(in.u, in.v) + vec2(-size.x, -size.y)).a;
-	outline += BatchedFrozenMask_USE_PALETTE_maskSample(in, vec2(in.u, in.v) + vec2(size.x, -size.y)).a;
-	outline = BatchedFrozenMask_USE_PALETTE_aastep(in, 1.0f, outline);
-	vec4 color = (tex + tex + tex1 + tex2 + tex3 + tex4) / 6.0f;
-	float grey = min((0.299f * color.r + 0.587f * color.g + 0.114f * color.b) * 2.6f, 1.0f);
-	COLOR = mix(tex, vec4(0.2f * grey, 0.2f + grey * 0.62f, 0.6f + 0.2f * grey, outline * 0.95f), COLOR.a);
 	packColor(COLOR, in.rgba);
 }
 
-		// --- Outline ---
-struct Outline_Uniforms
-{
-};
-
-static float Outline_aastep(const nCine::RHI::Software::FragmentShaderInput& in, float threshold, float value)
+void DefaultBatchedMeshSpritesNoTexture_Fragment4(const nCine::RHI::Software::FragmentShaderInput4& in)
 {
 	using namespace nCine::RHI::Software::sw;
-	const Outline_Uniforms* unis = static_cast<const Outline_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide4;
+	const DefaultBatchedMeshSpritesNoTexture_Uniforms* unis = static_cast<const DefaultBatchedMeshSpritesNoTexture_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	float afwidth = length(vec2(dFdx(value), dFdy(value))) * 0.70710678118654757f;
-	return smoothstep(threshold - afwidth, threshold + afwidth, value);
+	vvec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	packColor(COLOR, in.rgba);
 }
 
-void Outline_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
+#if defined(SW_WIDE8)
+DEATH_ENABLE_AVX2 void DefaultBatchedMeshSpritesNoTexture_Fragment8(const nCine::RHI::Software::FragmentShaderInput8& in)
 {
 	using namespace nCine::RHI::Software::sw;
-	const Outline_Uniforms* unis = static_cast<const Outline_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide8;
+	const DefaultBatchedMeshSpritesNoTexture_Uniforms* unis = static_cast<const DefaultBatchedMeshSpritesNoTexture_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	vec4 COLOR;
+	vvec4 COLOR;
 	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
-	vec2 size = COLOR.xy();
-	float outline = swTexture(in, 0, vec2(in.u, in.v) + vec2(-size.x, 0)).a;
-	outline += swTexture(in, 0, vec2(in.u, in.v) + vec2(0, size.y)).a;
-	outline += swTexture(in, 0, vec2(in.u, in.v) + vec2(size.x, 0)).a;
-	outline += swTexture(in, 0, vec2(in.u, in.v) + vec2(0, -size.y)).a;
-	outline += swTexture(in, 0, vec2(in.u, in.v) + vec2(-size.x, size.y)).a;
-	outline += swTexture(in, 0, vec2(in.u, in.v) + vec2(size.x, size.y)).a;
-	outline += swTexture(in, 0, vec2(in.u, in.v) + vec2(-size.x, -size.y)).a;
-	outline += swTexture(in, 0, vec2(in.u, in.v) + vec2(size.x, -size.y)).a;
-	outline = Outline_aastep(in, 1.0f, outline);
-	float outline2 = swTexture(in, 0, vec2(in.u, in.v) + vec2(-2.0f * size.x, 0)).a;
-	outline2 += swTexture(in, 0, vec2(in.u, in.v) + vec2(0, 2.0f * size.y)).a;
-	outline2 += swTexture(in, 0, vec2(in.u, in.v) + vec2(2.0f * size.x, 0)).a;
-	outline2 += swTexture(in, 0, vec2(in.u, in.v) + vec2(0, -2.0f * size.y)).a;
-	outline2 += swTexture(in, 0, vec2(in.u, in.v) + vec2(-2.0f * size.x, 2.0f * size.y)).a;
-	outline2 += swTexture(in, 0, vec2(in.u, in.v) + vec2(2.0f * size.x, 2.0f * size.y)).a;
-	outline2 += swTexture(in, 0, vec2(in.u, in.v) + vec2(-2.0f * size.x, -2.0f * size.y)).a;
-	outline2 += swTexture(in, 0, vec2(in.u, in.v) + vec2(2.0f * size.x, -2.0f * size.y)).a;
-	outline2 = Outline_aastep(in, 1.0f, outline2);
-	vec4 color = swTexturePrimary(in, 0);
-	COLOR = mix(color, mix(vec4(0.0f, 0.0f, 0.0f, COLOR.w * 0.5f), vec4(COLOR.z, COLOR.z, COLOR.z, COLOR.w), outline), max(outline, outline2) - color.a);
 	packColor(COLOR, in.rgba);
 }
+#endif
 
-		// --- BatchedOutline ---
-struct BatchedOutline_Uniforms
+		// --- DefaultBatchedSpritesNoTexture ---
+struct DefaultBatchedSpritesNoTexture_Uniforms
 {
 };
 
-static float BatchedOutline_aastep(const nCine::RHI::Software::FragmentShaderInput& in, float threshold, float value)
+void DefaultBatchedSpritesNoTexture_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
 {
 	using namespace nCine::RHI::Software::sw;
-	const BatchedOutline_Uniforms* unis = static_cast<const BatchedOutline_Uniforms*>(in.userData);
+	const DefaultBatchedSpritesNoTexture_Uniforms* unis = static_cast<const DefaultBatchedSpritesNoTexture_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	float afwidth = length(vec2(dFdx(value), dFdy(value))) * 0.70710678118654757f;
-	return smoothstep(threshold - afwidth, threshold + afwidth, value);
+	vec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	packColor(COLOR, in.rgba);
 }
 
-void BatchedOutline_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
+void DefaultBatchedSpritesNoTexture_Fragment4(const nCine::RHI::Software::FragmentShaderInput4& in)
 {
 	using namespace nCine::RHI::Software::sw;
-	const BatchedOutline_Uniforms* unis = static_cast<const BatchedOutline_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide4;
+	const DefaultBatchedSpritesNoTexture_Uniforms* unis = static_cast<const DefaultBatchedSpritesNoTexture_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	vec4 COLOR;
+	vvec4 COLOR;
 	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
-	vec2 size = COLOR.xy();
-	float outline = swTexture(in, 0, vec2(in.u, in.v) + vec2(-size.x, 0)).a;
-	outline += swTexture(in, 0, vec2(in.u, in.v) + vec2(0, size.y)).a;
-	outline += swTexture(in, 0, vec2(in.u, in.v) + vec2(size.x, 0)).a;
-	outline += swTexture(in, 0, vec2(in.u, in.v) + vec2(0, -size.y)).a;
-	outline += swTexture(in, 0, vec2(in.u, in.v) + vec2(-size.x, size.y)).a;
-	outline += swTexture(in, 0, vec2(in.u, in.v) + vec2(size.x, size.y)).a;
-	outline += swTexture(in, 0, vec2(in.u, in.v) + vec2(-size.x, -size.y)).a;
-	outline += swTexture(in, 0, vec2(in.u, in.v) + vec2(size.x, -size.y)).a;
-	outline = BatchedOutline_aastep(in, 1.0f, outline);
-	float outline2 = swTexture(in, 0, vec2(in.u, in.v) + vec2(-2.0f * size.x, 0)).a;
-	outline2 += swTexture(in, 0, vec2(in.u, in.v) + vec2(0, 2.0f * size.y)).a;
-	outline2 += swTexture(in, 0, vec2(in.u, in.v) + vec2(2.0f * size.x, 0)).a;
-	outline2 += swTexture(in, 0, vec2(in.u, in.v) + vec2(0, -2.0f * size.y)).a;
-	outline2 += swTexture(in, 0, vec2(in.u, in.v) + vec2(-2.0f * size.x, 2.0f * size.y)).a;
-	outline2 += swTexture(in, 0, vec2(in.u, in.v) + vec2(2.0f * size.x, 2.0f * size.y)).a;
-	outline2 += swTexture(in, 0, vec2(in.u, in.v) + vec2(-2.0f * size.x, -2.0f * size.y)).a;
-	outline2 += swTexture(in, 0, vec2(in.u, in.v) + vec2(2.0f * size.x, -2.0f * size.y)).a;
-	outline2 = BatchedOutline_aastep(in, 1.0f, outline2);
-	vec4 color = swTexturePrimary(in, 0);
-	COLOR = mix(color, mix(vec4(0.0f, 0.0f, 0.0f, COLOR.w * 0.5f), vec4(COLOR.z, COLOR.z, COLOR.z, COLOR.w), outline), max(outline, outline2) - color.a);
 	packColor(COLOR, in.rgba);
 }
 
-		// --- OutlinePalette ---
-struct OutlinePalette_Uniforms
+#if defined(SW_WIDE8)
+DEATH_ENABLE_AVX2 void DefaultBatchedSpritesNoTexture_Fragment8(const nCine::RHI::Software::FragmentShaderInput8& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const DefaultBatchedSpritesNoTexture_Uniforms* unis = static_cast<const DefaultBatchedSpritesNoTexture_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	packColor(COLOR, in.rgba);
+}
+#endif
+
+		// --- DefaultImGui ---
+struct DefaultImGui_Uniforms
 {
-	float vPaletteOffset;
 };
 
-void OutlinePalette_ComputeVaryings(void* inputs, const std::uint8_t* instanceBlock)
+void DefaultImGui_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
 {
 	using namespace nCine::RHI::Software::sw;
-	OutlinePalette_Uniforms* io = static_cast<OutlinePalette_Uniforms*>(inputs);
-	(void)io;
-	(void)instanceBlock;
-	io->vPaletteOffset = (*reinterpret_cast<const float*>(instanceBlock + 104));
+	const DefaultImGui_Uniforms* unis = static_cast<const DefaultImGui_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]) * swTexturePrimary(in, 0);
+	packColor(COLOR, in.rgba);
 }
 
-static float OutlinePalette_aastep(const nCine::RHI::Software::FragmentShaderInput& in, float threshold, float value)
+void DefaultImGui_Fragment4(const nCine::RHI::Software::FragmentShaderInput4& in)
 {
 	using namespace nCine::RHI::Software::sw;
-	const OutlinePalette_Uniforms* unis = static_cast<const OutlinePalette_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide4;
+	const DefaultImGui_Uniforms* unis = static_cast<const DefaultImGui_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	float afwidth = length(vec2(dFdx(value), dFdy(value))) * 0.70710678118654757f;
-	return smoothstep(threshold - afwidth, threshold + afwidth, value);
+	vvec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]) * swTexturePrimary(in, 0);
+	packColor(COLOR, in.rgba);
 }
 
-static nCine::RHI::Software::sw::vec4 OutlinePalette_palette(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 uv)
+#if defined(SW_WIDE8)
+DEATH_ENABLE_AVX2 void DefaultImGui_Fragment8(const nCine::RHI::Software::FragmentShaderInput8& in)
 {
 	using namespace nCine::RHI::Software::sw;
-	const OutlinePalette_Uniforms* unis = static_cast<const OutlinePalette_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide8;
+	const DefaultImGui_Uniforms* unis = static_cast<const DefaultImGui_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	vec4 src = swTexture(in, 0, uv);
-	float palIndex = floor(unis->vPaletteOffset + 0.5f) + floor(src.r * 255.0f + 0.5f);
-	float palX = (mod(palIndex, 256.0f) + 0.5f) / 256.0f;
-	float palY = (floor(palIndex / 256.0f) + 0.5f) / 256.0f;
-	vec4 c = swTexture(in, 1, vec2(palX, palY));
-	return vec4(c.rgb(), c.a * src.a);
+	vvec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]) * swTexturePrimary(in, 0);
+	packColor(COLOR, in.rgba);
 }
+#endif
 
-static float OutlinePalette_alphaAt(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 uv)
+		// --- DefaultMeshSprite ---
+struct DefaultMeshSprite_Uniforms
+{
+};
+
+void DefaultMeshSprite_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
 {
 	using namespace nCine::RHI::Software::sw;
-	const OutlinePalette_Uniforms* unis = static_cast<const OutlinePalette_Uniforms*>(in.userData);
+	const DefaultMeshSprite_Uniforms* unis = static_cast<const DefaultMeshSprite_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	vec4 src = swTexture(in, 0, uv);
-	float palIndex = floor(unis->vPaletteOffset + 0.5f) + floor(src.r * 255.0f + 0.5f);
-	float palX = (mod(palIndex, 256.0f) + 0.5f) / 256.0f;
-	float palY = (floor(palIndex / 256.0f) + 0.5f) / 256.0f;
-	return swTexture(in, 1, vec2(palX, palY)).a * src.a;
+	vec4 COLOR;
+	COLOR = swTexturePrimary(in, 0) * vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	packColor(COLOR, in.rgba);
 }
 
-void OutlinePalette_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
+void DefaultMeshSprite_Fragment4(const nCine::RHI::Software::FragmentShaderInput4& in)
 {
 	using namespace nCine::RHI::Software::sw;
-	const OutlinePalette_Uniforms* unis = static_cast<const OutlinePalette_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide4;
+	const DefaultMeshSprite_Uniforms* unis = static_cast<const DefaultMeshSprite_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = swTexturePrimary(in, 0) * vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	packColor(COLOR, in.rgba);
+}
+
+#if defined(SW_WIDE8)
+DEATH_ENABLE_AVX2 void DefaultMeshSprite_Fragment8(const nCine::RHI::Software::FragmentShaderInput8& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const DefaultMeshSprite_Uniforms* unis = static_cast<const DefaultMeshSprite_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = swTexturePrimary(in, 0) * vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	packColor(COLOR, in.rgba);
+}
+#endif
+
+		// --- DefaultMeshSpriteNoTexture ---
+struct DefaultMeshSpriteNoTexture_Uniforms
+{
+};
+
+void DefaultMeshSpriteNoTexture_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	const DefaultMeshSpriteNoTexture_Uniforms* unis = static_cast<const DefaultMeshSpriteNoTexture_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
 	vec4 COLOR;
 	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
-	vec2 size = COLOR.xy();
-	float outline = OutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(-size.x, 0));
-	outline += OutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(0, size.y));
-	outline += OutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(size.x, 0));
-	outline += OutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(0, -size.y));
-	outline += OutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(-size.x, size.y));
-	outline += OutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(size.x, size.y));
-	outline += OutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(-size.x, -size.y));
-	outline += OutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(size.x, -size.y));
-	outline = OutlinePalette_aastep(in, 1.0f, outline);
-	float outline2 = OutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(-2.0f * size.x, 0));
-	outline2 += OutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(0, 2.0f * size.y));
-	outline2 += OutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(2.0f * size.x, 0));
-	outline2 += OutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(0, -2.0f * size.y));
-	outline2 += OutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(-2.0f * size.x, 2.0f * size.y));
-	outline2 += OutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(2.0f * size.x, 2.0f * size.y));
-	outline2 += OutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(-2.0f * size.x, -2.0f * size.y));
-	outline2 += OutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(2.0f * size.x, -2.0f * size.y));
-	outline2 = OutlinePalette_aastep(in, 1.0f, outline2);
-	vec4 color = OutlinePalette_palette(in, vec2(in.u, in.v));
-	COLOR = mix(color, mix(vec4(0.0f, 0.0f, 0.0f, COLOR.w * 0.5f), vec4(COLOR.z, COLOR.z, COLOR.z, COLOR.w), outline), max(outline, outline2) - color.a);
 	packColor(COLOR, in.rgba);
 }
 
-		// --- BatchedOutlinePalette ---
-struct BatchedOutlinePalette_Uniforms
+void DefaultMeshSpriteNoTexture_Fragment4(const nCine::RHI::Software::FragmentShaderInput4& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const DefaultMeshSpriteNoTexture_Uniforms* unis = static_cast<const DefaultMeshSpriteNoTexture_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	packColor(COLOR, in.rgba);
+}
+
+#if defined(SW_WIDE8)
+DEATH_ENABLE_AVX2 void DefaultMeshSpriteNoTexture_Fragment8(const nCine::RHI::Software::FragmentShaderInput8& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const DefaultMeshSpriteNoTexture_Uniforms* unis = static_cast<const DefaultMeshSpriteNoTexture_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	packColor(COLOR, in.rgba);
+}
+#endif
+
+		// --- DefaultSprite ---
+struct DefaultSprite_Uniforms
+{
+};
+
+void DefaultSprite_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	const DefaultSprite_Uniforms* unis = static_cast<const DefaultSprite_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	COLOR = swTexturePrimary(in, 0) * COLOR;
+	packColor(COLOR, in.rgba);
+}
+
+void DefaultSprite_Fragment4(const nCine::RHI::Software::FragmentShaderInput4& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const DefaultSprite_Uniforms* unis = static_cast<const DefaultSprite_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	COLOR = swTexturePrimary(in, 0) * COLOR;
+	packColor(COLOR, in.rgba);
+}
+
+#if defined(SW_WIDE8)
+DEATH_ENABLE_AVX2 void DefaultSprite_Fragment8(const nCine::RHI::Software::FragmentShaderInput8& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const DefaultSprite_Uniforms* unis = static_cast<const DefaultSprite_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	COLOR = swTexturePrimary(in, 0) * COLOR;
+	packColor(COLOR, in.rgba);
+}
+#endif
+
+		// --- DefaultBatchedSprites ---
+struct DefaultBatchedSprites_Uniforms
+{
+};
+
+void DefaultBatchedSprites_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	const DefaultBatchedSprites_Uniforms* unis = static_cast<const DefaultBatchedSprites_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	COLOR = swTexturePrimary(in, 0) * COLOR;
+	packColor(COLOR, in.rgba);
+}
+
+void DefaultBatchedSprites_Fragment4(const nCine::RHI::Software::FragmentShaderInput4& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const DefaultBatchedSprites_Uniforms* unis = static_cast<const DefaultBatchedSprites_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	COLOR = swTexturePrimary(in, 0) * COLOR;
+	packColor(COLOR, in.rgba);
+}
+
+#if defined(SW_WIDE8)
+DEATH_ENABLE_AVX2 void DefaultBatchedSprites_Fragment8(const nCine::RHI::Software::FragmentShaderInput8& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const DefaultBatchedSprites_Uniforms* unis = static_cast<const DefaultBatchedSprites_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	COLOR = swTexturePrimary(in, 0) * COLOR;
+	packColor(COLOR, in.rgba);
+}
+#endif
+
+		// --- DefaultSpriteNoTexture ---
+struct DefaultSpriteNoTexture_Uniforms
+{
+};
+
+void DefaultSpriteNoTexture_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	const DefaultSpriteNoTexture_Uniforms* unis = static_cast<const DefaultSpriteNoTexture_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	packColor(COLOR, in.rgba);
+}
+
+void DefaultSpriteNoTexture_Fragment4(const nCine::RHI::Software::FragmentShaderInput4& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const DefaultSpriteNoTexture_Uniforms* unis = static_cast<const DefaultSpriteNoTexture_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	packColor(COLOR, in.rgba);
+}
+
+#if defined(SW_WIDE8)
+DEATH_ENABLE_AVX2 void DefaultSpriteNoTexture_Fragment8(const nCine::RHI::Software::FragmentShaderInput8& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const DefaultSpriteNoTexture_Uniforms* unis = static_cast<const DefaultSpriteNoTexture_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	packColor(COLOR, in.rgba);
+}
+#endif
+
+		// --- Downsample ---
+struct Downsample_Uniforms
+{
+	nCine::RHI::Software::sw::vec2 uPixelOffset;
+};
+
+void Downsample_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	const Downsample_Uniforms* unis = static_cast<const Downsample_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vec4 COLOR;
+	vec4 color = swTexturePrimary(in, 0);
+	color += swTexture(in, 0, vec2(in.u, in.v) + vec2(0.0f, unis->uPixelOffset.y));
+	color += swTexture(in, 0, vec2(in.u, in.v) + vec2(unis->uPixelOffset.x, 0.0f));
+	color += swTexture(in, 0, vec2(in.u, in.v) + unis->uPixelOffset);
+	COLOR = vec4(0.25f) * color;
+	packColor(COLOR, in.rgba);
+}
+
+void Downsample_Fragment4(const nCine::RHI::Software::FragmentShaderInput4& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const Downsample_Uniforms* unis = static_cast<const Downsample_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	vvec4 color = swTexturePrimary(in, 0);
+	color += swTexture(in, 0, swTexCoords(in) + vec2(0.0f, unis->uPixelOffset.y));
+	color += swTexture(in, 0, swTexCoords(in) + vec2(unis->uPixelOffset.x, 0.0f));
+	color += swTexture(in, 0, swTexCoords(in) + unis->uPixelOffset);
+	COLOR = vec4(0.25f) * color;
+	packColor(COLOR, in.rgba);
+}
+
+#if defined(SW_WIDE8)
+DEATH_ENABLE_AVX2 void Downsample_Fragment8(const nCine::RHI::Software::FragmentShaderInput8& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const Downsample_Uniforms* unis = static_cast<const Downsample_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	vvec4 color = swTexturePrimary(in, 0);
+	color += swTexture(in, 0, swTexCoords(in) + vec2(0.0f, unis->uPixelOffset.y));
+	color += swTexture(in, 0, swTexCoords(in) + vec2(unis->uPixelOffset.x, 0.0f));
+	color += swTexture(in, 0, swTexCoords(in) + unis->uPixelOffset);
+	COLOR = vec4(0.25f) * color;
+	packColor(COLOR, in.rgba);
+}
+#endif
+
+		// --- FrozenMask ---
+struct FrozenMask_Uniforms
+{
+};
+
+static float FrozenMask_aastep(const nCine::RHI::Software::FragmentShaderInput& in, float threshold, float value)
+{
+	using namespace nCine::RHI::Software::sw;
+	const FrozenMask_Uniforms* unis = static_cast<const FrozenMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	float afwidth = length(vec2(dFdx(value), dFdy(value))) * 0.70710678118654757f;
+	return smoothstep(threshold - afwidth, threshold + afwidth, value);
+}
+
+static nCine::RHI::Software::sw::vec4 FrozenMask_maskSample(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 uv)
+{
+	using namespace nCine::RHI::Software::sw;
+	const FrozenMask_Uniforms* unis = static_cast<const FrozenMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vec4 src = swTexture(in, 0, uv);
+	return src;
+}
+
+void FrozenMask_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	const FrozenMask_Uniforms* unis = static_cast<const FrozenMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vec2 size = COLOR.xy() * COLOR.a * 2.0f;
+	vec4 tex = FrozenMask_maskSample(in, vec2(in.u, in.v));
+	vec4 tex1 = FrozenMask_maskSample(in, vec2(in.u, in.v) + vec2(-size.x, 0));
+	vec4 tex2 = FrozenMask_maskSample(in, vec2(in.u, in.v) + vec2(0, size.y));
+	vec4 tex3 = FrozenMask_maskSample(in, vec2(in.u, in.v) + vec2(size.x, 0));
+	vec4 tex4 = FrozenMask_maskSample(in, vec2(in.u, in.v) + vec2(0, -size.y));
+	float outline = tex1.a;
+	outline += tex2.a;
+	outline += tex3.a;
+	outline += tex4.a;
+	outline += FrozenMask_maskSample(in, vec2(in.u, in.v) + vec2(-size.x, size.y)).a;
+	outline += FrozenMask_maskSample(in, vec2(in.u, in.v) + vec2(size.x, size.y)).a;
+	outline += FrozenMask_maskSample(in, vec2(in.u, in.v) + vec2(-size.x, -size.y)).a;
+	outline += FrozenMask_maskSample(in, vec2(in.u, in.v) + vec2(size.x, -size.y)).a;
+	outline = FrozenMask_aastep(in, 1.0f, outline);
+	vec4 color = (tex + tex + tex1 + tex2 + tex3 + tex4) / 6.0f;
+	float grey = min((0.299f * color.r + 0.587f * color.g + 0.114f * color.b) * 2.6f, 1.0f);
+	COLOR = mix(tex, vec4(0.2f * grey, 0.2f + grey * 0.62f, 0.6f + 0.2f * grey, outline * 0.95f), COLOR.a);
+	packColor(COLOR, in.rgba);
+}
+
+static nCine::RHI::Software::sw::wide4::vfloat FrozenMask_aastep4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vfloat threshold, nCine::RHI::Software::sw::wide4::vfloat value)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const FrozenMask_Uniforms* unis = static_cast<const FrozenMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vfloat afwidth = length(vvec2(dFdx(value), dFdy(value))) * 0.70710678118654757f;
+	return smoothstep(threshold - afwidth, threshold + afwidth, value);
+}
+
+static nCine::RHI::Software::sw::wide4::vvec4 FrozenMask_maskSample4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec2 uv)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const FrozenMask_Uniforms* unis = static_cast<const FrozenMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 src = swTexture(in, 0, uv);
+	return src;
+}
+
+void FrozenMask_Fragment4(const nCine::RHI::Software::FragmentShaderInput4& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const FrozenMask_Uniforms* unis = static_cast<const FrozenMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vvec2 size = COLOR.xy() * COLOR.w * 2.0f;
+	vvec4 tex = FrozenMask_maskSample4(in, swTexCoords(in));
+	vvec4 tex1 = FrozenMask_maskSample4(in, swTexCoords(in) + vvec2(-size.x, 0));
+	vvec4 tex2 = FrozenMask_maskSample4(in, swTexCoords(in) + vvec2(0, size.y));
+	vvec4 tex3 = FrozenMask_maskSample4(in, swTexCoords(in) + vvec2(size.x, 0));
+	vvec4 tex4 = FrozenMask_maskSample4(in, swTexCoords(in) + vvec2(0, -size.y));
+	vfloat outline = tex1.w;
+	outline += tex2.w;
+	outline += tex3.w;
+	outline += tex4.w;
+	outline += FrozenMask_maskSample4(in, swTexCoords(in) + vvec2(-size.x, size.y)).w;
+	outline += FrozenMask_maskSample4(in, swTexCoords(in) + vvec2(size.x, size.y)).w;
+	outline += FrozenMask_maskSample4(in, swTexCoords(in) + vvec2(-size.x, -size.y)).w;
+	outline += FrozenMask_maskSample4(in, swTexCoords(in) + vvec2(size.x, -size.y)).w;
+	outline = FrozenMask_aastep4(in, 1.0f, outline);
+	vvec4 color = (tex + tex + tex1 + tex2 + tex3 + tex4) / 6.0f;
+	vfloat grey = min((0.299f * color.x + 0.587f * color.y + 0.114f * color.z) * 2.6f, 1.0f);
+	COLOR = mix(tex, vvec4(0.2f * grey, 0.2f + grey * 0.62f, 0.6f + 0.2f * grey, outline * 0.95f), COLOR.w);
+	packColor(COLOR, in.rgba);
+}
+
+#if defined(SW_WIDE8)
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vfloat FrozenMask_aastep8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vfloat threshold, nCine::RHI::Software::sw::wide8::vfloat value)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const FrozenMask_Uniforms* unis = static_cast<const FrozenMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vfloat afwidth = length(vvec2(dFdx(value), dFdy(value))) * 0.70710678118654757f;
+	return smoothstep(threshold - afwidth, threshold + afwidth, value);
+}
+
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vvec4 FrozenMask_maskSample8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec2 uv)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const FrozenMask_Uniforms* unis = static_cast<const FrozenMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 src = swTexture(in, 0, uv);
+	return src;
+}
+
+DEATH_ENABLE_AVX2 void FrozenMask_Fragment8(const nCine::RHI::Software::FragmentShaderInput8& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const FrozenMask_Uniforms* unis = static_cast<const FrozenMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vvec2 size = COLOR.xy() * COLOR.w * 2.0f;
+	vvec4 tex = FrozenMask_maskSample8(in, swTexCoords(in));
+	vvec4 tex1 = FrozenMask_maskSample8(in, swTexCoords(in) + vvec2(-size.x, 0));
+	vvec4 tex2 = FrozenMask_maskSample8(in, swTexCoords(in) + vvec2(0, size.y));
+	vvec4 tex3 = FrozenMask_maskSample8(in, swTexCoords(in) + vvec2(size.x, 0));
+	vvec4 tex4 = FrozenMask_maskSample8(in, swTexCoords(in) + vvec2(0, -size.y));
+	vfloat outline = tex1.w;
+	outline += tex2.w;
+	outline += tex3.w;
+	outline += tex4.w;
+	outline += FrozenMask_maskSample8(in, swTexCoords(in) + vvec2(-size.x, size.y)).w;
+	outline += FrozenMask_maskSample8(in, swTexCoords(in) + vvec2(size.x, size.y)).w;
+	outline += FrozenMask_maskSample8(in, swTexCoords(in) + vvec2(-size.x, -size.y)).w;
+	outline += FrozenMask_maskSample8(in, swTexCoords(in) + vvec2(size.x, -size.y)).w;
+	outline = FrozenMask_aastep8(in, 1.0f, outline);
+	vvec4 color = (tex + tex + tex1 + tex2 + tex3 + tex4) / 6.0f;
+	vfloat grey = min((0.299f * color.x + 0.587f * color.y + 0.114f * color.z) * 2.6f, 1.0f);
+	COLOR = mix(tex, vvec4(0.2f * grey, 0.2f + grey * 0.62f, 0.6f + 0.2f * grey, outline * 0.95f), COLOR.w);
+	packColor(COLOR, in.rgba);
+}
+#endif
+
+		// --- FrozenMask_USE_PALETTE ---
+struct FrozenMask_USE_PALETTE_Uniforms
+{
+	float vPaletteOffset;
+};
+
+void FrozenMask_USE_PALETTE_ComputeVaryings(void* inputs, const std::uint8_t* instanceBlock)
+{
+	using namespace nCine::RHI::Software::sw;
+	FrozenMask_USE_PALETTE_Uniforms* io = static_cast<FrozenMask_USE_PALETTE_Uniforms*>(inputs);
+	(void)io;
+	(void)instanceBlock;
+	io->vPaletteOffset = (*reinterpret_cast<const float*>(instanceBlock + 104));
+}
+
+static float FrozenMask_USE_PALETTE_aastep(const nCine::RHI::Software::FragmentShaderInput& in, float threshold, float value)
+{
+	using namespace nCine::RHI::Software::sw;
+	const FrozenMask_USE_PALETTE_Uniforms* unis = static_cast<const FrozenMask_USE_PALETTE_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	float afwidth = length(vec2(dFdx(value), dFdy(value))) * 0.70710678118654757f;
+	return smoothstep(threshold - afwidth, threshold + afwidth, value);
+}
+
+static nCine::RHI::Software::sw::vec4 FrozenMask_USE_PALETTE_maskSample(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 uv)
+{
+	using namespace nCine::RHI::Software::sw;
+	const FrozenMask_USE_PALETTE_Uniforms* unis = static_cast<const FrozenMask_USE_PALETTE_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vec4 src = swTexture(in, 0, uv);
+	float palIndex = floor(unis->vPaletteOffset + 0.5f) + floor(src.r * 255.0f + 0.5f);
+	float palX = (mod(palIndex, 256.0f) + 0.5f) / 256.0f;
+	float palY = (floor(palIndex / 256.0f) + 0.5f) / 256.0f;
+	vec4 c = swTexture(in, 1, vec2(palX, palY));
+	return vec4(c.xyz(), c.a * src.a);
+}
+
+void FrozenMask_USE_PALETTE_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	const FrozenMask_USE_PALETTE_Uniforms* unis = static_cast<const FrozenMask_USE_PALETTE_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vec2 size = COLOR.xy() * COLOR.a * 2.0f;
+	vec4 tex = FrozenMask_USE_PALETTE_maskSample(in, vec2(in.u, in.v));
+	vec4 tex1 = FrozenMask_USE_PALETTE_maskSample(in, vec2(in.u, in.v) + vec2(-size.x, 0));
+	vec4 tex2 = FrozenMask_USE_PALETTE_maskSample(in, vec2(in.u, in.v) + vec2(0, size.y));
+	vec4 tex3 = FrozenMask_USE_PALETTE_maskSample(in, vec2(in.u, in.v) + vec2(size.x, 0));
+	vec4 tex4 = FrozenMask_USE_PALETTE_maskSample(in, vec2(in.u, in.v) + vec2(0, -size.y));
+	float outline = tex1.a;
+	outline += tex2.a;
+	outline += tex3.a;
+	outline += tex4.a;
+	outline += FrozenMask_USE_PALETTE_maskSample(in, vec2(in.u, in.v) + vec2(-size.x, size.y)).a;
+	outline += FrozenMask_USE_PALETTE_maskSample(in, vec2(in.u, in.v) + vec2(size.x, size.y)).a;
+	outline += FrozenMask_USE_PALETTE_maskSample(in, vec2(in.u, in.v) + vec2(-size.x, -size.y)).a;
+	outline += FrozenMask_USE_PALETTE_maskSample(in, vec2(in.u, in.v) + vec2(size.x, -size.y)).a;
+	outline = FrozenMask_USE_PALETTE_aastep(in, 1.0f, outline);
+	vec4 color = (tex + tex + tex1 + tex2 + tex3 + tex4) / 6.0f;
+	float grey = min((0.299f * color.r + 0.587f * color.g + 0.114f * color.b) * 2.6f, 1.0f);
+	COLOR = mix(tex, vec4(0.2f * grey, 0.2f + grey * 0.62f, 0.6f + 0.2f * grey, outline * 0.95f), COLOR.a);
+	packColor(COLOR, in.rgba);
+}
+
+static nCine::RHI::Software::sw::wide4::vfloat FrozenMask_USE_PALETTE_aastep4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vfloat threshold, nCine::RHI::Software::sw::wide4::vfloat value)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const FrozenMask_USE_PALETTE_Uniforms* unis = static_cast<const FrozenMask_USE_PALETTE_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vfloat afwidth = length(vvec2(dFdx(value), dFdy(value))) * 0.70710678118654757f;
+	return smoothstep(threshold - afwidth, threshold + afwidth, value);
+}
+
+static nCine::RHI::Software::sw::wide4::vvec4 FrozenMask_USE_PALETTE_maskSample4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec2 uv)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const FrozenMask_USE_PALETTE_Uniforms* unis = static_cast<const FrozenMask_USE_PALETTE_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 src = swTexture(in, 0, uv);
+	vfloat palIndex = floor(unis->vPaletteOffset + 0.5f) + floor(src.x * 255.0f + 0.5f);
+	vfloat palX = (mod(palIndex, 256.0f) + 0.5f) / 256.0f;
+	vfloat palY = (floor(palIndex / 256.0f) + 0.5f) / 256.0f;
+	vvec4 c = swTexture(in, 1, vvec2(palX, palY));
+	return vvec4(c.xyz(), c.w * src.w);
+}
+
+void FrozenMask_USE_PALETTE_Fragment4(const nCine::RHI::Software::FragmentShaderInput4& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const FrozenMask_USE_PALETTE_Uniforms* unis = static_cast<const FrozenMask_USE_PALETTE_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vvec2 size = COLOR.xy() * COLOR.w * 2.0f;
+	vvec4 tex = FrozenMask_USE_PALETTE_maskSample4(in, swTexCoords(in));
+	vvec4 tex1 = FrozenMask_USE_PALETTE_maskSample4(in, swTexCoords(in) + vvec2(-size.x, 0));
+	vvec4 tex2 = FrozenMask_USE_PALETTE_maskSample4(in, swTexCoords(in) + vvec2(0, size.y));
+	vvec4 tex3 = FrozenMask_USE_PALETTE_maskSample4(in, swTexCoords(in) + vvec2(size.x, 0));
+	vvec4 tex4 = FrozenMask_USE_PALETTE_maskSample4(in, swTexCoords(in) + vvec2(0, -size.y));
+	vfloat outline = tex1.w;
+	outline += tex2.w;
+	outline += tex3.w;
+	outline += tex4.w;
+	outline += FrozenMask_USE_PALETTE_maskSample4(in, swTexCoords(in) + vvec2(-size.x, size.y)).w;
+	outline += FrozenMask_USE_PALETTE_maskSample4(in, swTexCoords(in) + vvec2(size.x, size.y)).w;
+	outline += FrozenMask_USE_PALETTE_maskSample4(in, swTexCoords(in) + vvec2(-size.x, -size.y)).w;
+	outline += FrozenMask_USE_PALETTE_maskSample4(in, swTexCoords(in) + vvec2(size.x, -size.y)).w;
+	outline = FrozenMask_USE_PALETTE_aastep4(in, 1.0f, outline);
+	vvec4 color = (tex + tex + tex1 + tex2 + tex3 + tex4) / 6.0f;
+	vfloat grey = min((0.299f * color.x + 0.587f * color.y + 0.114f * color.z) * 2.6f, 1.0f);
+	COLOR = mix(tex, vvec4(0.2f * grey, 0.2f + grey * 0.62f, 0.6f + 0.2f * grey, outline * 0.95f), COLOR.w);
+	packColor(COLOR, in.rgba);
+}
+
+#if defined(SW_WIDE8)
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vfloat FrozenMask_USE_PALETTE_aastep8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vfloat threshold, nCine::RHI::Software::sw::wide8::vfloat value)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const FrozenMask_USE_PALETTE_Uniforms* unis = static_cast<const FrozenMask_USE_PALETTE_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vfloat afwidth = length(vvec2(dFdx(value), dFdy(value))) * 0.70710678118654757f;
+	return smoothstep(threshold - afwidth, threshold + afwidth, value);
+}
+
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vvec4 FrozenMask_USE_PALETTE_maskSample8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec2 uv)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const FrozenMask_USE_PALETTE_Uniforms* unis = static_cast<const FrozenMask_USE_PALETTE_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 src = swTexture(in, 0, uv);
+	vfloat palIndex = floor(unis->vPaletteOffset + 0.5f) + floor(src.x * 255.0f + 0.5f);
+	vfloat palX = (mod(palIndex, 256.0f) + 0.5f) / 256.0f;
+	vfloat palY = (floor(palIndex / 256.0f) + 0.5f) / 256.0f;
+	vvec4 c = swTexture(in, 1, vvec2(palX, palY));
+	return vvec4(c.xyz(), c.w * src.w);
+}
+
+DEATH_ENABLE_AVX2 void FrozenMask_USE_PALETTE_Fragment8(const nCine::RHI::Software::FragmentShaderInput8& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const FrozenMask_USE_PALETTE_Uniforms* unis = static_cast<const FrozenMask_USE_PALETTE_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vvec2 size = COLOR.xy() * COLOR.w * 2.0f;
+	vvec4 tex = FrozenMask_USE_PALETTE_maskSample8(in, swTexCoords(in));
+	vvec4 tex1 = FrozenMask_USE_PALETTE_maskSample8(in, swTexCoords(in) + vvec2(-size.x, 0));
+	vvec4 tex2 = FrozenMask_USE_PALETTE_maskSample8(in, swTexCoords(in) + vvec2(0, size.y));
+	vvec4 tex3 = FrozenMask_USE_PALETTE_maskSample8(in, swTexCoords(in) + vvec2(size.x, 0));
+	vvec4 tex4 = FrozenMask_USE_PALETTE_maskSample8(in, swTexCoords(in) + vvec2(0, -size.y));
+	vfloat outline = tex1.w;
+	outline += tex2.w;
+	outline += tex3.w;
+	outline += tex4.w;
+	outline += FrozenMask_USE_PALETTE_maskSample8(in, swTexCoords(in) + vvec2(-size.x, size.y)).w;
+	outline += FrozenMask_USE_PALETTE_maskSample8(in, swTexCoords(in) + vvec2(size.x, size.y)).w;
+	outline += FrozenMask_USE_PALETTE_maskSample8(in, swTexCoords(in) + vvec2(-size.x, -size.y)).w;
+	outline += FrozenMask_USE_PALETTE_maskSample8(in, swTexCoords(in) + vvec2(size.x, -size.y)).w;
+	outline = FrozenMask_USE_PALETTE_aastep8(in, 1.0f, outline);
+	vvec4 color = (tex + tex + tex1 + tex2 + tex3 + tex4) / 6.0f;
+	vfloat grey = min((0.299f * color.x + 0.587f * color.y + 0.114f * color.z) * 2.6f, 1.0f);
+	COLOR = mix(tex, vvec4(0.2f * grey, 0.2f + grey * 0.62f, 0.6f + 0.2f * grey, outline * 0.95f), COLOR.w);
+	packColor(COLOR, in.rgba);
+}
+#endif
+
+		// --- BatchedFrozenMask ---
+struct BatchedFrozenMask_Uniforms
+{
+};
+
+static float BatchedFrozenMask_aastep(const nCine::RHI::Software::FragmentShaderInput& in, float threshold, float value)
+{
+	using namespace nCine::RHI::Software::sw;
+	const BatchedFrozenMask_Uniforms* unis = static_cast<const BatchedFrozenMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	float afwidth = length(vec2(dFdx(value), dFdy(value))) * 0.70710678118654757f;
+	return smoothstep(threshold - afwidth, threshold + afwidth, value);
+}
+
+static nCine::RHI::Software::sw::vec4 BatchedFrozenMask_maskSample(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 uv)
+{
+	using namespace nCine::RHI::Software::sw;
+	const BatchedFrozenMask_Uniforms* unis = static_cast<const BatchedFrozenMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vec4 src = swTexture(in, 0, uv);
+	return src;
+}
+
+void BatchedFrozenMask_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	const BatchedFrozenMask_Uniforms* unis = static_cast<const BatchedFrozenMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vec2 size = COLOR.xy() * COLOR.a * 2.0f;
+	vec4 tex = BatchedFrozenMask_maskSample(in, vec2(in.u, in.v));
+	vec4 tex1 = BatchedFrozenMask_maskSample(in, vec2(in.u, in.v) + vec2(-size.x, 0));
+	vec4 tex2 = BatchedFrozenMask_maskSample(in, vec2(in.u, in.v) + vec2(0, size.y));
+	vec4 tex3 = BatchedFrozenMask_maskSample(in, vec2(in.u, in.v) + vec2(size.x, 0));
+	vec4 tex4 = BatchedFrozenMask_maskSample(in, vec2(in.u, in.v) + vec2(0, -size.y));
+	float outline = tex1.a;
+	outline += tex2.a;
+	outline += tex3.a;
+	outline += tex4.a;
+	outline += BatchedFrozenMask_maskSample(in, vec2(in.u, in.v) + vec2(-size.x, size.y)).a;
+	outline += BatchedFrozenMask_maskSample(in, vec2(in.u, in.v) + vec2(size.x, size.y)).a;
+	outline += BatchedFrozenMask_maskSample(in, vec2(in.u, in.v) + vec2(-size.x, -size.y)).a;
+	outline += BatchedFrozenMask_maskSample(in, vec2(in.u, in.v) + vec2(size.x, -size.y)).a;
+	outline = BatchedFrozenMask_aastep(in, 1.0f, outline);
+	vec4 color = (tex + tex + tex1 + tex2 + tex3 + tex4) / 6.0f;
+	float grey = min((0.299f * color.r + 0.587f * color.g + 0.114f * color.b) * 2.6f, 1.0f);
+	COLOR = mix(tex, vec4(0.2f * grey, 0.2f + grey * 0.62f, 0.6f + 0.2f * grey, outline * 0.95f), COLOR.a);
+	packColor(COLOR, in.rgba);
+}
+
+static nCine::RHI::Software::sw::wide4::vfloat BatchedFrozenMask_aastep4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vfloat threshold, nCine::RHI::Software::sw::wide4::vfloat value)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const BatchedFrozenMask_Uniforms* unis = static_cast<const BatchedFrozenMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vfloat afwidth = length(vvec2(dFdx(value), dFdy(value))) * 0.70710678118654757f;
+	return smoothstep(threshold - afwidth, threshold + afwidth, value);
+}
+
+static nCine::RHI::Software::sw::wide4::vvec4 BatchedFrozenMask_maskSample4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec2 uv)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const BatchedFrozenMask_Uniforms* unis = static_cast<const BatchedFrozenMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 src = swTexture(in, 0, uv);
+	return src;
+}
+
+void BatchedFrozenMask_Fragment4(const nCine::RHI::Software::FragmentShaderInput4& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const BatchedFrozenMask_Uniforms* unis = static_cast<const BatchedFrozenMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vvec2 size = COLOR.xy() * COLOR.w * 2.0f;
+	vvec4 tex = BatchedFrozenMask_maskSample4(in, swTexCoords(in));
+	vvec4 tex1 = BatchedFrozenMask_maskSample4(in, swTexCoords(in) + vvec2(-size.x, 0));
+	vvec4 tex2 = BatchedFrozenMask_maskSample4(in, swTexCoords(in) + vvec2(0, size.y));
+	vvec4 tex3 = BatchedFrozenMask_maskSample4(in, swTexCoords(in) + vvec2(size.x, 0));
+	vvec4 tex4 = BatchedFrozenMask_maskSample4(in, swTexCoords(in) + vvec2(0, -size.y));
+	vfloat outline = tex1.w;
+	outline += tex2.w;
+	outline += tex3.w;
+	outline += tex4.w;
+	outline += BatchedFrozenMask_maskSample4(in, swTexCoords(in) + vvec2(-size.x, size.y)).w;
+	outline += BatchedFrozenMask_maskSample4(in, swTexCoords(in) + vvec2(size.x, size.y)).w;
+	outline += BatchedFrozenMask_maskSample4(in, swTexCoords(in) + vvec2(-size.x, -size.y)).w;
+	outline += BatchedFrozenMask_maskSample4(in, swTexCoords(in) + vvec2(size.x, -size.y)).w;
+	outline = BatchedFrozenMask_aastep4(in, 1.0f, outline);
+	vvec4 color = (tex + tex + tex1 + tex2 + tex3 + tex4) / 6.0f;
+	vfloat grey = min((0.299f * color.x + 0.587f * color.y + 0.114f * color.z) * 2.6f, 1.0f);
+	COLOR = mix(tex, vvec4(0.2f * grey, 0.2f + grey * 0.62f, 0.6f + 0.2f * grey, outline * 0.95f), COLOR.w);
+	packColor(COLOR, in.rgba);
+}
+
+#if defined(SW_WIDE8)
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vfloat BatchedFrozenMask_aastep8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vfloat threshold, nCine::RHI::Software::sw::wide8::vfloat value)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const BatchedFrozenMask_Uniforms* unis = static_cast<const BatchedFrozenMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vfloat afwidth = length(vvec2(dFdx(value), dFdy(value))) * 0.70710678118654757f;
+	return smoothstep(threshold - afwidth, threshold + afwidth, value);
+}
+
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vvec4 BatchedFrozenMask_maskSample8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec2 uv)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const BatchedFrozenMask_Uniforms* unis = static_cast<const BatchedFrozenMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 src = swTexture(in, 0, uv);
+	return src;
+}
+
+DEATH_ENABLE_AVX2 void BatchedFrozenMask_Fragment8(const nCine::RHI::Software::FragmentShaderInput8& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const BatchedFrozenMask_Uniforms* unis = static_cast<const BatchedFrozenMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vvec2 size = COLOR.xy() * COLOR.w * 2.0f;
+	vvec4 tex = BatchedFrozenMask_maskSample8(in, swTexCoords(in));
+	vvec4 tex1 = BatchedFrozenMask_maskSample8(in, swTexCoords(in) + vvec2(-size.x, 0));
+	vvec4 tex2 = BatchedFrozenMask_maskSample8(in, swTexCoords(in) + vvec2(0, size.y));
+	vvec4 tex3 = BatchedFrozenMask_maskSample8(in, swTexCoords(in) + vvec2(size.x, 0));
+	vvec4 tex4 = BatchedFrozenMask_maskSample8(in, swTexCoords(in) + vvec2(0, -size.y));
+	vfloat outline = tex1.w;
+	outline += tex2.w;
+	outline += tex3.w;
+	outline += tex4.w;
+	outline += BatchedFrozenMask_maskSample8(in, swTexCoords(in) + vvec2(-size.x, size.y)).w;
+	outline += BatchedFrozenMask_maskSample8(in, swTexCoords(in) + vvec2(size.x, size.y)).w;
+	outline += BatchedFrozenMask_maskSample8(in, swTexCoords(in) + vvec2(-size.x, -size.y)).w;
+	outline += BatchedFrozenMask_maskSample8(in, swTexCoords(in) + vvec2(size.x, -size.y)).w;
+	outline = BatchedFrozenMask_aastep8(in, 1.0f, outline);
+	vvec4 color = (tex + tex + tex1 + tex2 + tex3 + tex4) / 6.0f;
+	vfloat grey = min((0.299f * color.x + 0.587f * color.y + 0.114f * color.z) * 2.6f, 1.0f);
+	COLOR = mix(tex, vvec4(0.2f * grey, 0.2f + grey * 0.62f, 0.6f + 0.2f * grey, outline * 0.95f), COLOR.w);
+	packColor(COLOR, in.rgba);
+}
+#endif
+
+		// --- BatchedFrozenMask_USE_PALETTE ---
+struct BatchedFrozenMask_USE_PALETTE_Uniforms
+{
+	float vPaletteOffset;
+};
+
+void BatchedFrozenMask_USE_PALETTE_ComputeVaryings(void* inputs, const std::uint8_t* instanceBlock)
+{
+	using namespace nCine::RHI::Software::sw;
+	BatchedFrozenMask_USE_PALETTE_Uniforms* io = static_cast<BatchedFrozenMask_USE_PALETTE_Uniforms*>(inputs);
+	(void)io;
+	(void)instanceBlock;
+	io->vPaletteOffset = (*reinterpret_cast<const float*>(instanceBlock + 104));
+}
+
+static float BatchedFrozenMask_USE_PALETTE_aastep(const nCine::RHI::Software::FragmentShaderInput& in, float threshold, float value)
+{
+	using namespace nCine::RHI::Software::sw;
+	const BatchedFrozenMask_USE_PALETTE_Uniforms* unis = static_cast<const BatchedFrozenMask_USE_PALETTE_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	float afwidth = length(vec2(dFdx(value), dFdy(value))) * 0.70710678118654757f;
+	return smoothstep(threshold - afwidth, threshold + afwidth, value);
+}
+
+static nCine::RHI::Software::sw::vec4 BatchedFrozenMask_USE_PALETTE_maskSample(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 uv)
+{
+	using namespace nCine::RHI::Software::sw;
+	const BatchedFrozenMask_USE_PALETTE_Uniforms* unis = static_cast<const BatchedFrozenMask_USE_PALETTE_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vec4 src = swTexture(in, 0, uv);
+	float palIndex = floor(unis->vPaletteOffset + 0.5f) + floor(src.r * 255.0f + 0.5f);
+	float palX = (mod(palIndex, 256.0f) + 0.5f) / 256.0f;
+	float palY = (floor(palIndex / 256.0f) + 0.5f) / 256.0f;
+	vec4 c = swTexture(in, 1, vec2(palX, palY));
+	return vec4(c.xyz(), c.a * src.a);
+}
+
+void BatchedFrozenMask_USE_PALETTE_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	const BatchedFrozenMask_USE_PALETTE_Uniforms* unis = static_cast<const BatchedFrozenMask_USE_PALETTE_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vec2 size = COLOR.xy() * COLOR.a * 2.0f;
+	vec4 tex = BatchedFrozenMask_USE_PALETTE_maskSample(in, vec2(in.u, in.v));
+	vec4 tex1 = BatchedFrozenMask_USE_PALETTE_maskSample(in, vec2(in.u, in.v) + vec2(-size.x, 0));
+	vec4 tex2 = BatchedFrozenMask_USE_PALETTE_maskSample(in, vec2(in.u, in.v) + vec2(0, size.y));
+	vec4 tex3 = BatchedFrozenMask_USE_PALETTE_maskSample(in, vec2(in.u, in.v) + vec2(size.x, 0));
+	vec4 tex4 = BatchedFrozenMask_USE_PALETTE_maskSample(in, vec2(in.u, in.v) + vec2(0, -size.y));
+	float outline = tex1.a;
+	outline += tex2.a;
+	outline += tex3.a;
+	outline += tex4.a;
+	outline += BatchedFrozenMask_USE_PALETTE_maskSample(in, vec2(in.u, in.v) + vec2(-size.x, size.y)).a;
+	outline += BatchedFrozenMask_USE_PALETTE_maskSample(in, vec2(in.u, in.v) + vec2(size.x, size.y)).a;
+	outline += BatchedFrozenMask_USE_PALETTE_maskSample(in, vec2(in.u, in.v) + vec2(-size.x, -size.y)).a;
+	outline += BatchedFrozenMask_USE_PALETTE_maskSample(in, vec2(in.u, in.v) + vec2(size.x, -size.y)).a;
+	outline = BatchedFrozenMask_USE_PALETTE_aastep(in, 1.0f, outline);
+	vec4 color = (tex + tex + tex1 + tex2 + tex3 + tex4) / 6.0f;
+	float grey = min((0.299f * color.r + 0.587f * color.g + 0.114f * color.b) * 2.6f, 1.0f);
+	COLOR = mix(tex, vec4(0.2f * grey, 0.2f + grey * 0.62f, 0.6f + 0.2f * grey, outline * 0.95f), COLOR.a);
+	packColor(COLOR, in.rgba);
+}
+
+static nCine::RHI::Software::sw::wide4::vfloat BatchedFrozenMask_USE_PALETTE_aastep4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vfloat threshold, nCine::RHI::Software::sw::wide4::vfloat value)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const BatchedFrozenMask_USE_PALETTE_Uniforms* unis = static_cast<const BatchedFrozenMask_USE_PALETTE_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vfloat afwidth = length(vvec2(dFdx(value), dFdy(value))) * 0.70710678118654757f;
+	return smoothstep(threshold - afwidth, threshold + afwidth, value);
+}
+
+static nCine::RHI::Software::sw::wide4::vvec4 BatchedFrozenMask_USE_PALETTE_maskSample4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec2 uv)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const BatchedFrozenMask_USE_PALETTE_Uniforms* unis = static_cast<const BatchedFrozenMask_USE_PALETTE_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 src = swTexture(in, 0, uv);
+	vfloat palIndex = floor(unis->vPaletteOffset + 0.5f) + floor(src.x * 255.0f + 0.5f);
+	vfloat palX = (mod(palIndex, 256.0f) + 0.5f) / 256.0f;
+	vfloat palY = (floor(palIndex / 256.0f) + 0.5f) / 256.0f;
+	vvec4 c = swTexture(in, 1, vvec2(palX, palY));
+	return vvec4(c.xyz(), c.w * src.w);
+}
+
+void BatchedFrozenMask_USE_PALETTE_Fragment4(const nCine::RHI::Software::FragmentShaderInput4& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const BatchedFrozenMask_USE_PALETTE_Uniforms* unis = static_cast<const BatchedFrozenMask_USE_PALETTE_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vvec2 size = COLOR.xy() * COLOR.w * 2.0f;
+	vvec4 tex = BatchedFrozenMask_USE_PALETTE_maskSample4(in, swTexCoords(in));
+	vvec4 tex1 = BatchedFrozenMask_USE_PALETTE_maskSample4(in, swTexCoords(in) + vvec2(-size.x, 0));
+	vvec4 tex2 = BatchedFrozenMask_USE_PALETTE_maskSample4(in, swTexCoords(in) + vvec2(0, size.y));
+	vvec4 tex3 = BatchedFrozenMask_USE_PALETTE_maskSample4(in, swTexCoords(in) + vvec2(size.x, 0));
+	vvec4 tex4 = BatchedFrozenMask_USE_PALETTE_maskSample4(in, swTexCoords(in) + vvec2(0, -size.y));
+	vfloat outline = tex1.w;
+	outline += tex2.w;
+	outline += tex3.w;
+	outline += tex4.w;
+	outline += BatchedFrozenMask_USE_PALETTE_maskSample4(in, swTexCoords(in) + vvec2(-size.x, size.y)).w;
+	outline += BatchedFrozenMask_USE_PALETTE_maskSample4(in, swTexCoords(in) + vvec2(size.x, size.y)).w;
+	outline += BatchedFrozenMask_USE_PALETTE_maskSample4(in, swTexCoords(in) + vvec2(-size.x, -size.y)).w;
+	outline += BatchedFrozenMask_USE_PALETTE_maskSample4(in, swTexCoords(in) + vvec2(size.x, -size.y)).w;
+	outline = BatchedFrozenMask_USE_PALETTE_aastep4(in, 1.0f, outline);
+	vvec4 color = (tex + tex + tex1 + tex2 + tex3 + tex4) / 6.0f;
+	vfloat grey = min((0.299f * color.x + 0.587f * color.y + 0.114f * color.z) * 2.6f, 1.0f);
+	COLOR = mix(tex, vvec4(0.2f * grey, 0.2f + grey * 0.62f, 0.6f + 0.2f * grey, outline * 0.95f), COLOR.w);
+	packColor(COLOR, in.rgba);
+}
+
+#if defined(SW_WIDE8)
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vfloat BatchedFrozenMask_USE_PALETTE_aastep8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vfloat threshold, nCine::RHI::Software::sw::wide8::vfloat value)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const BatchedFrozenMask_USE_PALETTE_Uniforms* unis = static_cast<const BatchedFrozenMask_USE_PALETTE_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vfloat afwidth = length(vvec2(dFdx(value), dFdy(value))) * 0.70710678118654757f;
+	return smoothstep(threshold - afwidth, threshold + afwidth, value);
+}
+
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vvec4 BatchedFrozenMask_USE_PALETTE_maskSample8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec2 uv)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const BatchedFrozenMask_USE_PALETTE_Uniforms* unis = static_cast<const BatchedFrozenMask_USE_PALETTE_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 src = swTexture(in, 0, uv);
+	vfloat palIndex = floor(unis->vPaletteOffset + 0.5f) + floor(src.x * 255.0f + 0.5f);
+	vfloat palX = (mod(palIndex, 256.0f) + 0.5f) / 256.0f;
+	vfloat palY = (floor(palIndex / 256.0f) + 0.5f) / 256.0f;
+	vvec4 c = swTexture(in, 1, vvec2(palX, palY));
+	return vvec4(c.xyz(), c.w * src.w);
+}
+
+DEATH_ENABLE_AVX2 void BatchedFrozenMask_USE_PALETTE_Fragment8(const nCine::RHI::Software::FragmentShaderInput8& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const BatchedFrozenMask_USE_PALETTE_Uniforms* unis = static_cast<const BatchedFrozenMask_USE_PALETTE_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vvec2 size = COLOR.xy() * COLOR.w * 2.0f;
+	vvec4 tex = BatchedFrozenMask_USE_PALETTE_maskSample8(in, swTexCoords(in));
+	vvec4 tex1 = BatchedFrozenMask_USE_PALETTE_maskSample8(in, swTexCoords(in) + vvec2(-size.x, 0));
+	vvec4 tex2 = BatchedFrozenMask_USE_PALETTE_maskSample8(in, swTexCoords(in) + vvec2(0, size.y));
+	vvec4 tex3 = BatchedFrozenMask_USE_PALETTE_maskSample8(in, swTexCoords(in) + vvec2(size.x, 0));
+	vvec4 tex4 = BatchedFrozenMask_USE_PALETTE_maskSample8(in, swTexCoords(in) + vvec2(0, -size.y));
+	vfloat outline = tex1.w;
+	outline += tex2.w;
+	outline += tex3.w;
+	outline += tex4.w;
+	outline += BatchedFrozenMask_USE_PALETTE_maskSample8(in, swTexCoords(in) + vvec2(-size.x, size.y)).w;
+	outline += BatchedFrozenMask_USE_PALETTE_maskSample8(in, swTexCoords(in) + vvec2(size.x, size.y)).w;
+	outline += BatchedFrozenMask_USE_PALETTE_maskSample8(in, swTexCoords(in) + vvec2(-size.x, -size.y)).w;
+	outline += BatchedFrozenMask_USE_PALETTE_maskSample8(in, swTexCoords(in) + vvec2(size.x, -size.y)).w;
+	outline = BatchedFrozenMask_USE_PALETTE_aastep8(in, 1.0f, outline);
+	vvec4 color = (tex + tex + tex1 + tex2 + tex3 + tex4) / 6.0f;
+	vfloat grey = min((0.299f * color.x + 0.587f * color.y + 0.114f * color.z) * 2.6f, 1.0f);
+	COLOR = mix(tex, vvec4(0.2f * grey, 0.2f + grey * 0.62f, 0.6f + 0.2f * grey, outline * 0.95f), COLOR.w);
+	packColor(COLOR, in.rgba);
+}
+#endif
+
+		// --- Outline ---
+struct Outline_Uniforms
+{
+};
+
+static float Outline_aastep(const nCine::RHI::Software::FragmentShaderInput& in, float threshold, float value)
+{
+	using namespace nCine::RHI::Software::sw;
+	const Outline_Uniforms* unis = static_cast<const Outline_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	float afwidth = length(vec2(dFdx(value), dFdy(value))) * 0.70710678118654757f;
+	return smoothstep(threshold - afwidth, threshold + afwidth, value);
+}
+
+void Outline_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	const Outline_Uniforms* unis = static_cast<const Outline_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vec2 size = COLOR.xy();
+	float outline = swTexture(in, 0, vec2(in.u, in.v) + vec2(-size.x, 0)).a;
+	outline += swTexture(in, 0, vec2(in.u, in.v) + vec2(0, size.y)).a;
+	outline += swTexture(in, 0, vec2(in.u, in.v) + vec2(size.x, 0)).a;
+	outline += swTexture(in, 0, vec2(in.u, in.v) + vec2(0, -size.y)).a;
+	outline += swTexture(in, 0, vec2(in.u, in.v) + vec2(-size.x, size.y)).a;
+	outline += swTexture(in, 0, vec2(in.u, in.v) + vec2(size.x, size.y)).a;
+	outline += swTexture(in, 0, vec2(in.u, in.v) + vec2(-size.x, -size.y)).a;
+	outline += swTexture(in, 0, vec2(in.u, in.v) + vec2(size.x, -size.y)).a;
+	outline = Outline_aastep(in, 1.0f, outline);
+	float outline2 = swTexture(in, 0, vec2(in.u, in.v) + vec2(-2.0f * size.x, 0)).a;
+	outline2 += swTexture(in, 0, vec2(in.u, in.v) + vec2(0, 2.0f * size.y)).a;
+	outline2 += swTexture(in, 0, vec2(in.u, in.v) + vec2(2.0f * size.x, 0)).a;
+	outline2 += swTexture(in, 0, vec2(in.u, in.v) + vec2(0, -2.0f * size.y)).a;
+	outline2 += swTexture(in, 0, vec2(in.u, in.v) + vec2(-2.0f * size.x, 2.0f * size.y)).a;
+	outline2 += swTexture(in, 0, vec2(in.u, in.v) + vec2(2.0f * size.x, 2.0f * size.y)).a;
+	outline2 += swTexture(in, 0, vec2(in.u, in.v) + vec2(-2.0f * size.x, -2.0f * size.y)).a;
+	outline2 += swTexture(in, 0, vec2(in.u, in.v) + vec2(2.0f * size.x, -2.0f * size.y)).a;
+	outline2 = Outline_aastep(in, 1.0f, outline2);
+	vec4 color = swTexturePrimary(in, 0);
+	COLOR = mix(color, mix(vec4(0.0f, 0.0f, 0.0f, COLOR.w * 0.5f), vec4(COLOR.z, COLOR.z, COLOR.z, COLOR.w), outline), max(outline, outline2) - color.a);
+	packColor(COLOR, in.rgba);
+}
+
+static nCine::RHI::Software::sw::wide4::vfloat Outline_aastep4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vfloat threshold, nCine::RHI::Software::sw::wide4::vfloat value)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const Outline_Uniforms* unis = static_cast<const Outline_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vfloat afwidth = length(vvec2(dFdx(value), dFdy(value))) * 0.70710678118654757f;
+	return smoothstep(threshold - afwidth, threshold + afwidth, value);
+}
+
+void Outline_Fragment4(const nCine::RHI::Software::FragmentShaderInput4& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const Outline_Uniforms* unis = static_cast<const Outline_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vvec2 size = COLOR.xy();
+	vfloat outline = swTexture(in, 0, swTexCoords(in) + vvec2(-size.x, 0)).w;
+	outline += swTexture(in, 0, swTexCoords(in) + vvec2(0, size.y)).w;
+	outline += swTexture(in, 0, swTexCoords(in) + vvec2(size.x, 0)).w;
+	outline += swTexture(in, 0, swTexCoords(in) + vvec2(0, -size.y)).w;
+	outline += swTexture(in, 0, swTexCoords(in) + vvec2(-size.x, size.y)).w;
+	outline += swTexture(in, 0, swTexCoords(in) + vvec2(size.x, size.y)).w;
+	outline += swTexture(in, 0, swTexCoords(in) + vvec2(-size.x, -size.y)).w;
+	outline += swTexture(in, 0, swTexCoords(in) + vvec2(size.x, -size.y)).w;
+	outline = Outline_aastep4(in, 1.0f, outline);
+	vfloat outline2 = swTexture(in, 0, swTexCoords(in) + vvec2(-2.0f * size.x, 0)).w;
+	outline2 += swTexture(in, 0, swTexCoords(in) + vvec2(0, 2.0f * size.y)).w;
+	outline2 += swTexture(in, 0, swTexCoords(in) + vvec2(2.0f * size.x, 0)).w;
+	outline2 += swTexture(in, 0, swTexCoords(in) + vvec2(0, -2.0f * size.y)).w;
+	outline2 += swTexture(in, 0, swTexCoords(in) + vvec2(-2.0f * size.x, 2.0f * size.y)).w;
+	outline2 += swTexture(in, 0, swTexCoords(in) + vvec2(2.0f * size.x, 2.0f * size.y)).w;
+	outline2 += swTexture(in, 0, swTexCoords(in) + vvec2(-2.0f * size.x, -2.0f * size.y)).w;
+	outline2 += swTexture(in, 0, swTexCoords(in) + vvec2(2.0f * size.x, -2.0f * size.y)).w;
+	outline2 = Outline_aastep4(in, 1.0f, outline2);
+	vvec4 color = swTexturePrimary(in, 0);
+	COLOR = mix(color, mix(vvec4(0.0f, 0.0f, 0.0f, COLOR.w * 0.5f), vvec4(COLOR.z, COLOR.z, COLOR.z, COLOR.w), outline), max(outline, outline2) - color.w);
+	packColor(COLOR, in.rgba);
+}
+
+#if defined(SW_WIDE8)
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vfloat Outline_aastep8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vfloat threshold, nCine::RHI::Software::sw::wide8::vfloat value)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const Outline_Uniforms* unis = static_cast<const Outline_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vfloat afwidth = length(vvec2(dFdx(value), dFdy(value))) * 0.70710678118654757f;
+	return smoothstep(threshold - afwidth, threshold + afwidth, value);
+}
+
+DEATH_ENABLE_AVX2 void Outline_Fragment8(const nCine::RHI::Software::FragmentShaderInput8& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const Outline_Uniforms* unis = static_cast<const Outline_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vvec2 size = COLOR.xy();
+	vfloat outline = swTexture(in, 0, swTexCoords(in) + vvec2(-size.x, 0)).w;
+	outline += swTexture(in, 0, swTexCoords(in) + vvec2(0, size.y)).w;
+	outline += swTexture(in, 0, swTexCoords(in) + vvec2(size.x, 0)).w;
+	outline += swTexture(in, 0, swTexCoords(in) + vvec2(0, -size.y)).w;
+	outline += swTexture(in, 0, swTexCoords(in) + vvec2(-size.x, size.y)).w;
+	outline += swTexture(in, 0, swTexCoords(in) + vvec2(size.x, size.y)).w;
+	outline += swTexture(in, 0, swTexCoords(in) + vvec2(-size.x, -size.y)).w;
+	outline += swTexture(in, 0, swTexCoords(in) + vvec2(size.x, -size.y)).w;
+	outline = Outline_aastep8(in, 1.0f, outline);
+	vfloat outline2 = swTexture(in, 0, swTexCoords(in) + vvec2(-2.0f * size.x, 0)).w;
+	outline2 += swTexture(in, 0, swTexCoords(in) + vvec2(0, 2.0f * size.y)).w;
+	outline2 += swTexture(in, 0, swTexCoords(in) + vvec2(2.0f * size.x, 0)).w;
+	outline2 += swTexture(in, 0, swTexCoords(in) + vvec2(0, -2.0f * size.y)).w;
+	outline2 += swTexture(in, 0, swTexCoords(in) + vvec2(-2.0f * size.x, 2.0f * size.y)).w;
+	outline2 += swTexture(in, 0, swTexCoords(in) + vvec2(2.0f * size.x, 2.0f * size.y)).w;
+	outline2 += swTexture(in, 0, swTexCoords(in) + vvec2(-2.0f * size.x, -2.0f * size.y)).w;
+	outline2 += swTexture(in, 0, swTexCoords(in) + vvec2(2.0f * size.x, -2.0f * size.y)).w;
+	outline2 = Outline_aastep8(in, 1.0f, outline2);
+	vvec4 color = swTexturePrimary(in, 0);
+	COLOR = mix(color, mix(vvec4(0.0f, 0.0f, 0.0f, COLOR.w * 0.5f), vvec4(COLOR.z, COLOR.z, COLOR.z, COLOR.w), outline), max(outline, outline2) - color.w);
+	packColor(COLOR, in.rgba);
+}
+#endif
+
+		// --- BatchedOutline ---
+struct BatchedOutline_Uniforms
+{
+};
+
+static float BatchedOutline_aastep(const nCine::RHI::Software::FragmentShaderInput& in, float threshold, float value)
+{
+	using namespace nCine::RHI::Software::sw;
+	const BatchedOutline_Uniforms* unis = static_cast<const BatchedOutline_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	float afwidth = length(vec2(dFdx(value), dFdy(value))) * 0.70710678118654757f;
+	return smoothstep(threshold - afwidth, threshold + afwidth, value);
+}
+
+void BatchedOutline_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	const BatchedOutline_Uniforms* unis = static_cast<const BatchedOutline_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vec2 size = COLOR.xy();
+	float outline = swTexture(in, 0, vec2(in.u, in.v) + vec2(-size.x, 0)).a;
+	outline += swTexture(in, 0, vec2(in.u, in.v) + vec2(0, size.y)).a;
+	outline += swTexture(in, 0, vec2(in.u, in.v) + vec2(size.x, 0)).a;
+	outline += swTexture(in, 0, vec2(in.u, in.v) + vec2(0, -size.y)).a;
+	outline += swTexture(in, 0, vec2(in.u, in.v) + vec2(-size.x, size.y)).a;
+	outline += swTexture(in, 0, vec2(in.u, in.v) + vec2(size.x, size.y)).a;
+	outline += swTexture(in, 0, vec2(in.u, in.v) + vec2(-size.x, -size.y)).a;
+	outline += swTexture(in, 0, vec2(in.u, in.v) + vec2(size.x, -size.y)).a;
+	outline = BatchedOutline_aastep(in, 1.0f, outline);
+	float outline2 = swTexture(in, 0, vec2(in.u, in.v) + vec2(-2.0f * size.x, 0)).a;
+	outline2 += swTexture(in, 0, vec2(in.u, in.v) + vec2(0, 2.0f * size.y)).a;
+	outline2 += swTexture(in, 0, vec2(in.u, in.v) + vec2(2.0f * size.x, 0)).a;
+	outline2 += swTexture(in, 0, vec2(in.u, in.v) + vec2(0, -2.0f * size.y)).a;
+	outline2 += swTexture(in, 0, vec2(in.u, in.v) + vec2(-2.0f * size.x, 2.0f * size.y)).a;
+	outline2 += swTexture(in, 0, vec2(in.u, in.v) + vec2(2.0f * size.x, 2.0f * size.y)).a;
+	outline2 += swTexture(in, 0, vec2(in.u, in.v) + vec2(-2.0f * size.x, -2.0f * size.y)).a;
+	outline2 += swTexture(in, 0, vec2(in.u, in.v) + vec2(2.0f * size.x, -2.0f * size.y)).a;
+	outline2 = BatchedOutline_aastep(in, 1.0f, outline2);
+	vec4 color = swTexturePrimary(in, 0);
+	COLOR = mix(color, mix(vec4(0.0f, 0.0f, 0.0f, COLOR.w * 0.5f), vec4(COLOR.z, COLOR.z, COLOR.z, COLOR.w), outline), max(outline, outline2) - color.a);
+	packColor(COLOR, in.rgba);
+}
+
+static nCine::RHI::Software::sw::wide4::vfloat BatchedOutline_aastep4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vfloat threshold, nCine::RHI::Software::sw::wide4::vfloat value)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const BatchedOutline_Uniforms* unis = static_cast<const BatchedOutline_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vfloat afwidth = length(vvec2(dFdx(value), dFdy(value))) * 0.70710678118654757f;
+	return smoothstep(threshold - afwidth, threshold + afwidth, value);
+}
+
+void BatchedOutline_Fragment4(const nCine::RHI::Software::FragmentShaderInput4& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const BatchedOutline_Uniforms* unis = static_cast<const BatchedOutline_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vvec2 size = COLOR.xy();
+	vfloat outline = swTexture(in, 0, swTexCoords(in) + vvec2(-size.x, 0)).w;
+	outline += swTexture(in, 0, swTexCoords(in) + vvec2(0, size.y)).w;
+	outline += swTexture(in, 0, swTexCoords(in) + vvec2(size.x, 0)).w;
+	outline += swTexture(in, 0, swTexCoords(in) + vvec2(0, -size.y)).w;
+	outline += swTexture(in, 0, swTexCoords(in) + vvec2(-size.x, size.y)).w;
+	outline += swTexture(in, 0, swTexCoords(in) + vvec2(size.x, size.y)).w;
+	outline += swTexture(in, 0, swTexCoords(in) + vvec2(-size.x, -size.y)).w;
+	outline += swTexture(in, 0, swTexCoords(in) + vvec2(size.x, -size.y)).w;
+	outline = BatchedOutline_aastep4(in, 1.0f, outline);
+	vfloat outline2 = swTexture(in, 0, swTexCoords(in) + vvec2(-2.0f * size.x, 0)).w;
+	outline2 += swTexture(in, 0, swTexCoords(in) + vvec2(0, 2.0f * size.y)).w;
+	outline2 += swTexture(in, 0, swTexCoords(in) + vvec2(2.0f * size.x, 0)).w;
+	outline2 += swTexture(in, 0, swTexCoords(in) + vvec2(0, -2.0f * size.y)).w;
+	outline2 += swTexture(in, 0, swTexCoords(in) + vvec2(-2.0f * size.x, 2.0f * size.y)).w;
+	outline2 += swTexture(in, 0, swTexCoords(in) + vvec2(2.0f * size.x, 2.0f * size.y)).w;
+	outline2 += swTexture(in, 0, swTexCoords(in) + vvec2(-2.0f * size.x, -2.0f * size.y)).w;
+	outline2 += swTexture(in, 0, swTexCoords(in) + vvec2(2.0f * size.x, -2.0f * size.y)).w;
+	outline2 = BatchedOutline_aastep4(in, 1.0f, outline2);
+	vvec4 color = swTexturePrimary(in, 0);
+	COLOR = mix(color, mix(vvec4(0.0f, 0.0f, 0.0f, COLOR.w * 0.5f), vvec4(COLOR.z, COLOR.z, COLOR.z, COLOR.w), outline), max(outline, outline2) - color.w);
+	packColor(COLOR, in.rgba);
+}
+
+#if defined(SW_WIDE8)
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vfloat BatchedOutline_aastep8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vfloat threshold, nCine::RHI::Software::sw::wide8::vfloat value)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const BatchedOutline_Uniforms* unis = static_cast<const BatchedOutline_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vfloat afwidth = length(vvec2(dFdx(value), dFdy(value))) * 0.70710678118654757f;
+	return smoothstep(threshold - afwidth, threshold + afwidth, value);
+}
+
+DEATH_ENABLE_AVX2 void BatchedOutline_Fragment8(const nCine::RHI::Software::FragmentShaderInput8& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const BatchedOutline_Uniforms* unis = static_cast<const BatchedOutline_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vvec2 size = COLOR.xy();
+	vfloat outline = swTexture(in, 0, swTexCoords(in) + vvec2(-size.x, 0)).w;
+	outline += swTexture(in, 0, swTexCoords(in) + vvec2(0, size.y)).w;
+	outline += swTexture(in, 0, swTexCoords(in) + vvec2(size.x, 0)).w;
+	outline += swTexture(in, 0, swTexCoords(in) + vvec2(0, -size.y)).w;
+	outline += swTexture(in, 0, swTexCoords(in) + vvec2(-size.x, size.y)).w;
+	outline += swTexture(in, 0, swTexCoords(in) + vvec2(size.x, size.y)).w;
+	outline += swTexture(in, 0, swTexCoords(in) + vvec2(-size.x, -size.y)).w;
+	outline += swTexture(in, 0, swTexCoords(in) + vvec2(size.x, -size.y)).w;
+	outline = BatchedOutline_aastep8(in, 1.0f, outline);
+	vfloat outline2 = swTexture(in, 0, swTexCoords(in) + vvec2(-2.0f * size.x, 0)).w;
+	outline2 += swTexture(in, 0, swTexCoords(in) + vvec2(0, 2.0f * size.y)).w;
+	outline2 += swTexture(in, 0, swTexCoords(in) + vvec2(2.0f * size.x, 0)).w;
+	outline2 += swTexture(in, 0, swTexCoords(in) + vvec2(0, -2.0f * size.y)).w;
+	outline2 += swTexture(in, 0, swTexCoords(in) + vvec2(-2.0f * size.x, 2.0f * size.y)).w;
+	outline2 += swTexture(in, 0, swTexCoords(in) + vvec2(2.0f * size.x, 2.0f * size.y)).w;
+	outline2 += swTexture(in, 0, swTexCoords(in) + vvec2(-2.0f * size.x, -2.0f * size.y)).w;
+	outline2 += swTexture(in, 0, swTexCoords(in) + vvec2(2.0f * size.x, -2.0f * size.y)).w;
+	outline2 = BatchedOutline_aastep8(in, 1.0f, outline2);
+	vvec4 color = swTexturePrimary(in, 0);
+	COLOR = mix(color, mix(vvec4(0.0f, 0.0f, 0.0f, COLOR.w * 0.5f), vvec4(COLOR.z, COLOR.z, COLOR.z, COLOR.w), outline), max(outline, outline2) - color.w);
+	packColor(COLOR, in.rgba);
+}
+#endif
+
+		// --- OutlinePalette ---
+struct OutlinePalette_Uniforms
+{
+	float vPaletteOffset;
+};
+
+void OutlinePalette_ComputeVaryings(void* inputs, const std::uint8_t* instanceBlock)
+{
+	using namespace nCine::RHI::Software::sw;
+	OutlinePalette_Uniforms* io = static_cast<OutlinePalette_Uniforms*>(inputs);
+	(void)io;
+	(void)instanceBlock;
+	io->vPaletteOffset = (*reinterpret_cast<const float*>(instanceBlock + 104));
+}
+
+static float OutlinePalette_aastep(const nCine::RHI::Software::FragmentShaderInput& in, float threshold, float value)
+{
+	using namespace nCine::RHI::Software::sw;
+	const OutlinePalette_Uniforms* unis = static_cast<const OutlinePalette_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	float afwidth = length(vec2(dFdx(value), dFdy(value))) * 0.70710678118654757f;
+	return smoothstep(threshold - afwidth, threshold + afwidth, value);
+}
+
+static nCine::RHI::Software::sw::vec4 OutlinePalette_palette(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 uv)
+{
+	using namespace nCine::RHI::Software::sw;
+	const OutlinePalette_Uniforms* unis = static_cast<const OutlinePalette_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vec4 src = swTexture(in, 0, uv);
+	float palIndex = floor(unis->vPaletteOffset + 0.5f) + floor(src.r * 255.0f + 0.5f);
+	float palX = (mod(palIndex, 256.0f) + 0.5f) / 256.0f;
+	float palY = (floor(palIndex / 256.0f) + 0.5f) / 256.0f;
+	vec4 c = swTexture(in, 1, vec2(palX, palY));
+	return vec4(c.xyz(), c.a * src.a);
+}
+
+static float OutlinePalette_alphaAt(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 uv)
+{
+	using namespace nCine::RHI::Software::sw;
+	const OutlinePalette_Uniforms* unis = static_cast<const OutlinePalette_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vec4 src = swTexture(in, 0, uv);
+	float palIndex = floor(unis->vPaletteOffset + 0.5f) + floor(src.r * 255.0f + 0.5f);
+	float palX = (mod(palIndex, 256.0f) + 0.5f) / 256.0f;
+	float palY = (floor(palIndex / 256.0f) + 0.5f) / 256.0f;
+	return swTexture(in, 1, vec2(palX, palY)).a * src.a;
+}
+
+void OutlinePalette_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	const OutlinePalette_Uniforms* unis = static_cast<const OutlinePalette_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vec2 size = COLOR.xy();
+	float outline = OutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(-size.x, 0));
+	outline += OutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(0, size.y));
+	outline += OutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(size.x, 0));
+	outline += OutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(0, -size.y));
+	outline += OutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(-size.x, size.y));
+	outline += OutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(size.x, size.y));
+	outline += OutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(-size.x, -size.y));
+	outline += OutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(size.x, -size.y));
+	outline = OutlinePalette_aastep(in, 1.0f, outline);
+	float outline2 = OutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(-2.0f * size.x, 0));
+	outline2 += OutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(0, 2.0f * size.y));
+	outline2 += OutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(2.0f * size.x, 0));
+	outline2 += OutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(0, -2.0f * size.y));
+	outline2 += OutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(-2.0f * size.x, 2.0f * size.y));
+	outline2 += OutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(2.0f * size.x, 2.0f * size.y));
+	outline2 += OutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(-2.0f * size.x, -2.0f * size.y));
+	outline2 += OutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(2.0f * size.x, -2.0f * size.y));
+	outline2 = OutlinePalette_aastep(in, 1.0f, outline2);
+	vec4 color = OutlinePalette_palette(in, vec2(in.u, in.v));
+	COLOR = mix(color, mix(vec4(0.0f, 0.0f, 0.0f, COLOR.w * 0.5f), vec4(COLOR.z, COLOR.z, COLOR.z, COLOR.w), outline), max(outline, outline2) - color.a);
+	packColor(COLOR, in.rgba);
+}
+
+static nCine::RHI::Software::sw::wide4::vfloat OutlinePalette_aastep4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vfloat threshold, nCine::RHI::Software::sw::wide4::vfloat value)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const OutlinePalette_Uniforms* unis = static_cast<const OutlinePalette_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vfloat afwidth = length(vvec2(dFdx(value), dFdy(value))) * 0.70710678118654757f;
+	return smoothstep(threshold - afwidth, threshold + afwidth, value);
+}
+
+static nCine::RHI::Software::sw::wide4::vvec4 OutlinePalette_palette4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec2 uv)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const OutlinePalette_Uniforms* unis = static_cast<const OutlinePalette_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 src = swTexture(in, 0, uv);
+	vfloat palIndex = floor(unis->vPaletteOffset + 0.5f) + floor(src.x * 255.0f + 0.5f);
+	vfloat palX = (mod(palIndex, 256.0f) + 0.5f) / 256.0f;
+	vfloat palY = (floor(palIndex / 256.0f) + 0.5f) / 256.0f;
+	vvec4 c = swTexture(in, 1, vvec2(palX, palY));
+	return vvec4(c.xyz(), c.w * src.w);
+}
+
+static nCine::RHI::Software::sw::wide4::vfloat OutlinePalette_alphaAt4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec2 uv)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const OutlinePalette_Uniforms* unis = static_cast<const OutlinePalette_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 src = swTexture(in, 0, uv);
+	vfloat palIndex = floor(unis->vPaletteOffset + 0.5f) + floor(src.x * 255.0f + 0.5f);
+	vfloat palX = (mod(palIndex, 256.0f) + 0.5f) / 256.0f;
+	vfloat palY = (floor(palIndex / 256.0f) + 0.5f) / 256.0f;
+	return swTexture(in, 1, vvec2(palX, palY)).w * src.w;
+}
+
+void OutlinePalette_Fragment4(const nCine::RHI::Software::FragmentShaderInput4& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const OutlinePalette_Uniforms* unis = static_cast<const OutlinePalette_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vvec2 size = COLOR.xy();
+	vfloat outline = OutlinePalette_alphaAt4(in, swTexCoords(in) + vvec2(-size.x, 0));
+	outline += OutlinePalette_alphaAt4(in, swTexCoords(in) + vvec2(0, size.y));
+	outline += OutlinePalette_alphaAt4(in, swTexCoords(in) + vvec2(size.x, 0));
+	outline += OutlinePalette_alphaAt4(in, swTexCoords(in) + vvec2(0, -size.y));
+	outline += OutlinePalette_alphaAt4(in, swTexCoords(in) + vvec2(-size.x, size.y));
+	outline += OutlinePalette_alphaAt4(in, swTexCoords(in) + vvec2(size.x, size.y));
+	outline += OutlinePalette_alphaAt4(in, swTexCoords(in) + vvec2(-size.x, -size.y));
+	outline += OutlinePalette_alphaAt4(in, swTexCoords(in) + vvec2(size.x, -size.y));
+	outline = OutlinePalette_aastep4(in, 1.0f, outline);
+	vfloat outline2 = OutlinePalette_alphaAt4(in, swTexCoords(in) + vvec2(-2.0f * size.x, 0));
+	outline2 += OutlinePalette_alphaAt4(in, swTexCoords(in) + vvec2(0, 2.0f * size.y));
+	outline2 += OutlinePalette_alphaAt4(in, swTexCoords(in) + vvec2(2.0f * size.x, 0));
+	outline2 += OutlinePalette_alphaAt4(in, swTexCoords(in) + vvec2(0, -2.0f * size.y));
+	outline2 += OutlinePalette_alphaAt4(in, swTexCoords(in) + vvec2(-2.0f * size.x, 2.0f * size.y));
+	outline2 += OutlinePalette_alphaAt4(in, swTexCoords(in) + vvec2(2.0f * size.x, 2.0f * size.y));
+	outline2 += OutlinePalette_alphaAt4(in, swTexCoords(in) + vvec2(-2.0f * size.x, -2.0f * size.y));
+	outline2 += OutlinePalette_alphaAt4(in, swTexCoords(in) + vvec2(2.0f * size.x, -2.0f * size.y));
+	outline2 = OutlinePalette_aastep4(in, 1.0f, outline2);
+	vvec4 color = OutlinePalette_palette4(in, swTexCoords(in));
+	COLOR = mix(color, mix(vvec4(0.0f, 0.0f, 0.0f, COLOR.w * 0.5f), vvec4(COLOR.z, COLOR.z, COLOR.z, COLOR.w), outline), max(outline, outline2) - color.w);
+	packColor(COLOR, in.rgba);
+}
+
+#if defined(SW_WIDE8)
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vfloat OutlinePalette_aastep8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vfloat threshold, nCine::RHI::Software::sw::wide8::vfloat value)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const OutlinePalette_Uniforms* unis = static_cast<const OutlinePalette_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vfloat afwidth = length(vvec2(dFdx(value), dFdy(value))) * 0.70710678118654757f;
+	return smoothstep(threshold - afwidth, threshold + afwidth, value);
+}
+
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vvec4 OutlinePalette_palette8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec2 uv)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const OutlinePalette_Uniforms* unis = static_cast<const OutlinePalette_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 src = swTexture(in, 0, uv);
+	vfloat palIndex = floor(unis->vPaletteOffset + 0.5f) + floor(src.x * 255.0f + 0.5f);
+	vfloat palX = (mod(palIndex, 256.0f) + 0.5f) / 256.0f;
+	vfloat palY = (floor(palIndex / 256.0f) + 0.5f) / 256.0f;
+	vvec4 c = swTexture(in, 1, vvec2(palX, palY));
+	return vvec4(c.xyz(), c.w * src.w);
+}
+
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vfloat OutlinePalette_alphaAt8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec2 uv)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const OutlinePalette_Uniforms* unis = static_cast<const OutlinePalette_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 src = swTexture(in, 0, uv);
+	vfloat palIndex = floor(unis->vPaletteOffset + 0.5f) + floor(src.x * 255.0f + 0.5f);
+	vfloat palX = (mod(palIndex, 256.0f) + 0.5f) / 256.0f;
+	vfloat palY = (floor(palIndex / 256.0f) + 0.5f) / 256.0f;
+	return swTexture(in, 1, vvec2(palX, palY)).w * src.w;
+}
+
+DEATH_ENABLE_AVX2 void OutlinePalette_Fragment8(const nCine::RHI::Software::FragmentShaderInput8& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const OutlinePalette_Uniforms* unis = static_cast<const OutlinePalette_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vvec2 size = COLOR.xy();
+	vfloat outline = OutlinePalette_alphaAt8(in, swTexCoords(in) + vvec2(-size.x, 0));
+	outline += OutlinePalette_alphaAt8(in, swTexCoords(in) + vvec2(0, size.y));
+	outline += OutlinePalette_alphaAt8(in, swTexCoords(in) + vvec2(size.x, 0));
+	outline += OutlinePalette_alphaAt8(in, swTexCoords(in) + vvec2(0, -size.y));
+	outline += OutlinePalette_alphaAt8(in, swTexCoords(in) + vvec2(-size.x, size.y));
+	outline += OutlinePalette_alphaAt8(in, swTexCoords(in) + vvec2(size.x, size.y));
+	outline += OutlinePalette_alphaAt8(in, swTexCoords(in) + vvec2(-size.x, -size.y));
+	outline += OutlinePalette_alphaAt8(in, swTexCoords(in) + vvec2(size.x, -size.y));
+	outline = OutlinePalette_aastep8(in, 1.0f, outline);
+	vfloat outline2 = OutlinePalette_alphaAt8(in, swTexCoords(in) + vvec2(-2.0f * size.x, 0));
+	outline2 += OutlinePalette_alphaAt8(in, swTexCoords(in) + vvec2(0, 2.0f * size.y));
+	outline2 += OutlinePalette_alphaAt8(in, swTexCoords(in) + vvec2(2.0f * size.x, 0));
+	outline2 += OutlinePalette_alphaAt8(in, swTexCoords(in) + vvec2(0, -2.0f * size.y));
+	outline2 += OutlinePalette_alphaAt8(in, swTexCoords(in) + vvec2(-2.0f * size.x, 2.0f * size.y));
+	outline2 += OutlinePalette_alphaAt8(in, swTexCoords(in) + vvec2(2.0f * size.x, 2.0f * size.y));
+	outline2 += OutlinePalette_alphaAt8(in, swTexCoords(in) + vvec2(-2.0f * size.x, -2.0f * size.y));
+	outline2 += OutlinePalette_alphaAt8(in, swTexCoords(in) + vvec2(2.0f * size.x, -2.0f * size.y));
+	outline2 = OutlinePalette_aastep8(in, 1.0f, outline2);
+	vvec4 color = OutlinePalette_palette8(in, swTexCoords(in));
+	COLOR = mix(color, mix(vvec4(0.0f, 0.0f, 0.0f, COLOR.w * 0.5f), vvec4(COLOR.z, COLOR.z, COLOR.z, COLOR.w), outline), max(outline, outline2) - color.w);
+	packColor(COLOR, in.rgba);
+}
+#endif
+
+		// --- BatchedOutlinePalette ---
+struct BatchedOutlinePalette_Uniforms
+{
+	float vPaletteOffset;
+};
+
+void BatchedOutlinePalette_ComputeVaryings(void* inputs, const std::uint8_t* instanceBlock)
+{
+	using namespace nCine::RHI::Software::sw;
+	BatchedOutlinePalette_Uniforms* io = static_cast<BatchedOutlinePalette_Uniforms*>(inputs);
+	(void)io;
+	(void)instanceBlock;
+	io->vPaletteOffset = (*reinterpret_cast<const float*>(instanceBlock + 104));
+}
+
+static float BatchedOutlinePalette_aastep(const nCine::RHI::Software::FragmentShaderInput& in, float threshold, float value)
+{
+	using namespace nCine::RHI::Software::sw;
+	const BatchedOutlinePalette_Uniforms* unis = static_cast<const BatchedOutlinePalette_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	float afwidth = length(vec2(dFdx(value), dFdy(value))) * 0.70710678118654757f;
+	return smoothstep(threshold - afwidth, threshold + afwidth, value);
+}
+
+static nCine::RHI::Software::sw::vec4 BatchedOutlinePalette_palette(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 uv)
+{
+	using namespace nCine::RHI::Software::sw;
+	const BatchedOutlinePalette_Uniforms* unis = static_cast<const BatchedOutlinePalette_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vec4 src = swTexture(in, 0, uv);
+	float palIndex = floor(unis->vPaletteOffset + 0.5f) + floor(src.r * 255.0f + 0.5f);
+	float palX = (mod(palIndex, 256.0f) + 0.5f) / 256.0f;
+	float palY = (floor(palIndex / 256.0f) + 0.5f) / 256.0f;
+	vec4 c = swTexture(in, 1, vec2(palX, palY));
+	return vec4(c.xyz(), c.a * src.a);
+}
+
+static float BatchedOutlinePalette_alphaAt(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 uv)
+{
+	using namespace nCine::RHI::Software::sw;
+	const BatchedOutlinePalette_Uniforms* unis = static_cast<const BatchedOutlinePalette_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vec4 src = swTexture(in, 0, uv);
+	float palIndex = floor(unis->vPaletteOffset + 0.5f) + floor(src.r * 255.0f + 0.5f);
+	float palX = (mod(palIndex, 256.0f) + 0.5f) / 256.0f;
+	float palY = (floor(palIndex / 256.0f) + 0.5f) / 256.0f;
+	return swTexture(in, 1, vec2(palX, palY)).a * src.a;
+}
+
+void BatchedOutlinePalette_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	const BatchedOutlinePalette_Uniforms* unis = static_cast<const BatchedOutlinePalette_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vec2 size = COLOR.xy();
+	float outline = BatchedOutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(-size.x, 0));
+	outline += BatchedOutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(0, size.y));
+	outline += BatchedOutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(size.x, 0));
+	outline += BatchedOutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(0, -size.y));
+	outline += BatchedOutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(-size.x, size.y));
+	outline += BatchedOutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(size.x, size.y));
+	outline += BatchedOutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(-size.x, -size.y));
+	outline += BatchedOutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(size.x, -size.y));
+	outline = BatchedOutlinePalette_aastep(in, 1.0f, outline);
+	float outline2 = BatchedOutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(-2.0f * size.x, 0));
+	outline2 += BatchedOutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(0, 2.0f * size.y));
+	outline2 += BatchedOutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(2.0f * size.x, 0));
+	outline2 += BatchedOutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(0, -2.0f * size.y));
+	outline2 += BatchedOutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(-2.0f * size.x, 2.0f * size.y));
+	outline2 += BatchedOutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(2.0f * size.x, 2.0f * size.y));
+	outline2 += BatchedOutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(-2.0f * size.x, -2.0f * size.y));
+	outline2 += BatchedOutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(2.0f * size.x, -2.0f * size.y));
+	outline2 = BatchedOutlinePalette_aastep(in, 1.0f, outline2);
+	vec4 color = BatchedOutlinePalette_palette(in, vec2(in.u, in.v));
+	COLOR = mix(color, mix(vec4(0.0f, 0.0f, 0.0f, COLOR.w * 0.5f), vec4(COLOR.z, COLOR.z, COLOR.z, COLOR.w), outline), max(outline, outline2) - color.a);
+	packColor(COLOR, in.rgba);
+}
+
+static nCine::RHI::Software::sw::wide4::vfloat BatchedOutlinePalette_aastep4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vfloat threshold, nCine::RHI::Software::sw::wide4::vfloat value)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const BatchedOutlinePalette_Uniforms* unis = static_cast<const BatchedOutlinePalette_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vfloat afwidth = length(vvec2(dFdx(value), dFdy(value))) * 0.70710678118654757f;
+	return smoothstep(threshold - afwidth, threshold + afwidth, value);
+}
+
+static nCine::RHI::Software::sw::wide4::vvec4 BatchedOutlinePalette_palette4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec2 uv)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const BatchedOutlinePalette_Uniforms* unis = static_cast<const BatchedOutlinePalette_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 src = swTexture(in, 0, uv);
+	vfloat palIndex = floor(unis->vPaletteOffset + 0.5f) + floor(src.x * 255.0f + 0.5f);
+	vfloat palX = (mod(palIndex, 256.0f) + 0.5f) / 256.0f;
+	vfloat palY = (floor(palIndex / 256.0f) + 0.5f) / 256.0f;
+	vvec4 c = swTexture(in, 1, vvec2(palX, palY));
+	return vvec4(c.xyz(), c.w * src.w);
+}
+
+static nCine::RHI::Software::sw::wide4::vfloat BatchedOutlinePalette_alphaAt4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec2 uv)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const BatchedOutlinePalette_Uniforms* unis = static_cast<const BatchedOutlinePalette_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 src = swTexture(in, 0, uv);
+	vfloat palIndex = floor(unis->vPaletteOffset + 0.5f) + floor(src.x * 255.0f + 0.5f);
+	vfloat palX = (mod(palIndex, 256.0f) + 0.5f) / 256.0f;
+	vfloat palY = (floor(palIndex / 256.0f) + 0.5f) / 256.0f;
+	return swTexture(in, 1, vvec2(palX, palY)).w * src.w;
+}
+
+void BatchedOutlinePalette_Fragment4(const nCine::RHI::Software::FragmentShaderInput4& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const BatchedOutlinePalette_Uniforms* unis = static_cast<const BatchedOutlinePalette_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vvec2 size = COLOR.xy();
+	vfloat outline = BatchedOutlinePalette_alphaAt4(in, swTexCoords(in) + vvec2(-size.x, 0));
+	outline += BatchedOutlinePalette_alphaAt4(in, swTexCoords(in) + vvec2(0, size.y));
+	outline += BatchedOutlinePalette_alphaAt4(in, swTexCoords(in) + vvec2(size.x, 0));
+	outline += BatchedOutlinePalette_alphaAt4(in, swTexCoords(in) + vvec2(0, -size.y));
+	outline += BatchedOutlinePalette_alphaAt4(in, swTexCoords(in) + vvec2(-size.x, size.y));
+	outline += BatchedOutlinePalette_alphaAt4(in, swTexCoords(in) + vvec2(size.x, size.y));
+	outline += BatchedOutlinePalette_alphaAt4(in, swTexCoords(in) + vvec2(-size.x, -size.y));
+	outline += BatchedOutlinePalette_alphaAt4(in, swTexCoords(in) + vvec2(size.x, -size.y));
+	outline = BatchedOutlinePalette_aastep4(in, 1.0f, outline);
+	vfloat outline2 = BatchedOutlinePalette_alphaAt4(in, swTexCoords(in) + vvec2(-2.0f * size.x, 0));
+	outline2 += BatchedOutlinePalette_alphaAt4(in, swTexCoords(in) + vvec2(0, 2.0f * size.y));
+	outline2 += BatchedOutlinePalette_alphaAt4(in, swTexCoords(in) + vvec2(2.0f * size.x, 0));
+	outline2 += BatchedOutlinePalette_alphaAt4(in, swTexCoords(in) + vvec2(0, -2.0f * size.y));
+	outline2 += BatchedOutlinePalette_alphaAt4(in, swTexCoords(in) + vvec2(-2.0f * size.x, 2.0f * size.y));
+	outline2 += BatchedOutlinePalette_alphaAt4(in, swTexCoords(in) + vvec2(2.0f * size.x, 2.0f * size.y));
+	outline2 += BatchedOutlinePalette_alphaAt4(in, swTexCoords(in) + vvec2(-2.0f * size.x, -2.0f * size.y));
+	outline2 += BatchedOutlinePalette_alphaAt4(in, swTexCoords(in) + vvec2(2.0f * size.x, -2.0f * size.y));
+	outline2 = BatchedOutlinePalette_aastep4(in, 1.0f, outline2);
+	vvec4 color = BatchedOutlinePalette_palette4(in, swTexCoords(in));
+	COLOR = mix(color, mix(vvec4(0.0f, 0.0f, 0.0f, COLOR.w * 0.5f), vvec4(COLOR.z, COLOR.z, COLOR.z, COLOR.w), outline), max(outline, outline2) - color.w);
+	packColor(COLOR, in.rgba);
+}
+
+#if defined(SW_WIDE8)
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vfloat BatchedOutlinePalette_aastep8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vfloat threshold, nCine::RHI::Software::sw::wide8::vfloat value)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const BatchedOutlinePalette_Uniforms* unis = static_cast<const BatchedOutlinePalette_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vfloat afwidth = length(vvec2(dFdx(value), dFdy(value))) * 0.70710678118654757f;
+	return smoothstep(threshold - afwidth, threshold + afwidth, value);
+}
+
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vvec4 BatchedOutlinePalette_palette8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec2 uv)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const BatchedOutlinePalette_Uniforms* unis = static_cast<const BatchedOutlinePalette_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 src = swTexture(in, 0, uv);
+	vfloat palIndex = floor(unis->vPaletteOffset + 0.5f) + floor(src.x * 255.0f + 0.5f);
+	vfloat palX = (mod(palIndex, 256.0f) + 0.5f) / 256.0f;
+	vfloat palY = (floor(palIndex / 256.0f) + 0.5f) / 256.0f;
+	vvec4 c = swTexture(in, 1, vvec2(palX, palY));
+	return vvec4(c.xyz(), c.w * src.w);
+}
+
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vfloat BatchedOutlinePalette_alphaAt8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec2 uv)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const BatchedOutlinePalette_Uniforms* unis = static_cast<const BatchedOutlinePalette_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 src = swTexture(in, 0, uv);
+	vfloat palIndex = floor(unis->vPaletteOffset + 0.5f) + floor(src.x * 255.0f + 0.5f);
+	vfloat palX = (mod(palIndex, 256.0f) + 0.5f) / 256.0f;
+	vfloat palY = (floor(palIndex / 256.0f) + 0.5f) / 256.0f;
+	return swTexture(in, 1, vvec2(palX, palY)).w * src.w;
+}
+
+DEATH_ENABLE_AVX2 void BatchedOutlinePalette_Fragment8(const nCine::RHI::Software::FragmentShaderInput8& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const BatchedOutlinePalette_Uniforms* unis = static_cast<const BatchedOutlinePalette_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vvec2 size = COLOR.xy();
+	vfloat outline = BatchedOutlinePalette_alphaAt8(in, swTexCoords(in) + vvec2(-size.x, 0));
+	outline += BatchedOutlinePalette_alphaAt8(in, swTexCoords(in) + vvec2(0, size.y));
+	outline += BatchedOutlinePalette_alphaAt8(in, swTexCoords(in) + vvec2(size.x, 0));
+	outline += BatchedOutlinePalette_alphaAt8(in, swTexCoords(in) + vvec2(0, -size.y));
+	outline += BatchedOutlinePalette_alphaAt8(in, swTexCoords(in) + vvec2(-size.x, size.y));
+	outline += BatchedOutlinePalette_alphaAt8(in, swTexCoords(in) + vvec2(size.x, size.y));
+	outline += BatchedOutlinePalette_alphaAt8(in, swTexCoords(in) + vvec2(-size.x, -size.y));
+	outline += BatchedOutlinePalette_alphaAt8(in, swTexCoords(in) + vvec2(size.x, -size.y));
+	outline = BatchedOutlinePalette_aastep8(in, 1.0f, outline);
+	vfloat outline2 = BatchedOutlinePalette_alphaAt8(in, swTexCoords(in) + vvec2(-2.0f * size.x, 0));
+	outline2 += BatchedOutlinePalette_alphaAt8(in, swTexCoords(in) + vvec2(0, 2.0f * size.y));
+	outline2 += BatchedOutlinePalette_alphaAt8(in, swTexCoords(in) + vvec2(2.0f * size.x, 0));
+	outline2 += BatchedOutlinePalette_alphaAt8(in, swTexCoords(in) + vvec2(0, -2.0f * size.y));
+	outline2 += BatchedOutlinePalette_alphaAt8(in, swTexCoords(in) + vvec2(-2.0f * size.x, 2.0f * size.y));
+	outline2 += BatchedOutlinePalette_alphaAt8(in, swTexCoords(in) + vvec2(2.0f * size.x, 2.0f * size.y));
+	outline2 += BatchedOutlinePalette_alphaAt8(in, swTexCoords(in) + vvec2(-2.0f * size.x, -2.0f * size.y));
+	outline2 += BatchedOutlinePalette_alphaAt8(in, swTexCoords(in) + vvec2(2.0f * size.x, -2.0f * size.y));
+	outline2 = BatchedOutlinePalette_aastep8(in, 1.0f, outline2);
+	vvec4 color = BatchedOutlinePalette_palette8(in, swTexCoords(in));
+	COLOR = mix(color, mix(vvec4(0.0f, 0.0f, 0.0f, COLOR.w * 0.5f), vvec4(COLOR.z, COLOR.z, COLOR.z, COLOR.w), outline), max(outline, outline2) - color.w);
+	packColor(COLOR, in.rgba);
+}
+#endif
+
+		// --- PaletteRemap ---
+struct PaletteRemap_Uniforms
+{
+	float vPaletteOffset;
+};
+
+void PaletteRemap_ComputeVaryings(void* inputs, const std::uint8_t* instanceBlock)
+{
+	using namespace nCine::RHI::Software::sw;
+	PaletteRemap_Uniforms* io = static_cast<PaletteRemap_Uniforms*>(inputs);
+	(void)io;
+	(void)instanceBlock;
+	io->vPaletteOffset = (*reinterpret_cast<const float*>(instanceBlock + 104));
+}
+
+void PaletteRemap_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	const PaletteRemap_Uniforms* unis = static_cast<const PaletteRemap_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vec4 src = swTexturePrimary(in, 0);
+	float palIndex = floor(unis->vPaletteOffset + 0.5f) + floor(src.r * 255.0f + 0.5f);
+	float palX = (mod(palIndex, 256.0f) + 0.5f) / 256.0f;
+	float palY = (floor(palIndex / 256.0f) + 0.5f) / 256.0f;
+	vec4 color = swTexture(in, 1, vec2(palX, palY));
+	COLOR = vec4(color.xyz(), color.a * src.a) * COLOR;
+	packColor(COLOR, in.rgba);
+}
+
+void PaletteRemap_Fragment4(const nCine::RHI::Software::FragmentShaderInput4& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const PaletteRemap_Uniforms* unis = static_cast<const PaletteRemap_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vvec4 src = swTexturePrimary(in, 0);
+	vfloat palIndex = floor(unis->vPaletteOffset + 0.5f) + floor(src.x * 255.0f + 0.5f);
+	vfloat palX = (mod(palIndex, 256.0f) + 0.5f) / 256.0f;
+	vfloat palY = (floor(palIndex / 256.0f) + 0.5f) / 256.0f;
+	vvec4 color = swTexture(in, 1, vvec2(palX, palY));
+	COLOR = vvec4(color.xyz(), color.w * src.w) * COLOR;
+	packColor(COLOR, in.rgba);
+}
+
+#if defined(SW_WIDE8)
+DEATH_ENABLE_AVX2 void PaletteRemap_Fragment8(const nCine::RHI::Software::FragmentShaderInput8& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const PaletteRemap_Uniforms* unis = static_cast<const PaletteRemap_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vvec4 src = swTexturePrimary(in, 0);
+	vfloat palIndex = floor(unis->vPaletteOffset + 0.5f) + floor(src.x * 255.0f + 0.5f);
+	vfloat palX = (mod(palIndex, 256.0f) + 0.5f) / 256.0f;
+	vfloat palY = (floor(palIndex / 256.0f) + 0.5f) / 256.0f;
+	vvec4 color = swTexture(in, 1, vvec2(palX, palY));
+	COLOR = vvec4(color.xyz(), color.w * src.w) * COLOR;
+	packColor(COLOR, in.rgba);
+}
+#endif
+
+		// --- BatchedPaletteRemap ---
+struct BatchedPaletteRemap_Uniforms
+{
+	float vPaletteOffset;
+};
+
+void BatchedPaletteRemap_ComputeVaryings(void* inputs, const std::uint8_t* instanceBlock)
+{
+	using namespace nCine::RHI::Software::sw;
+	BatchedPaletteRemap_Uniforms* io = static_cast<BatchedPaletteRemap_Uniforms*>(inputs);
+	(void)io;
+	(void)instanceBlock;
+	io->vPaletteOffset = (*reinterpret_cast<const float*>(instanceBlock + 104));
+}
+
+void BatchedPaletteRemap_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	const BatchedPaletteRemap_Uniforms* unis = static_cast<const BatchedPaletteRemap_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vec4 src = swTexturePrimary(in, 0);
+	float palIndex = floor(unis->vPaletteOffset + 0.5f) + floor(src.r * 255.0f + 0.5f);
+	float palX = (mod(palIndex, 256.0f) + 0.5f) / 256.0f;
+	float palY = (floor(palIndex / 256.0f) + 0.5f) / 256.0f;
+	vec4 color = swTexture(in, 1, vec2(palX, palY));
+	COLOR = vec4(color.xyz(), color.a * src.a) * COLOR;
+	packColor(COLOR, in.rgba);
+}
+
+void BatchedPaletteRemap_Fragment4(const nCine::RHI::Software::FragmentShaderInput4& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const BatchedPaletteRemap_Uniforms* unis = static_cast<const BatchedPaletteRemap_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vvec4 src = swTexturePrimary(in, 0);
+	vfloat palIndex = floor(unis->vPaletteOffset + 0.5f) + floor(src.x * 255.0f + 0.5f);
+	vfloat palX = (mod(palIndex, 256.0f) + 0.5f) / 256.0f;
+	vfloat palY = (floor(palIndex / 256.0f) + 0.5f) / 256.0f;
+	vvec4 color = swTexture(in, 1, vvec2(palX, palY));
+	COLOR = vvec4(color.xyz(), color.w * src.w) * COLOR;
+	packColor(COLOR, in.rgba);
+}
+
+#if defined(SW_WIDE8)
+DEATH_ENABLE_AVX2 void BatchedPaletteRemap_Fragment8(const nCine::RHI::Software::FragmentShaderInput8& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const BatchedPaletteRemap_Uniforms* unis = static_cast<const BatchedPaletteRemap_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vvec4 src = swTexturePrimary(in, 0);
+	vfloat palIndex = floor(unis->vPaletteOffset + 0.5f) + floor(src.x * 255.0f + 0.5f);
+	vfloat palX = (mod(palIndex, 256.0f) + 0.5f) / 256.0f;
+	vfloat palY = (floor(palIndex / 256.0f) + 0.5f) / 256.0f;
+	vvec4 color = swTexture(in, 1, vvec2(palX, palY));
+	COLOR = vvec4(color.xyz(), color.w * src.w) * COLOR;
+	packColor(COLOR, in.rgba);
+}
+#endif
+
+		// --- PartialWhiteMask ---
+struct PartialWhiteMask_Uniforms
+{
+};
+
+static nCine::RHI::Software::sw::vec4 PartialWhiteMask_maskSample(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 uv)
+{
+	using namespace nCine::RHI::Software::sw;
+	const PartialWhiteMask_Uniforms* unis = static_cast<const PartialWhiteMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vec4 src = swTexture(in, 0, uv);
+	return src;
+}
+
+void PartialWhiteMask_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	const PartialWhiteMask_Uniforms* unis = static_cast<const PartialWhiteMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vec4 tex = PartialWhiteMask_maskSample(in, vec2(in.u, in.v));
+	float color = min((0.299f * tex.r + 0.587f * tex.g + 0.114f * tex.b) * 2.5f, 1.0f);
+	COLOR = vec4(color, color, color, tex.a) * COLOR;
+	packColor(COLOR, in.rgba);
+}
+
+static nCine::RHI::Software::sw::wide4::vvec4 PartialWhiteMask_maskSample4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec2 uv)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const PartialWhiteMask_Uniforms* unis = static_cast<const PartialWhiteMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 src = swTexture(in, 0, uv);
+	return src;
+}
+
+void PartialWhiteMask_Fragment4(const nCine::RHI::Software::FragmentShaderInput4& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const PartialWhiteMask_Uniforms* unis = static_cast<const PartialWhiteMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vvec4 tex = PartialWhiteMask_maskSample4(in, swTexCoords(in));
+	vfloat color = min((0.299f * tex.x + 0.587f * tex.y + 0.114f * tex.z) * 2.5f, 1.0f);
+	COLOR = vvec4(color, color, color, tex.w) * COLOR;
+	packColor(COLOR, in.rgba);
+}
+
+#if defined(SW_WIDE8)
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vvec4 PartialWhiteMask_maskSample8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec2 uv)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const PartialWhiteMask_Uniforms* unis = static_cast<const PartialWhiteMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 src = swTexture(in, 0, uv);
+	return src;
+}
+
+DEATH_ENABLE_AVX2 void PartialWhiteMask_Fragment8(const nCine::RHI::Software::FragmentShaderInput8& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const PartialWhiteMask_Uniforms* unis = static_cast<const PartialWhiteMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vvec4 tex = PartialWhiteMask_maskSample8(in, swTexCoords(in));
+	vfloat color = min((0.299f * tex.x + 0.587f * tex.y + 0.114f * tex.z) * 2.5f, 1.0f);
+	COLOR = vvec4(color, color, color, tex.w) * COLOR;
+	packColor(COLOR, in.rgba);
+}
+#endif
+
+		// --- PartialWhiteMask_USE_PALETTE ---
+struct PartialWhiteMask_USE_PALETTE_Uniforms
+{
+	float vPaletteOffset;
+};
+
+void PartialWhiteMask_USE_PALETTE_ComputeVaryings(void* inputs, const std::uint8_t* instanceBlock)
+{
+	using namespace nCine::RHI::Software::sw;
+	PartialWhiteMask_USE_PALETTE_Uniforms* io = static_cast<PartialWhiteMask_USE_PALETTE_Uniforms*>(inputs);
+	(void)io;
+	(void)instanceBlock;
+	io->vPaletteOffset = (*reinterpret_cast<const float*>(instanceBlock + 104));
+}
+
+static nCine::RHI::Software::sw::vec4 PartialWhiteMask_USE_PALETTE_maskSample(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 uv)
+{
+	using namespace nCine::RHI::Software::sw;
+	const PartialWhiteMask_USE_PALETTE_Uniforms* unis = static_cast<const PartialWhiteMask_USE_PALETTE_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vec4 src = swTexture(in, 0, uv);
+	float palIndex = floor(unis->vPaletteOffset + 0.5f) + floor(src.r * 255.0f + 0.5f);
+	float palX = (mod(palIndex, 256.0f) + 0.5f) / 256.0f;
+	float palY = (floor(palIndex / 256.0f) + 0.5f) / 256.0f;
+	vec4 c = swTexture(in, 1, vec2(palX, palY));
+	return vec4(c.xyz(), c.a * src.a);
+}
+
+void PartialWhiteMask_USE_PALETTE_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	const PartialWhiteMask_USE_PALETTE_Uniforms* unis = static_cast<const PartialWhiteMask_USE_PALETTE_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vec4 tex = PartialWhiteMask_USE_PALETTE_maskSample(in, vec2(in.u, in.v));
+	float color = min((0.299f * tex.r + 0.587f * tex.g + 0.114f * tex.b) * 2.5f, 1.0f);
+	COLOR = vec4(color, color, color, tex.a) * COLOR;
+	packColor(COLOR, in.rgba);
+}
+
+static nCine::RHI::Software::sw::wide4::vvec4 PartialWhiteMask_USE_PALETTE_maskSample4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec2 uv)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const PartialWhiteMask_USE_PALETTE_Uniforms* unis = static_cast<const PartialWhiteMask_USE_PALETTE_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 src = swTexture(in, 0, uv);
+	vfloat palIndex = floor(unis->vPaletteOffset + 0.5f) + floor(src.x * 255.0f + 0.5f);
+	vfloat palX = (mod(palIndex, 256.0f) + 0.5f) / 256.0f;
+	vfloat palY = (floor(palIndex / 256.0f) + 0.5f) / 256.0f;
+	vvec4 c = swTexture(in, 1, vvec2(palX, palY));
+	return vvec4(c.xyz(), c.w * src.w);
+}
+
+void PartialWhiteMask_USE_PALETTE_Fragment4(const nCine::RHI::Software::FragmentShaderInput4& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const PartialWhiteMask_USE_PALETTE_Uniforms* unis = static_cast<const PartialWhiteMask_USE_PALETTE_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vvec4 tex = PartialWhiteMask_USE_PALETTE_maskSample4(in, swTexCoords(in));
+	vfloat color = min((0.299f * tex.x + 0.587f * tex.y + 0.114f * tex.z) * 2.5f, 1.0f);
+	COLOR = vvec4(color, color, color, tex.w) * COLOR;
+	packColor(COLOR, in.rgba);
+}
+
+#if defined(SW_WIDE8)
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vvec4 PartialWhiteMask_USE_PALETTE_maskSample8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec2 uv)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const PartialWhiteMask_USE_PALETTE_Uniforms* unis = static_cast<const PartialWhiteMask_USE_PALETTE_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 src = swTexture(in, 0, uv);
+	vfloat palIndex = floor(unis->vPaletteOffset + 0.5f) + floor(src.x * 255.0f + 0.5f);
+	vfloat palX = (mod(palIndex, 256.0f) + 0.5f) / 256.0f;
+	vfloat palY = (floor(palIndex / 256.0f) + 0.5f) / 256.0f;
+	vvec4 c = swTexture(in, 1, vvec2(palX, palY));
+	return vvec4(c.xyz(), c.w * src.w);
+}
+
+DEATH_ENABLE_AVX2 void PartialWhiteMask_USE_PALETTE_Fragment8(const nCine::RHI::Software::FragmentShaderInput8& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const PartialWhiteMask_USE_PALETTE_Uniforms* unis = static_cast<const PartialWhiteMask_USE_PALETTE_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vvec4 tex = PartialWhiteMask_USE_PALETTE_maskSample8(in, swTexCoords(in));
+	vfloat color = min((0.299f * tex.x + 0.587f * tex.y + 0.114f * tex.z) * 2.5f, 1.0f);
+	COLOR = vvec4(color, color, color, tex.w) * COLOR;
+	packColor(COLOR, in.rgba);
+}
+#endif
+
+		// --- BatchedPartialWhiteMask ---
+struct BatchedPartialWhiteMask_Uniforms
+{
+};
+
+static nCine::RHI::Software::sw::vec4 BatchedPartialWhiteMask_maskSample(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 uv)
+{
+	using namespace nCine::RHI::Software::sw;
+	const BatchedPartialWhiteMask_Uniforms* unis = static_cast<const BatchedPartialWhiteMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vec4 src = swTexture(in, 0, uv);
+	return src;
+}
+
+void BatchedPartialWhiteMask_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	const BatchedPartialWhiteMask_Uniforms* unis = static_cast<const BatchedPartialWhiteMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vec4 tex = BatchedPartialWhiteMask_maskSample(in, vec2(in.u, in.v));
+	float color = min((0.299f * tex.r + 0.587f * tex.g + 0.114f * tex.b) * 2.5f, 1.0f);
+	COLOR = vec4(color, color, color, tex.a) * COLOR;
+	packColor(COLOR, in.rgba);
+}
+
+static nCine::RHI::Software::sw::wide4::vvec4 BatchedPartialWhiteMask_maskSample4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec2 uv)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const BatchedPartialWhiteMask_Uniforms* unis = static_cast<const BatchedPartialWhiteMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 src = swTexture(in, 0, uv);
+	return src;
+}
+
+void BatchedPartialWhiteMask_Fragment4(const nCine::RHI::Software::FragmentShaderInput4& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const BatchedPartialWhiteMask_Uniforms* unis = static_cast<const BatchedPartialWhiteMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vvec4 tex = BatchedPartialWhiteMask_maskSample4(in, swTexCoords(in));
+	vfloat color = min((0.299f * tex.x + 0.587f * tex.y + 0.114f * tex.z) * 2.5f, 1.0f);
+	COLOR = vvec4(color, color, color, tex.w) * COLOR;
+	packColor(COLOR, in.rgba);
+}
+
+#if defined(SW_WIDE8)
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vvec4 BatchedPartialWhiteMask_maskSample8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec2 uv)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const BatchedPartialWhiteMask_Uniforms* unis = static_cast<const BatchedPartialWhiteMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 src = swTexture(in, 0, uv);
+	return src;
+}
+
+DEATH_ENABLE_AVX2 void BatchedPartialWhiteMask_Fragment8(const nCine::RHI::Software::FragmentShaderInput8& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const BatchedPartialWhiteMask_Uniforms* unis = static_cast<const BatchedPartialWhiteMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vvec4 tex = BatchedPartialWhiteMask_maskSample8(in, swTexCoords(in));
+	vfloat color = min((0.299f * tex.x + 0.587f * tex.y + 0.114f * tex.z) * 2.5f, 1.0f);
+	COLOR = vvec4(color, color, color, tex.w) * COLOR;
+	packColor(COLOR, in.rgba);
+}
+#endif
+
+		// --- BatchedPartialWhiteMask_USE_PALETTE ---
+struct BatchedPartialWhiteMask_USE_PALETTE_Uniforms
+{
+	float vPaletteOffset;
+};
+
+void BatchedPartialWhiteMask_USE_PALETTE_ComputeVaryings(void* inputs, const std::uint8_t* instanceBlock)
+{
+	using namespace nCine::RHI::Software::sw;
+	BatchedPartialWhiteMask_USE_PALETTE_Uniforms* io = static_cast<BatchedPartialWhiteMask_USE_PALETTE_Uniforms*>(inputs);
+	(void)io;
+	(void)instanceBlock;
+	io->vPaletteOffset = (*reinterpret_cast<const float*>(instanceBlock + 104));
+}
+
+static nCine::RHI::Software::sw::vec4 BatchedPartialWhiteMask_USE_PALETTE_maskSample(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 uv)
+{
+	using namespace nCine::RHI::Software::sw;
+	const BatchedPartialWhiteMask_USE_PALETTE_Uniforms* unis = static_cast<const BatchedPartialWhiteMask_USE_PALETTE_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vec4 src = swTexture(in, 0, uv);
+	float palIndex = floor(unis->vPaletteOffset + 0.5f) + floor(src.r * 255.0f + 0.5f);
+	float palX = (mod(palIndex, 256.0f) + 0.5f) / 256.0f;
+	float palY = (floor(palIndex / 256.0f) + 0.5f) / 256.0f;
+	vec4 c = swTexture(in, 1, vec2(palX, palY));
+	return vec4(c.xyz(), c.a * src.a);
+}
+
+void BatchedPartialWhiteMask_USE_PALETTE_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	const BatchedPartialWhiteMask_USE_PALETTE_Uniforms* unis = static_cast<const BatchedPartialWhiteMask_USE_PALETTE_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vec4 tex = BatchedPartialWhiteMask_USE_PALETTE_maskSample(in, vec2(in.u, in.v));
+	float color = min((0.299f * tex.r + 0.587f * tex.g + 0.114f * tex.b) * 2.5f, 1.0f);
+	COLOR = vec4(color, color, color, tex.a) * COLOR;
+	packColor(COLOR, in.rgba);
+}
+
+static nCine::RHI::Software::sw::wide4::vvec4 BatchedPartialWhiteMask_USE_PALETTE_maskSample4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec2 uv)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const BatchedPartialWhiteMask_USE_PALETTE_Uniforms* unis = static_cast<const BatchedPartialWhiteMask_USE_PALETTE_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 src = swTexture(in, 0, uv);
+	vfloat palIndex = floor(unis->vPaletteOffset + 0.5f) + floor(src.x * 255.0f + 0.5f);
+	vfloat palX = (mod(palIndex, 256.0f) + 0.5f) / 256.0f;
+	vfloat palY = (floor(palIndex / 256.0f) + 0.5f) / 256.0f;
+	vvec4 c = swTexture(in, 1, vvec2(palX, palY));
+	return vvec4(c.xyz(), c.w * src.w);
+}
+
+void BatchedPartialWhiteMask_USE_PALETTE_Fragment4(const nCine::RHI::Software::FragmentShaderInput4& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const BatchedPartialWhiteMask_USE_PALETTE_Uniforms* unis = static_cast<const BatchedPartialWhiteMask_USE_PALETTE_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vvec4 tex = BatchedPartialWhiteMask_USE_PALETTE_maskSample4(in, swTexCoords(in));
+	vfloat color = min((0.299f * tex.x + 0.587f * tex.y + 0.114f * tex.z) * 2.5f, 1.0f);
+	COLOR = vvec4(color, color, color, tex.w) * COLOR;
+	packColor(COLOR, in.rgba);
+}
+
+#if defined(SW_WIDE8)
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vvec4 BatchedPartialWhiteMask_USE_PALETTE_maskSample8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec2 uv)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const BatchedPartialWhiteMask_USE_PALETTE_Uniforms* unis = static_cast<const BatchedPartialWhiteMask_USE_PALETTE_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 src = swTexture(in, 0, uv);
+	vfloat palIndex = floor(unis->vPaletteOffset + 0.5f) + floor(src.x * 255.0f + 0.5f);
+	vfloat palX = (mod(palIndex, 256.0f) + 0.5f) / 256.0f;
+	vfloat palY = (floor(palIndex / 256.0f) + 0.5f) / 256.0f;
+	vvec4 c = swTexture(in, 1, vvec2(palX, palY));
+	return vvec4(c.xyz(), c.w * src.w);
+}
+
+DEATH_ENABLE_AVX2 void BatchedPartialWhiteMask_USE_PALETTE_Fragment8(const nCine::RHI::Software::FragmentShaderInput8& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const BatchedPartialWhiteMask_USE_PALETTE_Uniforms* unis = static_cast<const BatchedPartialWhiteMask_USE_PALETTE_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vvec4 tex = BatchedPartialWhiteMask_USE_PALETTE_maskSample8(in, swTexCoords(in));
+	vfloat color = min((0.299f * tex.x + 0.587f * tex.y + 0.114f * tex.z) * 2.5f, 1.0f);
+	COLOR = vvec4(color, color, color, tex.w) * COLOR;
+	packColor(COLOR, in.rgba);
+}
+#endif
+
+		// --- ResizeCrtApertureGrille ---
+struct ResizeCrtApertureGrille_Uniforms
+{
+	nCine::RHI::Software::sw::vec2 vTexSize;
+	nCine::RHI::Software::sw::vec2 vViewSize;
+};
+
+void ResizeCrtApertureGrille_ComputeVaryings(void* inputs, const std::uint8_t* instanceBlock)
+{
+	using namespace nCine::RHI::Software::sw;
+	ResizeCrtApertureGrille_Uniforms* io = static_cast<ResizeCrtApertureGrille_Uniforms*>(inputs);
+	(void)io;
+	(void)instanceBlock;
+	io->vTexSize = (*reinterpret_cast<const vec4*>(instanceBlock + 80)).xy();
+	io->vViewSize = (*reinterpret_cast<const vec2*>(instanceBlock + 96));
+}
+
+static float ResizeCrtApertureGrille_ToLinear1(const nCine::RHI::Software::FragmentShaderInput& in, float c)
+{
+	using namespace nCine::RHI::Software::sw;
+	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	if (1 == 0) {
+		return c;
+	}
+	return c <= 0.04045f ? c / 12.92f : pow((c + 0.055f) / 1.055f, 2.4f);
+}
+
+static nCine::RHI::Software::sw::vec3 ResizeCrtApertureGrille_ToLinear(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec3 c)
+{
+	using namespace nCine::RHI::Software::sw;
+	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	if (1 == 0) {
+		return c;
+	}
+	return vec3(ResizeCrtApertureGrille_ToLinear1(in, c.r), ResizeCrtApertureGrille_ToLinear1(in, c.g), ResizeCrtApertureGrille_ToLinear1(in, c.b));
+}
+
+static float ResizeCrtApertureGrille_ToSrgb1(const nCine::RHI::Software::FragmentShaderInput& in, float c)
+{
+	using namespace nCine::RHI::Software::sw;
+	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	if (1 == 0) {
+		return c;
+	}
+	return c < 0.0031308f ? c * 12.92f : 1.055f * pow(c, 0.41666f) - 0.055f;
+}
+
+static nCine::RHI::Software::sw::vec3 ResizeCrtApertureGrille_ToSrgb(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec3 c)
+{
+	using namespace nCine::RHI::Software::sw;
+	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	if (1 == 0) {
+		return c;
+	}
+	return vec3(ResizeCrtApertureGrille_ToSrgb1(in, c.r), ResizeCrtApertureGrille_ToSrgb1(in, c.g), ResizeCrtApertureGrille_ToSrgb1(in, c.b));
+}
+
+static nCine::RHI::Software::sw::vec3 ResizeCrtApertureGrille_Fetch(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 pos, nCine::RHI::Software::sw::vec2 off, nCine::RHI::Software::sw::vec2 texture_size)
+{
+	using namespace nCine::RHI::Software::sw;
+	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	pos = (floor(pos * texture_size.xy() + off) + vec2(0.5f, 0.5f)) / texture_size.xy();
+	return ResizeCrtApertureGrille_ToLinear(in, vec3(1.1f) * swTexture(in, 0, pos.xy()).xyz());
+}
+
+static nCine::RHI::Software::sw::vec2 ResizeCrtApertureGrille_Dist(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 pos, nCine::RHI::Software::sw::vec2 texture_size)
+{
+	using namespace nCine::RHI::Software::sw;
+	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	pos = pos * texture_size.xy();
+	return -(pos - floor(pos) - vec2(0.5f, 0.5f));
+}
+
+static float ResizeCrtApertureGrille_Gaus(const nCine::RHI::Software::FragmentShaderInput& in, float pos, float scale)
+{
+	using namespace nCine::RHI::Software::sw;
+	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	return exp2(scale * pow(abs(pos), 2.0f));
+}
+
+static nCine::RHI::Software::sw::vec3 ResizeCrtApertureGrille_Horz3(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 pos, float off, nCine::RHI::Software::sw::vec2 texture_size)
+{
+	using namespace nCine::RHI::Software::sw;
+	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vec3 b = ResizeCrtApertureGrille_Fetch(in, pos, vec2(-1.0f, off), texture_size);
+	vec3 c = ResizeCrtApertureGrille_Fetch(in, pos, vec2(0.0f, off), texture_size);
+	vec3 d = ResizeCrtApertureGrille_Fetch(in, pos, vec2(1.0f, off), texture_size);
+	float dst = ResizeCrtApertureGrille_Dist(in, pos, texture_size).x;
+	float scale = -3.0f;
+	float wb = ResizeCrtApertureGrille_Gaus(in, dst - 1.0f, scale);
+	float wc = ResizeCrtApertureGrille_Gaus(in, dst + 0.0f, scale);
+	float wd = ResizeCrtApertureGrille_Gaus(in, dst + 1.0f, scale);
+	return (b * wb + c * wc + d * wd) / (wb + wc + wd);
+}
+
+static nCine::RHI::Software::sw::vec3 ResizeCrtApertureGrille_Horz5(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 pos, float off, nCine::RHI::Software::sw::vec2 texture_size)
+{
+	using namespace nCine::RHI::Software::sw;
+	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vec3 a = ResizeCrtApertureGrille_Fetch(in, pos, vec2(-2.0f, off), texture_size);
+	vec3 b = ResizeCrtApertureGrille_Fetch(in, pos, vec2(-1.0f, off), texture_size);
+	vec3 c = ResizeCrtApertureGrille_Fetch(in, pos, vec2(0.0f, off), texture_size);
+	vec3 d = ResizeCrtApertureGrille_Fetch(in, pos, vec2(1.0f, off), texture_size);
+	vec3 e = ResizeCrtApertureGrille_Fetch(in, pos, vec2(2.0f, off), texture_size);
+	float dst = ResizeCrtApertureGrille_Dist(in, pos, texture_size).x;
+	float scale = -3.0f;
+	float wa = ResizeCrtApertureGrille_Gaus(in, dst - 2.0f, scale);
+	float wb = ResizeCrtApertureGrille_Gaus(in, dst - 1.0f, scale);
+	float wc = ResizeCrtApertureGrille_Gaus(in, dst + 0.0f, scale);
+	float wd = ResizeCrtApertureGrille_Gaus(in, dst + 1.0f, scale);
+	float we = ResizeCrtApertureGrille_Gaus(in, dst + 2.0f, scale);
+	return (a * wa + b * wb + c * wc + d * wd + e * we) / (wa + wb + wc + wd + we);
+}
+
+static nCine::RHI::Software::sw::vec3 ResizeCrtApertureGrille_Horz7(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 pos, float off, nCine::RHI::Software::sw::vec2 texture_size)
+{
+	using namespace nCine::RHI::Software::sw;
+	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vec3 a = ResizeCrtApertureGrille_Fetch(in, pos, vec2(-3.0f, off), texture_size);
+	vec3 b = ResizeCrtApertureGrille_Fetch(in, pos, vec2(-2.0f, off), texture_size);
+	vec3 c = ResizeCrtApertureGrille_Fetch(in, pos, vec2(-1.0f, off), texture_size);
+	vec3 d = ResizeCrtApertureGrille_Fetch(in, pos, vec2(0.0f, off), texture_size);
+	vec3 e = ResizeCrtApertureGrille_Fetch(in, pos, vec2(1.0f, off), texture_size);
+	vec3 f = ResizeCrtApertureGrille_Fetch(in, pos, vec2(2.0f, off), texture_size);
+	vec3 g = ResizeCrtApertureGrille_Fetch(in, pos, vec2(3.0f, off), texture_size);
+	float dst = ResizeCrtApertureGrille_Dist(in, pos, texture_size).x;
+	float scale = -1.5f;
+	float wa = ResizeCrtApertureGrille_Gaus(in, dst - 3.0f, scale);
+	float wb = ResizeCrtApertureGrille_Gaus(in, dst - 2.0f, scale);
+	float wc = ResizeCrtApertureGrille_Gaus(in, dst - 1.0f, scale);
+	float wd = ResizeCrtApertureGrille_Gaus(in, dst + 0.0f, scale);
+	float we = ResizeCrtApertureGrille_Gaus(in, dst + 1.0f, scale);
+	float wf = ResizeCrtApertureGrille_Gaus(in, dst + 2.0f, scale);
+	float wg = ResizeCrtApertureGrille_Gaus(in, dst + 3.0f, scale);
+	return (a * wa + b * wb + c * wc + d * wd + e * we + f * wf + g * wg) / (wa + wb + wc + wd + we + wf + wg);
+}
+
+static float ResizeCrtApertureGrille_Scan(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 pos, float off, nCine::RHI::Software::sw::vec2 texture_size)
+{
+	using namespace nCine::RHI::Software::sw;
+	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	float dst = ResizeCrtApertureGrille_Dist(in, pos, texture_size).y;
+	return ResizeCrtApertureGrille_Gaus(in, dst + off, -8.0f);
+}
+
+static float ResizeCrtApertureGrille_BloomScan(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 pos, float off, nCine::RHI::Software::sw::vec2 texture_size)
+{
+	using namespace nCine::RHI::Software::sw;
+	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	float dst = ResizeCrtApertureGrille_Dist(in, pos, texture_size).y;
+	return ResizeCrtApertureGrille_Gaus(in, dst + off, -2.0f);
+}
+
+static nCine::RHI::Software::sw::vec3 ResizeCrtApertureGrille_Tri(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 pos, nCine::RHI::Software::sw::vec2 texture_size)
+{
+	using namespace nCine::RHI::Software::sw;
+	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vec3 a = ResizeCrtApertureGrille_Horz3(in, pos, -1.0f, texture_size);
+	vec3 b = ResizeCrtApertureGrille_Horz5(in, pos, 0.0f, texture_size);
+	vec3 c = ResizeCrtApertureGrille_Horz3(in, pos, 1.0f, texture_size);
+	float wa = ResizeCrtApertureGrille_Scan(in, pos, -1.0f, texture_size);
+	float wb = ResizeCrtApertureGrille_Scan(in, pos, 0.0f, texture_size);
+	float wc = ResizeCrtApertureGrille_Scan(in, pos, 1.0f, texture_size);
+	return a * wa + b * wb + c * wc;
+}
+
+static nCine::RHI::Software::sw::vec3 ResizeCrtApertureGrille_Bloom(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 pos, nCine::RHI::Software::sw::vec2 texture_size)
+{
+	using namespace nCine::RHI::Software::sw;
+	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vec3 a = ResizeCrtApertureGrille_Horz5(in, pos, -2.0f, texture_size);
+	vec3 b = ResizeCrtApertureGrille_Horz7(in, pos, -1.0f, texture_size);
+	vec3 c = ResizeCrtApertureGrille_Horz7(in, pos, 0.0f, texture_size);
+	vec3 d = ResizeCrtApertureGrille_Horz7(in, pos, 1.0f, texture_size);
+	vec3 e = ResizeCrtApertureGrille_Horz5(in, pos, 2.0f, texture_size);
+	float wa = ResizeCrtApertureGrille_BloomScan(in, pos, -2.0f, texture_size);
+	float wb = ResizeCrtApertureGrille_BloomScan(in, pos, -1.0f, texture_size);
+	float wc = ResizeCrtApertureGrille_BloomScan(in, pos, 0.0f, texture_size);
+	float wd = ResizeCrtApertureGrille_BloomScan(in, pos, 1.0f, texture_size);
+	float we = ResizeCrtApertureGrille_BloomScan(in, pos, 2.0f, texture_size);
+	return a * wa + b * wb + c * wc + d * wd + e * we;
+}
+
+static nCine::RHI::Software::sw::vec2 ResizeCrtApertureGrille_Warp(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 pos)
+{
+	using namespace nCine::RHI::Software::sw;
+	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	pos = pos * 2.0f - 1.0f;
+	pos *= vec2(1.0f + pos.y * pos.y * 0.0155f, 1.0f + pos.x * pos.x * 0.0205f);
+	return pos * 0.5f + 0.5f;
+}
+
+static nCine::RHI::Software::sw::vec3 ResizeCrtApertureGrille_Mask(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 pos)
+{
+	using namespace nCine::RHI::Software::sw;
+	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vec3 mask = vec3(0.7f, 0.7f, 0.7f);
+	pos.x = fract(pos.x / 3.0f);
+	if (pos.x < 0.333f) {
+		mask.r = 1.5f;
+	} else {
+		if (pos.x < 0.666f) {
+			mask.g = 1.5f;
+		} else {
+			mask.b = 1.5f;
+		}
+	}
+	return mask;
+}
+
+static nCine::RHI::Software::sw::vec4 ResizeCrtApertureGrille_crt_lottes(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 texture_size, nCine::RHI::Software::sw::vec2 video_size, nCine::RHI::Software::sw::vec2 output_size, nCine::RHI::Software::sw::vec2 tex)
+{
+	using namespace nCine::RHI::Software::sw;
+	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vec2 pos = ResizeCrtApertureGrille_Warp(in, tex.xy() * (texture_size.xy() / video_size.xy())) * (video_size.xy() / texture_size.xy());
+	vec3 outColor = ResizeCrtApertureGrille_Tri(in, pos, texture_size);
+	{
+		const vec3 _w = vec3(ResizeCrtApertureGrille_Bloom(in, pos, texture_size) * 1.0f / 16.0f);
+		outColor.r += _w.x;
+		outColor.g += _w.y;
+		outColor.b += _w.z;
+	}
+	{
+		const vec3 _w = vec3(ResizeCrtApertureGrille_Mask(in, floor(tex.xy() * (texture_size.xy() / video_size.xy()) * output_size.xy()) + vec2(0.5f, 0.5f)));
+		outColor.r *= _w.x;
+		outColor.g *= _w.y;
+		outColor.b *= _w.z;
+	}
+	return vec4(ResizeCrtApertureGrille_ToSrgb(in, outColor.xyz()), 1.0f);
+}
+
+void ResizeCrtApertureGrille_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vec4 COLOR;
+	COLOR = ResizeCrtApertureGrille_crt_lottes(in, unis->vTexSize, unis->vTexSize, unis->vViewSize, vec2(in.u, in.v));
+	packColor(COLOR, in.rgba);
+}
+
+static nCine::RHI::Software::sw::wide4::vfloat ResizeCrtApertureGrille_ToLinear14(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vfloat c)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	if (1 == 0) {
+		return c;
+	}
+	return select(vmask(c <= 0.04045f), c / 12.92f, pow((c + 0.055f) / 1.055f, 2.4f));
+}
+
+static nCine::RHI::Software::sw::wide4::vvec3 ResizeCrtApertureGrille_ToLinear4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec3 c)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	if (1 == 0) {
+		return c;
+	}
+	return vvec3(ResizeCrtApertureGrille_ToLinear14(in, c.x), ResizeCrtApertureGrille_ToLinear14(in, c.y), ResizeCrtApertureGrille_ToLinear14(in, c.z));
+}
+
+static nCine::RHI::Software::sw::wide4::vfloat ResizeCrtApertureGrille_ToSrgb14(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vfloat c)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	if (1 == 0) {
+		return c;
+	}
+	return select(vmask(c < 0.0031308f), c * 12.92f, 1.055f * pow(c, 0.41666f) - 0.055f);
+}
+
+static nCine::RHI::Software::sw::wide4::vvec3 ResizeCrtApertureGrille_ToSrgb4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec3 c)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	if (1 == 0) {
+		return c;
+	}
+	return vvec3(ResizeCrtApertureGrille_ToSrgb14(in, c.x), ResizeCrtApertureGrille_ToSrgb14(in, c.y), ResizeCrtApertureGrille_ToSrgb14(in, c.z));
+}
+
+static nCine::RHI::Software::sw::wide4::vvec3 ResizeCrtApertureGrille_Fetch4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec2 pos, nCine::RHI::Software::sw::wide4::vvec2 off, nCine::RHI::Software::sw::wide4::vvec2 texture_size)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	pos = (floor(pos * texture_size.xy() + off) + vec2(0.5f, 0.5f)) / texture_size.xy();
+	return ResizeCrtApertureGrille_ToLinear4(in, vec3(1.1f) * swTexture(in, 0, pos.xy()).xyz());
+}
+
+static nCine::RHI::Software::sw::wide4::vvec2 ResizeCrtApertureGrille_Dist4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec2 pos, nCine::RHI::Software::sw::wide4::vvec2 texture_size)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	pos = pos * texture_size.xy();
+	return -(pos - floor(pos) - vec2(0.5f, 0.5f));
+}
+
+static nCine::RHI::Software::sw::wide4::vfloat ResizeCrtApertureGrille_Gaus4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vfloat pos, nCine::RHI::Software::sw::wide4::vfloat scale)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	return exp2(scale * pow(abs(pos), 2.0f));
+}
+
+static nCine::RHI::Software::sw::wide4::vvec3 ResizeCrtApertureGrille_Horz34(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec2 pos, nCine::RHI::Software::sw::wide4::vfloat off, nCine::RHI::Software::sw::wide4::vvec2 texture_size)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec3 b = ResizeCrtApertureGrille_Fetch4(in, pos, vvec2(-1.0f, off), texture_size);
+	vvec3 c = ResizeCrtApertureGrille_Fetch4(in, pos, vvec2(0.0f, off), texture_size);
+	vvec3 d = ResizeCrtApertureGrille_Fetch4(in, pos, vvec2(1.0f, off), texture_size);
+	vfloat dst = ResizeCrtApertureGrille_Dist4(in, pos, texture_size).x;
+	float scale = -3.0f;
+	vfloat wb = ResizeCrtApertureGrille_Gaus4(in, dst - 1.0f, scale);
+	vfloat wc = ResizeCrtApertureGrille_Gaus4(in, dst + 0.0f, scale);
+	vfloat wd = ResizeCrtApertureGrille_Gaus4(in, dst + 1.0f, scale);
+	return (b * wb + c * wc + d * wd) / (wb + wc + wd);
+}
+
+static nCine::RHI::Software::sw::wide4::vvec3 ResizeCrtApertureGrille_Horz54(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec2 pos, nCine::RHI::Software::sw::wide4::vfloat off, nCine::RHI::Software::sw::wide4::vvec2 texture_size)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec3 a = ResizeCrtApertureGrille_Fetch4(in, pos, vvec2(-2.0f, off), texture_size);
+	vvec3 b = ResizeCrtApertureGrille_Fetch4(in, pos, vvec2(-1.0f, off), texture_size);
+	vvec3 c = ResizeCrtApertureGrille_Fetch4(in, pos, vvec2(0.0f, off), texture_size);
+	vvec3 d = ResizeCrtApertureGrille_Fetch4(in, pos, vvec2(1.0f, off), texture_size);
+	vvec3 e = ResizeCrtApertureGrille_Fetch4(in, pos, vvec2(2.0f, off), texture_size);
+	vfloat dst = ResizeCrtApertureGrille_Dist4(in, pos, texture_size).x;
+	float scale = -3.0f;
+	vfloat wa = ResizeCrtApertureGrille_Gaus4(in, dst - 2.0f, scale);
+	vfloat wb = ResizeCrtApertureGrille_Gaus4(in, dst - 1.0f, scale);
+	vfloat wc = ResizeCrtApertureGrille_Gaus4(in, dst + 0.0f, scale);
+	vfloat wd = ResizeCrtApertureGrille_Gaus4(in, dst + 1.0f, scale);
+	vfloat we = ResizeCrtApertureGrille_Gaus4(in, dst + 2.0f, scale);
+	return (a * wa + b * wb + c * wc + d * wd + e * we) / (wa + wb + wc + wd + we);
+}
+
+static nCine::RHI::Software::sw::wide4::vvec3 ResizeCrtApertureGrille_Horz74(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec2 pos, nCine::RHI::Software::sw::wide4::vfloat off, nCine::RHI::Software::sw::wide4::vvec2 texture_size)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec3 a = ResizeCrtApertureGrille_Fetch4(in, pos, vvec2(-3.0f, off), texture_size);
+	vvec3 b = ResizeCrtApertureGrille_Fetch4(in, pos, vvec2(-2.0f, off), texture_size);
+	vvec3 c = ResizeCrtApertureGrille_Fetch4(in, pos, vvec2(-1.0f, off), texture_size);
+	vvec3 d = ResizeCrtApertureGrille_Fetch4(in, pos, vvec2(0.0f, off), texture_size);
+	vvec3 e = ResizeCrtApertureGrille_Fetch4(in, pos, vvec2(1.0f, off), texture_size);
+	vvec3 f = ResizeCrtApertureGrille_Fetch4(in, pos, vvec2(2.0f, off), texture_size);
+	vvec3 g = ResizeCrtApertureGrille_Fetch4(in, pos, vvec2(3.0f, off), texture_size);
+	vfloat dst = ResizeCrtApertureGrille_Dist4(in, pos, texture_size).x;
+	float scale = -1.5f;
+	vfloat wa = ResizeCrtApertureGrille_Gaus4(in, dst - 3.0f, scale);
+	vfloat wb = ResizeCrtApertureGrille_Gaus4(in, dst - 2.0f, scale);
+	vfloat wc = ResizeCrtApertureGrille_Gaus4(in, dst - 1.0f, scale);
+	vfloat wd = ResizeCrtApertureGrille_Gaus4(in, dst + 0.0f, scale);
+	vfloat we = ResizeCrtApertureGrille_Gaus4(in, dst + 1.0f, scale);
+	vfloat wf = ResizeCrtApertureGrille_Gaus4(in, dst + 2.0f, scale);
+	vfloat wg = ResizeCrtApertureGrille_Gaus4(in, dst + 3.0f, scale);
+	return (a * wa + b * wb + c * wc + d * wd + e * we + f * wf + g * wg) / (wa + wb + wc + wd + we + wf + wg);
+}
+
+static nCine::RHI::Software::sw::wide4::vfloat ResizeCrtApertureGrille_Scan4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec2 pos, nCine::RHI::Software::sw::wide4::vfloat off, nCine::RHI::Software::sw::wide4::vvec2 texture_size)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vfloat dst = ResizeCrtApertureGrille_Dist4(in, pos, texture_size).y;
+	return ResizeCrtApertureGrille_Gaus4(in, dst + off, -8.0f);
+}
+
+static nCine::RHI::Software::sw::wide4::vfloat ResizeCrtApertureGrille_BloomScan4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec2 pos, nCine::RHI::Software::sw::wide4::vfloat off, nCine::RHI::Software::sw::wide4::vvec2 texture_size)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vfloat dst = ResizeCrtApertureGrille_Dist4(in, pos, texture_size).y;
+	return ResizeCrtApertureGrille_Gaus4(in, dst + off, -2.0f);
+}
+
+static nCine::RHI::Software::sw::wide4::vvec3 ResizeCrtApertureGrille_Tri4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec2 pos, nCine::RHI::Software::sw::wide4::vvec2 texture_size)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec3 a = ResizeCrtApertureGrille_Horz34(in, pos, -1.0f, texture_size);
+	vvec3 b = ResizeCrtApertureGrille_Horz54(in, pos, 0.0f, texture_size);
+	vvec3 c = ResizeCrtApertureGrille_Horz34(in, pos, 1.0f, texture_size);
+	vfloat wa = ResizeCrtApertureGrille_Scan4(in, pos, -1.0f, texture_size);
+	vfloat wb = ResizeCrtApertureGrille_Scan4(in, pos, 0.0f, texture_size);
+	vfloat wc = ResizeCrtApertureGrille_Scan4(in, pos, 1.0f, texture_size);
+	return a * wa + b * wb + c * wc;
+}
+
+static nCine::RHI::Software::sw::wide4::vvec3 ResizeCrtApertureGrille_Bloom4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec2 pos, nCine::RHI::Software::sw::wide4::vvec2 texture_size)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec3 a = ResizeCrtApertureGrille_Horz54(in, pos, -2.0f, texture_size);
+	vvec3 b = ResizeCrtApertureGrille_Horz74(in, pos, -1.0f, texture_size);
+	vvec3 c = ResizeCrtApertureGrille_Horz74(in, pos, 0.0f, texture_size);
+	vvec3 d = ResizeCrtApertureGrille_Horz74(in, pos, 1.0f, texture_size);
+	vvec3 e = ResizeCrtApertureGrille_Horz54(in, pos, 2.0f, texture_size);
+	vfloat wa = ResizeCrtApertureGrille_BloomScan4(in, pos, -2.0f, texture_size);
+	vfloat wb = ResizeCrtApertureGrille_BloomScan4(in, pos, -1.0f, texture_size);
+	vfloat wc = ResizeCrtApertureGrille_BloomScan4(in, pos, 0.0f, texture_size);
+	vfloat wd = ResizeCrtApertureGrille_BloomScan4(in, pos, 1.0f, texture_size);
+	vfloat we = ResizeCrtApertureGrille_BloomScan4(in, pos, 2.0f, texture_size);
+	return a * wa + b * wb + c * wc + d * wd + e * we;
+}
+
+static nCine::RHI::Software::sw::wide4::vvec2 ResizeCrtApertureGrille_Warp4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec2 pos)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	pos = pos * 2.0f - 1.0f;
+	pos *= vvec2(1.0f + pos.y * pos.y * 0.0155f, 1.0f + pos.x * pos.x * 0.0205f);
+	return pos * 0.5f + 0.5f;
+}
+
+static nCine::RHI::Software::sw::wide4::vvec3 ResizeCrtApertureGrille_Mask4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec2 pos)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec3 mask = vec3(0.7f, 0.7f, 0.7f);
+	pos.x = fract(pos.x / 3.0f);
+	const vmask _cond0 = vmask(pos.x < 0.333f);
+	const vmask _mask0 = _cond0;
+	if (any(_mask0)) {
+		mask.x = select(_mask0, 1.5f, mask.x);
+	}
+	const vmask _else0 = !_cond0;
+	if (any(_else0)) {
+		const vmask _cond1 = vmask(pos.x < 0.666f);
+		const vmask _mask1 = _else0 & _cond1;
+		if (any(_mask1)) {
+			mask.y = select(_mask1, 1.5f, mask.y);
+		}
+		const vmask _else1 = andNot(_else0, _cond1);
+		if (any(_else1)) {
+			mask.z = select(_else1, 1.5f, mask.z);
+		}
+	}
+	return mask;
+}
+
+static nCine::RHI::Software::sw::wide4::vvec4 ResizeCrtApertureGrille_crt_lottes4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec2 texture_size, nCine::RHI::Software::sw::wide4::vvec2 video_size, nCine::RHI::Software::sw::wide4::vvec2 output_size, nCine::RHI::Software::sw::wide4::vvec2 tex)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec2 pos = ResizeCrtApertureGrille_Warp4(in, tex.xy() * (texture_size.xy() / video_size.xy())) * (video_size.xy() / texture_size.xy());
+	vvec3 outColor = ResizeCrtApertureGrille_Tri4(in, pos, texture_size);
+	{
+		const vvec3 _w = vvec3(ResizeCrtApertureGrille_Bloom4(in, pos, texture_size) * 1.0f / 16.0f);
+		outColor.x += _w.x;
+		outColor.y += _w.y;
+		outColor.z += _w.z;
+	}
+	{
+		const vvec3 _w = vvec3(ResizeCrtApertureGrille_Mask4(in, floor(tex.xy() * (texture_size.xy() / video_size.xy()) * output_size.xy()) + vec2(0.5f, 0.5f)));
+		outColor.x *= _w.x;
+		outColor.y *= _w.y;
+		outColor.z *= _w.z;
+	}
+	return vvec4(ResizeCrtApertureGrille_ToSrgb4(in, outColor.xyz()), 1.0f);
+}
+
+void ResizeCrtApertureGrille_Fragment4(const nCine::RHI::Software::FragmentShaderInput4& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = ResizeCrtApertureGrille_crt_lottes4(in, unis->vTexSize, unis->vTexSize, unis->vViewSize, swTexCoords(in));
+	packColor(COLOR, in.rgba);
+}
+
+#if defined(SW_WIDE8)
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vfloat ResizeCrtApertureGrille_ToLinear18(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vfloat c)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	if (1 == 0) {
+		return c;
+	}
+	return select(vmask(c <= 0.04045f), c / 12.92f, pow((c + 0.055f) / 1.055f, 2.4f));
+}
+
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vvec3 ResizeCrtApertureGrille_ToLinear8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec3 c)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	if (1 == 0) {
+		return c;
+	}
+	return vvec3(ResizeCrtApertureGrille_ToLinear18(in, c.x), ResizeCrtApertureGrille_ToLinear18(in, c.y), ResizeCrtApertureGrille_ToLinear18(in, c.z));
+}
+
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vfloat ResizeCrtApertureGrille_ToSrgb18(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vfloat c)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	if (1 == 0) {
+		return c;
+	}
+	return select(vmask(c < 0.0031308f), c * 12.92f, 1.055f * pow(c, 0.41666f) - 0.055f);
+}
+
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vvec3 ResizeCrtApertureGrille_ToSrgb8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec3 c)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	if (1 == 0) {
+		return c;
+	}
+	return vvec3(ResizeCrtApertureGrille_ToSrgb18(in, c.x), ResizeCrtApertureGrille_ToSrgb18(in, c.y), ResizeCrtApertureGrille_ToSrgb18(in, c.z));
+}
+
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vvec3 ResizeCrtApertureGrille_Fetch8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec2 pos, nCine::RHI::Software::sw::wide8::vvec2 off, nCine::RHI::Software::sw::wide8::vvec2 texture_size)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	pos = (floor(pos * texture_size.xy() + off) + vec2(0.5f, 0.5f)) / texture_size.xy();
+	return ResizeCrtApertureGrille_ToLinear8(in, vec3(1.1f) * swTexture(in, 0, pos.xy()).xyz());
+}
+
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vvec2 ResizeCrtApertureGrille_Dist8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec2 pos, nCine::RHI::Software::sw::wide8::vvec2 texture_size)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	pos = pos * texture_size.xy();
+	return -(pos - floor(pos) - vec2(0.5f, 0.5f));
+}
+
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vfloat ResizeCrtApertureGrille_Gaus8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vfloat pos, nCine::RHI::Software::sw::wide8::vfloat scale)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	return exp2(scale * pow(abs(pos), 2.0f));
+}
+
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vvec3 ResizeCrtApertureGrille_Horz38(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec2 pos, nCine::RHI::Software::sw::wide8::vfloat off, nCine::RHI::Software::sw::wide8::vvec2 texture_size)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec3 b = ResizeCrtApertureGrille_Fetch8(in, pos, vvec2(-1.0f, off), texture_size);
+	vvec3 c = ResizeCrtApertureGrille_Fetch8(in, pos, vvec2(0.0f, off), texture_size);
+	vvec3 d = ResizeCrtApertureGrille_Fetch8(in, pos, vvec2(1.0f, off), texture_size);
+	vfloat dst = ResizeCrtApertureGrille_Dist8(in, pos, texture_size).x;
+	float scale = -3.0f;
+	vfloat wb = ResizeCrtApertureGrille_Gaus8(in, dst - 1.0f, scale);
+	vfloat wc = ResizeCrtApertureGrille_Gaus8(in, dst + 0.0f, scale);
+	vfloat wd = ResizeCrtApertureGrille_Gaus8(in, dst + 1.0f, scale);
+	return (b * wb + c * wc + d * wd) / (wb + wc + wd);
+}
+
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vvec3 ResizeCrtApertureGrille_Horz58(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec2 pos, nCine::RHI::Software::sw::wide8::vfloat off, nCine::RHI::Software::sw::wide8::vvec2 texture_size)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec3 a = ResizeCrtApertureGrille_Fetch8(in, pos, vvec2(-2.0f, off), texture_size);
+	vvec3 b = ResizeCrtApertureGrille_Fetch8(in, pos, vvec2(-1.0f, off), texture_size);
+	vvec3 c = ResizeCrtApertureGrille_Fetch8(in, pos, vvec2(0.0f, off), texture_size);
+	vvec3 d = ResizeCrtApertureGrille_Fetch8(in, pos, vvec2(1.0f, off), texture_size);
+	vvec3 e = ResizeCrtApertureGrille_Fetch8(in, pos, vvec2(2.0f, off), texture_size);
+	vfloat dst = ResizeCrtApertureGrille_Dist8(in, pos, texture_size).x;
+	float scale = -3.0f;
+	vfloat wa = ResizeCrtApertureGrille_Gaus8(in, dst - 2.0f, scale);
+	vfloat wb = ResizeCrtApertureGrille_Gaus8(in, dst - 1.0f, scale);
+	vfloat wc = ResizeCrtApertureGrille_Gaus8(in, dst + 0.0f, scale);
+	vfloat wd = ResizeCrtApertureGrille_Gaus8(in, dst + 1.0f, scale);
+	vfloat we = ResizeCrtApertureGrille_Gaus8(in, dst + 2.0f, scale);
+	return (a * wa + b * wb + c * wc + d * wd + e * we) / (wa + wb + wc + wd + we);
+}
+
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vvec3 ResizeCrtApertureGrille_Horz78(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec2 pos, nCine::RHI::Software::sw::wide8::vfloat off, nCine::RHI::Software::sw::wide8::vvec2 texture_size)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec3 a = ResizeCrtApertureGrille_Fetch8(in, pos, vvec2(-3.0f, off), texture_size);
+	vvec3 b = ResizeCrtApertureGrille_Fetch8(in, pos, vvec2(-2.0f, off), texture_size);
+	vvec3 c = ResizeCrtApertureGrille_Fetch8(in, pos, vvec2(-1.0f, off), texture_size);
+	vvec3 d = ResizeCrtApertureGrille_Fetch8(in, pos, vvec2(0.0f, off), texture_size);
+	vvec3 e = ResizeCrtApertureGrille_Fetch8(in, pos, vvec2(1.0f, off), texture_size);
+	vvec3 f = ResizeCrtApertureGrille_Fetch8(in, pos, vvec2(2.0f, off), texture_size);
+	vvec3 g = ResizeCrtApertureGrille_Fetch8(in, pos, vvec2(3.0f, off), texture_size);
+	vfloat dst = ResizeCrtApertureGrille_Dist8(in, pos, texture_size).x;
+	float scale = -1.5f;
+	vfloat wa = ResizeCrtApertureGrille_Gaus8(in, dst - 3.0f, scale);
+	vfloat wb = ResizeCrtApertureGrille_Gaus8(in, dst - 2.0f, scale);
+	vfloat wc = ResizeCrtApertureGrille_Gaus8(in, dst - 1.0f, scale);
+	vfloat wd = ResizeCrtApertureGrille_Gaus8(in, dst + 0.0f, scale);
+	vfloat we = ResizeCrtApertureGrille_Gaus8(in, dst + 1.0f, scale);
+	vfloat wf = ResizeCrtApertureGrille_Gaus8(in, dst + 2.0f, scale);
+	vfloat wg = ResizeCrtApertureGrille_Gaus8(in, dst + 3.0f, scale);
+	return (a * wa + b * wb + c * wc + d * wd + e * we + f * wf + g * wg) / (wa + wb + wc + wd + we + wf + wg);
+}
+
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vfloat ResizeCrtApertureGrille_Scan8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec2 pos, nCine::RHI::Software::sw::wide8::vfloat off, nCine::RHI::Software::sw::wide8::vvec2 texture_size)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vfloat dst = ResizeCrtApertureGrille_Dist8(in, pos, texture_size).y;
+	return ResizeCrtApertureGrille_Gaus8(in, dst + off, -8.0f);
+}
+
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vfloat ResizeCrtApertureGrille_BloomScan8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec2 pos, nCine::RHI::Software::sw::wide8::vfloat off, nCine::RHI::Software::sw::wide8::vvec2 texture_size)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vfloat dst = ResizeCrtApertureGrille_Dist8(in, pos, texture_size).y;
+	return ResizeCrtApertureGrille_Gaus8(in, dst + off, -2.0f);
+}
+
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vvec3 ResizeCrtApertureGrille_Tri8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec2 pos, nCine::RHI::Software::sw::wide8::vvec2 texture_size)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec3 a = ResizeCrtApertureGrille_Horz38(in, pos, -1.0f, texture_size);
+	vvec3 b = ResizeCrtApertureGrille_Horz58(in, pos, 0.0f, texture_size);
+	vvec3 c = ResizeCrtApertureGrille_Horz38(in, pos, 1.0f, texture_size);
+	vfloat wa = ResizeCrtApertureGrille_Scan8(in, pos, -1.0f, texture_size);
+	vfloat wb = ResizeCrtApertureGrille_Scan8(in, pos, 0.0f, texture_size);
+	vfloat wc = ResizeCrtApertureGrille_Scan8(in, pos, 1.0f, texture_size);
+	return a * wa + b * wb + c * wc;
+}
+
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vvec3 ResizeCrtApertureGrille_Bloom8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec2 pos, nCine::RHI::Software::sw::wide8::vvec2 texture_size)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec3 a = ResizeCrtApertureGrille_Horz58(in, pos, -2.0f, texture_size);
+	vvec3 b = ResizeCrtApertureGrille_Horz78(in, pos, -1.0f, texture_size);
+	vvec3 c = ResizeCrtApertureGrille_Horz78(in, pos, 0.0f, texture_size);
+	vvec3 d = ResizeCrtApertureGrille_Horz78(in, pos, 1.0f, texture_size);
+	vvec3 e = ResizeCrtApertureGrille_Horz58(in, pos, 2.0f, texture_size);
+	vfloat wa = ResizeCrtApertureGrille_BloomScan8(in, pos, -2.0f, texture_size);
+	vfloat wb = ResizeCrtApertureGrille_BloomScan8(in, pos, -1.0f, texture_size);
+	vfloat wc = ResizeCrtApertureGrille_BloomScan8(in, pos, 0.0f, texture_size);
+	vfloat wd = ResizeCrtApertureGrille_BloomScan8(in, pos, 1.0f, texture_size);
+	vfloat we = ResizeCrtApertureGrille_BloomScan8(in, pos, 2.0f, texture_size);
+	return a * wa + b * wb + c * wc + d * wd + e * we;
+}
+
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vvec2 ResizeCrtApertureGrille_Warp8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec2 pos)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	pos = pos * 2.0f - 1.0f;
+	pos *= vvec2(1.0f + pos.y * pos.y * 0.0155f, 1.0f + pos.x * pos.x * 0.0205f);
+	return pos * 0.5f + 0.5f;
+}
+
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vvec3 ResizeCrtApertureGrille_Mask8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec2 pos)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec3 mask = vec3(0.7f, 0.7f, 0.7f);
+	pos.x = fract(pos.x / 3.0f);
+	const vmask _cond0 = vmask(pos.x < 0.333f);
+	const vmask _mask0 = _cond0;
+	if (any(_mask0)) {
+		mask.x = select(_mask0, 1.5f, mask.x);
+	}
+	const vmask _else0 = !_cond0;
+	if (any(_else0)) {
+		const vmask _cond1 = vmask(pos.x < 0.666f);
+		const vmask _mask1 = _else0 & _cond1;
+		if (any(_mask1)) {
+			mask.y = select(_mask1, 1.5f, mask.y);
+		}
+		const vmask _else1 = andNot(_else0, _cond1);
+		if (any(_else1)) {
+			mask.z = select(_else1, 1.5f, mask.z);
+		}
+	}
+	return mask;
+}
+
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vvec4 ResizeCrtApertureGrille_crt_lottes8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec2 texture_size, nCine::RHI::Software::sw::wide8::vvec2 video_size, nCine::RHI::Software::sw::wide8::vvec2 output_size, nCine::RHI::Software::sw::wide8::vvec2 tex)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec2 pos = ResizeCrtApertureGrille_Warp8(in, tex.xy() * (texture_size.xy() / video_size.xy())) * (video_size.xy() / texture_size.xy());
+	vvec3 outColor = ResizeCrtApertureGrille_Tri8(in, pos, texture_size);
+	{
+		const vvec3 _w = vvec3(ResizeCrtApertureGrille_Bloom8(in, pos, texture_size) * 1.0f / 16.0f);
+		outColor.x += _w.x;
+		outColor.y += _w.y;
+		outColor.z += _w.z;
+	}
+	{
+		const vvec3 _w = vvec3(ResizeCrtApertureGrille_Mask8(in, floor(tex.xy() * (texture_size.xy() / video_size.xy()) * output_size.xy()) + vec2(0.5f, 0.5f)));
+		outColor.x *= _w.x;
+		outColor.y *= _w.y;
+		outColor.z *= _w.z;
+	}
+	return vvec4(ResizeCrtApertureGrille_ToSrgb8(in, outColor.xyz()), 1.0f);
+}
+
+DEATH_ENABLE_AVX2 void ResizeCrtApertureGrille_Fragment8(const nCine::RHI::Software::FragmentShaderInput8& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = ResizeCrtApertureGrille_crt_lottes8(in, unis->vTexSize, unis->vTexSize, unis->vViewSize, swTexCoords(in));
+	packColor(COLOR, in.rgba);
+}
+#endif
+
+		// --- ResizeCrtShadowMask ---
+struct ResizeCrtShadowMask_Uniforms
+{
+	nCine::RHI::Software::sw::vec2 vTexSize;
+	nCine::RHI::Software::sw::vec2 vViewSize;
+};
+
+void ResizeCrtShadowMask_ComputeVaryings(void* inputs, const std::uint8_t* instanceBlock)
+{
+	using namespace nCine::RHI::Software::sw;
+	ResizeCrtShadowMask_Uniforms* io = static_cast<ResizeCrtShadowMask_Uniforms*>(inputs);
+	(void)io;
+	(void)instanceBlock;
+	io->vTexSize = (*reinterpret_cast<const vec4*>(instanceBlock + 80)).xy();
+	io->vViewSize = (*reinterpret_cast<const vec2*>(instanceBlock + 96));
+}
+
+static float ResizeCrtShadowMask_ToLinear1(const nCine::RHI::Software::FragmentShaderInput& in, float c)
+{
+	using namespace nCine::RHI::Software::sw;
+	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	if (1 == 0) {
+		return c;
+	}
+	return c <= 0.04045f ? c / 12.92f : pow((c + 0.055f) / 1.055f, 2.4f);
+}
+
+static nCine::RHI::Software::sw::vec3 ResizeCrtShadowMask_ToLinear(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec3 c)
+{
+	using namespace nCine::RHI::Software::sw;
+	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	if (1 == 0) {
+		return c;
+	}
+	return vec3(ResizeCrtShadowMask_ToLinear1(in, c.r), ResizeCrtShadowMask_ToLinear1(in, c.g), ResizeCrtShadowMask_ToLinear1(in, c.b));
+}
+
+static float ResizeCrtShadowMask_ToSrgb1(const nCine::RHI::Software::FragmentShaderInput& in, float c)
+{
+	using namespace nCine::RHI::Software::sw;
+	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	if (1 == 0) {
+		return c;
+	}
+	return c < 0.0031308f ? c * 12.92f : 1.055f * pow(c, 0.41666f) - 0.055f;
+}
+
+static nCine::RHI::Software::sw::vec3 ResizeCrtShadowMask_ToSrgb(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec3 c)
+{
+	using namespace nCine::RHI::Software::sw;
+	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	if (1 == 0) {
+		return c;
+	}
+	return vec3(ResizeCrtShadowMask_ToSrgb1(in, c.r), ResizeCrtShadowMask_ToSrgb1(in, c.g), ResizeCrtShadowMask_ToSrgb1(in, c.b));
+}
+
+static nCine::RHI::Software::sw::vec3 ResizeCrtShadowMask_Fetch(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 pos, nCine::RHI::Software::sw::vec2 off, nCine::RHI::Software::sw::vec2 texture_size)
+{
+	using namespace nCine::RHI::Software::sw;
+	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	pos = (floor(pos * texture_size.xy() + off) + vec2(0.5f, 0.5f)) / texture_size.xy();
+	return ResizeCrtShadowMask_ToLinear(in, vec3(1.0f) * swTexture(in, 0, pos.xy()).xyz());
+}
+
+static nCine::RHI::Software::sw::vec2 ResizeCrtShadowMask_Dist(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 pos, nCine::RHI::Software::sw::vec2 texture_size)
+{
+	using namespace nCine::RHI::Software::sw;
+	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	pos = pos * texture_size.xy();
+	return -(pos - floor(pos) - vec2(0.5f, 0.5f));
+}
+
+static float ResizeCrtShadowMask_Gaus(const nCine::RHI::Software::FragmentShaderInput& in, float pos, float scale)
+{
+	using namespace nCine::RHI::Software::sw;
+	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	return exp2(scale * pow(abs(pos), 2.0f));
+}
+
+static nCine::RHI::Software::sw::vec3 ResizeCrtShadowMask_Horz3(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 pos, float off, nCine::RHI::Software::sw::vec2 texture_size)
+{
+	using namespace nCine::RHI::Software::sw;
+	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vec3 b = ResizeCrtShadowMask_Fetch(in, pos, vec2(-1.0f, off), texture_size);
+	vec3 c = ResizeCrtShadowMask_Fetch(in, pos, vec2(0.0f, off), texture_size);
+	vec3 d = ResizeCrtShadowMask_Fetch(in, pos, vec2(1.0f, off), texture_size);
+	float dst = ResizeCrtShadowMask_Dist(in, pos, texture_size).x;
+	float scale = -3.0f;
+	float wb = ResizeCrtShadowMask_Gaus(in, dst - 1.0f, scale);
+	float wc = ResizeCrtShadowMask_Gaus(in, dst + 0.0f, scale);
+	float wd = ResizeCrtShadowMask_Gaus(in, dst + 1.0f, scale);
+	return (b * wb + c * wc + d * wd) / (wb + wc + wd);
+}
+
+static nCine::RHI::Software::sw::vec3 ResizeCrtShadowMask_Horz5(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 pos, float off, nCine::RHI::Software::sw::vec2 texture_size)
+{
+	using namespace nCine::RHI::Software::sw;
+	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vec3 a = ResizeCrtShadowMask_Fetch(in, pos, vec2(-2.0f, off), texture_size);
+	vec3 b = ResizeCrtShadowMask_Fetch(in, pos, vec2(-1.0f, off), texture_size);
+	vec3 c = ResizeCrtShadowMask_Fetch(in, pos, vec2(0.0f, off), texture_size);
+	vec3 d = ResizeCrtShadowMask_Fetch(in, pos, vec2(1.0f, off), texture_size);
+	vec3 e = ResizeCrtShadowMask_Fetch(in, pos, vec2(2.0f, off), texture_size);
+	float dst = ResizeCrtShadowMask_Dist(in, pos, texture_size).x;
+	float scale = -3.0f;
+	float wa = ResizeCrtShadowMask_Gaus(in, dst - 2.0f, scale);
+	float wb = ResizeCrtShadowMask_Gaus(in, dst - 1.0f, scale);
+	float wc = ResizeCrtShadowMask_Gaus(in, dst + 0.0f, scale);
+	float wd = ResizeCrtShadowMask_Gaus(in, dst + 1.0f, scale);
+	float we = ResizeCrtShadowMask_Gaus(in, dst + 2.0f, scale);
+	return (a * wa + b * wb + c * wc + d * wd + e * we) / (wa + wb + wc + wd + we);
+}
+
+static nCine::RHI::Software::sw::vec3 ResizeCrtShadowMask_Horz7(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 pos, float off, nCine::RHI::Software::sw::vec2 texture_size)
+{
+	using namespace nCine::RHI::Software::sw;
+	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vec3 a = ResizeCrtShadowMask_Fetch(in, pos, vec2(-3.0f, off), texture_size);
+	vec3 b = ResizeCrtShadowMask_Fetch(in, pos, vec2(-2.0f, off), texture_size);
+	vec3 c = ResizeCrtShadowMask_Fetch(in, pos, vec2(-1.0f, off), texture_size);
+	vec3 d = ResizeCrtShadowMask_Fetch(in, pos, vec2(0.0f, off), texture_size);
+	vec3 e = ResizeCrtShadowMask_Fetch(in, pos, vec2(1.0f, off), texture_size);
+	vec3 f = ResizeCrtShadowMask_Fetch(in, pos, vec2(2.0f, off), texture_size);
+	vec3 g = ResizeCrtShadowMask_Fetch(in, pos, vec2(3.0f, off), texture_size);
+	float dst = ResizeCrtShadowMask_Dist(in, pos, texture_size).x;
+	float scale = -1.5f;
+	float wa = ResizeCrtShadowMask_Gaus(in, dst - 3.0f, scale);
+	float wb = ResizeCrtShadowMask_Gaus(in, dst - 2.0f, scale);
+	float wc = ResizeCrtShadowMask_Gaus(in, dst - 1.0f, scale);
+	float wd = ResizeCrtShadowMask_Gaus(in, dst + 0.0f, scale);
+	float we = ResizeCrtShadowMask_Gaus(in, dst + 1.0f, scale);
+	float wf = ResizeCrtShadowMask_Gaus(in, dst + 2.0f, scale);
+	float wg = ResizeCrtShadowMask_Gaus(in, dst + 3.0f, scale);
+	return (a * wa + b * wb + c * wc + d * wd + e * we + f * wf + g * wg) / (wa + wb + wc + wd + we + wf + wg);
+}
+
+static float ResizeCrtShadowMask_Scan(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 pos, float off, nCine::RHI::Software::sw::vec2 texture_size)
+{
+	using namespace nCine::RHI::Software::sw;
+	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	float dst = ResizeCrtShadowMask_Dist(in, pos, texture_size).y;
+	return ResizeCrtShadowMask_Gaus(in, dst + off, -6.0f);
+}
+
+static float ResizeCrtShadowMask_BloomScan(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 pos, float off, nCine::RHI::Software::sw::vec2 texture_size)
+{
+	using namespace nCine::RHI::Software::sw;
+	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	float dst = ResizeCrtShadowMask_Dist(in, pos, texture_size).y;
+	return ResizeCrtShadowMask_Gaus(in, dst + off, -2.0f);
+}
+
+static nCine::RHI::Software::sw::vec3 ResizeCrtShadowMask_Tri(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 pos, nCine::RHI::Software::sw::vec2 texture_size)
+{
+	using namespace nCine::RHI::Software::sw;
+	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vec3 a = ResizeCrtShadowMask_Horz3(in, pos, -1.0f, texture_size);
+	vec3 b = ResizeCrtShadowMask_Horz5(in, pos, 0.0f, texture_size);
+	vec3 c = ResizeCrtShadowMask_Horz3(in, pos, 1.0f, texture_size);
+	float wa = ResizeCrtShadowMask_Scan(in, pos, -1.0f, texture_size);
+	float wb = ResizeCrtShadowMask_Scan(in, pos, 0.0f, texture_size);
+	float wc = ResizeCrtShadowMask_Scan(in, pos, 1.0f, texture_size);
+	return a * wa + b * wb + c * wc;
+}
+
+static nCine::RHI::Software::sw::vec3 ResizeCrtShadowMask_Bloom(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 pos, nCine::RHI::Software::sw::vec2 texture_size)
+{
+	using namespace nCine::RHI::Software::sw;
+	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vec3 a = ResizeCrtShadowMask_Horz5(in, pos, -2.0f, texture_size);
+	vec3 b = ResizeCrtShadowMask_Horz7(in, pos, -1.0f, texture_size);
+	vec3 c = ResizeCrtShadowMask_Horz7(in, pos, 0.0f, texture_size);
+	vec3 d = ResizeCrtShadowMask_Horz7(in, pos, 1.0f, texture_size);
+	vec3 e = ResizeCrtShadowMask_Horz5(in, pos, 2.0f, texture_size);
+	float wa = ResizeCrtShadowMask_BloomScan(in, pos, -2.0f, texture_size);
+	float wb = ResizeCrtShadowMask_BloomScan(in, pos, -1.0f, texture_size);
+	float wc = ResizeCrtShadowMask_BloomScan(in, pos, 0.0f, texture_size);
+	float wd = ResizeCrtShadowMask_BloomScan(in, pos, 1.0f, texture_size);
+	float we = ResizeCrtShadowMask_BloomScan(in, pos, 2.0f, texture_size);
+	return a * wa + b * wb + c * wc + d * wd + e * we;
+}
+
+static nCine::RHI::Software::sw::vec2 ResizeCrtShadowMask_Warp(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 pos)
+{
+	using namespace nCine::RHI::Software::sw;
+	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	pos = pos * 2.0f - 1.0f;
+	pos *= vec2(1.0f + pos.y * pos.y * 0.031f, 1.0f + pos.x * pos.x * 0.041f);
+	return pos * 0.5f + 0.5f;
+}
+
+static nCine::RHI::Software::sw::vec3 ResizeCrtShadowMask_Mask(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 pos)
+{
+	using namespace nCine::RHI::Software::sw;
+	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vec3 mask = vec3(0.55f, 0.55f, 0.55f);
+	{
+		const vec2 _w = vec2(floor(pos.xy() * vec2(1.0f, 0.5f)));
+		pos.x = _w.x;
+		pos.y = _w.y;
+	}
+	pos.x += pos.y * 3.0f;
+	pos.x = fract(pos.x / 6.0f);
+	if (pos.x < 0.333f) {
+		mask.r = 1.5f;
+	} else {
+		if (pos.x < 0.666f) {
+			mask.g = 1.5f;
+		} else {
+			mask.b = 1.5f;
+		}
+	}
+	return mask;
+}
+
+static nCine::RHI::Software::sw::vec4 ResizeCrtShadowMask_crt_lottes(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 texture_size, nCine::RHI::Software::sw::vec2 video_size, nCine::RHI::Software::sw::vec2 output_size, nCine::RHI::Software::sw::vec2 tex)
+{
+	using namespace nCine::RHI::Software::sw;
+	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vec2 pos = ResizeCrtShadowMask_Warp(in, tex.xy() * (texture_size.xy() / video_size.xy())) * (video_size.xy() / texture_size.xy());
+	vec3 outColor = ResizeCrtShadowMask_Tri(in, pos, texture_size);
+	{
+		const vec3 _w = vec3(ResizeCrtShadowMask_Bloom(in, pos, texture_size) * 1.0f / 12.0f);
+		outColor.r += _w.x;
+		outColor.g += _w.y;
+		outColor.b += _w.z;
+	}
+	{
+		const vec3 _w = vec3(ResizeCrtShadowMask_Mask(in, floor(tex.xy() * (texture_size.xy() / video_size.xy()) * output_size.xy()) + vec2(0.5f, 0.5f)));
+		outColor.r *= _w.x;
+		outColor.g *= _w.y;
+		outColor.b *= _w.z;
+	}
+	return vec4(ResizeCrtShadowMask_ToSrgb(in, outColor.xyz()), 1.0f);
+}
+
+void ResizeCrtShadowMask_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vec4 COLOR;
+	COLOR = ResizeCrtShadowMask_crt_lottes(in, unis->vTexSize, unis->vTexSize, unis->vViewSize, vec2(in.u, in.v));
+	packColor(COLOR, in.rgba);
+}
+
+static nCine::RHI::Software::sw::wide4::vfloat ResizeCrtShadowMask_ToLinear14(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vfloat c)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	if (1 == 0) {
+		return c;
+	}
+	return select(vmask(c <= 0.04045f), c / 12.92f, pow((c + 0.055f) / 1.055f, 2.4f));
+}
+
+static nCine::RHI::Software::sw::wide4::vvec3 ResizeCrtShadowMask_ToLinear4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec3 c)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	if (1 == 0) {
+		return c;
+	}
+	return vvec3(ResizeCrtShadowMask_ToLinear14(in, c.x), ResizeCrtShadowMask_ToLinear14(in, c.y), ResizeCrtShadowMask_ToLinear14(in, c.z));
+}
+
+static nCine::RHI::Software::sw::wide4::vfloat ResizeCrtShadowMask_ToSrgb14(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vfloat c)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	if (1 == 0) {
+		return c;
+	}
+	return select(vmask(c < 0.0031308f), c * 12.92f, 1.055f * pow(c, 0.41666f) - 0.055f);
+}
+
+static nCine::RHI::Software::sw::wide4::vvec3 ResizeCrtShadowMask_ToSrgb4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec3 c)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	if (1 == 0) {
+		return c;
+	}
+	return vvec3(ResizeCrtShadowMask_ToSrgb14(in, c.x), ResizeCrtShadowMask_ToSrgb14(in, c.y), ResizeCrtShadowMask_ToSrgb14(in, c.z));
+}
+
+static nCine::RHI::Software::sw::wide4::vvec3 ResizeCrtShadowMask_Fetch4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec2 pos, nCine::RHI::Software::sw::wide4::vvec2 off, nCine::RHI::Software::sw::wide4::vvec2 texture_size)
 {
-	float vPaletteOffset;
-};
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	pos = (floor(pos * texture_size.xy() + off) + vec2(0.5f, 0.5f)) / texture_size.xy();
+	return ResizeCrtShadowMask_ToLinear4(in, vec3(1.0f) * swTexture(in, 0, pos.xy()).xyz());
+}
 
-void BatchedOutlinePalette_ComputeVaryings(void* inputs, const std::uint8_t* instanceBlock)
+static nCine::RHI::Software::sw::wide4::vvec2 ResizeCrtShadowMask_Dist4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec2 pos, nCine::RHI::Software::sw::wide4::vvec2 texture_size)
 {
 	using namespace nCine::RHI::Software::sw;
-	BatchedOutlinePalette_Uniforms* io = static_cast<BatchedOutlinePalette_Uniforms*>(inputs);
-	(void)io;
-	(void)instanceBlock;
-	io->vPaletteOffset = (*reinterpret_cast<const float*>(instanceBlock + 104));
+	using namespace nCine::RHI::Software::sw::wide4;
+	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	pos = pos * texture_size.xy();
+	return -(pos - floor(pos) - vec2(0.5f, 0.5f));
 }
 
-static float BatchedOutlinePalette_aastep(const nCine::RHI::Software::FragmentShaderInput& in, float threshold, float value)
+static nCine::RHI::Software::sw::wide4::vfloat ResizeCrtShadowMask_Gaus4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vfloat pos, nCine::RHI::Software::sw::wide4::vfloat scale)
 {
 	using namespace nCine::RHI::Software::sw;
-	const BatchedOutlinePalette_Uniforms* unis = static_cast<const BatchedOutlinePalette_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide4;
+	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	float afwidth = length(vec2(dFdx(value), dFdy(value))) * 0.70710678118654757f;
-	return smoothstep(threshold - afwidth, threshold + afwidth, value);
+	return exp2(scale * pow(abs(pos), 2.0f));
 }
 
-static nCine::RHI::Software::sw::vec4 BatchedOutlinePalette_palette(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 uv)
+static nCine::RHI::Software::sw::wide4::vvec3 ResizeCrtShadowMask_Horz34(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec2 pos, nCine::RHI::Software::sw::wide4::vfloat off, nCine::RHI::Software::sw::wide4::vvec2 texture_size)
 {
 	using namespace nCine::RHI::Software::sw;
-	const BatchedOutlinePalette_Uniforms* unis = static_cast<const BatchedOutlinePalette_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide4;
+	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	vec4 src = swTexture(in, 0, uv);
-	float palIndex = floor(unis->vPaletteOffset + 0.5f) + floor(src.r * 255.0f + 0.5f);
-	float palX = (mod(palIndex, 256.0f) + 0.5f) / 256.0f;
-	float palY = (floor(palIndex / 256.0f) + 0.5f) / 256.0f;
-	vec4 c = swTexture(in, 1, vec2(palX, palY));
-	return vec4(c.rgb(), c.a * src.a);
+	vvec3 b = ResizeCrtShadowMask_Fetch4(in, pos, vvec2(-1.0f, off), texture_size);
+	vvec3 c = ResizeCrtShadowMask_Fetch4(in, pos, vvec2(0.0f, off), texture_size);
+	vvec3 d = ResizeCrtShadowMask_Fetch4(in, pos, vvec2(1.0f, off), texture_size);
+	vfloat dst = ResizeCrtShadowMask_Dist4(in, pos, texture_size).x;
+	float scale = -3.0f;
+	vfloat wb = ResizeCrtShadowMask_Gaus4(in, dst - 1.0f, scale);
+	vfloat wc = ResizeCrtShadowMask_Gaus4(in, dst + 0.0f, scale);
+	vfloat wd = ResizeCrtShadowMask_Gaus4(in, dst + 1.0f, scale);
+	return (b * wb + c * wc + d * wd) / (wb + wc + wd);
 }
 
-static float BatchedOutlinePalette_alphaAt(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 uv)
+static nCine::RHI::Software::sw::wide4::vvec3 ResizeCrtShadowMask_Horz54(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec2 pos, nCine::RHI::Software::sw::wide4::vfloat off, nCine::RHI::Software::sw::wide4::vvec2 texture_size)
 {
 	using namespace nCine::RHI::Software::sw;
-	const BatchedOutlinePalette_Uniforms* unis = static_cast<const BatchedOutlinePalette_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide4;
+	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	vec4 src = swTexture(in, 0, uv);
-	float palIndex = floor(unis->vPaletteOffset + 0.5f) + floor(src.r * 255.0f + 0.5f);
-	float palX = (mod(palIndex, 256.0f) + 0.5f) / 256.0f;
-	float palY = (floor(palIndex / 256.0f) + 0.5f) / 256.0f;
-	return swTexture(in, 1, vec2(palX, palY)).a * src.a;
+	vvec3 a = ResizeCrtShadowMask_Fetch4(in, pos, vvec2(-2.0f, off), texture_size);
+	vvec3 b = ResizeCrtShadowMask_Fetch4(in, pos, vvec2(-1.0f, off), texture_size);
+	vvec3 c = ResizeCrtShadowMask_Fetch4(in, pos, vvec2(0.0f, off), texture_size);
+	vvec3 d = ResizeCrtShadowMask_Fetch4(in, pos, vvec2(1.0f, off), texture_size);
+	vvec3 e = ResizeCrtShadowMask_Fetch4(in, pos, vvec2(2.0f, off), texture_size);
+	vfloat dst = ResizeCrtShadowMask_Dist4(in, pos, texture_size).x;
+	float scale = -3.0f;
+	vfloat wa = ResizeCrtShadowMask_Gaus4(in, dst - 2.0f, scale);
+	vfloat wb = ResizeCrtShadowMask_Gaus4(in, dst - 1.0f, scale);
+	vfloat wc = ResizeCrtShadowMask_Gaus4(in, dst + 0.0f, scale);
+	vfloat wd = ResizeCrtShadowMask_Gaus4(in, dst + 1.0f, scale);
+	vfloat we = ResizeCrtShadowMask_Gaus4(in, dst + 2.0f, scale);
+	return (a * wa + b * wb + c * wc + d * wd + e * we) / (wa + wb + wc + wd + we);
 }
 
-void BatchedOutlinePalette_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
+static nCine::RHI::Software::sw::wide4::vvec3 ResizeCrtShadowMask_Horz74(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec2 pos, nCine::RHI::Software::sw::wide4::vfloat off, nCine::RHI::Software::sw::wide4::vvec2 texture_size)
 {
 	using namespace nCine::RHI::Software::sw;
-	const BatchedOutlinePalette_Uniforms* unis = static_cast<const BatchedOutlinePalette_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide4;
+	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	vec4 COLOR;
-	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
-	vec2 size = COLOR.xy();
-	float outline = BatchedOutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(-size.x, 0));
-	outline += BatchedOutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(0, size.y));
-	outline += BatchedOutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(size.x, 0));
-	outline += BatchedOutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(0, -size.y));
-	outline += BatchedOutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(-size.x, size.y));
-	outline += BatchedOutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(size.x, size.y));
-	outline += BatchedOutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(-size.x, -size.y));
-	outline += BatchedOutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(size.x, -size.y));
-	outline = BatchedOutlinePalette_aastep(in, 1.0f, outline);
-	float outline2 = BatchedOutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(-2.0f * size.x, 0));
-	outline2 += BatchedOutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(0, 2.0f * size.y));
-	outline2 += BatchedOutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(2.0f * size.x, 0));
-	outline2 += BatchedOutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(0, -2.0f * size.y));
-	outline2 += BatchedOutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(-2.0f * size.x, 2.0f * size.y));
-	outline2 += BatchedOutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(2.0f * size.x, 2.0f * size.y));
-	outline2 += BatchedOutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(-2.0f * size.x, -2.0f * size.y));
-	outline2 += BatchedOutlinePalette_alphaAt(in, vec2(in.u, in.v) + vec2(2.0f * size.x, -2.0f * size.y));
-	outline2 = BatchedOutlinePalette_aastep(in, 1.0f, outline2);
-	vec4 color = BatchedOutlinePalette_palette(in, vec2(in.u, in.v));
-	COLOR = mix(color, mix(vec4(0.0f, 0.0f, 0.0f, COLOR.w * 0.5f), vec4(COLOR.z, COLOR.z, COLOR.z, COLOR.w), outline), max(outline, outline2) - color.a);
-	packColor(COLOR, in.rgba);
+	vvec3 a = ResizeCrtShadowMask_Fetch4(in, pos, vvec2(-3.0f, off), texture_size);
+	vvec3 b = ResizeCrtShadowMask_Fetch4(in, pos, vvec2(-2.0f, off), texture_size);
+	vvec3 c = ResizeCrtShadowMask_Fetch4(in, pos, vvec2(-1.0f, off), texture_size);
+	vvec3 d = ResizeCrtShadowMask_Fetch4(in, pos, vvec2(0.0f, off), texture_size);
+	vvec3 e = ResizeCrtShadowMask_Fetch4(in, pos, vvec2(1.0f, off), texture_size);
+	vvec3 f = ResizeCrtShadowMask_Fetch4(in, pos, vvec2(2.0f, off), texture_size);
+	vvec3 g = ResizeCrtShadowMask_Fetch4(in, pos, vvec2(3.0f, off), texture_size);
+	vfloat dst = ResizeCrtShadowMask_Dist4(in, pos, texture_size).x;
+	float scale = -1.5f;
+	vfloat wa = ResizeCrtShadowMask_Gaus4(in, dst - 3.0f, scale);
+	vfloat wb = ResizeCrtShadowMask_Gaus4(in, dst - 2.0f, scale);
+	vfloat wc = ResizeCrtShadowMask_Gaus4(in, dst - 1.0f, scale);
+	vfloat wd = ResizeCrtShadowMask_Gaus4(in, dst + 0.0f, scale);
+	vfloat we = ResizeCrtShadowMask_Gaus4(in, dst + 1.0f, scale);
+	vfloat wf = ResizeCrtShadowMask_Gaus4(in, dst + 2.0f, scale);
+	vfloat wg = ResizeCrtShadowMask_Gaus4(in, dst + 3.0f, scale);
+	return (a * wa + b * wb + c * wc + d * wd + e * we + f * wf + g * wg) / (wa + wb + wc + wd + we + wf + wg);
 }
 
-		// --- PaletteRemap ---
-struct PaletteRemap_Uniforms
+static nCine::RHI::Software::sw::wide4::vfloat ResizeCrtShadowMask_Scan4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec2 pos, nCine::RHI::Software::sw::wide4::vfloat off, nCine::RHI::Software::sw::wide4::vvec2 texture_size)
 {
-	float vPaletteOffset;
-};
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vfloat dst = ResizeCrtShadowMask_Dist4(in, pos, texture_size).y;
+	return ResizeCrtShadowMask_Gaus4(in, dst + off, -6.0f);
+}
 
-void PaletteRemap_ComputeVaryings(void* inputs, const std::uint8_t* instanceBlock)
+static nCine::RHI::Software::sw::wide4::vfloat ResizeCrtShadowMask_BloomScan4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec2 pos, nCine::RHI::Software::sw::wide4::vfloat off, nCine::RHI::Software::sw::wide4::vvec2 texture_size)
 {
 	using namespace nCine::RHI::Software::sw;
-	PaletteRemap_Uniforms* io = static_cast<PaletteRemap_Uniforms*>(inputs);
-	(void)io;
-	(void)instanceBlock;
-	io->vPaletteOffset = (*reinterpret_cast<const float*>(instanceBlock + 104));
+	using namespace nCine::RHI::Software::sw::wide4;
+	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vfloat dst = ResizeCrtShadowMask_Dist4(in, pos, texture_size).y;
+	return ResizeCrtShadowMask_Gaus4(in, dst + off, -2.0f);
 }
 
-void PaletteRemap_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
+static nCine::RHI::Software::sw::wide4::vvec3 ResizeCrtShadowMask_Tri4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec2 pos, nCine::RHI::Software::sw::wide4::vvec2 texture_size)
 {
 	using namespace nCine::RHI::Software::sw;
-	const PaletteRemap_Uniforms* unis = static_cast<const PaletteRemap_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide4;
+	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	vec4 COLOR;
-	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
-	vec4 src = swTexturePrimary(in, 0);
-	float palIndex = floor(unis->vPaletteOffset + 0.5f) + floor(src.r * 255.0f + 0.5f);
-	float palX = (mod(palIndex, 256.0f) + 0.5f) / 256.0f;
-	float palY = (floor(palIndex / 256.0f) + 0.5f) / 256.0f;
-	vec4 color = swTexture(in, 1, vec2(palX, palY));
-	COLOR = vec4(color.rgb(), color.a * src.a) * COLOR;
-	packColor(COLOR, in.rgba);
+	vvec3 a = ResizeCrtShadowMask_Horz34(in, pos, -1.0f, texture_size);
+	vvec3 b = ResizeCrtShadowMask_Horz54(in, pos, 0.0f, texture_size);
+	vvec3 c = ResizeCrtShadowMask_Horz34(in, pos, 1.0f, texture_size);
+	vfloat wa = ResizeCrtShadowMask_Scan4(in, pos, -1.0f, texture_size);
+	vfloat wb = ResizeCrtShadowMask_Scan4(in, pos, 0.0f, texture_size);
+	vfloat wc = ResizeCrtShadowMask_Scan4(in, pos, 1.0f, texture_size);
+	return a * wa + b * wb + c * wc;
 }
 
-		// --- BatchedPaletteRemap ---
-struct BatchedPaletteRemap_Uniforms
+static nCine::RHI::Software::sw::wide4::vvec3 ResizeCrtShadowMask_Bloom4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec2 pos, nCine::RHI::Software::sw::wide4::vvec2 texture_size)
 {
-	float vPaletteOffset;
-};
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec3 a = ResizeCrtShadowMask_Horz54(in, pos, -2.0f, texture_size);
+	vvec3 b = ResizeCrtShadowMask_Horz74(in, pos, -1.0f, texture_size);
+	vvec3 c = ResizeCrtShadowMask_Horz74(in, pos, 0.0f, texture_size);
+	vvec3 d = ResizeCrtShadowMask_Horz74(in, pos, 1.0f, texture_size);
+	vvec3 e = ResizeCrtShadowMask_Horz54(in, pos, 2.0f, texture_size);
+	vfloat wa = ResizeCrtShadowMask_BloomScan4(in, pos, -2.0f, texture_size);
+	vfloat wb = ResizeCrtShadowMask_BloomScan4(in, pos, -1.0f, texture_size);
+	vfloat wc = ResizeCrtShadowMask_BloomScan4(in, pos, 0.0f, texture_size);
+	vfloat wd = ResizeCrtShadowMask_BloomScan4(in, pos, 1.0f, texture_size);
+	vfloat we = ResizeCrtShadowMask_BloomScan4(in, pos, 2.0f, texture_size);
+	return a * wa + b * wb + c * wc + d * wd + e * we;
+}
 
-void BatchedPaletteRemap_ComputeVaryings(void* inputs, const std::uint8_t* instanceBlock)
+static nCine::RHI::Software::sw::wide4::vvec2 ResizeCrtShadowMask_Warp4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec2 pos)
 {
 	using namespace nCine::RHI::Software::sw;
-	BatchedPaletteRemap_Uniforms* io = static_cast<BatchedPaletteRemap_Uniforms*>(inputs);
-	(void)io;
-	(void)instanceBlock;
-	io->vPaletteOffset = (*reinterpret_cast<const float*>(instanceBlock + 104));
+	using namespace nCine::RHI::Software::sw::wide4;
+	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	pos = pos * 2.0f - 1.0f;
+	pos *= vvec2(1.0f + pos.y * pos.y * 0.031f, 1.0f + pos.x * pos.x * 0.041f);
+	return pos * 0.5f + 0.5f;
 }
 
-void BatchedPaletteRemap_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
+static nCine::RHI::Software::sw::wide4::vvec3 ResizeCrtShadowMask_Mask4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec2 pos)
 {
 	using namespace nCine::RHI::Software::sw;
-	const BatchedPaletteRemap_Uniforms* unis = static_cast<const BatchedPaletteRemap_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide4;
+	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	vec4 COLOR;
-	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
-	vec4 src = swTexturePrimary(in, 0);
-	float palIndex = floor(unis->vPaletteOffset + 0.5f) + floor(src.r * 255.0f + 0.5f);
-	float palX = (mod(palIndex, 256.0f) + 0.5f) / 256.0f;
-	float palY = (floor(palIndex / 256.0f) + 0.5f) / 256.0f;
-	vec4 color = swTexture(in, 1, vec2(palX, palY));
-	COLOR = vec4(color.rgb(), color.a * src.a) * COLOR;
-	packColor(COLOR, in.rgba);
+	vvec3 mask = vec3(0.55f, 0.55f, 0.55f);
+	{
+		const vvec2 _w = vvec2(floor(pos.xy() * vec2(1.0f, 0.5f)));
+		pos.x = _w.x;
+		pos.y = _w.y;
+	}
+	pos.x += pos.y * 3.0f;
+	pos.x = fract(pos.x / 6.0f);
+	const vmask _cond0 = vmask(pos.x < 0.333f);
+	const vmask _mask0 = _cond0;
+	if (any(_mask0)) {
+		mask.x = select(_mask0, 1.5f, mask.x);
+	}
+	const vmask _else0 = !_cond0;
+	if (any(_else0)) {
+		const vmask _cond1 = vmask(pos.x < 0.666f);
+		const vmask _mask1 = _else0 & _cond1;
+		if (any(_mask1)) {
+			mask.y = select(_mask1, 1.5f, mask.y);
+		}
+		const vmask _else1 = andNot(_else0, _cond1);
+		if (any(_else1)) {
+			mask.z = select(_else1, 1.5f, mask.z);
+		}
+	}
+	return mask;
 }
 
-		// --- PartialWhiteMask ---
-struct PartialWhiteMask_Uniforms
+static nCine::RHI::Software::sw::wide4::vvec4 ResizeCrtShadowMask_crt_lottes4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec2 texture_size, nCine::RHI::Software::sw::wide4::vvec2 video_size, nCine::RHI::Software::sw::wide4::vvec2 output_size, nCine::RHI::Software::sw::wide4::vvec2 tex)
 {
-};
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec2 pos = ResizeCrtShadowMask_Warp4(in, tex.xy() * (texture_size.xy() / video_size.xy())) * (video_size.xy() / texture_size.xy());
+	vvec3 outColor = ResizeCrtShadowMask_Tri4(in, pos, texture_size);
+	{
+		const vvec3 _w = vvec3(ResizeCrtShadowMask_Bloom4(in, pos, texture_size) * 1.0f / 12.0f);
+		outColor.x += _w.x;
+		outColor.y += _w.y;
+		outColor.z += _w.z;
+	}
+	{
+		const vvec3 _w = vvec3(ResizeCrtShadowMask_Mask4(in, floor(tex.xy() * (texture_size.xy() / video_size.xy()) * output_size.xy()) + vec2(0.5f, 0.5f)));
+		outColor.x *= _w.x;
+		outColor.y *= _w.y;
+		outColor.z *= _w.z;
+	}
+	return vvec4(ResizeCrtShadowMask_ToSrgb4(in, outColor.xyz()), 1.0f);
+}
 
-static nCine::RHI::Software::sw::vec4 PartialWhiteMask_maskSample(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 uv)
+void ResizeCrtShadowMask_Fragment4(const nCine::RHI::Software::FragmentShaderInput4& in)
 {
 	using namespace nCine::RHI::Software::sw;
-	const PartialWhiteMask_Uniforms* unis = static_cast<const PartialWhiteMask_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide4;
+	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	vec4 src = swTexture(in, 0, uv);
-	return src;
+	vvec4 COLOR;
+	COLOR = ResizeCrtShadowMask_crt_lottes4(in, unis->vTexSize, unis->vTexSize, unis->vViewSize, swTexCoords(in));
+	packColor(COLOR, in.rgba);
 }
 
-void PartialWhiteMask_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
+#if defined(SW_WIDE8)
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vfloat ResizeCrtShadowMask_ToLinear18(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vfloat c)
 {
 	using namespace nCine::RHI::Software::sw;
-	const PartialWhiteMask_Uniforms* unis = static_cast<const PartialWhiteMask_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide8;
+	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	vec4 COLOR;
-	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
-	vec4 tex = PartialWhiteMask_maskSample(in, vec2(in.u, in.v));
-	float color = min((0.299f * tex.r + 0.587f * tex.g + 0.114f * tex.b) * 2.5f, 1.0f);
-	COLOR = vec4(color, color, color, tex.a) * COLOR;
-	packColor(COLOR, in.rgba);
+	if (1 == 0) {
+		return c;
+	}
+	return select(vmask(c <= 0.04045f), c / 12.92f, pow((c + 0.055f) / 1.055f, 2.4f));
 }
 
-		// --- PartialWhiteMask_USE_PALETTE ---
-struct PartialWhiteMask_USE_PALETTE_Uniforms
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vvec3 ResizeCrtShadowMask_ToLinear8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec3 c)
 {
-	float vPaletteOffset;
-};
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	if (1 == 0) {
+		return c;
+	}
+	return vvec3(ResizeCrtShadowMask_ToLinear18(in, c.x), ResizeCrtShadowMask_ToLinear18(in, c.y), ResizeCrtShadowMask_ToLinear18(in, c.z));
+}
 
-void PartialWhiteMask_USE_PALETTE_ComputeVaryings(void* inputs, const std::uint8_t* instanceBlock)
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vfloat ResizeCrtShadowMask_ToSrgb18(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vfloat c)
 {
 	using namespace nCine::RHI::Software::sw;
-	PartialWhiteMask_USE_PALETTE_Uniforms* io = static_cast<PartialWhiteMask_USE_PALETTE_Uniforms*>(inputs);
-	(void)io;
-	(void)instanceBlock;
-	io->vPaletteOffset = (*reinterpret_cast<const float*>(instanceBlock + 104));
+	using namespace nCine::RHI::Software::sw::wide8;
+	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	if (1 == 0) {
+		return c;
+	}
+	return select(vmask(c < 0.0031308f), c * 12.92f, 1.055f * pow(c, 0.41666f) - 0.055f);
 }
 
-static nCine::RHI::Software::sw::vec4 PartialWhiteMask_USE_PALETTE_maskSample(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 uv)
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vvec3 ResizeCrtShadowMask_ToSrgb8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec3 c)
 {
 	using namespace nCine::RHI::Software::sw;
-	const PartialWhiteMask_USE_PALETTE_Uniforms* unis = static_cast<const PartialWhiteMask_USE_PALETTE_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide8;
+	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	vec4 src = swTexture(in, 0, uv);
-	float palIndex = floor(unis->vPaletteOffset + 0.5f) + floor(src.r * 255.0f + 0.5f);
-	float palX = (mod(palIndex, 256.0f) + 0.5f) / 256.0f;
-	float palY = (floor(palIndex / 256.0f) + 0.5f) / 256.0f;
-	vec4 c = swTexture(in, 1, vec2(palX, palY));
-	return vec4(c.rgb(), c.a * src.a);
+	if (1 == 0) {
+		return c;
+	}
+	return vvec3(ResizeCrtShadowMask_ToSrgb18(in, c.x), ResizeCrtShadowMask_ToSrgb18(in, c.y), ResizeCrtShadowMask_ToSrgb18(in, c.z));
 }
 
-void PartialWhiteMask_USE_PALETTE_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vvec3 ResizeCrtShadowMask_Fetch8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec2 pos, nCine::RHI::Software::sw::wide8::vvec2 off, nCine::RHI::Software::sw::wide8::vvec2 texture_size)
 {
 	using namespace nCine::RHI::Software::sw;
-	const PartialWhiteMask_USE_PALETTE_Uniforms* unis = static_cast<const PartialWhiteMask_USE_PALETTE_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide8;
+	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	vec4 COLOR;
-	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
-	vec4 tex = PartialWhiteMask_USE_PALETTE_maskSample(in, vec2(in.u, in.v));
-	float color = min((0.299f * tex.r + 0.587f * tex.g + 0.114f * tex.b) * 2.5f, 1.0f);
-	COLOR = vec4(color, color, color, tex.a) * COLOR;
-	packColor(COLOR, in.rgba);
+	pos = (floor(pos * texture_size.xy() + off) + vec2(0.5f, 0.5f)) / texture_size.xy();
+	return ResizeCrtShadowMask_ToLinear8(in, vec3(1.0f) * swTexture(in, 0, pos.xy()).xyz());
 }
 
-		// --- BatchedPartialWhiteMask ---
-struct BatchedPartialWhiteMask_Uniforms
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vvec2 ResizeCrtShadowMask_Dist8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec2 pos, nCine::RHI::Software::sw::wide8::vvec2 texture_size)
 {
-};
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	pos = pos * texture_size.xy();
+	return -(pos - floor(pos) - vec2(0.5f, 0.5f));
+}
 
-static nCine::RHI::Software::sw::vec4 BatchedPartialWhiteMask_maskSample(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 uv)
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vfloat ResizeCrtShadowMask_Gaus8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vfloat pos, nCine::RHI::Software::sw::wide8::vfloat scale)
 {
 	using namespace nCine::RHI::Software::sw;
-	const BatchedPartialWhiteMask_Uniforms* unis = static_cast<const BatchedPartialWhiteMask_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide8;
+	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	vec4 src = swTexture(in, 0, uv);
-	return src;
+	return exp2(scale * pow(abs(pos), 2.0f));
 }
 
-void BatchedPartialWhiteMask_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vvec3 ResizeCrtShadowMask_Horz38(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec2 pos, nCine::RHI::Software::sw::wide8::vfloat off, nCine::RHI::Software::sw::wide8::vvec2 texture_size)
 {
 	using namespace nCine::RHI::Software::sw;
-	const BatchedPartialWhiteMask_Uniforms* unis = static_cast<const BatchedPartialWhiteMask_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide8;
+	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	vec4 COLOR;
-	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
-	vec4 tex = BatchedPartialWhiteMask_maskSample(in, vec2(in.u, in.v));
-	float color = min((0.299f * tex.r + 0.587f * tex.g + 0.114f * tex.b) * 2.5f, 1.0f);
-	COLOR = vec4(color, color, color, tex.a) * COLOR;
-	packColor(COLOR, in.rgba);
+	vvec3 b = ResizeCrtShadowMask_Fetch8(in, pos, vvec2(-1.0f, off), texture_size);
+	vvec3 c = ResizeCrtShadowMask_Fetch8(in, pos, vvec2(0.0f, off), texture_size);
+	vvec3 d = ResizeCrtShadowMask_Fetch8(in, pos, vvec2(1.0f, off), texture_size);
+	vfloat dst = ResizeCrtShadowMask_Dist8(in, pos, texture_size).x;
+	float scale = -3.0f;
+	vfloat wb = ResizeCrtShadowMask_Gaus8(in, dst - 1.0f, scale);
+	vfloat wc = ResizeCrtShadowMask_Gaus8(in, dst + 0.0f, scale);
+	vfloat wd = ResizeCrtShadowMask_Gaus8(in, dst + 1.0f, scale);
+	return (b * wb + c * wc + d * wd) / (wb + wc + wd);
 }
 
-		// --- BatchedPartialWhiteMask_USE_PALETTE ---
-struct BatchedPartialWhiteMask_USE_PALETTE_Uniforms
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vvec3 ResizeCrtShadowMask_Horz58(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec2 pos, nCine::RHI::Software::sw::wide8::vfloat off, nCine::RHI::Software::sw::wide8::vvec2 texture_size)
 {
-	float vPaletteOffset;
-};
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec3 a = ResizeCrtShadowMask_Fetch8(in, pos, vvec2(-2.0f, off), texture_size);
+	vvec3 b = ResizeCrtShadowMask_Fetch8(in, pos, vvec2(-1.0f, off), texture_size);
+	vvec3 c = ResizeCrtShadowMask_Fetch8(in, pos, vvec2(0.0f, off), texture_size);
+	vvec3 d = ResizeCrtShadowMask_Fetch8(in, pos, vvec2(1.0f, off), texture_size);
+	vvec3 e = ResizeCrtShadowMask_Fetch8(in, pos, vvec2(2.0f, off), texture_size);
+	vfloat dst = ResizeCrtShadowMask_Dist8(in, pos, texture_size).x;
+	float scale = -3.0f;
+	vfloat wa = ResizeCrtShadowMask_Gaus8(in, dst - 2.0f, scale);
+	vfloat wb = ResizeCrtShadowMask_Gaus8(in, dst - 1.0f, scale);
+	vfloat wc = ResizeCrtShadowMask_Gaus8(in, dst + 0.0f, scale);
+	vfloat wd = ResizeCrtShadowMask_Gaus8(in, dst + 1.0f, scale);
+	vfloat we = ResizeCrtShadowMask_Gaus8(in, dst + 2.0f, scale);
+	return (a * wa + b * wb + c * wc + d * wd + e * we) / (wa + wb + wc + wd + we);
+}
 
-void BatchedPartialWhiteMask_USE_PALETTE_ComputeVaryings(void* inputs, const std::uint8_t* instanceBlock)
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vvec3 ResizeCrtShadowMask_Horz78(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec2 pos, nCine::RHI::Software::sw::wide8::vfloat off, nCine::RHI::Software::sw::wide8::vvec2 texture_size)
 {
 	using namespace nCine::RHI::Software::sw;
-	BatchedPartialWhiteMask_USE_PALETTE_Uniforms* io = static_cast<BatchedPartialWhiteMask_USE_PALETTE_Uniforms*>(inputs);
-	(void)io;
-	(void)instanceBlock;
-	io->vPaletteOffset = (*reinterpret_cast<const float*>(instanceBlock + 104));
+	using namespace nCine::RHI::Software::sw::wide8;
+	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec3 a = ResizeCrtShadowMask_Fetch8(in, pos, vvec2(-3.0f, off), texture_size);
+	vvec3 b = ResizeCrtShadowMask_Fetch8(in, pos, vvec2(-2.0f, off), texture_size);
+	vvec3 c = ResizeCrtShadowMask_Fetch8(in, pos, vvec2(-1.0f, off), texture_size);
+	vvec3 d = ResizeCrtShadowMask_Fetch8(in, pos, vvec2(0.0f, off), texture_size);
+	vvec3 e = ResizeCrtShadowMask_Fetch8(in, pos, vvec2(1.0f, off), texture_size);
+	vvec3 f = ResizeCrtShadowMask_Fetch8(in, pos, vvec2(2.0f, off), texture_size);
+	vvec3 g = ResizeCrtShadowMask_Fetch8(in, pos, vvec2(3.0f, off), texture_size);
+	vfloat dst = ResizeCrtShadowMask_Dist8(in, pos, texture_size).x;
+	float scale = -1.5f;
+	vfloat wa = ResizeCrtShadowMask_Gaus8(in, dst - 3.0f, scale);
+	vfloat wb = ResizeCrtShadowMask_Gaus8(in, dst - 2.0f, scale);
+	vfloat wc = ResizeCrtShadowMask_Gaus8(in, dst - 1.0f, scale);
+	vfloat wd = ResizeCrtShadowMask_Gaus8(in, dst + 0.0f, scale);
+	vfloat we = ResizeCrtShadowMask_Gaus8(in, dst + 1.0f, scale);
+	vfloat wf = ResizeCrtShadowMask_Gaus8(in, dst + 2.0f, scale);
+	vfloat wg = ResizeCrtShadowMask_Gaus8(in, dst + 3.0f, scale);
+	return (a * wa + b * wb + c * wc + d * wd + e * we + f * wf + g * wg) / (wa + wb + wc + wd + we + wf + wg);
 }
 
-static nCine::RHI::Software::sw::vec4 BatchedPartialWhiteMask_USE_PALETTE_maskSample(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 uv)
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vfloat ResizeCrtShadowMask_Scan8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec2 pos, nCine::RHI::Software::sw::wide8::vfloat off, nCine::RHI::Software::sw::wide8::vvec2 texture_size)
 {
 	using namespace nCine::RHI::Software::sw;
-	const BatchedPartialWhiteMask_USE_PALETTE_Uniforms* unis = static_cast<const BatchedPartialWhiteMask_USE_PALETTE_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide8;
+	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	vec4 src = swTexture(in, 0, uv);
-	float palIndex = floor(unis->vPaletteOffset + 0.5f) + floor(src.r * 255.0f + 0.5f);
-	float palX = (mod(palIndex, 256.0f) + 0.5f) / 256.0f;
-	float palY = (floor(palIndex / 256.0f) + 0.5f) / 256.0f;
-	vec4 c = swTexture(in, 1, vec2(palX, palY));
-	return vec4(c.rgb(), c.a * src.a);
+	vfloat dst = ResizeCrtShadowMask_Dist8(in, pos, texture_size).y;
+	return ResizeCrtShadowMask_Gaus8(in, dst + off, -6.0f);
 }
 
-void BatchedPartialWhiteMask_USE_PALETTE_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vfloat ResizeCrtShadowMask_BloomScan8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec2 pos, nCine::RHI::Software::sw::wide8::vfloat off, nCine::RHI::Software::sw::wide8::vvec2 texture_size)
 {
 	using namespace nCine::RHI::Software::sw;
-	const BatchedPartialWhiteMask_USE_PALETTE_Uniforms* unis = static_cast<const BatchedPartialWhiteMask_USE_PALETTE_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide8;
+	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	vec4 COLOR;
-	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
-	vec4 tex = BatchedPartialWhiteMask_USE_PALETTE_maskSample(in, vec2(in.u, in.v));
-	float color = min((0.299f * tex.r + 0.587f * tex.g + 0.114f * tex.b) * 2.5f, 1.0f);
-	COLOR = vec4(color, color, color, tex.a) * COLOR;
-	packColor(COLOR, in.rgba);
+	vfloat dst = ResizeCrtShadowMask_Dist8(in, pos, texture_size).y;
+	return ResizeCrtShadowMask_Gaus8(in, dst + off, -2.0f);
 }
 
-		// --- ResizeCrtApertureGrille ---
-struct ResizeCrtApertureGrille_Uniforms
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vvec3 ResizeCrtShadowMask_Tri8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec2 pos, nCine::RHI::Software::sw::wide8::vvec2 texture_size)
 {
-	nCine::RHI::Software::sw::vec2 vTexSize;
-	nCine::RHI::Software::sw::vec2 vViewSize;
-};
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec3 a = ResizeCrtShadowMask_Horz38(in, pos, -1.0f, texture_size);
+	vvec3 b = ResizeCrtShadowMask_Horz58(in, pos, 0.0f, texture_size);
+	vvec3 c = ResizeCrtShadowMask_Horz38(in, pos, 1.0f, texture_size);
+	vfloat wa = ResizeCrtShadowMask_Scan8(in, pos, -1.0f, texture_size);
+	vfloat wb = ResizeCrtShadowMask_Scan8(in, pos, 0.0f, texture_size);
+	vfloat wc = ResizeCrtShadowMask_Scan8(in, pos, 1.0f, texture_size);
+	return a * wa + b * wb + c * wc;
+}
 
-void ResizeCrtApertureGrille_ComputeVaryings(void* inputs, const std::uint8_t* instanceBlock)
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vvec3 ResizeCrtShadowMask_Bloom8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec2 pos, nCine::RHI::Software::sw::wide8::vvec2 texture_size)
 {
 	using namespace nCine::RHI::Software::sw;
-	ResizeCrtApertureGrille_Uniforms* io = static_cast<ResizeCrtApertureGrille_Uniforms*>(inputs);
-	(void)io;
-	(void)instanceBlock;
-	io->vTexSize = (*reinterpret_cast<const vec4*>(instanceBlock + 80)).xy();
-	io->vViewSize = (*reinterpret_cast<const vec2*>(instanceBlock + 96));
+	using namespace nCine::RHI::Software::sw::wide8;
+	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec3 a = ResizeCrtShadowMask_Horz58(in, pos, -2.0f, texture_size);
+	vvec3 b = ResizeCrtShadowMask_Horz78(in, pos, -1.0f, texture_size);
+	vvec3 c = ResizeCrtShadowMask_Horz78(in, pos, 0.0f, texture_size);
+	vvec3 d = ResizeCrtShadowMask_Horz78(in, pos, 1.0f, texture_size);
+	vvec3 e = ResizeCrtShadowMask_Horz58(in, pos, 2.0f, texture_size);
+	vfloat wa = ResizeCrtShadowMask_BloomScan8(in, pos, -2.0f, texture_size);
+	vfloat wb = ResizeCrtShadowMask_BloomScan8(in, pos, -1.0f, texture_size);
+	vfloat wc = ResizeCrtShadowMask_BloomScan8(in, pos, 0.0f, texture_size);
+	vfloat wd = ResizeCrtShadowMask_BloomScan8(in, pos, 1.0f, texture_size);
+	vfloat we = ResizeCrtShadowMask_BloomScan8(in, pos, 2.0f, texture_size);
+	return a * wa + b * wb + c * wc + d * wd + e * we;
 }
 
-static float ResizeCrtApertureGrille_ToLinear1(const nCine::RHI::Software::FragmentShaderInput& in, float c)
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vvec2 ResizeCrtShadowMask_Warp8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec2 pos)
 {
 	using namespace nCine::RHI::Software::sw;
-	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide8;
+	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	if (1 == 0) {
-		return c;
-	}
-	return c <= 0.04045f ? c / 12.92f : pow((c + 0.055f) / 1.055f, 2.4f);
+	pos = pos * 2.0f - 1.0f;
+	pos *= vvec2(1.0f + pos.y * pos.y * 0.031f, 1.0f + pos.x * pos.x * 0.041f);
+	return pos * 0.5f + 0.5f;
 }
 
-static nCine::RHI::Software::sw::vec3 ResizeCrtApertureGrille_ToLinear(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec3 c)
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vvec3 ResizeCrtShadowMask_Mask8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec2 pos)
 {
 	using namespace nCine::RHI::Software::sw;
-	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide8;
+	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	if (1 == 0) {
-		return c;
+	vvec3 mask = vec3(0.55f, 0.55f, 0.55f);
+	{
+		const vvec2 _w = vvec2(floor(pos.xy() * vec2(1.0f, 0.5f)));
+		pos.x = _w.x;
+		pos.y = _w.y;
 	}
-	return vec3(ResizeCrtApertureGrille_ToLinear1(in, c.r), ResizeCrtApertureGrille_ToLinear1(in, c.g), ResizeCrtApertureGrille_ToLinear1(in, c.b));
+	pos.x += pos.y * 3.0f;
+	pos.x = fract(pos.x / 6.0f);
+	const vmask _cond0 = vmask(pos.x < 0.333f);
+	const vmask _mask0 = _cond0;
+	if (any(_mask0)) {
+		mask.x = select(_mask0, 1.5f, mask.x);
+	}
+	const vmask _else0 = !_cond0;
+	if (any(_else0)) {
+		const vmask _cond1 = vmask(pos.x < 0.666f);
+		const vmask _mask1 = _else0 & _cond1;
+		if (any(_mask1)) {
+			mask.y = select(_mask1, 1.5f, mask.y);
+		}
+		const vmask _else1 = andNot(_else0, _cond1);
+		if (any(_else1)) {
+			mask.z = select(_else1, 1.5f, mask.z);
+		}
+	}
+	return mask;
 }
 
-static float ResizeCrtApertureGrille_ToSrgb1(const nCine::RHI::Software::FragmentShaderInput& in, float c)
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vvec4 ResizeCrtShadowMask_crt_lottes8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec2 texture_size, nCine::RHI::Software::sw::wide8::vvec2 video_size, nCine::RHI::Software::sw::wide8::vvec2 output_size, nCine::RHI::Software::sw::wide8::vvec2 tex)
 {
 	using namespace nCine::RHI::Software::sw;
-	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide8;
+	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	if (1 == 0) {
-		return c;
+	vvec2 pos = ResizeCrtShadowMask_Warp8(in, tex.xy() * (texture_size.xy() / video_size.xy())) * (video_size.xy() / texture_size.xy());
+	vvec3 outColor = ResizeCrtShadowMask_Tri8(in, pos, texture_size);
+	{
+		const vvec3 _w = vvec3(ResizeCrtShadowMask_Bloom8(in, pos, texture_size) * 1.0f / 12.0f);
+		outColor.x += _w.x;
+		outColor.y += _w.y;
+		outColor.z += _w.z;
 	}
-	return c < 0.0031308f ? c * 12.92f : 1.055f * pow(c, 0.41666f) - 0.055f;
+	{
+		const vvec3 _w = vvec3(ResizeCrtShadowMask_Mask8(in, floor(tex.xy() * (texture_size.xy() / video_size.xy()) * output_size.xy()) + vec2(0.5f, 0.5f)));
+		outColor.x *= _w.x;
+		outColor.y *= _w.y;
+		outColor.z *= _w.z;
+	}
+	return vvec4(ResizeCrtShadowMask_ToSrgb8(in, outColor.xyz()), 1.0f);
 }
 
-static nCine::RHI::Software::sw::vec3 ResizeCrtApertureGrille_ToSrgb(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec3 c)
+DEATH_ENABLE_AVX2 void ResizeCrtShadowMask_Fragment8(const nCine::RHI::Software::FragmentShaderInput8& in)
 {
 	using namespace nCine::RHI::Software::sw;
-	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide8;
+	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	if (1 == 0) {
-		return c;
-	}
-	return vec3(ResizeCrtApertureGrille_ToSrgb1(in, c.r), ResizeCrtApertureGrille_ToSrgb1(in, c.g), ResizeCrtApertureGrille_ToSrgb1(in, c.b));
+	vvec4 COLOR;
+	COLOR = ResizeCrtShadowMask_crt_lottes8(in, unis->vTexSize, unis->vTexSize, unis->vViewSize, swTexCoords(in));
+	packColor(COLOR, in.rgba);
 }
+#endif
 
-static nCine::RHI::Software::sw::vec3 ResizeCrtApertureGrille_Fetch(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 pos, nCine::RHI::Software::sw::vec2 off, nCine::RHI::Software::sw::vec2 texture_size)
+		// --- ShieldFire ---
+struct ShieldFire_Uniforms
+{
+	nCine::RHI::Software::sw::vec4 vShieldRect;
+};
+
+void ShieldFire_ComputeVaryings(void* inputs, const std::uint8_t* instanceBlock)
 {
 	using namespace nCine::RHI::Software::sw;
-	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	ShieldFire_Uniforms* io = static_cast<ShieldFire_Uniforms*>(inputs);
+	(void)io;
+	(void)instanceBlock;
+	io->vShieldRect = (*reinterpret_cast<const vec4*>(instanceBlock + 80));
+}
+
+static float ShieldFire_aastep(const nCine::RHI::Software::FragmentShaderInput& in, float threshold, float value)
+{
+	using namespace nCine::RHI::Software::sw;
+	const ShieldFire_Uniforms* unis = static_cast<const ShieldFire_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	pos = (floor(pos * texture_size.xy() + off) + vec2(0.5f, 0.5f)) / texture_size.xy();
-	return ResizeCrtApertureGrille_ToLinear(in, vec3(1.1f) * swTexture(in, 0, pos.xy()).rgb());
+	float afwidth = length(vec2(dFdx(value), dFdy(value))) * 0.70710678118654757f;
+	return smoothstep(threshold - afwidth, threshold + afwidth, value);
 }
 
-static nCine::RHI::Software::sw::vec2 ResizeCrtApertureGrille_Dist(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 pos, nCine::RHI::Software::sw::vec2 texture_size)
+static float ShieldFire_triangleWave(const nCine::RHI::Software::FragmentShaderInput& in, float x, float period)
 {
 	using namespace nCine::RHI::Software::sw;
-	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	const ShieldFire_Uniforms* unis = static_cast<const ShieldFire_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	pos = pos * texture_size.xy();
-	return -(pos - floor(pos) - vec2(0.5f, 0.5f));
+	float p = x / period;
+	float f = fract(p);
+	return abs(f - 0.5f) * 2.0f;
 }
 
-static float ResizeCrtApertureGrille_Gaus(const nCine::RHI::Software::FragmentShaderInput& in, float pos, float scale)
+void ShieldFire_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
 {
 	using namespace nCine::RHI::Software::sw;
-	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	const ShieldFire_Uniforms* unis = static_cast<const ShieldFire_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	return exp2(scale * pow(abs(pos), 2.0f));
+	vec4 COLOR;
+	vec2 scale = vec4(in.color[0], in.color[1], in.color[2], in.color[3]).xy();
+	vec2 shift1 = unis->vShieldRect.xy();
+	vec2 shift2 = unis->vShieldRect.zw();
+	vec2 vPos = vec2(in.u, in.v).xy() * vec2(2.0f) - vec2(1.0f);
+	float darkness = vec4(in.color[0], in.color[1], in.color[2], in.color[3]).z;
+	float alpha = vec4(in.color[0], in.color[1], in.color[2], in.color[3]).w;
+	float dist = length(vPos);
+	if (dist > 1.0f) {
+		COLOR = vec4(0.0f, 0.0f, 0.0f, 0.0f);
+	} else {
+		vec3 v = vec3(vPos.x, vPos.y, sqrt(1.0f - vPos.x * vPos.x - vPos.y * vPos.y));
+		vec3 n = normalize(v);
+		float b = dot(n, vec3(0.0f, 0.0f, 1.0f));
+		vec2 q = vec2(0.5f - 0.5f * atan(n.z, n.x) / 3.1415926f, -acos(vPos.y) / 3.1415926f);
+		float isNearBorder = 1.0f - ShieldFire_aastep(in, 0.96f, dist);
+		float mask1 = swTexture(in, 0, mod(shift1 + q * scale, 1.0f)).r;
+		float maskNormalized1 = max(1.0f - abs(ShieldFire_triangleWave(in, shift2.y + 0.5f, 2.0f) - mask1) * 6.0f, 0.0f);
+		float mask2 = swTexture(in, 0, mod(shift2 + q * scale, 1.0f)).r;
+		float maskNormalized2 = max(1.0f - abs(ShieldFire_triangleWave(in, shift1.x, 1.333f) - mask2) * 6.0f, 0.0f);
+		float maskSum = min(maskNormalized1 + maskNormalized2, 1.0f);
+		COLOR = vec4(mix(vec3(1.0f, 0.3f, 0.0f), vec3(1.0f, 1.0f, 1.0f), max(maskSum * 2.0f - 1.0f, 0.0f)) * darkness, min(maskSum * b * isNearBorder * 1.3f + 0.1f, 1.0f) * alpha);
+	}
+	packColor(COLOR, in.rgba);
 }
 
-static nCine::RHI::Software::sw::vec3 ResizeCrtApertureGrille_Horz3(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 pos, float off, nCine::RHI::Software::sw::vec2 texture_size)
+static nCine::RHI::Software::sw::wide4::vfloat ShieldFire_aastep4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vfloat threshold, nCine::RHI::Software::sw::wide4::vfloat value)
 {
 	using namespace nCine::RHI::Software::sw;
-	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide4;
+	const ShieldFire_Uniforms* unis = static_cast<const ShieldFire_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	vec3 b = ResizeCrtApertureGrille_Fetch(in, pos, vec2(-1.0f, off), texture_size);
-	vec3 c = ResizeCrtApertureGrille_Fetch(in, pos, vec2(0.0f, off), texture_size);
-	vec3 d = ResizeCrtApertureGrille_Fetch(in, pos, vec2(1.0f, off), texture_size);
-	float dst = ResizeCrtApertureGrille_Dist(in, pos, texture_size).x;
-	float scale = -3.0f;
-	float wb = ResizeCrtApertureGrille_Gaus(in, dst - 1.0f, scale);
-	float wc = ResizeCrtApertureGrille_Gaus(in, dst + 0.0f, scale);
-	float wd = ResizeCrtApertureGrille_Gaus(in, dst + 1.0f, scale);
-	return (b * wb + c * wc + d * wd) / (wb + wc + wd);
+	vfloat afwidth = length(vvec2(dFdx(value), dFdy(value))) * 0.70710678118654757f;
+	return smoothstep(threshold - afwidth, threshold + afwidth, value);
 }
 
-static nCine::RHI::Software::sw::vec3 ResizeCrtApertureGrille_Horz5(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 pos, float off, nCine::RHI::Software::sw::vec2 texture_size)
+static nCine::RHI::Software::sw::wide4::vfloat ShieldFire_triangleWave4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vfloat x, nCine::RHI::Software::sw::wide4::vfloat period)
 {
 	using namespace nCine::RHI::Software::sw;
-	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide4;
+	const ShieldFire_Uniforms* unis = static_cast<const ShieldFire_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	vec3 a = ResizeCrtApertureGrille_Fetch(in, pos, vec2(-2.0f, off), texture_size);
-	vec3 b = ResizeCrtApertureGrille_Fetch(in, pos, vec2(-1.0f, off), texture_size);
-	vec3 c = ResizeCrtApertureGrille_Fetch(in, pos, vec2(0.0f, off), texture_size);
-	vec3 d = ResizeCrtApertureGrille_Fetch(in, pos, vec2(1.0f, off), texture_size);
-	vec3 e = ResizeCrtApertureGrille_Fetch(in, pos, vec2(2.0f, off), texture_size);
-	float dst = ResizeCrtApertureGrille_Dist(in, pos, texture_size).x;
-	float scale = -3.0f;
-	float wa = ResizeCrtApertureGrille_Gaus(in, dst - 2.0f, scale);
-	float wb = ResizeCrtApertureGrille_Gaus(in, dst - 1.0f, scale);
-	float wc = ResizeCrtApertureGrille_Gaus(in, dst + 0.0f, scale);
-	float wd = ResizeCrtApertureGrille_Gaus(in, dst + 1.0f, scale);
-	float we = ResizeCrtApertureGrille_Gaus(in, dst + 2.0f, scale);
-	return (a * wa + b * wb + c * wc + d * wd + e * we) / (wa + wb + wc + wd + we);
+	vfloat p = x / period;
+	vfloat f = fract(p);
+	return abs(f - 0.5f) * 2.0f;
 }
 
-static nCine::RHI::Software::sw::vec3 ResizeCrtApertureGrille_Horz7(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 pos, float off, nCine::RHI::Software::sw::vec2 texture_size)
+void ShieldFire_Fragment4(const nCine::RHI::Software::FragmentShaderInput4& in)
 {
 	using namespace nCine::RHI::Software::sw;
-	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide4;
+	const ShieldFire_Uniforms* unis = static_cast<const ShieldFire_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	vec3 a = ResizeCrtApertureGrille_Fetch(in, pos, vec2(-3.0f, off), texture_size);
-	vec3 b = ResizeCrtApertureGrille_Fetch(in, pos, vec2(-2.0f, off), texture_size);
-	vec3 c = ResizeCrtApertureGrille_Fetch(in, pos, vec2(-1.0f, off), texture_size);
-	vec3 d = ResizeCrtApertureGrille_Fetch(in, pos, vec2(0.0f, off), texture_size);
-	vec3 e = ResizeCrtApertureGrille_Fetch(in, pos, vec2(1.0f, off), texture_size);
-	vec3 f = ResizeCrtApertureGrille_Fetch(in, pos, vec2(2.0f, off), texture_size);
-	vec3 g = ResizeCrtApertureGrille_Fetch(in, pos, vec2(3.0f, off), texture_size);
-	float dst = ResizeCrtApertureGrille_Dist(in, pos, texture_size).x;
-	float scale = -1.5f;
-	float wa = ResizeCrtApertureGrille_Gaus(in, dst - 3.0f, scale);
-	float wb = ResizeCrtApertureGrille_Gaus(in, dst - 2.0f, scale);
-	float wc = ResizeCrtApertureGrille_Gaus(in, dst - 1.0f, scale);
-	float wd = ResizeCrtApertureGrille_Gaus(in, dst + 0.0f, scale);
-	float we = ResizeCrtApertureGrille_Gaus(in, dst + 1.0f, scale);
-	float wf = ResizeCrtApertureGrille_Gaus(in, dst + 2.0f, scale);
-	float wg = ResizeCrtApertureGrille_Gaus(in, dst + 3.0f, scale);
-	return (a * wa + b * wb + c * wc + d * wd + e * we + f * wf + g * wg) / (wa + wb + wc + wd + we + wf + wg);
+	vvec4 COLOR;
+	vec2 scale = vec4(in.color[0], in.color[1], in.color[2], in.color[3]).xy();
+	vec2 shift1 = unis->vShieldRect.xy();
+	vec2 shift2 = unis->vShieldRect.zw();
+	vvec2 vPos = swTexCoords(in).xy() * vec2(2.0f) - vec2(1.0f);
+	float darkness = vec4(in.color[0], in.color[1], in.color[2], in.color[3]).z;
+	float alpha = vec4(in.color[0], in.color[1], in.color[2], in.color[3]).w;
+	vfloat dist = length(vPos);
+	const vmask _cond0 = vmask(dist > 1.0f);
+	const vmask _mask0 = _cond0;
+	if (any(_mask0)) {
+		COLOR = select(_mask0, vec4(0.0f, 0.0f, 0.0f, 0.0f), COLOR);
+	}
+	const vmask _else0 = !_cond0;
+	if (any(_else0)) {
+		vvec3 v = vvec3(vPos.x, vPos.y, sqrt(1.0f - vPos.x * vPos.x - vPos.y * vPos.y));
+		vvec3 n = normalize(v);
+		vfloat b = dot(n, vec3(0.0f, 0.0f, 1.0f));
+		vvec2 q = vvec2(0.5f - 0.5f * atan(n.z, n.x) / 3.1415926f, -acos(vPos.y) / 3.1415926f);
+		vfloat isNearBorder = 1.0f - ShieldFire_aastep4(in, 0.96f, dist);
+		vfloat mask1 = swTexture(in, 0, mod(shift1 + q * scale, 1.0f)).x;
+		vfloat maskNormalized1 = max(1.0f - abs(ShieldFire_triangleWave4(in, shift2.y + 0.5f, 2.0f) - mask1) * 6.0f, 0.0f);
+		vfloat mask2 = swTexture(in, 0, mod(shift2 + q * scale, 1.0f)).x;
+		vfloat maskNormalized2 = max(1.0f - abs(ShieldFire_triangleWave4(in, shift1.x, 1.333f) - mask2) * 6.0f, 0.0f);
+		vfloat maskSum = min(maskNormalized1 + maskNormalized2, 1.0f);
+		COLOR = select(_else0, vvec4(mix(vec3(1.0f, 0.3f, 0.0f), vec3(1.0f, 1.0f, 1.0f), max(maskSum * 2.0f - 1.0f, 0.0f)) * darkness, min(maskSum * b * isNearBorder * 1.3f + 0.1f, 1.0f) * alpha), COLOR);
+	}
+	packColor(COLOR, in.rgba);
 }
 
-static float ResizeCrtApertureGrille_Scan(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 pos, float off, nCine::RHI::Software::sw::vec2 texture_size)
+#if defined(SW_WIDE8)
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vfloat ShieldFire_aastep8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vfloat threshold, nCine::RHI::Software::sw::wide8::vfloat value)
 {
 	using namespace nCine::RHI::Software::sw;
-	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide8;
+	const ShieldFire_Uniforms* unis = static_cast<const ShieldFire_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	float dst = ResizeCrtApertureGrille_Dist(in, pos, texture_size).y;
-	return ResizeCrtApertureGrille_Gaus(in, dst + off, -8.0f);
+	vfloat afwidth = length(vvec2(dFdx(value), dFdy(value))) * 0.70710678118654757f;
+	return smoothstep(threshold - afwidth, threshold + afwidth, value);
 }
 
-static float ResizeCrtApertureGrille_BloomScan(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 pos, float off, nCine::RHI::Software::sw::vec2 texture_size)
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vfloat ShieldFire_triangleWave8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vfloat x, nCine::RHI::Software::sw::wide8::vfloat period)
 {
 	using namespace nCine::RHI::Software::sw;
-	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide8;
+	const ShieldFire_Uniforms* unis = static_cast<const ShieldFire_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	float dst = ResizeCrtApertureGrille_Dist(in, pos, texture_size).y;
-	return ResizeCrtApertureGrille_Gaus(in, dst + off, -2.0f);
+	vfloat p = x / period;
+	vfloat f = fract(p);
+	return abs(f - 0.5f) * 2.0f;
 }
 
-static nCine::RHI::Software::sw::vec3 ResizeCrtApertureGrille_Tri(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 pos, nCine::RHI::Software::sw::vec2 texture_size)
+DEATH_ENABLE_AVX2 void ShieldFire_Fragment8(const nCine::RHI::Software::FragmentShaderInput8& in)
 {
 	using namespace nCine::RHI::Software::sw;
-	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide8;
+	const ShieldFire_Uniforms* unis = static_cast<const ShieldFire_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	vec3 a = ResizeCrtApertureGrille_Horz3(in, pos, -1.0f, texture_size);
-	vec3 b = ResizeCrtApertureGrille_Horz5(in, pos, 0.0f, texture_size);
-	vec3 c = ResizeCrtApertureGrille_Horz3(in, pos, 1.0f, texture_size);
-	float wa = ResizeCrtApertureGrille_Scan(in, pos, -1.0f, texture_size);
-	float wb = ResizeCrtApertureGrille_Scan(in, pos, 0.0f, texture_size);
-	float wc = ResizeCrtApertureGrille_Scan(in, pos, 1.0f, texture_size);
-	return a * wa + b * wb + c * wc;
+	vvec4 COLOR;
+	vec2 scale = vec4(in.color[0], in.color[1], in.color[2], in.color[3]).xy();
+	vec2 shift1 = unis->vShieldRect.xy();
+	vec2 shift2 = unis->vShieldRect.zw();
+	vvec2 vPos = swTexCoords(in).xy() * vec2(2.0f) - vec2(1.0f);
+	float darkness = vec4(in.color[0], in.color[1], in.color[2], in.color[3]).z;
+	float alpha = vec4(in.color[0], in.color[1], in.color[2], in.color[3]).w;
+	vfloat dist = length(vPos);
+	const vmask _cond0 = vmask(dist > 1.0f);
+	const vmask _mask0 = _cond0;
+	if (any(_mask0)) {
+		COLOR = select(_mask0, vec4(0.0f, 0.0f, 0.0f, 0.0f), COLOR);
+	}
+	const vmask _else0 = !_cond0;
+	if (any(_else0)) {
+		vvec3 v = vvec3(vPos.x, vPos.y, sqrt(1.0f - vPos.x * vPos.x - vPos.y * vPos.y));
+		vvec3 n = normalize(v);
+		vfloat b = dot(n, vec3(0.0f, 0.0f, 1.0f));
+		vvec2 q = vvec2(0.5f - 0.5f * atan(n.z, n.x) / 3.1415926f, -acos(vPos.y) / 3.1415926f);
+		vfloat isNearBorder = 1.0f - ShieldFire_aastep8(in, 0.96f, dist);
+		vfloat mask1 = swTexture(in, 0, mod(shift1 + q * scale, 1.0f)).x;
+		vfloat maskNormalized1 = max(1.0f - abs(ShieldFire_triangleWave8(in, shift2.y + 0.5f, 2.0f) - mask1) * 6.0f, 0.0f);
+		vfloat mask2 = swTexture(in, 0, mod(shift2 + q * scale, 1.0f)).x;
+		vfloat maskNormalized2 = max(1.0f - abs(ShieldFire_triangleWave8(in, shift1.x, 1.333f) - mask2) * 6.0f, 0.0f);
+		vfloat maskSum = min(maskNormalized1 + maskNormalized2, 1.0f);
+		COLOR = select(_else0, vvec4(mix(vec3(1.0f, 0.3f, 0.0f), vec3(1.0f, 1.0f, 1.0f), max(maskSum * 2.0f - 1.0f, 0.0f)) * darkness, min(maskSum * b * isNearBorder * 1.3f + 0.1f, 1.0f) * alpha), COLOR);
+	}
+	packColor(COLOR, in.rgba);
+}
+#endif
+
+		// --- ShieldLightning ---
+struct ShieldLightning_Uniforms
+{
+	nCine::RHI::Software::sw::vec4 vShieldRect;
+};
+
+void ShieldLightning_ComputeVaryings(void* inputs, const std::uint8_t* instanceBlock)
+{
+	using namespace nCine::RHI::Software::sw;
+	ShieldLightning_Uniforms* io = static_cast<ShieldLightning_Uniforms*>(inputs);
+	(void)io;
+	(void)instanceBlock;
+	io->vShieldRect = (*reinterpret_cast<const vec4*>(instanceBlock + 80));
 }
 
-static nCine::RHI::Software::sw::vec3 ResizeCrtApertureGrille_Bloom(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 pos, nCine::RHI::Software::sw::vec2 texture_size)
+static float ShieldLightning_aastep(const nCine::RHI::Software::FragmentShaderInput& in, float threshold, float value)
 {
 	using namespace nCine::RHI::Software::sw;
-	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	const ShieldLightning_Uniforms* unis = static_cast<const ShieldLightning_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	vec3 a = ResizeCrtApertureGrille_Horz5(in, pos, -2.0f, texture_size);
-	vec3 b = ResizeCrtApertureGrille_Horz7(in, pos, -1.0f, texture_size);
-	vec3 c = ResizeCrtApertureGrille_Horz7(in, pos, 0.0f, texture_size);
-	vec3 d = ResizeCrtApertureGrille_Horz7(in, pos, 1.0f, texture_size);
-	vec3 e = ResizeCrtApertureGrille_Horz5(in, pos, 2.0f, texture_size);
-	float wa = ResizeCrtApertureGrille_BloomScan(in, pos, -2.0f, texture_size);
-	float wb = ResizeCrtApertureGrille_BloomScan(in, pos, -1.0f, texture_size);
-	float wc = ResizeCrtApertureGrille_BloomScan(in, pos, 0.0f, texture_size);
-	float wd = ResizeCrtApertureGrille_BloomScan(in, pos, 1.0f, texture_size);
-	float we = ResizeCrtApertureGrille_BloomScan(in, pos, 2.0f, texture_size);
-	return a * wa + b * wb + c * wc + d * wd + e * we;
+	float afwidth = length(vec2(dFdx(value), dFdy(value))) * 0.70710678118654757f;
+	return smoothstep(threshold - afwidth, threshold + afwidth, value);
 }
 
-static nCine::RHI::Software::sw::vec2 ResizeCrtApertureGrille_Warp(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 pos)
+static float ShieldLightning_triangleWave(const nCine::RHI::Software::FragmentShaderInput& in, float x, float period)
 {
 	using namespace nCine::RHI::Software::sw;
-	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	const ShieldLightning_Uniforms* unis = static_cast<const ShieldLightning_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	pos = pos * 2.0f - 1.0f;
-	pos *= vec2(1.0f + pos.y * pos.y * 0.0155f, 1.0f + pos.x * pos.x * 0.0205f);
-	return pos * 0.5f + 0.5f;
+	float p = x / period;
+	float f = fract(p);
+	return abs(f - 0.5f) * 2.0f;
 }
 
-static nCine::RHI::Software::sw::vec3 ResizeCrtApertureGrille_Mask(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 pos)
+void ShieldLightning_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
 {
 	using namespace nCine::RHI::Software::sw;
-	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	const ShieldLightning_Uniforms* unis = static_cast<const ShieldLightning_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	vec3 mask = vec3(0.7f, 0.7f, 0.7f);
-	pos.x = fract(pos.x / 3.0f);
-	if (pos.x < 0.333f) {
-		mask.r = 1.5f;
+	vec4 COLOR;
+	vec2 scale = vec4(in.color[0], in.color[1], in.color[2], in.color[3]).xy();
+	vec2 shift1 = unis->vShieldRect.xy();
+	vec2 shift2 = unis->vShieldRect.zw();
+	vec2 vPos = vec2(in.u, in.v).xy() * vec2(2.0f) - vec2(1.0f);
+	float darkness = vec4(in.color[0], in.color[1], in.color[2], in.color[3]).z;
+	float alpha = vec4(in.color[0], in.color[1], in.color[2], in.color[3]).w;
+	float dist = length(vPos);
+	if (dist > 1.0f) {
+		COLOR = vec4(0.0f, 0.0f, 0.0f, 0.0f);
 	} else {
-		if (pos.x < 0.666f) {
-			mask.g = 1.5f;
-		} else {
-			mask.b = 1.5f;
-		}
+		vec3 v = vec3(vPos.x, vPos.y, sqrt(1.0f - vPos.x * vPos.x - vPos.y * vPos.y));
+		vec3 n = normalize(v);
+		float b = dot(n, vec3(0.0f, 0.0f, 1.0f));
+		vec2 q = vec2(0.5f - 0.5f * atan(n.z, n.x) / 3.1415926f, -acos(vPos.y) / 3.1415926f);
+		float isNearBorder = 1.0f - ShieldLightning_aastep(in, 0.96f, dist);
+		float mask = swTexture(in, 0, mod(shift1 + q * scale, 1.0f)).r;
+		float maskNormalized = max(1.0f - abs(ShieldLightning_triangleWave(in, shift2.y + 0.5f, 2.0f) - mask) * 8.0f, 0.0f);
+		float isVeryNearBorder = 1.0f - ShieldLightning_aastep(in, 0.024f, abs(dist - 0.94f));
+		float maskSum = max(maskNormalized, isVeryNearBorder);
+		COLOR = vec4(mix(vec3(0.1f, 1.0f, 0.0f), vec3(1.0f, 1.0f, 1.0f), max(maskSum * 2.0f - 1.0f, 0.0f)) * darkness, min(maskSum * b * isNearBorder * 1.3f + 0.1f, 1.0f) * alpha);
 	}
-	return mask;
+	packColor(COLOR, in.rgba);
 }
 
-static nCine::RHI::Software::sw::vec4 ResizeCrtApertureGrille_crt_lottes(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 texture_size, nCine::RHI::Software::sw::vec2 video_size, nCine::RHI::Software::sw::vec2 output_size, nCine::RHI::Software::sw::vec2 tex)
+static nCine::RHI::Software::sw::wide4::vfloat ShieldLightning_aastep4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vfloat threshold, nCine::RHI::Software::sw::wide4::vfloat value)
 {
 	using namespace nCine::RHI::Software::sw;
-	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide4;
+	const ShieldLightning_Uniforms* unis = static_cast<const ShieldLightning_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	vec2 pos = ResizeCrtApertureGrille_Warp(in, tex.xy() * (texture_size.xy() / video_size.xy())) * (video_size.xy() / texture_size.xy());
-	vec3 outColor = ResizeCrtApertureGrille_Tri(in, pos, texture_size);
-	outColor.rgb() += ResizeCrtApertureGrille_Bloom(in, pos, texture_size) * 1.0f / 16.0f;
-	outColor.rgb() *= ResizeCrtApertureGrille_Mask(in, floor(tex.xy() * (texture_size.xy() / video_size.xy()) * output_size.xy()) + vec2(0.5f, 0.5f));
-	return vec4(ResizeCrtApertureGrille_ToSrgb(in, outColor.rgb()), 1.0f);
+	vfloat afwidth = length(vvec2(dFdx(value), dFdy(value))) * 0.70710678118654757f;
+	return smoothstep(threshold - afwidth, threshold + afwidth, value);
 }
 
-void ResizeCrtApertureGrille_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
+static nCine::RHI::Software::sw::wide4::vfloat ShieldLightning_triangleWave4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vfloat x, nCine::RHI::Software::sw::wide4::vfloat period)
 {
 	using namespace nCine::RHI::Software::sw;
-	const ResizeCrtApertureGrille_Uniforms* unis = static_cast<const ResizeCrtApertureGrille_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide4;
+	const ShieldLightning_Uniforms* unis = static_cast<const ShieldLightning_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	vec4 COLOR;
-	COLOR = ResizeCrtApertureGrille_crt_lottes(in, unis->vTexSize, unis->vTexSize, unis->vViewSize, vec2(in.u, in.v));
-	packColor(COLOR, in.rgba);
+	vfloat p = x / period;
+	vfloat f = fract(p);
+	return abs(f - 0.5f) * 2.0f;
 }
 
-		// --- ResizeCrtShadowMask ---
-struct ResizeCrtShadowMask_Uniforms
-{
-	nCine::RHI::Software::sw::vec2 vTexSize;
-	nCine::RHI::Software::sw::vec2 vViewSize;
-};
-
-void ResizeCrtShadowMask_ComputeVaryings(void* inputs, const std::uint8_t* instanceBlock)
+void ShieldLightning_Fragment4(const nCine::RHI::Software::FragmentShaderInput4& in)
 {
 	using namespace nCine::RHI::Software::sw;
-	ResizeCrtShadowMask_Uniforms* io = static_cast<ResizeCrtShadowMask_Uniforms*>(inputs);
-	(void)io;
-	(void)instanceBlock;
-	io->vTexSize = (*reinterpret_cast<const vec4*>(instanceBlock + 80)).xy();
-	io->vViewSize = (*reinterpret_cast<const vec2*>(instanceBlock + 96));
+	using namespace nCine::RHI::Software::sw::wide4;
+	const ShieldLightning_Uniforms* unis = static_cast<const ShieldLightning_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	vec2 scale = vec4(in.color[0], in.color[1], in.color[2], in.color[3]).xy();
+	vec2 shift1 = unis->vShieldRect.xy();
+	vec2 shift2 = unis->vShieldRect.zw();
+	vvec2 vPos = swTexCoords(in).xy() * vec2(2.0f) - vec2(1.0f);
+	float darkness = vec4(in.color[0], in.color[1], in.color[2], in.color[3]).z;
+	float alpha = vec4(in.color[0], in.color[1], in.color[2], in.color[3]).w;
+	vfloat dist = length(vPos);
+	const vmask _cond0 = vmask(dist > 1.0f);
+	const vmask _mask0 = _cond0;
+	if (any(_mask0)) {
+		COLOR = select(_mask0, vec4(0.0f, 0.0f, 0.0f, 0.0f), COLOR);
+	}
+	const vmask _else0 = !_cond0;
+	if (any(_else0)) {
+		vvec3 v = vvec3(vPos.x, vPos.y, sqrt(1.0f - vPos.x * vPos.x - vPos.y * vPos.y));
+		vvec3 n = normalize(v);
+		vfloat b = dot(n, vec3(0.0f, 0.0f, 1.0f));
+		vvec2 q = vvec2(0.5f - 0.5f * atan(n.z, n.x) / 3.1415926f, -acos(vPos.y) / 3.1415926f);
+		vfloat isNearBorder = 1.0f - ShieldLightning_aastep4(in, 0.96f, dist);
+		vfloat mask = swTexture(in, 0, mod(shift1 + q * scale, 1.0f)).x;
+		vfloat maskNormalized = max(1.0f - abs(ShieldLightning_triangleWave4(in, shift2.y + 0.5f, 2.0f) - mask) * 8.0f, 0.0f);
+		vfloat isVeryNearBorder = 1.0f - ShieldLightning_aastep4(in, 0.024f, abs(dist - 0.94f));
+		vfloat maskSum = max(maskNormalized, isVeryNearBorder);
+		COLOR = select(_else0, vvec4(mix(vec3(0.1f, 1.0f, 0.0f), vec3(1.0f, 1.0f, 1.0f), max(maskSum * 2.0f - 1.0f, 0.0f)) * darkness, min(maskSum * b * isNearBorder * 1.3f + 0.1f, 1.0f) * alpha), COLOR);
+	}
+	packColor(COLOR, in.rgba);
 }
 
-static float ResizeCrtShadowMask_ToLinear1(const nCine::RHI::Software::FragmentShaderInput& in, float c)
+#if defined(SW_WIDE8)
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vfloat ShieldLightning_aastep8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vfloat threshold, nCine::RHI::Software::sw::wide8::vfloat value)
 {
 	using namespace nCine::RHI::Software::sw;
-	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide8;
+	const ShieldLightning_Uniforms* unis = static_cast<const ShieldLightning_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	if (1 == 0) {
-		return c;
-	}
-	return c <= 0.04045f ? c / 12.92f : pow((c + 0.055f) / 1.055f, 2.4f);
+	vfloat afwidth = length(vvec2(dFdx(value), dFdy(value))) * 0.70710678118654757f;
+	return smoothstep(threshold - afwidth, threshold + afwidth, value);
 }
 
-static nCine::RHI::Software::sw::vec3 ResizeCrtShadowMask_ToLinear(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec3 c)
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vfloat ShieldLightning_triangleWave8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vfloat x, nCine::RHI::Software::sw::wide8::vfloat period)
 {
 	using namespace nCine::RHI::Software::sw;
-	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide8;
+	const ShieldLightning_Uniforms* unis = static_cast<const ShieldLightning_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	if (1 == 0) {
-		return c;
-	}
-	return vec3(ResizeCrtShadowMask_ToLinear1(in, c.r), ResizeCrtShadowMask_ToLinear1(in, c.g), ResizeCrtShadowMask_ToLinear1(in, c.b));
+	vfloat p = x / period;
+	vfloat f = fract(p);
+	return abs(f - 0.5f) * 2.0f;
 }
 
-static float ResizeCrtShadowMask_ToSrgb1(const nCine::RHI::Software::FragmentShaderInput& in, float c)
+DEATH_ENABLE_AVX2 void ShieldLightning_Fragment8(const nCine::RHI::Software::FragmentShaderInput8& in)
 {
 	using namespace nCine::RHI::Software::sw;
-	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide8;
+	const ShieldLightning_Uniforms* unis = static_cast<const ShieldLightning_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	if (1 == 0) {
-		return c;
+	vvec4 COLOR;
+	vec2 scale = vec4(in.color[0], in.color[1], in.color[2], in.color[3]).xy();
+	vec2 shift1 = unis->vShieldRect.xy();
+	vec2 shift2 = unis->vShieldRect.zw();
+	vvec2 vPos = swTexCoords(in).xy() * vec2(2.0f) - vec2(1.0f);
+	float darkness = vec4(in.color[0], in.color[1], in.color[2], in.color[3]).z;
+	float alpha = vec4(in.color[0], in.color[1], in.color[2], in.color[3]).w;
+	vfloat dist = length(vPos);
+	const vmask _cond0 = vmask(dist > 1.0f);
+	const vmask _mask0 = _cond0;
+	if (any(_mask0)) {
+		COLOR = select(_mask0, vec4(0.0f, 0.0f, 0.0f, 0.0f), COLOR);
 	}
-	return c < 0.0031308f ? c * 12.92f : 1.055f * pow(c, 0.41666f) - 0.055f;
+	const vmask _else0 = !_cond0;
+	if (any(_else0)) {
+		vvec3 v = vvec3(vPos.x, vPos.y, sqrt(1.0f - vPos.x * vPos.x - vPos.y * vPos.y));
+		vvec3 n = normalize(v);
+		vfloat b = dot(n, vec3(0.0f, 0.0f, 1.0f));
+		vvec2 q = vvec2(0.5f - 0.5f * atan(n.z, n.x) / 3.1415926f, -acos(vPos.y) / 3.1415926f);
+		vfloat isNearBorder = 1.0f - ShieldLightning_aastep8(in, 0.96f, dist);
+		vfloat mask = swTexture(in, 0, mod(shift1 + q * scale, 1.0f)).x;
+		vfloat maskNormalized = max(1.0f - abs(ShieldLightning_triangleWave8(in, shift2.y + 0.5f, 2.0f) - mask) * 8.0f, 0.0f);
+		vfloat isVeryNearBorder = 1.0f - ShieldLightning_aastep8(in, 0.024f, abs(dist - 0.94f));
+		vfloat maskSum = max(maskNormalized, isVeryNearBorder);
+		COLOR = select(_else0, vvec4(mix(vec3(0.1f, 1.0f, 0.0f), vec3(1.0f, 1.0f, 1.0f), max(maskSum * 2.0f - 1.0f, 0.0f)) * darkness, min(maskSum * b * isNearBorder * 1.3f + 0.1f, 1.0f) * alpha), COLOR);
+	}
+	packColor(COLOR, in.rgba);
 }
+#endif
 
-static nCine::RHI::Software::sw::vec3 ResizeCrtShadowMask_ToSrgb(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec3 c)
+		// --- TexturedBackground ---
+struct TexturedBackground_Uniforms
+{
+	nCine::RHI::Software::sw::vec2 uViewSize;
+	nCine::RHI::Software::sw::vec2 uCameraPos;
+	nCine::RHI::Software::sw::vec4 uHorizonColor;
+	nCine::RHI::Software::sw::vec2 uShift;
+};
+
+static nCine::RHI::Software::sw::vec2 TexturedBackground_hash2D(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 p)
 {
 	using namespace nCine::RHI::Software::sw;
-	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
+	const TexturedBackground_Uniforms* unis = static_cast<const TexturedBackground_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	if (1 == 0) {
-		return c;
-	}
-	return vec3(ResizeCrtShadowMask_ToSrgb1(in, c.r), ResizeCrtShadowMask_ToSrgb1(in, c.g), ResizeCrtShadowMask_ToSrgb1(in, c.b));
+	float h = dot(p, vec2(12.9898f, 78.233f));
+	float h2 = dot(p, vec2(37.271f, 377.632f));
+	return -1.0f + 2.0f * vec2(fract(sin(h) * 43758.5453f), fract(sin(h2) * 43758.5453f));
 }
 
-static nCine::RHI::Software::sw::vec3 ResizeCrtShadowMask_Fetch(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 pos, nCine::RHI::Software::sw::vec2 off, nCine::RHI::Software::sw::vec2 texture_size)
+static nCine::RHI::Software::sw::vec3 TexturedBackground_voronoi(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 p)
 {
 	using namespace nCine::RHI::Software::sw;
-	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
+	const TexturedBackground_Uniforms* unis = static_cast<const TexturedBackground_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	pos = (floor(pos * texture_size.xy() + off) + vec2(0.5f, 0.5f)) / texture_size.xy();
-	return ResizeCrtShadowMask_ToLinear(in, vec3(1.0f) * swTexture(in, 0, pos.xy()).rgb());
+	vec2 n = floor(p);
+	vec2 f = fract(p);
+	vec2 mg;
+	vec2 mr;
+	float md = 8.0f;
+	for (int j = -1; j <= 1; ++j) {
+		for (int i = -1; i <= 1; ++i) {
+			vec2 g = vec2(float(i), float(j));
+			vec2 o = TexturedBackground_hash2D(in, n + g);
+			vec2 r = g + o - f;
+			float d = dot(r, r);
+			if (d < md) {
+				md = d;
+				mr = r;
+				mg = g;
+			}
+		}
+	}
+	return vec3(md, mr);
 }
 
-static nCine::RHI::Software::sw::vec2 ResizeCrtShadowMask_Dist(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 pos, nCine::RHI::Software::sw::vec2 texture_size)
+static float TexturedBackground_addStarField(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 samplePosition, float threshold)
 {
 	using namespace nCine::RHI::Software::sw;
-	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
+	const TexturedBackground_Uniforms* unis = static_cast<const TexturedBackground_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	pos = pos * texture_size.xy();
-	return -(pos - floor(pos) - vec2(0.5f, 0.5f));
+	vec3 starValue = TexturedBackground_voronoi(in, samplePosition);
+	if (starValue.x < threshold) {
+		float power = 1.0f - starValue.x / threshold;
+		return min(power * power * power, 0.5f);
+	}
+	return 0.0f;
 }
 
-static float ResizeCrtShadowMask_Gaus(const nCine::RHI::Software::FragmentShaderInput& in, float pos, float scale)
+void TexturedBackground_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
 {
 	using namespace nCine::RHI::Software::sw;
-	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
+	const TexturedBackground_Uniforms* unis = static_cast<const TexturedBackground_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	return exp2(scale * pow(abs(pos), 2.0f));
+	vec4 COLOR;
+	float distance = 1.3f - abs(2.0f * vec2(in.u, in.v).y - 1.0f);
+	float horizonDepth = distance;
+	float yShift = vec2(in.u, in.v).y > 0.5f ? 1.0f : 0.0f;
+	float correction = unis->uViewSize.x * 9.0f / (unis->uViewSize.y * 16.0f);
+	vec2 texturePos = vec2(unis->uShift.x / 256.0f + (vec2(in.u, in.v).x - 0.5f) * (0.5f + 1.5f * horizonDepth) * correction, unis->uShift.y / 256.0f + (vec2(in.u, in.v).y - yShift) * 1.4f * distance);
+	vec4 texColor = swTexture(in, 0, texturePos);
+	float horizonOpacity = clamp(distance * distance - 0.3f, 0.0f, 1.0f);
+	vec4 horizonColorWithStars = vec4(unis->uHorizonColor.xyz(), 1.0f);
+	COLOR = mix(texColor, horizonColorWithStars, horizonOpacity);
+	COLOR.a = 1.0f;
+	packColor(COLOR, in.rgba);
 }
 
-static nCine::RHI::Software::sw::vec3 ResizeCrtShadowMask_Horz3(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 pos, float off, nCine::RHI::Software::sw::vec2 texture_size)
+static nCine::RHI::Software::sw::wide4::vvec2 TexturedBackground_hash2D4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec2 p)
 {
 	using namespace nCine::RHI::Software::sw;
-	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide4;
+	const TexturedBackground_Uniforms* unis = static_cast<const TexturedBackground_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	vec3 b = ResizeCrtShadowMask_Fetch(in, pos, vec2(-1.0f, off), texture_size);
-	vec3 c = ResizeCrtShadowMask_Fetch(in, pos, vec2(0.0f, off), texture_size);
-	vec3 d = ResizeCrtShadowMask_Fetch(in, pos, vec2(1.0f, off), texture_size);
-	float dst = ResizeCrtShadowMask_Dist(in, pos, texture_size).x;
-	float scale = -3.0f;
-	float wb = ResizeCrtShadowMask_Gaus(in, dst - 1.0f, scale);
-	float wc = ResizeCrtShadowMask_Gaus(in, dst + 0.0f, scale);
-	float wd = ResizeCrtShadowMask_Gaus(in, dst + 1.0f, scale);
-	return (b * wb + c * wc + d * wd) / (wb + wc + wd);
+	vfloat h = dot(p, vec2(12.9898f, 78.233f));
+	vfloat h2 = dot(p, vec2(37.271f, 377.632f));
+	return -1.0f + 2.0f * vvec2(fract(sin(h) * 43758.5453f), fract(sin(h2) * 43758.5453f));
 }
 
-static nCine::RHI::Software::sw::vec3 ResizeCrtShadowMask_Horz5(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 pos, float off, nCine::RHI::Software::sw::vec2 texture_size)
+static nCine::RHI::Software::sw::wide4::vvec3 TexturedBackground_voronoi4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec2 p)
 {
 	using namespace nCine::RHI::Software::sw;
-	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide4;
+	const TexturedBackground_Uniforms* unis = static_cast<const TexturedBackground_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	vec3 a = ResizeCrtShadowMask_Fetch(in, pos, vec2(-2.0f, off), texture_size);
-	vec3 b = ResizeCrtShadowMask_Fetch(in, pos, vec2(-1.0f, off), texture_size);
-	vec3 c = ResizeCrtShadowMask_Fetch(in, pos, vec2(0.0f, off), texture_size);
-	vec3 d = ResizeCrtShadowMask_Fetch(in, pos, vec2(1.0f, off), texture_size);
-	vec3 e = ResizeCrtShadowMask_Fetch(in, pos, vec2(2.0f, off), texture_size);
-	float dst = ResizeCrtShadowMask_Dist(in, pos, texture_size).x;
-	float scale = -3.0f;
-	float wa = ResizeCrtShadowMask_Gaus(in, dst - 2.0f, scale);
-	float wb = ResizeCrtShadowMask_Gaus(in, dst - 1.0f, scale);
-	float wc = ResizeCrtShadowMask_Gaus(in, dst + 0.0f, scale);
-	float wd = ResizeCrtShadowMask_Gaus(in, dst + 1.0f, scale);
-	float we = ResizeCrtShadowMask_Gaus(in, dst + 2.0f, scale);
-	return (a * wa + b * wb + c * wc + d * wd + e * we) / (wa + wb + wc + wd + we);
+	vvec2 n = floor(p);
+	vvec2 f = fract(p);
+	vvec2 mg;
+	vvec2 mr;
+	vfloat md = 8.0f;
+	for (int j = -1; j <= 1; ++j) {
+		for (int i = -1; i <= 1; ++i) {
+			vec2 g = vec2(float(i), float(j));
+			vvec2 o = TexturedBackground_hash2D4(in, n + g);
+			vvec2 r = g + o - f;
+			vfloat d = dot(r, r);
+			const vmask _cond0 = vmask(d < md);
+			const vmask _mask0 = _cond0;
+			if (any(_mask0)) {
+				md = select(_mask0, d, md);
+				mr = select(_mask0, r, mr);
+				mg = select(_mask0, g, mg);
+			}
+		}
+	}
+	return vvec3(md, mr);
 }
 
-static nCine::RHI::Software::sw::vec3 ResizeCrtShadowMask_Horz7(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 pos, float off, nCine::RHI::Software::sw::vec2 texture_size)
+static nCine::RHI::Software::sw::wide4::vfloat TexturedBackground_addStarField4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec2 samplePosition, nCine::RHI::Software::sw::wide4::vfloat threshold)
 {
 	using namespace nCine::RHI::Software::sw;
-	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide4;
+	const TexturedBackground_Uniforms* unis = static_cast<const TexturedBackground_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	vec3 a = ResizeCrtShadowMask_Fetch(in, pos, vec2(-3.0f, off), texture_size);
-	vec3 b = ResizeCrtShadowMask_Fetch(in, pos, vec2(-2.0f, off), texture_size);
-	vec3 c = ResizeCrtShadowMask_Fetch(in, pos, vec2(-1.0f, off), texture_size);
-	vec3 d = ResizeCrtShadowMask_Fetch(in, pos, vec2(0.0f, off), texture_size);
-	vec3 e = ResizeCrtShadowMask_Fetch(in, pos, vec2(1.0f, off), texture_size);
-	vec3 f = ResizeCrtShadowMask_Fetch(in, pos, vec2(2.0f, off), texture_size);
-	vec3 g = ResizeCrtShadowMask_Fetch(in, pos, vec2(3.0f, off), texture_size);
-	float dst = ResizeCrtShadowMask_Dist(in, pos, texture_size).x;
-	float scale = -1.5f;
-	float wa = ResizeCrtShadowMask_Gaus(in, dst - 3.0f, scale);
-	float wb = ResizeCrtShadowMask_Gaus(in, dst - 2.0f, scale);
-	float wc = ResizeCrtShadowMask_Gaus(in, dst - 1.0f, scale);
-	float wd = ResizeCrtShadowMask_Gaus(in, dst + 0.0f, scale);
-	float we = ResizeCrtShadowMask_Gaus(in, dst + 1.0f, scale);
-	float wf = ResizeCrtShadowMask_Gaus(in, dst + 2.0f, scale);
-	float wg = ResizeCrtShadowMask_Gaus(in, dst + 3.0f, scale);
-	return (a * wa + b * wb + c * wc + d * wd + e * we + f * wf + g * wg) / (wa + wb + wc + wd + we + wf + wg);
+	vfloat _ret = vfloat();
+	vmask _live(true);
+	vvec3 starValue = TexturedBackground_voronoi4(in, samplePosition);
+	const vmask _cond0 = vmask(starValue.x < threshold);
+	const vmask _mask0 = _cond0;
+	if (any(_mask0)) {
+		vfloat power = 1.0f - starValue.x / threshold;
+		_ret = select(_mask0 & _live, min(power * power * power, 0.5f), _ret);
+		_live = andNot(_live, _mask0);
+	}
+	return select(_live, 0.0f, _ret);
+	return _ret;
 }
 
-static float ResizeCrtShadowMask_Scan(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 pos, float off, nCine::RHI::Software::sw::vec2 texture_size)
+void TexturedBackground_Fragment4(const nCine::RHI::Software::FragmentShaderInput4& in)
 {
 	using namespace nCine::RHI::Software::sw;
-	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide4;
+	const TexturedBackground_Uniforms* unis = static_cast<const TexturedBackground_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	float dst = ResizeCrtShadowMask_Dist(in, pos, texture_size).y;
-	return ResizeCrtShadowMask_Gaus(in, dst + off, -6.0f);
+	vvec4 COLOR;
+	vfloat distance = 1.3f - abs(2.0f * swTexCoords(in).y - 1.0f);
+	vfloat horizonDepth = distance;
+	vfloat yShift = select(vmask(swTexCoords(in).y > 0.5f), 1.0f, 0.0f);
+	float correction = unis->uViewSize.x * 9.0f / (unis->uViewSize.y * 16.0f);
+	vvec2 texturePos = vvec2(unis->uShift.x / 256.0f + (swTexCoords(in).x - 0.5f) * (0.5f + 1.5f * horizonDepth) * correction, unis->uShift.y / 256.0f + (swTexCoords(in).y - yShift) * 1.4f * distance);
+	vvec4 texColor = swTexture(in, 0, texturePos);
+	vfloat horizonOpacity = clamp(distance * distance - 0.3f, 0.0f, 1.0f);
+	vec4 horizonColorWithStars = vec4(unis->uHorizonColor.xyz(), 1.0f);
+	COLOR = mix(texColor, horizonColorWithStars, horizonOpacity);
+	COLOR.w = 1.0f;
+	packColor(COLOR, in.rgba);
 }
 
-static float ResizeCrtShadowMask_BloomScan(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 pos, float off, nCine::RHI::Software::sw::vec2 texture_size)
+#if defined(SW_WIDE8)
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vvec2 TexturedBackground_hash2D8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec2 p)
 {
 	using namespace nCine::RHI::Software::sw;
-	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide8;
+	const TexturedBackground_Uniforms* unis = static_cast<const TexturedBackground_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	float dst = ResizeCrtShadowMask_Dist(in, pos, texture_size).y;
-	return ResizeCrtShadowMask_Gaus(in, dst + off, -2.0f);
+	vfloat h = dot(p, vec2(12.9898f, 78.233f));
+	vfloat h2 = dot(p, vec2(37.271f, 377.632f));
+	return -1.0f + 2.0f * vvec2(fract(sin(h) * 43758.5453f), fract(sin(h2) * 43758.5453f));
 }
 
-static nCine::RHI::Software::sw::vec3 ResizeCrtShadowMask_Tri(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 pos, nCine::RHI::Software::sw::vec2 texture_size)
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vvec3 TexturedBackground_voronoi8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec2 p)
 {
 	using namespace nCine::RHI::Software::sw;
-	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide8;
+	const TexturedBackground_Uniforms* unis = static_cast<const TexturedBackground_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	vec3 a = ResizeCrtShadowMask_Horz3(in, pos, -1.0f, texture_size);
-	vec3 b = ResizeCrtShadowMask_Horz5(in, pos, 0.0f, texture_size);
-	vec3 c = ResizeCrtShadowMask_Horz3(in, pos, 1.0f, texture_size);
-	float wa = ResizeCrtShadowMask_Scan(in, pos, -1.0f, texture_size);
-	float wb = ResizeCrtShadowMask_Scan(in, pos, 0.0f, texture_size);
-	float wc = ResizeCrtShadowMask_Scan(in, pos, 1.0f, texture_size);
-	return a * wa + b * wb + c * wc;
+	vvec2 n = floor(p);
+	vvec2 f = fract(p);
+	vvec2 mg;
+	vvec2 mr;
+	vfloat md = 8.0f;
+	for (int j = -1; j <= 1; ++j) {
+		for (int i = -1; i <= 1; ++i) {
+			vec2 g = vec2(float(i), float(j));
+			vvec2 o = TexturedBackground_hash2D8(in, n + g);
+			vvec2 r = g + o - f;
+			vfloat d = dot(r, r);
+			const vmask _cond0 = vmask(d < md);
+			const vmask _mask0 = _cond0;
+			if (any(_mask0)) {
+				md = select(_mask0, d, md);
+				mr = select(_mask0, r, mr);
+				mg = select(_mask0, g, mg);
+			}
+		}
+	}
+	return vvec3(md, mr);
 }
 
-static nCine::RHI::Software::sw::vec3 ResizeCrtShadowMask_Bloom(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 pos, nCine::RHI::Software::sw::vec2 texture_size)
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vfloat TexturedBackground_addStarField8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec2 samplePosition, nCine::RHI::Software::sw::wide8::vfloat threshold)
 {
 	using namespace nCine::RHI::Software::sw;
-	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide8;
+	const TexturedBackground_Uniforms* unis = static_cast<const TexturedBackground_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	vec3 a = ResizeCrtShadowMask_Horz5(in, pos, -2.0f, texture_size);
-	vec3 b = ResizeCrtShadowMask_Horz7(in, pos, -1.0f, texture_size);
-	vec3 c = ResizeCrtShadowMask_Horz7(in, pos, 0.0f, texture_size);
-	vec3 d = ResizeCrtShadowMask_Horz7(in, pos, 1.0f, texture_size);
-	vec3 e = ResizeCrtShadowMask_Horz5(in, pos, 2.0f, texture_size);
-	float wa = ResizeCrtShadowMask_BloomScan(in, pos, -2.0f, texture_size);
-	float wb = ResizeCrtShadowMask_BloomScan(in, pos, -1.0f, texture_size);
-	float wc = ResizeCrtShadowMask_BloomScan(in, pos, 0.0f, texture_size);
-	float wd = ResizeCrtShadowMask_BloomScan(in, pos, 1.0f, texture_size);
-	float we = ResizeCrtShadowMask_BloomScan(in, pos, 2.0f, texture_size);
-	return a * wa + b * wb + c * wc + d * wd + e * we;
+	vfloat _ret = vfloat();
+	vmask _live(true);
+	vvec3 starValue = TexturedBackground_voronoi8(in, samplePosition);
+	const vmask _cond0 = vmask(starValue.x < threshold);
+	const vmask _mask0 = _cond0;
+	if (any(_mask0)) {
+		vfloat power = 1.0f - starValue.x / threshold;
+		_ret = select(_mask0 & _live, min(power * power * power, 0.5f), _ret);
+		_live = andNot(_live, _mask0);
+	}
+	return select(_live, 0.0f, _ret);
+	return _ret;
 }
 
-static nCine::RHI::Software::sw::vec2 ResizeCrtShadowMask_Warp(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 pos)
+DEATH_ENABLE_AVX2 void TexturedBackground_Fragment8(const nCine::RHI::Software::FragmentShaderInput8& in)
 {
 	using namespace nCine::RHI::Software::sw;
-	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide8;
+	const TexturedBackground_Uniforms* unis = static_cast<const TexturedBackground_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	pos = pos * 2.0f - 1.0f;
-	pos *= vec2(1.0f + pos.y * pos.y * 0.031f, 1.0f + pos.x * pos.x * 0.041f);
-	return pos * 0.5f + 0.5f;
+	vvec4 COLOR;
+	vfloat distance = 1.3f - abs(2.0f * swTexCoords(in).y - 1.0f);
+	vfloat horizonDepth = distance;
+	vfloat yShift = select(vmask(swTexCoords(in).y > 0.5f), 1.0f, 0.0f);
+	float correction = unis->uViewSize.x * 9.0f / (unis->uViewSize.y * 16.0f);
+	vvec2 texturePos = vvec2(unis->uShift.x / 256.0f + (swTexCoords(in).x - 0.5f) * (0.5f + 1.5f * horizonDepth) * correction, unis->uShift.y / 256.0f + (swTexCoords(in).y - yShift) * 1.4f * distance);
+	vvec4 texColor = swTexture(in, 0, texturePos);
+	vfloat horizonOpacity = clamp(distance * distance - 0.3f, 0.0f, 1.0f);
+	vec4 horizonColorWithStars = vec4(unis->uHorizonColor.xyz(), 1.0f);
+	COLOR = mix(texColor, horizonColorWithStars, horizonOpacity);
+	COLOR.w = 1.0f;
+	packColor(COLOR, in.rgba);
 }
+#endif
 
-static nCine::RHI::Software::sw::vec3 ResizeCrtShadowMask_Mask(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 pos)
+		// --- TexturedBackground_DITHER ---
+struct TexturedBackground_DITHER_Uniforms
+{
+	nCine::RHI::Software::sw::vec2 uViewSize;
+	nCine::RHI::Software::sw::vec2 uCameraPos;
+	nCine::RHI::Software::sw::vec4 uHorizonColor;
+	nCine::RHI::Software::sw::vec2 uShift;
+};
+
+static nCine::RHI::Software::sw::vec2 TexturedBackground_DITHER_hash2D(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 p)
 {
 	using namespace nCine::RHI::Software::sw;
-	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
+	const TexturedBackground_DITHER_Uniforms* unis = static_cast<const TexturedBackground_DITHER_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	vec3 mask = vec3(0.55f, 0.55f, 0.55f);
-	pos.xy() = floor(pos.xy() * vec2(1.0f, 0.5f));
-	pos.x += pos.y * 3.0f;
-	pos.x = fract(pos.x / 6.0f);
-	if (pos.x < 0.333f) {
-		mask.r = 1.5f;
-	} else {
-		if (pos.x < 0.666f) {
-			mask.g = 1.5f;
-		} else {
-			mask.b = 1.5f;
+	float h = dot(p, vec2(12.9898f, 78.233f));
+	float h2 = dot(p, vec2(37.271f, 377.632f));
+	return -1.0f + 2.0f * vec2(fract(sin(h) * 43758.5453f), fract(sin(h2) * 43758.5453f));
+}
+
+static nCine::RHI::Software::sw::vec3 TexturedBackground_DITHER_voronoi(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 p)
+{
+	using namespace nCine::RHI::Software::sw;
+	const TexturedBackground_DITHER_Uniforms* unis = static_cast<const TexturedBackground_DITHER_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vec2 n = floor(p);
+	vec2 f = fract(p);
+	vec2 mg;
+	vec2 mr;
+	float md = 8.0f;
+	for (int j = -1; j <= 1; ++j) {
+		for (int i = -1; i <= 1; ++i) {
+			vec2 g = vec2(float(i), float(j));
+			vec2 o = TexturedBackground_DITHER_hash2D(in, n + g);
+			vec2 r = g + o - f;
+			float d = dot(r, r);
+			if (d < md) {
+				md = d;
+				mr = r;
+				mg = g;
+			}
 		}
 	}
-	return mask;
+	return vec3(md, mr);
 }
 
-static nCine::RHI::Software::sw::vec4 ResizeCrtShadowMask_crt_lottes(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 texture_size, nCine::RHI::Software::sw::vec2 video_size, nCine::RHI::Software::sw::vec2 output_size, nCine::RHI::Software::sw::vec2 tex)
+static float TexturedBackground_DITHER_addStarField(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 samplePosition, float threshold)
 {
 	using namespace nCine::RHI::Software::sw;
-	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
+	const TexturedBackground_DITHER_Uniforms* unis = static_cast<const TexturedBackground_DITHER_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	vec2 pos = ResizeCrtShadowMask_Warp(in, tex.xy() * (texture_size.xy() / video_size.xy())) * (video_size.xy() / texture_size.xy());
-	vec3 outColor = ResizeCrtShadowMask_Tri(in, pos, texture_size);
-	outColor.rgb() += ResizeCrtShadowMask_Bloom(in, pos, texture_size) * 1.0f / 12.0f;
-	outColor.rgb() *= ResizeCrtShadowMask_Mask(in, floor(tex.xy() * (texture_size.xy() / video_size.xy()) * output_size.xy()) + vec2(0.5f, 0.5f));
-	return vec4(ResizeCrtShadowMask_ToSrgb(in, outColor.rgb()), 1.0f);
+	vec3 starValue = TexturedBackground_DITHER_voronoi(in, samplePosition);
+	if (starValue.x < threshold) {
+		float power = 1.0f - starValue.x / threshold;
+		return min(power * power * power, 0.5f);
+	}
+	return 0.0f;
 }
 
-void ResizeCrtShadowMask_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
+void TexturedBackground_DITHER_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
 {
 	using namespace nCine::RHI::Software::sw;
-	const ResizeCrtShadowMask_Uniforms* unis = static_cast<const ResizeCrtShadowMask_Uniforms*>(in.userData);
+	const TexturedBackground_DITHER_Uniforms* unis = static_cast<const TexturedBackground_DITHER_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
 	vec4 COLOR;
-	COLOR = ResizeCrtShadowMask_crt_lottes(in, unis->vTexSize, unis->vTexSize, unis->vViewSize, vec2(in.u, in.v));
+	float distance = 1.3f - abs(2.0f * vec2(in.u, in.v).y - 1.0f);
+	float horizonDepth = distance;
+	float yShift = vec2(in.u, in.v).y > 0.5f ? 1.0f : 0.0f;
+	float correction = unis->uViewSize.x * 9.0f / (unis->uViewSize.y * 16.0f);
+	vec2 texturePos = vec2(unis->uShift.x / 256.0f + (vec2(in.u, in.v).x - 0.5f) * (0.5f + 1.5f * horizonDepth) * correction, unis->uShift.y / 256.0f + (vec2(in.u, in.v).y - yShift) * 1.4f * distance);
+	vec4 texColor = swTexture(in, 0, texturePos);
+	float horizonOpacity = clamp(distance * distance - 0.3f, 0.0f, 1.0f);
+	vec4 horizonColorWithStars = vec4(unis->uHorizonColor.xyz(), 1.0f);
+	COLOR = mix(texColor, horizonColorWithStars, horizonOpacity);
+	COLOR.a = 1.0f;
 	packColor(COLOR, in.rgba);
 }
 
-		// --- ShieldFire ---
-struct ShieldFire_Uniforms
-{
-	nCine::RHI::Software::sw::vec4 vShieldRect;
-};
-
-void ShieldFire_ComputeVaryings(void* inputs, const std::uint8_t* instanceBlock)
+static nCine::RHI::Software::sw::wide4::vvec2 TexturedBackground_DITHER_hash2D4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec2 p)
 {
 	using namespace nCine::RHI::Software::sw;
-	ShieldFire_Uniforms* io = static_cast<ShieldFire_Uniforms*>(inputs);
-	(void)io;
-	(void)instanceBlock;
-	io->vShieldRect = (*reinterpret_cast<const vec4*>(instanceBlock + 80));
+	using namespace nCine::RHI::Software::sw::wide4;
+	const TexturedBackground_DITHER_Uniforms* unis = static_cast<const TexturedBackground_DITHER_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vfloat h = dot(p, vec2(12.9898f, 78.233f));
+	vfloat h2 = dot(p, vec2(37.271f, 377.632f));
+	return -1.0f + 2.0f * vvec2(fract(sin(h) * 43758.5453f), fract(sin(h2) * 43758.5453f));
 }
 
-static float ShieldFire_aastep(const nCine::RHI::Software::FragmentShaderInput& in, float threshold, float value)
+static nCine::RHI::Software::sw::wide4::vvec3 TexturedBackground_DITHER_voronoi4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec2 p)
 {
 	using namespace nCine::RHI::Software::sw;
-	const ShieldFire_Uniforms* unis = static_cast<const ShieldFire_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide4;
+	const TexturedBackground_DITHER_Uniforms* unis = static_cast<const TexturedBackground_DITHER_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	float afwidth = length(vec2(dFdx(value), dFdy(value))) * 0.70710678118654757f;
-	return smoothstep(threshold - afwidth, threshold + afwidth, value);
+	vvec2 n = floor(p);
+	vvec2 f = fract(p);
+	vvec2 mg;
+	vvec2 mr;
+	vfloat md = 8.0f;
+	for (int j = -1; j <= 1; ++j) {
+		for (int i = -1; i <= 1; ++i) {
+			vec2 g = vec2(float(i), float(j));
+			vvec2 o = TexturedBackground_DITHER_hash2D4(in, n + g);
+			vvec2 r = g + o - f;
+			vfloat d = dot(r, r);
+			const vmask _cond0 = vmask(d < md);
+			const vmask _mask0 = _cond0;
+			if (any(_mask0)) {
+				md = select(_mask0, d, md);
+				mr = select(_mask0, r, mr);
+				mg = select(_mask0, g, mg);
+			}
+		}
+	}
+	return vvec3(md, mr);
 }
 
-static float ShieldFire_triangleWave(const nCine::RHI::Software::FragmentShaderInput& in, float x, float period)
+static nCine::RHI::Software::sw::wide4::vfloat TexturedBackground_DITHER_addStarField4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec2 samplePosition, nCine::RHI::Software::sw::wide4::vfloat threshold)
 {
 	using namespace nCine::RHI::Software::sw;
-	const ShieldFire_Uniforms* unis = static_cast<const ShieldFire_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide4;
+	const TexturedBackground_DITHER_Uniforms* unis = static_cast<const TexturedBackground_DITHER_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	float p = x / period;
-	float f = fract(p);
-	return abs(f - 0.5f) * 2.0f;
+	vfloat _ret = vfloat();
+	vmask _live(true);
+	vvec3 starValue = TexturedBackground_DITHER_voronoi4(in, samplePosition);
+	const vmask _cond0 = vmask(starValue.x < threshold);
+	const vmask _mask0 = _cond0;
+	if (any(_mask0)) {
+		vfloat power = 1.0f - starValue.x / threshold;
+		_ret = select(_mask0 & _live, min(power * power * power, 0.5f), _ret);
+		_live = andNot(_live, _mask0);
+	}
+	return select(_live, 0.0f, _ret);
+	return _ret;
 }
 
-void ShieldFire_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
+void TexturedBackground_DITHER_Fragment4(const nCine::RHI::Software::FragmentShaderInput4& in)
 {
 	using namespace nCine::RHI::Software::sw;
-	const ShieldFire_Uniforms* unis = static_cast<const ShieldFire_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide4;
+	const TexturedBackground_DITHER_Uniforms* unis = static_cast<const TexturedBackground_DITHER_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	vec4 COLOR;
-	vec2 scale = vec4(in.color[0], in.color[1], in.color[2], in.color[3]).xy();
-	vec2 shift1 = unis->vShieldRect.xy();
-	vec2 shift2 = unis->vShieldRect.zw();
-	vec2 vPos = vec2(in.u, in.v).xy() * vec2(2.0f) - vec2(1.0f);
-	float darkness = vec4(in.color[0], in.color[1], in.color[2], in.color[3]).z;
-	float alpha = vec4(in.color[0], in.color[1], in.color[2], in.color[3]).w;
-	float dist = length(vPos);
-	if (dist > 1.0f) {
-		COLOR = vec4(0.0f, 0.0f, 0.0f, 0.0f);
-	} else {
-		vec3 v = vec3(vPos.x, vPos.y, sqrt(1.0f - vPos.x * vPos.x - vPos.y * vPos.y));
-		vec3 n = normalize(v);
-		float b = dot(n, vec3(0.0f, 0.0f, 1.0f));
-		vec2 q = vec2(0.5f - 0.5f * atan(n.z, n.x) / 3.1415926f, -acos(vPos.y) / 3.1415926f);
-		float isNearBorder = 1.0f - ShieldFire_aastep(in, 0.96f, dist);
-		float mask1 = swTexture(in, 0, mod(shift1 + q * scale, 1.0f)).r;
-		float maskNormalized1 = max(1.0f - abs(ShieldFire_triangleWave(in, shift2.y + 0.5f, 2.0f) - mask1) * 6.0f, 0.0f);
-		float mask2 = swTexture(in, 0, mod(shift2 + q * scale, 1.0f)).r;
-		float maskNormalized2 = max(1.0f - abs(ShieldFire_triangleWave(in, shift1.x, 1.333f) - mask2) * 6.0f, 0.0f);
-		float maskSum = min(maskNormalized1 + maskNormalized2, 1.0f);
-		COLOR = vec4(mix(vec3(1.0f, 0.3f, 0.0f), vec3(1.0f, 1.0f, 1.0f), max(maskSum * 2.0f - 1.0f, 0.0f)) * darkness, min(maskSum * b * isNearBorder * 1.3f + 0.1f, 1.0f) * alpha);
-	}
+	vvec4 COLOR;
+	vfloat distance = 1.3f - abs(2.0f * swTexCoords(in).y - 1.0f);
+	vfloat horizonDepth = distance;
+	vfloat yShift = select(vmask(swTexCoords(in).y > 0.5f), 1.0f, 0.0f);
+	float correction = unis->uViewSize.x * 9.0f / (unis->uViewSize.y * 16.0f);
+	vvec2 texturePos = vvec2(unis->uShift.x / 256.0f + (swTexCoords(in).x - 0.5f) * (0.5f + 1.5f * horizonDepth) * correction, unis->uShift.y / 256.0f + (swTexCoords(in).y - yShift) * 1.4f * distance);
+	vvec4 texColor = swTexture(in, 0, texturePos);
+	vfloat horizonOpacity = clamp(distance * distance - 0.3f, 0.0f, 1.0f);
+	vec4 horizonColorWithStars = vec4(unis->uHorizonColor.xyz(), 1.0f);
+	COLOR = mix(texColor, horizonColorWithStars, horizonOpacity);
+	COLOR.w = 1.0f;
 	packColor(COLOR, in.rgba);
 }
 
-		// --- ShieldLightning ---
-struct ShieldLightning_Uniforms
-{
-	nCine::RHI::Software::sw::vec4 vShieldRect;
-};
-
-void ShieldLightning_ComputeVaryings(void* inputs, const std::uint8_t* instanceBlock)
+#if defined(SW_WIDE8)
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vvec2 TexturedBackground_DITHER_hash2D8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec2 p)
 {
 	using namespace nCine::RHI::Software::sw;
-	ShieldLightning_Uniforms* io = static_cast<ShieldLightning_Uniforms*>(inputs);
-	(void)io;
-	(void)instanceBlock;
-	io->vShieldRect = (*reinterpret_cast<const vec4*>(instanceBlock + 80));
+	using namespace nCine::RHI::Software::sw::wide8;
+	const TexturedBackground_DITHER_Uniforms* unis = static_cast<const TexturedBackground_DITHER_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vfloat h = dot(p, vec2(12.9898f, 78.233f));
+	vfloat h2 = dot(p, vec2(37.271f, 377.632f));
+	return -1.0f + 2.0f * vvec2(fract(sin(h) * 43758.5453f), fract(sin(h2) * 43758.5453f));
 }
 
-static float ShieldLightning_aastep(const nCine::RHI::Software::FragmentShaderInput& in, float threshold, float value)
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vvec3 TexturedBackground_DITHER_voronoi8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec2 p)
 {
 	using namespace nCine::RHI::Software::sw;
-	const ShieldLightning_Uniforms* unis = static_cast<const ShieldLightning_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide8;
+	const TexturedBackground_DITHER_Uniforms* unis = static_cast<const TexturedBackground_DITHER_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	float afwidth = length(vec2(dFdx(value), dFdy(value))) * 0.70710678118654757f;
-	return smoothstep(threshold - afwidth, threshold + afwidth, value);
+	vvec2 n = floor(p);
+	vvec2 f = fract(p);
+	vvec2 mg;
+	vvec2 mr;
+	vfloat md = 8.0f;
+	for (int j = -1; j <= 1; ++j) {
+		for (int i = -1; i <= 1; ++i) {
+			vec2 g = vec2(float(i), float(j));
+			vvec2 o = TexturedBackground_DITHER_hash2D8(in, n + g);
+			vvec2 r = g + o - f;
+			vfloat d = dot(r, r);
+			const vmask _cond0 = vmask(d < md);
+			const vmask _mask0 = _cond0;
+			if (any(_mask0)) {
+				md = select(_mask0, d, md);
+				mr = select(_mask0, r, mr);
+				mg = select(_mask0, g, mg);
+			}
+		}
+	}
+	return vvec3(md, mr);
 }
 
-static float ShieldLightning_triangleWave(const nCine::RHI::Software::FragmentShaderInput& in, float x, float period)
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vfloat TexturedBackground_DITHER_addStarField8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec2 samplePosition, nCine::RHI::Software::sw::wide8::vfloat threshold)
 {
 	using namespace nCine::RHI::Software::sw;
-	const ShieldLightning_Uniforms* unis = static_cast<const ShieldLightning_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide8;
+	const TexturedBackground_DITHER_Uniforms* unis = static_cast<const TexturedBackground_DITHER_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	float p = x / period;
-	float f = fract(p);
-	return abs(f - 0.5f) * 2.0f;
+	vfloat _ret = vfloat();
+	vmask _live(true);
+	vvec3 starValue = TexturedBackground_DITHER_voronoi8(in, samplePosition);
+	const vmask _cond0 = vmask(starValue.x < threshold);
+	const vmask _mask0 = _cond0;
+	if (any(_mask0)) {
+		vfloat power = 1.0f - starValue.x / threshold;
+		_ret = select(_mask0 & _live, min(power * power * power, 0.5f), _ret);
+		_live = andNot(_live, _mask0);
+	}
+	return select(_live, 0.0f, _ret);
+	return _ret;
 }
 
-void ShieldLightning_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
+DEATH_ENABLE_AVX2 void TexturedBackground_DITHER_Fragment8(const nCine::RHI::Software::FragmentShaderInput8& in)
 {
 	using namespace nCine::RHI::Software::sw;
-	const ShieldLightning_Uniforms* unis = static_cast<const ShieldLightning_Uniforms*>(in.userData);
-	(void)unis;
-	(void)in;
-	vec4 COLOR;
-	vec2 scale = vec4(in.color[0], in.color[1], in.color[2], in.color[3]).xy();
-	vec2 shift1 = unis->vShieldRect.xy();
-	vec2 shift2 = unis->vShieldRect.zw();
-	vec2 vPos = vec2(in.u, in.v).xy() * vec2(2.0f) - vec2(1.0f);
-	float darkness = vec4(in.color[0], in.color[1], in.color[2], in.color[3]).z;
-	float alpha = vec4(in.color[0], in.color[1], in.color[2], in.color[3]).w;
-	float dist = length(vPos);
-	if (dist > 1.0f) {
-		COLOR = vec4(0.0f, 0.0f, 0.0f, 0.0f);
-	} else {
-		vec3 v = vec3(vPos.x, vPos.y, sqrt(1.0f - vPos.x * vPos.x - vPos.y * vPos.y));
-		vec3 n = normalize(v);
-		float b = dot(n, vec3(0.0f, 0.0f, 1.0f));
-		vec2 q = vec2(0.5f - 0.5f * atan(n.z, n.x) / 3.1415926f, -acos(vPos.y) / 3.1415926f);
-		float isNearBorder = 1.0f - ShieldLightning_aastep(in, 0.96f, dist);
-		float mask = swTexture(in, 0, mod(shift1 + q * scale, 1.0f)).r;
-		float maskNormalized = max(1.0f - abs(ShieldLightning_triangleWave(in, shift2.y + 0.5f, 2.0f) - mask) * 8.0f, 0.0f);
-		float isVeryNearBorder = 1.0f - ShieldLightning_aastep(in, 0.024f, abs(dist - 0.94f));
-		float maskSum = max(maskNormalized, isVeryNearBorder);
-		COLOR = vec4(mix(vec3(0.1f, 1.0f, 0.0f), vec3(1.0f, 1.0f, 1.0f), max(maskSum * 2.0f - 1.0f, 0.0f)) * darkness, min(maskSum * b * isNearBorder * 1.3f + 0.1f, 1.0f) * alpha);
-	}
+	using namespace nCine::RHI::Software::sw::wide8;
+	const TexturedBackground_DITHER_Uniforms* unis = static_cast<const TexturedBackground_DITHER_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	vfloat distance = 1.3f - abs(2.0f * swTexCoords(in).y - 1.0f);
+	vfloat horizonDepth = distance;
+	vfloat yShift = select(vmask(swTexCoords(in).y > 0.5f), 1.0f, 0.0f);
+	float correction = unis->uViewSize.x * 9.0f / (unis->uViewSize.y * 16.0f);
+	vvec2 texturePos = vvec2(unis->uShift.x / 256.0f + (swTexCoords(in).x - 0.5f) * (0.5f + 1.5f * horizonDepth) * correction, unis->uShift.y / 256.0f + (swTexCoords(in).y - yShift) * 1.4f * distance);
+	vvec4 texColor = swTexture(in, 0, texturePos);
+	vfloat horizonOpacity = clamp(distance * distance - 0.3f, 0.0f, 1.0f);
+	vec4 horizonColorWithStars = vec4(unis->uHorizonColor.xyz(), 1.0f);
+	COLOR = mix(texColor, horizonColorWithStars, horizonOpacity);
+	COLOR.w = 1.0f;
 	packColor(COLOR, in.rgba);
 }
+#endif
 
-		// --- TexturedBackground ---
-struct TexturedBackground_Uniforms
+		// --- TexturedBackgroundCircle ---
+struct TexturedBackgroundCircle_Uniforms
 {
 	nCine::RHI::Software::sw::vec2 uViewSize;
 	nCine::RHI::Software::sw::vec2 uCameraPos;
@@ -1908,10 +6412,10 @@ struct TexturedBackground_Uniforms
 	nCine::RHI::Software::sw::vec2 uShift;
 };
 
-static nCine::RHI::Software::sw::vec2 TexturedBackground_hash2D(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 p)
+static nCine::RHI::Software::sw::vec2 TexturedBackgroundCircle_hash2D(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 p)
 {
 	using namespace nCine::RHI::Software::sw;
-	const TexturedBackground_Uniforms* unis = static_cast<const TexturedBackground_Uniforms*>(in.userData);
+	const TexturedBackgroundCircle_Uniforms* unis = static_cast<const TexturedBackgroundCircle_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
 	float h = dot(p, vec2(12.9898f, 78.233f));
@@ -1919,10 +6423,10 @@ static nCine::RHI::Software::sw::vec2 TexturedBackground_hash2D(const nCine::RHI
 	return -1.0f + 2.0f * vec2(fract(sin(h) * 43758.5453f), fract(sin(h2) * 43758.5453f));
 }
 
-static nCine::RHI::Software::sw::vec3 TexturedBackground_voronoi(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 p)
+static nCine::RHI::Software::sw::vec3 TexturedBackgroundCircle_voronoi(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 p)
 {
 	using namespace nCine::RHI::Software::sw;
-	const TexturedBackground_Uniforms* unis = static_cast<const TexturedBackground_Uniforms*>(in.userData);
+	const TexturedBackgroundCircle_Uniforms* unis = static_cast<const TexturedBackgroundCircle_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
 	vec2 n = floor(p);
@@ -1933,7 +6437,7 @@ static nCine::RHI::Software::sw::vec3 TexturedBackground_voronoi(const nCine::RH
 	for (int j = -1; j <= 1; ++j) {
 		for (int i = -1; i <= 1; ++i) {
 			vec2 g = vec2(float(i), float(j));
-			vec2 o = TexturedBackground_hash2D(in, n + g);
+			vec2 o = TexturedBackgroundCircle_hash2D(in, n + g);
 			vec2 r = g + o - f;
 			float d = dot(r, r);
 			if (d < md) {
@@ -1946,13 +6450,13 @@ static nCine::RHI::Software::sw::vec3 TexturedBackground_voronoi(const nCine::RH
 	return vec3(md, mr);
 }
 
-static float TexturedBackground_addStarField(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 samplePosition, float threshold)
+static float TexturedBackgroundCircle_addStarField(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 samplePosition, float threshold)
 {
 	using namespace nCine::RHI::Software::sw;
-	const TexturedBackground_Uniforms* unis = static_cast<const TexturedBackground_Uniforms*>(in.userData);
+	const TexturedBackgroundCircle_Uniforms* unis = static_cast<const TexturedBackgroundCircle_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	vec3 starValue = TexturedBackground_voronoi(in, samplePosition);
+	vec3 starValue = TexturedBackgroundCircle_voronoi(in, samplePosition);
 	if (starValue.x < threshold) {
 		float power = 1.0f - starValue.x / threshold;
 		return min(power * power * power, 0.5f);
@@ -1960,187 +6464,195 @@ static float TexturedBackground_addStarField(const nCine::RHI::Software::Fragmen
 	return 0.0f;
 }
 
-void TexturedBackground_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
+void TexturedBackgroundCircle_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
 {
 	using namespace nCine::RHI::Software::sw;
-	const TexturedBackground_Uniforms* unis = static_cast<const TexturedBackground_Uniforms*>(in.userData);
+	const TexturedBackgroundCircle_Uniforms* unis = static_cast<const TexturedBackgroundCircle_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
 	vec4 COLOR;
-	float distance = 1.3f - abs(2.0f * vec2(in.u, in.v).y - 1.0f);
-	float horizonDepth = distance;
-	float yShift = vec2(in.u, in.v).y > 0.5f ? 1.0f : 0.0f;
-	float correction = unis->uViewSize.x * 9.0f / (unis->uViewSize.y * 16.0f);
-	vec2 texturePos = vec2(unis->uShift.x / 256.0f + (vec2(in.u, in.v).x - 0.5f) * (0.5f + 1.5f * horizonDepth) * correction, unis->uShift.y / 256.0f + (vec2(in.u, in.v).y - yShift) * 1.4f * distance);
+	vec2 targetCoord = vec2(2.0f) * vec2(in.u, in.v) - vec2(1.0f);
+	targetCoord.x *= unis->uViewSize.x / unis->uViewSize.y;
+	float distance = length(targetCoord);
+	float xShift = targetCoord.x == 0.0f ? sign(targetCoord.y) * 0.5f : atan(targetCoord.y, targetCoord.x) * 0.31830988618379067153776752675f;
+	vec2 texturePos = vec2(xShift * 1.0f + unis->uShift.x * 0.01f, 1.0f / distance * 1.4f + unis->uShift.y * 0.002f);
 	vec4 texColor = swTexture(in, 0, texturePos);
-	float horizonOpacity = clamp(distance * distance - 0.3f, 0.0f, 1.0f);
+	float horizonOpacity = 1.0f - clamp(distance * distance - 0.3f, 0.0f, 1.0f);
 	vec4 horizonColorWithStars = vec4(unis->uHorizonColor.xyz(), 1.0f);
 	COLOR = mix(texColor, horizonColorWithStars, horizonOpacity);
 	COLOR.a = 1.0f;
 	packColor(COLOR, in.rgba);
 }
 
-		// --- TexturedBackground_DITHER ---
-struct TexturedBackground_DITHER_Uniforms
-{
-	nCine::RHI::Software::sw::vec2 uViewSize;
-	nCine::RHI::Software::sw::vec2 uCameraPos;
-	nCine::RHI::Software::sw::vec4 uHorizonColor;
-	nCine::RHI::Software::sw::vec2 uShift;
-};
-
-static nCine::RHI::Software::sw::vec2 TexturedBackground_DITHER_hash2D(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 p)
+static nCine::RHI::Software::sw::wide4::vvec2 TexturedBackgroundCircle_hash2D4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec2 p)
 {
 	using namespace nCine::RHI::Software::sw;
-	const TexturedBackground_DITHER_Uniforms* unis = static_cast<const TexturedBackground_DITHER_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide4;
+	const TexturedBackgroundCircle_Uniforms* unis = static_cast<const TexturedBackgroundCircle_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	float h = dot(p, vec2(12.9898f, 78.233f));
-	float h2 = dot(p, vec2(37.271f, 377.632f));
-	return -1.0f + 2.0f * vec2(fract(sin(h) * 43758.5453f), fract(sin(h2) * 43758.5453f));
+	vfloat h = dot(p, vec2(12.9898f, 78.233f));
+	vfloat h2 = dot(p, vec2(37.271f, 377.632f));
+	return -1.0f + 2.0f * vvec2(fract(sin(h) * 43758.5453f), fract(sin(h2) * 43758.5453f));
 }
 
-static nCine::RHI::Software::sw::vec3 TexturedBackground_DITHER_voronoi(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 p)
+static nCine::RHI::Software::sw::wide4::vvec3 TexturedBackgroundCircle_voronoi4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec2 p)
 {
 	using namespace nCine::RHI::Software::sw;
-	const TexturedBackground_DITHER_Uniforms* unis = static_cast<const TexturedBackground_DITHER_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide4;
+	const TexturedBackgroundCircle_Uniforms* unis = static_cast<const TexturedBackgroundCircle_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	vec2 n = floor(p);
-	vec2 f = fract(p);
-	vec2 mg;
-	vec2 mr;
-	float md = 8.0f;
+	vvec2 n = floor(p);
+	vvec2 f = fract(p);
+	vvec2 mg;
+	vvec2 mr;
+	vfloat md = 8.0f;
 	for (int j = -1; j <= 1; ++j) {
 		for (int i = -1; i <= 1; ++i) {
 			vec2 g = vec2(float(i), float(j));
-			vec2 o = TexturedBackground_DITHER_hash2D(in, n + g);
-			vec2 r = g + o - f;
-			float d = dot(r, r);
-			if (d < md) {
-				md = d;
-				mr = r;
-				mg = g;
+			vvec2 o = TexturedBackgroundCircle_hash2D4(in, n + g);
+			vvec2 r = g + o - f;
+			vfloat d = dot(r, r);
+			const vmask _cond0 = vmask(d < md);
+			const vmask _mask0 = _cond0;
+			if (any(_mask0)) {
+				md = select(_mask0, d, md);
+				mr = select(_mask0, r, mr);
+				mg = select(_mask0, g, mg);
 			}
 		}
 	}
-	return vec3(md, mr);
+	return vvec3(md, mr);
 }
 
-static float TexturedBackground_DITHER_addStarField(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 samplePosition, float threshold)
+static nCine::RHI::Software::sw::wide4::vfloat TexturedBackgroundCircle_addStarField4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec2 samplePosition, nCine::RHI::Software::sw::wide4::vfloat threshold)
 {
 	using namespace nCine::RHI::Software::sw;
-	const TexturedBackground_DITHER_Uniforms* unis = static_cast<const TexturedBackground_DITHER_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide4;
+	const TexturedBackgroundCircle_Uniforms* unis = static_cast<const TexturedBackgroundCircle_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	vec3 starValue = TexturedBackground_DITHER_voronoi(in, samplePosition);
-	if (starValue.x < threshold) {
-		float power = 1.0f - starValue.x / threshold;
-		return min(power * power * power, 0.5f);
+	vfloat _ret = vfloat();
+	vmask _live(true);
+	vvec3 starValue = TexturedBackgroundCircle_voronoi4(in, samplePosition);
+	const vmask _cond0 = vmask(starValue.x < threshold);
+	const vmask _mask0 = _cond0;
+	if (any(_mask0)) {
+		vfloat power = 1.0f - starValue.x / threshold;
+		_ret = select(_mask0 & _live, min(power * power * power, 0.5f), _ret);
+		_live = andNot(_live, _mask0);
 	}
-	return 0.0f;
+	return select(_live, 0.0f, _ret);
+	return _ret;
 }
 
-void TexturedBackground_DITHER_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
+void TexturedBackgroundCircle_Fragment4(const nCine::RHI::Software::FragmentShaderInput4& in)
 {
 	using namespace nCine::RHI::Software::sw;
-	const TexturedBackground_DITHER_Uniforms* unis = static_cast<const TexturedBackground_DITHER_Uniforms*>(in.userData);
+	using namespace nCine::RHI::Software::sw::wide4;
+	const TexturedBackgroundCircle_Uniforms* unis = static_cast<const TexturedBackgroundCircle_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	vec4 COLOR;
-	float distance = 1.3f - abs(2.0f * vec2(in.u, in.v).y - 1.0f);
-	float horizonDepth = distance;
-	float yShift = vec2(in.u, in.v).y > 0.5f ? 1.0f : 0.0f;
-	float correction = unis->uViewSize.x * 9.0f / (unis->uViewSize.y * 16.0f);
-	vec2 texturePos = vec2(unis->uShift.x / 256.0f + (vec2(in.u, in.v).x - 0.5f) * (0.5f + 1.5f * horizonDepth) * correction, unis->uShift.y / 256.0f + (vec2(in.u, in.v).y - yShift) * 1.4f * distance);
-	vec4 texColor = swTexture(in, 0, texturePos);
-	float horizonOpacity = clamp(distance * distance - 0.3f, 0.0f, 1.0f);
+	vvec4 COLOR;
+	vvec2 targetCoord = vec2(2.0f) * swTexCoords(in) - vec2(1.0f);
+	targetCoord.x *= unis->uViewSize.x / unis->uViewSize.y;
+	vfloat distance = length(targetCoord);
+	vfloat xShift = select(vmask(targetCoord.x == 0.0f), sign(targetCoord.y) * 0.5f, atan(targetCoord.y, targetCoord.x) * 0.31830988618379067153776752675f);
+	vvec2 texturePos = vvec2(xShift * 1.0f + unis->uShift.x * 0.01f, 1.0f / distance * 1.4f + unis->uShift.y * 0.002f);
+	vvec4 texColor = swTexture(in, 0, texturePos);
+	vfloat horizonOpacity = 1.0f - clamp(distance * distance - 0.3f, 0.0f, 1.0f);
 	vec4 horizonColorWithStars = vec4(unis->uHorizonColor.xyz(), 1.0f);
 	COLOR = mix(texColor, horizonColorWithStars, horizonOpacity);
-	COLOR.a = 1.0f;
+	COLOR.w = 1.0f;
 	packColor(COLOR, in.rgba);
 }
 
-		// --- TexturedBackgroundCircle ---
-struct TexturedBackgroundCircle_Uniforms
-{
-	nCine::RHI::Software::sw::vec2 uViewSize;
-	nCine::RHI::Software::sw::vec2 uCameraPos;
-	nCine::RHI::Software::sw::vec4 uHorizonColor;
-	nCine::RHI::Software::sw::vec2 uShift;
-};
-
-static nCine::RHI::Software::sw::vec2 TexturedBackgroundCircle_hash2D(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 p)
+#if defined(SW_WIDE8)
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vvec2 TexturedBackgroundCircle_hash2D8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec2 p)
 {
 	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
 	const TexturedBackgroundCircle_Uniforms* unis = static_cast<const TexturedBackgroundCircle_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	float h = dot(p, vec2(12.9898f, 78.233f));
-	float h2 = dot(p, vec2(37.271f, 377.632f));
-	return -1.0f + 2.0f * vec2(fract(sin(h) * 43758.5453f), fract(sin(h2) * 43758.5453f));
+	vfloat h = dot(p, vec2(12.9898f, 78.233f));
+	vfloat h2 = dot(p, vec2(37.271f, 377.632f));
+	return -1.0f + 2.0f * vvec2(fract(sin(h) * 43758.5453f), fract(sin(h2) * 43758.5453f));
 }
 
-static nCine::RHI::Software::sw::vec3 TexturedBackgroundCircle_voronoi(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 p)
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vvec3 TexturedBackgroundCircle_voronoi8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec2 p)
 {
 	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
 	const TexturedBackgroundCircle_Uniforms* unis = static_cast<const TexturedBackgroundCircle_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	vec2 n = floor(p);
-	vec2 f = fract(p);
-	vec2 mg;
-	vec2 mr;
-	float md = 8.0f;
+	vvec2 n = floor(p);
+	vvec2 f = fract(p);
+	vvec2 mg;
+	vvec2 mr;
+	vfloat md = 8.0f;
 	for (int j = -1; j <= 1; ++j) {
 		for (int i = -1; i <= 1; ++i) {
 			vec2 g = vec2(float(i), float(j));
-			vec2 o = TexturedBackgroundCircle_hash2D(in, n + g);
-			vec2 r = g + o - f;
-			float d = dot(r, r);
-			if (d < md) {
-				md = d;
-				mr = r;
-				mg = g;
+			vvec2 o = TexturedBackgroundCircle_hash2D8(in, n + g);
+			vvec2 r = g + o - f;
+			vfloat d = dot(r, r);
+			const vmask _cond0 = vmask(d < md);
+			const vmask _mask0 = _cond0;
+			if (any(_mask0)) {
+				md = select(_mask0, d, md);
+				mr = select(_mask0, r, mr);
+				mg = select(_mask0, g, mg);
 			}
 		}
 	}
-	return vec3(md, mr);
+	return vvec3(md, mr);
 }
 
-static float TexturedBackgroundCircle_addStarField(const nCine::RHI::Software::FragmentShaderInput& in, nCine::RHI::Software::sw::vec2 samplePosition, float threshold)
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vfloat TexturedBackgroundCircle_addStarField8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec2 samplePosition, nCine::RHI::Software::sw::wide8::vfloat threshold)
 {
 	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
 	const TexturedBackgroundCircle_Uniforms* unis = static_cast<const TexturedBackgroundCircle_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	vec3 starValue = TexturedBackgroundCircle_voronoi(in, samplePosition);
-	if (starValue.x < threshold) {
-		float power = 1.0f - starValue.x / threshold;
-		return min(power * power * power, 0.5f);
+	vfloat _ret = vfloat();
+	vmask _live(true);
+	vvec3 starValue = TexturedBackgroundCircle_voronoi8(in, samplePosition);
+	const vmask _cond0 = vmask(starValue.x < threshold);
+	const vmask _mask0 = _cond0;
+	if (any(_mask0)) {
+		vfloat power = 1.0f - starValue.x / threshold;
+		_ret = select(_mask0 & _live, min(power * power * power, 0.5f), _ret);
+		_live = andNot(_live, _mask0);
 	}
-	return 0.0f;
+	return select(_live, 0.0f, _ret);
+	return _ret;
 }
 
-void TexturedBackgroundCircle_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
+DEATH_ENABLE_AVX2 void TexturedBackgroundCircle_Fragment8(const nCine::RHI::Software::FragmentShaderInput8& in)
 {
 	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
 	const TexturedBackgroundCircle_Uniforms* unis = static_cast<const TexturedBackgroundCircle_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	vec4 COLOR;
-	vec2 targetCoord = vec2(2.0f) * vec2(in.u, in.v) - vec2(1.0f);
+	vvec4 COLOR;
+	vvec2 targetCoord = vec2(2.0f) * swTexCoords(in) - vec2(1.0f);
 	targetCoord.x *= unis->uViewSize.x / unis->uViewSize.y;
-	float distance = length(targetCoord);
-	float xShift = targetCoord.x == 0.0f ? sign(targetCoord.y) * 0.5f : atan(targetCoord.y, targetCoord.x) * 0.31830988618379067153776752675f;
-	vec2 texturePos = vec2(xShift * 1.0f + unis->uShift.x * 0.01f, 1.0f / distance * 1.4f + unis->uShift.y * 0.002f);
-	vec4 texColor = swTexture(in, 0, texturePos);
-	float horizonOpacity = 1.0f - clamp(distance * distance - 0.3f, 0.0f, 1.0f);
+	vfloat distance = length(targetCoord);
+	vfloat xShift = select(vmask(targetCoord.x == 0.0f), sign(targetCoord.y) * 0.5f, atan(targetCoord.y, targetCoord.x) * 0.31830988618379067153776752675f);
+	vvec2 texturePos = vvec2(xShift * 1.0f + unis->uShift.x * 0.01f, 1.0f / distance * 1.4f + unis->uShift.y * 0.002f);
+	vvec4 texColor = swTexture(in, 0, texturePos);
+	vfloat horizonOpacity = 1.0f - clamp(distance * distance - 0.3f, 0.0f, 1.0f);
 	vec4 horizonColorWithStars = vec4(unis->uHorizonColor.xyz(), 1.0f);
 	COLOR = mix(texColor, horizonColorWithStars, horizonOpacity);
-	COLOR.a = 1.0f;
+	COLOR.w = 1.0f;
 	packColor(COLOR, in.rgba);
 }
+#endif
 
 		// --- TexturedBackgroundCircle_DITHER ---
 struct TexturedBackgroundCircle_DITHER_Uniforms
@@ -2223,6 +6735,176 @@ void TexturedBackgroundCircle_DITHER_Fragment(const nCine::RHI::Software::Fragme
 	packColor(COLOR, in.rgba);
 }
 
+static nCine::RHI::Software::sw::wide4::vvec2 TexturedBackgroundCircle_DITHER_hash2D4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec2 p)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const TexturedBackgroundCircle_DITHER_Uniforms* unis = static_cast<const TexturedBackgroundCircle_DITHER_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vfloat h = dot(p, vec2(12.9898f, 78.233f));
+	vfloat h2 = dot(p, vec2(37.271f, 377.632f));
+	return -1.0f + 2.0f * vvec2(fract(sin(h) * 43758.5453f), fract(sin(h2) * 43758.5453f));
+}
+
+static nCine::RHI::Software::sw::wide4::vvec3 TexturedBackgroundCircle_DITHER_voronoi4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec2 p)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const TexturedBackgroundCircle_DITHER_Uniforms* unis = static_cast<const TexturedBackgroundCircle_DITHER_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec2 n = floor(p);
+	vvec2 f = fract(p);
+	vvec2 mg;
+	vvec2 mr;
+	vfloat md = 8.0f;
+	for (int j = -1; j <= 1; ++j) {
+		for (int i = -1; i <= 1; ++i) {
+			vec2 g = vec2(float(i), float(j));
+			vvec2 o = TexturedBackgroundCircle_DITHER_hash2D4(in, n + g);
+			vvec2 r = g + o - f;
+			vfloat d = dot(r, r);
+			const vmask _cond0 = vmask(d < md);
+			const vmask _mask0 = _cond0;
+			if (any(_mask0)) {
+				md = select(_mask0, d, md);
+				mr = select(_mask0, r, mr);
+				mg = select(_mask0, g, mg);
+			}
+		}
+	}
+	return vvec3(md, mr);
+}
+
+static nCine::RHI::Software::sw::wide4::vfloat TexturedBackgroundCircle_DITHER_addStarField4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec2 samplePosition, nCine::RHI::Software::sw::wide4::vfloat threshold)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const TexturedBackgroundCircle_DITHER_Uniforms* unis = static_cast<const TexturedBackgroundCircle_DITHER_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vfloat _ret = vfloat();
+	vmask _live(true);
+	vvec3 starValue = TexturedBackgroundCircle_DITHER_voronoi4(in, samplePosition);
+	const vmask _cond0 = vmask(starValue.x < threshold);
+	const vmask _mask0 = _cond0;
+	if (any(_mask0)) {
+		vfloat power = 1.0f - starValue.x / threshold;
+		_ret = select(_mask0 & _live, min(power * power * power, 0.5f), _ret);
+		_live = andNot(_live, _mask0);
+	}
+	return select(_live, 0.0f, _ret);
+	return _ret;
+}
+
+void TexturedBackgroundCircle_DITHER_Fragment4(const nCine::RHI::Software::FragmentShaderInput4& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const TexturedBackgroundCircle_DITHER_Uniforms* unis = static_cast<const TexturedBackgroundCircle_DITHER_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	vvec2 targetCoord = vec2(2.0f) * swTexCoords(in) - vec2(1.0f);
+	targetCoord.x *= unis->uViewSize.x / unis->uViewSize.y;
+	vfloat distance = length(targetCoord);
+	vfloat xShift = select(vmask(targetCoord.x == 0.0f), sign(targetCoord.y) * 0.5f, atan(targetCoord.y, targetCoord.x) * 0.31830988618379067153776752675f);
+	vvec2 texturePos = vvec2(xShift * 1.0f + unis->uShift.x * 0.01f, 1.0f / distance * 1.4f + unis->uShift.y * 0.002f);
+	vvec4 texColor = swTexture(in, 0, texturePos);
+	vfloat horizonOpacity = 1.0f - clamp(distance * distance - 0.3f, 0.0f, 1.0f);
+	vec4 horizonColorWithStars = vec4(unis->uHorizonColor.xyz(), 1.0f);
+	COLOR = mix(texColor, horizonColorWithStars, horizonOpacity);
+	COLOR.w = 1.0f;
+	packColor(COLOR, in.rgba);
+}
+
+#if defined(SW_WIDE8)
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vvec2 TexturedBackgroundCircle_DITHER_hash2D8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec2 p)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const TexturedBackgroundCircle_DITHER_Uniforms* unis = static_cast<const TexturedBackgroundCircle_DITHER_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vfloat h = dot(p, vec2(12.9898f, 78.233f));
+	vfloat h2 = dot(p, vec2(37.271f, 377.632f));
+	return -1.0f + 2.0f * vvec2(fract(sin(h) * 43758.5453f), fract(sin(h2) * 43758.5453f));
+}
+
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vvec3 TexturedBackgroundCircle_DITHER_voronoi8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec2 p)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const TexturedBackgroundCircle_DITHER_Uniforms* unis = static_cast<const TexturedBackgroundCircle_DITHER_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec2 n = floor(p);
+	vvec2 f = fract(p);
+	vvec2 mg;
+	vvec2 mr;
+	vfloat md = 8.0f;
+	for (int j = -1; j <= 1; ++j) {
+		for (int i = -1; i <= 1; ++i) {
+			vec2 g = vec2(float(i), float(j));
+			vvec2 o = TexturedBackgroundCircle_DITHER_hash2D8(in, n + g);
+			vvec2 r = g + o - f;
+			vfloat d = dot(r, r);
+			const vmask _cond0 = vmask(d < md);
+			const vmask _mask0 = _cond0;
+			if (any(_mask0)) {
+				md = select(_mask0, d, md);
+				mr = select(_mask0, r, mr);
+				mg = select(_mask0, g, mg);
+			}
+		}
+	}
+	return vvec3(md, mr);
+}
+
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vfloat TexturedBackgroundCircle_DITHER_addStarField8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec2 samplePosition, nCine::RHI::Software::sw::wide8::vfloat threshold)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const TexturedBackgroundCircle_DITHER_Uniforms* unis = static_cast<const TexturedBackgroundCircle_DITHER_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vfloat _ret = vfloat();
+	vmask _live(true);
+	vvec3 starValue = TexturedBackgroundCircle_DITHER_voronoi8(in, samplePosition);
+	const vmask _cond0 = vmask(starValue.x < threshold);
+	const vmask _mask0 = _cond0;
+	if (any(_mask0)) {
+		vfloat power = 1.0f - starValue.x / threshold;
+		_ret = select(_mask0 & _live, min(power * power * power, 0.5f), _ret);
+		_live = andNot(_live, _mask0);
+	}
+	return select(_live, 0.0f, _ret);
+	return _ret;
+}
+
+DEATH_ENABLE_AVX2 void TexturedBackgroundCircle_DITHER_Fragment8(const nCine::RHI::Software::FragmentShaderInput8& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const TexturedBackgroundCircle_DITHER_Uniforms* unis = static_cast<const TexturedBackgroundCircle_DITHER_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	vvec2 targetCoord = vec2(2.0f) * swTexCoords(in) - vec2(1.0f);
+	targetCoord.x *= unis->uViewSize.x / unis->uViewSize.y;
+	vfloat distance = length(targetCoord);
+	vfloat xShift = select(vmask(targetCoord.x == 0.0f), sign(targetCoord.y) * 0.5f, atan(targetCoord.y, targetCoord.x) * 0.31830988618379067153776752675f);
+	vvec2 texturePos = vvec2(xShift * 1.0f + unis->uShift.x * 0.01f, 1.0f / distance * 1.4f + unis->uShift.y * 0.002f);
+	vvec4 texColor = swTexture(in, 0, texturePos);
+	vfloat horizonOpacity = 1.0f - clamp(distance * distance - 0.3f, 0.0f, 1.0f);
+	vec4 horizonColorWithStars = vec4(unis->uHorizonColor.xyz(), 1.0f);
+	COLOR = mix(texColor, horizonColorWithStars, horizonOpacity);
+	COLOR.w = 1.0f;
+	packColor(COLOR, in.rgba);
+}
+#endif
+
 		// --- TileMapMesh ---
 struct TileMapMesh_Uniforms
 {
@@ -2239,6 +6921,32 @@ void TileMapMesh_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
 	packColor(COLOR, in.rgba);
 }
 
+void TileMapMesh_Fragment4(const nCine::RHI::Software::FragmentShaderInput4& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const TileMapMesh_Uniforms* unis = static_cast<const TileMapMesh_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = swTexturePrimary(in, 0) * vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	packColor(COLOR, in.rgba);
+}
+
+#if defined(SW_WIDE8)
+DEATH_ENABLE_AVX2 void TileMapMesh_Fragment8(const nCine::RHI::Software::FragmentShaderInput8& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const TileMapMesh_Uniforms* unis = static_cast<const TileMapMesh_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = swTexturePrimary(in, 0) * vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	packColor(COLOR, in.rgba);
+}
+#endif
+
 		// --- Tinted ---
 struct Tinted_Uniforms
 {
@@ -2250,13 +6958,45 @@ void Tinted_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
 	const Tinted_Uniforms* unis = static_cast<const Tinted_Uniforms*>(in.userData);
 	(void)unis;
 	(void)in;
-	vec4 COLOR;
+	vec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vec4 original = swTexturePrimary(in, 0);
+	vec3 tinted = mix(original.xyz(), COLOR.xyz(), 0.45f);
+	COLOR = vec4(tinted.r, tinted.g, tinted.b, original.a * COLOR.a);
+	packColor(COLOR, in.rgba);
+}
+
+void Tinted_Fragment4(const nCine::RHI::Software::FragmentShaderInput4& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const Tinted_Uniforms* unis = static_cast<const Tinted_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vvec4 original = swTexturePrimary(in, 0);
+	vvec3 tinted = mix(original.xyz(), COLOR.xyz(), 0.45f);
+	COLOR = vvec4(tinted.x, tinted.y, tinted.z, original.w * COLOR.w);
+	packColor(COLOR, in.rgba);
+}
+
+#if defined(SW_WIDE8)
+DEATH_ENABLE_AVX2 void Tinted_Fragment8(const nCine::RHI::Software::FragmentShaderInput8& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const Tinted_Uniforms* unis = static_cast<const Tinted_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
 	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
-	vec4 original = swTexturePrimary(in, 0);
-	vec3 tinted = mix(original.rgb(), COLOR.rgb(), 0.45f);
-	COLOR = vec4(tinted.r, tinted.g, tinted.b, original.a * COLOR.a);
+	vvec4 original = swTexturePrimary(in, 0);
+	vvec3 tinted = mix(original.xyz(), COLOR.xyz(), 0.45f);
+	COLOR = vvec4(tinted.x, tinted.y, tinted.z, original.w * COLOR.w);
 	packColor(COLOR, in.rgba);
 }
+#endif
 
 		// --- Tinted_USE_PALETTE ---
 struct Tinted_USE_PALETTE_Uniforms
@@ -2287,11 +7027,53 @@ void Tinted_USE_PALETTE_Fragment(const nCine::RHI::Software::FragmentShaderInput
 	float palY = (floor(palIndex / 256.0f) + 0.5f) / 256.0f;
 	vec4 original = swTexture(in, 1, vec2(palX, palY));
 	original.a *= src.a;
-	vec3 tinted = mix(original.rgb(), COLOR.rgb(), 0.45f);
+	vec3 tinted = mix(original.xyz(), COLOR.xyz(), 0.45f);
 	COLOR = vec4(tinted.r, tinted.g, tinted.b, original.a * COLOR.a);
 	packColor(COLOR, in.rgba);
 }
 
+void Tinted_USE_PALETTE_Fragment4(const nCine::RHI::Software::FragmentShaderInput4& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const Tinted_USE_PALETTE_Uniforms* unis = static_cast<const Tinted_USE_PALETTE_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vvec4 src = swTexturePrimary(in, 0);
+	vfloat palIndex = floor(unis->vPaletteOffset + 0.5f) + floor(src.x * 255.0f + 0.5f);
+	vfloat palX = (mod(palIndex, 256.0f) + 0.5f) / 256.0f;
+	vfloat palY = (floor(palIndex / 256.0f) + 0.5f) / 256.0f;
+	vvec4 original = swTexture(in, 1, vvec2(palX, palY));
+	original.w *= src.w;
+	vvec3 tinted = mix(original.xyz(), COLOR.xyz(), 0.45f);
+	COLOR = vvec4(tinted.x, tinted.y, tinted.z, original.w * COLOR.w);
+	packColor(COLOR, in.rgba);
+}
+
+#if defined(SW_WIDE8)
+DEATH_ENABLE_AVX2 void Tinted_USE_PALETTE_Fragment8(const nCine::RHI::Software::FragmentShaderInput8& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const Tinted_USE_PALETTE_Uniforms* unis = static_cast<const Tinted_USE_PALETTE_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vvec4 src = swTexturePrimary(in, 0);
+	vfloat palIndex = floor(unis->vPaletteOffset + 0.5f) + floor(src.x * 255.0f + 0.5f);
+	vfloat palX = (mod(palIndex, 256.0f) + 0.5f) / 256.0f;
+	vfloat palY = (floor(palIndex / 256.0f) + 0.5f) / 256.0f;
+	vvec4 original = swTexture(in, 1, vvec2(palX, palY));
+	original.w *= src.w;
+	vvec3 tinted = mix(original.xyz(), COLOR.xyz(), 0.45f);
+	COLOR = vvec4(tinted.x, tinted.y, tinted.z, original.w * COLOR.w);
+	packColor(COLOR, in.rgba);
+}
+#endif
+
 		// --- BatchedTinted ---
 struct BatchedTinted_Uniforms
 {
@@ -2306,11 +7088,43 @@ void BatchedTinted_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
 	vec4 COLOR;
 	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
 	vec4 original = swTexturePrimary(in, 0);
-	vec3 tinted = mix(original.rgb(), COLOR.rgb(), 0.45f);
+	vec3 tinted = mix(original.xyz(), COLOR.xyz(), 0.45f);
 	COLOR = vec4(tinted.r, tinted.g, tinted.b, original.a * COLOR.a);
 	packColor(COLOR, in.rgba);
 }
 
+void BatchedTinted_Fragment4(const nCine::RHI::Software::FragmentShaderInput4& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const BatchedTinted_Uniforms* unis = static_cast<const BatchedTinted_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vvec4 original = swTexturePrimary(in, 0);
+	vvec3 tinted = mix(original.xyz(), COLOR.xyz(), 0.45f);
+	COLOR = vvec4(tinted.x, tinted.y, tinted.z, original.w * COLOR.w);
+	packColor(COLOR, in.rgba);
+}
+
+#if defined(SW_WIDE8)
+DEATH_ENABLE_AVX2 void BatchedTinted_Fragment8(const nCine::RHI::Software::FragmentShaderInput8& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const BatchedTinted_Uniforms* unis = static_cast<const BatchedTinted_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vvec4 original = swTexturePrimary(in, 0);
+	vvec3 tinted = mix(original.xyz(), COLOR.xyz(), 0.45f);
+	COLOR = vvec4(tinted.x, tinted.y, tinted.z, original.w * COLOR.w);
+	packColor(COLOR, in.rgba);
+}
+#endif
+
 		// --- BatchedTinted_USE_PALETTE ---
 struct BatchedTinted_USE_PALETTE_Uniforms
 {
@@ -2340,11 +7154,53 @@ void BatchedTinted_USE_PALETTE_Fragment(const nCine::RHI::Software::FragmentShad
 	float palY = (floor(palIndex / 256.0f) + 0.5f) / 256.0f;
 	vec4 original = swTexture(in, 1, vec2(palX, palY));
 	original.a *= src.a;
-	vec3 tinted = mix(original.rgb(), COLOR.rgb(), 0.45f);
+	vec3 tinted = mix(original.xyz(), COLOR.xyz(), 0.45f);
 	COLOR = vec4(tinted.r, tinted.g, tinted.b, original.a * COLOR.a);
 	packColor(COLOR, in.rgba);
 }
 
+void BatchedTinted_USE_PALETTE_Fragment4(const nCine::RHI::Software::FragmentShaderInput4& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const BatchedTinted_USE_PALETTE_Uniforms* unis = static_cast<const BatchedTinted_USE_PALETTE_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vvec4 src = swTexturePrimary(in, 0);
+	vfloat palIndex = floor(unis->vPaletteOffset + 0.5f) + floor(src.x * 255.0f + 0.5f);
+	vfloat palX = (mod(palIndex, 256.0f) + 0.5f) / 256.0f;
+	vfloat palY = (floor(palIndex / 256.0f) + 0.5f) / 256.0f;
+	vvec4 original = swTexture(in, 1, vvec2(palX, palY));
+	original.w *= src.w;
+	vvec3 tinted = mix(original.xyz(), COLOR.xyz(), 0.45f);
+	COLOR = vvec4(tinted.x, tinted.y, tinted.z, original.w * COLOR.w);
+	packColor(COLOR, in.rgba);
+}
+
+#if defined(SW_WIDE8)
+DEATH_ENABLE_AVX2 void BatchedTinted_USE_PALETTE_Fragment8(const nCine::RHI::Software::FragmentShaderInput8& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const BatchedTinted_USE_PALETTE_Uniforms* unis = static_cast<const BatchedTinted_USE_PALETTE_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vvec4 src = swTexturePrimary(in, 0);
+	vfloat palIndex = floor(unis->vPaletteOffset + 0.5f) + floor(src.x * 255.0f + 0.5f);
+	vfloat palX = (mod(palIndex, 256.0f) + 0.5f) / 256.0f;
+	vfloat palY = (floor(palIndex / 256.0f) + 0.5f) / 256.0f;
+	vvec4 original = swTexture(in, 1, vvec2(palX, palY));
+	original.w *= src.w;
+	vvec3 tinted = mix(original.xyz(), COLOR.xyz(), 0.45f);
+	COLOR = vvec4(tinted.x, tinted.y, tinted.z, original.w * COLOR.w);
+	packColor(COLOR, in.rgba);
+}
+#endif
+
 		// --- Transition ---
 struct Transition_Uniforms
 {
@@ -2402,6 +7258,106 @@ void Transition_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
 	packColor(COLOR, in.rgba);
 }
 
+static nCine::RHI::Software::sw::wide4::vfloat Transition_rand4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec2 xy)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const Transition_Uniforms* unis = static_cast<const Transition_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	return fract(sin(dot(xy.xy(), vec2(12.9898f, 78.233f))) * 43758.5453f);
+}
+
+static nCine::RHI::Software::sw::wide4::vfloat Transition_ease4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vfloat time)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const Transition_Uniforms* unis = static_cast<const Transition_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vfloat _ret = vfloat();
+	vmask _live(true);
+	time *= 2.0f;
+	const vmask _cond0 = vmask(time < 1.0f);
+	const vmask _mask0 = _cond0;
+	if (any(_mask0)) {
+		_ret = select(_mask0 & _live, 0.5f * time * time, _ret);
+		_live = andNot(_live, _mask0);
+	}
+	time -= 1.0f;
+	return select(_live, -0.5f * (time * (time - 2.0f) - 1.0f), _ret);
+	return _ret;
+}
+
+void Transition_Fragment4(const nCine::RHI::Software::FragmentShaderInput4& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const Transition_Uniforms* unis = static_cast<const Transition_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	vvec2 uv = (swTexCoords(in) - vec2(0.5f)) * unis->vCorrection;
+	vfloat distance = length(uv);
+	float progressInner = unis->vProgressTime - 0.22f;
+	distance = (clamp(distance, progressInner, unis->vProgressTime) - progressInner) / (unis->vProgressTime - progressInner);
+	vfloat mixValue = Transition_ease4(in, distance);
+	vfloat noise = 1.0f + Transition_rand4(in, uv) * 0.1f;
+	COLOR = vvec4(0.0f, 0.0f, 0.0f, mixValue * noise);
+	packColor(COLOR, in.rgba);
+}
+
+#if defined(SW_WIDE8)
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vfloat Transition_rand8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec2 xy)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const Transition_Uniforms* unis = static_cast<const Transition_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	return fract(sin(dot(xy.xy(), vec2(12.9898f, 78.233f))) * 43758.5453f);
+}
+
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vfloat Transition_ease8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vfloat time)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const Transition_Uniforms* unis = static_cast<const Transition_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vfloat _ret = vfloat();
+	vmask _live(true);
+	time *= 2.0f;
+	const vmask _cond0 = vmask(time < 1.0f);
+	const vmask _mask0 = _cond0;
+	if (any(_mask0)) {
+		_ret = select(_mask0 & _live, 0.5f * time * time, _ret);
+		_live = andNot(_live, _mask0);
+	}
+	time -= 1.0f;
+	return select(_live, -0.5f * (time * (time - 2.0f) - 1.0f), _ret);
+	return _ret;
+}
+
+DEATH_ENABLE_AVX2 void Transition_Fragment8(const nCine::RHI::Software::FragmentShaderInput8& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const Transition_Uniforms* unis = static_cast<const Transition_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	vvec2 uv = (swTexCoords(in) - vec2(0.5f)) * unis->vCorrection;
+	vfloat distance = length(uv);
+	float progressInner = unis->vProgressTime - 0.22f;
+	distance = (clamp(distance, progressInner, unis->vProgressTime) - progressInner) / (unis->vProgressTime - progressInner);
+	vfloat mixValue = Transition_ease8(in, distance);
+	vfloat noise = 1.0f + Transition_rand8(in, uv) * 0.1f;
+	COLOR = vvec4(0.0f, 0.0f, 0.0f, mixValue * noise);
+	packColor(COLOR, in.rgba);
+}
+#endif
+
 		// --- WhiteMask ---
 struct WhiteMask_Uniforms
 {
@@ -2431,6 +7387,60 @@ void WhiteMask_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
 	packColor(COLOR, in.rgba);
 }
 
+static nCine::RHI::Software::sw::wide4::vvec4 WhiteMask_maskSample4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec2 uv)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const WhiteMask_Uniforms* unis = static_cast<const WhiteMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 src = swTexture(in, 0, uv);
+	return src;
+}
+
+void WhiteMask_Fragment4(const nCine::RHI::Software::FragmentShaderInput4& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const WhiteMask_Uniforms* unis = static_cast<const WhiteMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vvec4 tex = WhiteMask_maskSample4(in, swTexCoords(in));
+	vfloat color = min((0.299f * tex.x + 0.587f * tex.y + 0.114f * tex.z) * 6.0f, 1.0f);
+	COLOR = vvec4(color, color, color, tex.w) * COLOR;
+	packColor(COLOR, in.rgba);
+}
+
+#if defined(SW_WIDE8)
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vvec4 WhiteMask_maskSample8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec2 uv)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const WhiteMask_Uniforms* unis = static_cast<const WhiteMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 src = swTexture(in, 0, uv);
+	return src;
+}
+
+DEATH_ENABLE_AVX2 void WhiteMask_Fragment8(const nCine::RHI::Software::FragmentShaderInput8& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const WhiteMask_Uniforms* unis = static_cast<const WhiteMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vvec4 tex = WhiteMask_maskSample8(in, swTexCoords(in));
+	vfloat color = min((0.299f * tex.x + 0.587f * tex.y + 0.114f * tex.z) * 6.0f, 1.0f);
+	COLOR = vvec4(color, color, color, tex.w) * COLOR;
+	packColor(COLOR, in.rgba);
+}
+#endif
+
 		// --- WhiteMask_USE_PALETTE ---
 struct WhiteMask_USE_PALETTE_Uniforms
 {
@@ -2457,7 +7467,7 @@ static nCine::RHI::Software::sw::vec4 WhiteMask_USE_PALETTE_maskSample(const nCi
 	float palX = (mod(palIndex, 256.0f) + 0.5f) / 256.0f;
 	float palY = (floor(palIndex / 256.0f) + 0.5f) / 256.0f;
 	vec4 c = swTexture(in, 1, vec2(palX, palY));
-	return vec4(c.rgb(), c.a * src.a);
+	return vec4(c.xyz(), c.a * src.a);
 }
 
 void WhiteMask_USE_PALETTE_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
@@ -2474,6 +7484,68 @@ void WhiteMask_USE_PALETTE_Fragment(const nCine::RHI::Software::FragmentShaderIn
 	packColor(COLOR, in.rgba);
 }
 
+static nCine::RHI::Software::sw::wide4::vvec4 WhiteMask_USE_PALETTE_maskSample4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec2 uv)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const WhiteMask_USE_PALETTE_Uniforms* unis = static_cast<const WhiteMask_USE_PALETTE_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 src = swTexture(in, 0, uv);
+	vfloat palIndex = floor(unis->vPaletteOffset + 0.5f) + floor(src.x * 255.0f + 0.5f);
+	vfloat palX = (mod(palIndex, 256.0f) + 0.5f) / 256.0f;
+	vfloat palY = (floor(palIndex / 256.0f) + 0.5f) / 256.0f;
+	vvec4 c = swTexture(in, 1, vvec2(palX, palY));
+	return vvec4(c.xyz(), c.w * src.w);
+}
+
+void WhiteMask_USE_PALETTE_Fragment4(const nCine::RHI::Software::FragmentShaderInput4& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const WhiteMask_USE_PALETTE_Uniforms* unis = static_cast<const WhiteMask_USE_PALETTE_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vvec4 tex = WhiteMask_USE_PALETTE_maskSample4(in, swTexCoords(in));
+	vfloat color = min((0.299f * tex.x + 0.587f * tex.y + 0.114f * tex.z) * 6.0f, 1.0f);
+	COLOR = vvec4(color, color, color, tex.w) * COLOR;
+	packColor(COLOR, in.rgba);
+}
+
+#if defined(SW_WIDE8)
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vvec4 WhiteMask_USE_PALETTE_maskSample8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec2 uv)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const WhiteMask_USE_PALETTE_Uniforms* unis = static_cast<const WhiteMask_USE_PALETTE_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 src = swTexture(in, 0, uv);
+	vfloat palIndex = floor(unis->vPaletteOffset + 0.5f) + floor(src.x * 255.0f + 0.5f);
+	vfloat palX = (mod(palIndex, 256.0f) + 0.5f) / 256.0f;
+	vfloat palY = (floor(palIndex / 256.0f) + 0.5f) / 256.0f;
+	vvec4 c = swTexture(in, 1, vvec2(palX, palY));
+	return vvec4(c.xyz(), c.w * src.w);
+}
+
+DEATH_ENABLE_AVX2 void WhiteMask_USE_PALETTE_Fragment8(const nCine::RHI::Software::FragmentShaderInput8& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const WhiteMask_USE_PALETTE_Uniforms* unis = static_cast<const WhiteMask_USE_PALETTE_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vvec4 tex = WhiteMask_USE_PALETTE_maskSample8(in, swTexCoords(in));
+	vfloat color = min((0.299f * tex.x + 0.587f * tex.y + 0.114f * tex.z) * 6.0f, 1.0f);
+	COLOR = vvec4(color, color, color, tex.w) * COLOR;
+	packColor(COLOR, in.rgba);
+}
+#endif
+
 		// --- BatchedWhiteMask ---
 struct BatchedWhiteMask_Uniforms
 {
@@ -2503,6 +7575,60 @@ void BatchedWhiteMask_Fragment(const nCine::RHI::Software::FragmentShaderInput&
 	packColor(COLOR, in.rgba);
 }
 
+static nCine::RHI::Software::sw::wide4::vvec4 BatchedWhiteMask_maskSample4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec2 uv)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const BatchedWhiteMask_Uniforms* unis = static_cast<const BatchedWhiteMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 src = swTexture(in, 0, uv);
+	return src;
+}
+
+void BatchedWhiteMask_Fragment4(const nCine::RHI::Software::FragmentShaderInput4& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const BatchedWhiteMask_Uniforms* unis = static_cast<const BatchedWhiteMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vvec4 tex = BatchedWhiteMask_maskSample4(in, swTexCoords(in));
+	vfloat color = min((0.299f * tex.x + 0.587f * tex.y + 0.114f * tex.z) * 6.0f, 1.0f);
+	COLOR = vvec4(color, color, color, tex.w) * COLOR;
+	packColor(COLOR, in.rgba);
+}
+
+#if defined(SW_WIDE8)
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vvec4 BatchedWhiteMask_maskSample8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec2 uv)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const BatchedWhiteMask_Uniforms* unis = static_cast<const BatchedWhiteMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 src = swTexture(in, 0, uv);
+	return src;
+}
+
+DEATH_ENABLE_AVX2 void BatchedWhiteMask_Fragment8(const nCine::RHI::Software::FragmentShaderInput8& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const BatchedWhiteMask_Uniforms* unis = static_cast<const BatchedWhiteMask_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vvec4 tex = BatchedWhiteMask_maskSample8(in, swTexCoords(in));
+	vfloat color = min((0.299f * tex.x + 0.587f * tex.y + 0.114f * tex.z) * 6.0f, 1.0f);
+	COLOR = vvec4(color, color, color, tex.w) * COLOR;
+	packColor(COLOR, in.rgba);
+}
+#endif
+
 		// --- BatchedWhiteMask_USE_PALETTE ---
 struct BatchedWhiteMask_USE_PALETTE_Uniforms
 {
@@ -2529,7 +7655,7 @@ static nCine::RHI::Software::sw::vec4 BatchedWhiteMask_USE_PALETTE_maskSample(co
 	float palX = (mod(palIndex, 256.0f) + 0.5f) / 256.0f;
 	float palY = (floor(palIndex / 256.0f) + 0.5f) / 256.0f;
 	vec4 c = swTexture(in, 1, vec2(palX, palY));
-	return vec4(c.rgb(), c.a * src.a);
+	return vec4(c.xyz(), c.a * src.a);
 }
 
 void BatchedWhiteMask_USE_PALETTE_Fragment(const nCine::RHI::Software::FragmentShaderInput& in)
@@ -2546,9 +7672,71 @@ void BatchedWhiteMask_USE_PALETTE_Fragment(const nCine::RHI::Software::FragmentS
 	packColor(COLOR, in.rgba);
 }
 
+static nCine::RHI::Software::sw::wide4::vvec4 BatchedWhiteMask_USE_PALETTE_maskSample4(const nCine::RHI::Software::FragmentShaderInput4& in, nCine::RHI::Software::sw::wide4::vvec2 uv)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const BatchedWhiteMask_USE_PALETTE_Uniforms* unis = static_cast<const BatchedWhiteMask_USE_PALETTE_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 src = swTexture(in, 0, uv);
+	vfloat palIndex = floor(unis->vPaletteOffset + 0.5f) + floor(src.x * 255.0f + 0.5f);
+	vfloat palX = (mod(palIndex, 256.0f) + 0.5f) / 256.0f;
+	vfloat palY = (floor(palIndex / 256.0f) + 0.5f) / 256.0f;
+	vvec4 c = swTexture(in, 1, vvec2(palX, palY));
+	return vvec4(c.xyz(), c.w * src.w);
+}
+
+void BatchedWhiteMask_USE_PALETTE_Fragment4(const nCine::RHI::Software::FragmentShaderInput4& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide4;
+	const BatchedWhiteMask_USE_PALETTE_Uniforms* unis = static_cast<const BatchedWhiteMask_USE_PALETTE_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vvec4 tex = BatchedWhiteMask_USE_PALETTE_maskSample4(in, swTexCoords(in));
+	vfloat color = min((0.299f * tex.x + 0.587f * tex.y + 0.114f * tex.z) * 6.0f, 1.0f);
+	COLOR = vvec4(color, color, color, tex.w) * COLOR;
+	packColor(COLOR, in.rgba);
+}
+
+#if defined(SW_WIDE8)
+DEATH_ENABLE_AVX2 static nCine::RHI::Software::sw::wide8::vvec4 BatchedWhiteMask_USE_PALETTE_maskSample8(const nCine::RHI::Software::FragmentShaderInput8& in, nCine::RHI::Software::sw::wide8::vvec2 uv)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const BatchedWhiteMask_USE_PALETTE_Uniforms* unis = static_cast<const BatchedWhiteMask_USE_PALETTE_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 src = swTexture(in, 0, uv);
+	vfloat palIndex = floor(unis->vPaletteOffset + 0.5f) + floor(src.x * 255.0f + 0.5f);
+	vfloat palX = (mod(palIndex, 256.0f) + 0.5f) / 256.0f;
+	vfloat palY = (floor(palIndex / 256.0f) + 0.5f) / 256.0f;
+	vvec4 c = swTexture(in, 1, vvec2(palX, palY));
+	return vvec4(c.xyz(), c.w * src.w);
+}
+
+DEATH_ENABLE_AVX2 void BatchedWhiteMask_USE_PALETTE_Fragment8(const nCine::RHI::Software::FragmentShaderInput8& in)
+{
+	using namespace nCine::RHI::Software::sw;
+	using namespace nCine::RHI::Software::sw::wide8;
+	const BatchedWhiteMask_USE_PALETTE_Uniforms* unis = static_cast<const BatchedWhiteMask_USE_PALETTE_Uniforms*>(in.userData);
+	(void)unis;
+	(void)in;
+	vvec4 COLOR;
+	COLOR = vec4(in.color[0], in.color[1], in.color[2], in.color[3]);
+	vvec4 tex = BatchedWhiteMask_USE_PALETTE_maskSample8(in, swTexCoords(in));
+	vfloat color = min((0.299f * tex.x + 0.587f * tex.y + 0.114f * tex.z) * 6.0f, 1.0f);
+	COLOR = vvec4(color, color, color, tex.w) * COLOR;
+	packColor(COLOR, in.rgba);
+}
+#endif
+
 		struct SwGeneratedUniformField { const char* name; std::uint32_t offset; std::uint32_t componentCount; };
 		using SwGeneratedComputeVaryingsFn = void (*)(void* inputs, const std::uint8_t* instanceBlock);
-		struct SwGeneratedShaderInfo { const char* name; nCine::RHI::Software::FragmentShaderFn fragment; std::uint32_t uniformsSize; const SwGeneratedUniformField* uniformFields; std::uint32_t uniformFieldCount; SwGeneratedComputeVaryingsFn computeVaryings; };
+		struct SwGeneratedShaderInfo { const char* name; nCine::RHI::Software::FragmentShaderFn fragment; std::uint32_t uniformsSize; const SwGeneratedUniformField* uniformFields; std::uint32_t uniformFieldCount; SwGeneratedComputeVaryingsFn computeVaryings; nCine::RHI::Software::FragmentShader4Fn fragment4; nCine::RHI::Software::FragmentShader8Fn fragment8; };
 
 		const SwGeneratedUniformField Blur_Fields[] = {
 			{ "uPixelOffset", (std::uint32_t)offsetof(Blur_Uniforms, uPixelOffset), 2 },
@@ -2558,6 +7746,12 @@ void BatchedWhiteMask_USE_PALETTE_Fragment(const nCine::RHI::Software::FragmentS
 			{ "uAmbientColor", (std::uint32_t)offsetof(Combine_Uniforms, uAmbientColor), 4 },
 			{ "uTime", (std::uint32_t)offsetof(Combine_Uniforms, uTime), 1 },
 		};
+		const SwGeneratedUniformField CombineWithWater_Fields[] = {
+			{ "uAmbientColor", (std::uint32_t)offsetof(CombineWithWater_Uniforms, uAmbientColor), 4 },
+			{ "uTime", (std::uint32_t)offsetof(CombineWithWater_Uniforms, uTime), 1 },
+			{ "uCameraPos", (std::uint32_t)offsetof(CombineWithWater_Uniforms, uCameraPos), 2 },
+			{ "uWaterLevel", (std::uint32_t)offsetof(CombineWithWater_Uniforms, uWaterLevel), 1 },
+		};
 		const SwGeneratedUniformField CombineWithWaterLow_Fields[] = {
 			{ "uAmbientColor", (std::uint32_t)offsetof(CombineWithWaterLow_Uniforms, uAmbientColor), 4 },
 			{ "uTime", (std::uint32_t)offsetof(CombineWithWaterLow_Uniforms, uTime), 1 },
@@ -2593,55 +7787,56 @@ void BatchedWhiteMask_USE_PALETTE_Fragment(const nCine::RHI::Software::FragmentS
 		};
 
 		const SwGeneratedShaderInfo SwGeneratedShaders[] = {
-			{ "BatchedShieldFire", &BatchedShieldFire_Fragment, (std::uint32_t)sizeof(BatchedShieldFire_Uniforms), nullptr, 0, &BatchedShieldFire_ComputeVaryings },
-			{ "BatchedShieldLightning", &BatchedShieldLightning_Fragment, (std::uint32_t)sizeof(BatchedShieldLightning_Uniforms), nullptr, 0, &BatchedShieldLightning_ComputeVaryings },
-			{ "Blur", &Blur_Fragment, (std::uint32_t)sizeof(Blur_Uniforms), Blur_Fields, 2, nullptr },
-			{ "Colorized", &Colorized_Fragment, (std::uint32_t)sizeof(Colorized_Uniforms), nullptr, 0, nullptr },
-			{ "BatchedColorized", &BatchedColorized_Fragment, (std::uint32_t)sizeof(BatchedColorized_Uniforms), nullptr, 0, nullptr },
-			{ "Combine", &Combine_Fragment, (std::uint32_t)sizeof(Combine_Uniforms), Combine_Fields, 2, &Combine_ComputeVaryings },
-			{ "CombineWithWaterLow", &CombineWithWaterLow_Fragment, (std::uint32_t)sizeof(CombineWithWaterLow_Uniforms), CombineWithWaterLow_Fields, 4, &CombineWithWaterLow_ComputeVaryings },
-			{ "DefaultBatchedMeshSprites", &DefaultBatchedMeshSprites_Fragment, (std::uint32_t)sizeof(DefaultBatchedMeshSprites_Uniforms), nullptr, 0, nullptr },
-			{ "DefaultBatchedMeshSpritesNoTexture", &DefaultBatchedMeshSpritesNoTexture_Fragment, (std::uint32_t)sizeof(DefaultBatchedMeshSpritesNoTexture_Uniforms), nullptr, 0, nullptr },
-			{ "DefaultBatchedSpritesNoTexture", &DefaultBatchedSpritesNoTexture_Fragment, (std::uint32_t)sizeof(DefaultBatchedSpritesNoTexture_Uniforms), nullptr, 0, nullptr },
-			{ "DefaultImGui", &DefaultImGui_Fragment, (std::uint32_t)sizeof(DefaultImGui_Uniforms), nullptr, 0, nullptr },
-			{ "DefaultMeshSprite", &DefaultMeshSprite_Fragment, (std::uint32_t)sizeof(DefaultMeshSprite_Uniforms), nullptr, 0, nullptr },
-			{ "DefaultMeshSpriteNoTexture", &DefaultMeshSpriteNoTexture_Fragment, (std::uint32_t)sizeof(DefaultMeshSpriteNoTexture_Uniforms), nullptr, 0, nullptr },
-			{ "DefaultSprite", &DefaultSprite_Fragment, (std::uint32_t)sizeof(DefaultSprite_Uniforms), nullptr, 0, nullptr },
-			{ "DefaultBatchedSprites", &DefaultBatchedSprites_Fragment, (std::uint32_t)sizeof(DefaultBatchedSprites_Uniforms), nullptr, 0, nullptr },
-			{ "DefaultSpriteNoTexture", &DefaultSpriteNoTexture_Fragment, (std::uint32_t)sizeof(DefaultSpriteNoTexture_Uniforms), nullptr, 0, nullptr },
-			{ "Downsample", &Downsample_Fragment, (std::uint32_t)sizeof(Downsample_Uniforms), Downsample_Fields, 1, nullptr },
-			{ "FrozenMask", &FrozenMask_Fragment, (std::uint32_t)sizeof(FrozenMask_Uniforms), nullptr, 0, nullptr },
-			{ "FrozenMask_USE_PALETTE", &FrozenMask_USE_PALETTE_Fragment, (std::uint32_t)sizeof(FrozenMask_USE_PALETTE_Uniforms), nullptr, 0, &FrozenMask_USE_PALETTE_ComputeVaryings },
-			{ "BatchedFrozenMask", &BatchedFrozenMask_Fragment, (std::uint32_t)sizeof(BatchedFrozenMask_Uniforms), nullptr, 0, nullptr },
-			{ "BatchedFrozenMask_USE_PALETTE", &BatchedFrozenMask_USE_PALETTE_Fragment, (std::uint32_t)sizeof(BatchedFrozenMask_USE_PALETTE_Uniforms), nullptr, 0, &BatchedFrozenMask_USE_PALETTE_ComputeVaryings },
-			{ "Outline", &Outline_Fragment, (std::uint32_t)sizeof(Outline_Uniforms), nullptr, 0, nullptr },
-			{ "BatchedOutline", &BatchedOutline_Fragment, (std::uint32_t)sizeof(BatchedOutline_Uniforms), nullptr, 0, nullptr },
-			{ "OutlinePalette", &OutlinePalette_Fragment, (std::uint32_t)sizeof(OutlinePalette_Uniforms), nullptr, 0, &OutlinePalette_ComputeVaryings },
-			{ "BatchedOutlinePalette", &BatchedOutlinePalette_Fragment, (std::uint32_t)sizeof(BatchedOutlinePalette_Uniforms), nullptr, 0, &BatchedOutlinePalette_ComputeVaryings },
-			{ "PaletteRemap", &PaletteRemap_Fragment, (std::uint32_t)sizeof(PaletteRemap_Uniforms), nullptr, 0, &PaletteRemap_ComputeVaryings },
-			{ "BatchedPaletteRemap", &BatchedPaletteRemap_Fragment, (std::uint32_t)sizeof(BatchedPaletteRemap_Uniforms), nullptr, 0, &BatchedPaletteRemap_ComputeVaryings },
-			{ "PartialWhiteMask", &PartialWhiteMask_Fragment, (std::uint32_t)sizeof(PartialWhiteMask_Uniforms), nullptr, 0, nullptr },
-			{ "PartialWhiteMask_USE_PALETTE", &PartialWhiteMask_USE_PALETTE_Fragment, (std::uint32_t)sizeof(PartialWhiteMask_USE_PALETTE_Uniforms), nullptr, 0, &PartialWhiteMask_USE_PALETTE_ComputeVaryings },
-			{ "BatchedPartialWhiteMask", &BatchedPartialWhiteMask_Fragment, (std::uint32_t)sizeof(BatchedPartialWhiteMask_Uniforms), nullptr, 0, nullptr },
-			{ "BatchedPartialWhiteMask_USE_PALETTE", &BatchedPartialWhiteMask_USE_PALETTE_Fragment, (std::uint32_t)sizeof(BatchedPartialWhiteMask_USE_PALETTE_Uniforms), nullptr, 0, &BatchedPartialWhiteMask_USE_PALETTE_ComputeVaryings },
-			{ "ResizeCrtApertureGrille", &ResizeCrtApertureGrille_Fragment, (std::uint32_t)sizeof(ResizeCrtApertureGrille_Uniforms), nullptr, 0, &ResizeCrtApertureGrille_ComputeVaryings },
-			{ "ResizeCrtShadowMask", &ResizeCrtShadowMask_Fragment, (std::uint32_t)sizeof(ResizeCrtShadowMask_Uniforms), nullptr, 0, &ResizeCrtShadowMask_ComputeVaryings },
-			{ "ShieldFire", &ShieldFire_Fragment, (std::uint32_t)sizeof(ShieldFire_Uniforms), nullptr, 0, &ShieldFire_ComputeVaryings },
-			{ "ShieldLightning", &ShieldLightning_Fragment, (std::uint32_t)sizeof(ShieldLightning_Uniforms), nullptr, 0, &ShieldLightning_ComputeVaryings },
-			{ "TexturedBackground", &TexturedBackground_Fragment, (std::uint32_t)sizeof(TexturedBackground_Uniforms), TexturedBackground_Fields, 4, nullptr },
-			{ "TexturedBackground_DITHER", &TexturedBackground_DITHER_Fragment, (std::uint32_t)sizeof(TexturedBackground_DITHER_Uniforms), TexturedBackground_DITHER_Fields, 4, nullptr },
-			{ "TexturedBackgroundCircle", &TexturedBackgroundCircle_Fragment, (std::uint32_t)sizeof(TexturedBackgroundCircle_Uniforms), TexturedBackgroundCircle_Fields, 4, nullptr },
-			{ "TexturedBackgroundCircle_DITHER", &TexturedBackgroundCircle_DITHER_Fragment, (std::uint32_t)sizeof(TexturedBackgroundCircle_DITHER_Uniforms), TexturedBackgroundCircle_DITHER_Fields, 4, nullptr },
-			{ "TileMapMesh", &TileMapMesh_Fragment, (std::uint32_t)sizeof(TileMapMesh_Uniforms), nullptr, 0, nullptr },
-			{ "Tinted", &Tinted_Fragment, (std::uint32_t)sizeof(Tinted_Uniforms), nullptr, 0, nullptr },
-			{ "Tinted_USE_PALETTE", &Tinted_USE_PALETTE_Fragment, (std::uint32_t)sizeof(Tinted_USE_PALETTE_Uniforms), nullptr, 0, &Tinted_USE_PALETTE_ComputeVaryings },
-			{ "BatchedTinted", &BatchedTinted_Fragment, (std::uint32_t)sizeof(BatchedTinted_Uniforms), nullptr, 0, nullptr },
-			{ "BatchedTinted_USE_PALETTE", &BatchedTinted_USE_PALETTE_Fragment, (std::uint32_t)sizeof(BatchedTinted_USE_PALETTE_Uniforms), nullptr, 0, &BatchedTinted_USE_PALETTE_ComputeVaryings },
-			{ "Transition", &Transition_Fragment, (std::uint32_t)sizeof(Transition_Uniforms), nullptr, 0, &Transition_ComputeVaryings },
-			{ "WhiteMask", &WhiteMask_Fragment, (std::uint32_t)sizeof(WhiteMask_Uniforms), nullptr, 0, nullptr },
-			{ "WhiteMask_USE_PALETTE", &WhiteMask_USE_PALETTE_Fragment, (std::uint32_t)sizeof(WhiteMask_USE_PALETTE_Uniforms), nullptr, 0, &WhiteMask_USE_PALETTE_ComputeVaryings },
-			{ "BatchedWhiteMask", &BatchedWhiteMask_Fragment, (std::uint32_t)sizeof(BatchedWhiteMask_Uniforms), nullptr, 0, nullptr },
-			{ "BatchedWhiteMask_USE_PALETTE", &BatchedWhiteMask_USE_PALETTE_Fragment, (std::uint32_t)sizeof(BatchedWhiteMask_USE_PALETTE_Uniforms), nullptr, 0, &BatchedWhiteMask_USE_PALETTE_ComputeVaryings },
+			{ "BatchedShieldFire", &BatchedShieldFire_Fragment, (std::uint32_t)sizeof(BatchedShieldFire_Uniforms), nullptr, 0, &BatchedShieldFire_ComputeVaryings, &BatchedShieldFire_Fragment4, SW_GENERATED_FRAGMENT8(BatchedShieldFire_Fragment8) },
+			{ "BatchedShieldLightning", &BatchedShieldLightning_Fragment, (std::uint32_t)sizeof(BatchedShieldLightning_Uniforms), nullptr, 0, &BatchedShieldLightning_ComputeVaryings, &BatchedShieldLightning_Fragment4, SW_GENERATED_FRAGMENT8(BatchedShieldLightning_Fragment8) },
+			{ "Blur", &Blur_Fragment, (std::uint32_t)sizeof(Blur_Uniforms), Blur_Fields, 2, nullptr, &Blur_Fragment4, SW_GENERATED_FRAGMENT8(Blur_Fragment8) },
+			{ "Colorized", &Colorized_Fragment, (std::uint32_t)sizeof(Colorized_Uniforms), nullptr, 0, nullptr, &Colorized_Fragment4, SW_GENERATED_FRAGMENT8(Colorized_Fragment8) },
+			{ "BatchedColorized", &BatchedColorized_Fragment, (std::uint32_t)sizeof(BatchedColorized_Uniforms), nullptr, 0, nullptr, &BatchedColorized_Fragment4, SW_GENERATED_FRAGMENT8(BatchedColorized_Fragment8) },
+			{ "Combine", &Combine_Fragment, (std::uint32_t)sizeof(Combine_Uniforms), Combine_Fields, 2, &Combine_ComputeVaryings, &Combine_Fragment4, SW_GENERATED_FRAGMENT8(Combine_Fragment8) },
+			{ "CombineWithWater", &CombineWithWater_Fragment, (std::uint32_t)sizeof(CombineWithWater_Uniforms), CombineWithWater_Fields, 4, &CombineWithWater_ComputeVaryings, &CombineWithWater_Fragment4, SW_GENERATED_FRAGMENT8(CombineWithWater_Fragment8) },
+			{ "CombineWithWaterLow", &CombineWithWaterLow_Fragment, (std::uint32_t)sizeof(CombineWithWaterLow_Uniforms), CombineWithWaterLow_Fields, 4, &CombineWithWaterLow_ComputeVaryings, &CombineWithWaterLow_Fragment4, SW_GENERATED_FRAGMENT8(CombineWithWaterLow_Fragment8) },
+			{ "DefaultBatchedMeshSprites", &DefaultBatchedMeshSprites_Fragment, (std::uint32_t)sizeof(DefaultBatchedMeshSprites_Uniforms), nullptr, 0, nullptr, &DefaultBatchedMeshSprites_Fragment4, SW_GENERATED_FRAGMENT8(DefaultBatchedMeshSprites_Fragment8) },
+			{ "DefaultBatchedMeshSpritesNoTexture", &DefaultBatchedMeshSpritesNoTexture_Fragment, (std::uint32_t)sizeof(DefaultBatchedMeshSpritesNoTexture_Uniforms), nullptr, 0, nullptr, &DefaultBatchedMeshSpritesNoTexture_Fragment4, SW_GENERATED_FRAGMENT8(DefaultBatchedMeshSpritesNoTexture_Fragment8) },
+			{ "DefaultBatchedSpritesNoTexture", &DefaultBatchedSpritesNoTexture_Fragment, (std::uint32_t)sizeof(DefaultBatchedSpritesNoTexture_Uniforms), nullptr, 0, nullptr, &DefaultBatchedSpritesNoTexture_Fragment4, SW_GENERATED_FRAGMENT8(DefaultBatchedSpritesNoTexture_Fragment8) },
+			{ "DefaultImGui", &DefaultImGui_Fragment, (std::uint32_t)sizeof(DefaultImGui_Uniforms), nullptr, 0, nullptr, &DefaultImGui_Fragment4, SW_GENERATED_FRAGMENT8(DefaultImGui_Fragment8) },
+			{ "DefaultMeshSprite", &DefaultMeshSprite_Fragment, (std::uint32_t)sizeof(DefaultMeshSprite_Uniforms), nullptr, 0, nullptr, &DefaultMeshSprite_Fragment4, SW_GENERATED_FRAGMENT8(DefaultMeshSprite_Fragment8) },
+			{ "DefaultMeshSpriteNoTexture", &DefaultMeshSpriteNoTexture_Fragment, (std::uint32_t)sizeof(DefaultMeshSpriteNoTexture_Uniforms), nullptr, 0, nullptr, &DefaultMeshSpriteNoTexture_Fragment4, SW_GENERATED_FRAGMENT8(DefaultMeshSpriteNoTexture_Fragment8) },
+			{ "DefaultSprite", &DefaultSprite_Fragment, (std::uint32_t)sizeof(DefaultSprite_Uniforms), nullptr, 0, nullptr, &DefaultSprite_Fragment4, SW_GENERATED_FRAGMENT8(DefaultSprite_Fragment8) },
+			{ "DefaultBatchedSprites", &DefaultBatchedSprites_Fragment, (std::uint32_t)sizeof(DefaultBatchedSprites_Uniforms), nullptr, 0, nullptr, &DefaultBatchedSprites_Fragment4, SW_GENERATED_FRAGMENT8(DefaultBatchedSprites_Fragment8) },
+			{ "DefaultSpriteNoTexture", &DefaultSpriteNoTexture_Fragment, (std::uint32_t)sizeof(DefaultSpriteNoTexture_Uniforms), nullptr, 0, nullptr, &DefaultSpriteNoTexture_Fragment4, SW_GENERATED_FRAGMENT8(DefaultSpriteNoTexture_Fragment8) },
+			{ "Downsample", &Downsample_Fragment, (std::uint32_t)sizeof(Downsample_Uniforms), Downsample_Fields, 1, nullptr, &Downsample_Fragment4, SW_GENERATED_FRAGMENT8(Downsample_Fragment8) },
+			{ "FrozenMask", &FrozenMask_Fragment, (std::uint32_t)sizeof(FrozenMask_Uniforms), nullptr, 0, nullptr, &FrozenMask_Fragment4, SW_GENERATED_FRAGMENT8(FrozenMask_Fragment8) },
+			{ "FrozenMask_USE_PALETTE", &FrozenMask_USE_PALETTE_Fragment, (std::uint32_t)sizeof(FrozenMask_USE_PALETTE_Uniforms), nullptr, 0, &FrozenMask_USE_PALETTE_ComputeVaryings, &FrozenMask_USE_PALETTE_Fragment4, SW_GENERATED_FRAGMENT8(FrozenMask_USE_PALETTE_Fragment8) },
+			{ "BatchedFrozenMask", &BatchedFrozenMask_Fragment, (std::uint32_t)sizeof(BatchedFrozenMask_Uniforms), nullptr, 0, nullptr, &BatchedFrozenMask_Fragment4, SW_GENERATED_FRAGMENT8(BatchedFrozenMask_Fragment8) },
+			{ "BatchedFrozenMask_USE_PALETTE", &BatchedFrozenMask_USE_PALETTE_Fragment, (std::uint32_t)sizeof(BatchedFrozenMask_USE_PALETTE_Uniforms), nullptr, 0, &BatchedFrozenMask_USE_PALETTE_ComputeVaryings, &BatchedFrozenMask_USE_PALETTE_Fragment4, SW_GENERATED_FRAGMENT8(BatchedFrozenMask_USE_PALETTE_Fragment8) },
+			{ "Outline", &Outline_Fragment, (std::uint32_t)sizeof(Outline_Uniforms), nullptr, 0, nullptr, &Outline_Fragment4, SW_GENERATED_FRAGMENT8(Outline_Fragment8) },
+			{ "BatchedOutline", &BatchedOutline_Fragment, (std::uint32_t)sizeof(BatchedOutline_Uniforms), nullptr, 0, nullptr, &BatchedOutline_Fragment4, SW_GENERATED_FRAGMENT8(BatchedOutline_Fragment8) },
+			{ "OutlinePalette", &OutlinePalette_Fragment, (std::uint32_t)sizeof(OutlinePalette_Uniforms), nullptr, 0, &OutlinePalette_ComputeVaryings, &OutlinePalette_Fragment4, SW_GENERATED_FRAGMENT8(OutlinePalette_Fragment8) },
+			{ "BatchedOutlinePalette", &BatchedOutlinePalette_Fragment, (std::uint32_t)sizeof(BatchedOutlinePalette_Uniforms), nullptr, 0, &BatchedOutlinePalette_ComputeVaryings, &BatchedOutlinePalette_Fragment4, SW_GENERATED_FRAGMENT8(BatchedOutlinePalette_Fragment8) },
+			{ "PaletteRemap", &PaletteRemap_Fragment, (std::uint32_t)sizeof(PaletteRemap_Uniforms), nullptr, 0, &PaletteRemap_ComputeVaryings, &PaletteRemap_Fragment4, SW_GENERATED_FRAGMENT8(PaletteRemap_Fragment8) },
+			{ "BatchedPaletteRemap", &BatchedPaletteRemap_Fragment, (std::uint32_t)sizeof(BatchedPaletteRemap_Uniforms), nullptr, 0, &BatchedPaletteRemap_ComputeVaryings, &BatchedPaletteRemap_Fragment4, SW_GENERATED_FRAGMENT8(BatchedPaletteRemap_Fragment8) },
+			{ "PartialWhiteMask", &PartialWhiteMask_Fragment, (std::uint32_t)sizeof(PartialWhiteMask_Uniforms), nullptr, 0, nullptr, &PartialWhiteMask_Fragment4, SW_GENERATED_FRAGMENT8(PartialWhiteMask_Fragment8) },
+			{ "PartialWhiteMask_USE_PALETTE", &PartialWhiteMask_USE_PALETTE_Fragment, (std::uint32_t)sizeof(PartialWhiteMask_USE_PALETTE_Uniforms), nullptr, 0, &PartialWhiteMask_USE_PALETTE_ComputeVaryings, &PartialWhiteMask_USE_PALETTE_Fragment4, SW_GENERATED_FRAGMENT8(PartialWhiteMask_USE_PALETTE_Fragment8) },
+			{ "BatchedPartialWhiteMask", &BatchedPartialWhiteMask_Fragment, (std::uint32_t)sizeof(BatchedPartialWhiteMask_Uniforms), nullptr, 0, nullptr, &BatchedPartialWhiteMask_Fragment4, SW_GENERATED_FRAGMENT8(BatchedPartialWhiteMask_Fragment8) },
+			{ "BatchedPartialWhiteMask_USE_PALETTE", &BatchedPartialWhiteMask_USE_PALETTE_Fragment, (std::uint32_t)sizeof(BatchedPartialWhiteMask_USE_PALETTE_Uniforms), nullptr, 0, &BatchedPartialWhiteMask_USE_PALETTE_ComputeVaryings, &BatchedPartialWhiteMask_USE_PALETTE_Fragment4, SW_GENERATED_FRAGMENT8(BatchedPartialWhiteMask_USE_PALETTE_Fragment8) },
+			{ "ResizeCrtApertureGrille", &ResizeCrtApertureGrille_Fragment, (std::uint32_t)sizeof(ResizeCrtApertureGrille_Uniforms), nullptr, 0, &ResizeCrtApertureGrille_ComputeVaryings, &ResizeCrtApertureGrille_Fragment4, SW_GENERATED_FRAGMENT8(ResizeCrtApertureGrille_Fragment8) },
+			{ "ResizeCrtShadowMask", &ResizeCrtShadowMask_Fragment, (std::uint32_t)sizeof(ResizeCrtShadowMask_Uniforms), nullptr, 0, &ResizeCrtShadowMask_ComputeVaryings, &ResizeCrtShadowMask_Fragment4, SW_GENERATED_FRAGMENT8(ResizeCrtShadowMask_Fragment8) },
+			{ "ShieldFire", &ShieldFire_Fragment, (std::uint32_t)sizeof(ShieldFire_Uniforms), nullptr, 0, &ShieldFire_ComputeVaryings, &ShieldFire_Fragment4, SW_GENERATED_FRAGMENT8(ShieldFire_Fragment8) },
+			{ "ShieldLightning", &ShieldLightning_Fragment, (std::uint32_t)sizeof(ShieldLightning_Uniforms), nullptr, 0, &ShieldLightning_ComputeVaryings, &ShieldLightning_Fragment4, SW_GENERATED_FRAGMENT8(ShieldLightning_Fragment8) },
+			{ "TexturedBackground", &TexturedBackground_Fragment, (std::uint32_t)sizeof(TexturedBackground_Uniforms), TexturedBackground_Fields, 4, nullptr, &TexturedBackground_Fragment4, SW_GENERATED_FRAGMENT8(TexturedBackground_Fragment8) },
+			{ "TexturedBackground_DITHER", &TexturedBackground_DITHER_Fragment, (std::uint32_t)sizeof(TexturedBackground_DITHER_Uniforms), TexturedBackground_DITHER_Fields, 4, nullptr, &TexturedBackground_DITHER_Fragment4, SW_GENERATED_FRAGMENT8(TexturedBackground_DITHER_Fragment8) },
+			{ "TexturedBackgroundCircle", &TexturedBackgroundCircle_Fragment, (std::uint32_t)sizeof(TexturedBackgroundCircle_Uniforms), TexturedBackgroundCircle_Fields, 4, nullptr, &TexturedBackgroundCircle_Fragment4, SW_GENERATED_FRAGMENT8(TexturedBackgroundCircle_Fragment8) },
+			{ "TexturedBackgroundCircle_DITHER", &TexturedBackgroundCircle_DITHER_Fragment, (std::uint32_t)sizeof(TexturedBackgroundCircle_DITHER_Uniforms), TexturedBackgroundCircle_DITHER_Fields, 4, nullptr, &TexturedBackgroundCircle_DITHER_Fragment4, SW_GENERATED_FRAGMENT8(TexturedBackgroundCircle_DITHER_Fragment8) },
+			{ "TileMapMesh", &TileMapMesh_Fragment, (std::uint32_t)sizeof(TileMapMesh_Uniforms), nullptr, 0, nullptr, &TileMapMesh_Fragment4, SW_GENERATED_FRAGMENT8(TileMapMesh_Fragment8) },
+			{ "Tinted", &Tinted_Fragment, (std::uint32_t)sizeof(Tinted_Uniforms), nullptr, 0, nullptr, &Tinted_Fragment4, SW_GENERATED_FRAGMENT8(Tinted_Fragment8) },
+			{ "Tinted_USE_PALETTE", &Tinted_USE_PALETTE_Fragment, (std::uint32_t)sizeof(Tinted_USE_PALETTE_Uniforms), nullptr, 0, &Tinted_USE_PALETTE_ComputeVaryings, &Tinted_USE_PALETTE_Fragment4, SW_GENERATED_FRAGMENT8(Tinted_USE_PALETTE_Fragment8) },
+			{ "BatchedTinted", &BatchedTinted_Fragment, (std::uint32_t)sizeof(BatchedTinted_Uniforms), nullptr, 0, nullptr, &BatchedTinted_Fragment4, SW_GENERATED_FRAGMENT8(BatchedTinted_Fragment8) },
+			{ "BatchedTinted_USE_PALETTE", &BatchedTinted_USE_PALETTE_Fragment, (std::uint32_t)sizeof(BatchedTinted_USE_PALETTE_Uniforms), nullptr, 0, &BatchedTinted_USE_PALETTE_ComputeVaryings, &BatchedTinted_USE_PALETTE_Fragment4, SW_GENERATED_FRAGMENT8(BatchedTinted_USE_PALETTE_Fragment8) },
+			{ "Transition", &Transition_Fragment, (std::uint32_t)sizeof(Transition_Uniforms), nullptr, 0, &Transition_ComputeVaryings, &Transition_Fragment4, SW_GENERATED_FRAGMENT8(Transition_Fragment8) },
+			{ "WhiteMask", &WhiteMask_Fragment, (std::uint32_t)sizeof(WhiteMask_Uniforms), nullptr, 0, nullptr, &WhiteMask_Fragment4, SW_GENERATED_FRAGMENT8(WhiteMask_Fragment8) },
+			{ "WhiteMask_USE_PALETTE", &WhiteMask_USE_PALETTE_Fragment, (std::uint32_t)sizeof(WhiteMask_USE_PALETTE_Uniforms), nullptr, 0, &WhiteMask_USE_PALETTE_ComputeVaryings, &WhiteMask_USE_PALETTE_Fragment4, SW_GENERATED_FRAGMENT8(WhiteMask_USE_PALETTE_Fragment8) },
+			{ "BatchedWhiteMask", &BatchedWhiteMask_Fragment, (std::uint32_t)sizeof(BatchedWhiteMask_Uniforms), nullptr, 0, nullptr, &BatchedWhiteMask_Fragment4, SW_GENERATED_FRAGMENT8(BatchedWhiteMask_Fragment8) },
+			{ "BatchedWhiteMask_USE_PALETTE", &BatchedWhiteMask_USE_PALETTE_Fragment, (std::uint32_t)sizeof(BatchedWhiteMask_USE_PALETTE_Uniforms), nullptr, 0, &BatchedWhiteMask_USE_PALETTE_ComputeVaryings, &BatchedWhiteMask_USE_PALETTE_Fragment4, SW_GENERATED_FRAGMENT8(BatchedWhiteMask_USE_PALETTE_Fragment8) },
 		};
 
 		const SwGeneratedShaderInfo* FindGeneratedShader(const char* name)
@@ -2685,4 +7880,6 @@ void BatchedWhiteMask_USE_PALETTE_Fragment(const nCine::RHI::Software::FragmentS
 	}
 }
 
+#undef SW_GENERATED_FRAGMENT8
+
 #endif
@@ -1,6 +1,7 @@
-#include "PakFile.h"
+﻿#include "PakFile.h"
 #include "BoundedFileStream.h"
 #include "FileSystem.h"
+#include "MemoryStream.h"
 #include "Compression/DeflateStream.h"
 #include "Compression/Lz4Stream.h"
 #include "Compression/Lzma2Stream.h"
@@ -364,7 +365,19 @@ namespace Death { namespace IO {
 #	endif
 #endif
 
-	PakFile::PakFile(StringView path)
+	/** @brief Read-only stream over a file stored in a memory-mapped `.pak` file, it keeps the mapping alive */
+	class MappedFileStream : public MemoryStream
+	{
+	public:
+		MappedFileStream(std::shared_ptr<void> mapping, const std::uint8_t* data, std::int64_t size)
+			: MemoryStream(static_cast<const void*>(data), size), _mapping(std::move(mapping)) {}
+
+	private:
+		std::shared_ptr<void> _mapping;
+	};
+
+	PakFile::PakFile(StringView path, bool useMemoryMapping)
+		: _mappedData(nullptr), _mappedSize(0)
 	{
 		std::unique_ptr<Stream> s = std::make_unique<FileStream>(path, FileAccess::Read);
 		DEATH_ASSERT(s->GetSize() > FooterSize + 8, "Invalid .pak file", );
@@ -402,6 +415,24 @@ namespace Death { namespace IO {
 		ConstructsItemsFromIndex(*s, nullptr,
 			(fileFlags & PakFileFlags::DeflateCompressedIndex) == PakFileFlags::DeflateCompressedIndex,
 			useRelativeOffsets, 0);
+
+		BuildLookupTable();
+
+#if defined(DEATH_TARGET_ANDROID) || defined(DEATH_TARGET_APPLE) || defined(DEATH_TARGET_UNIX) || (defined(DEATH_TARGET_WINDOWS) && !defined(DEATH_TARGET_WINDOWS_RT))
+		if (useMemoryMapping) {
+			s = nullptr;
+
+			// If the file cannot be mapped (e.g., it's not a regular file), it's read through file streams instead
+			auto mapped = FileSystem::OpenAsMemoryMapped(path, FileAccess::Read);
+			if (mapped && !mapped->empty()) {
+				_mappedData = reinterpret_cast<const std::uint8_t*>(mapped->data());
+				_mappedSize = mapped->size();
+				_mapping = std::make_shared<Array<char, FileSystem::MapDeleter>>(std::move(*mapped));
+			}
+		}
+#else
+		static_cast<void>(useMemoryMapping);
+#endif
 	}
 
 	StringView PakFile::GetMountPoint() const
@@ -425,10 +456,20 @@ namespace Death { namespace IO {
 		return (foundItem != nullptr && (foundItem->Flags & ItemFlags::Directory) != ItemFlags::Directory);
 	}
 
-	bool PakFile::FileExists(std::uint64_t hashedPath)
+	Array<std::uint64_t> PakFile::GetFileHashes() const
 	{
-		DEATH_ASSERT(_useHashIndex, "Hashed path can only be used with hash-indexed .pak files", false);
+		Array<std::uint64_t> hashes;
+		arrayReserve(hashes, _lookupTable.size() / 2);
+		for (const auto& entry : _lookupTable) {
+			if (entry.Target != nullptr && (entry.Target->Flags & ItemFlags::Directory) != ItemFlags::Directory) {
+				arrayAppend(hashes, entry.Hash);
+			}
+		}
+		return hashes;
+	}
 
+	bool PakFile::FileExists(std::uint64_t hashedPath)
+	{
 		Item* foundItem = FindItemByHash(hashedPath);
 		return (foundItem != nullptr && (foundItem->Flags & ItemFlags::Directory) != ItemFlags::Directory);
 	}
@@ -453,6 +494,10 @@ namespace Death { namespace IO {
 		PakPreferredCompression compression = PakPreferredCompression(std::uint32_t(foundItem->Flags & ItemFlags::CompressionFlags) >> CompressionFlagsShift);
 		switch (compression) {
 			case PakPreferredCompression::None: {
+				auto mappedFile = GetMappedItem(foundItem);
+				if (mappedFile.data() != nullptr) {
+					return std::make_unique<MappedFileStream>(_mapping, mappedFile.data(), std::int64_t(mappedFile.size()));
+				}
 				return std::make_unique<BoundedFileStream>(_path, foundItem->Offset, foundItem->UncompressedSize, bufferSize);
 			}
 			case PakPreferredCompression::Deflate: {
@@ -503,8 +548,6 @@ namespace Death { namespace IO {
 
 	std::unique_ptr<Stream> PakFile::OpenFile(std::uint64_t hashedPath, std::int32_t bufferSize)
 	{
-		DEATH_ASSERT(_useHashIndex, "Hashed path can only be used with hash-indexed .pak files", nullptr);
-
 		Item* foundItem = FindItemByHash(hashedPath);
 		if DEATH_UNLIKELY(foundItem == nullptr || (foundItem->Flags & ItemFlags::Directory) == ItemFlags::Directory) {
 			return nullptr;
@@ -513,6 +556,10 @@ namespace Death { namespace IO {
 		PakPreferredCompression compression = PakPreferredCompression(std::uint32_t(foundItem->Flags & ItemFlags::CompressionFlags) >> CompressionFlagsShift);
 		switch (compression) {
 			case PakPreferredCompression::None: {
+				auto mappedFile = GetMappedItem(foundItem);
+				if (mappedFile.data() != nullptr) {
+					return std::make_unique<MappedFileStream>(_mapping, mappedFile.data(), std::int64_t(mappedFile.size()));
+				}
 				return std::make_unique<BoundedFileStream>(_path, foundItem->Offset, foundItem->UncompressedSize, bufferSize);
 			}
 			case PakPreferredCompression::Deflate: {
@@ -561,6 +608,36 @@ namespace Death { namespace IO {
 		}
 	}
 
+	ArrayView<const std::uint8_t> PakFile::GetMappedFile(StringView path)
+	{
+		if (_mappedData == nullptr || path.empty() || path[path.size() - 1] == '/' || path[path.size() - 1] == '\\') {
+			return {};
+		}
+
+		return GetMappedItem(FindItem(path));
+	}
+
+	ArrayView<const std::uint8_t> PakFile::GetMappedFile(std::uint64_t hashedPath)
+	{
+		if (_mappedData == nullptr) {
+			return {};
+		}
+
+		return GetMappedItem(FindItemByHash(hashedPath));
+	}
+
+	ArrayView<const std::uint8_t> PakFile::GetMappedItem(Item* item)
+	{
+		if (_mappedData == nullptr || item == nullptr || (item->Flags & (ItemFlags::Directory | ItemFlags::CompressionFlags)) != ItemFlags::None) {
+			return {};
+		}
+		if DEATH_UNLIKELY(item->Offset + item->UncompressedSize > _mappedSize) {
+			return {};
+		}
+
+		return { _mappedData + item->Offset, item->UncompressedSize };
+	}
+
 	void PakFile::ConstructsItemsFromIndex(Stream& s, Item* parentItem, bool deflateCompressed, bool useRelativeOffsets, std::uint32_t depth)
 	{
 		DEATH_ASSERT(depth < MaxDepth, "Maximum directory structure depth reached", );
@@ -651,61 +728,108 @@ namespace Death { namespace IO {
 #endif
 	}
 
-	PakFile::Item* PakFile::FindItem(StringView path)
+	std::uint64_t PakFile::HashPath(StringView path)
 	{
-		path = path.trimmedPrefix("/\\");
+		return FileNameToHash(path);
+	}
 
-		if (_useHashIndex) {
-			std::uint64_t hashedPath = FileNameToHash(path);
-			return FindItemByHash(hashedPath);
+	void PakFile::BuildLookupTable()
+	{
+		// Keep the load factor at most 50%, so probe sequences stay short
+		std::size_t capacity = 16;
+		std::size_t itemCount = CountItems(_rootItems);
+		while (capacity < itemCount * 2) {
+			capacity <<= 1;
 		}
 
-		Array<Item>* items = &_rootItems;
-		while (true) {
-			auto separator = path.findAnyOr("/\\", path.end());
-			auto name = path.prefix(separator.begin());
+		_lookupTable = Array<LookupEntry>(ValueInit, capacity);
 
-			if (name.empty()) {
-				// Skip all consecutive slashes
-				path = path.suffix(separator.end());
-				continue;
+		if (_useHashIndex) {
+			// Hash-indexed containers are flat and the hashes are already stored instead of names
+			for (auto& item : _rootItems) {
+				std::uint64_t hash;
+				std::memcpy(&hash, item.Name.data(), HashIndexLength);
+#if defined(DEATH_TARGET_BIG_ENDIAN)
+				// The hash bytes are stored in little-endian order by PakWriter
+				hash = Memory::SwapBytes(hash);
+#endif
+				AddToLookupTable(hash, &item);
 			}
+		} else {
+			SmallVector<char, 512> path;
+			AddItemsToLookupTable(_rootItems, path);
+		}
+	}
 
-			// Items are always sorted by PakWriter
-			Item* foundItem = std::lower_bound(items->begin(), items->end(), name, [](const PakFile::Item& a, StringView b) {
-				return a.Name < b;
-			});
+	std::size_t PakFile::CountItems(const Array<Item>& items)
+	{
+		std::size_t count = items.size();
+		for (const auto& item : items) {
+			count += CountItems(item.ChildItems);
+		}
+		return count;
+	}
 
-			if DEATH_UNLIKELY(foundItem == items->end() || foundItem->Name != name) {
-				return nullptr;
+	void PakFile::AddItemsToLookupTable(Array<Item>& items, SmallVectorImpl<char>& path)
+	{
+		std::size_t parentLength = path.size();
+		for (auto& item : items) {
+			if (parentLength > 0) {
+				path.push_back('/');
 			}
+			path.append(item.Name.begin(), item.Name.end());
 
-			if (separator == path.end()) {
-				// If there is no separator left
-				return foundItem;
+			AddToLookupTable(FileNameToHash({ path.data(), path.size() }), &item);
+			if ((item.Flags & ItemFlags::Directory) == ItemFlags::Directory) {
+				AddItemsToLookupTable(item.ChildItems, path);
 			}
 
-			path = path.suffix(separator.end());
-			items = &foundItem->ChildItems;
+			path.resize(parentLength);
 		}
 	}
 
-	PakFile::Item* PakFile::FindItemByHash(std::uint64_t hashedPath)
+	void PakFile::AddToLookupTable(std::uint64_t hash, Item* item)
 	{
-#if defined(DEATH_TARGET_BIG_ENDIAN)
-		// The hash bytes are stored in little-endian order by PakWriter
-		hashedPath = Memory::SwapBytes(hashedPath);
-#endif
-		// Items are always sorted by PakWriter
-		Item* foundItem = std::lower_bound(_rootItems.begin(), _rootItems.end(), hashedPath, [](const PakFile::Item& a, std::uint64_t b) {
-			return std::memcmp(a.Name.data(), &b, HashIndexLength) < 0;
-		});
+		std::size_t mask = _lookupTable.size() - 1;
+		std::size_t i = std::size_t(hash) & mask;
+		while (_lookupTable[i].Target != nullptr) {
+			if DEATH_UNLIKELY(_lookupTable[i].Hash == hash) {
+				// Paths that differ only in case are indistinguishable by hash, the first one is kept
+				return;
+			}
+			i = (i + 1) & mask;
+		}
 
-		if DEATH_UNLIKELY(foundItem == _rootItems.end() || std::memcmp(foundItem->Name.data(), &hashedPath, HashIndexLength) != 0) {
+		_lookupTable[i].Hash = hash;
+		_lookupTable[i].Target = item;
+	}
+
+	PakFile::Item* PakFile::FindItem(StringView path)
+	{
+		path = path.trimmed("/\\");
+		if (path.empty()) {
+			return nullptr;
+		}
+
+		return FindItemByHash(FileNameToHash(path));
+	}
+
+	PakFile::Item* PakFile::FindItemByHash(std::uint64_t hashedPath)
+	{
+		if DEATH_UNLIKELY(_lookupTable.empty()) {
 			return nullptr;
 		}
 
-		return foundItem;
+		std::size_t mask = _lookupTable.size() - 1;
+		std::size_t i = std::size_t(hashedPath) & mask;
+		while (_lookupTable[i].Target != nullptr) {
+			if (_lookupTable[i].Hash == hashedPath) {
+				return _lookupTable[i].Target;
+			}
+			i = (i + 1) & mask;
+		}
+
+		return nullptr;
 	}
 
 	bool PakFile::HasCompressedSize(ItemFlags itemFlags)
@@ -937,20 +1061,10 @@ namespace Death { namespace IO {
 		DEATH_ASSERT(!path.empty() && path[path.size() - 1] != '/' && path[path.size() - 1] != '\\',
 			("\"{}\" is not valid file path", String::nullTerminatedView(path).data()), false);
 
-		Array<PakFile::Item>* items = &_rootItems;
-		if (!_useHashIndex) {
-			PakFile::Item* parentItem = FindOrCreateParentItem(path);
-			if (parentItem != nullptr) {
-				items = &parentItem->ChildItems;
-			}
-		}
-
-		for (PakFile::Item& item : *items) {
-			if (item.Name == path) {
-				// File already exists in the .pak file
-				LOGW("File \"{}\" already exists in the .pak file", path);
-				return false;
-			}
+		StringView name = path;
+		Array<PakFile::Item>* items = FindItemsForNewFile(name);
+		if (items == nullptr) {
+			return false;
 		}
 
 		PakFile::ItemFlags flags = PakFile::ItemFlags::None;
@@ -1001,11 +1115,115 @@ namespace Death { namespace IO {
 			}
 		}
 
-		DEATH_ASSERT(uncompressedSize > 0, "Failed to copy stream to .pak file", false);
 		// NOTE: Files inside .pak are limited to 4 GB only for now
 		DEATH_ASSERT(uncompressedSize < UINT32_MAX && size < UINT32_MAX, "File size in .pak file exceeded the allowed range", false);
 
-		PakFile::Item* newItem = &arrayAppend(*items, PakFile::Item());
+		AddItem(*items, name, flags, offset, uncompressedSize, size);
+		return true;
+	}
+
+	bool PakWriter::AddFile(PreparedFile&& file, StringView path)
+	{
+		DEATH_ASSERT(_outputStream->IsValid(), "Invalid output stream specified", false);
+		DEATH_ASSERT(!path.empty() && path[path.size() - 1] != '/' && path[path.size() - 1] != '\\',
+			("\"{}\" is not valid file path", String::nullTerminatedView(path).data()), false);
+		DEATH_ASSERT(file.IsValid(), "Failed to prepare file for .pak file", false);
+		// NOTE: Files inside .pak are limited to 4 GB only for now
+		DEATH_ASSERT(file._uncompressedSize < UINT32_MAX && file._size < UINT32_MAX, "File size in .pak file exceeded the allowed range", false);
+
+		StringView name = path;
+		Array<PakFile::Item>* items = FindItemsForNewFile(name);
+		if (items == nullptr) {
+			return false;
+		}
+
+		PakFile::ItemFlags flags = PakFile::ItemFlags::None;
+		if (file._compression != PakPreferredCompression::None) {
+			flags |= PakFile::ItemFlags(std::uint32_t(file._compression) << PakFile::CompressionFlagsShift);
+		}
+
+		std::int64_t offset = _outputStream->GetPosition();
+		file._data->Seek(0, SeekOrigin::Begin);
+		file._data->CopyTo(*_outputStream);
+
+		AddItem(*items, name, flags, offset, file._uncompressedSize, file._size);
+		file._data = nullptr;
+		return true;
+	}
+
+	PakWriter::PreparedFile PakWriter::PrepareFile(Stream& stream, PakPreferredCompression preferredCompression)
+	{
+		PreparedFile file;
+		auto output = std::make_unique<MemoryStream>(std::max(stream.GetSize(), std::int64_t(64)));
+
+		switch (preferredCompression) {
+#if defined(WITH_ZLIB) || defined(WITH_MINIZ)
+			case PakPreferredCompression::Deflate: {
+				CopyToDeflate(stream, *output, file._uncompressedSize);
+				file._size = output->GetSize();
+				file._compression = PakPreferredCompression::Deflate;
+				break;
+			}
+#endif
+#if defined(WITH_LZ4)
+			case PakPreferredCompression::Lz4: {
+				CopyToLz4(stream, *output, file._uncompressedSize);
+				file._size = output->GetSize();
+				file._compression = PakPreferredCompression::Lz4;
+				break;
+			}
+#endif
+#if defined(WITH_ZSTD)
+			case PakPreferredCompression::Zstd: {
+				CopyToZstd(stream, *output, file._uncompressedSize);
+				file._size = output->GetSize();
+				file._compression = PakPreferredCompression::Zstd;
+				break;
+			}
+#endif
+#if defined(WITH_LZMA2)
+			case PakPreferredCompression::Lzma2Compressed: {
+				CopyToLzma2(stream, *output, file._uncompressedSize);
+				file._size = output->GetSize();
+				file._compression = PakPreferredCompression::Lzma2Compressed;
+				break;
+			}
+#endif
+			default: {
+				file._uncompressedSize = stream.CopyTo(*output);
+				file._size = 0;
+				break;
+			}
+		}
+
+		file._data = std::move(output);
+		return file;
+	}
+
+	Array<PakFile::Item>* PakWriter::FindItemsForNewFile(StringView& path)
+	{
+		Array<PakFile::Item>* items = &_rootItems;
+		if (!_useHashIndex) {
+			PakFile::Item* parentItem = FindOrCreateParentItem(path);
+			if (parentItem != nullptr) {
+				items = &parentItem->ChildItems;
+			}
+		}
+
+		for (PakFile::Item& item : *items) {
+			if (item.Name == path) {
+				// File already exists in the .pak file
+				LOGW("File \"{}\" already exists in the .pak file", path);
+				return nullptr;
+			}
+		}
+
+		return items;
+	}
+
+	void PakWriter::AddItem(Array<PakFile::Item>& items, StringView path, PakFile::ItemFlags flags, std::int64_t offset, std::int64_t uncompressedSize, std::int64_t size)
+	{
+		PakFile::Item* newItem = &arrayAppend(items, PakFile::Item());
 		if (_useHashIndex) {
 			newItem->Name = String{NoInit, HashIndexLength};
 			std::uint64_t hash = FileNameToHash(path);
@@ -1021,8 +1239,6 @@ namespace Death { namespace IO {
 		newItem->Offset = offset;
 		newItem->UncompressedSize = std::uint32_t(uncompressedSize);
 		newItem->Size = std::uint32_t(size);
-
-		return true;
 	}
 
 	bool PakWriter::FileExists(StringView path) const
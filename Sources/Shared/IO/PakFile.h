@@ -6,6 +6,8 @@
 
 #include "../Common.h"
 #include "../Containers/Array.h"
+#include "../Containers/ArrayView.h"
+#include "../Containers/SmallVector.h"
 #include "../Containers/String.h"
 #include "FileStream.h"
 #include "FileSystem.h"
@@ -27,13 +29,24 @@ namespace Death { namespace IO {
 
 	/**
 		@brief Provides read-only access to contents of `.pak` file
+
+		All paths in the container are indexed in a flat open-addressed table keyed by @ref HashPath() when
+		the container is opened, so looking up a file or directory is a single probe regardless of the depth
+		of the directory tree. Hashed paths are case-insensitive, see @ref HashPath().
 	*/
 	class PakFile
 	{
 		friend class PakWriter;
 
 	public:
-		explicit PakFile(Containers::StringView path);
+		/**
+			@brief Opens the specified `.pak` file
+
+			If @p useMemoryMapping is `true`, the whole file is mapped to memory if the platform supports it, so
+			stored (uncompressed) files can be read directly from the mapped pages, see @ref GetMappedFile().
+			If it cannot be mapped, the container silently falls back to reading through file streams.
+		*/
+		explicit PakFile(Containers::StringView path, bool useMemoryMapping = false);
 
 		PakFile(const PakFile&) = delete;
 		PakFile& operator=(const PakFile&) = delete;
@@ -49,6 +62,19 @@ namespace Death { namespace IO {
 		
 		bool IsValid() const;
 
+		/** @brief Returns `true` if the container is memory-mapped */
+		bool IsMemoryMapped() const {
+			return (_mappedData != nullptr);
+		}
+
+		/**
+			@brief Returns hashes of all files in the container
+
+			Hashes are computed by @ref HashPath() from paths relative to the mount point, so they can be used
+			to build an index spanning multiple containers and then passed to the hashed-path overloads.
+		*/
+		Containers::Array<std::uint64_t> GetFileHashes() const;
+
 		/** @brief Returns `true` if the specified path is a file */
 		bool FileExists(Containers::StringView path);
 		/** @overload */
@@ -61,6 +87,25 @@ namespace Death { namespace IO {
 		/** @overload */
 		std::unique_ptr<Stream> OpenFile(std::uint64_t hashedPath, std::int32_t bufferSize = FileStream::DefaultBufferSize);
 
+		/**
+			@brief Returns contents of a stored file directly from the memory-mapped container
+
+			Returns an empty view if the container is not memory-mapped, the file doesn't exist, or it's compressed,
+			so it has to be opened with @ref OpenFile() instead. The view is valid only as long as the container
+			exists, unlike streams returned by @ref OpenFile() which keep the mapping alive on their own.
+		*/
+		Containers::ArrayView<const std::uint8_t> GetMappedFile(Containers::StringView path);
+		/** @overload */
+		Containers::ArrayView<const std::uint8_t> GetMappedFile(std::uint64_t hashedPath);
+
+		/**
+			@brief Returns hash of the specified path, which can be used in place of the path itself
+
+			Slashes are normalized, consecutive ones are skipped and ASCII letters are lowercased before hashing,
+			so differently written paths to the same file end up with the same hash.
+		*/
+		static std::uint64_t HashPath(Containers::StringView path);
+
 		/** @brief Handles directory traversal, should be used as iterator */
 		class Directory
 		{
@@ -144,6 +189,11 @@ namespace Death { namespace IO {
 
 			Containers::Array<Item> ChildItems;
 		};
+
+		struct LookupEntry {
+			std::uint64_t Hash;
+			Item* Target;
+		};
 #endif
 
 		static constexpr std::uint32_t CompressionFlagsShift = 8;
@@ -151,13 +201,22 @@ namespace Death { namespace IO {
 		Containers::String _path;
 		Containers::String _mountPoint;
 		Containers::Array<Item> _rootItems;
+		Containers::Array<LookupEntry> _lookupTable;
+		std::shared_ptr<void> _mapping;
+		const std::uint8_t* _mappedData;
+		std::uint64_t _mappedSize;
 		bool _useHashIndex;
 
 		void ConstructsItemsFromIndex(Stream& s, Item* parentItem, bool deflateCompressed, bool useRelativeOffsets, std::uint32_t depth);
 		Containers::Array<Item>* ReadIndexFromStream(Stream& s, Item* parentItem, bool useRelativeOffsets, std::int64_t indexStartPosition);
 		DEATH_NEVER_INLINE Containers::Array<Item>* ReadIndexFromStreamDeflateCompressed(Stream& s, Item* parentItem, bool useRelativeOffsets, std::int64_t indexStartPosition);
+		void BuildLookupTable();
+		std::size_t CountItems(const Containers::Array<Item>& items);
+		void AddItemsToLookupTable(Containers::Array<Item>& items, Containers::SmallVectorImpl<char>& path);
+		void AddToLookupTable(std::uint64_t hash, Item* item);
 		Item* FindItem(Containers::StringView path);
 		Item* FindItemByHash(std::uint64_t hashedPath);
+		Containers::ArrayView<const std::uint8_t> GetMappedItem(Item* item);
 
 		static DEATH_ALWAYS_INLINE bool HasCompressedSize(ItemFlags itemFlags);
 	};
@@ -168,6 +227,30 @@ namespace Death { namespace IO {
 	class PakWriter
 	{
 	public:
+		/**
+			@brief File already compressed by @ref PrepareFile(), waiting to be added to a container
+
+			Move-only, it owns the compressed data until it's passed to @ref AddFile(PreparedFile&&, Containers::StringView).
+		*/
+		class PreparedFile
+		{
+			friend class PakWriter;
+
+		public:
+			PreparedFile() : _uncompressedSize(0), _size(0), _compression(PakPreferredCompression::None) {}
+
+			/** @brief Returns `true` if the file was prepared successfully, empty files are valid too */
+			bool IsValid() const {
+				return (_data != nullptr && _uncompressedSize >= 0);
+			}
+
+		private:
+			std::unique_ptr<Stream> _data;
+			std::int64_t _uncompressedSize;
+			std::int64_t _size;
+			PakPreferredCompression _compression;
+		};
+
 		explicit PakWriter(Containers::StringView path, bool useHashIndex = false, bool useCompressedIndex = false, bool useRelativeOffsets = false, bool append = false);
 		~PakWriter();
 
@@ -182,6 +265,21 @@ namespace Death { namespace IO {
 
 		/** @brief Adds a file to the `.pak` container */
 		bool AddFile(Stream& stream, Containers::StringView path, PakPreferredCompression preferredCompression = PakPreferredCompression::None);
+		/**
+			@brief Adds a file compressed by @ref PrepareFile() to the `.pak` container
+
+			Only copies the already compressed data, so the container ends up the same as with
+			@ref AddFile(Stream&, Containers::StringView, PakPreferredCompression) as long as the files are
+			added in the same order.
+		*/
+		bool AddFile(PreparedFile&& file, Containers::StringView path);
+		/**
+			@brief Compresses a file in memory, so it can be added later
+
+			Doesn't touch any writer, so it can be called from any thread --- several files can be compressed
+			in parallel and then added one by one in a fixed order, which keeps the output deterministic.
+		*/
+		static PreparedFile PrepareFile(Stream& stream, PakPreferredCompression preferredCompression = PakPreferredCompression::None);
 		/**
 			@brief Returns `true` if the container already contains a file at the specified path
 
@@ -208,6 +306,9 @@ namespace Death { namespace IO {
 		bool _useRelativeOffsets;
 
 		PakFile::Item* FindOrCreateParentItem(Containers::StringView& path);
+		// Returns list of items the file should be added to, or `nullptr` if it already exists
+		Containers::Array<PakFile::Item>* FindItemsForNewFile(Containers::StringView& path);
+		void AddItem(Containers::Array<PakFile::Item>& items, Containers::StringView path, PakFile::ItemFlags flags, std::int64_t offset, std::int64_t uncompressedSize, std::int64_t size);
 		void WriteItemDescription(Stream& s, PakFile::Item& item, std::int64_t indexStartPosition);
 	};
 
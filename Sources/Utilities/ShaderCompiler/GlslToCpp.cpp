@@ -141,28 +141,67 @@ namespace ShaderCompiler
 				name == "textureProj" || name == "textureGrad" || name == "textureOffset");
 		}
 
+		// Single component of a wide runtime vector: they have no union aliases (a union cannot hold members
+		// with constructors), so the colour and texture-coordinate names map to the .x/.y/.z/.w fields
+		StringView WideComponent(char c)
+		{
+			switch (c) {
+				case 'x': case 'r': case 's': return "x"_s;
+				case 'y': case 'g': case 't': return "y"_s;
+				case 'z': case 'b': case 'p': return "z"_s;
+				default: return "w"_s;
+			}
+		}
+
+		// The runtime spells every multi-component swizzle method with xyzw, `.rgb` and `.stp` map to `.xyz()`
+		String NormalizeSwizzle(StringView s)
+		{
+			String r{NoInit, s.size()};
+			for (std::size_t i = 0; i < s.size(); i++) {
+				r[i] = WideComponent(s[i])[0];
+			}
+			return r;
+		}
+
 		// The software runtime (SwShaderRuntime.h) exposes multi-component read swizzles as a fixed set of
-		// const methods; a swizzle outside it (e.g. .yy, .xz, .www, .xxzz) would call a method that does not
-		// exist and fail to compile. Single components are always real fields. Returns false for a
-		// multi-component swizzle the runtime does not provide, so the caller declines the shader (matching the
-		// transpiler's "decline cleanly rather than mistranslate" contract) instead of emitting broken C++.
-		// This list must mirror the swizzle methods in SwShaderRuntime.h.
+		// const methods; a swizzle outside it would call a method that does not exist and fail to compile.
+		// Single components are always real fields. Returns false for a multi-component swizzle the runtime
+		// does not provide, so the caller declines the shader (matching the transpiler's "decline cleanly
+		// rather than mistranslate" contract) instead of emitting broken C++. This list must mirror the
+		// swizzle methods in SwShaderRuntime.h and SwShaderRuntimeWide.h.
 		bool IsRuntimeSwizzle(StringView s)
 		{
 			if (s.size() <= 1) {
 				return true;
 			}
 			static const char* const kProvided[] = {
-				"xy", "rg", "xx", "zw", "ba", "xyz", "rgb", "yzw", "gba", "xyzw", "rgba"
+				"xy", "yx", "xx", "yy", "xz", "yz", "yw", "zw", "xyz", "yzw", "www", "xyzw", "xyxy", "xxzz"
 			};
+			String normalized = NormalizeSwizzle(s);
 			for (const char* p : kProvided) {
-				if (s == p) {
+				if (normalized == p) {
 					return true;
 				}
 			}
 			return false;
 		}
 
+		// C++ spelling of the wide counterpart of a float/bool subset type (`sw::wide4`/`sw::wide8` in
+		// SwShaderRuntime.h); the integer and boolean-vector types have none
+		bool TryWideTypeName(Ty t, std::int32_t lanes, bool qualified, String& out)
+		{
+			String ns = (qualified ? String("nCine::RHI::Software::sw::wide"_s + Death::format("{}", lanes) + "::"_s) : String{});
+			switch (t) {
+				case Ty::Void: out = "void"_s; return true;
+				case Ty::Float: out = ns + "vfloat"_s; return true;
+				case Ty::Bool: out = ns + "vmask"_s; return true;
+				case Ty::Vec2: out = ns + "vvec2"_s; return true;
+				case Ty::Vec3: out = ns + "vvec3"_s; return true;
+				case Ty::Vec4: out = ns + "vvec4"_s; return true;
+				default: return false;
+			}
+		}
+
 		// --- Abstract syntax tree --------------------------------------------------------------------
 		// The expression AST (Expr / ExprKind / ExprPtr / MakeExpr) is shared with the HLSL emitter and
 		// lives in GlslAst.h; only the statement/declaration model is software-transpiler-local. The
@@ -993,7 +1032,7 @@ namespace ShaderCompiler
 				}
 				if (!IsRuntimeSwizzle(field)) { ok = false; reason = "constant-varying swizzle '."_s + field + "' not provided by the software runtime"_s; return base; }
 				if (field.size() == 1) return base + "."_s + field;
-				if (field.size() >= 2 && field.size() <= 4) return base + "."_s + field + "()"_s;
+				if (field.size() >= 2 && field.size() <= 4) return base + "."_s + NormalizeSwizzle(field) + "()"_s;
 				ok = false; reason = "unsupported swizzle length in constant varying"_s;
 				return base;
 			}
@@ -1013,6 +1052,10 @@ namespace ShaderCompiler
 
 			/** @brief `true` once a fragment read of a constant varying required a `<Program>_ComputeVaryings` */
 			bool HasComputeVaryings() const { return !_usedVaryings.empty(); }
+			/** @brief `true` when the wide `<Program>_Fragment4` and `<Program>_Fragment8` were emitted along with the scalar kernel */
+			bool HasFragment4() const { return _wideOk; }
+			/** @brief Why the wide kernels were declined */
+			const String& Fragment4Reason() const { return _wideReason; }
 			/** @brief Names of the constant-varying fields added to the struct (excluded from the loose-uniform list) */
 			SmallVector<String, 0> ConstVaryingNames() const
 			{
@@ -1049,6 +1092,29 @@ namespace ShaderCompiler
 				}
 				String mainOut = EmitMain(*main);
 
+				// The wide kernels are emitted only on top of a supported scalar kernel, failing them just
+				// drops them (see Fail) and the scalar kernel is used for every pixel. Both widths are the same
+				// code over different lane types, the 8-wide one is compiled only where the runtime defines
+				// SW_WIDE8 (AVX2 through a per-function target attribute)
+				String wideOut;
+				if (_ok) {
+					_wide = true;
+					for (std::int32_t lanes : { 4, 8 }) {
+						_lanes = lanes;
+						String kernels;
+						for (const Function& fn : _functions) {
+							if (fn.Name == "main") continue;
+							kernels += EmitWideHelper(fn);
+							kernels += "\n"_s;
+						}
+						kernels += EmitWideMain(*main);
+						wideOut += (lanes == 8 ? String("\n#if defined(SW_WIDE8)\n"_s + kernels + "#endif\n"_s) : kernels);
+					}
+					_wide = false;
+				} else {
+					_wideOk = false;
+				}
+
 				String out;
 
 				// <Program>_Uniforms — one field per non-sampler fragment uniform, then one per constant varying
@@ -1088,6 +1154,11 @@ namespace ShaderCompiler
 
 				// The fragment entry point
 				out += mainOut;
+
+				// The wide entry points and their helpers
+				if (_wideOk) {
+					out += "\n"_s + wideOut;
+				}
 				return out;
 			}
 
@@ -1102,7 +1173,39 @@ namespace ShaderCompiler
 			bool _ok = true;
 			String _reason;
 
-			void Fail(String why) { if (_ok) { _ok = false; _reason = std::move(why); } }
+			// One local, parameter or COLOR in the uniformity analysis of the 4-wide kernels
+			struct WideSym
+			{
+				Ty Type = Ty::Void;
+				std::int32_t Depth = 0;		// Number of enclosing per-pixel branches at the declaration
+				bool Varying = false;		// Can differ between the pixels of a run
+			};
+
+			bool _wide = false;										// Emitting the wide kernels
+			std::int32_t _lanes = 4;								// Emission: lanes of the wide kernel (4 or 8)
+			bool _wideOk = true;
+			String _wideReason;
+			std::map<const void*, WideSym> _wideSyms;				// Keyed by the declaring Stmt/declarator/Param/Function
+			std::map<const Expr*, WideSym*> _wideRefs;				// Identifier -> the symbol it resolves to
+			std::map<const Expr*, bool> _wideVarying;				// Expression -> can differ between the pixels
+			SmallVector<std::map<String, WideSym*>, 0> _wideScopes;
+			std::int32_t _wideDepth = 0;							// Analysis: enclosing per-pixel branches
+			bool _wideChanged = false;
+			bool _wideMaskedReturn = false;
+			bool _wideLive = false;									// Emission: the function tracks returned lanes in `_live`
+			bool _wideIsMain = false;
+			Ty _wideRetType = Ty::Void;
+			SmallVector<String, 0> _wideMasks;						// Emission: lane mask of each enclosing per-pixel branch
+			std::int32_t _wideCounter = 0;
+
+			void Fail(String why)
+			{
+				if (_wide) {
+					if (_wideOk) { _wideOk = false; _wideReason = std::move(why); }
+					return;
+				}
+				if (_ok) { _ok = false; _reason = std::move(why); }
+			}
 
 			bool IsUserFunc(StringView name) const
 			{
@@ -1187,7 +1290,11 @@ namespace ShaderCompiler
 						}
 						break;
 					case StmtKind::ExprStmt:
-						out += indent + EmitExpr(s->E.get(), 0) + ";\n"_s;
+						if (IsSwizzleWrite(s->E.get())) {
+							EmitSwizzleWrite(s->E.get(), indent, out);
+						} else {
+							out += indent + EmitExpr(s->E.get(), 0) + ";\n"_s;
+						}
 						break;
 					case StmtKind::Return:
 						out += indent + "return"_s;
@@ -1216,6 +1323,55 @@ namespace ShaderCompiler
 				}
 			}
 
+			bool IsSwizzleWrite(const Expr* e) const
+			{
+				return (e != nullptr && e->Kind == ExprKind::Assign && e->A->Kind == ExprKind::Member && e->A->Text.size() > 1);
+			}
+
+			// `v.xy op= value` as a statement: the value is held in a temporary and written one component at a
+			// time. Inside a per-pixel branch of a wide kernel each write keeps the other lanes, like EmitWideAssign().
+			void EmitSwizzleWrite(const Expr* e, const String& indent, String& out)
+			{
+				const Expr* target = e->A.get();
+				StringView field = target->Text;
+				if (target->A->Kind != ExprKind::Ident) {
+					Fail("write swizzle '."_s + field + "' on a computed value"_s);
+					return;
+				}
+				if (field.size() > 4) {
+					Fail("swizzle '."_s + field + "' has an unsupported length"_s);
+					return;
+				}
+				for (std::size_t i = 0; i < field.size(); i++) {
+					if (!"xyzwrgbastpq"_s.contains(field[i])) {
+						Fail("member '."_s + field + "' is not a supported swizzle"_s);
+						return;
+					}
+				}
+
+				const Ty valueType = (field.size() == 2 ? Ty::Vec2 : (field.size() == 3 ? Ty::Vec3 : Ty::Vec4));
+				const bool wideBase = (_wide && IsWideVarying(target->A.get()));
+				const bool masked = (_wide && WideAssignNeedsMask(e));
+				const String typeName = (wideBase ? WideTypeName(valueType, false) : CppTypeName(valueType, false));
+				const String base = EmitExpr(target->A.get(), 100);
+				const StringView op = e->Text.prefix(e->Text.size() - 1);
+
+				String inner = indent + "\t"_s;
+				out += indent + "{\n"_s;
+				out += inner + "const "_s + typeName + " _w = "_s + typeName + "("_s + EmitExpr(e->B.get(), 0) + ");\n"_s;
+				for (std::size_t i = 0; i < field.size(); i++) {
+					String component = base + "."_s + (wideBase ? WideComponent(field[i]) : field.slice(i, i + 1));
+					String value = "_w."_s + "xyzw"_s.slice(i, i + 1);
+					if (masked) {
+						if (!op.empty()) value = component + " "_s + op + " "_s + value;
+						out += inner + component + " = select("_s + _wideMasks.back() + ", "_s + value + ", "_s + component + ");\n"_s;
+					} else {
+						out += inner + component + " "_s + e->Text + " "_s + value + ";\n"_s;
+					}
+				}
+				out += indent + "}\n"_s;
+			}
+
 			String EmitForInit(const Stmt* s)
 			{
 				if (s == nullptr) return {};
@@ -1267,19 +1423,40 @@ namespace ShaderCompiler
 					case ExprKind::Index: Fail("array indexing is unsupported in the fragment path"_s); return {};
 					case ExprKind::Call: return EmitCall(e);
 					case ExprKind::Unary: {
+						if (_wide && (e->Text == "++" || e->Text == "--") && IsWideVarying(e->A.get())) {
+							Fail("'"_s + e->Text + "' on a value that varies per pixel"_s);
+							return {};
+						}
 						String inner = EmitExpr(e->A.get(), 90);
 						if (e->Postfix) return inner + e->Text;					// x++ / x--
 						if (e->Text == "-" && !inner.empty() && inner[0] == '-') return "- "_s + inner;	// avoid a spurious "--"
 						return e->Text + inner;
 					}
 					case ExprKind::Binary: {
+						if (_wide && (e->Text == "&&" || e->Text == "||" || e->Text == "^^") && IsWideVarying(e)) {
+							// Per-lane logical operators, both sides are evaluated (the subset has no side effects)
+							StringView op = (e->Text == "&&" ? "&"_s : (e->Text == "||" ? "|"_s : "!="_s));
+							return "(vmask("_s + EmitExpr(e->A.get(), 0) + ") "_s + op + " vmask("_s + EmitExpr(e->B.get(), 0) + "))"_s;
+						}
 						std::int32_t p = BinPrec(e->Text);
 						String op = (e->Text == "^^" ? String{"!="_s} : e->Text);		// GLSL logical xor -> C++ !=
 						return EmitExpr(e->A.get(), p) + " "_s + op + " "_s + EmitExpr(e->B.get(), p + 1);
 					}
 					case ExprKind::Assign:
+						if (IsSwizzleWrite(e)) {
+							// Statements are decomposed by EmitSwizzleWrite(), the runtime has no lvalue swizzles
+							Fail("write swizzle '."_s + e->A->Text + "' inside an expression"_s);
+							return {};
+						}
+						if (_wide && WideAssignNeedsMask(e)) {
+							Fail("nested assignment inside a per-pixel branch"_s);
+							return {};
+						}
 						return EmitExpr(e->A.get(), 1) + " "_s + e->Text + " "_s + EmitExpr(e->B.get(), 1);
 					case ExprKind::Conditional:
+						if (_wide && IsWideVarying(e->A.get())) {
+							return "select(vmask("_s + EmitExpr(e->A.get(), 0) + "), "_s + EmitExpr(e->B.get(), 0) + ", "_s + EmitExpr(e->C.get(), 0) + ")"_s;
+						}
 						return EmitExpr(e->A.get(), 3) + " ? "_s + EmitExpr(e->B.get(), 3) + " : "_s + EmitExpr(e->C.get(), 2);
 				}
 				return {};
@@ -1294,7 +1471,7 @@ namespace ShaderCompiler
 			String EmitIdent(StringView name)
 			{
 				if (name == "COLOR") return "COLOR"_s;
-				if (name == "vTexCoords") return "vec2(in.u, in.v)"_s;
+				if (name == "vTexCoords") return (_wide ? "swTexCoords(in)"_s : "vec2(in.u, in.v)"_s);
 				if (name == "vColor") return "vec4(in.color[0], in.color[1], in.color[2], in.color[3])"_s;
 
 				auto it = _globals.find(String{name});
@@ -1343,8 +1520,13 @@ namespace ShaderCompiler
 					Fail("swizzle '."_s + field + "' is not provided by the software runtime"_s);
 					return base;
 				}
-				if (field.size() == 1) return base + "."_s + field;
-				if (field.size() >= 2 && field.size() <= 4) return base + "."_s + field + "()"_s;
+				if (field.size() == 1) {
+					if (_wide && IsWideVarying(e->A.get())) {
+						return base + "."_s + WideComponent(field[0]);
+					}
+					return base + "."_s + field;
+				}
+				if (field.size() >= 2 && field.size() <= 4) return base + "."_s + NormalizeSwizzle(field) + "()"_s;
 				Fail("swizzle '."_s + field + "' has an unsupported length"_s);
 				return base;
 			}
@@ -1367,6 +1549,9 @@ namespace ShaderCompiler
 				if (TryType(name, ct)) {
 					if (ct == Ty::Unsupported) { Fail("'"_s + name + "(...)' constructor (matrix) is unsupported"_s); return {}; }
 					if (ct == Ty::Sampler) { Fail("sampler constructors are unsupported"_s); return {}; }
+					if (_wide && IsWideVarying(e)) {
+						return WideTypeName(ct, false) + "("_s + EmitArgs(e) + ")"_s;
+					}
 					return CppTypeName(ct, false) + "("_s + EmitArgs(e) + ")"_s;
 				}
 
@@ -1401,12 +1586,427 @@ namespace ShaderCompiler
 				if (IsUserFunc(name)) {
 					// Helpers take the fragment input as their first argument (see EmitHelper)
 					String args = EmitArgs(e);
+					if (_wide) {
+						return _prog + "_"_s + name + Death::format("{}", _lanes) + "(in"_s + (args.empty() ? String{} : String(", "_s + args)) + ")"_s;
+					}
 					return _prog + "_"_s + name + "(in"_s + (args.empty() ? String{} : String(", "_s + args)) + ")"_s;
 				}
 
 				Fail("unknown function '"_s + name + "'"_s);
 				return {};
 			}
+
+			// --- Wide kernels --------------------------------------------------------------------------
+			//
+			// `<Program>_Fragment4` and `<Program>_Fragment8` shade four or eight adjacent pixels, one per lane.
+			// A uniformity analysis over each function decides which locals can differ between the pixels (they
+			// become vfloat/vvecN, the rest stays scalar and is computed once per run); it is iterated to a fixed point so values carried
+			// around a loop are covered. A per-pixel `if` becomes a lane mask, an assignment inside it to a
+			// variable declared outside of it keeps the previous value in the other lanes via select(), and a
+			// per-pixel `return` retires lanes from `_live`.
+
+			String WideTypeName(Ty t, bool qualified)
+			{
+				String name;
+				if (!TryWideTypeName(t, _lanes, qualified, name)) {
+					Fail("an integer or boolean-vector value varies per pixel"_s);
+					return "void"_s;
+				}
+				return name;
+			}
+
+			bool IsWideVarying(const Expr* e) const
+			{
+				auto it = _wideVarying.find(e);
+				return (it != _wideVarying.end() && it->second);
+			}
+
+			WideSym* DeclareWideSym(const void* key, StringView name, Ty type, bool varying)
+			{
+				WideSym& sym = _wideSyms[key];
+				sym.Type = type;
+				sym.Depth = _wideDepth;
+				if (varying && !sym.Varying) {
+					sym.Varying = true;
+					_wideChanged = true;
+				}
+				_wideScopes.back()[String{name}] = &sym;
+				return &sym;
+			}
+
+			WideSym* LookupWideSym(StringView name) const
+			{
+				for (std::size_t i = _wideScopes.size(); i > 0; i--) {
+					auto it = _wideScopes[i - 1].find(String{name});
+					if (it != _wideScopes[i - 1].end()) return it->second;
+				}
+				return nullptr;
+			}
+
+			// Symbol an assignment target (`x`, `x.a`, `x.rgb`) writes to
+			WideSym* WideTargetSym(const Expr* target) const
+			{
+				while (target != nullptr && target->Kind == ExprKind::Member) {
+					target = target->A.get();
+				}
+				if (target == nullptr || target->Kind != ExprKind::Ident) return nullptr;
+				auto it = _wideRefs.find(target);
+				return (it != _wideRefs.end() ? it->second : nullptr);
+			}
+
+			void AnalyzeWideAssign(const Expr* target, bool valueVarying)
+			{
+				WideSym* sym = WideTargetSym(target);
+				if (sym != nullptr && !sym->Varying && (valueVarying || _wideDepth > sym->Depth)) {
+					sym->Varying = true;
+					_wideChanged = true;
+				}
+			}
+
+			bool AnalyzeWideExpr(const Expr* e)
+			{
+				if (e == nullptr) return false;
+				bool varying = false;
+				switch (e->Kind) {
+					case ExprKind::IntLit: case ExprKind::UIntLit: case ExprKind::FloatLit: case ExprKind::BoolLit:
+						break;
+					case ExprKind::Ident:
+						if (e->Text == "vTexCoords") {
+							varying = true;
+						} else if (WideSym* sym = LookupWideSym(e->Text)) {
+							_wideRefs[e] = sym;
+							varying = sym->Varying;
+						}
+						break;
+					case ExprKind::Call:
+						for (const ExprPtr& arg : e->Args) {
+							varying |= AnalyzeWideExpr(arg.get());
+						}
+						// Sampling and helpers (which always get 4-wide variants) are per pixel
+						if (e->Text == "texture" || IsUserFunc(e->Text)) varying = true;
+						break;
+					case ExprKind::Unary:
+						varying = AnalyzeWideExpr(e->A.get());
+						if (e->Text == "++" || e->Text == "--") AnalyzeWideAssign(e->A.get(), varying);
+						break;
+					case ExprKind::Assign: {
+						bool value = AnalyzeWideExpr(e->B.get());
+						AnalyzeWideExpr(e->A.get());
+						AnalyzeWideAssign(e->A.get(), value);
+						varying = AnalyzeWideExpr(e->A.get());
+						break;
+					}
+					default:
+						varying |= AnalyzeWideExpr(e->A.get());
+						varying |= AnalyzeWideExpr(e->B.get());
+						varying |= AnalyzeWideExpr(e->C.get());
+						break;
+				}
+				_wideVarying[e] = varying;
+				return varying;
+			}
+
+			void AnalyzeWideBranch(const Stmt* s)
+			{
+				if (s == nullptr) return;
+				_wideScopes.emplace_back();
+				if (s->Kind == StmtKind::Block) {
+					for (const StmtPtr& child : s->Body) AnalyzeWideStmt(child.get());
+				} else {
+					AnalyzeWideStmt(s);
+				}
+				_wideScopes.pop_back();
+			}
+
+			void AnalyzeWideStmt(const Stmt* s)
+			{
+				if (s == nullptr) return;
+				switch (s->Kind) {
+					case StmtKind::Block:
+						AnalyzeWideBranch(s);
+						break;
+					case StmtKind::VarDecl:
+						DeclareWideSym(s, s->DeclName, s->DeclType, AnalyzeWideExpr(s->Init.get()));
+						for (const std::pair<String, ExprPtr>& d : s->ExtraDecls) {
+							DeclareWideSym(&d, d.first, s->DeclType, AnalyzeWideExpr(d.second.get()));
+						}
+						break;
+					case StmtKind::ExprStmt:
+						AnalyzeWideExpr(s->E.get());
+						break;
+					case StmtKind::Return:
+						AnalyzeWideExpr(s->E.get());
+						if (_wideDepth > 0) _wideMaskedReturn = true;
+						break;
+					case StmtKind::If: {
+						bool varying = AnalyzeWideExpr(s->Cond.get());
+						if (varying) _wideDepth++;
+						AnalyzeWideBranch(s->Then.get());
+						AnalyzeWideBranch(s->Else.get());
+						if (varying) _wideDepth--;
+						break;
+					}
+					case StmtKind::For:
+						_wideScopes.emplace_back();
+						AnalyzeWideStmt(s->ForInit.get());
+						AnalyzeWideExpr(s->ForCond.get());
+						AnalyzeWideExpr(s->ForUpdate.get());
+						AnalyzeWideBranch(s->ForBody.get());
+						_wideScopes.pop_back();
+						break;
+				}
+			}
+
+			void AnalyzeWideFunction(const Function& fn)
+			{
+				do {
+					_wideChanged = false;
+					_wideMaskedReturn = false;
+					_wideDepth = 0;
+					_wideScopes.clear();
+					_wideScopes.emplace_back();
+					if (fn.Name == "main") {
+						DeclareWideSym(&fn, "COLOR"_s, Ty::Vec4, true);
+					} else {
+						for (const Param& p : fn.Params) {
+							DeclareWideSym(&p, p.Name, p.Type, true);
+						}
+					}
+					AnalyzeWideStmt(fn.Body.get());
+				} while (_wideChanged);
+				_wideScopes.clear();
+				_wideLive = _wideMaskedReturn;
+				_wideMasks.clear();
+				_wideCounter = 0;
+			}
+
+			String WideSymTypeName(const WideSym& sym, Ty type)
+			{
+				return (sym.Varying ? WideTypeName(type, false) : CppTypeName(type, false));
+			}
+
+			bool WideAssignNeedsMask(const Expr* e) const
+			{
+				const WideSym* sym = WideTargetSym(e->A.get());
+				return (sym != nullptr && (std::int32_t)_wideMasks.size() > sym->Depth);
+			}
+
+			// Top-level assignment statement; inside a per-pixel branch it only writes the lanes of its mask
+			String EmitWideAssign(const Expr* e)
+			{
+				const WideSym* sym = WideTargetSym(e->A.get());
+				String value = EmitExpr(e->B.get(), 0);
+				if (sym != nullptr && sym->Varying && sym->Type == Ty::Bool && e->A->Kind == ExprKind::Ident) {
+					value = "vmask("_s + value + ")"_s;
+				}
+				if (!WideAssignNeedsMask(e)) {
+					return EmitExpr(e->A.get(), 1) + " "_s + e->Text + " "_s + value;
+				}
+				String target = EmitExpr(e->A.get(), 1);
+				if (e->Text != "=") {
+					value = target + " "_s + e->Text.prefix(e->Text.size() - 1) + " ("_s + value + ")"_s;
+				}
+				return target + " = select("_s + _wideMasks.back() + ", "_s + value + ", "_s + target + ")"_s;
+			}
+
+			String EmitWideDeclarator(const void* key, Ty type, StringView name, const Expr* init)
+			{
+				const WideSym& sym = _wideSyms[key];
+				String typeName = WideSymTypeName(sym, type);
+				String r = typeName + " "_s + name;
+				if (init != nullptr) {
+					String value = EmitExpr(init, 0);
+					r += " = "_s + (sym.Varying && type == Ty::Bool ? String("vmask("_s + value + ")"_s) : value);
+				}
+				return r;
+			}
+
+			// The 8-wide kernels and their helpers are compiled for AVX2, like the runtime functions they call
+			String WideAttributes() const
+			{
+				return String(_lanes == 8 ? "DEATH_ENABLE_AVX2 "_s : ""_s);
+			}
+
+			// Scalar runtime for the uniform values, the lane types of this width for the per-pixel ones
+			String WideUsings() const
+			{
+				return "\tusing namespace nCine::RHI::Software::sw;\n\tusing namespace nCine::RHI::Software::sw::wide"_s +
+					Death::format("{}", _lanes) + ";\n"_s;
+			}
+
+			String EmitWideMain(const Function& fn)
+			{
+				AnalyzeWideFunction(fn);
+				_wideIsMain = true;
+				_wideRetType = Ty::Void;
+				String out;
+				out += WideAttributes() + "void "_s + _prog + "_Fragment"_s + Death::format("{}", _lanes) +
+					"(const nCine::RHI::Software::FragmentShaderInput"_s + Death::format("{}", _lanes) + "& in)\n{\n"_s;
+				out += WideUsings();
+				out += "\tconst "_s + _prog + "_Uniforms* unis = static_cast<const "_s + _prog + "_Uniforms*>(in.userData);\n"_s;
+				out += "\t(void)unis;\n\t(void)in;\n"_s;
+				out += "\tvvec4 COLOR;\n"_s;
+				if (_wideLive) out += "\tvmask _live(true);\n"_s;
+				EmitWideBlockInner(fn.Body.get(), "\t"_s, out);
+				out += (_wideLive ? "\tpackColor(COLOR, in.rgba, _live);\n}\n"_s : "\tpackColor(COLOR, in.rgba);\n}\n"_s);
+				return out;
+			}
+
+			String EmitWideHelper(const Function& fn)
+			{
+				AnalyzeWideFunction(fn);
+				_wideIsMain = false;
+				_wideRetType = fn.RetType;
+				String out;
+				out += WideAttributes() + "static "_s + WideTypeName(fn.RetType, true) + " "_s + _prog + "_"_s + fn.Name +
+					Death::format("{}", _lanes) + "(const nCine::RHI::Software::FragmentShaderInput"_s + Death::format("{}", _lanes) + "& in"_s;
+				for (std::size_t i = 0; i < fn.Params.size(); i++) {
+					out += ", "_s + WideTypeName(fn.Params[i].Type, true) + " "_s + fn.Params[i].Name;
+				}
+				out += ")\n{\n"_s + WideUsings();
+				out += "\tconst "_s + _prog + "_Uniforms* unis = static_cast<const "_s + _prog + "_Uniforms*>(in.userData);\n"_s;
+				out += "\t(void)unis;\n\t(void)in;\n"_s;
+				const bool hasValue = (fn.RetType != Ty::Void);
+				if (_wideLive) {
+					if (hasValue) {
+						String retType = WideTypeName(fn.RetType, false);
+						out += "\t"_s + retType + " _ret = "_s + retType + "();\n"_s;
+					}
+					out += "\tvmask _live(true);\n"_s;
+				}
+				EmitWideBlockInner(fn.Body.get(), "\t"_s, out);
+				if (_wideLive && hasValue) out += "\treturn _ret;\n"_s;
+				out += "}\n"_s;
+				return out;
+			}
+
+			void EmitWideBlockInner(const Stmt* block, const String& indent, String& out)
+			{
+				if (block == nullptr) return;
+				for (const StmtPtr& s : block->Body) {
+					EmitWideStmt(s.get(), indent, out);
+				}
+			}
+
+			void EmitWideBranch(const Stmt* s, const String& indent, String& out)
+			{
+				String inner = indent + "\t"_s;
+				out += "{\n"_s;
+				if (s != nullptr && s->Kind == StmtKind::Block) {
+					EmitWideBlockInner(s, inner, out);
+				} else if (s != nullptr) {
+					EmitWideStmt(s, inner, out);
+				}
+				out += indent + "}"_s;
+			}
+
+			// One side of a per-pixel `if`, skipped when no lane takes it
+			void EmitWideMaskedBranch(const Stmt* s, const String& mask, const String& indent, String& out)
+			{
+				out += indent + "if (any("_s + mask + ")) "_s;
+				_wideMasks.push_back(mask);
+				EmitWideBranch(s, indent, out);
+				_wideMasks.pop_back();
+				out += "\n"_s;
+			}
+
+			void EmitWideStmt(const Stmt* s, const String& indent, String& out)
+			{
+				if (s == nullptr) return;
+				switch (s->Kind) {
+					case StmtKind::Block:
+						out += indent + "{\n"_s;
+						EmitWideBlockInner(s, indent + "\t"_s, out);
+						out += indent + "}\n"_s;
+						break;
+					case StmtKind::VarDecl:
+						out += indent + EmitWideDeclarator(s, s->DeclType, s->DeclName, s->Init.get()) + ";\n"_s;
+						for (const std::pair<String, ExprPtr>& d : s->ExtraDecls) {
+							out += indent + EmitWideDeclarator(&d, s->DeclType, d.first, d.second.get()) + ";\n"_s;
+						}
+						break;
+					case StmtKind::ExprStmt:
+						if (IsSwizzleWrite(s->E.get())) {
+							EmitSwizzleWrite(s->E.get(), indent, out);
+						} else if (s->E != nullptr && s->E->Kind == ExprKind::Assign) {
+							out += indent + EmitWideAssign(s->E.get()) + ";\n"_s;
+						} else {
+							out += indent + EmitExpr(s->E.get(), 0) + ";\n"_s;
+						}
+						break;
+					case StmtKind::Return: {
+						String value = (s->E != nullptr ? EmitExpr(s->E.get(), 0) : String{});
+						if (_wideMasks.empty()) {
+							// Every lane that is still live returns here
+							if (_wideIsMain || value.empty()) {
+								out += indent + "return;\n"_s;
+							} else if (_wideLive) {
+								out += indent + "return select(_live, "_s + value + ", _ret);\n"_s;
+							} else {
+								out += indent + "return "_s + value + ";\n"_s;
+							}
+						} else {
+							const String& mask = _wideMasks.back();
+							if (!_wideIsMain && !value.empty()) {
+								out += indent + "_ret = select("_s + mask + " & _live, "_s + value + ", _ret);\n"_s;
+							}
+							out += indent + "_live = andNot(_live, "_s + mask + ");\n"_s;
+						}
+						break;
+					}
+					case StmtKind::If: {
+						if (!IsWideVarying(s->Cond.get())) {
+							out += indent + "if ("_s + EmitExpr(s->Cond.get(), 0) + ") "_s;
+							EmitWideBranch(s->Then.get(), indent, out);
+							if (s->Else != nullptr) {
+								out += " else "_s;
+								EmitWideBranch(s->Else.get(), indent, out);
+							}
+							out += "\n"_s;
+							break;
+						}
+						String n = Death::format("{}", _wideCounter++);
+						String cond = "_cond"_s + n;
+						String outer = (_wideMasks.empty() ? String{} : _wideMasks.back());
+						out += indent + "const vmask "_s + cond + " = vmask("_s + EmitExpr(s->Cond.get(), 0) + ");\n"_s;
+						String mask = "_mask"_s + n;
+						out += indent + "const vmask "_s + mask + " = "_s + (outer.empty() ? cond : String(outer + " & "_s + cond)) + ";\n"_s;
+						EmitWideMaskedBranch(s->Then.get(), mask, indent, out);
+						if (s->Else != nullptr) {
+							String elseMask = "_else"_s + n;
+							out += indent + "const vmask "_s + elseMask + " = "_s +
+								(outer.empty() ? String("!"_s + cond) : String("andNot("_s + outer + ", "_s + cond + ")"_s)) + ";\n"_s;
+							EmitWideMaskedBranch(s->Else.get(), elseMask, indent, out);
+						}
+						break;
+					}
+					case StmtKind::For: {
+						if (IsWideVarying(s->ForCond.get())) {
+							Fail("loop condition varies per pixel"_s);
+							break;
+						}
+						const Stmt* init = s->ForInit.get();
+						if (init != nullptr && init->Kind == StmtKind::VarDecl) {
+							bool varying = _wideSyms[init].Varying;
+							for (const std::pair<String, ExprPtr>& d : init->ExtraDecls) {
+								varying |= _wideSyms[&d].Varying;
+							}
+							if (varying) {
+								Fail("loop variable varies per pixel"_s);
+								break;
+							}
+						}
+						out += indent + "for ("_s + EmitForInit(init) + "; "_s;
+						if (s->ForCond != nullptr) out += EmitExpr(s->ForCond.get(), 0);
+						out += "; "_s;
+						if (s->ForUpdate != nullptr) out += EmitExpr(s->ForUpdate.get(), 0);
+						out += ") "_s;
+						EmitWideBranch(s->ForBody.get(), indent, out);
+						out += "\n"_s;
+						break;
+					}
+				}
+			}
 		};
 	}
 
@@ -1458,6 +2058,8 @@ namespace ShaderCompiler
 		result.Code = std::move(code);
 		result.HasComputeVaryings = emitter.HasComputeVaryings();
 		result.ConstVaryingNames = emitter.ConstVaryingNames();
+		result.HasFragment4 = emitter.HasFragment4();
+		result.Fragment4UnsupportedReason = emitter.Fragment4Reason();
 		return result;
 	}
 }
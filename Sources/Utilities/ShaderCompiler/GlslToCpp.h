@@ -23,6 +23,12 @@
 	`vTexCoords`/`vColor`, or any fragment output besides `COLOR` — the software rasterizer renders to a
 	single color target, no MRT) makes @ref GlslToCppResult::Supported `false` with a reason and NO
 	emitted code, so unsupported shaders are cleanly declined rather than mistranslated.
+
+	A supported shader additionally gets a 4-wide `<Program>_Fragment4` when its control flow can be
+	vectorized: a uniformity analysis keeps values equal for the whole pixel quad scalar and lowers the
+	per-pixel ones to the runtime's structure-of-arrays types (`vfloat`/`vvec2`/...), and a branch on a
+	per-pixel condition runs under a lane mask. Loops with a per-pixel condition or per-pixel integer and
+	boolean-vector values keep only the scalar kernel (@ref GlslToCppResult::HasFragment4 is `false`).
 */
 
 #include <cstdint>
@@ -87,6 +93,16 @@ namespace ShaderCompiler
 			(not by `ResolveUniform`), so the caller excludes them from the loose-uniform field list.
 		*/
 		SmallVector<String, 0> ConstVaryingNames;
+		/**
+			@brief `true` when the wide `<Program>_Fragment4(const FragmentShaderInput4&)` and
+				`<Program>_Fragment8(const FragmentShaderInput8&)` were emitted as well
+
+			They shade four or eight adjacent pixels with the same result as that many calls of
+			`<Program>_Fragment`. The 8-wide kernel is guarded by `SW_WIDE8` (AVX2, see SwShaderRuntime.h).
+		*/
+		bool HasFragment4 = false;
+		/** @brief Why the wide kernels were not emitted (only meaningful when @ref HasFragment4 is `false`) */
+		String Fragment4UnsupportedReason;
 	};
 
 	/** @brief Transpiles lowered fragment GLSL into a C++ software-renderer fragment function */
@@ -389,6 +389,8 @@ namespace
 		String Code;								// the transpiled struct + fragment function
 		SmallVector<GeneratedUniformField, 0> Fields;	// non-sampler uniform layout of the struct
 		bool HasComputeVaryings = false;			// a "<Prefix>_ComputeVaryings" was emitted (per-instance-constant varyings)
+		bool HasFragment4 = false;					// the wide "<Prefix>_Fragment4" and "<Prefix>_Fragment8" were emitted as well
+		String Fragment4Reason;						// why it was not (only for the summary)
 	};
 
 	/** Scalar-component count of a reflected GLSL type (0 for matrices/structs/samplers - not a varying member) */
@@ -545,7 +547,12 @@ namespace
 			if (sw.size() == 1) {
 				ok = "xyrgst"_s.contains(sw[0]);
 			} else {
-				ok = (sw == "xy"_s || sw == "rg"_s);	// the only swizzle methods sw::vec2 provides
+				// The runtime spells the swizzle methods with xyzw only, sw::vec2 provides xy(), yx(), xx() and yy()
+				String normalized = sw;
+				for (char& c : normalized) {
+					c = (c == 'r' || c == 's' ? 'x' : (c == 'g' || c == 't' ? 'y' : c));
+				}
+				ok = (normalized == "xy"_s || normalized == "yx"_s || normalized == "xx"_s || normalized == "yy"_s);
 			}
 			if (!ok) {
 				reason = "reads '."_s + sw + "' of vTexCoords, which the software path only exposes as a 2D texture coordinate"_s;
@@ -1282,6 +1289,12 @@ namespace
 		out += "#include <cstddef>\n";
 		out += "#include <cstdint>\n";
 		out += "#include <cstring>\n\n";
+		// The 8-wide kernels exist only where the runtime can compile them (AVX2, see SwShaderRuntime.h)
+		out += "#if defined(SW_WIDE8)\n";
+		out += "#\tdefine SW_GENERATED_FRAGMENT8(name) &name\n";
+		out += "#else\n";
+		out += "#\tdefine SW_GENERATED_FRAGMENT8(name) nullptr\n";
+		out += "#endif\n\n";
 		out += "namespace nCine::RHI::Software\n{\n";
 		// The transpiled fragment functions are plain (non-inline) free functions. Wrapping the whole payload
 		// in an anonymous namespace gives them internal linkage so the header is ODR-safe even if it is ever
@@ -1301,7 +1314,9 @@ namespace
 		// computeVaryings is null unless the shader reads per-instance-constant varyings; the device calls it
 		// once per instance (with that instance's block pointer) to fill those varyings before the draw
 		out += "\t\tusing SwGeneratedComputeVaryingsFn = void (*)(void* inputs, const std::uint8_t* instanceBlock);\n";
-		out += "\t\tstruct SwGeneratedShaderInfo { const char* name; nCine::RHI::Software::FragmentShaderFn fragment; std::uint32_t uniformsSize; const SwGeneratedUniformField* uniformFields; std::uint32_t uniformFieldCount; SwGeneratedComputeVaryingsFn computeVaryings; };\n\n";
+		// fragment4/fragment8 are null when the transpiler could not vectorize the shader, the scalar kernel then shades
+		// every pixel; fragment8 is also null when the build cannot target AVX2
+		out += "\t\tstruct SwGeneratedShaderInfo { const char* name; nCine::RHI::Software::FragmentShaderFn fragment; std::uint32_t uniformsSize; const SwGeneratedUniformField* uniformFields; std::uint32_t uniformFieldCount; SwGeneratedComputeVaryingsFn computeVaryings; nCine::RHI::Software::FragmentShader4Fn fragment4; nCine::RHI::Software::FragmentShader8Fn fragment8; };\n\n";
 
 		for (const GeneratedShaderEntry& e : supported) {
 			if (e.Fields.empty()) {
@@ -1323,8 +1338,10 @@ namespace
 			for (const GeneratedShaderEntry& e : supported) {
 				String fieldsPtr = (e.Fields.empty() ? String("nullptr") : String(e.Prefix + "_Fields"));
 				String computeVaryingsPtr = (e.HasComputeVaryings ? String("&" + e.Prefix + "_ComputeVaryings") : String("nullptr"));
+				String fragment4Ptr = (e.HasFragment4 ? String("&" + e.Prefix + "_Fragment4") : String("nullptr"));
+				String fragment8Ptr = (e.HasFragment4 ? String("SW_GENERATED_FRAGMENT8(" + e.Prefix + "_Fragment8)") : String("nullptr"));
 				out += "\t\t\t{ \"" + e.Prefix + "\", &" + e.Prefix + "_Fragment, (std::uint32_t)sizeof(" + e.Prefix + "_Uniforms), " +
-					fieldsPtr + ", " + Death::format("{}", e.Fields.size()) + ", " + computeVaryingsPtr + " },\n";
+					fieldsPtr + ", " + Death::format("{}", e.Fields.size()) + ", " + computeVaryingsPtr + ", " + fragment4Ptr + ", " + fragment8Ptr + " },\n";
 			}
 			out += "\t\t};\n\n";
 			out += "\t\tconst SwGeneratedShaderInfo* FindGeneratedShader(const char* name)\n\t\t{\n";
@@ -1361,6 +1378,7 @@ namespace
 
 		out += "\t}\n";	// anonymous namespace
 		out += "}\n";		// namespace nCine::RHI::Software
+		out += "\n#undef SW_GENERATED_FRAGMENT8\n";
 		out += "\n#endif\n";
 		return out;
 	}
@@ -2189,6 +2207,8 @@ namespace
 						e.Prefix = prefix;
 						e.Code = std::move(r.Code);
 						e.HasComputeVaryings = r.HasComputeVaryings;
+						e.HasFragment4 = r.HasFragment4;
+						e.Fragment4Reason = std::move(r.Fragment4UnsupportedReason);
 						ExtractUniformFields(e.Code, e.Prefix, e.Fields);
 						// Constant-varying fields share the struct with the loose uniforms but are filled by
 						// "<Prefix>_ComputeVaryings" (not ResolveUniform), so drop them from the uniform list.
@@ -2218,7 +2238,11 @@ namespace
 		std::fprintf(stdout, "[SwGenerated] emitted %zu supported fragment function(s), declined %zu\n",
 			supported.size(), declined.size());
 		for (const GeneratedShaderEntry& e : supported) {
-			std::fprintf(stdout, "  emitted:  %s (%zu uniform field(s))\n", e.Prefix.data(), e.Fields.size());
+			if (e.HasFragment4) {
+				std::fprintf(stdout, "  emitted:  %s (%zu uniform field(s), 4/8-wide)\n", e.Prefix.data(), e.Fields.size());
+			} else {
+				std::fprintf(stdout, "  emitted:  %s (%zu uniform field(s), scalar only - %s)\n", e.Prefix.data(), e.Fields.size(), e.Fragment4Reason.data());
+			}
 		}
 		for (const std::pair<String, String>& d : declined) {
 			std::fprintf(stdout, "  declined: %s - %s\n", d.first.data(), d.second.data());
@@ -27,6 +27,8 @@ std::unique_ptr<IAppEventHandler> CreateAppEventHandler();
 static retro_audio_sample_t _audioCb;
 static retro_audio_sample_batch_t _audioBatchCb;
 static bool _gameInitialized = false;
+static bool _variableStateSize = false;
+static std::int64_t _frameCount = 0;
 
 static constexpr double AudioSampleRate = 48000.0;
 
@@ -105,12 +107,16 @@ RETRO_API void retro_set_environment(retro_environment_t cb)
 	};
 	cb(RETRO_ENVIRONMENT_SET_VARIABLES, (void*)variables);
 
-	// Save states are the game's own level-resume snapshot written in host byte order: usable for
-	// manual save/load, but the frontend must not build rewind, run-ahead or netplay on top of it,
-	// and the resulting file cannot travel to a machine with a different endianness or word size
-	std::uint64_t quirks = RETRO_SERIALIZATION_QUIRK_INCOMPLETE | RETRO_SERIALIZATION_QUIRK_MUST_INITIALIZE |
+	// Save states hold an exact snapshot of the frame for rewind and same-instance run-ahead, plus the
+	// game's own level-resume snapshot for manual save/load. Both are written in host byte order and
+	// the exact one refers to objects in memory, so the state cannot travel to another process, let
+	// alone a machine with a different endianness or word size - that rules out netplay. The size
+	// follows the content of the state if the frontend supports it, it clears the flag otherwise
+	std::uint64_t quirks = RETRO_SERIALIZATION_QUIRK_MUST_INITIALIZE | RETRO_SERIALIZATION_QUIRK_CORE_VARIABLE_SIZE |
 		RETRO_SERIALIZATION_QUIRK_ENDIAN_DEPENDENT | RETRO_SERIALIZATION_QUIRK_PLATFORM_DEPENDENT;
-	cb(RETRO_ENVIRONMENT_SET_SERIALIZATION_QUIRKS, &quirks);
+	if (cb(RETRO_ENVIRONMENT_SET_SERIALIZATION_QUIRKS, &quirks)) {
+		_variableStateSize = (quirks & RETRO_SERIALIZATION_QUIRK_FRONT_VARIABLE_SIZE) != 0;
+	}
 }
 
 RETRO_API void retro_set_video_refresh(retro_video_refresh_t cb) { LibretroApplication::VideoRefreshCallback = cb; }
@@ -181,6 +187,7 @@ RETRO_API void retro_run(void)
 	LibretroApplication::IsInsideFrame = true;
 	theLibretroApplication().RunFrame();
 	LibretroApplication::IsInsideFrame = false;
+	_frameCount++;
 
 	// One frame of the mixed OpenAL output (48000 Hz / fps) is pulled from the loopback device and
 	// handed to the frontend; it also feeds the frontend's audio sync so retro_run stays paced at
@@ -207,15 +214,96 @@ RETRO_API void retro_run(void)
 	}
 }
 
-// Save states piggyback on the application's own resumable session snapshot: it is restored on the
-// next frame instead of the current one, so it is fine for manual save/load but unsuitable for
-// netplay/run-ahead/rewind.
-// Fixed generous cap, the snapshot is deflate-compressed and typically tens of KB
+// Save states start with an exact, uncompressed snapshot of the current frame that is restored
+// synchronously, so run-ahead and rewind see the same frame again. It only refers to actors kept
+// alive in memory, so it is followed by the application's own resumable session snapshot, which is
+// restored on the next frame instead, but survives a restart - manual saves fall back to it.
+// Same-instance run-ahead states never leave the process, so they carry only the exact snapshot.
+// Rewind gets the normal context too, it can't be told apart from a manual save, but it asks for
+// a state every frame - then the deflated session is reused for up to a second instead of being
+// compressed again each time. It's only the fallback after a restart, which reloads the level anyway.
+// If the frontend doesn't support a variable size, the state must fit a fixed generous cap instead:
+// the exact part is typically a few hundred KB and the deflate-compressed session tens of KB
 static constexpr std::size_t StateBufferSize = 2 * 1024 * 1024;
+// Marks a state that starts with an exact snapshot, older states start with the session signature
+static constexpr std::uint32_t FrameStateSignature = 0x5346324A;	// "J2FS"
+static constexpr std::size_t FrameStateHeaderSize = 2 * sizeof(std::uint32_t);
+static constexpr std::int64_t SessionRefreshFrames = 60;
+
+// The state is built once per frame and context, retro_serialize_size() needs it to report the size
+static MemoryStream _state;
+static std::int64_t _stateFrame = -1;
+static retro_savestate_context _stateContext = RETRO_SAVESTATE_CONTEXT_NORMAL;
+static MemoryStream _session;
+static std::int64_t _sessionFrame = -1;
+static std::int64_t _lastNormalStateFrame = -1;
+static bool _sessionSaved = false;
+
+static retro_savestate_context GetSaveStateContext()
+{
+	retro_savestate_context context = RETRO_SAVESTATE_CONTEXT_NORMAL;
+	LibretroApplication::EnvironmentCallback(RETRO_ENVIRONMENT_GET_SAVESTATE_CONTEXT, &context);
+	return context;
+}
+
+static void InvalidateState()
+{
+	_stateFrame = -1;
+	_sessionFrame = -1;
+}
+
+static bool BuildState(retro_savestate_context context)
+{
+	if (_stateFrame == _frameCount && _stateContext == context) {
+		return true;
+	}
+	_stateFrame = -1;
+
+	_state.SetSize(0);
+	_state.Seek(0, SeekOrigin::Begin);
+	std::uint32_t frameSize = 0;
+	_state.WriteValue<std::uint32_t>(FrameStateSignature);
+	_state.WriteValue<std::uint32_t>(frameSize);
+	if (theLibretroApplication().SaveFrameState(_state)) {
+		frameSize = (std::uint32_t)(_state.GetPosition() - FrameStateHeaderSize);
+		std::memcpy(_state.GetBuffer() + sizeof(std::uint32_t), &frameSize, sizeof(std::uint32_t));
+	} else if (context == RETRO_SAVESTATE_CONTEXT_RUNAHEAD_SAME_INSTANCE) {
+		return false;
+	} else {
+		_state.SetSize(FrameStateHeaderSize);
+	}
+
+	if (context != RETRO_SAVESTATE_CONTEXT_RUNAHEAD_SAME_INSTANCE) {
+		bool everyFrame = (_lastNormalStateFrame >= 0 && _lastNormalStateFrame + 1 >= _frameCount);
+		if (!everyFrame || _sessionFrame < 0 || _sessionFrame + SessionRefreshFrames <= _frameCount) {
+			_session.SetSize(0);
+			_session.Seek(0, SeekOrigin::Begin);
+			// Saving must work at any point (auto-states on exit, manual saves in the menus): outside
+			// a resumable session only the header is written instead of failing - loading it is a no-op
+			_sessionSaved = theLibretroApplication().SaveState(_session);
+			_sessionFrame = _frameCount;
+		}
+		_lastNormalStateFrame = _frameCount;
+		if (_sessionSaved) {
+			_state.Seek(0, SeekOrigin::End);
+			_state.Write(_session.GetBuffer(), _session.GetSize());
+		}
+	}
+
+	_stateFrame = _frameCount;
+	_stateContext = context;
+	return true;
+}
 
 RETRO_API size_t retro_serialize_size(void)
 {
-	return StateBufferSize;
+	if (!_variableStateSize) {
+		return StateBufferSize;
+	}
+	if (!_gameInitialized || !BuildState(GetSaveStateContext())) {
+		return 0;
+	}
+	return (std::size_t)_state.GetSize();
 }
 
 RETRO_API bool retro_serialize(void* data, size_t size)
@@ -223,25 +311,38 @@ RETRO_API bool retro_serialize(void* data, size_t size)
 	if (!_gameInitialized) {
 		return false;
 	}
-	// The snapshot is checkpoint-grade, it cannot serve the frame-exact contexts: refuse them right
-	// away instead of producing a state that would only corrupt run-ahead or rollback netplay
-	retro_savestate_context context = RETRO_SAVESTATE_CONTEXT_NORMAL;
-	if (LibretroApplication::EnvironmentCallback(RETRO_ENVIRONMENT_GET_SAVESTATE_CONTEXT, &context) &&
-		context != RETRO_SAVESTATE_CONTEXT_NORMAL && context != RETRO_SAVESTATE_CONTEXT_UNKNOWN) {
+	// The exact snapshot refers to objects of this process, so it cannot serve a second instance or
+	// netplay peers: refuse them right away instead of producing a state that would corrupt them
+	retro_savestate_context context = GetSaveStateContext();
+	if (context == RETRO_SAVESTATE_CONTEXT_RUNAHEAD_SAME_BINARY || context == RETRO_SAVESTATE_CONTEXT_ROLLBACK_NETPLAY) {
 		return false;
 	}
-	MemoryStream session;
-	if (!theLibretroApplication().SaveState(session)) {
-		// Saving must work at any point (auto-states on exit, manual saves in the menus): outside a
-		// resumable session an all-zero state is written instead of failing - loading it is a no-op
-		std::memset(data, 0, size);
-		return true;
-	}
-	if ((std::size_t)session.GetSize() > size) {
+	if (size < FrameStateHeaderSize || !BuildState(context)) {
 		return false;
 	}
-	std::memcpy(data, session.GetBuffer(), (std::size_t)session.GetSize());
-	std::memset((std::uint8_t*)data + session.GetSize(), 0, size - (std::size_t)session.GetSize());
+
+	std::uint8_t* bytes = (std::uint8_t*)data;
+	const std::uint8_t* state = _state.GetBuffer();
+	std::size_t stateSize = (std::size_t)_state.GetSize();
+	if (stateSize > size) {
+		// The exact snapshot didn't fit the fixed cap, the session alone is still better than nothing
+		std::uint32_t frameSize;
+		std::memcpy(&frameSize, state + sizeof(std::uint32_t), sizeof(std::uint32_t));
+		if (context == RETRO_SAVESTATE_CONTEXT_RUNAHEAD_SAME_INSTANCE || stateSize - frameSize > size) {
+			return false;
+		}
+		std::uint32_t noFrameSize = 0;
+		std::memcpy(bytes, &FrameStateSignature, sizeof(std::uint32_t));
+		std::memcpy(bytes + sizeof(std::uint32_t), &noFrameSize, sizeof(std::uint32_t));
+		std::memcpy(bytes + FrameStateHeaderSize, state + FrameStateHeaderSize + frameSize, stateSize - FrameStateHeaderSize - frameSize);
+		stateSize -= frameSize;
+	} else {
+		std::memcpy(bytes, state, stateSize);
+	}
+	// With a fixed size, the whole buffer ends up in the file, so the unused tail must not carry stale data
+	if (stateSize < size) {
+		std::memset(bytes + stateSize, 0, size - stateSize);
+	}
 	return true;
 }
 
@@ -250,11 +351,33 @@ RETRO_API bool retro_unserialize(const void* data, size_t size)
 	if (!_gameInitialized || size == 0) {
 		return false;
 	}
+	InvalidateState();
+
 	const std::uint8_t* bytes = (const std::uint8_t*)data;
+	std::uint32_t signature = 0, frameSize = 0;
+	bool frameStateFailed = false;
+	if (size >= FrameStateHeaderSize) {
+		std::memcpy(&signature, bytes, sizeof(std::uint32_t));
+		std::memcpy(&frameSize, bytes + sizeof(std::uint32_t), sizeof(std::uint32_t));
+	}
+	if (signature == FrameStateSignature && frameSize <= size - FrameStateHeaderSize) {
+		// The exact snapshot is restored right away, the session only if it is no longer valid
+		if (frameSize > 0) {
+			MemoryStream frame(bytes + FrameStateHeaderSize, frameSize);
+			if (theLibretroApplication().LoadFrameState(frame)) {
+				return true;
+			}
+			frameStateFailed = true;
+		}
+		bytes += FrameStateHeaderSize + frameSize;
+		size -= FrameStateHeaderSize + frameSize;
+	}
+
 	static const std::uint8_t EmptySignature[8] = {};
 	if (size < sizeof(EmptySignature) || std::memcmp(bytes, EmptySignature, sizeof(EmptySignature)) == 0) {
-		// The state was saved outside a resumable session, there is nothing to restore
-		return true;
+		// The state was saved outside a resumable session, there is nothing to restore - unless the
+		// exact snapshot was the only content, then the frontend must know that nothing was restored
+		return !frameStateFailed;
 	}
 	auto ms = std::make_shared<MemoryStream>(Containers::InPlaceInit,
 		Containers::ArrayView<const std::uint8_t>(bytes, (std::size_t)size));
@@ -340,6 +463,7 @@ RETRO_API void retro_unload_game(void)
 		theLibretroApplication().Shutdown();
 		_gameInitialized = false;
 	}
+	InvalidateState();
 }
 
 RETRO_API unsigned retro_get_region(void)
@@ -97,6 +97,16 @@ namespace nCine::Backends
 	{
 		return (_appEventHandler != nullptr && _appEventHandler->OnLoadState(std::move(src)));
 	}
+
+	bool LibretroApplication::SaveFrameState(Death::IO::Stream& dest)
+	{
+		return (_appEventHandler != nullptr && _appEventHandler->OnSaveFrameState(dest));
+	}
+
+	bool LibretroApplication::LoadFrameState(Death::IO::Stream& src)
+	{
+		return (_appEventHandler != nullptr && _appEventHandler->OnLoadFrameState(src));
+	}
 }
 
 #endif
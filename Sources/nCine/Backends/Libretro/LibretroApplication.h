@@ -59,6 +59,10 @@ namespace nCine::Backends
 		bool SaveState(Death::IO::Stream& dest);
 		/** @brief Restores a snapshot written by @ref SaveState(), see @ref IAppEventHandler::OnLoadState() */
 		bool LoadState(std::shared_ptr<Death::IO::Stream> src);
+		/** @brief Writes an exact snapshot of the current frame to a stream, see @ref IAppEventHandler::OnSaveFrameState() */
+		bool SaveFrameState(Death::IO::Stream& dest);
+		/** @brief Restores a snapshot written by @ref SaveFrameState(), see @ref IAppEventHandler::OnLoadFrameState() */
+		bool LoadFrameState(Death::IO::Stream& src);
 
 		/** @brief Returns the directories advertised by the frontend */
 		inline const HostPaths& GetHostPaths() const {
@@ -772,11 +772,12 @@ namespace nCine::Backends
 		if (_softwareRenderer == nullptr) {
 			return;
 		}
-		// Render any draws the tile renderer deferred this frame into the screen buffer before we read it
-		RHI::Device::FlushSoftwareRenderer();
+		// Render any draws the tile renderer deferred this frame into the screen buffer before we read it. When the
+		// tile renderer is pipelined, this frame is rasterized while the next one is updated and the previous,
+		// already finished frame is returned instead
+		const auto fb = RHI::Device::PresentSoftwareRenderer();
 		// All of this frame's Combine draws have run by now, so any lighting entries still queued are leftovers
 		RHI::Device::EndFrame();
-		const auto fb = RHI::Device::GetScreenFramebuffer();
 		// The render pipeline sizes the screen framebuffer to the internal/logical resolution (see
 		// UpscaleRenderPass, which resizes it on the software backend); keep the streaming texture matched to
 		// that size so SDL_RenderCopyEx below stretches the low-resolution image up to the window. The window
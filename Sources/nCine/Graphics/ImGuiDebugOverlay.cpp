@@ -30,6 +30,9 @@
 #if defined(WITH_RENDERDOC)
 #	include "RenderDocCapture.h"
 #endif
+#if defined(WITH_RHI_SOFTWARE)
+#	include "RHI/Software/SwTileRenderer.h"
+#endif
 
 #if defined(WITH_ALLOCATORS)
 #	include "allocators_config.h"
@@ -1410,6 +1413,17 @@ namespace nCine
 
 		ImGui::Text("Viewport chain length: %u", Viewport::GetChain().size());
 
+#if defined(WITH_RHI_SOFTWARE)
+		// Counters are cumulative, show how many tiles were reused since the previous overlay frame
+		static RHI::Software::SwTileRenderer::TileCacheStats lastTileStats = {};
+		const RHI::Software::SwTileRenderer::TileCacheStats tileStats = RHI::Software::SwTileRenderer::GetTileCacheStats();
+		const std::uint64_t processedTiles = tileStats.processedTiles - lastTileStats.processedTiles;
+		const std::uint64_t skippedTiles = tileStats.skippedTiles - lastTileStats.skippedTiles;
+		lastTileStats = tileStats;
+		ImGui::Text("%u/%u software tiles reused (%.0f%%)", (std::uint32_t)skippedTiles, (std::uint32_t)processedTiles,
+			processedTiles > 0 ? (float)skippedTiles * 100.0f / (float)processedTiles : 0.0f);
+#endif
+
 		ImGui::End();
 	}
 #endif
@@ -3,6 +3,7 @@
 #include "SwRaster.h"
 #include "SwScanlineOps.h"
 #include "SwShaderProgram.h"
+#include "SwTileRenderer.h"
 #include "SwRenderTarget.h"
 #include "SwTexture.h"
 
@@ -102,7 +103,8 @@ namespace nCine::RHI::Software
 	std::int32_t SwDevice::_defaultFbWidth = 0;
 	std::int32_t SwDevice::_defaultFbHeight = 0;
 	std::int32_t SwDevice::_defaultFbStride = 0;
-	std::vector<std::uint8_t> SwDevice::_screenPixels;
+	std::vector<std::uint8_t> SwDevice::_screenPixels[2];
+	std::int32_t SwDevice::_screenBufferIndex = 0;
 	std::vector<SwDevice::PendingSoftwareLight> SwDevice::_pendingSoftwareLights;
 
 	void SwDevice::SetBlendingEnabled(bool enabled)
@@ -355,11 +357,18 @@ namespace nCine::RHI::Software
 		constexpr std::size_t ScreenBpp = 4;
 #endif
 		const std::size_t required = std::size_t(width) * std::size_t(height) * ScreenBpp;
-		if (_screenPixels.size() != required) {
-			_screenPixels.assign(required, 0);
+		if (_screenPixels[0].size() != required) {
+			// Workers may still be rendering the previous frame into one of the stores
+			SwRaster::WaitForAsyncFlush();
+			SwTileRenderer::InvalidateTarget(_screenPixels[0].data());
+			SwTileRenderer::InvalidateTarget(_screenPixels[1].data());
+			_screenPixels[0].assign(required, 0);
+			// The second store is allocated lazily by PresentSoftwareRenderer(), only if the present path is pipelined
+			_screenPixels[1].clear();
+			_screenBufferIndex = 0;
 		}
 		Framebuffer fb;
-		fb.pixels = _screenPixels.data();
+		fb.pixels = _screenPixels[_screenBufferIndex].data();
 		fb.width = width;
 		fb.height = height;
 		fb.strideBytes = width * std::int32_t(ScreenBpp);
@@ -381,6 +390,33 @@ namespace nCine::RHI::Software
 		SwRaster::Flush();
 	}
 
+	Framebuffer SwDevice::PresentSoftwareRenderer()
+	{
+		// Pipelining requires the default framebuffer to be the owned screen store, an external one can't be swapped
+		const bool ownsScreen = (!_screenPixels[0].empty() && _defaultFbPixels == _screenPixels[_screenBufferIndex].data());
+		if (!ownsScreen || !SwTileRenderer::IsPipelined()) {
+			FlushSoftwareRenderer();
+			return GetScreenFramebuffer();
+		}
+
+		const std::int32_t nextIndex = (_screenBufferIndex ^ 1);
+		if (_screenPixels[nextIndex].size() != _screenPixels[_screenBufferIndex].size()) {
+			_screenPixels[nextIndex].assign(_screenPixels[_screenBufferIndex].size(), 0);
+		}
+
+		// Waits for the previous frame (rendered into the other store), then starts this one on the workers
+		SwRaster::FlushAsync();
+
+		Framebuffer fb = GetScreenFramebuffer();
+		fb.pixels = _screenPixels[nextIndex].data();
+
+		// The next frame is rendered into the store that is presented now, it's not touched before the next
+		// frame starts drawing into it, by then the window backend has already copied it
+		_screenBufferIndex = nextIndex;
+		SetDefaultFramebuffer(fb);
+		return fb;
+	}
+
 	void SwDevice::EndFrame()
 	{
 		if (!_pendingSoftwareLights.empty()) {
@@ -395,12 +431,14 @@ namespace nCine::RHI::Software
 		}
 	}
 
-	void SwDevice::SetPendingSoftwareLighting(const float* lightmap, std::int32_t lmW, std::int32_t lmH, std::int32_t scale,
+	void SwDevice::SetPendingSoftwareLighting(const SwLight* lights, std::int32_t lightCount, float ambientLevel, std::int32_t lmW, std::int32_t lmH, std::int32_t scale,
 		std::int32_t vpX, std::int32_t vpY, std::int32_t vpW, std::int32_t vpH, float ambR, float ambG, float ambB,
 		bool waterActive, float waterLevelPx, float waterTime, float waterCamY)
 	{
 		PendingSoftwareLight entry;
-		entry.Lightmap = lightmap;
+		entry.Lights = lights;
+		entry.LightCount = lightCount;
+		entry.AmbientLevel = ambientLevel;
 		entry.LmW = lmW;
 		entry.LmH = lmH;
 		entry.Scale = (scale > 0 ? scale : 1);
@@ -469,16 +507,12 @@ namespace nCine::RHI::Software
 		const PendingSoftwareLight light = _pendingSoftwareLights.front();
 		_pendingSoftwareLights.erase(_pendingSoftwareLights.begin());
 
-		const bool hasLighting = (light.Lightmap != nullptr && light.LmW > 0 && light.LmH > 0);
+		const bool hasLighting = (light.LmW > 0 && light.LmH > 0);
 		const bool hasWater = light.WaterActive;
 		if (!hasLighting && !hasWater) {
 			return;
 		}
 
-		// The scene viewport rasterized straight into the screen back-buffer and deferred its tiles to the tile
-		// renderer; drain them so the buffer holds the finished scene before it is read back and modified here. The
-		// HUD is dispatched after this Combine draw, so it is not affected (it re-defers and is flushed at present).
-		FlushSoftwareRenderer();
 		const Framebuffer fb = GetScreenFramebuffer();
 		if (fb.pixels == nullptr) {
 			return;
@@ -500,6 +534,41 @@ namespace nCine::RHI::Software
 		const float ambG = light.AmbG;
 		const float ambB = light.AmbB;
 
+		if (!hasWater) {
+			// The lighting alone is per pixel, so it runs inside the tile renderer's worker pass: each tile is lit
+			// right after the scene was drawn into it, still in the cache, and the HUD submitted after this
+			// Combine draw is drawn over it. Declined only when the scene doesn't go through the tile renderer.
+			SwTileRenderer::LightingParams params;
+			params.viewportX = vpX;
+			params.viewportY = vpY;
+			params.viewportW = vpW;
+			params.viewportH = vpH;
+			params.lightmapW = lmW;
+			params.lightmapH = lmH;
+			params.scale = scale;
+			params.ambientLevel = light.AmbientLevel;
+			params.ambientR = ambR;
+			params.ambientG = ambG;
+			params.ambientB = ambB;
+			if (SwTileRenderer::SubmitLighting(fb.pixels, light.Lights, light.LightCount, params)) {
+				return;
+			}
+		}
+
+		// The scene viewport rasterized straight into the screen back-buffer and deferred its tiles to the tile
+		// renderer; drain them so the buffer holds the finished scene before it is read back and modified here. The
+		// HUD is dispatched after this Combine draw, so it is not affected (it re-defers and is flushed at present).
+		FlushSoftwareRenderer();
+		// The combine below modifies the buffer in place, the tiles remembered for it no longer match
+		SwTileRenderer::InvalidateTarget(fb.pixels);
+
+		// Main-thread-only like the whole Combine intercept, kept across frames to avoid reallocations
+		static std::vector<float> lightmap;
+		if (hasLighting) {
+			lightmap.resize(std::size_t(lmW) * lmH * 2);
+			SplatLights(lightmap.data(), 0, 0, lmW, lmH, light.AmbientLevel, light.Lights, nullptr, light.LightCount);
+		}
+
 		// Water precompute. This is the lightweight CPU replacement of the CombineWithWaterLow shader: a per-row
 		// horizontal sine displacement, the constant water tint mix(main, (0.4, 0.6, 0.8), 0.4), a surface glow
 		// band (0.2 * topGradient^2 plus 0.2 on the waterline row, approximated as a mix toward white instead of
@@ -587,8 +656,8 @@ namespace nCine::RHI::Software
 
 			if (hasLighting) {
 				const std::int32_t lmY = std::min(y / scale, lmH - 1);
-				const float* texelBase = light.Lightmap + (std::size_t)lmY * lmW * 2;
-				CombineLightingScanline(px, vpW, texelBase, lmW, scale, ambR, ambG, ambB);
+				const float* texelBase = lightmap.data() + (std::size_t)lmY * lmW * 2;
+				CombineLightingScanline(px, vpW, 0, texelBase, lmW, scale, ambR, ambG, ambB);
 			}
 
 			if (hasWater && !isUnderwaterRow && aboveWaterBlend[3] != 0) {
@@ -767,6 +836,8 @@ namespace nCine::RHI::Software
 					generatedShader.computeVaryings(uniformScratch, inst);
 				}
 				ctx.fragmentShader = generatedShader.fragment;
+				ctx.fragmentShader4 = generatedShader.fragment4;
+				ctx.fragmentShader8 = generatedShader.fragment8;
 				ctx.fragmentShaderUserData = uniformScratch;
 				ctx.fragmentShaderUserDataSize = uniformsSize;
 				ctx.blendingEnabled = blendOn;
@@ -782,6 +853,174 @@ namespace nCine::RHI::Software
 				runBegin = runEnd;
 			}
 		}
+
+		/**
+			Whole-layer submit of a tile-layer mesh (TileMapMesh / TileMapMeshPalette). Succeeds only when the
+			mesh is what TileMap::DrawLayer() writes for a pixel-aligned, unscaled layer: 32x32 quads on a common
+			grid, each showing one atlas tile 1:1 (optionally mirrored) with one vertex colour and at most
+			SwTileRenderer::MaxTileLayerAlphas distinct vertex alphas, blended with the SrcAlpha /
+			OneMinusSrcAlpha pair. The mesh then becomes a single SwTileRenderer::SubmitTileLayer() command.
+			Returns false for anything else (debris, a zoomed camera), which the caller draws quad by quad.
+		*/
+		bool SubmitTileMeshLayer(const float* vertices, std::int32_t quadCount, const float* mvp, const Recti& viewport,
+			std::int32_t fbHeight, const float* instanceColor, bool indexed, float paletteOffset, const SwTexture* atlas,
+			const SwTexture* palette, bool scissorEnabled, const Recti& scissorRect)
+		{
+			constexpr std::int32_t FloatsPerVertex = 8;
+			constexpr std::int32_t FloatsPerQuad = 6 * FloatsPerVertex;
+			constexpr std::int32_t CellSize = SwTileRenderer::TileLayerCellSize;
+			constexpr std::int32_t MaxCells = 65536;
+			constexpr float SnapEps = 1.0f / 128.0f;
+
+			if (atlas == nullptr || atlas->GetWidth() <= 0 || atlas->GetHeight() <= 0 || quadCount <= 0 ||
+			    mvp[3] != 0.0f || mvp[7] != 0.0f || mvp[15] != 1.0f) {
+				return false;
+			}
+			const float texW = float(atlas->GetWidth());
+			const float texH = float(atlas->GetHeight());
+
+			// The screen position the rasterizer's vertex fetch would give a mesh vertex, if it lands on a pixel corner
+			auto toPixel = [&](const float* p, std::int32_t& x, std::int32_t& y) {
+				const float cx = mvp[0] * p[0] + mvp[4] * p[1] + mvp[12];
+				const float cy = mvp[1] * p[0] + mvp[5] * p[1] + mvp[13];
+				const float sx = (cx + 1.0f) * 0.5f * float(viewport.W) + float(viewport.X);
+				const float sy = (1.0f - cy) * 0.5f * float(viewport.H) + float(viewport.Y);
+				const float rx = std::round(sx);
+				const float ry = std::round(sy);
+				if (std::fabs(sx - rx) >= SnapEps || std::fabs(sy - ry) >= SnapEps) {
+					return false;
+				}
+				x = std::int32_t(rx);
+				y = std::int32_t(ry);
+				return true;
+			};
+			// The atlas texel a texture coordinate starts at, if it lies on a texel corner
+			auto toTexel = [](float uv, float size, std::int32_t& texel) {
+				const float t = uv * size;
+				const float rt = std::round(t);
+				if (std::fabs(t - rt) >= 1.0f / 256.0f) {
+					return false;
+				}
+				texel = std::int32_t(rt);
+				return true;
+			};
+
+			struct QuadCell
+			{
+				std::int32_t x, y;
+				SwTileRenderer::TileLayerCell cell;
+			};
+			// Main-thread-only like the rest of the dispatch, kept across frames to avoid reallocations
+			static std::vector<QuadCell> quadCells;
+			static std::vector<SwTileRenderer::TileLayerCell> cells;
+			quadCells.resize(std::size_t(quadCount));
+
+			SwTileRenderer::TileLayerParams params = {};
+			std::int32_t minX = 0, minY = 0, maxX = 0, maxY = 0;
+			for (std::int32_t i = 0; i < quadCount; i++) {
+				const float* q = vertices + std::size_t(i) * FloatsPerQuad;
+				const float* v0 = q;
+				const float* v1 = q + FloatsPerVertex;
+				const float* v2 = q + 2 * FloatsPerVertex;
+				const float* v5 = q + 5 * FloatsPerVertex;
+				// An axis-aligned rectangle in TileMap::AppendTileQuad() order with one colour for all six vertices
+				if (std::memcmp(v0, q + 3 * FloatsPerVertex, FloatsPerVertex * sizeof(float)) != 0 ||
+				    std::memcmp(v2, q + 4 * FloatsPerVertex, FloatsPerVertex * sizeof(float)) != 0 ||
+				    v1[0] != v2[0] || v1[1] != v0[1] || v5[0] != v0[0] || v5[1] != v2[1] ||
+				    v1[2] != v2[2] || v1[3] != v0[3] || v5[2] != v0[2] || v5[3] != v2[3] ||
+				    std::memcmp(v0 + 4, v1 + 4, 4 * sizeof(float)) != 0 || std::memcmp(v0 + 4, v2 + 4, 4 * sizeof(float)) != 0 ||
+				    std::memcmp(v0 + 4, v5 + 4, 4 * sizeof(float)) != 0) {
+					return false;
+				}
+
+				// Exactly one cell on screen, and one atlas tile mapped 1:1 onto it
+				std::int32_t x0, y0, x2, y2;
+				if (!toPixel(v0, x0, y0) || !toPixel(v2, x2, y2) || std::abs(x2 - x0) != CellSize || std::abs(y2 - y0) != CellSize) {
+					return false;
+				}
+				std::int32_t u0, t0, u2, t2;
+				if (!toTexel(v0[2], texW, u0) || !toTexel(v0[3], texH, t0) || !toTexel(v2[2], texW, u2) || !toTexel(v2[3], texH, t2)) {
+					return false;
+				}
+				// Texels along the screen axes, starting at the left / top screen edge
+				const std::int32_t du = (x2 > x0 ? u2 - u0 : u0 - u2);
+				const std::int32_t dv = (y2 > y0 ? t2 - t0 : t0 - t2);
+				if (std::abs(du) != CellSize || std::abs(dv) != CellSize) {
+					return false;
+				}
+
+				QuadCell& quad = quadCells[i];
+				quad.x = std::min(x0, x2);
+				quad.y = std::min(y0, y2);
+				quad.cell.srcX = std::min(u0, u2);
+				quad.cell.srcY = std::min(t0, t2);
+				quad.cell.flags = std::uint8_t((du < 0 ? SwTileRenderer::TileLayerFlipX : 0) | (dv < 0 ? SwTileRenderer::TileLayerFlipY : 0));
+
+				if (i == 0) {
+					params.color[0] = instanceColor[0] * v0[4];
+					params.color[1] = instanceColor[1] * v0[5];
+					params.color[2] = instanceColor[2] * v0[6];
+					params.color[3] = instanceColor[3];
+					minX = maxX = quad.x;
+					minY = maxY = quad.y;
+				} else if (instanceColor[0] * v0[4] != params.color[0] || instanceColor[1] * v0[5] != params.color[1] ||
+				           instanceColor[2] * v0[6] != params.color[2] ||
+				           ((quad.x - minX) % CellSize) != 0 || ((quad.y - minY) % CellSize) != 0) {
+					return false;
+				}
+				minX = std::min(minX, quad.x);
+				minY = std::min(minY, quad.y);
+				maxX = std::max(maxX, quad.x);
+				maxY = std::max(maxY, quad.y);
+
+				std::int32_t alphaIndex = 0;
+				while (alphaIndex < params.alphaCount && params.alphas[alphaIndex] != v0[7]) {
+					alphaIndex++;
+				}
+				if (alphaIndex == params.alphaCount) {
+					if (params.alphaCount == SwTileRenderer::MaxTileLayerAlphas) {
+						return false;
+					}
+					params.alphas[params.alphaCount++] = v0[7];
+				}
+				quad.cell.alphaIndex = std::uint8_t(alphaIndex);
+			}
+
+			params.columns = (maxX - minX) / CellSize + 1;
+			params.rows = (maxY - minY) / CellSize + 1;
+			if (std::int64_t(params.columns) * params.rows > MaxCells) {
+				return false;
+			}
+			cells.assign(std::size_t(params.columns) * params.rows, SwTileRenderer::TileLayerCell{ -1, -1, 0, 0 });
+			for (const QuadCell& quad : quadCells) {
+				SwTileRenderer::TileLayerCell& cell = cells[((quad.y - minY) / CellSize) * params.columns + (quad.x - minX) / CellSize];
+				if (cell.srcX >= 0) {
+					return false;	// Overlapping quads, the later one would have to be drawn over the earlier one
+				}
+				cell = quad.cell;
+			}
+
+			params.atlas = atlas;
+			params.indexed = indexed;
+			params.palette = palette;
+			params.paletteOffset = paletteOffset;
+			params.originX = minX;
+			params.originY = minY;
+			params.cells = cells.data();
+			params.clipMinX = viewport.X;
+			params.clipMinY = viewport.Y;
+			params.clipMaxX = viewport.X + viewport.W - 1;
+			params.clipMaxY = viewport.Y + viewport.H - 1;
+			if (scissorEnabled) {
+				// nCine hands scissor rectangles in bottom-up (OpenGL) window coordinates, the layer clips top-down
+				const std::int32_t scissorY = fbHeight - scissorRect.Y - scissorRect.H;
+				params.clipMinX = std::max(params.clipMinX, scissorRect.X);
+				params.clipMinY = std::max(params.clipMinY, scissorY);
+				params.clipMaxX = std::min(params.clipMaxX, scissorRect.X + scissorRect.W - 1);
+				params.clipMaxY = std::min(params.clipMaxY, scissorY + scissorRect.H - 1);
+			}
+			return SwTileRenderer::SubmitTileLayer(params);
+		}
 	}
 
 	void SwDevice::Dispatch(PrimitiveType primitive, std::int32_t firstVertex, std::int32_t numVertices)
@@ -928,20 +1167,22 @@ namespace nCine::RHI::Software
 		// procedural sprite quad (vertexData stays null, so FetchVertex synthesizes the four corners from ff).
 		// userDataSize is the byte size of the block userData points at, so the tile renderer can snapshot it
 		// when the draw is deferred (its storage is caller-stack memory); pass 0 when there is no callback.
-		auto drawQuad = [&](const FFState& ff, FragmentShaderFn fragmentShader, void* userData, std::uint32_t userDataSize) {
+		auto drawQuad = [&](const FFState& ff, FragmentShaderFn fragmentShader, FragmentShader4Fn fragmentShader4, FragmentShader8Fn fragmentShader8, void* userData, std::uint32_t userDataSize) {
 			DrawContext ctx;
 			for (std::uint32_t u = 0; u < MaxTextureUnits; u++) {
 				ctx.textures[u] = _boundTextures[u];
 			}
 			ctx.ff = ff;
 			ctx.fragmentShader = fragmentShader;
+			ctx.fragmentShader4 = fragmentShader4;
+			ctx.fragmentShader8 = fragmentShader8;
 			ctx.fragmentShaderUserData = userData;
 			ctx.fragmentShaderUserDataSize = userDataSize;
 			// PaletteRemap(+Batched) draws qualify for the tile renderer's palette-LUT fast path (the
 			// classified effect guarantees the fragment is the transpiled PaletteRemap one, whose parameter
 			// block is a single vPaletteOffset float); the remaining constraints are validated at build time
-			ctx.paletteRemapHint = ((effect == SwEffect::PaletteRemap || effect == SwEffect::BatchedPaletteRemap) &&
-				fragmentShader != nullptr && userData != nullptr);
+			ctx.paletteRemapHint = ((effect == SwEffect::PaletteRemap || effect == SwEffect::BatchedPaletteRemap ||
+				effect == SwEffect::TileMapMeshPalette) && fragmentShader != nullptr && userData != nullptr);
 			// The no-texture sprite family's fragment is packColor(vColor) - a per-draw constant - so the
 			// tile renderer may evaluate it once and run its constant-color fill/blend scanline path
 			ctx.constantColorHint = ((effect == SwEffect::DefaultSpriteNoTexture || effect == SwEffect::DefaultBatchedSpritesNoTexture) &&
@@ -1056,7 +1297,7 @@ namespace nCine::RHI::Software
 				if (generatedShader->computeVaryings != nullptr) {
 					generatedShader->computeVaryings(uniformScratch, inst);
 				}
-				drawQuad(ff, generatedShader->fragment, uniformScratch, uniformsSize);
+				drawQuad(ff, generatedShader->fragment, generatedShader->fragment4, generatedShader->fragment8, uniformScratch, uniformsSize);
 			}
 			SwRaster::ClearDrawContext();
 			return;
@@ -1082,7 +1323,7 @@ namespace nCine::RHI::Software
 					std::memcpy(ff.spriteSize, inst + kSpriteSizeOffset, sizeof(ff.spriteSize));
 					ff.hasTexture = true;
 					ff.textureUnit = uTextureUnit;
-					drawQuad(ff, nullptr, nullptr, 0);
+					drawQuad(ff, nullptr, nullptr, nullptr, nullptr, 0);
 				}
 				break;
 			}
@@ -1102,7 +1343,103 @@ namespace nCine::RHI::Software
 					std::memcpy(ff.color, inst + kColorOffset, sizeof(ff.color));
 					std::memcpy(ff.spriteSize, inst + kSpriteSizeNoTexOffset, sizeof(ff.spriteSize));
 					ff.hasTexture = false;
-					drawQuad(ff, noTexFragment, nullptr, 0);
+					drawQuad(ff, noTexFragment, nullptr, nullptr, nullptr, 0);
+				}
+				break;
+			}
+
+			case SwEffect::TileMapMesh:
+			case SwEffect::TileMapMeshPalette: {
+				// Whole tile layer as one triangle list of 32x32 quads (TileMap::DrawLayer() with TILEMAP_USE_SINGLE_DRAW),
+				// [x, y, u, v, r, g, b, a] per vertex, 6 vertices per quad, transformed by the instance's modelMatrix
+				constexpr std::int32_t FloatsPerVertex = 8;
+				const bool indexed = (effect == SwEffect::TileMapMeshPalette);
+				SwVertexFormat::Attribute* posAttr = _currentProgram->GetAttribute("aPosition");
+				if (primitive != PrimitiveType::Triangles || posAttr == nullptr || !posAttr->IsEnabled() || posAttr->GetVbo() == nullptr) {
+					LOGW("Skipped draw: Tile layer mesh is not a triangle list with vertex attributes");
+					break;
+				}
+				const SwBuffer* vbo = posAttr->GetVbo();
+				const std::uint8_t* vboData = vbo->HostData();
+				const std::int32_t stride = posAttr->GetStride();
+				const std::size_t posOff = std::size_t(posAttr->GetBaseOffset()) + reinterpret_cast<std::uintptr_t>(posAttr->GetPointer());
+				const std::int32_t quadCount = numVertices / 6;
+				if (vboData == nullptr || firstVertex < 0 || quadCount <= 0 || (stride != 0 && stride != FloatsPerVertex * sizeof(float)) ||
+				    (posOff % sizeof(float)) != 0 ||
+				    posOff + (std::size_t(firstVertex) + std::size_t(quadCount) * 6) * FloatsPerVertex * sizeof(float) > vbo->GetSize()) {
+					LOGW("Skipped draw: Vertex range exceeds the bound vertex buffer");
+					break;
+				}
+				const float* vertices = reinterpret_cast<const float*>(vboData + posOff) + std::size_t(firstVertex) * FloatsPerVertex;
+
+				const std::uint8_t* inst = blockData;
+				const float* instColor = reinterpret_cast<const float*>(inst + kColorOffset);
+				float palOffset;
+				std::memcpy(&palOffset, inst + kPaletteOffsetOffset, sizeof(palOffset));
+				float mvp[16];
+				Mat4Mul(pv, reinterpret_cast<const float*>(inst + kModelMatrixOffset), mvp);
+
+				const std::int32_t uTextureUnit = samplerUnit("uTexture", 0);
+				const SwTexture* atlas = GetBoundTexture(std::uint32_t(uTextureUnit));
+				const SwTexture* palette = (indexed ? GetBoundTexture(std::uint32_t(samplerUnit("uTexturePalette", 1))) : nullptr);
+				if (atlas == nullptr || atlas->GetPixels() == nullptr) {
+					LOGW("Skipped draw: No texture bound to the sampler unit");
+					break;
+				}
+
+				// A pixel-aligned layer becomes a single tile-renderer command, binned per screen tile
+				if (blendOn && bsrc == SwBlendFactor::SrcAlpha && bdst == SwBlendFactor::OneMinusSrcAlpha &&
+				    SubmitTileMeshLayer(vertices, quadCount, mvp, viewport, fb.height, instColor, indexed, palOffset,
+				                        atlas, palette, _scissor.Enabled, _scissor.Rect)) {
+					break;
+				}
+
+				// Anything else (debris, a zoomed or sub-pixel camera, additive blending) is drawn quad by quad, each
+				// quad as a procedural sprite whose model matrix spans the quad's two edges
+				const SwGeneratedShaderInfo* paletteShader = nullptr;
+				if (indexed) {
+					static const SwGeneratedShaderInfo* paletteRemapShader = FindGeneratedShader("PaletteRemap");
+					paletteShader = paletteRemapShader;
+					if (paletteShader == nullptr || paletteShader->uniformsSize > MaxFragmentShaderUserDataSize) {
+						LOGW("Skipped draw: No transpiled palette remap fragment");
+						break;
+					}
+				}
+				std::uint8_t uniformScratch[MaxFragmentShaderUserDataSize];
+				if (paletteShader != nullptr) {
+					std::memset(uniformScratch, 0, paletteShader->uniformsSize);
+					if (paletteShader->computeVaryings != nullptr) {
+						paletteShader->computeVaryings(uniformScratch, inst);
+					}
+				}
+				for (std::int32_t i = 0; i < quadCount; i++) {
+					const float* v0 = vertices + std::size_t(i) * 6 * FloatsPerVertex;
+					const float* v1 = v0 + FloatsPerVertex;
+					const float* v5 = v0 + 5 * FloatsPerVertex;
+					const float quad[16] = {
+						v1[0] - v0[0], v1[1] - v0[1], 0.0f, 0.0f,
+						v5[0] - v0[0], v5[1] - v0[1], 0.0f, 0.0f,
+						0.0f, 0.0f, 1.0f, 0.0f,
+						v0[0], v0[1], 0.0f, 1.0f
+					};
+					FFState ff;
+					Mat4Mul(mvp, quad, ff.mvpMatrix);
+					for (std::int32_t c = 0; c < 4; c++) {
+						ff.color[c] = v0[4 + c] * instColor[c];
+					}
+					ff.texRect[0] = v1[2] - v0[2];
+					ff.texRect[1] = v0[2];
+					ff.texRect[2] = v5[3] - v0[3];
+					ff.texRect[3] = v0[3];
+					ff.spriteSize[0] = 1.0f;
+					ff.spriteSize[1] = 1.0f;
+					ff.hasTexture = true;
+					ff.textureUnit = uTextureUnit;
+					if (paletteShader != nullptr) {
+						drawQuad(ff, paletteShader->fragment, paletteShader->fragment4, paletteShader->fragment8, uniformScratch, paletteShader->uniformsSize);
+					} else {
+						drawQuad(ff, nullptr, nullptr, nullptr, nullptr, 0);
+					}
 				}
 				break;
 			}
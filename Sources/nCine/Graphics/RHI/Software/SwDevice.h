@@ -12,6 +12,7 @@ namespace nCine::RHI::Software
 	class SwShaderProgram;
 	class SwRenderTarget;
 	class SwTexture;
+	struct SwLight;
 
 	/**
 		@brief Destination framebuffer the device presents and resolves draws into
@@ -193,6 +194,18 @@ namespace nCine::RHI::Software
 		*/
 		static void FlushSoftwareRenderer();
 
+		/**
+			@brief Finishes the frame and returns the screen buffer to present
+
+			With a pipelined tile renderer (see @ref SwTileRenderer::IsPipelined()), the screen back-buffer is
+			double-buffered: the finished frame's deferred draws are handed to the worker threads and the next
+			frame is rendered into the other buffer in the meantime, so the returned buffer is the previous,
+			already completed frame (one frame of latency). Otherwise it's equivalent to
+			@ref FlushSoftwareRenderer() followed by @ref GetScreenFramebuffer(). The returned pixels stay valid
+			until the next call.
+		*/
+		static Framebuffer PresentSoftwareRenderer();
+
 		/**
 			@brief Ends the presented frame, dropping any per-frame device state
 
@@ -204,21 +217,25 @@ namespace nCine::RHI::Software
 		static void EndFrame();
 
 		/**
-			@brief Queues a dynamic lightmap to be composited over a viewport during the next matching Combine draw
+			@brief Queues dynamic lights to be composited over a viewport during the next matching Combine draw
 
 			Software-lighting entry point used by the viewport compositor (@c Jazz2::Rendering::CombineRenderer). The
 			scene renders straight to the screen buffer with no shader post-processing, so the dynamic lighting is
-			applied on the CPU here instead: the compositor builds the half-resolution lightmap in the Visit
-			(queue-building) phase and calls this, then the Combine draw it queues is intercepted in @ref Dispatch()
-			during the later Draw phase - after the scene has been rasterized into the screen buffer and before the
-			HUD - where the map is blended in place over the viewport rectangle. Entries are consumed
-			first-in-first-out, one per Combine draw, so splitscreen viewports each receive their own map in
-			submission order.
-
-			@param lightmap  Half-resolution accumulation buffer, 2 floats per texel (R = intensity incl. the ambient
-			                 base, G = brightness core), row-major. Caller-owned; must stay valid until the matching
-			                 Combine draw is dispatched (the compositor keeps it in a per-viewport member).
-			@param lmW       Lightmap width in texels
+			applied on the CPU here instead: the compositor collects the lights in the Visit (queue-building) phase
+			and calls this, then the Combine draw it queues is intercepted in @ref Dispatch() during the later Draw
+			phase - after the scene has been submitted to the screen buffer and before the HUD. Without water, the
+			combine is deferred into the tile renderer, which evaluates the half-resolution lightmap and blends it
+			tile by tile on its workers; the water effect shifts whole rows, so with water in view the scene is
+			flushed and the lightmap is evaluated and blended in place over the viewport rectangle here. Entries are
+			consumed first-in-first-out, one per Combine draw, so splitscreen viewports each receive their own
+			lights in submission order.
+
+			@param lights    Lights in lightmap space (see @ref SwLight), summed in this order. Caller-owned; must stay
+			                 valid until the matching Combine draw is dispatched (the compositor keeps them in a
+			                 per-viewport member).
+			@param lightCount    Number of lights
+			@param ambientLevel  Lightmap intensity where no light reaches
+			@param lmW       Lightmap width in texels, `0` for a water-only combine (fully lit scene)
 			@param lmH       Lightmap height in texels
 			@param scale     Lightmap-to-screen downscale factor (a screen pixel samples texel `pixel / scale`)
 			@param vpX       Viewport left in screen-buffer pixels
@@ -230,13 +247,13 @@ namespace nCine::RHI::Software
 			@param ambB      Ambient colour blue the unlit scene is blended toward
 			@param waterActive   Whether the waterline is inside this viewport - enables the lightweight per-row
 			                     water effect (the CPU replacement of the CombineWithWater shader variants). With
-			                     water active, @p lightmap may be `nullptr` for a water-only combine (fully lit scene).
+			                     water active, @p lmW may be `0` for a water-only combine (fully lit scene).
 			@param waterLevelPx  Waterline position in viewport-local pixels from the TOP edge (the shader path's
 			                     `viewWaterLevel`); may be negative when the whole viewport is underwater
 			@param waterTime     Wave animation time, the shader path's `uTime` (elapsed frames * 0.0018)
 			@param waterCamY     Camera world-space Y, anchors the per-row wave phase to the world while scrolling
 		*/
-		static void SetPendingSoftwareLighting(const float* lightmap, std::int32_t lmW, std::int32_t lmH, std::int32_t scale,
+		static void SetPendingSoftwareLighting(const SwLight* lights, std::int32_t lightCount, float ambientLevel, std::int32_t lmW, std::int32_t lmH, std::int32_t scale,
 			std::int32_t vpX, std::int32_t vpY, std::int32_t vpW, std::int32_t vpH, float ambR, float ambG, float ambB,
 			bool waterActive = false, float waterLevelPx = 0.0f, float waterTime = 0.0f, float waterCamY = 0.0f);
 
@@ -265,13 +282,17 @@ namespace nCine::RHI::Software
 		static std::int32_t _defaultFbWidth;
 		static std::int32_t _defaultFbHeight;
 		static std::int32_t _defaultFbStride;
-		/** @brief Backend-owned pixel store for the screen back-buffer (only used by the present path) */
-		static std::vector<std::uint8_t> _screenPixels;
+		/** @brief Backend-owned pixel stores for the screen back-buffer (only used by the present path, the second one when pipelined) */
+		static std::vector<std::uint8_t> _screenPixels[2];
+		/** @brief Index of the store in @ref _screenPixels the current frame is rendered into */
+		static std::int32_t _screenBufferIndex;
 
 		/** @brief One queued software-lighting/water combine, submitted by the compositor and applied at the next Combine draw */
 		struct PendingSoftwareLight
 		{
-			const float* Lightmap = nullptr;
+			const SwLight* Lights = nullptr;
+			std::int32_t LightCount = 0;
+			float AmbientLevel = 1.0f;
 			std::int32_t LmW = 0, LmH = 0, Scale = 1;
 			std::int32_t VpX = 0, VpY = 0, VpW = 0, VpH = 0;
 			float AmbR = 0.0f, AmbG = 0.0f, AmbB = 0.0f;
@@ -285,7 +306,7 @@ namespace nCine::RHI::Software
 		static bool ResolveFramebuffer(Framebuffer& out);
 		/** @brief Runs the correct C++ effect for the bound program over the given draw range (@p firstVertex indexes the bound vertex buffer; only the vertex-attribute mesh path consumes it) */
 		static void Dispatch(PrimitiveType primitive, std::int32_t firstVertex, std::int32_t numVertices);
-		/** @brief Consumes the front queued software combine (lightmap and/or water effect) and blends it in place over its viewport rectangle */
+		/** @brief Consumes the front queued software combine (lighting and/or water effect), defers it into the tile renderer or blends it in place over its viewport rectangle */
 		static void ApplyPendingSoftwareLighting();
 	};
 }
@@ -966,19 +966,21 @@ namespace nCine::RHI::Software
 	// The SSE2 variant processes 4 pixels per step with the scalar float operations replayed in the
 	// same order per 4-wide lane, so its output is bit-identical to the scalar loop: a fully lit lane
 	// computes (px / 255) * 1 + 0 whose re-quantization is exact for every byte, and the alpha lane
-	// is carried through the transpose untouched. Only a scalar fallback exists for NEON/WASM (the
-	// combine runs on dark levels only; those targets keep the previous per-pixel cost).
+	// is carried through the transpose untouched. The NEON variant (AArch64 only, it needs the vector
+	// division) keeps each pixel in one vector instead and restores the alpha lane with a bit select.
+	// WASM keeps the scalar loop.
 	// =====================================================================
-	extern void DEATH_CPU_DISPATCHED_DECLARATION(combineLightingScanline)(std::uint8_t* DEATH_RESTRICT px, std::int32_t width, const float* DEATH_RESTRICT lmRow, std::int32_t lmW, std::int32_t scale, float ambR, float ambG, float ambB);
+	extern void DEATH_CPU_DISPATCHED_DECLARATION(combineLightingScanline)(std::uint8_t* DEATH_RESTRICT px, std::int32_t width, std::int32_t startX, const float* DEATH_RESTRICT lmRow, std::int32_t lmW, std::int32_t scale, float ambR, float ambG, float ambB);
 	DEATH_CPU_DISPATCHER_DECLARATION(combineLightingScanline)
 
 	namespace
 	{
 		// Scalar fallback: the exact per-pixel loop the device ran inline before
 		DEATH_CPU_MAYBE_UNUSED typename std::decay<decltype(combineLightingScanline)>::type combineLightingScanlineImplementation(Cpu::ScalarT) {
-			return [](std::uint8_t* DEATH_RESTRICT px, std::int32_t width, const float* DEATH_RESTRICT lmRow, std::int32_t lmW, std::int32_t scale, float ambR, float ambG, float ambB) {
+			return [](std::uint8_t* DEATH_RESTRICT px, std::int32_t width, std::int32_t startX, const float* DEATH_RESTRICT lmRow, std::int32_t lmW, std::int32_t scale, float ambR, float ambG, float ambB) {
+				const std::int32_t lmBase = startX / scale;
 				for (std::int32_t x = 0; x < width; x++, px += 4) {
-					const std::int32_t lmX = std::min(x / scale, lmW - 1);
+					const std::int32_t lmX = std::min((startX + x) / scale, lmW - 1) - lmBase;
 					const float r = std::clamp(lmRow[lmX * 2], 0.0f, 1.0f);
 					const float g = std::clamp(lmRow[lmX * 2 + 1], 0.0f, 1.0f);
 					const float darkT = std::clamp(1.0f - r, 0.0f, 1.0f);
@@ -1002,7 +1004,7 @@ namespace nCine::RHI::Software
 
 #if defined(DEATH_ENABLE_SSE2)
 		DEATH_CPU_MAYBE_UNUSED DEATH_ENABLE_SSE2 typename std::decay<decltype(combineLightingScanline)>::type combineLightingScanlineImplementation(Cpu::Sse2T) {
-			return [](std::uint8_t* DEATH_RESTRICT px, std::int32_t width, const float* DEATH_RESTRICT lmRow, std::int32_t lmW, std::int32_t scale, float ambR, float ambG, float ambB) DEATH_ENABLE_SSE2 {
+			return [](std::uint8_t* DEATH_RESTRICT px, std::int32_t width, std::int32_t startX, const float* DEATH_RESTRICT lmRow, std::int32_t lmW, std::int32_t scale, float ambR, float ambG, float ambB) DEATH_ENABLE_SSE2 {
 				const __m128 zerof = _mm_setzero_ps();
 				const __m128 onef = _mm_set1_ps(1.0f);
 				const __m128 halff = _mm_set1_ps(0.5f);
@@ -1020,19 +1022,21 @@ namespace nCine::RHI::Software
 					while ((1 << shift) < scale) shift++;
 				}
 				const std::int32_t lmLast = lmW - 1;
+				const std::int32_t lmBase = startX / scale;
 
 				std::int32_t x = 0;
 				for (; x + 4 <= width; x += 4, px += 16) {
+					const std::int32_t sx = startX + x;
 					std::int32_t i0, i1, i2, i3;
 					if (shift >= 0) {
-						i0 = (x) >> shift; i1 = (x + 1) >> shift; i2 = (x + 2) >> shift; i3 = (x + 3) >> shift;
+						i0 = (sx) >> shift; i1 = (sx + 1) >> shift; i2 = (sx + 2) >> shift; i3 = (sx + 3) >> shift;
 					} else {
-						i0 = (x) / scale; i1 = (x + 1) / scale; i2 = (x + 2) / scale; i3 = (x + 3) / scale;
+						i0 = (sx) / scale; i1 = (sx + 1) / scale; i2 = (sx + 2) / scale; i3 = (sx + 3) / scale;
 					}
-					if (i0 > lmLast) i0 = lmLast;
-					if (i1 > lmLast) i1 = lmLast;
-					if (i2 > lmLast) i2 = lmLast;
-					if (i3 > lmLast) i3 = lmLast;
+					i0 = std::min(i0, lmLast) - lmBase;
+					i1 = std::min(i1, lmLast) - lmBase;
+					i2 = std::min(i2, lmLast) - lmBase;
+					i3 = std::min(i3, lmLast) - lmBase;
 
 					__m128 r = _mm_setr_ps(lmRow[i0 * 2], lmRow[i1 * 2], lmRow[i2 * 2], lmRow[i3 * 2]);
 					__m128 g = _mm_setr_ps(lmRow[i0 * 2 + 1], lmRow[i1 * 2 + 1], lmRow[i2 * 2 + 1], lmRow[i3 * 2 + 1]);
@@ -1079,7 +1083,96 @@ namespace nCine::RHI::Software
 				}
 				// Scalar tail
 				for (; x < width; x++, px += 4) {
-					const std::int32_t lmX = std::min(x / scale, lmW - 1);
+					const std::int32_t lmX = std::min((startX + x) / scale, lmW - 1) - lmBase;
+					const float r = std::clamp(lmRow[lmX * 2], 0.0f, 1.0f);
+					const float g = std::clamp(lmRow[lmX * 2 + 1], 0.0f, 1.0f);
+					const float darkT = std::clamp(1.0f - r, 0.0f, 1.0f);
+					if (darkT <= 0.0f && g <= 0.0f) {
+						continue;
+					}
+					const float lit = 1.0f + g;
+					const float core = (g > 0.7f ? g - 0.7f : 0.0f);
+					float cr = (px[0] / 255.0f) * lit + core;
+					float cg = (px[1] / 255.0f) * lit + core;
+					float cb = (px[2] / 255.0f) * lit + core;
+					cr += (ambR - cr) * darkT;
+					cg += (ambG - cg) * darkT;
+					cb += (ambB - cb) * darkT;
+					px[0] = (std::uint8_t)std::clamp(cr * 255.0f + 0.5f, 0.0f, 255.0f);
+					px[1] = (std::uint8_t)std::clamp(cg * 255.0f + 0.5f, 0.0f, 255.0f);
+					px[2] = (std::uint8_t)std::clamp(cb * 255.0f + 0.5f, 0.0f, 255.0f);
+				}
+			};
+		}
+#endif
+
+#if defined(DEATH_ENABLE_NEON) && !defined(DEATH_TARGET_32BIT)
+		DEATH_CPU_MAYBE_UNUSED DEATH_ENABLE_NEON typename std::decay<decltype(combineLightingScanline)>::type combineLightingScanlineImplementation(Cpu::NeonT) {
+			return [](std::uint8_t* DEATH_RESTRICT px, std::int32_t width, std::int32_t startX, const float* DEATH_RESTRICT lmRow, std::int32_t lmW, std::int32_t scale, float ambR, float ambG, float ambB) DEATH_ENABLE_NEON {
+				const float32x4_t zerof = vdupq_n_f32(0.0f);
+				const float32x4_t onef = vdupq_n_f32(1.0f);
+				const float32x4_t halff = vdupq_n_f32(0.5f);
+				const float32x4_t c255f = vdupq_n_f32(255.0f);
+				const float32x4_t coreT = vdupq_n_f32(0.7f);
+				const float ambient[4] = { ambR, ambG, ambB, 0.0f };
+				const float32x4_t vAmb = vld1q_f32(ambient);
+				// Selects the alpha lane, which is carried over from the loaded pixel
+				static const std::uint32_t alphaLane[4] = { 0, 0, 0, 0xFFFFFFFFu };
+				const uint32x4_t alphaMask = vld1q_u32(alphaLane);
+
+				const std::int32_t lmLast = lmW - 1;
+				const std::int32_t lmBase = startX / scale;
+
+				std::int32_t x = 0;
+				for (; x + 4 <= width; x += 4, px += 16) {
+					float rs[4], gs[4];
+					for (std::int32_t k = 0; k < 4; k++) {
+						const std::int32_t lmX = std::min((startX + x + k) / scale, lmLast) - lmBase;
+						rs[k] = lmRow[lmX * 2];
+						gs[k] = lmRow[lmX * 2 + 1];
+					}
+					const float32x4_t r = vminq_f32(vmaxq_f32(vld1q_f32(rs), zerof), onef);
+					const float32x4_t g = vminq_f32(vmaxq_f32(vld1q_f32(gs), zerof), onef);
+					const float32x4_t darkT = vminq_f32(vmaxq_f32(vsubq_f32(onef, r), zerof), onef);
+
+					// Per-4-pixel early out (the block form of the scalar per-pixel fully-lit skip)
+					if (vmaxvq_u32(vorrq_u32(vcgtq_f32(darkT, zerof), vcgtq_f32(g, zerof))) == 0) {
+						continue;
+					}
+
+					const float32x4_t lit = vaddq_f32(onef, g);
+					const float32x4_t core = vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(vsubq_f32(g, coreT)), vcgtq_f32(g, coreT)));
+
+					// Each pixel stays in its own vector (R, G, B, A lanes), the per-pixel factors are broadcast
+					const uint8x16_t pix = vld1q_u8(px);
+					const uint16x8_t lo16 = vmovl_u8(vget_low_u8(pix));
+					const uint16x8_t hi16 = vmovl_high_u8(pix);
+					float32x4_t p[4] = {
+						vcvtq_f32_u32(vmovl_u16(vget_low_u16(lo16))),
+						vcvtq_f32_u32(vmovl_high_u16(lo16)),
+						vcvtq_f32_u32(vmovl_u16(vget_low_u16(hi16))),
+						vcvtq_f32_u32(vmovl_high_u16(hi16))
+					};
+					float32x4_t c[4];
+#define SW_COMBINE_PIXEL(k) \
+					c[k] = vaddq_f32(vmulq_f32(vdivq_f32(p[k], c255f), vdupq_laneq_f32(lit, k)), vdupq_laneq_f32(core, k)); \
+					c[k] = vaddq_f32(c[k], vmulq_f32(vsubq_f32(vAmb, c[k]), vdupq_laneq_f32(darkT, k))); \
+					c[k] = vminq_f32(vmaxq_f32(vaddq_f32(vmulq_f32(c[k], c255f), halff), zerof), c255f); \
+					c[k] = vbslq_f32(alphaMask, p[k], c[k]);
+					SW_COMBINE_PIXEL(0)
+					SW_COMBINE_PIXEL(1)
+					SW_COMBINE_PIXEL(2)
+					SW_COMBINE_PIXEL(3)
+#undef SW_COMBINE_PIXEL
+
+					// Values are in [0, 255], the truncating convert and the narrowing moves are lossless
+					const uint16x8_t q01 = vcombine_u16(vmovn_u32(vcvtq_u32_f32(c[0])), vmovn_u32(vcvtq_u32_f32(c[1])));
+					const uint16x8_t q23 = vcombine_u16(vmovn_u32(vcvtq_u32_f32(c[2])), vmovn_u32(vcvtq_u32_f32(c[3])));
+					vst1q_u8(px, vcombine_u8(vmovn_u16(q01), vmovn_u16(q23)));
+				}
+				// Scalar tail
+				for (; x < width; x++, px += 4) {
+					const std::int32_t lmX = std::min((startX + x) / scale, lmLast) - lmBase;
 					const float r = std::clamp(lmRow[lmX * 2], 0.0f, 1.0f);
 					const float g = std::clamp(lmRow[lmX * 2 + 1], 0.0f, 1.0f);
 					const float darkT = std::clamp(1.0f - r, 0.0f, 1.0f);
@@ -1105,8 +1198,234 @@ namespace nCine::RHI::Software
 	}
 
 	DEATH_CPU_DISPATCHER_BASE(combineLightingScanlineImplementation)
-	DEATH_CPU_DISPATCHED(combineLightingScanlineImplementation, void DEATH_CPU_DISPATCHED_DECLARATION(combineLightingScanline)(std::uint8_t* DEATH_RESTRICT px, std::int32_t width, const float* DEATH_RESTRICT lmRow, std::int32_t lmW, std::int32_t scale, float ambR, float ambG, float ambB))({
-		return combineLightingScanlineImplementation(Cpu::DefaultBase)(px, width, lmRow, lmW, scale, ambR, ambG, ambB);
+	DEATH_CPU_DISPATCHED(combineLightingScanlineImplementation, void DEATH_CPU_DISPATCHED_DECLARATION(combineLightingScanline)(std::uint8_t* DEATH_RESTRICT px, std::int32_t width, std::int32_t startX, const float* DEATH_RESTRICT lmRow, std::int32_t lmW, std::int32_t scale, float ambR, float ambG, float ambB))({
+		return combineLightingScanlineImplementation(Cpu::DefaultBase)(px, width, startX, lmRow, lmW, scale, ambR, ambG, ambB);
+	})
+
+	// =====================================================================
+	// CPU-dispatched light splat row (see SwScanlineOps.h)
+	// The falloff is evaluated for 4 texels per step; texels outside the radius get a zero contribution
+	// through the mask instead of a branch, which adds nothing to their sum. Division and square root are
+	// correctly rounded in SSE2 and AArch64 NEON alike, so every lane computes the scalar value.
+	// =====================================================================
+	extern void DEATH_CPU_DISPATCHED_DECLARATION(splatLightScanline)(float* DEATH_RESTRICT lmRow, std::int32_t x, std::int32_t count, const SwLight& light, float dy);
+	DEATH_CPU_DISPATCHER_DECLARATION(splatLightScanline)
+
+	namespace
+	{
+		DEATH_CPU_MAYBE_UNUSED inline void SplatLightScanlineScalar(float* DEATH_RESTRICT lmRow, std::int32_t x, std::int32_t count, const SwLight& light, float dy)
+		{
+			const float denom = 1.0f - light.RadiusNearNorm;
+			for (std::int32_t i = 0; i < count; i++, lmRow += 2) {
+				const float dx = ((x + i) - light.CenterX) / light.Radius;
+				// About a fifth of the bounding box lies outside the circle - reject on the squared distance
+				// so those texels never pay for the square root
+				const float dist2 = dx * dx + dy * dy;
+				if (dist2 > 1.0f) {
+					continue;
+				}
+				const float dist = std::sqrt(dist2);
+				float t = (denom > 0.0f ? 1.0f - ((dist - light.RadiusNearNorm) / denom) : 1.0f);
+				t = std::clamp(t, 0.0f, 1.0f);
+				const float strength = t * t * t;
+				lmRow[0] += strength * light.Intensity;
+				lmRow[1] += strength * light.Brightness;
+			}
+		}
+
+		DEATH_CPU_MAYBE_UNUSED typename std::decay<decltype(splatLightScanline)>::type splatLightScanlineImplementation(Cpu::ScalarT) {
+			return [](float* DEATH_RESTRICT lmRow, std::int32_t x, std::int32_t count, const SwLight& light, float dy) {
+				SplatLightScanlineScalar(lmRow, x, count, light, dy);
+			};
+		}
+
+#if defined(DEATH_ENABLE_SSE2)
+		DEATH_CPU_MAYBE_UNUSED DEATH_ENABLE_SSE2 typename std::decay<decltype(splatLightScanline)>::type splatLightScanlineImplementation(Cpu::Sse2T) {
+			return [](float* DEATH_RESTRICT lmRow, std::int32_t x, std::int32_t count, const SwLight& light, float dy) DEATH_ENABLE_SSE2 {
+				const float denom = 1.0f - light.RadiusNearNorm;
+				const __m128 zerof = _mm_setzero_ps();
+				const __m128 onef = _mm_set1_ps(1.0f);
+				const __m128 vCenterX = _mm_set1_ps(light.CenterX);
+				const __m128 vRadius = _mm_set1_ps(light.Radius);
+				const __m128 vDy2 = _mm_set1_ps(dy * dy);
+				const __m128 vNear = _mm_set1_ps(light.RadiusNearNorm);
+				const __m128 vDenom = _mm_set1_ps(denom);
+				const __m128 vIntensity = _mm_set1_ps(light.Intensity);
+				const __m128 vBrightness = _mm_set1_ps(light.Brightness);
+
+				std::int32_t i = 0;
+				__m128i xi = _mm_add_epi32(_mm_set1_epi32(x), _mm_setr_epi32(0, 1, 2, 3));
+				for (; i + 4 <= count; i += 4, lmRow += 8, xi = _mm_add_epi32(xi, _mm_set1_epi32(4))) {
+					const __m128 dx = _mm_div_ps(_mm_sub_ps(_mm_cvtepi32_ps(xi), vCenterX), vRadius);
+					const __m128 dist2 = _mm_add_ps(_mm_mul_ps(dx, dx), vDy2);
+					const __m128 inside = _mm_cmple_ps(dist2, onef);
+					if (_mm_movemask_ps(inside) == 0) {
+						continue;
+					}
+					__m128 t = onef;
+					if (denom > 0.0f) {
+						t = _mm_sub_ps(onef, _mm_div_ps(_mm_sub_ps(_mm_sqrt_ps(dist2), vNear), vDenom));
+						t = _mm_min_ps(_mm_max_ps(t, zerof), onef);
+					}
+					const __m128 strength = _mm_and_ps(_mm_mul_ps(_mm_mul_ps(t, t), t), inside);
+					// Interleave back into (R, G) texel pairs
+					const __m128 addR = _mm_mul_ps(strength, vIntensity);
+					const __m128 addG = _mm_mul_ps(strength, vBrightness);
+					_mm_storeu_ps(lmRow, _mm_add_ps(_mm_loadu_ps(lmRow), _mm_unpacklo_ps(addR, addG)));
+					_mm_storeu_ps(lmRow + 4, _mm_add_ps(_mm_loadu_ps(lmRow + 4), _mm_unpackhi_ps(addR, addG)));
+				}
+				SplatLightScanlineScalar(lmRow, x + i, count - i, light, dy);
+			};
+		}
+#endif
+
+#if defined(DEATH_ENABLE_NEON) && !defined(DEATH_TARGET_32BIT)
+		DEATH_CPU_MAYBE_UNUSED DEATH_ENABLE_NEON typename std::decay<decltype(splatLightScanline)>::type splatLightScanlineImplementation(Cpu::NeonT) {
+			return [](float* DEATH_RESTRICT lmRow, std::int32_t x, std::int32_t count, const SwLight& light, float dy) DEATH_ENABLE_NEON {
+				const float denom = 1.0f - light.RadiusNearNorm;
+				const float32x4_t zerof = vdupq_n_f32(0.0f);
+				const float32x4_t onef = vdupq_n_f32(1.0f);
+				const float32x4_t vCenterX = vdupq_n_f32(light.CenterX);
+				const float32x4_t vRadius = vdupq_n_f32(light.Radius);
+				const float32x4_t vDy2 = vdupq_n_f32(dy * dy);
+				const float32x4_t vNear = vdupq_n_f32(light.RadiusNearNorm);
+				const float32x4_t vDenom = vdupq_n_f32(denom);
+				const float32x4_t vIntensity = vdupq_n_f32(light.Intensity);
+				const float32x4_t vBrightness = vdupq_n_f32(light.Brightness);
+				static const std::int32_t laneOffsets[4] = { 0, 1, 2, 3 };
+
+				std::int32_t i = 0;
+				int32x4_t xi = vaddq_s32(vdupq_n_s32(x), vld1q_s32(laneOffsets));
+				for (; i + 4 <= count; i += 4, lmRow += 8, xi = vaddq_s32(xi, vdupq_n_s32(4))) {
+					const float32x4_t dx = vdivq_f32(vsubq_f32(vcvtq_f32_s32(xi), vCenterX), vRadius);
+					const float32x4_t dist2 = vaddq_f32(vmulq_f32(dx, dx), vDy2);
+					const uint32x4_t inside = vcleq_f32(dist2, onef);
+					if (vmaxvq_u32(inside) == 0) {
+						continue;
+					}
+					float32x4_t t = onef;
+					if (denom > 0.0f) {
+						t = vsubq_f32(onef, vdivq_f32(vsubq_f32(vsqrtq_f32(dist2), vNear), vDenom));
+						t = vminq_f32(vmaxq_f32(t, zerof), onef);
+					}
+					const float32x4_t strength = vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(vmulq_f32(vmulq_f32(t, t), t)), inside));
+					// Interleave back into (R, G) texel pairs
+					const float32x4x2_t add = vzipq_f32(vmulq_f32(strength, vIntensity), vmulq_f32(strength, vBrightness));
+					vst1q_f32(lmRow, vaddq_f32(vld1q_f32(lmRow), add.val[0]));
+					vst1q_f32(lmRow + 4, vaddq_f32(vld1q_f32(lmRow + 4), add.val[1]));
+				}
+				SplatLightScanlineScalar(lmRow, x + i, count - i, light, dy);
+			};
+		}
+#endif
+	}
+
+	DEATH_CPU_DISPATCHER_BASE(splatLightScanlineImplementation)
+	DEATH_CPU_DISPATCHED(splatLightScanlineImplementation, void DEATH_CPU_DISPATCHED_DECLARATION(splatLightScanline)(float* DEATH_RESTRICT lmRow, std::int32_t x, std::int32_t count, const SwLight& light, float dy))({
+		return splatLightScanlineImplementation(Cpu::DefaultBase)(lmRow, x, count, light, dy);
+	})
+
+	// =====================================================================
+	// CPU-dispatched fragment-shader scanline (see SwScanlineOps.h)
+	// The SSE2/NEON variants hand runs of 4 pixels to the transpiled 4-wide kernel, which is built for the
+	// baseline ISA of the target (SSE2 on x86, NEON on AArch64, plain arrays elsewhere) with the scalar one.
+	// The AVX2 variant first hands runs of 8 pixels to the 8-wide kernel, which is compiled for AVX2 only.
+	// The per-pixel texture coordinate is computed with the same expression for all of them, so they shade
+	// identically; the remainder of the scanline (and every pixel of a shader without a wide kernel) stays scalar.
+	// =====================================================================
+	extern void DEATH_CPU_DISPATCHED_DECLARATION(shadeScanline)(FragmentShaderFn fragment, FragmentShader4Fn fragment4, FragmentShader8Fn fragment8, FragmentShaderInput& input, std::uint8_t* buf, std::int32_t count, std::int32_t txFix, std::int32_t dtxFix, float invTexW);
+	DEATH_CPU_DISPATCHER_DECLARATION(shadeScanline)
+
+	namespace
+	{
+		DEATH_CPU_MAYBE_UNUSED void ShadeScanlineScalar(FragmentShaderFn fragment, FragmentShaderInput& input, std::uint8_t* buf, std::int32_t count, std::int32_t txFix, std::int32_t dtxFix, float invTexW)
+		{
+			const std::int32_t x0 = input.x;
+			for (std::int32_t i = 0; i < count; i++) {
+				input.rgba = &buf[i * 4];
+				input.u = txFix / 65536.0f * invTexW;
+				input.x = x0 + i;
+				fragment(input);
+				txFix += dtxFix;
+			}
+		}
+
+		/** Shades runs of @p Lanes pixels with @p fragmentN, returns the number of pixels shaded */
+		template<class Input, class Fn, std::int32_t Lanes>
+		DEATH_CPU_MAYBE_UNUSED std::int32_t ShadeScanlineRuns(Fn fragmentN, const FragmentShaderInput& input, std::uint8_t* buf, std::int32_t count, std::int32_t& txFix, std::int32_t dtxFix, float invTexW)
+		{
+			Input inputN;
+			inputN.y = input.y;
+			inputN.texWidth = input.texWidth;
+			inputN.texHeight = input.texHeight;
+			inputN.textures = input.textures;
+			inputN.color = input.color;
+			inputN.userData = input.userData;
+			for (std::int32_t k = 0; k < Lanes; k++) {
+				inputN.v[k] = input.v;
+			}
+			std::int32_t i = 0;
+			for (; i + Lanes <= count; i += Lanes) {
+				inputN.rgba = &buf[i * 4];
+				inputN.x = input.x + i;
+				for (std::int32_t k = 0; k < Lanes; k++) {
+					inputN.u[k] = txFix / 65536.0f * invTexW;
+					txFix += dtxFix;
+				}
+				fragmentN(inputN);
+			}
+			return i;
+		}
+
+		DEATH_CPU_MAYBE_UNUSED void ShadeScanlineWide(FragmentShaderFn fragment, FragmentShader4Fn fragment4, FragmentShader8Fn fragment8, FragmentShaderInput& input, std::uint8_t* buf, std::int32_t count, std::int32_t txFix, std::int32_t dtxFix, float invTexW)
+		{
+			std::int32_t i = 0;
+			if (fragment8 != nullptr && count >= 8) {
+				i = ShadeScanlineRuns<FragmentShaderInput8, FragmentShader8Fn, 8>(fragment8, input, buf, count, txFix, dtxFix, invTexW);
+			}
+			if (fragment4 != nullptr && count - i >= 4) {
+				FragmentShaderInput tail = input;
+				tail.x += i;
+				i += ShadeScanlineRuns<FragmentShaderInput4, FragmentShader4Fn, 4>(fragment4, tail, buf + i * 4, count - i, txFix, dtxFix, invTexW);
+			}
+			input.x += i;
+			ShadeScanlineScalar(fragment, input, buf + i * 4, count - i, txFix, dtxFix, invTexW);
+		}
+
+		DEATH_CPU_MAYBE_UNUSED typename std::decay<decltype(shadeScanline)>::type shadeScanlineImplementation(Cpu::ScalarT) {
+			return [](FragmentShaderFn fragment, FragmentShader4Fn, FragmentShader8Fn, FragmentShaderInput& input, std::uint8_t* buf, std::int32_t count, std::int32_t txFix, std::int32_t dtxFix, float invTexW) {
+				ShadeScanlineScalar(fragment, input, buf, count, txFix, dtxFix, invTexW);
+			};
+		}
+
+#if defined(DEATH_ENABLE_SSE2)
+		DEATH_CPU_MAYBE_UNUSED DEATH_ENABLE_SSE2 typename std::decay<decltype(shadeScanline)>::type shadeScanlineImplementation(Cpu::Sse2T) {
+			return [](FragmentShaderFn fragment, FragmentShader4Fn fragment4, FragmentShader8Fn, FragmentShaderInput& input, std::uint8_t* buf, std::int32_t count, std::int32_t txFix, std::int32_t dtxFix, float invTexW) DEATH_ENABLE_SSE2 {
+				ShadeScanlineWide(fragment, fragment4, nullptr, input, buf, count, txFix, dtxFix, invTexW);
+			};
+		}
+#endif
+
+#if defined(DEATH_ENABLE_AVX2)
+		DEATH_CPU_MAYBE_UNUSED DEATH_ENABLE_AVX2 typename std::decay<decltype(shadeScanline)>::type shadeScanlineImplementation(Cpu::Avx2T) {
+			return [](FragmentShaderFn fragment, FragmentShader4Fn fragment4, FragmentShader8Fn fragment8, FragmentShaderInput& input, std::uint8_t* buf, std::int32_t count, std::int32_t txFix, std::int32_t dtxFix, float invTexW) DEATH_ENABLE_AVX2 {
+				ShadeScanlineWide(fragment, fragment4, fragment8, input, buf, count, txFix, dtxFix, invTexW);
+			};
+		}
+#endif
+
+#if defined(DEATH_ENABLE_NEON)
+		DEATH_CPU_MAYBE_UNUSED DEATH_ENABLE_NEON typename std::decay<decltype(shadeScanline)>::type shadeScanlineImplementation(Cpu::NeonT) {
+			return [](FragmentShaderFn fragment, FragmentShader4Fn fragment4, FragmentShader8Fn, FragmentShaderInput& input, std::uint8_t* buf, std::int32_t count, std::int32_t txFix, std::int32_t dtxFix, float invTexW) DEATH_ENABLE_NEON {
+				ShadeScanlineWide(fragment, fragment4, nullptr, input, buf, count, txFix, dtxFix, invTexW);
+			};
+		}
+#endif
+	}
+
+	DEATH_CPU_DISPATCHER_BASE(shadeScanlineImplementation)
+	DEATH_CPU_DISPATCHED(shadeScanlineImplementation, void DEATH_CPU_DISPATCHED_DECLARATION(shadeScanline)(FragmentShaderFn fragment, FragmentShader4Fn fragment4, FragmentShader8Fn fragment8, FragmentShaderInput& input, std::uint8_t* buf, std::int32_t count, std::int32_t txFix, std::int32_t dtxFix, float invTexW))({
+		return shadeScanlineImplementation(Cpu::DefaultBase)(fragment, fragment4, fragment8, input, buf, count, txFix, dtxFix, invTexW);
 	})
 
 	// Externally-visible entry points (see SwScanlineOps.h) so the tile rasterizer TU runs the exact same
@@ -1131,10 +1450,49 @@ namespace nCine::RHI::Software
 		blendScanlineConstSrcAlpha(dst, count, src);
 	}
 
-	void CombineLightingScanline(std::uint8_t* px, std::int32_t width, const float* lmRow, std::int32_t lmW,
+	void CombineLightingScanline(std::uint8_t* px, std::int32_t width, std::int32_t startX, const float* lmRow, std::int32_t lmW,
 		std::int32_t scale, float ambR, float ambG, float ambB)
 	{
-		combineLightingScanline(px, width, lmRow, lmW, scale, ambR, ambG, ambB);
+		combineLightingScanline(px, width, startX, lmRow, lmW, scale, ambR, ambG, ambB);
+	}
+
+	void SplatLightScanline(float* lmRow, std::int32_t x, std::int32_t count, const SwLight& light, float dy)
+	{
+		splatLightScanline(lmRow, x, count, light, dy);
+	}
+
+	void SplatLights(float* block, std::int32_t blockX, std::int32_t blockY, std::int32_t blockW, std::int32_t blockH,
+		float ambientLevel, const SwLight* lights, const std::uint16_t* indices, std::int32_t count)
+	{
+		// R (intensity) starts at the ambient level everywhere, G (brightness core) at zero
+		const std::size_t texelCount = (std::size_t)blockW * blockH;
+		for (std::size_t i = 0; i < texelCount; i++) {
+			block[i * 2] = ambientLevel;
+			block[i * 2 + 1] = 0.0f;
+		}
+
+		const std::int32_t blockMaxX = blockX + blockW - 1;
+		const std::int32_t blockMaxY = blockY + blockH - 1;
+		for (std::int32_t i = 0; i < count; i++) {
+			const SwLight& light = lights[indices != nullptr ? indices[i] : i];
+			const std::int32_t x0 = std::max(light.MinX, blockX);
+			const std::int32_t x1 = std::min(light.MaxX, blockMaxX);
+			const std::int32_t y0 = std::max(light.MinY, blockY);
+			const std::int32_t y1 = std::min(light.MaxY, blockMaxY);
+			if (x0 > x1 || y0 > y1) {
+				continue;
+			}
+			for (std::int32_t y = y0; y <= y1; y++) {
+				const float dy = (y - light.CenterY) / light.Radius;
+				splatLightScanline(block + ((std::size_t)(y - blockY) * blockW + (x0 - blockX)) * 2, x0, x1 - x0 + 1, light, dy);
+			}
+		}
+	}
+
+	void ShadeScanline(FragmentShaderFn fragment, FragmentShader4Fn fragment4, FragmentShader8Fn fragment8, FragmentShaderInput& input,
+		std::uint8_t* buf, std::int32_t count, std::int32_t txFix, std::int32_t dtxFix, float invTexW)
+	{
+		shadeScanline(fragment, fragment4, fragment8, input, buf, count, txFix, dtxFix, invTexW);
 	}
 
 	// =========================================================================
@@ -1495,6 +1853,7 @@ namespace nCine::RHI::Software
 			// Flush any pending deferred draws first, so this opaque full-screen blit (which bypasses the
 			// tile queue and writes the buffer directly) lands after everything submitted before it.
 			SwTileRenderer::Flush();
+			SwTileRenderer::InvalidateTarget(dstBuffer);
 
 			// Y-flip needed when source and destination have different row orders:
 			// - FBO textures/buffers are stored bottom-up (row 0 = bottom)
@@ -1819,16 +2178,10 @@ namespace nCine::RHI::Software
 						fsInput.textures = ctx.textures;
 						fsInput.color = ctx.ff.color;
 						fsInput.userData = ctx.fragmentShaderUserData;
+						fsInput.x = xMin;
+						fsInput.y = py;
 						const float invTexW = 1.0f / static_cast<float>(texW > 0 ? texW : 1);
-						std::int32_t txFixShader = txBase;
-						for (std::int32_t i = 0; i < scanWidth; i++) {
-							fsInput.rgba = &scanBuf[i * 4];
-							fsInput.u = txFixShader / 65536.0f * invTexW;
-							fsInput.x = xMin + i;
-							fsInput.y = py;
-							ctx.fragmentShader(fsInput);
-							txFixShader += dtxFix;
-						}
+						ShadeScanline(ctx.fragmentShader, ctx.fragmentShader4, ctx.fragmentShader8, fsInput, scanBuf, scanWidth, txBase, dtxFix, invTexW);
 					} else if DEATH_UNLIKELY(!whiteTint) {
 						tintScanline(scanBuf, scanWidth, tR, tG, tB, tA);
 					}
@@ -2780,16 +3133,31 @@ namespace nCine::RHI::Software
 			return;
 		}
 
-		// A full-buffer clear wipes everything drawn before it, so drop any deferred draws still queued for
-		// this surface rather than letting them re-render on top of the cleared buffer at the next flush.
-		if (SwTileRenderer::GetPendingCommandCount() > 0) {
-			SwTileRenderer::DiscardPending();
-		}
-
 		const std::uint8_t rb = static_cast<std::uint8_t>(r * 255.0f);
 		const std::uint8_t gb = static_cast<std::uint8_t>(g * 255.0f);
 		const std::uint8_t bb = static_cast<std::uint8_t>(b * 255.0f);
 		const std::uint8_t ab = static_cast<std::uint8_t>(a * 255.0f);
+
+		// Let the tile renderer apply the clear per tile at the next flush instead of touching the whole buffer
+		// now. It also drops any deferred draws still queued for this surface, which the clear wipes anyway.
+		const std::uint32_t pattern = static_cast<std::uint32_t>(rb)
+			| (static_cast<std::uint32_t>(gb) << 8)
+			| (static_cast<std::uint32_t>(bb) << 16)
+			| (static_cast<std::uint32_t>(ab) << 24);
+		if (SwTileRenderer::SubmitClear(pattern)) {
+			return;
+		}
+
+		if (SwTileRenderer::GetPendingCommandCount() > 0) {
+			SwTileRenderer::DiscardPending();
+		}
+		// Render-target textures may still be sampled by the previous frame that is rendered asynchronously,
+		// the screen buffer only has to wait when it's the one being rendered into
+		if (g_state.isFboTarget || SwTileRenderer::IsAsyncFlushTarget(g_state.colorBuffer)) {
+			SwTileRenderer::WaitForAsyncFlush();
+		}
+		SwTileRenderer::InvalidateTarget(g_state.colorBuffer);
+
 		const std::int32_t totalPixels = g_state.bufferWidth * g_state.bufferHeight;
 #if defined(RHI_USE_FB16)
 		if (g_state.is16Bit) {
@@ -2817,11 +3185,7 @@ namespace nCine::RHI::Software
 			// All channels identical: single memset
 			std::memset(g_state.colorBuffer, rb, static_cast<std::size_t>(totalPixels) * 4);
 		} else {
-			// Build 32-bit RGBA pattern and fill using 32-bit writes
-			const std::uint32_t pattern = static_cast<std::uint32_t>(rb)
-				| (static_cast<std::uint32_t>(gb) << 8)
-				| (static_cast<std::uint32_t>(bb) << 16)
-				| (static_cast<std::uint32_t>(ab) << 24);
+			// Fill using 32-bit writes of the RGBA pattern
 			std::uint32_t* dst32 = reinterpret_cast<std::uint32_t*>(g_state.colorBuffer);
 			for (std::int32_t i = 0; i < totalPixels; ++i) {
 				dst32[i] = pattern;
@@ -2869,6 +3233,8 @@ namespace nCine::RHI::Software
 			}
 			SwTileRenderer::Flush();
 		}
+		// The immediate paths below write the buffer behind the tile renderer's back
+		SwTileRenderer::InvalidateTarget(g_state.colorBuffer);
 
 		// Fast path: procedural 4-vertex quad (TriangleStrip, no vertex buffer)
 		if DEATH_LIKELY(type == PrimitiveType::TriangleStrip && count == 4 && firstVertex == 0 &&
@@ -2898,6 +3264,16 @@ namespace nCine::RHI::Software
 	{
 		SwTileRenderer::Flush();
 	}
+
+	void SwRaster::FlushAsync()
+	{
+		SwTileRenderer::FlushAsync();
+	}
+
+	void SwRaster::WaitForAsyncFlush()
+	{
+		SwTileRenderer::WaitForAsyncFlush();
+	}
 }
 
 #endif
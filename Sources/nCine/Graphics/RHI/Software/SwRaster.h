@@ -107,6 +107,42 @@ namespace nCine::RHI::Software
 	/** @brief Optional per-pixel fragment callback; runs after sampling, before blending */
 	using FragmentShaderFn = void (*)(const FragmentShaderInput& input);
 
+	/**
+		@brief Inputs of four horizontally adjacent pixels handed to a 4-wide fragment callback
+
+		The same as @ref FragmentShaderInput, but @ref rgba points at four consecutive pixels (16 bytes) and
+		the texture coordinates are given per pixel. @ref x is the destination coordinate of the first pixel,
+		the others follow it on the same row @ref y.
+	*/
+	struct FragmentShaderInput4
+	{
+		std::uint8_t* rgba;					/**< In/out colors of the four pixels (16 bytes, RGBA order) */
+		float u[4], v[4];					/**< Interpolated texture coordinates of each pixel */
+		std::int32_t x, y;					/**< Destination coordinates of the first pixel */
+		std::int32_t texWidth, texHeight;	/**< Dimensions of the primary (unit `ff.textureUnit`) texture */
+		const SwTexture* const* textures;	/**< The bound textures (@ref MaxTextureUnits entries) */
+		const float* color;					/**< Instance color (4 floats, RGBA) */
+		void* userData;						/**< Effect-owned parameter block, opaque to the rasterizer */
+	};
+
+	/** @brief Optional 4-wide fragment callback, shades four pixels exactly like four calls of the scalar one */
+	using FragmentShader4Fn = void (*)(const FragmentShaderInput4& input);
+
+	/** @brief Inputs of eight horizontally adjacent pixels handed to an 8-wide fragment callback, see @ref FragmentShaderInput4 */
+	struct FragmentShaderInput8
+	{
+		std::uint8_t* rgba;					/**< In/out colors of the eight pixels (32 bytes, RGBA order) */
+		float u[8], v[8];					/**< Interpolated texture coordinates of each pixel */
+		std::int32_t x, y;					/**< Destination coordinates of the first pixel */
+		std::int32_t texWidth, texHeight;	/**< Dimensions of the primary (unit `ff.textureUnit`) texture */
+		const SwTexture* const* textures;	/**< The bound textures (@ref MaxTextureUnits entries) */
+		const float* color;					/**< Instance color (4 floats, RGBA) */
+		void* userData;						/**< Effect-owned parameter block, opaque to the rasterizer */
+	};
+
+	/** @brief Optional 8-wide (AVX2) fragment callback, shades eight pixels exactly like eight calls of the scalar one */
+	using FragmentShader8Fn = void (*)(const FragmentShaderInput8& input);
+
 #if defined(RHI_USE_FB16)
 	/**
 		@brief Packs one 4-byte RGBA working pixel into an RGB565 framebuffer texel (alpha is dropped)
@@ -390,6 +426,32 @@ namespace nCine::RHI::Software
 		bool allOpaque;
 	};
 
+	/**
+		@brief One light of the software dynamic-lighting combine, in lightmap space
+
+		Filled by the compositor from the frame's light emitters and evaluated per texel of the reduced-resolution
+		lightmap by @ref SplatLights(): a texel within @ref Radius of the center receives `t^3 * Intensity` and
+		`t^3 * Brightness`, with `t` the cubic falloff of `lightBlend()` in `LightingFs.inc`. The inclusive texel
+		bounding box is clamped to the lightmap and only limits the work, the distance test decides coverage.
+	*/
+	struct SwLight
+	{
+		/** @brief Center X in lightmap texels */
+		float CenterX;
+		/** @brief Center Y in lightmap texels */
+		float CenterY;
+		/** @brief Outer radius in lightmap texels */
+		float Radius;
+		/** @brief Inner radius divided by the outer one, full strength inside it */
+		float RadiusNearNorm;
+		/** @brief Intensity added to the R channel (non-negative) */
+		float Intensity;
+		/** @brief Brightness added to the G channel (non-negative) */
+		float Brightness;
+		/** @brief Inclusive texel bounding box */
+		std::int32_t MinX, MinY, MaxX, MaxY;
+	};
+
 	/**
 		@brief One transformed screen-space vertex
 
@@ -420,6 +482,20 @@ namespace nCine::RHI::Software
 		FFState ff;
 		/** @brief Optional per-pixel fragment callback (null for the plain textured / tinted path) */
 		FragmentShaderFn fragmentShader = nullptr;
+		/**
+		 * @brief Optional 4-wide variant of @ref fragmentShader
+		 *
+		 * Used for runs of at least four pixels along a scanline when the CPU supports the wide path, the
+		 * remaining pixels still go through @ref fragmentShader. Must be null if @ref fragmentShader is null.
+		 */
+		FragmentShader4Fn fragmentShader4 = nullptr;
+		/**
+		 * @brief Optional 8-wide variant of @ref fragmentShader
+		 *
+		 * Used before @ref fragmentShader4 for runs of at least eight pixels when the CPU supports AVX2.
+		 * Must be null if @ref fragmentShader4 is null.
+		 */
+		FragmentShader8Fn fragmentShader8 = nullptr;
 		/** @brief Opaque parameter block passed to @ref fragmentShader */
 		void* fragmentShaderUserData = nullptr;
 		/**
@@ -531,6 +607,17 @@ namespace nCine::RHI::Software
 			it does not return until every worker thread has finished writing.
 		*/
 		static void Flush();
+
+		/**
+			@brief Starts rendering the deferred draws on the worker threads and returns immediately
+
+			Used at present when the next frame is rendered into a different surface. The current color buffer
+			and the textures sampled by the queued draws must not be touched until @ref WaitForAsyncFlush().
+		*/
+		static void FlushAsync();
+
+		/** @brief Waits until the draws started by @ref FlushAsync() have landed in their color buffer */
+		static void WaitForAsyncFlush();
 	};
 }
 
@@ -2,6 +2,8 @@
 
 #if defined(WITH_RHI_SOFTWARE)
 
+#include "SwRaster.h"
+
 #include <cstdint>
 
 namespace nCine::RHI::Software
@@ -41,16 +43,49 @@ namespace nCine::RHI::Software
 	/**
 	 * @brief Applies the dynamic-lighting combine to one row of screen pixels
 	 *
-	 * The per-row core of @ref SwDevice::ApplyPendingSoftwareLighting(): for each pixel `x` it samples the
-	 * half-resolution lightmap row (`lmRow`, 2 floats per texel, indexed by `min(x / scale, lmW - 1)`),
-	 * clamps both channels to `[0, 1]` and composites in place:
+	 * The per-row core of @ref SwDevice::ApplyPendingSoftwareLighting() and of the tile renderer's lighting pass:
+	 * for each pixel `x` it samples the half-resolution lightmap row (`lmRow`, 2 floats per texel, indexed by
+	 * `min((startX + x) / scale, lmW - 1) - startX / scale`, so @p lmRow starts at the texel of @p startX, the
+	 * viewport-relative column of the first pixel), clamps both channels to `[0, 1]` and composites in place:
 	 * `lit = main * (1 + g) + max(g - 0.7, 0)`, then `out = mix(lit, ambient, clamp(1 - r, 0, 1))`.
 	 * A fully lit texel (`r >= 1`, `g <= 0`) leaves the pixel bytes untouched. The SIMD variants keep the
 	 * scalar float operations in the same order, so the output is bit-identical to the scalar loop
 	 * (fully lit lanes round-trip exactly; the alpha byte is rewritten with its own value).
 	 */
-	void CombineLightingScanline(std::uint8_t* px, std::int32_t width, const float* lmRow, std::int32_t lmW,
+	void CombineLightingScanline(std::uint8_t* px, std::int32_t width, std::int32_t startX, const float* lmRow, std::int32_t lmW,
 		std::int32_t scale, float ambR, float ambG, float ambB);
+
+	/**
+	 * @brief Adds one light to a run of lightmap texels of one row
+	 *
+	 * @p lmRow points at texel @p x (2 floats per texel), @p dy is `(y - light.CenterY) / light.Radius` of the
+	 * row. Texels outside the radius are left untouched. The SIMD variants evaluate 4 texels per step with the
+	 * scalar float operations in the same order, so they accumulate exactly the same values.
+	 */
+	void SplatLightScanline(float* lmRow, std::int32_t x, std::int32_t count, const SwLight& light, float dy);
+
+	/**
+	 * @brief Evaluates the lightmap texels of a rectangle from scratch
+	 *
+	 * Fills the `blockW * blockH` texels starting at (@p blockX, @p blockY) of the lightmap with
+	 * `(ambientLevel, 0)` and adds every light in order, either `lights[indices[i]]` or `lights[i]` when
+	 * @p indices is `nullptr`. Each texel sums the same lights in the same order wherever the rectangle lies,
+	 * so overlapping rectangles agree exactly.
+	 */
+	void SplatLights(float* block, std::int32_t blockX, std::int32_t blockY, std::int32_t blockW, std::int32_t blockH,
+		float ambientLevel, const SwLight* lights, const std::uint16_t* indices, std::int32_t count);
+
+	/**
+	 * @brief Runs a fragment callback over one scanline of sampled pixels
+	 *
+	 * `input` carries everything but the per-pixel fields, `input.x` is the first pixel. The texture
+	 * coordinate of pixel `i` is `(txFix + i * dtxFix) / 65536 * invTexW`. When @p fragment8 is not null
+	 * and the CPU has AVX2, runs of 8 pixels are shaded by it first. When @p fragment4 is not null and the
+	 * CPU has the SSE2/NEON lanes it was built for, the following runs of 4 pixels are shaded by it, and
+	 * only the remainder by @p fragment.
+	 */
+	void ShadeScanline(FragmentShaderFn fragment, FragmentShader4Fn fragment4, FragmentShader8Fn fragment8, FragmentShaderInput& input,
+		std::uint8_t* buf, std::int32_t count, std::int32_t txFix, std::int32_t dtxFix, float invTexW);
 }
 
 #endif
@@ -44,6 +44,8 @@ namespace nCine::RHI::Software
 			{ "TexturedBackgroundCircleDither", SwEffect::TexturedBackgroundCircle, true },
 			{ "PaletteRemap", SwEffect::PaletteRemap, false },
 			{ "BatchedPaletteRemap", SwEffect::BatchedPaletteRemap, false },
+			{ "TileMapMesh", SwEffect::TileMapMesh, false },
+			{ "TileMapMeshPalette", SwEffect::TileMapMeshPalette, false },
 		};
 
 		const EffectMapping* FindEffectMapping(const char* label)
@@ -73,6 +75,10 @@ namespace nCine::RHI::Software
 			if (Contains(label, "PaletteRemap")) {
 				return Contains(label, "Batched") ? SwEffect::BatchedPaletteRemap : SwEffect::PaletteRemap;
 			}
+			// Tile-layer mesh, with or without the palette remap
+			if (Contains(label, "TileMapMesh")) {
+				return Contains(label, "Palette") ? SwEffect::TileMapMeshPalette : SwEffect::TileMapMesh;
+			}
 			// Animated background (planar tunnel and its circular variant)
 			if (Contains(label, "TexturedBackground")) {
 				return Contains(label, "Circle") ? SwEffect::TexturedBackgroundCircle : SwEffect::TexturedBackground;
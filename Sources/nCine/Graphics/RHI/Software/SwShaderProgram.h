@@ -42,7 +42,9 @@ namespace nCine::RHI::Software
 		TexturedBackgroundCircle,	/**< The circular ("tube") variant of the textured background */
 		PaletteRemap,			/**< An R8/RG8 index sprite recolored through the shared palette texture */
 		BatchedPaletteRemap,	/**< The palette-remap effect over an array of batched instances */
-		Combine					/**< The viewport compositor (scene + lighting + blur + ambient) */
+		Combine,				/**< The viewport compositor (scene + lighting + blur + ambient) */
+		TileMapMesh,			/**< A whole tile layer (or debris group) as one mesh of textured quads */
+		TileMapMeshPalette		/**< The tile-layer mesh of an R8/RG8 index tileset, recolored through the palette */
 	};
 
 	/**
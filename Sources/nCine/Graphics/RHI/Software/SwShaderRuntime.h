@@ -11,18 +11,20 @@
 	types and free functions defined here: GLSL-shaped `vec2`/`vec3`/`vec4` (plus minimal integer and
 	boolean vectors), the arithmetic operators and the built-in functions the shader corpus uses, a
 	`swTexture()` sampler shim over @ref SwTexture and a `packColor()` writer to the rasterizer's RGBA8
-	output pixel.
+	output pixel. The wide counterparts (`vfloat`/`vvec2`/`vvec3`/`vvec4`/`vmask`) used by the
+	`<Program>_Fragment4` and `<Program>_Fragment8` kernels, which shade a run of adjacent pixels at once,
+	are at the end of the file.
 
 	Swizzle-access convention (chosen so the emitter never needs C++ lvalue swizzles):
 	- A single component is a plain field: `.x`/`.y`/`.z`/`.w`, aliased through a union to `.r`/`.g`/`.b`/`.a`
 	  and `.s`/`.t`/`.p`/`.q`. Because it is a real member it works as both a read and a write target, so
 	  the emitter maps `v.x` and an assignment `v.x = ...` straight through.
-	- A multi-component read swizzle (`v.rgb`, `v.xy`) is a const method the emitter calls: `v.rgb()`,
-	  `v.xy()`. The base is evaluated once and a fresh vector is returned. Only the common/contiguous
-	  swizzles are provided here (see the file tail) — the full permutation set is a
-	  mechanical later completion.
-	- A multi-component write swizzle (`v.xy = ...`) is NOT supported; the emitter would have to
-	  decompose it into per-component field writes. No corpus shader needs it yet.
+	- A multi-component read swizzle (`v.rgb`, `v.xy`) is a const method the emitter calls, always spelled
+	  with `xyzw` (`v.xyz()`, `v.xy()`), so the scalar and the wide vectors share one set of names. The base
+	  is evaluated once and a fresh vector is returned. Only the swizzles the shader corpus reads are
+	  provided here.
+	- A multi-component write swizzle (`v.xy = ...`) is decomposed by the emitter into one write per
+	  component of a temporary holding the value.
 */
 
 #if defined(WITH_RHI_SOFTWARE)
@@ -33,6 +35,16 @@
 
 #include <cmath>
 #include <cstdint>
+#include <cstring>
+
+#include <Cpu.h>
+
+// The 8-wide kernels are compiled only where the compiler can target AVX2 per function, they are selected
+// at runtime by the CPU dispatch of the rasterizer
+#if defined(DEATH_TARGET_X86) && defined(DEATH_ENABLE_AVX2)
+#	include <IntrinsicsAvx.h>
+#	define SW_WIDE8
+#endif
 
 // Anonymous structs inside a union give the .x/.r/.s aliasing; they are a well-supported extension
 // that MSVC flags only at /W4. Silence it just around the value types.
@@ -51,7 +63,7 @@ namespace nCine::RHI::Software::sw
 		@brief Two-component float vector mirroring GLSL `vec2`
 
 		Components are reachable as `.x`/`.y`, `.r`/`.g` or `.s`/`.t` (union-aliased); multi-component
-		read swizzles are const methods (@ref xy() etc.).
+		read swizzles are const methods spelled with `xyzw` (@ref xy() etc.).
 	*/
 	struct vec2
 	{
@@ -76,8 +88,10 @@ namespace nCine::RHI::Software::sw
 		vec2& operator/=(float o) { x /= o; y /= o; return *this; }
 
 		vec2 xy() const { return vec2(x, y); }
-		vec2 rg() const { return vec2(x, y); }
+		vec2 yx() const { return vec2(y, x); }
 		vec2 xx() const { return vec2(x, x); }
+		vec2 yy() const { return vec2(y, y); }
+		vec4 xyxy() const;
 	};
 
 	/**
@@ -108,10 +122,11 @@ namespace nCine::RHI::Software::sw
 		vec3& operator/=(float o) { x /= o; y /= o; z /= o; return *this; }
 
 		vec2 xy() const { return vec2(x, y); }
-		vec2 rg() const { return vec2(x, y); }
 		vec2 xx() const { return vec2(x, x); }
+		vec2 yy() const { return vec2(y, y); }
+		vec2 xz() const { return vec2(x, z); }
+		vec2 yz() const { return vec2(y, z); }
 		vec3 xyz() const { return vec3(x, y, z); }
-		vec3 rgb() const { return vec3(x, y, z); }
 	};
 
 	/**
@@ -145,21 +160,24 @@ namespace nCine::RHI::Software::sw
 		vec4& operator/=(float o) { x /= o; y /= o; z /= o; w /= o; return *this; }
 
 		vec2 xy() const { return vec2(x, y); }
-		vec2 rg() const { return vec2(x, y); }
 		vec2 xx() const { return vec2(x, x); }
+		vec2 yy() const { return vec2(y, y); }
+		vec2 xz() const { return vec2(x, z); }
+		vec2 yz() const { return vec2(y, z); }
+		vec2 yw() const { return vec2(y, w); }
 		vec2 zw() const { return vec2(z, w); }
-		vec2 ba() const { return vec2(z, w); }
 		vec3 xyz() const { return vec3(x, y, z); }
-		vec3 rgb() const { return vec3(x, y, z); }
 		vec3 yzw() const { return vec3(y, z, w); }
-		vec3 gba() const { return vec3(y, z, w); }
+		vec3 www() const { return vec3(w, w, w); }
 		vec4 xyzw() const { return vec4(x, y, z, w); }
-		vec4 rgba() const { return vec4(x, y, z, w); }
+		vec4 xyxy() const { return vec4(x, y, x, y); }
+		vec4 xxzz() const { return vec4(x, x, z, z); }
 	};
 
 	inline vec2::vec2(const vec3& v) : x(v.x), y(v.y) {}
 	inline vec2::vec2(const vec4& v) : x(v.x), y(v.y) {}
 	inline vec3::vec3(const vec4& v) : x(v.x), y(v.y), z(v.z) {}
+	inline vec4 vec2::xyxy() const { return vec4(x, y, x, y); }
 
 	// --- Arithmetic operators (component-wise, with scalar broadcast on either side) ---------------
 
@@ -211,25 +229,15 @@ namespace nCine::RHI::Software::sw
 
 	inline float radians(float d) { return d * 0.01745329251994329577f; }
 	inline float degrees(float r) { return r * 57.2957795130823208768f; }
-	inline float sin(float x) { return std::sin(x); }
-	inline float cos(float x) { return std::cos(x); }
-	inline float tan(float x) { return std::tan(x); }
-	inline float asin(float x) { return std::asin(x); }
-	inline float acos(float x) { return std::acos(x); }
-	inline float atan(float x) { return std::atan(x); }
-	inline float atan(float y, float x) { return std::atan2(y, x); }
-	inline float pow(float x, float y) { return std::pow(x, y); }
-	inline float exp2(float x) { return std::exp2(x); }
-	inline float log2(float x) { return std::log2(x); }
 	inline float sqrt(float x) { return std::sqrt(x); }
 	inline float inversesqrt(float x) { return 1.0f / std::sqrt(x); }
 	inline float abs(float x) { return std::fabs(x); }
 	inline float sign(float x) { return (x > 0.0f) ? 1.0f : (x < 0.0f ? -1.0f : 0.0f); }
 	inline float floor(float x) { return std::floor(x); }
 	inline float ceil(float x) { return std::ceil(x); }
-	inline float round(float x) { return std::floor(x + 0.5f); }		// GLSL round is unspecified at .5; match the shader idiom floor(x + 0.5)
-	inline float fract(float x) { return x - std::floor(x); }
-	inline float mod(float x, float y) { return x - y * std::floor(x / y); }
+	inline float round(float x) { return floor(x + 0.5f); }		// GLSL round is unspecified at .5; match the shader idiom floor(x + 0.5)
+	inline float fract(float x) { return x - floor(x); }
+	inline float mod(float x, float y) { return x - y * floor(x / y); }
 	inline float min(float x, float y) { return (x < y) ? x : y; }
 	inline float max(float x, float y) { return (x > y) ? x : y; }
 	inline float clamp(float x, float lo, float hi) { return (x < lo) ? lo : (x > hi ? hi : x); }
@@ -240,6 +248,49 @@ namespace nCine::RHI::Software::sw
 		return t * t * (3.0f - 2.0f * t);
 	}
 
+	namespace detail
+	{
+		inline float select(bool m, float a, float b) { return (m ? a : b); }
+
+		/** Multiplies @p x by `2^n` for an integral @p n in `[-126, 127]` */
+		inline float scaleByPow2(float x, float n)
+		{
+			std::int32_t bits = (static_cast<std::int32_t>(n) + 127) << 23;
+			float s;
+			std::memcpy(&s, &bits, sizeof(s));
+			return x * s;
+		}
+
+		/** Splits a positive normal @p x into its mantissa in `[1, 2)` (returned) and its exponent @p e */
+		inline float splitExponent(float x, float& e)
+		{
+			std::int32_t bits;
+			std::memcpy(&bits, &x, sizeof(bits));
+			e = static_cast<float>((bits >> 23) - 127);
+			bits = (bits & 0x007FFFFF) | 0x3F800000;
+			float m;
+			std::memcpy(&m, &bits, sizeof(m));
+			return m;
+		}
+
+#define SW_MATH_FLOAT float
+#define SW_MATH_FN inline
+#include "SwShaderRuntimeMath.h"
+	}
+
+	// The transcendental functions use the polynomials of SwShaderRuntimeMath.h rather than the C library,
+	// so the wide kernels below can evaluate the very same operations in vector registers
+	inline float sin(float x) { return detail::sinPoly(x); }
+	inline float cos(float x) { return detail::cosPoly(x); }
+	inline float tan(float x) { return detail::sinPoly(x) / detail::cosPoly(x); }
+	inline float asin(float x) { return detail::asinPoly(x); }
+	inline float acos(float x) { return detail::acosPoly(x); }
+	inline float atan(float x) { return detail::atanPoly(x); }
+	inline float atan(float y, float x) { return detail::atan2Poly(y, x); }
+	inline float pow(float x, float y) { return detail::powPoly(x, y); }
+	inline float exp2(float x) { return detail::exp2Poly(x); }
+	inline float log2(float x) { return detail::log2Poly(x); }
+
 	// Component-wise unary vector wrappers over the scalar built-ins
 #define SW_UNARY(func) \
 	inline vec2 func(const vec2& v) { return vec2(func(v.x), func(v.y)); } \
@@ -373,6 +424,97 @@ namespace nCine::RHI::Software::sw
 			const std::int32_t i = static_cast<std::int32_t>(f);
 			return (static_cast<float>(i) > f && i != INT32_MIN) ? i - 1 : i;
 		}
+
+		/** Body of @ref swTexture(), shared with the wide sampler below */
+		inline vec4 sampleTexture(const SwTexture* const* textures, int unit, const vec2& uv)
+		{
+			if (unit < 0 || unit >= static_cast<int>(MaxTextureUnits)) {
+				return vec4(0.0f);
+			}
+			const SwTexture* tex = textures[unit];
+			if (tex == nullptr) {
+				return vec4(0.0f);
+			}
+			const std::uint8_t* pixels = tex->GetPixels(0);
+			std::int32_t width = tex->GetWidth();
+			std::int32_t height = tex->GetHeight();
+			if (pixels == nullptr || width <= 0 || height <= 0) {
+				return vec4(0.0f);
+			}
+			std::int32_t stride = tex->GetStrideBytes();
+			const std::int32_t bpp = tex->GetBytesPerPixel();
+			std::int32_t tx = detail::wrapTexel(detail::floorToInt(uv.x * static_cast<float>(width)), width, tex->GetWrapS());
+			std::int32_t ty = detail::wrapTexel(detail::floorToInt(uv.y * static_cast<float>(height)), height, tex->GetWrapT());
+			const std::uint8_t* texel = pixels + static_cast<std::size_t>(ty) * static_cast<std::size_t>(stride) + static_cast<std::size_t>(tx) * bpp;
+			std::uint8_t expanded[4];
+			if (bpp != 4) {
+				expanded[0] = texel[0];
+				expanded[1] = (bpp >= 2 ? texel[1] : std::uint8_t(255));
+				expanded[2] = 255;
+				expanded[3] = 255;
+				texel = expanded;
+			}
+
+			// Honor the texture's sampling swizzle, exactly as GLSL texture() does. It is identity for normal
+			// textures, so a four-way compare short-circuits the per-channel switch on the hot path; only the
+			// palette-index RG8 textures take the generic remap below (their swizzle maps the sampled `.a` to
+			// the green channel - the packed per-pixel alpha - the same source the hand-ported palette effect
+			// reads. Without this the expanded texel's opaque byte-3 would drop that alpha).
+			//
+			// NOTE: the `/ 255.0f` byte normalization is kept verbatim (no reciprocal multiply, no lookup
+			// table): the Debug (/fp:precise) build compiles it as a true division while the Release
+			// (/fp:fast) build already rewrites it into `* (1/255)` on its own, and the two differ in the
+			// last bit for 126 of the 256 byte values - so any manual substitution would break bit-parity
+			// with the current output in one of the two float models.
+			const nCine::SwizzleChannel* swizzle = tex->GetSwizzle();
+			if (swizzle[0] == nCine::SwizzleChannel::Red && swizzle[1] == nCine::SwizzleChannel::Green &&
+			    swizzle[2] == nCine::SwizzleChannel::Blue && swizzle[3] == nCine::SwizzleChannel::Alpha) {
+				return vec4(texel[0] / 255.0f, texel[1] / 255.0f, texel[2] / 255.0f, texel[3] / 255.0f);
+			}
+			auto pickChannel = [texel](nCine::SwizzleChannel channel) -> float {
+				switch (channel) {
+					case nCine::SwizzleChannel::Red:	return texel[0] / 255.0f;
+					case nCine::SwizzleChannel::Green:	return texel[1] / 255.0f;
+					case nCine::SwizzleChannel::Blue:	return texel[2] / 255.0f;
+					case nCine::SwizzleChannel::Alpha:	return texel[3] / 255.0f;
+					case nCine::SwizzleChannel::Zero:	return 0.0f;
+					case nCine::SwizzleChannel::One:	return 1.0f;
+				}
+				return 0.0f;
+			};
+			return vec4(pickChannel(swizzle[0]), pickChannel(swizzle[1]), pickChannel(swizzle[2]), pickChannel(swizzle[3]));
+		}
+
+		/** Body of @ref swTexturePrimary(), shared with the wide sampler below */
+		inline vec4 readPrimaryTexel(const SwTexture* const* textures, int unit, const std::uint8_t* texel, float u, float v)
+		{
+			const SwTexture* tex = (unit >= 0 && unit < static_cast<int>(MaxTextureUnits) ? textures[unit] : nullptr);
+			if (tex != nullptr && tex->GetPixels(0) != nullptr) {
+				const std::int32_t width = tex->GetWidth();
+				const std::int32_t height = tex->GetHeight();
+				if (width > 0 && height > 0) {
+					// Same swizzle handling (and the same verbatim `/ 255.0f`) as sampleTexture above
+					const nCine::SwizzleChannel* swizzle = tex->GetSwizzle();
+					if (swizzle[0] == nCine::SwizzleChannel::Red && swizzle[1] == nCine::SwizzleChannel::Green &&
+					    swizzle[2] == nCine::SwizzleChannel::Blue && swizzle[3] == nCine::SwizzleChannel::Alpha) {
+						return vec4(texel[0] / 255.0f, texel[1] / 255.0f, texel[2] / 255.0f, texel[3] / 255.0f);
+					}
+					auto pickChannel = [texel](nCine::SwizzleChannel channel) -> float {
+						switch (channel) {
+							case nCine::SwizzleChannel::Red:	return texel[0] / 255.0f;
+							case nCine::SwizzleChannel::Green:	return texel[1] / 255.0f;
+							case nCine::SwizzleChannel::Blue:	return texel[2] / 255.0f;
+							case nCine::SwizzleChannel::Alpha:	return texel[3] / 255.0f;
+							case nCine::SwizzleChannel::Zero:	return 0.0f;
+							case nCine::SwizzleChannel::One:	return 1.0f;
+						}
+						return 0.0f;
+					};
+					return vec4(pickChannel(swizzle[0]), pickChannel(swizzle[1]), pickChannel(swizzle[2]), pickChannel(swizzle[3]));
+				}
+			}
+			return sampleTexture(textures, unit, vec2(u, v));
+		}
 	}
 
 	/**
@@ -386,61 +528,7 @@ namespace nCine::RHI::Software::sw
 	 */
 	inline vec4 swTexture(const FragmentShaderInput& in, int unit, const vec2& uv)
 	{
-		if (unit < 0 || unit >= static_cast<int>(MaxTextureUnits)) {
-			return vec4(0.0f);
-		}
-		const SwTexture* tex = in.textures[unit];
-		if (tex == nullptr) {
-			return vec4(0.0f);
-		}
-		const std::uint8_t* pixels = tex->GetPixels(0);
-		std::int32_t width = tex->GetWidth();
-		std::int32_t height = tex->GetHeight();
-		if (pixels == nullptr || width <= 0 || height <= 0) {
-			return vec4(0.0f);
-		}
-		std::int32_t stride = tex->GetStrideBytes();
-		const std::int32_t bpp = tex->GetBytesPerPixel();
-		std::int32_t tx = detail::wrapTexel(detail::floorToInt(uv.x * static_cast<float>(width)), width, tex->GetWrapS());
-		std::int32_t ty = detail::wrapTexel(detail::floorToInt(uv.y * static_cast<float>(height)), height, tex->GetWrapT());
-		const std::uint8_t* texel = pixels + static_cast<std::size_t>(ty) * static_cast<std::size_t>(stride) + static_cast<std::size_t>(tx) * bpp;
-		std::uint8_t expanded[4];
-		if (bpp != 4) {
-			expanded[0] = texel[0];
-			expanded[1] = (bpp >= 2 ? texel[1] : std::uint8_t(255));
-			expanded[2] = 255;
-			expanded[3] = 255;
-			texel = expanded;
-		}
-
-		// Honor the texture's sampling swizzle, exactly as GLSL texture() does. It is identity for normal
-		// textures, so a four-way compare short-circuits the per-channel switch on the hot path; only the
-		// palette-index RG8 textures take the generic remap below (their swizzle maps the sampled `.a` to
-		// the green channel - the packed per-pixel alpha - the same source the hand-ported palette effect
-		// reads. Without this the expanded texel's opaque byte-3 would drop that alpha).
-		//
-		// NOTE: the `/ 255.0f` byte normalization is kept verbatim (no reciprocal multiply, no lookup
-		// table): the Debug (/fp:precise) build compiles it as a true division while the Release
-		// (/fp:fast) build already rewrites it into `* (1/255)` on its own, and the two differ in the
-		// last bit for 126 of the 256 byte values - so any manual substitution would break bit-parity
-		// with the current output in one of the two float models.
-		const nCine::SwizzleChannel* swizzle = tex->GetSwizzle();
-		if (swizzle[0] == nCine::SwizzleChannel::Red && swizzle[1] == nCine::SwizzleChannel::Green &&
-		    swizzle[2] == nCine::SwizzleChannel::Blue && swizzle[3] == nCine::SwizzleChannel::Alpha) {
-			return vec4(texel[0] / 255.0f, texel[1] / 255.0f, texel[2] / 255.0f, texel[3] / 255.0f);
-		}
-		auto pickChannel = [texel](nCine::SwizzleChannel channel) -> float {
-			switch (channel) {
-				case nCine::SwizzleChannel::Red:	return texel[0] / 255.0f;
-				case nCine::SwizzleChannel::Green:	return texel[1] / 255.0f;
-				case nCine::SwizzleChannel::Blue:	return texel[2] / 255.0f;
-				case nCine::SwizzleChannel::Alpha:	return texel[3] / 255.0f;
-				case nCine::SwizzleChannel::Zero:	return 0.0f;
-				case nCine::SwizzleChannel::One:	return 1.0f;
-			}
-			return 0.0f;
-		};
-		return vec4(pickChannel(swizzle[0]), pickChannel(swizzle[1]), pickChannel(swizzle[2]), pickChannel(swizzle[3]));
+		return detail::sampleTexture(in.textures, unit, uv);
 	}
 
 	/**
@@ -463,33 +551,7 @@ namespace nCine::RHI::Software::sw
 	 */
 	inline vec4 swTexturePrimary(const FragmentShaderInput& in, int unit)
 	{
-		const SwTexture* tex = (unit >= 0 && unit < static_cast<int>(MaxTextureUnits) ? in.textures[unit] : nullptr);
-		if (tex != nullptr && tex->GetPixels(0) != nullptr) {
-			const std::int32_t width = tex->GetWidth();
-			const std::int32_t height = tex->GetHeight();
-			if (width > 0 && height > 0) {
-				const std::uint8_t* texel = in.rgba;
-				// Same swizzle handling (and the same verbatim `/ 255.0f`) as swTexture above
-				const nCine::SwizzleChannel* swizzle = tex->GetSwizzle();
-				if (swizzle[0] == nCine::SwizzleChannel::Red && swizzle[1] == nCine::SwizzleChannel::Green &&
-				    swizzle[2] == nCine::SwizzleChannel::Blue && swizzle[3] == nCine::SwizzleChannel::Alpha) {
-					return vec4(texel[0] / 255.0f, texel[1] / 255.0f, texel[2] / 255.0f, texel[3] / 255.0f);
-				}
-				auto pickChannel = [texel](nCine::SwizzleChannel channel) -> float {
-					switch (channel) {
-						case nCine::SwizzleChannel::Red:	return texel[0] / 255.0f;
-						case nCine::SwizzleChannel::Green:	return texel[1] / 255.0f;
-						case nCine::SwizzleChannel::Blue:	return texel[2] / 255.0f;
-						case nCine::SwizzleChannel::Alpha:	return texel[3] / 255.0f;
-						case nCine::SwizzleChannel::Zero:	return 0.0f;
-						case nCine::SwizzleChannel::One:	return 1.0f;
-					}
-					return 0.0f;
-				};
-				return vec4(pickChannel(swizzle[0]), pickChannel(swizzle[1]), pickChannel(swizzle[2]), pickChannel(swizzle[3]));
-			}
-		}
-		return swTexture(in, unit, vec2(in.u, in.v));
+		return detail::readPrimaryTexel(in.textures, unit, in.rgba, in.u, in.v);
 	}
 
 	/**
@@ -510,6 +572,498 @@ namespace nCine::RHI::Software::sw
 		rgba[2] = quantize(c.b);
 		rgba[3] = quantize(c.a);
 	}
+
+	// --- Wide (multi-pixel) kernels -------------------------------------------------------------------
+	//
+	// Besides the scalar `<Program>_Fragment`, the transpiler emits a `<Program>_Fragment4` for every shader
+	// whose control flow it can vectorize, and on x86 also a `<Program>_Fragment8` for CPUs with AVX2. They
+	// shade four or eight horizontally adjacent pixels at once, one per lane, in structure-of-arrays form.
+	// Values its uniformity analysis proves equal for all pixels (uniforms, the instance color and
+	// everything computed only from them) keep the scalar types above, so they are evaluated once per run;
+	// only the per-pixel values use the wide types of `sw::wide4` or `sw::wide8`. A branch on a per-pixel
+	// condition runs each side under a lane mask, a side no lane takes is skipped, and the assignments
+	// inside are merged with select().
+	//
+	// Every wide operation applies the scalar operation of the same name per lane, in the same order,
+	// including the polynomial transcendentals shared through SwShaderRuntimeMath.h, so a run shades like
+	// that many calls of the scalar kernel. The 4-wide lanes map to SSE2 on x86 and to NEON on AArch64
+	// (both baseline there), any other target uses a plain array; the 8-wide lanes map to AVX2 and are
+	// compiled with the `DEATH_ENABLE_AVX2` target attribute, so they are selected only by the CPU dispatch
+	// of the rasterizer. Only the lane primitives differ per ISA, the vector types and built-ins on top of
+	// them are shared through SwShaderRuntimeWide.h. Single components of the wide vectors are plain fields
+	// named `.x`/`.y`/`.z`/`.w` only (a union cannot alias members with constructors), the emitter normalizes
+	// `.r`/`.s` etc. to them; the multi-component read swizzles are the same methods as above.
+
+#if defined(DEATH_TARGET_SSE2)
+#	define SW_WIDE_SSE2
+#elif defined(DEATH_TARGET_NEON) && !defined(DEATH_TARGET_32BIT)
+#	define SW_WIDE_NEON
+#endif
+
+	namespace wide4
+	{
+		struct vfloat;
+
+		/** @brief Per-lane boolean, the wide counterpart of GLSL `bool` (all bits of a lane set when true) */
+		struct vmask
+		{
+#if defined(SW_WIDE_SSE2)
+			__m128 m;
+#elif defined(SW_WIDE_NEON)
+			uint32x4_t m;
+#else
+			std::uint32_t m[4];
+#endif
+
+			vmask() = default;
+			/** @brief Broadcasts a uniform condition to all lanes */
+			explicit vmask(bool b)
+			{
+#if defined(SW_WIDE_SSE2)
+				m = _mm_castsi128_ps(_mm_set1_epi32(b ? -1 : 0));
+#elif defined(SW_WIDE_NEON)
+				m = vdupq_n_u32(b ? 0xFFFFFFFFu : 0u);
+#else
+				m[0] = m[1] = m[2] = m[3] = (b ? 0xFFFFFFFFu : 0u);
+#endif
+			}
+			/** @brief GLSL `bool(float)`, lanes that are not zero (defined out of line) */
+			explicit vmask(const vfloat& f);
+
+			/** @brief Returns whether lane @p i is set */
+			bool lane(std::int32_t i) const
+			{
+#if defined(SW_WIDE_SSE2)
+				return ((_mm_movemask_ps(m) >> i) & 1) != 0;
+#elif defined(SW_WIDE_NEON)
+				std::uint32_t t[4];
+				vst1q_u32(t, m);
+				return (t[i] != 0);
+#else
+				return (m[i] != 0);
+#endif
+			}
+		};
+
+		inline vmask operator&(const vmask& a, const vmask& b)
+		{
+			vmask r;
+#if defined(SW_WIDE_SSE2)
+			r.m = _mm_and_ps(a.m, b.m);
+#elif defined(SW_WIDE_NEON)
+			r.m = vandq_u32(a.m, b.m);
+#else
+			for (std::int32_t i = 0; i < 4; i++) r.m[i] = a.m[i] & b.m[i];
+#endif
+			return r;
+		}
+		inline vmask operator|(const vmask& a, const vmask& b)
+		{
+			vmask r;
+#if defined(SW_WIDE_SSE2)
+			r.m = _mm_or_ps(a.m, b.m);
+#elif defined(SW_WIDE_NEON)
+			r.m = vorrq_u32(a.m, b.m);
+#else
+			for (std::int32_t i = 0; i < 4; i++) r.m[i] = a.m[i] | b.m[i];
+#endif
+			return r;
+		}
+		inline vmask operator!=(const vmask& a, const vmask& b)
+		{
+			vmask r;
+#if defined(SW_WIDE_SSE2)
+			r.m = _mm_xor_ps(a.m, b.m);
+#elif defined(SW_WIDE_NEON)
+			r.m = veorq_u32(a.m, b.m);
+#else
+			for (std::int32_t i = 0; i < 4; i++) r.m[i] = a.m[i] ^ b.m[i];
+#endif
+			return r;
+		}
+		/** @brief Lanes set in @p a but not in @p b */
+		inline vmask andNot(const vmask& a, const vmask& b)
+		{
+			vmask r;
+#if defined(SW_WIDE_SSE2)
+			r.m = _mm_andnot_ps(b.m, a.m);
+#elif defined(SW_WIDE_NEON)
+			r.m = vbicq_u32(a.m, b.m);
+#else
+			for (std::int32_t i = 0; i < 4; i++) r.m[i] = a.m[i] & ~b.m[i];
+#endif
+			return r;
+		}
+		/** @brief Returns whether at least one lane is set */
+		inline bool any(const vmask& a)
+		{
+#if defined(SW_WIDE_SSE2)
+			return (_mm_movemask_ps(a.m) != 0);
+#elif defined(SW_WIDE_NEON)
+			return (vmaxvq_u32(a.m) != 0);
+#else
+			return ((a.m[0] | a.m[1] | a.m[2] | a.m[3]) != 0);
+#endif
+		}
+		/** @brief Returns whether every lane is set */
+		inline bool all(const vmask& a)
+		{
+#if defined(SW_WIDE_SSE2)
+			return (_mm_movemask_ps(a.m) == 0x0F);
+#elif defined(SW_WIDE_NEON)
+			return (vminvq_u32(a.m) != 0);
+#else
+			return ((a.m[0] & a.m[1] & a.m[2] & a.m[3]) != 0);
+#endif
+		}
+
+		/** @brief Per-lane float, the wide counterpart of GLSL `float` */
+		struct vfloat
+		{
+#if defined(SW_WIDE_SSE2)
+			__m128 v;
+#elif defined(SW_WIDE_NEON)
+			float32x4_t v;
+#else
+			float v[4];
+#endif
+
+			vfloat() = default;
+			/** @brief Broadcasts a uniform value to all lanes */
+			vfloat(float s)
+			{
+#if defined(SW_WIDE_SSE2)
+				v = _mm_set1_ps(s);
+#elif defined(SW_WIDE_NEON)
+				v = vdupq_n_f32(s);
+#else
+				v[0] = v[1] = v[2] = v[3] = s;
+#endif
+			}
+			/** @brief GLSL `float(bool)`, `1.0` in set lanes and `0.0` elsewhere (defined out of line) */
+			explicit vfloat(const vmask& b);
+
+			/** @brief Loads four consecutive floats, one per lane */
+			static vfloat load(const float* p)
+			{
+				vfloat r;
+#if defined(SW_WIDE_SSE2)
+				r.v = _mm_loadu_ps(p);
+#elif defined(SW_WIDE_NEON)
+				r.v = vld1q_f32(p);
+#else
+				for (std::int32_t i = 0; i < 4; i++) r.v[i] = p[i];
+#endif
+				return r;
+			}
+
+			/** @brief Stores the four lanes to consecutive floats */
+			void store(float* p) const
+			{
+#if defined(SW_WIDE_SSE2)
+				_mm_storeu_ps(p, v);
+#elif defined(SW_WIDE_NEON)
+				vst1q_f32(p, v);
+#else
+				for (std::int32_t i = 0; i < 4; i++) p[i] = v[i];
+#endif
+			}
+
+			vfloat& operator+=(const vfloat& o);
+			vfloat& operator-=(const vfloat& o);
+			vfloat& operator*=(const vfloat& o);
+			vfloat& operator/=(const vfloat& o);
+		};
+
+#if defined(SW_WIDE_SSE2)
+#	define SW_WIDE_FLOAT_OP(OP, SSE, NEON) \
+		inline vfloat operator OP(const vfloat& a, const vfloat& b) { vfloat r; r.v = SSE(a.v, b.v); return r; }
+#	define SW_WIDE_CMP_OP(OP, SSE, NEON) \
+		inline vmask operator OP(const vfloat& a, const vfloat& b) { vmask r; r.m = SSE(a.v, b.v); return r; }
+#elif defined(SW_WIDE_NEON)
+#	define SW_WIDE_FLOAT_OP(OP, SSE, NEON) \
+		inline vfloat operator OP(const vfloat& a, const vfloat& b) { vfloat r; r.v = NEON(a.v, b.v); return r; }
+#	define SW_WIDE_CMP_OP(OP, SSE, NEON) \
+		inline vmask operator OP(const vfloat& a, const vfloat& b) { vmask r; r.m = NEON(a.v, b.v); return r; }
+#else
+#	define SW_WIDE_FLOAT_OP(OP, SSE, NEON) \
+		inline vfloat operator OP(const vfloat& a, const vfloat& b) { vfloat r; for (std::int32_t i = 0; i < 4; i++) r.v[i] = a.v[i] OP b.v[i]; return r; }
+#	define SW_WIDE_CMP_OP(OP, SSE, NEON) \
+		inline vmask operator OP(const vfloat& a, const vfloat& b) { vmask r; for (std::int32_t i = 0; i < 4; i++) r.m[i] = (a.v[i] OP b.v[i] ? 0xFFFFFFFFu : 0u); return r; }
+#endif
+
+		SW_WIDE_FLOAT_OP(+, _mm_add_ps, vaddq_f32)
+		SW_WIDE_FLOAT_OP(-, _mm_sub_ps, vsubq_f32)
+		SW_WIDE_FLOAT_OP(*, _mm_mul_ps, vmulq_f32)
+		SW_WIDE_FLOAT_OP(/, _mm_div_ps, vdivq_f32)
+		SW_WIDE_CMP_OP(<, _mm_cmplt_ps, vcltq_f32)
+		SW_WIDE_CMP_OP(<=, _mm_cmple_ps, vcleq_f32)
+		SW_WIDE_CMP_OP(>, _mm_cmpgt_ps, vcgtq_f32)
+		SW_WIDE_CMP_OP(>=, _mm_cmpge_ps, vcgeq_f32)
+		SW_WIDE_CMP_OP(==, _mm_cmpeq_ps, vceqq_f32)
+
+#undef SW_WIDE_FLOAT_OP
+#undef SW_WIDE_CMP_OP
+
+		/** @brief Per-lane `m ? a : b` */
+		inline vfloat select(const vmask& m, const vfloat& a, const vfloat& b)
+		{
+			vfloat r;
+#if defined(SW_WIDE_SSE2)
+			r.v = _mm_or_ps(_mm_and_ps(m.m, a.v), _mm_andnot_ps(m.m, b.v));
+#elif defined(SW_WIDE_NEON)
+			r.v = vbslq_f32(m.m, a.v, b.v);
+#else
+			for (std::int32_t i = 0; i < 4; i++) r.v[i] = (m.m[i] != 0 ? a.v[i] : b.v[i]);
+#endif
+			return r;
+		}
+
+		inline vfloat sqrt(const vfloat& x)
+		{
+			vfloat r;
+#if defined(SW_WIDE_SSE2)
+			r.v = _mm_sqrt_ps(x.v);
+#elif defined(SW_WIDE_NEON)
+			r.v = vsqrtq_f32(x.v);
+#else
+			for (std::int32_t i = 0; i < 4; i++) r.v[i] = std::sqrt(x.v[i]);
+#endif
+			return r;
+		}
+		inline vfloat abs(const vfloat& x)
+		{
+			vfloat r;
+#if defined(SW_WIDE_SSE2)
+			r.v = _mm_andnot_ps(_mm_set1_ps(-0.0f), x.v);
+#elif defined(SW_WIDE_NEON)
+			r.v = vabsq_f32(x.v);
+#else
+			for (std::int32_t i = 0; i < 4; i++) r.v[i] = std::fabs(x.v[i]);
+#endif
+			return r;
+		}
+		inline vfloat floor(const vfloat& x)
+		{
+			vfloat r;
+#if defined(SW_WIDE_SSE2)
+			// SSE2 has no rounding instruction: truncate, step down where that rounded up, and restore the sign
+			// of -0.0. A value of 2^23 and above (and NaN) is already integral and is passed through.
+			__m128 t = _mm_cvtepi32_ps(_mm_cvttps_epi32(x.v));
+			t = _mm_sub_ps(t, _mm_and_ps(_mm_cmpgt_ps(t, x.v), _mm_set1_ps(1.0f)));
+			t = _mm_or_ps(t, _mm_and_ps(x.v, _mm_set1_ps(-0.0f)));
+			__m128 inRange = _mm_cmplt_ps(_mm_andnot_ps(_mm_set1_ps(-0.0f), x.v), _mm_set1_ps(8388608.0f));
+			r.v = _mm_or_ps(_mm_and_ps(inRange, t), _mm_andnot_ps(inRange, x.v));
+#elif defined(SW_WIDE_NEON)
+			r.v = vrndmq_f32(x.v);
+#else
+			for (std::int32_t i = 0; i < 4; i++) r.v[i] = std::floor(x.v[i]);
+#endif
+			return r;
+		}
+
+		namespace detail
+		{
+			/** Lane-wise @ref sw::detail::scaleByPow2() */
+			inline vfloat scaleByPow2(const vfloat& x, const vfloat& n)
+			{
+#if defined(SW_WIDE_SSE2)
+				vfloat s;
+				s.v = _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(_mm_cvttps_epi32(n.v), _mm_set1_epi32(127)), 23));
+				return x * s;
+#elif defined(SW_WIDE_NEON)
+				vfloat s;
+				s.v = vreinterpretq_f32_s32(vshlq_n_s32(vaddq_s32(vcvtq_s32_f32(n.v), vdupq_n_s32(127)), 23));
+				return x * s;
+#else
+				vfloat r;
+				for (std::int32_t i = 0; i < 4; i++) r.v[i] = sw::detail::scaleByPow2(x.v[i], n.v[i]);
+				return r;
+#endif
+			}
+
+			/** Lane-wise @ref sw::detail::splitExponent() */
+			inline vfloat splitExponent(const vfloat& x, vfloat& e)
+			{
+				vfloat m;
+#if defined(SW_WIDE_SSE2)
+				__m128i bits = _mm_castps_si128(x.v);
+				e.v = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_srai_epi32(bits, 23), _mm_set1_epi32(127)));
+				m.v = _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32(0x007FFFFF)), _mm_set1_epi32(0x3F800000)));
+#elif defined(SW_WIDE_NEON)
+				int32x4_t bits = vreinterpretq_s32_f32(x.v);
+				e.v = vcvtq_f32_s32(vsubq_s32(vshrq_n_s32(bits, 23), vdupq_n_s32(127)));
+				m.v = vreinterpretq_f32_s32(vorrq_s32(vandq_s32(bits, vdupq_n_s32(0x007FFFFF)), vdupq_n_s32(0x3F800000)));
+#else
+				for (std::int32_t i = 0; i < 4; i++) m.v[i] = sw::detail::splitExponent(x.v[i], e.v[i]);
+#endif
+				return m;
+			}
+
+			/** Quantizes straight-alpha `0..1` channels exactly like @ref sw::packColor() and writes four RGBA8 pixels */
+			inline void packLanes(const vfloat& r, const vfloat& g, const vfloat& b, const vfloat& a, std::uint8_t* rgba)
+			{
+				const vfloat zero(0.0f), one(1.0f);
+				vfloat c[4] = { r, g, b, a };
+				for (std::int32_t i = 0; i < 4; i++) {
+					c[i] = select(c[i] < zero, zero, select(c[i] > one, one, c[i])) * vfloat(255.0f) + vfloat(0.5f);
+				}
+#if defined(SW_WIDE_SSE2)
+				// Truncate, then interleave the channel-planar words into pixels (a NaN lane saturates to 0)
+				__m128i rg = _mm_packs_epi32(_mm_cvttps_epi32(c[0].v), _mm_cvttps_epi32(c[1].v));
+				__m128i ba = _mm_packs_epi32(_mm_cvttps_epi32(c[2].v), _mm_cvttps_epi32(c[3].v));
+				__m128i rb = _mm_unpacklo_epi16(rg, ba);
+				__m128i ga = _mm_unpackhi_epi16(rg, ba);
+				__m128i px = _mm_packus_epi16(_mm_unpacklo_epi16(rb, ga), _mm_unpackhi_epi16(rb, ga));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(rgba), px);
+#elif defined(SW_WIDE_NEON)
+				uint16x8_t rg = vcombine_u16(vqmovun_s32(vcvtq_s32_f32(c[0].v)), vqmovun_s32(vcvtq_s32_f32(c[1].v)));
+				uint16x8_t ba = vcombine_u16(vqmovun_s32(vcvtq_s32_f32(c[2].v)), vqmovun_s32(vcvtq_s32_f32(c[3].v)));
+				uint16x8_t rb = vzip1q_u16(rg, ba);
+				uint16x8_t ga = vzip2q_u16(rg, ba);
+				vst1q_u8(rgba, vcombine_u8(vqmovn_u16(vzip1q_u16(rb, ga)), vqmovn_u16(vzip2q_u16(rb, ga))));
+#else
+				for (std::int32_t i = 0; i < 4; i++) {
+					for (std::int32_t ch = 0; ch < 4; ch++) {
+						std::int32_t q = static_cast<std::int32_t>(c[ch].v[i]);
+						rgba[i * 4 + ch] = static_cast<std::uint8_t>((q < 0) ? 0 : (q > 255 ? 255 : q));
+					}
+				}
+#endif
+			}
+		}
+
+#define SW_WIDE_LANES 4
+#define SW_WIDE_FN inline
+#define SW_WIDE_INPUT FragmentShaderInput4
+#include "SwShaderRuntimeWide.h"
+	}
+
+#undef SW_WIDE_SSE2
+#undef SW_WIDE_NEON
+
+#if defined(SW_WIDE8)
+	namespace wide8
+	{
+		struct vfloat;
+
+		/** @brief Per-lane boolean of the 8-wide AVX2 kernels */
+		struct vmask
+		{
+			__m256 m;
+
+			vmask() = default;
+			/** @brief Broadcasts a uniform condition to all lanes */
+			DEATH_ENABLE_AVX2 explicit vmask(bool b) : m(_mm256_castsi256_ps(_mm256_set1_epi32(b ? -1 : 0))) {}
+			/** @brief GLSL `bool(float)`, lanes that are not zero (defined out of line) */
+			DEATH_ENABLE_AVX2 explicit vmask(const vfloat& f);
+
+			/** @brief Returns whether lane @p i is set */
+			DEATH_ENABLE_AVX2 bool lane(std::int32_t i) const { return ((_mm256_movemask_ps(m) >> i) & 1) != 0; }
+		};
+
+		DEATH_ENABLE_AVX2 inline vmask operator&(const vmask& a, const vmask& b) { vmask r; r.m = _mm256_and_ps(a.m, b.m); return r; }
+		DEATH_ENABLE_AVX2 inline vmask operator|(const vmask& a, const vmask& b) { vmask r; r.m = _mm256_or_ps(a.m, b.m); return r; }
+		DEATH_ENABLE_AVX2 inline vmask operator!=(const vmask& a, const vmask& b) { vmask r; r.m = _mm256_xor_ps(a.m, b.m); return r; }
+		/** @brief Lanes set in @p a but not in @p b */
+		DEATH_ENABLE_AVX2 inline vmask andNot(const vmask& a, const vmask& b) { vmask r; r.m = _mm256_andnot_ps(b.m, a.m); return r; }
+		/** @brief Returns whether at least one lane is set */
+		DEATH_ENABLE_AVX2 inline bool any(const vmask& a) { return (_mm256_movemask_ps(a.m) != 0); }
+		/** @brief Returns whether every lane is set */
+		DEATH_ENABLE_AVX2 inline bool all(const vmask& a) { return (_mm256_movemask_ps(a.m) == 0xFF); }
+
+		/** @brief Per-lane float of the 8-wide AVX2 kernels */
+		struct vfloat
+		{
+			__m256 v;
+
+			vfloat() = default;
+			/** @brief Broadcasts a uniform value to all lanes */
+			DEATH_ENABLE_AVX2 vfloat(float s) : v(_mm256_set1_ps(s)) {}
+			/** @brief GLSL `float(bool)`, `1.0` in set lanes and `0.0` elsewhere (defined out of line) */
+			DEATH_ENABLE_AVX2 explicit vfloat(const vmask& b);
+
+			/** @brief Loads eight consecutive floats, one per lane */
+			DEATH_ENABLE_AVX2 static vfloat load(const float* p) { vfloat r; r.v = _mm256_loadu_ps(p); return r; }
+			/** @brief Stores the eight lanes to consecutive floats */
+			DEATH_ENABLE_AVX2 void store(float* p) const { _mm256_storeu_ps(p, v); }
+
+			DEATH_ENABLE_AVX2 vfloat& operator+=(const vfloat& o);
+			DEATH_ENABLE_AVX2 vfloat& operator-=(const vfloat& o);
+			DEATH_ENABLE_AVX2 vfloat& operator*=(const vfloat& o);
+			DEATH_ENABLE_AVX2 vfloat& operator/=(const vfloat& o);
+		};
+
+#define SW_WIDE_FLOAT_OP(OP, AVX) \
+		DEATH_ENABLE_AVX2 inline vfloat operator OP(const vfloat& a, const vfloat& b) { vfloat r; r.v = AVX(a.v, b.v); return r; }
+#define SW_WIDE_CMP_OP(OP, PREDICATE) \
+		DEATH_ENABLE_AVX2 inline vmask operator OP(const vfloat& a, const vfloat& b) { vmask r; r.m = _mm256_cmp_ps(a.v, b.v, PREDICATE); return r; }
+
+		SW_WIDE_FLOAT_OP(+, _mm256_add_ps)
+		SW_WIDE_FLOAT_OP(-, _mm256_sub_ps)
+		SW_WIDE_FLOAT_OP(*, _mm256_mul_ps)
+		SW_WIDE_FLOAT_OP(/, _mm256_div_ps)
+		SW_WIDE_CMP_OP(<, _CMP_LT_OQ)
+		SW_WIDE_CMP_OP(<=, _CMP_LE_OQ)
+		SW_WIDE_CMP_OP(>, _CMP_GT_OQ)
+		SW_WIDE_CMP_OP(>=, _CMP_GE_OQ)
+		SW_WIDE_CMP_OP(==, _CMP_EQ_OQ)
+
+#undef SW_WIDE_FLOAT_OP
+#undef SW_WIDE_CMP_OP
+
+		/** @brief Per-lane `m ? a : b` */
+		DEATH_ENABLE_AVX2 inline vfloat select(const vmask& m, const vfloat& a, const vfloat& b) { vfloat r; r.v = _mm256_blendv_ps(b.v, a.v, m.m); return r; }
+
+		DEATH_ENABLE_AVX2 inline vfloat sqrt(const vfloat& x) { vfloat r; r.v = _mm256_sqrt_ps(x.v); return r; }
+		DEATH_ENABLE_AVX2 inline vfloat abs(const vfloat& x) { vfloat r; r.v = _mm256_andnot_ps(_mm256_set1_ps(-0.0f), x.v); return r; }
+		DEATH_ENABLE_AVX2 inline vfloat floor(const vfloat& x) { vfloat r; r.v = _mm256_floor_ps(x.v); return r; }
+
+		namespace detail
+		{
+			/** Lane-wise @ref sw::detail::scaleByPow2() */
+			DEATH_ENABLE_AVX2 inline vfloat scaleByPow2(const vfloat& x, const vfloat& n)
+			{
+				vfloat s;
+				s.v = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(_mm256_cvttps_epi32(n.v), _mm256_set1_epi32(127)), 23));
+				return x * s;
+			}
+
+			/** Lane-wise @ref sw::detail::splitExponent() */
+			DEATH_ENABLE_AVX2 inline vfloat splitExponent(const vfloat& x, vfloat& e)
+			{
+				__m256i bits = _mm256_castps_si256(x.v);
+				e.v = _mm256_cvtepi32_ps(_mm256_sub_epi32(_mm256_srai_epi32(bits, 23), _mm256_set1_epi32(127)));
+				vfloat m;
+				m.v = _mm256_castsi256_ps(_mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi32(0x007FFFFF)), _mm256_set1_epi32(0x3F800000)));
+				return m;
+			}
+
+			/** Quantizes straight-alpha `0..1` channels exactly like @ref sw::packColor() and writes eight RGBA8 pixels */
+			DEATH_ENABLE_AVX2 inline void packLanes(const vfloat& r, const vfloat& g, const vfloat& b, const vfloat& a, std::uint8_t* rgba)
+			{
+				const vfloat zero(0.0f), one(1.0f);
+				vfloat c[4] = { r, g, b, a };
+				for (std::int32_t i = 0; i < 4; i++) {
+					c[i] = select(c[i] < zero, zero, select(c[i] > one, one, c[i])) * vfloat(255.0f) + vfloat(0.5f);
+				}
+				// Same interleave as the SSE2 variant, the pack/unpack instructions work within each 128-bit half,
+				// so the low half holds pixels 0-3 and the high half pixels 4-7
+				__m256i rg = _mm256_packs_epi32(_mm256_cvttps_epi32(c[0].v), _mm256_cvttps_epi32(c[1].v));
+				__m256i ba = _mm256_packs_epi32(_mm256_cvttps_epi32(c[2].v), _mm256_cvttps_epi32(c[3].v));
+				__m256i rb = _mm256_unpacklo_epi16(rg, ba);
+				__m256i ga = _mm256_unpackhi_epi16(rg, ba);
+				__m256i px = _mm256_packus_epi16(_mm256_unpacklo_epi16(rb, ga), _mm256_unpackhi_epi16(rb, ga));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(rgba), px);
+			}
+		}
+
+#define SW_WIDE_LANES 8
+#define SW_WIDE_FN DEATH_ENABLE_AVX2 inline
+#define SW_WIDE_INPUT FragmentShaderInput8
+#include "SwShaderRuntimeWide.h"
+	}
+#endif
 }
 
 #if defined(_MSC_VER)
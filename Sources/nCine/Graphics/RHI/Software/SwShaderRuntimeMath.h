@@ -0,0 +1,181 @@
+// No include guard, this file is included once per lane width by SwShaderRuntime.h
+
+/**
+	@file SwShaderRuntimeMath.h
+
+	Polynomial transcendental functions of the software shader runtime, written once for the scalar
+	`float` and for every wide lane type.
+
+	SwShaderRuntime.h includes this file inside each `detail` namespace with `SW_MATH_FLOAT` set to the
+	value type (`float`, `wide4::vfloat`, ...) and `SW_MATH_FN` to the function specifiers. The bodies
+	call only the arithmetic operators, the comparisons and `select()`, `floor()`, `abs()`, `sqrt()`,
+	`scaleByPow2()` and `splitExponent()` of that type, so every wide kernel lowers `sin()` or `pow()`
+	into a few vector instructions instead of a library call per lane, and because the scalar and the
+	wide variants execute the same operations in the same order, a wide kernel still shades exactly like
+	the scalar one. Over the ranges the shaders use the absolute error of sin()/cos() stays below 2e-7 and
+	the others are within a few ulp of the C library.
+*/
+
+#if !defined(SW_MATH_FLOAT) || !defined(SW_MATH_FN)
+#	error "SW_MATH_FLOAT and SW_MATH_FN must be defined before including SwShaderRuntimeMath.h"
+#endif
+
+using Float = SW_MATH_FLOAT;
+
+/** Reduces @p x to [-pi, pi] with 2pi split into three parts (Cody-Waite), so the reduction stays exact for large @p x */
+SW_MATH_FN Float reduceTwoPi(Float x)
+{
+	Float k = floor(x * Float(0.15915494309189533577f) + Float(0.5f));
+	return ((x - k * Float(6.28125f)) - k * Float(1.93500518798828125e-3f)) - k * Float(3.019915981e-07f);
+}
+
+/** Odd Taylor polynomial of sin() up to x^13, accurate to 1e-9 for |x| <= pi / 2 */
+SW_MATH_FN Float sinKernel(Float x)
+{
+	Float x2 = x * x;
+	Float p = Float(1.6059043836821614599e-10f);
+	p = p * x2 + Float(-2.5052108385441718775e-8f);
+	p = p * x2 + Float(2.7557319223985890653e-6f);
+	p = p * x2 + Float(-1.9841269841269841270e-4f);
+	p = p * x2 + Float(8.3333333333333333333e-3f);
+	p = p * x2 + Float(-1.6666666666666666667e-1f);
+	return x + x * x2 * p;
+}
+
+SW_MATH_FN Float sinPoly(Float x)
+{
+	// sin(r) = sin(pi - r), pi is split in two so the fold is exact
+	Float r = reduceTwoPi(x);
+	r = select(r > Float(1.57079632679489661923f), (Float(3.14159274101257324219f) - r) - Float(8.742278e-08f),
+		select(r < Float(-1.57079632679489661923f), (Float(-3.14159274101257324219f) - r) + Float(8.742278e-08f), r));
+	return sinKernel(r);
+}
+
+SW_MATH_FN Float cosPoly(Float x)
+{
+	// cos(r) = sin(pi / 2 - |r|)
+	Float r = reduceTwoPi(x);
+	return sinKernel((Float(1.57079637050628662109f) - abs(r)) - Float(4.371139e-08f));
+}
+
+SW_MATH_FN Float atanPoly(Float x)
+{
+	// Cephes atanf(), the argument is first reduced to |z| <= tan(pi / 8)
+	Float a = abs(x);
+	auto big = (a > Float(2.41421356237309504880f));
+	auto mid = (a > Float(0.41421356237309504880f));
+	Float y = select(big, Float(1.57079632679489661923f), select(mid, Float(0.78539816339744830962f), Float(0.0f)));
+	Float z = select(big, Float(-1.0f) / a, select(mid, (a - Float(1.0f)) / (a + Float(1.0f)), a));
+	Float z2 = z * z;
+	Float p = Float(8.05374449538e-2f);
+	p = p * z2 + Float(-1.38776856032e-1f);
+	p = p * z2 + Float(1.99777106478e-1f);
+	p = p * z2 + Float(-3.33329491539e-1f);
+	Float r = y + (p * z2 * z + z);
+	return select(x < Float(0.0f), -r, r);
+}
+
+SW_MATH_FN Float atan2Poly(Float y, Float x)
+{
+	Float r = atanPoly(y / x);
+	Float pi = Float(3.14159265358979323846f);
+	r = select(x < Float(0.0f), r + select(y < Float(0.0f), -pi, pi), r);
+	// On the vertical axis, y * 0 keeps a NaN and yields 0 for the origin
+	Float onAxis = select(y > Float(0.0f), Float(1.57079632679489661923f), select(y < Float(0.0f), Float(-1.57079632679489661923f), y * Float(0.0f)));
+	return select(x == Float(0.0f), onAxis, r);
+}
+
+/** Shared polynomial of asin() and acos() (Cephes asinf()), @p s * (1 + z * P(z)) */
+SW_MATH_FN Float asinCore(Float z, Float s)
+{
+	Float p = Float(4.2163199048e-2f);
+	p = p * z + Float(2.4181311049e-2f);
+	p = p * z + Float(4.5470025998e-2f);
+	p = p * z + Float(7.4953002686e-2f);
+	p = p * z + Float(1.6666752422e-1f);
+	return p * z * s + s;
+}
+
+SW_MATH_FN Float asinPoly(Float x)
+{
+	// asin(x) = pi / 2 - 2 asin(sqrt((1 - |x|) / 2)) for |x| > 0.5
+	Float a = abs(x);
+	auto big = (a > Float(0.5f));
+	Float zBig = Float(0.5f) * (Float(1.0f) - a);
+	Float r = asinCore(select(big, zBig, a * a), select(big, sqrt(zBig), a));
+	r = select(big, Float(1.57079632679489661923f) - r - r, r);
+	return select(x < Float(0.0f), -r, r);
+}
+
+SW_MATH_FN Float acosPoly(Float x)
+{
+	// acos(x) = 2 asin(sqrt((1 - |x|) / 2)) for |x| > 0.5, mirrored for negative x, otherwise pi / 2 - asin(x)
+	Float a = abs(x);
+	auto big = (a > Float(0.5f));
+	Float zBig = Float(0.5f) * (Float(1.0f) - a);
+	Float r = asinCore(select(big, zBig, x * x), select(big, sqrt(zBig), x));
+	Float rBig = r + r;
+	return select(big, select(x < Float(0.0f), Float(3.14159265358979323846f) - rBig, rBig), Float(1.57079632679489661923f) - r);
+}
+
+SW_MATH_FN Float exp2Poly(Float x)
+{
+	// Cephes exp2f(), 2^x = 2^n * 2^f with |f| <= 0.5
+	Float n = floor(x + Float(0.5f));
+	Float f = x - n;
+	Float p = Float(1.535336188319500e-4f);
+	p = p * f + Float(1.339887440266574e-3f);
+	p = p * f + Float(9.618437357674640e-3f);
+	p = p * f + Float(5.550332471162809e-2f);
+	p = p * f + Float(2.402264791363012e-1f);
+	p = p * f + Float(6.931472028550421e-1f);
+	p = p * f + Float(1.0f);
+	// 2^n is built from the exponent bits, n = 128 takes two steps; denormal results flush to zero
+	Float nClamped = select(n > Float(127.0f), Float(127.0f), n);
+	Float r = scaleByPow2(p, select(nClamped < Float(-126.0f), Float(-126.0f), nClamped));
+	r = select(n > Float(127.0f), r + r, r);
+	r = select(x >= Float(128.0f), Float(INFINITY), r);
+	return select(x < Float(-126.0f), Float(0.0f), r);
+}
+
+SW_MATH_FN Float log2Poly(Float x)
+{
+	// Cephes logf() on the mantissa folded to [sqrt(0.5), sqrt(2)), then scaled to base 2
+	Float e;
+	Float m = splitExponent(x, e);
+	auto hi = (m > Float(1.41421356237309504880f));
+	m = select(hi, m * Float(0.5f), m);
+	e = select(hi, e + Float(1.0f), e);
+	Float z = m - Float(1.0f);
+	Float z2 = z * z;
+	Float p = Float(7.0376836292e-2f);
+	p = p * z + Float(-1.1514610310e-1f);
+	p = p * z + Float(1.1676998740e-1f);
+	p = p * z + Float(-1.2420140846e-1f);
+	p = p * z + Float(1.4249322787e-1f);
+	p = p * z + Float(-1.6668057665e-1f);
+	p = p * z + Float(2.0000714765e-1f);
+	p = p * z + Float(-2.4999993993e-1f);
+	p = p * z + Float(3.3333331174e-1f);
+	Float ln = z + (z * z2 * p - Float(0.5f) * z2);
+	Float r = ln * Float(1.44269504088896340736f) + e;
+	// Zero and denormals give -inf, negative values NaN, +inf and NaN pass through
+	r = select(x < Float(1.17549435e-38f), Float(-INFINITY), r);
+	r = select(x < Float(0.0f), Float(NAN), r);
+	r = select(x == Float(INFINITY), x, r);
+	return select(x == x, r, x);
+}
+
+SW_MATH_FN Float powPoly(Float x, Float y)
+{
+	Float r = exp2Poly(y * log2Poly(abs(x)));
+	// A negative base is defined only for an integral exponent, like std::pow()
+	auto isInt = (floor(y) == y);
+	Float half = y * Float(0.5f);
+	auto isOdd = isInt & (floor(half) != half);
+	r = select(x < Float(0.0f), select(isInt, select(isOdd, -r, r), Float(NAN)), r);
+	return select(y == Float(0.0f), Float(1.0f), r);
+}
+
+#undef SW_MATH_FLOAT
+#undef SW_MATH_FN
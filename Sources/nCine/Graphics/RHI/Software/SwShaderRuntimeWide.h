@@ -0,0 +1,352 @@
+// No include guard, this file is included once per lane width by SwShaderRuntime.h
+
+/**
+	@file SwShaderRuntimeWide.h
+
+	Vector types and built-in functions of the wide fragment kernels, shared by every lane width.
+
+	SwShaderRuntime.h includes this file inside `sw::wide4` and `sw::wide8` after defining the lane
+	primitives of that width (`vmask`, `vfloat`, their operators, `select()`, `any()`, `all()`, `sqrt()`,
+	`abs()`, `floor()` and `detail::scaleByPow2()`, `detail::splitExponent()`, `detail::packLanes()`),
+	with `SW_WIDE_LANES` set to the number of lanes, `SW_WIDE_FN` to the function specifiers (it carries
+	the target attribute of the ISA) and `SW_WIDE_INPUT` to the fragment input of that width. Inside these
+	namespaces the scalar functions of the same name are hidden, so scalar calls are spelled with `sw::`.
+*/
+
+#if !defined(SW_WIDE_LANES) || !defined(SW_WIDE_FN) || !defined(SW_WIDE_INPUT)
+#	error "SW_WIDE_LANES, SW_WIDE_FN and SW_WIDE_INPUT must be defined before including SwShaderRuntimeWide.h"
+#endif
+
+SW_WIDE_FN vmask operator!(const vmask& a) { return (a != vmask(true)); }
+SW_WIDE_FN vmask operator==(const vmask& a, const vmask& b) { return !(a != b); }
+SW_WIDE_FN vmask operator!=(const vfloat& a, const vfloat& b) { return !(a == b); }
+SW_WIDE_FN vfloat operator-(const vfloat& a) { return vfloat(0.0f) - a; }
+
+SW_WIDE_FN vfloat& vfloat::operator+=(const vfloat& o) { return (*this = *this + o); }
+SW_WIDE_FN vfloat& vfloat::operator-=(const vfloat& o) { return (*this = *this - o); }
+SW_WIDE_FN vfloat& vfloat::operator*=(const vfloat& o) { return (*this = *this * o); }
+SW_WIDE_FN vfloat& vfloat::operator/=(const vfloat& o) { return (*this = *this / o); }
+
+SW_WIDE_FN vmask select(const vmask& m, const vmask& a, const vmask& b) { return (m & a) | andNot(b, m); }
+
+SW_WIDE_FN vmask::vmask(const vfloat& f) { *this = (f != vfloat(0.0f)); }
+SW_WIDE_FN vfloat::vfloat(const vmask& b) { *this = select(b, vfloat(1.0f), vfloat(0.0f)); }
+
+namespace detail
+{
+#define SW_MATH_FLOAT vfloat
+#define SW_MATH_FN SW_WIDE_FN
+#include "SwShaderRuntimeMath.h"
+}
+
+struct vvec3;
+struct vvec4;
+
+/** @brief Wide counterpart of @ref sw::vec2 */
+struct vvec2
+{
+	vfloat x, y;
+
+	SW_WIDE_FN vvec2() : x(0.0f), y(0.0f) {}
+	SW_WIDE_FN explicit vvec2(const vfloat& v) : x(v), y(v) {}
+	SW_WIDE_FN vvec2(const vfloat& x_, const vfloat& y_) : x(x_), y(y_) {}
+	SW_WIDE_FN vvec2(const vec2& v) : x(v.x), y(v.y) {}
+	SW_WIDE_FN explicit vvec2(const vvec3& v);
+	SW_WIDE_FN explicit vvec2(const vvec4& v);
+
+	SW_WIDE_FN vvec2& operator+=(const vvec2& o) { x += o.x; y += o.y; return *this; }
+	SW_WIDE_FN vvec2& operator-=(const vvec2& o) { x -= o.x; y -= o.y; return *this; }
+	SW_WIDE_FN vvec2& operator*=(const vvec2& o) { x *= o.x; y *= o.y; return *this; }
+	SW_WIDE_FN vvec2& operator/=(const vvec2& o) { x /= o.x; y /= o.y; return *this; }
+	SW_WIDE_FN vvec2& operator*=(const vfloat& o) { x *= o; y *= o; return *this; }
+	SW_WIDE_FN vvec2& operator/=(const vfloat& o) { x /= o; y /= o; return *this; }
+
+	SW_WIDE_FN vvec2 xy() const { return vvec2(x, y); }
+	SW_WIDE_FN vvec2 yx() const { return vvec2(y, x); }
+	SW_WIDE_FN vvec2 xx() const { return vvec2(x, x); }
+	SW_WIDE_FN vvec2 yy() const { return vvec2(y, y); }
+	SW_WIDE_FN vvec4 xyxy() const;
+};
+
+/** @brief Wide counterpart of @ref sw::vec3 */
+struct vvec3
+{
+	vfloat x, y, z;
+
+	SW_WIDE_FN vvec3() : x(0.0f), y(0.0f), z(0.0f) {}
+	SW_WIDE_FN explicit vvec3(const vfloat& v) : x(v), y(v), z(v) {}
+	SW_WIDE_FN vvec3(const vfloat& x_, const vfloat& y_, const vfloat& z_) : x(x_), y(y_), z(z_) {}
+	SW_WIDE_FN vvec3(const vvec2& xy_, const vfloat& z_) : x(xy_.x), y(xy_.y), z(z_) {}
+	SW_WIDE_FN vvec3(const vfloat& x_, const vvec2& yz_) : x(x_), y(yz_.x), z(yz_.y) {}
+	SW_WIDE_FN vvec3(const vec3& v) : x(v.x), y(v.y), z(v.z) {}
+	SW_WIDE_FN explicit vvec3(const vvec4& v);
+
+	SW_WIDE_FN vvec3& operator+=(const vvec3& o) { x += o.x; y += o.y; z += o.z; return *this; }
+	SW_WIDE_FN vvec3& operator-=(const vvec3& o) { x -= o.x; y -= o.y; z -= o.z; return *this; }
+	SW_WIDE_FN vvec3& operator*=(const vvec3& o) { x *= o.x; y *= o.y; z *= o.z; return *this; }
+	SW_WIDE_FN vvec3& operator/=(const vvec3& o) { x /= o.x; y /= o.y; z /= o.z; return *this; }
+	SW_WIDE_FN vvec3& operator*=(const vfloat& o) { x *= o; y *= o; z *= o; return *this; }
+	SW_WIDE_FN vvec3& operator/=(const vfloat& o) { x /= o; y /= o; z /= o; return *this; }
+
+	SW_WIDE_FN vvec2 xy() const { return vvec2(x, y); }
+	SW_WIDE_FN vvec2 xx() const { return vvec2(x, x); }
+	SW_WIDE_FN vvec2 yy() const { return vvec2(y, y); }
+	SW_WIDE_FN vvec2 xz() const { return vvec2(x, z); }
+	SW_WIDE_FN vvec2 yz() const { return vvec2(y, z); }
+	SW_WIDE_FN vvec3 xyz() const { return vvec3(x, y, z); }
+};
+
+/** @brief Wide counterpart of @ref sw::vec4 */
+struct vvec4
+{
+	vfloat x, y, z, w;
+
+	SW_WIDE_FN vvec4() : x(0.0f), y(0.0f), z(0.0f), w(0.0f) {}
+	SW_WIDE_FN explicit vvec4(const vfloat& v) : x(v), y(v), z(v), w(v) {}
+	SW_WIDE_FN vvec4(const vfloat& x_, const vfloat& y_, const vfloat& z_, const vfloat& w_) : x(x_), y(y_), z(z_), w(w_) {}
+	SW_WIDE_FN vvec4(const vvec3& xyz_, const vfloat& w_) : x(xyz_.x), y(xyz_.y), z(xyz_.z), w(w_) {}
+	SW_WIDE_FN vvec4(const vfloat& x_, const vvec3& yzw_) : x(x_), y(yzw_.x), z(yzw_.y), w(yzw_.z) {}
+	SW_WIDE_FN vvec4(const vvec2& xy_, const vvec2& zw_) : x(xy_.x), y(xy_.y), z(zw_.x), w(zw_.y) {}
+	SW_WIDE_FN vvec4(const vvec2& xy_, const vfloat& z_, const vfloat& w_) : x(xy_.x), y(xy_.y), z(z_), w(w_) {}
+	SW_WIDE_FN vvec4(const vfloat& x_, const vvec2& yz_, const vfloat& w_) : x(x_), y(yz_.x), z(yz_.y), w(w_) {}
+	SW_WIDE_FN vvec4(const vfloat& x_, const vfloat& y_, const vvec2& zw_) : x(x_), y(y_), z(zw_.x), w(zw_.y) {}
+	SW_WIDE_FN vvec4(const vec4& v) : x(v.x), y(v.y), z(v.z), w(v.w) {}
+
+	SW_WIDE_FN vvec4& operator+=(const vvec4& o) { x += o.x; y += o.y; z += o.z; w += o.w; return *this; }
+	SW_WIDE_FN vvec4& operator-=(const vvec4& o) { x -= o.x; y -= o.y; z -= o.z; w -= o.w; return *this; }
+	SW_WIDE_FN vvec4& operator*=(const vvec4& o) { x *= o.x; y *= o.y; z *= o.z; w *= o.w; return *this; }
+	SW_WIDE_FN vvec4& operator/=(const vvec4& o) { x /= o.x; y /= o.y; z /= o.z; w /= o.w; return *this; }
+	SW_WIDE_FN vvec4& operator*=(const vfloat& o) { x *= o; y *= o; z *= o; w *= o; return *this; }
+	SW_WIDE_FN vvec4& operator/=(const vfloat& o) { x /= o; y /= o; z /= o; w /= o; return *this; }
+
+	SW_WIDE_FN vvec2 xy() const { return vvec2(x, y); }
+	SW_WIDE_FN vvec2 xx() const { return vvec2(x, x); }
+	SW_WIDE_FN vvec2 yy() const { return vvec2(y, y); }
+	SW_WIDE_FN vvec2 xz() const { return vvec2(x, z); }
+	SW_WIDE_FN vvec2 yz() const { return vvec2(y, z); }
+	SW_WIDE_FN vvec2 yw() const { return vvec2(y, w); }
+	SW_WIDE_FN vvec2 zw() const { return vvec2(z, w); }
+	SW_WIDE_FN vvec3 xyz() const { return vvec3(x, y, z); }
+	SW_WIDE_FN vvec3 yzw() const { return vvec3(y, z, w); }
+	SW_WIDE_FN vvec3 www() const { return vvec3(w, w, w); }
+	SW_WIDE_FN vvec4 xyzw() const { return vvec4(x, y, z, w); }
+	SW_WIDE_FN vvec4 xyxy() const { return vvec4(x, y, x, y); }
+	SW_WIDE_FN vvec4 xxzz() const { return vvec4(x, x, z, z); }
+};
+
+SW_WIDE_FN vvec2::vvec2(const vvec3& v) : x(v.x), y(v.y) {}
+SW_WIDE_FN vvec2::vvec2(const vvec4& v) : x(v.x), y(v.y) {}
+SW_WIDE_FN vvec3::vvec3(const vvec4& v) : x(v.x), y(v.y), z(v.z) {}
+SW_WIDE_FN vvec4 vvec2::xyxy() const { return vvec4(x, y, x, y); }
+
+#define SW_DEFINE_VVEC2_OP(OP) \
+	SW_WIDE_FN vvec2 operator OP(const vvec2& a, const vvec2& b) { return vvec2(a.x OP b.x, a.y OP b.y); } \
+	SW_WIDE_FN vvec2 operator OP(const vvec2& a, const vfloat& b) { return vvec2(a.x OP b, a.y OP b); } \
+	SW_WIDE_FN vvec2 operator OP(const vfloat& a, const vvec2& b) { return vvec2(a OP b.x, a OP b.y); }
+#define SW_DEFINE_VVEC3_OP(OP) \
+	SW_WIDE_FN vvec3 operator OP(const vvec3& a, const vvec3& b) { return vvec3(a.x OP b.x, a.y OP b.y, a.z OP b.z); } \
+	SW_WIDE_FN vvec3 operator OP(const vvec3& a, const vfloat& b) { return vvec3(a.x OP b, a.y OP b, a.z OP b); } \
+	SW_WIDE_FN vvec3 operator OP(const vfloat& a, const vvec3& b) { return vvec3(a OP b.x, a OP b.y, a OP b.z); }
+#define SW_DEFINE_VVEC4_OP(OP) \
+	SW_WIDE_FN vvec4 operator OP(const vvec4& a, const vvec4& b) { return vvec4(a.x OP b.x, a.y OP b.y, a.z OP b.z, a.w OP b.w); } \
+	SW_WIDE_FN vvec4 operator OP(const vvec4& a, const vfloat& b) { return vvec4(a.x OP b, a.y OP b, a.z OP b, a.w OP b); } \
+	SW_WIDE_FN vvec4 operator OP(const vfloat& a, const vvec4& b) { return vvec4(a OP b.x, a OP b.y, a OP b.z, a OP b.w); }
+
+SW_DEFINE_VVEC2_OP(+) SW_DEFINE_VVEC2_OP(-) SW_DEFINE_VVEC2_OP(*) SW_DEFINE_VVEC2_OP(/)
+SW_DEFINE_VVEC3_OP(+) SW_DEFINE_VVEC3_OP(-) SW_DEFINE_VVEC3_OP(*) SW_DEFINE_VVEC3_OP(/)
+SW_DEFINE_VVEC4_OP(+) SW_DEFINE_VVEC4_OP(-) SW_DEFINE_VVEC4_OP(*) SW_DEFINE_VVEC4_OP(/)
+
+#undef SW_DEFINE_VVEC2_OP
+#undef SW_DEFINE_VVEC3_OP
+#undef SW_DEFINE_VVEC4_OP
+
+SW_WIDE_FN vvec2 operator-(const vvec2& v) { return vvec2(-v.x, -v.y); }
+SW_WIDE_FN vvec3 operator-(const vvec3& v) { return vvec3(-v.x, -v.y, -v.z); }
+SW_WIDE_FN vvec4 operator-(const vvec4& v) { return vvec4(-v.x, -v.y, -v.z, -v.w); }
+
+SW_WIDE_FN vvec2 select(const vmask& m, const vvec2& a, const vvec2& b) { return vvec2(select(m, a.x, b.x), select(m, a.y, b.y)); }
+SW_WIDE_FN vvec3 select(const vmask& m, const vvec3& a, const vvec3& b) { return vvec3(select(m, a.x, b.x), select(m, a.y, b.y), select(m, a.z, b.z)); }
+SW_WIDE_FN vvec4 select(const vmask& m, const vvec4& a, const vvec4& b) { return vvec4(select(m, a.x, b.x), select(m, a.y, b.y), select(m, a.z, b.z), select(m, a.w, b.w)); }
+
+// Wide built-in functions, same semantics and the same operations as the scalar ones
+
+SW_WIDE_FN vfloat radians(const vfloat& d) { return d * vfloat(0.01745329251994329577f); }
+SW_WIDE_FN vfloat degrees(const vfloat& r) { return r * vfloat(57.2957795130823208768f); }
+SW_WIDE_FN vfloat inversesqrt(const vfloat& x) { return vfloat(1.0f) / sqrt(x); }
+SW_WIDE_FN vfloat sign(const vfloat& x) { return select(x > vfloat(0.0f), vfloat(1.0f), select(x < vfloat(0.0f), vfloat(-1.0f), vfloat(0.0f))); }
+SW_WIDE_FN vfloat ceil(const vfloat& x) { return -floor(-x); }
+SW_WIDE_FN vfloat round(const vfloat& x) { return floor(x + vfloat(0.5f)); }
+SW_WIDE_FN vfloat fract(const vfloat& x) { return x - floor(x); }
+SW_WIDE_FN vfloat mod(const vfloat& x, const vfloat& y) { return x - y * floor(x / y); }
+SW_WIDE_FN vfloat min(const vfloat& x, const vfloat& y) { return select(x < y, x, y); }
+SW_WIDE_FN vfloat max(const vfloat& x, const vfloat& y) { return select(x > y, x, y); }
+SW_WIDE_FN vfloat clamp(const vfloat& x, const vfloat& lo, const vfloat& hi) { return select(x < lo, lo, select(x > hi, hi, x)); }
+SW_WIDE_FN vfloat mix(const vfloat& a, const vfloat& b, const vfloat& t) { return a * (vfloat(1.0f) - t) + b * t; }
+SW_WIDE_FN vfloat step(const vfloat& edge, const vfloat& x) { return select(x < edge, vfloat(0.0f), vfloat(1.0f)); }
+SW_WIDE_FN vfloat smoothstep(const vfloat& e0, const vfloat& e1, const vfloat& x)
+{
+	vfloat t = clamp((x - e0) / (e1 - e0), vfloat(0.0f), vfloat(1.0f));
+	return t * t * (vfloat(3.0f) - vfloat(2.0f) * t);
+}
+SW_WIDE_FN vfloat sin(const vfloat& x) { return detail::sinPoly(x); }
+SW_WIDE_FN vfloat cos(const vfloat& x) { return detail::cosPoly(x); }
+SW_WIDE_FN vfloat tan(const vfloat& x) { return detail::sinPoly(x) / detail::cosPoly(x); }
+SW_WIDE_FN vfloat asin(const vfloat& x) { return detail::asinPoly(x); }
+SW_WIDE_FN vfloat acos(const vfloat& x) { return detail::acosPoly(x); }
+SW_WIDE_FN vfloat atan(const vfloat& x) { return detail::atanPoly(x); }
+SW_WIDE_FN vfloat atan(const vfloat& y, const vfloat& x) { return detail::atan2Poly(y, x); }
+SW_WIDE_FN vfloat pow(const vfloat& x, const vfloat& y) { return detail::powPoly(x, y); }
+SW_WIDE_FN vfloat exp2(const vfloat& x) { return detail::exp2Poly(x); }
+SW_WIDE_FN vfloat log2(const vfloat& x) { return detail::log2Poly(x); }
+
+// Component-wise vector wrappers over the wide scalar built-ins
+#define SW_WIDE_UNARY(func) \
+	SW_WIDE_FN vvec2 func(const vvec2& v) { return vvec2(func(v.x), func(v.y)); } \
+	SW_WIDE_FN vvec3 func(const vvec3& v) { return vvec3(func(v.x), func(v.y), func(v.z)); } \
+	SW_WIDE_FN vvec4 func(const vvec4& v) { return vvec4(func(v.x), func(v.y), func(v.z), func(v.w)); }
+SW_WIDE_UNARY(sin) SW_WIDE_UNARY(cos) SW_WIDE_UNARY(tan) SW_WIDE_UNARY(asin) SW_WIDE_UNARY(acos) SW_WIDE_UNARY(atan)
+SW_WIDE_UNARY(exp2) SW_WIDE_UNARY(log2) SW_WIDE_UNARY(sqrt) SW_WIDE_UNARY(inversesqrt) SW_WIDE_UNARY(abs) SW_WIDE_UNARY(sign)
+SW_WIDE_UNARY(floor) SW_WIDE_UNARY(ceil) SW_WIDE_UNARY(round) SW_WIDE_UNARY(fract) SW_WIDE_UNARY(radians) SW_WIDE_UNARY(degrees)
+#undef SW_WIDE_UNARY
+
+#define SW_WIDE_BINARY(func) \
+	SW_WIDE_FN vvec2 func(const vvec2& a, const vvec2& b) { return vvec2(func(a.x, b.x), func(a.y, b.y)); } \
+	SW_WIDE_FN vvec3 func(const vvec3& a, const vvec3& b) { return vvec3(func(a.x, b.x), func(a.y, b.y), func(a.z, b.z)); } \
+	SW_WIDE_FN vvec4 func(const vvec4& a, const vvec4& b) { return vvec4(func(a.x, b.x), func(a.y, b.y), func(a.z, b.z), func(a.w, b.w)); } \
+	SW_WIDE_FN vvec2 func(const vvec2& a, const vfloat& b) { return vvec2(func(a.x, b), func(a.y, b)); } \
+	SW_WIDE_FN vvec3 func(const vvec3& a, const vfloat& b) { return vvec3(func(a.x, b), func(a.y, b), func(a.z, b)); } \
+	SW_WIDE_FN vvec4 func(const vvec4& a, const vfloat& b) { return vvec4(func(a.x, b), func(a.y, b), func(a.z, b), func(a.w, b)); }
+SW_WIDE_BINARY(pow) SW_WIDE_BINARY(mod) SW_WIDE_BINARY(min) SW_WIDE_BINARY(max)
+#undef SW_WIDE_BINARY
+
+SW_WIDE_FN vvec2 step(const vvec2& e, const vvec2& x) { return vvec2(step(e.x, x.x), step(e.y, x.y)); }
+SW_WIDE_FN vvec3 step(const vvec3& e, const vvec3& x) { return vvec3(step(e.x, x.x), step(e.y, x.y), step(e.z, x.z)); }
+SW_WIDE_FN vvec4 step(const vvec4& e, const vvec4& x) { return vvec4(step(e.x, x.x), step(e.y, x.y), step(e.z, x.z), step(e.w, x.w)); }
+SW_WIDE_FN vvec2 step(const vfloat& e, const vvec2& x) { return vvec2(step(e, x.x), step(e, x.y)); }
+SW_WIDE_FN vvec3 step(const vfloat& e, const vvec3& x) { return vvec3(step(e, x.x), step(e, x.y), step(e, x.z)); }
+SW_WIDE_FN vvec4 step(const vfloat& e, const vvec4& x) { return vvec4(step(e, x.x), step(e, x.y), step(e, x.z), step(e, x.w)); }
+
+SW_WIDE_FN vvec2 clamp(const vvec2& v, const vfloat& lo, const vfloat& hi) { return vvec2(clamp(v.x, lo, hi), clamp(v.y, lo, hi)); }
+SW_WIDE_FN vvec3 clamp(const vvec3& v, const vfloat& lo, const vfloat& hi) { return vvec3(clamp(v.x, lo, hi), clamp(v.y, lo, hi), clamp(v.z, lo, hi)); }
+SW_WIDE_FN vvec4 clamp(const vvec4& v, const vfloat& lo, const vfloat& hi) { return vvec4(clamp(v.x, lo, hi), clamp(v.y, lo, hi), clamp(v.z, lo, hi), clamp(v.w, lo, hi)); }
+SW_WIDE_FN vvec2 clamp(const vvec2& v, const vvec2& lo, const vvec2& hi) { return vvec2(clamp(v.x, lo.x, hi.x), clamp(v.y, lo.y, hi.y)); }
+SW_WIDE_FN vvec3 clamp(const vvec3& v, const vvec3& lo, const vvec3& hi) { return vvec3(clamp(v.x, lo.x, hi.x), clamp(v.y, lo.y, hi.y), clamp(v.z, lo.z, hi.z)); }
+SW_WIDE_FN vvec4 clamp(const vvec4& v, const vvec4& lo, const vvec4& hi) { return vvec4(clamp(v.x, lo.x, hi.x), clamp(v.y, lo.y, hi.y), clamp(v.z, lo.z, hi.z), clamp(v.w, lo.w, hi.w)); }
+
+SW_WIDE_FN vvec2 mix(const vvec2& a, const vvec2& b, const vfloat& t) { return vvec2(mix(a.x, b.x, t), mix(a.y, b.y, t)); }
+SW_WIDE_FN vvec3 mix(const vvec3& a, const vvec3& b, const vfloat& t) { return vvec3(mix(a.x, b.x, t), mix(a.y, b.y, t), mix(a.z, b.z, t)); }
+SW_WIDE_FN vvec4 mix(const vvec4& a, const vvec4& b, const vfloat& t) { return vvec4(mix(a.x, b.x, t), mix(a.y, b.y, t), mix(a.z, b.z, t), mix(a.w, b.w, t)); }
+SW_WIDE_FN vvec2 mix(const vvec2& a, const vvec2& b, const vvec2& t) { return vvec2(mix(a.x, b.x, t.x), mix(a.y, b.y, t.y)); }
+SW_WIDE_FN vvec3 mix(const vvec3& a, const vvec3& b, const vvec3& t) { return vvec3(mix(a.x, b.x, t.x), mix(a.y, b.y, t.y), mix(a.z, b.z, t.z)); }
+SW_WIDE_FN vvec4 mix(const vvec4& a, const vvec4& b, const vvec4& t) { return vvec4(mix(a.x, b.x, t.x), mix(a.y, b.y, t.y), mix(a.z, b.z, t.z), mix(a.w, b.w, t.w)); }
+
+SW_WIDE_FN vvec2 smoothstep(const vfloat& e0, const vfloat& e1, const vvec2& x) { return vvec2(smoothstep(e0, e1, x.x), smoothstep(e0, e1, x.y)); }
+SW_WIDE_FN vvec3 smoothstep(const vfloat& e0, const vfloat& e1, const vvec3& x) { return vvec3(smoothstep(e0, e1, x.x), smoothstep(e0, e1, x.y), smoothstep(e0, e1, x.z)); }
+SW_WIDE_FN vvec4 smoothstep(const vfloat& e0, const vfloat& e1, const vvec4& x) { return vvec4(smoothstep(e0, e1, x.x), smoothstep(e0, e1, x.y), smoothstep(e0, e1, x.z), smoothstep(e0, e1, x.w)); }
+
+SW_WIDE_FN vfloat dot(const vvec2& a, const vvec2& b) { return a.x * b.x + a.y * b.y; }
+SW_WIDE_FN vfloat dot(const vvec3& a, const vvec3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+SW_WIDE_FN vfloat dot(const vvec4& a, const vvec4& b) { return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w; }
+SW_WIDE_FN vvec3 cross(const vvec3& a, const vvec3& b) { return vvec3(a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x); }
+SW_WIDE_FN vfloat length(const vvec2& v) { return sqrt(dot(v, v)); }
+SW_WIDE_FN vfloat length(const vvec3& v) { return sqrt(dot(v, v)); }
+SW_WIDE_FN vfloat length(const vvec4& v) { return sqrt(dot(v, v)); }
+SW_WIDE_FN vfloat distance(const vvec2& a, const vvec2& b) { return length(a - b); }
+SW_WIDE_FN vfloat distance(const vvec3& a, const vvec3& b) { return length(a - b); }
+SW_WIDE_FN vfloat distance(const vvec4& a, const vvec4& b) { return length(a - b); }
+SW_WIDE_FN vvec2 normalize(const vvec2& v) { return v * (vfloat(1.0f) / length(v)); }
+SW_WIDE_FN vvec3 normalize(const vvec3& v) { return v * (vfloat(1.0f) / length(v)); }
+SW_WIDE_FN vvec4 normalize(const vvec4& v) { return v * (vfloat(1.0f) / length(v)); }
+SW_WIDE_FN vvec2 reflect(const vvec2& i, const vvec2& n) { return i - n * (vfloat(2.0f) * dot(n, i)); }
+SW_WIDE_FN vvec3 reflect(const vvec3& i, const vvec3& n) { return i - n * (vfloat(2.0f) * dot(n, i)); }
+SW_WIDE_FN vvec4 reflect(const vvec4& i, const vvec4& n) { return i - n * (vfloat(2.0f) * dot(n, i)); }
+
+// The same approximated screen-space derivatives as the scalar overloads
+SW_WIDE_FN vfloat dFdx(const vfloat&) { return vfloat(0.02f); }
+SW_WIDE_FN vfloat dFdy(const vfloat&) { return vfloat(0.02f); }
+SW_WIDE_FN vvec2 dFdx(const vvec2&) { return vvec2(vfloat(0.02f)); }
+SW_WIDE_FN vvec2 dFdy(const vvec2&) { return vvec2(vfloat(0.02f)); }
+SW_WIDE_FN vvec3 dFdx(const vvec3&) { return vvec3(vfloat(0.02f)); }
+SW_WIDE_FN vvec3 dFdy(const vvec3&) { return vvec3(vfloat(0.02f)); }
+SW_WIDE_FN vvec4 dFdx(const vvec4&) { return vvec4(vfloat(0.02f)); }
+SW_WIDE_FN vvec4 dFdy(const vvec4&) { return vvec4(vfloat(0.02f)); }
+SW_WIDE_FN vfloat fwidth(const vfloat&) { return vfloat(0.04f); }
+SW_WIDE_FN vvec2 fwidth(const vvec2&) { return vvec2(vfloat(0.04f)); }
+SW_WIDE_FN vvec3 fwidth(const vvec3&) { return vvec3(vfloat(0.04f)); }
+SW_WIDE_FN vvec4 fwidth(const vvec4&) { return vvec4(vfloat(0.04f)); }
+
+namespace detail
+{
+	/** Transposes per-lane samples into one wide vector */
+	SW_WIDE_FN vvec4 fromLanes(const vec4 (&lanes)[SW_WIDE_LANES])
+	{
+		float r[SW_WIDE_LANES], g[SW_WIDE_LANES], b[SW_WIDE_LANES], a[SW_WIDE_LANES];
+		for (std::int32_t i = 0; i < SW_WIDE_LANES; i++) {
+			r[i] = lanes[i].r;
+			g[i] = lanes[i].g;
+			b[i] = lanes[i].b;
+			a[i] = lanes[i].a;
+		}
+		return vvec4(vfloat::load(r), vfloat::load(g), vfloat::load(b), vfloat::load(a));
+	}
+}
+
+/** @brief Interpolated texture coordinates of the pixels, the wide `vTexCoords` */
+SW_WIDE_FN vvec2 swTexCoords(const SW_WIDE_INPUT& in)
+{
+	return vvec2(vfloat::load(in.u), vfloat::load(in.v));
+}
+
+/** @brief Wide @ref sw::swTexture(), samples each lane at its own coordinate */
+SW_WIDE_FN vvec4 swTexture(const SW_WIDE_INPUT& in, int unit, const vvec2& uv)
+{
+	float u[SW_WIDE_LANES], v[SW_WIDE_LANES];
+	uv.x.store(u);
+	uv.y.store(v);
+	vec4 lanes[SW_WIDE_LANES];
+	for (std::int32_t i = 0; i < SW_WIDE_LANES; i++) {
+		lanes[i] = sw::detail::sampleTexture(in.textures, unit, vec2(u[i], v[i]));
+	}
+	return detail::fromLanes(lanes);
+}
+
+/** @brief Wide @ref sw::swTexturePrimary(), reads back the texels the rasterizer already gathered */
+SW_WIDE_FN vvec4 swTexturePrimary(const SW_WIDE_INPUT& in, int unit)
+{
+	vec4 lanes[SW_WIDE_LANES];
+	for (std::int32_t i = 0; i < SW_WIDE_LANES; i++) {
+		lanes[i] = sw::detail::readPrimaryTexel(in.textures, unit, in.rgba + i * 4, in.u[i], in.v[i]);
+	}
+	return detail::fromLanes(lanes);
+}
+
+/** @brief Wide @ref sw::packColor(), writes all output pixels */
+SW_WIDE_FN void packColor(const vvec4& c, std::uint8_t* rgba)
+{
+	detail::packLanes(c.x, c.y, c.z, c.w, rgba);
+}
+
+/**
+ * @brief Wide @ref sw::packColor() that writes only the pixels of @p lanes
+ *
+ * Used by kernels whose `main()` may return early: a pixel that returned keeps its input color, just
+ * like the scalar kernel that skips its final `packColor()`.
+ */
+SW_WIDE_FN void packColor(const vvec4& c, std::uint8_t* rgba, const vmask& lanes)
+{
+	if (all(lanes)) {
+		detail::packLanes(c.x, c.y, c.z, c.w, rgba);
+		return;
+	}
+	std::uint8_t packed[SW_WIDE_LANES * 4];
+	detail::packLanes(c.x, c.y, c.z, c.w, packed);
+	for (std::int32_t i = 0; i < SW_WIDE_LANES; i++) {
+		if (lanes.lane(i)) {
+			std::memcpy(rgba + i * 4, packed + i * 4, 4);
+		}
+	}
+}
+
+#undef SW_WIDE_LANES
+#undef SW_WIDE_FN
+#undef SW_WIDE_INPUT
@@ -1,6 +1,7 @@
 #include "SwTexture.h"
 #include "SwDevice.h"
 #include "SwRaster.h"
+#include "SwTileRenderer.h"
 
 #include <cstring>
 
@@ -49,6 +50,10 @@ namespace nCine::RHI::Software
 		// Clear from the device so a destroyed texture can't dangle in _boundTextures (a later deferred draw would
 		// dereference freed memory in Dispatch)
 		SwDevice::UnbindTexture(this);
+		// The previous frame may still be rasterized asynchronously from this texture's store
+		SwRaster::WaitForAsyncFlush();
+		// A render target store about to be freed must not keep its remembered tiles, another one may reuse the address
+		SwTileRenderer::InvalidateTarget(_pixels.data());
 	}
 
 	std::int32_t SwTexture::BytesPerPixel(PixelFormat format)
@@ -87,6 +92,7 @@ namespace nCine::RHI::Software
 		// reallocated so no worker rasterizes from freed memory. A no-op when nothing is queued.
 		if (!_pixels.empty()) {
 			SwRaster::Flush();
+			SwTileRenderer::InvalidateTarget(_pixels.data());
 		}
 		_pixels.assign(std::size_t(_strideBytes) * std::size_t(height > 0 ? height : 0), std::uint8_t(0));
 		// The store content changed; the counter is process-global so a stamp is never repeated, even by
@@ -158,6 +164,9 @@ namespace nCine::RHI::Software
 		if (level != 0 || data == nullptr || _pixels.empty()) {
 			return;
 		}
+		// The previous frame may still sample the store, see SwRaster::FlushAsync()
+		SwRaster::WaitForAsyncFlush();
+		SwTileRenderer::InvalidateTarget(_pixels.data());
 		const std::int32_t srcBpp = BytesPerPixel(format);
 		const std::int32_t dstBpp = BytesPerPixel(_format);
 		for (std::int32_t y = 0; y < height; y++) {
@@ -223,6 +232,10 @@ namespace nCine::RHI::Software
 		if (pixels == nullptr || _pixels.empty()) {
 			return;
 		}
+		if (_isRenderTarget) {
+			// Draws (and clears) into a render target are deferred, make them land before reading it back
+			SwRaster::Flush();
+		}
 		const std::int32_t dstBpp = BytesPerPixel(format);
 		if (dstBpp <= 0 || dstBpp == _bytesPerPixel) {
 			// The store already matches the requested layout (the common case - native R8/RG8 reads back
@@ -252,21 +265,25 @@ namespace nCine::RHI::Software
 
 	void SwTexture::SetMinFiltering(nCine::SamplerFilter filter)
 	{
+		SwRaster::WaitForAsyncFlush();
 		_minFilter = filter;
 	}
 
 	void SwTexture::SetMagFiltering(nCine::SamplerFilter filter)
 	{
+		SwRaster::WaitForAsyncFlush();
 		_magFilter = filter;
 	}
 
 	void SwTexture::SetWrap(SamplerWrapping wrap)
 	{
+		SwRaster::WaitForAsyncFlush();
 		_wrap = wrap;
 	}
 
 	void SwTexture::SetSwizzle(SwizzleChannel r, SwizzleChannel g, SwizzleChannel b, SwizzleChannel a)
 	{
+		SwRaster::WaitForAsyncFlush();
 		_swizzle[0] = r;
 		_swizzle[1] = g;
 		_swizzle[2] = b;
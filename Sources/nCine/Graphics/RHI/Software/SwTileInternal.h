@@ -0,0 +1,35 @@
+#pragma once
+
+#if defined(WITH_RHI_SOFTWARE)
+
+#include "SwTileRenderer.h"
+
+#include <cstdint>
+
+namespace nCine::RHI::Software
+{
+	// Per-tile rasterization entry points, defined in SwTileRasterizer.cpp and called from SwTileRenderer::ProcessTile.
+	// Kept in this internal namespace so they have external linkage across the two translation units without leaking
+	// into the public API.
+	namespace TileInternal
+	{
+		/** @brief Prepares a procedural quad command once at submit time, leaves `prep.valid` false if it draws nothing */
+		void PrepareQuad(const DrawContext& ctx, std::int32_t viewportX, std::int32_t viewportY,
+		                 std::int32_t viewportW, std::int32_t viewportH, SwTileRenderer::PreparedQuad& prep);
+
+		/** @brief Renders a single command into the tile buffer */
+		void RenderCommandToTile(const DrawContext& ctx, const SwTileRenderer::PreparedQuad* prep,
+		                         PrimitiveType type,
+		                         std::int32_t firstVertex, std::int32_t count,
+		                         std::uint8_t* tileBuffer, std::int32_t tileX, std::int32_t tileY,
+		                         std::int32_t tileW, std::int32_t tileH,
+		                         std::int32_t viewportX, std::int32_t viewportY,
+		                         std::int32_t viewportW, std::int32_t viewportH);
+
+		/** @brief Blits the cells of a tile layer that overlap the tile into the tile buffer */
+		void RenderTileLayerToTile(const SwTileRenderer::PreparedTileLayer& layer, std::uint8_t* tileBuffer,
+		                           std::int32_t tileX, std::int32_t tileY, std::int32_t tileW, std::int32_t tileH);
+	}
+}
+
+#endif
@@ -1,6 +1,6 @@
 #if defined(WITH_RHI_SOFTWARE)
 
-#include "SwTileRenderer.h"
+#include "SwTileInternal.h"
 #include "SwScanlineOps.h"
 
 #include <algorithm>
@@ -19,8 +19,8 @@ namespace nCine::RHI::Software
 
 	// Per-tile rasterization, called from SwTileRenderer::ProcessTile. All the sampling / blend / vertex
 	// helpers below are file-local (internal linkage) copies of the immediate rasterizer's math kept in
-	// SwRaster.cpp — the tile path is standalone, so nothing crosses the TU boundary except
-	// RenderCommandToTile (external linkage), which SwTileRenderer.cpp forward-declares and calls.
+	// SwRaster.cpp — the tile path is standalone, so nothing crosses the TU boundary except the entry points
+	// declared in SwTileInternal.h (external linkage): PrepareQuad, RenderCommandToTile and RenderTileLayerToTile.
 	namespace TileInternal
 	{
 		// =====================================================================
@@ -696,6 +696,8 @@ namespace nCine::RHI::Software
 			// aliases with ctx through FragmentShaderInput). Flush() already waits on workersActive before
 			// returning, so ctx is guaranteed not to be overwritten while workers run.
 			const FragmentShaderFn cachedShader = ctx.fragmentShader;
+			const FragmentShader4Fn cachedShader4 = ctx.fragmentShader4;
+			const FragmentShader8Fn cachedShader8 = ctx.fragmentShader8;
 
 			for (std::int32_t py = yMin; py <= yMax; py++, tyFix += dtyFix) {
 				// Tile-local row offset
@@ -820,16 +822,10 @@ namespace nCine::RHI::Software
 						fsInput.textures = ctx.textures;
 						fsInput.color = ctx.ff.color;
 						fsInput.userData = ctx.fragmentShaderUserData;
+						fsInput.x = xMin;
+						fsInput.y = py;
 						const float invTexW = 1.0f / static_cast<float>(texW > 0 ? texW : 1);
-						std::int32_t txFixShader = txBase;
-						for (std::int32_t i = 0; i < scanWidth; i++) {
-							fsInput.rgba = &scanBuf[i * 4];
-							fsInput.u = txFixShader / 65536.0f * invTexW;
-							fsInput.x = xMin + i;
-							fsInput.y = py;
-							cachedShader(fsInput);
-							txFixShader += dtxFix;
-						}
+						ShadeScanline(cachedShader, cachedShader4, cachedShader8, fsInput, scanBuf, scanWidth, txBase, dtxFix, invTexW);
 					} else if DEATH_UNLIKELY(!whiteTint) {
 						TintScanline(scanBuf, scanWidth, tR, tG, tB, tA);
 					}
@@ -1404,6 +1400,138 @@ namespace nCine::RHI::Software
 					break;
 			}
 		}
+
+		// =====================================================================
+		// Tile layer: direct blit of the cells overlapping the tile
+		// Each cell maps its atlas tile 1:1 onto pixels (SubmitTileLayer accepts nothing else), so a row of a
+		// cell is one run of consecutive atlas texels - read backwards for a mirrored cell. The submit-time
+		// spans skip the rows and row ends that write nothing, and the opaque rows of an opaque cell alpha
+		// are stored without reading the destination. The output is bit-identical to the cell's quad drawn
+		// through the axis-aligned rasterizer (the fused palette LUT, or gather + tint + fast blend).
+		// =====================================================================
+		void RenderTileLayerToTile(const SwTileRenderer::PreparedTileLayer& layer, std::uint8_t* tileBuffer,
+		                           std::int32_t tileX, std::int32_t tileY, std::int32_t tileW, std::int32_t tileH)
+		{
+			constexpr std::int32_t CellSize = SwTileRenderer::TileLayerCellSize;
+
+			const std::int32_t x0 = std::max(tileX, layer.clipMinX);
+			const std::int32_t y0 = std::max(tileY, layer.clipMinY);
+			const std::int32_t x1 = std::min(tileX + tileW - 1, layer.clipMaxX);
+			const std::int32_t y1 = std::min(tileY + tileH - 1, layer.clipMaxY);
+			if (x0 > x1 || y0 > y1) {
+				return;
+			}
+			// The clip rectangle never leaves the grid, so all of these are valid cell coordinates
+			const std::int32_t col0 = (x0 - layer.originX) / CellSize;
+			const std::int32_t row0 = (y0 - layer.originY) / CellSize;
+			const std::int32_t col1 = (x1 - layer.originX) / CellSize;
+			const std::int32_t row1 = (y1 - layer.originY) / CellSize;
+
+			const std::int32_t texBpp = layer.texBpp;
+			const std::size_t texRowBytes = std::size_t(layer.texW) * texBpp;
+			alignas(16) std::uint8_t scanBuf[CellSize * 4];
+			std::uint8_t indexBuf[CellSize];
+
+			for (std::int32_t row = row0; row <= row1; row++) {
+				for (std::int32_t col = col0; col <= col1; col++) {
+					const SwTileRenderer::PreparedTileLayerCell& cell = layer.cells[row * layer.columns + col];
+					if (cell.texelOffset < 0) {
+						continue;
+					}
+
+					// Pixels of the cell inside the clipped tile, in cell-local coordinates
+					const std::int32_t cellX = layer.originX + col * CellSize;
+					const std::int32_t cellY = layer.originY + row * CellSize;
+					const std::int32_t cx0 = std::max(x0, cellX) - cellX;
+					const std::int32_t cx1 = std::min(x1, cellX + CellSize - 1) - cellX;
+					const std::int32_t cy0 = std::max(y0, cellY) - cellY;
+					const std::int32_t cy1 = std::min(y1, cellY + CellSize - 1) - cellY;
+
+					const bool flipX = (cell.flags & SwTileRenderer::TileLayerFlipX) != 0;
+					const bool flipY = (cell.flags & SwTileRenderer::TileLayerFlipY) != 0;
+					const std::uint8_t* texBase = layer.texPixels + cell.texelOffset;
+					const SwPaletteLut* lut = (layer.indexed ? layer.luts[cell.alphaIndex] : nullptr);
+					const std::int32_t* tint = layer.tint[cell.alphaIndex];
+					const bool whiteTint = layer.whiteTint[cell.alphaIndex];
+					const bool opaqueAlpha = layer.opaqueAlpha[cell.alphaIndex];
+					// The dominant layer: R8 indices with a constant source alpha, the LUT entry is the final pixel
+					const bool directLut = (lut != nullptr && texBpp == 1 && lut->indexByteOffset == 0 && lut->alphaByteOffset < 0);
+
+					for (std::int32_t cy = cy0; cy <= cy1; cy++) {
+						const std::int32_t texRow = (flipY ? CellSize - 1 - cy : cy);
+						const std::uint32_t rowBit = (1u << texRow);
+						if (!(cell.spans.visibleRows & rowBit)) {
+							continue;
+						}
+						// Destination columns of the row's non-transparent texels
+						std::int32_t first = cell.spans.first[texRow];
+						std::int32_t last = cell.spans.last[texRow];
+						if (flipX) {
+							const std::int32_t mirroredFirst = CellSize - 1 - last;
+							last = CellSize - 1 - first;
+							first = mirroredFirst;
+						}
+						const std::int32_t dx0 = std::max(cx0, first);
+						const std::int32_t dx1 = std::min(cx1, last);
+						if (dx0 > dx1) {
+							continue;
+						}
+						const std::int32_t count = dx1 - dx0 + 1;
+						const bool storeRow = (opaqueAlpha && (cell.spans.opaqueRows & rowBit) != 0);
+
+						std::uint8_t* dst = tileBuffer + ((cellY + cy - tileY) * SwTileRenderer::TileSize + (cellX + dx0 - tileX)) * 4;
+						// Texel of the first destination column, the next ones follow forwards or backwards
+						const std::uint8_t* src = texBase + std::size_t(texRow) * texRowBytes +
+							std::size_t(flipX ? CellSize - 1 - dx0 : dx0) * texBpp;
+
+						if (lut != nullptr) {
+							if (directLut) {
+								const std::uint8_t* indices = src;
+								if (flipX) {
+									for (std::int32_t i = 0; i < count; i++) {
+										indexBuf[i] = src[-i];
+									}
+									indices = indexBuf;
+								}
+								if (storeRow) {
+									for (std::int32_t i = 0; i < count; i++) {
+										std::memcpy(&dst[i * 4], lut->packed[indices[i]], 4);
+									}
+								} else {
+									FusedLutBlendScanline(dst, indices, count, lut->packed);
+								}
+							} else {
+								const std::ptrdiff_t step = (flipX ? -texBpp : texBpp);
+								for (std::int32_t i = 0; i < count; i++) {
+									FusedPaletteLutBlendTexel(*lut, src + i * step, texBpp, &dst[i * 4], true);
+								}
+							}
+							continue;
+						}
+
+						if (storeRow && whiteTint && !flipX && texBpp == 4) {
+							std::memcpy(dst, src, std::size_t(count) * 4);
+							continue;
+						}
+						if (flipX) {
+							for (std::int32_t i = 0; i < count; i++) {
+								SwExpandTexel(&scanBuf[i * 4], src - std::ptrdiff_t(i) * texBpp, texBpp);
+							}
+						} else {
+							SwExpandTexelRun(scanBuf, src, count, texBpp);
+						}
+						if (!whiteTint) {
+							TintScanline(scanBuf, count, tint[0], tint[1], tint[2], tint[3]);
+						}
+						if (storeRow) {
+							std::memcpy(dst, scanBuf, std::size_t(count) * 4);
+						} else {
+							BlendScanlineSrcAlpha(dst, scanBuf, count);
+						}
+					}
+				}
+			}
+		}
 	}
 }
 
@@ -1,9 +1,12 @@
 #if defined(WITH_RHI_SOFTWARE)
 
 #include "SwTileRenderer.h"
+#include "SwTileInternal.h"
+#include "SwScanlineOps.h"
 #include "SwShaderRuntime.h"	// sw::swTexture / sw::floor / sw::mod, replicated by the palette-LUT builder
 
 #include <Containers/SmallVector.h>
+#include <Cryptography/xxHash.h>
 
 #if defined(DEATH_ENABLE_NEON)
 #	include <arm_neon.h>
@@ -15,25 +18,10 @@
 #include <cstring>
 
 using namespace Death::Containers;
+using namespace Death::Cryptography;
 
 namespace nCine::RHI::Software
 {
-	// Per-tile rasterization entry points, defined in SwTileRasterizer.cpp. Kept in this internal namespace
-	// so they have external linkage across the two translation units without leaking into the public API.
-	namespace TileInternal
-	{
-		void PrepareQuad(const DrawContext& ctx, std::int32_t viewportX, std::int32_t viewportY,
-		                 std::int32_t viewportW, std::int32_t viewportH, SwTileRenderer::PreparedQuad& prep);
-
-		void RenderCommandToTile(const DrawContext& ctx, const SwTileRenderer::PreparedQuad* prep,
-		                         PrimitiveType type,
-		                         std::int32_t firstVertex, std::int32_t count,
-		                         std::uint8_t* tileBuffer, std::int32_t tileX, std::int32_t tileY,
-		                         std::int32_t tileW, std::int32_t tileH,
-		                         std::int32_t viewportX, std::int32_t viewportY,
-		                         std::int32_t viewportW, std::int32_t viewportH);
-	}
-
 	namespace SwTileRenderer
 	{
 		// =====================================================================
@@ -55,22 +43,93 @@ namespace nCine::RHI::Software
 				std::int32_t alphaByteOffset;
 			};
 
-			struct TileState
+			// Hashes of the tiles last flushed into one destination surface (0 = unknown). A tile whose new hash
+			// matches still holds exactly the pixels it would be rasterized to, as long as nothing else wrote
+			// the surface in the meantime (see InvalidateTarget). With the double-buffered screen, each of the
+			// two screen stores has its own entry.
+			struct TileHistory
+			{
+				const std::uint8_t* buffer = nullptr;
+				std::int32_t fbWidth = 0;
+				std::int32_t fbHeight = 0;
+				bool isFboTarget = false;
+				std::uint32_t lastUsed = 0;
+				SmallVector<std::uint64_t, 0> tileHashes;
+			};
+
+			// One deferred dynamic-lighting combine (see SubmitLighting). The lights are a snapshot, because the
+			// compositor refills its array in the next frame while an asynchronous flush may still rasterize this
+			// one. They are binned to the tiles of the viewport rectangle as one flat index list per pass.
+			struct LightingPass
+			{
+				LightingParams params;
+				// Applied to a tile after the commands recorded before it, i.e. with an index below this one
+				std::int32_t commandIndex = 0;
+				// Inclusive tile rectangle covered by the viewport
+				std::int32_t tileMinX = 0, tileMinY = 0, tileMaxX = 0, tileMaxY = 0;
+				std::uint64_t paramsHash = 0;
+				SmallVector<SwLight, 0> lights;
+				SmallVector<std::uint64_t, 0> lightHashes;
+				// Lights of tile `i` of the rectangle (row-major) are binLights[binOffsets[i], binOffsets[i + 1])
+				SmallVector<std::uint32_t, 0> binOffsets;
+				SmallVector<std::uint16_t, 0> binLights;
+			};
+
+			// One deferred tile layer (see SubmitTileLayer), referenced by its command through tileLayerIndex
+			struct TileLayerPass
+			{
+				PreparedTileLayer layer;
+				// Inclusive tile rectangle covered by the layer's clip rectangle
+				std::int32_t tileMinX = 0, tileMinY = 0, tileMaxX = 0, tileMaxY = 0;
+				// What the layer writes into tile `i` of the rectangle (row-major), see TileLayerCoverage
+				SmallVector<std::uint8_t, 0> tileCoverage;
+				std::uint64_t paramsHash = 0;
+			};
+
+			enum TileLayerCoverage : std::uint8_t
+			{
+				TileLayerCoverageNone,		// No visible cell overlaps the tile
+				TileLayerCoveragePartial,	// The tile has to be drawn over its previous content
+				TileLayerCoverageOpaque		// Opaque cells overwrite every pixel of the tile
+			};
+
+			// Spans of one atlas tile cached by TileSpanCache, the slot of the 32x32 atlas block its top-left texel is in
+			struct TileSpanSlot
+			{
+				std::int32_t srcX = -1;
+				std::int32_t srcY = -1;
+				TileLayerSpans spans;
+			};
+
+			// Spans of the atlas tiles shown by tile layers, valid for as long as everything the classification
+			// depends on stays the same. With the 34-pixel pitch of tilesets, no two tiles share a slot.
+			struct TileSpanCache
+			{
+				const SwTexture* atlas = nullptr;
+				std::uint32_t atlasVersion = 0;
+				std::int32_t texBpp = 0;
+				const SwTexture* palette = nullptr;
+				std::uint32_t paletteVersion = 0;
+				float paletteOffset = 0.0f;
+				std::int32_t indexByteOffset = 0;
+				std::int32_t alphaByteOffset = 0;
+				bool indexed = false;
+				std::uint32_t lastUsed = 0;
+				std::int32_t slotsX = 0;
+				SmallVector<TileSpanSlot, 0> slots;
+			};
+
+			// Everything one flush window owns: the destination it was recorded for and its commands, bins
+			// and LUTs. There are two of them, so the main thread can record the next frame into one while
+			// the workers still rasterize the other (see FlushAsync).
+			struct CommandWindow
 			{
-				bool initialized = false;
 				std::int32_t fbWidth = 0;
 				std::int32_t fbHeight = 0;
 				std::int32_t tilesX = 0;
 				std::int32_t tilesY = 0;
 				std::int32_t totalTiles = 0;
 
-				// Viewport snapshotted into each submitted command (mirrors SwRaster's viewport so the
-				// deferred vertex transform is identical to the immediate one)
-				std::int32_t viewportX = 0;
-				std::int32_t viewportY = 0;
-				std::int32_t viewportW = 0;
-				std::int32_t viewportH = 0;
-
 				// Command arena: grows on demand up to MaxCommands and keeps both its capacity and each
 				// slot's heap allocations (vertexStorage) across frames, so steady state allocates nothing -
 				// exactly like the former fixed array, minus the ~3.6 MB worst-case static footprint. Slots
@@ -88,6 +147,23 @@ namespace nCine::RHI::Software
 				SmallVector<SwPaletteLut, 0> paletteLuts;
 				SmallVector<PaletteLutKey, 0> paletteLutKeys;
 
+				// Deferred lighting combines in submission order (see SubmitLighting), slots [0, lightingPassCount)
+				// are live, the rest keep their allocations for the next frames
+				SmallVector<LightingPass, 0> lightingPasses;
+				std::int32_t lightingPassCount = 0;
+
+				// Deferred tile layers (see SubmitTileLayer), slots [0, tileLayerCount) are live, the rest keep
+				// their allocations for the next frames
+				SmallVector<TileLayerPass, 0> tileLayers;
+				std::int32_t tileLayerCount = 0;
+
+				// Deferred full-surface clear (see SubmitClear), packed RGBA8
+				bool hasClear = false;
+				std::uint32_t clearColor = 0;
+
+				// Tile hashes of the destination, assigned when the window is flushed
+				TileHistory* history = nullptr;
+
 				// Current render target buffer
 				std::uint8_t* targetBuffer = nullptr;
 				bool isFboTarget = false;
@@ -96,6 +172,40 @@ namespace nCine::RHI::Software
 				// scratch either way; only the tile <-> framebuffer copies convert)
 				bool is16Bit = false;
 #endif
+			};
+
+			struct TileState
+			{
+				bool initialized = false;
+
+				// Viewport snapshotted into each submitted command (mirrors SwRaster's viewport so the
+				// deferred vertex transform is identical to the immediate one)
+				std::int32_t viewportX = 0;
+				std::int32_t viewportY = 0;
+				std::int32_t viewportW = 0;
+				std::int32_t viewportH = 0;
+
+				// Double-buffered flush windows: new commands are always recorded into `recording`, the
+				// workers rasterize `rasterizing` (the same window during a blocking Flush, the other one
+				// while an asynchronous flush is in flight)
+				CommandWindow windows[2];
+				CommandWindow* recording = &windows[0];
+				CommandWindow* rasterizing = nullptr;
+
+				// Tile hashes of the most recently flushed surfaces (least recently used entry is reused)
+				static constexpr std::int32_t MaxTileHistories = 4;
+				TileHistory histories[MaxTileHistories];
+				std::uint32_t historyClock = 0;
+
+				// Atlas tile spans of the most recently submitted tile layers (least recently used entry is reused),
+				// only ever accessed by the recording thread
+				static constexpr std::int32_t MaxTileSpanCaches = 4;
+				TileSpanCache tileSpanCaches[MaxTileSpanCaches];
+				std::uint32_t tileSpanClock = 0;
+
+				// Tile cache counters, folded from the per-worker ones after each flush (see GetTileCacheStats)
+				std::uint64_t processedTiles = 0;
+				std::uint64_t skippedTiles = 0;
 
 				// Worker threads for parallel tile processing
 #if defined(WITH_THREADS)
@@ -117,6 +227,10 @@ namespace nCine::RHI::Software
 				std::int32_t flushGeneration = 0; // Incremented each Flush to prevent worker re-entry
 				std::int32_t workerGeneration[MaxWorkers] = {}; // Last generation each worker processed
 
+				// Pipelined mode (see SetPipelined) and whether the `rasterizing` window is still in flight
+				bool pipelined = true;
+				bool asyncFlushPending = false;
+
 				// Signal and join the workers before this object's mutex / condition variables are destroyed
 				// at static teardown, so they are never left blocked on a destroyed primitive (the renderer
 				// keeps the pool alive for the whole process and has no explicit Shutdown() call site).
@@ -157,21 +271,12 @@ namespace nCine::RHI::Software
 				}
 			}
 
-			// Validates the fast-path constraints for a PaletteRemap draw (ctx.paletteRemapHint) and returns
-			// the index of a pooled SwPaletteLut for it, building one when no cached table matches. Returns -1
-			// when any constraint fails - the draw then keeps the generic transpiled fragment, so the LUT is a
-			// pure optimization. `ctx` must be the command's own snapshot (its userData already repointed).
-			std::int32_t AcquirePaletteLut(const DrawContext& ctx)
+			// Returns the index of a pooled SwPaletteLut of the window that remaps `indexTex` through the palette row
+			// `paletteOffset` of `palette` and multiplies by `tint`, building one when no cached table matches.
+			// Returns -1 when the index texture doesn't satisfy the fast-path constraints.
+			std::int32_t AcquirePaletteLut(CommandWindow& window, const SwTexture* indexTex, const SwTexture* palette,
+			                               float paletteOffset, const float tint[4])
 			{
-				// The parameter block is the transpiled fragment's single vPaletteOffset float
-				if (ctx.fragmentShader == nullptr || ctx.fragmentShaderUserData == nullptr ||
-				    ctx.fragmentShaderUserDataSize < sizeof(float)) {
-					return -1;
-				}
-				if (!ctx.ff.hasTexture || ctx.ff.textureUnit < 0 || ctx.ff.textureUnit >= std::int32_t(MaxTextureUnits)) {
-					return -1;
-				}
-				const SwTexture* indexTex = ctx.textures[ctx.ff.textureUnit];
 				if (indexTex == nullptr || indexTex->GetPixels(0) == nullptr ||
 				    indexTex->GetWidth() <= 0 || indexTex->GetHeight() <= 0) {
 					return -1;
@@ -204,10 +309,8 @@ namespace nCine::RHI::Software
 						return -1;
 					}
 				}
-				// The fragment samples the palette on unit 1 (PaletteRemap.shader: texture_unit(1)). A missing
-				// palette is fine (swTexture yields transparent black, baked below the same way), but a
-				// CPU-rendered target could change without a content-version bump, so it stays generic.
-				const SwTexture* palette = ctx.textures[1];
+				// A missing palette is fine (swTexture yields transparent black, baked below the same way), but a
+				// CPU-rendered target could change without a content-version bump, so it stays generic
 				if (palette != nullptr && palette->IsRenderTarget()) {
 					return -1;
 				}
@@ -215,18 +318,18 @@ namespace nCine::RHI::Software
 				PaletteLutKey key;
 				key.palette = palette;
 				key.paletteVersion = (palette != nullptr ? palette->GetContentVersion() : 0);
-				key.paletteOffset = *reinterpret_cast<const float*>(ctx.fragmentShaderUserData);
-				key.tint[0] = ctx.ff.color[0];
-				key.tint[1] = ctx.ff.color[1];
-				key.tint[2] = ctx.ff.color[2];
-				key.tint[3] = ctx.ff.color[3];
+				key.paletteOffset = paletteOffset;
+				key.tint[0] = tint[0];
+				key.tint[1] = tint[1];
+				key.tint[2] = tint[2];
+				key.tint[3] = tint[3];
 				key.indexByteOffset = indexByteOffset;
 				key.alphaByteOffset = alphaByteOffset;
 
 				// Most draws of a window share one palette / tint (tile layers submit runs of hundreds), so a
 				// most-recent-first linear scan almost always hits its first entry
-				for (std::int32_t i = std::int32_t(g_tile.paletteLutKeys.size()) - 1; i >= 0; i--) {
-					const PaletteLutKey& k = g_tile.paletteLutKeys[i];
+				for (std::int32_t i = std::int32_t(window.paletteLutKeys.size()) - 1; i >= 0; i--) {
+					const PaletteLutKey& k = window.paletteLutKeys[i];
 					if (k.palette == key.palette && k.paletteVersion == key.paletteVersion &&
 					    k.paletteOffset == key.paletteOffset &&
 					    k.tint[0] == key.tint[0] && k.tint[1] == key.tint[1] &&
@@ -240,15 +343,18 @@ namespace nCine::RHI::Software
 				// index bytes, with the identical float operations in the identical order so the results are
 				// bit-exact. floor(src.r * 255 + 0.5) recovers the index byte exactly (src.r is idx / 255), so
 				// per index everything but the per-pixel source-alpha factor collapses to constants.
-				g_tile.paletteLutKeys.push_back(key);
-				SwPaletteLut& lut = g_tile.paletteLuts.emplace_back();
-				lut.tintAlpha = ctx.ff.color[3];
+				window.paletteLutKeys.push_back(key);
+				SwPaletteLut& lut = window.paletteLuts.emplace_back();
+				lut.tintAlpha = tint[3];
 				lut.indexByteOffset = indexByteOffset;
 				lut.alphaByteOffset = alphaByteOffset;
 				lut.allOpaque = true;
 
+				// The fragment samples the palette on unit 1 (PaletteRemap.shader: texture_unit(1))
+				const SwTexture* paletteTextures[MaxTextureUnits] = {};
+				paletteTextures[1] = palette;
 				FragmentShaderInput paletteInput = {};
-				paletteInput.textures = ctx.textures;
+				paletteInput.textures = paletteTextures;
 				// The constant source alpha baked into packed[][3]: 1.0 both for the swizzle-One case and for
 				// the per-pixel case's alpha-byte-255 shortcut (255/255 == 1.0 exactly); 0.0 for swizzle-Zero
 				const float bakedSrcAlpha = (alphaByteOffset == -2 ? 0.0f : 1.0f);
@@ -258,9 +364,9 @@ namespace nCine::RHI::Software
 					const float palX = (sw::mod(palIndex, 256.0f) + 0.5f) / 256.0f;
 					const float palY = (sw::floor(palIndex / 256.0f) + 0.5f) / 256.0f;
 					const sw::vec4 color = sw::swTexture(paletteInput, 1, sw::vec2(palX, palY));
-					lut.packed[i][0] = SwQuantizeColor(color.r * ctx.ff.color[0]);
-					lut.packed[i][1] = SwQuantizeColor(color.g * ctx.ff.color[1]);
-					lut.packed[i][2] = SwQuantizeColor(color.b * ctx.ff.color[2]);
+					lut.packed[i][0] = SwQuantizeColor(color.r * tint[0]);
+					lut.packed[i][1] = SwQuantizeColor(color.g * tint[1]);
+					lut.packed[i][2] = SwQuantizeColor(color.b * tint[2]);
 					lut.packed[i][3] = SwQuantizeColor((color.a * bakedSrcAlpha) * lut.tintAlpha);
 					if (lut.packed[i][3] != 255) {
 						lut.allOpaque = false;
@@ -270,7 +376,24 @@ namespace nCine::RHI::Software
 					// float the fragment's own sample would produce
 					lut.palAlphaByte[i] = std::uint8_t(std::int32_t(color.a * 255.0f + 0.5f));
 				}
-				return std::int32_t(g_tile.paletteLuts.size()) - 1;
+				return std::int32_t(window.paletteLuts.size()) - 1;
+			}
+
+			// Validates the fast-path constraints for a PaletteRemap draw (ctx.paletteRemapHint) and returns the
+			// index of its pooled SwPaletteLut, or -1 when any constraint fails - the draw then keeps the generic
+			// transpiled fragment, so the LUT is a pure optimization. `ctx` must be the command's own snapshot.
+			std::int32_t AcquirePaletteLut(CommandWindow& window, const DrawContext& ctx)
+			{
+				// The parameter block is the transpiled fragment's single vPaletteOffset float
+				if (ctx.fragmentShader == nullptr || ctx.fragmentShaderUserData == nullptr ||
+				    ctx.fragmentShaderUserDataSize < sizeof(float)) {
+					return -1;
+				}
+				if (!ctx.ff.hasTexture || ctx.ff.textureUnit < 0 || ctx.ff.textureUnit >= std::int32_t(MaxTextureUnits)) {
+					return -1;
+				}
+				return AcquirePaletteLut(window, ctx.textures[ctx.ff.textureUnit], ctx.textures[1],
+					*reinterpret_cast<const float*>(ctx.fragmentShaderUserData), ctx.ff.color);
 			}
 
 			// Per-tile scratch buffer (each worker uses its own slice; slot 0 belongs to the main thread,
@@ -282,6 +405,136 @@ namespace nCine::RHI::Software
 			alignas(64) std::uint8_t g_tileScratch[1][TileSize * TileSize * 4];
 #endif
 
+			// Per-worker lightmap scratch of a lighting pass (same slots as above), 2 floats per texel. A tile reaches
+			// at most TileSize texels per axis (scale 1), or TileSize / scale + 1 when a texel straddles its edges.
+#if defined(WITH_THREADS)
+			alignas(64) float g_tileLightmap[TileState::MaxWorkers + 1][TileSize * TileSize * 2];
+#else
+			alignas(64) float g_tileLightmap[1][TileSize * TileSize * 2];
+#endif
+
+			// Per-worker tile cache counters (same slots as the scratch buffers), each on its own cache line
+			struct alignas(64) TileCounters
+			{
+				std::uint32_t processed;
+				std::uint32_t skipped;
+			};
+#if defined(WITH_THREADS)
+			TileCounters g_tileCounters[TileState::MaxWorkers + 1];
+#else
+			TileCounters g_tileCounters[1];
+#endif
+
+			// =====================================================================
+			// Tile cache hashing
+			// =====================================================================
+
+			// Combines the hashes of a tile's command sequence (order-dependent)
+			inline std::uint64_t MixTileHash(std::uint64_t hash, std::uint64_t value)
+			{
+				hash ^= value + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2);
+				return hash;
+			}
+
+			// Computes DeferredCommand::contentHash / cacheable of a fully submitted command. Pointers that change
+			// every frame (the caller's parameter block, the device's vertex scratch) are replaced by the content
+			// of their snapshots; textures by their identity, content version and sampler state.
+			void HashCommand(DeferredCommand& cmd)
+			{
+				struct TextureKey
+				{
+					const SwTexture* texture;
+					std::uint32_t version;
+					std::uint8_t wrapS, wrapT, magFilter;
+					std::uint8_t swizzle[4];
+				};
+				struct CommandKey
+				{
+					float mvpMatrix[16];
+					float color[4];
+					float texRect[4];
+					float spriteSize[2];
+					std::int32_t textureUnit;
+					std::int32_t vertexStride;
+					std::int32_t primType, firstVertex, count;
+					std::int32_t viewport[4];
+					std::int32_t scissor[4];
+					std::uint32_t userDataSize;
+					std::uint8_t hasTexture, blendingEnabled, blendSrc, blendDst;
+					std::uint8_t scissorEnabled, paletteRemapHint, constantColorHint;
+					FragmentShaderFn fragmentShader;
+					TextureKey textures[MaxTextureUnits];
+				};
+
+				const DrawContext& ctx = cmd.ctx;
+				// Zeroed as a whole first, so the padding bytes hash the same every time
+				CommandKey key;
+				std::memset(&key, 0, sizeof(key));
+				std::memcpy(key.mvpMatrix, ctx.ff.mvpMatrix, sizeof(key.mvpMatrix));
+				std::memcpy(key.color, ctx.ff.color, sizeof(key.color));
+				std::memcpy(key.texRect, ctx.ff.texRect, sizeof(key.texRect));
+				std::memcpy(key.spriteSize, ctx.ff.spriteSize, sizeof(key.spriteSize));
+				key.textureUnit = ctx.ff.textureUnit;
+				key.vertexStride = ctx.vertexStride;
+				key.primType = std::int32_t(cmd.primType);
+				key.firstVertex = cmd.firstVertex;
+				key.count = cmd.count;
+				key.viewport[0] = cmd.viewportX;
+				key.viewport[1] = cmd.viewportY;
+				key.viewport[2] = cmd.viewportW;
+				key.viewport[3] = cmd.viewportH;
+				if (ctx.scissorEnabled) {
+					key.scissor[0] = ctx.scissorRect.X;
+					key.scissor[1] = ctx.scissorRect.Y;
+					key.scissor[2] = ctx.scissorRect.W;
+					key.scissor[3] = ctx.scissorRect.H;
+				}
+				const bool hasUserData = (ctx.fragmentShader != nullptr && ctx.fragmentShaderUserData != nullptr);
+				key.userDataSize = (hasUserData ? ctx.fragmentShaderUserDataSize : 0);
+				key.hasTexture = std::uint8_t(ctx.ff.hasTexture);
+				key.blendingEnabled = std::uint8_t(ctx.blendingEnabled);
+				key.blendSrc = std::uint8_t(ctx.blendSrc);
+				key.blendDst = std::uint8_t(ctx.blendDst);
+				key.scissorEnabled = std::uint8_t(ctx.scissorEnabled);
+				key.paletteRemapHint = std::uint8_t(ctx.paletteRemapHint);
+				key.constantColorHint = std::uint8_t(ctx.constantColorHint);
+				key.fragmentShader = ctx.fragmentShader;
+
+				// A fragment callback may sample any unit, the fixed-function path only the primary one
+				bool cacheable = true;
+				for (std::int32_t i = 0; i < std::int32_t(MaxTextureUnits); i++) {
+					const SwTexture* texture = ctx.textures[i];
+					if (texture == nullptr || (ctx.fragmentShader == nullptr && !(ctx.ff.hasTexture && i == ctx.ff.textureUnit))) {
+						continue;
+					}
+					// A render target is drawn on the CPU without a content-version bump, so its hash can't
+					// tell whether it changed
+					if (texture->IsRenderTarget()) {
+						cacheable = false;
+					}
+					TextureKey& t = key.textures[i];
+					t.texture = texture;
+					t.version = texture->GetContentVersion();
+					t.wrapS = std::uint8_t(texture->GetWrapS());
+					t.wrapT = std::uint8_t(texture->GetWrapT());
+					t.magFilter = std::uint8_t(texture->GetMagFilter());
+					const SwizzleChannel* swizzle = texture->GetSwizzle();
+					for (std::int32_t j = 0; j < 4; j++) {
+						t.swizzle[j] = std::uint8_t(swizzle[j]);
+					}
+				}
+
+				std::uint64_t hash = xxHash3(&key, sizeof(key));
+				if (hasUserData) {
+					hash = xxHash3(cmd.userDataStorage, ctx.fragmentShaderUserDataSize, hash);
+				}
+				if (ctx.vertexData != nullptr) {
+					hash = xxHash3(cmd.vertexStorage.data(), cmd.vertexStorage.size() * sizeof(float), hash);
+				}
+				cmd.contentHash = hash;
+				cmd.cacheable = cacheable;
+			}
+
 			// =====================================================================
 			// Tile clear
 			// =====================================================================
@@ -314,12 +567,14 @@ namespace nCine::RHI::Software
 			// =====================================================================
 			// Copy tile buffer back to framebuffer
 			// =====================================================================
-			inline void CopyTileToFramebuffer(const std::uint8_t* tile, std::uint8_t* fb,
+			inline void CopyTileToFramebuffer(const CommandWindow& window, const std::uint8_t* tile,
 			                                  std::int32_t tileX, std::int32_t tileY,
-			                                  std::int32_t tileW, std::int32_t tileH,
-			                                  std::int32_t fbWidth, std::int32_t fbHeight,
-			                                  bool flipY)
+			                                  std::int32_t tileW, std::int32_t tileH)
 			{
+				std::uint8_t* fb = window.targetBuffer;
+				const std::int32_t fbWidth = window.fbWidth;
+				const std::int32_t fbHeight = window.fbHeight;
+				const bool flipY = window.isFboTarget;
 				const std::int32_t rowBytes = tileW * 4;
 				for (std::int32_t row = 0; row < tileH; row++) {
 					const std::uint8_t* src = tile + row * TileSize * 4;
@@ -328,7 +583,7 @@ namespace nCine::RHI::Software
 						continue;
 					}
 #if defined(RHI_USE_FB16)
-					if (g_tile.is16Bit) {
+					if (window.is16Bit) {
 						// Tiles are rasterized as RGBA8; the 565 conversion happens once here, per copied row
 						SwStoreFbSpan565(fb + (dstY * fbWidth + tileX) * 2, src, tileW);
 						continue;
@@ -342,12 +597,14 @@ namespace nCine::RHI::Software
 			// =====================================================================
 			// Copy framebuffer region into tile buffer (for read-modify-write blending)
 			// =====================================================================
-			inline void CopyFramebufferToTile(std::uint8_t* tile, const std::uint8_t* fb,
+			inline void CopyFramebufferToTile(const CommandWindow& window, std::uint8_t* tile,
 			                                  std::int32_t tileX, std::int32_t tileY,
-			                                  std::int32_t tileW, std::int32_t tileH,
-			                                  std::int32_t fbWidth, std::int32_t fbHeight,
-			                                  bool flipY)
+			                                  std::int32_t tileW, std::int32_t tileH)
 			{
+				const std::uint8_t* fb = window.targetBuffer;
+				const std::int32_t fbWidth = window.fbWidth;
+				const std::int32_t fbHeight = window.fbHeight;
+				const bool flipY = window.isFboTarget;
 				const std::int32_t rowBytes = tileW * 4;
 				for (std::int32_t row = 0; row < tileH; row++) {
 					std::uint8_t* dst = tile + row * TileSize * 4;
@@ -357,7 +614,7 @@ namespace nCine::RHI::Software
 						continue;
 					}
 #if defined(RHI_USE_FB16)
-					if (g_tile.is16Bit) {
+					if (window.is16Bit) {
 						SwLoadFbSpan565(dst, fb + (srcY * fbWidth + tileX) * 2, tileW);
 						continue;
 					}
@@ -367,24 +624,240 @@ namespace nCine::RHI::Software
 				}
 			}
 
+			// =====================================================================
+			// Lighting pass of a single tile
+			// =====================================================================
+			inline bool IsTileInLightingPass(const LightingPass& pass, std::int32_t tileCol, std::int32_t tileRow)
+			{
+				return (tileCol >= pass.tileMinX && tileCol <= pass.tileMaxX && tileRow >= pass.tileMinY && tileRow <= pass.tileMaxY);
+			}
+
+			inline std::int32_t GetLightingBinIndex(const LightingPass& pass, std::int32_t tileCol, std::int32_t tileRow)
+			{
+				return (tileRow - pass.tileMinY) * (pass.tileMaxX - pass.tileMinX + 1) + (tileCol - pass.tileMinX);
+			}
+
+			// Everything the pass output of the tile depends on besides its pixels: the parameters and the lights
+			// binned to it (the others cannot reach any of its texels)
+			std::uint64_t HashLightingPass(const LightingPass& pass, std::int32_t tileCol, std::int32_t tileRow)
+			{
+				const std::int32_t binIndex = GetLightingBinIndex(pass, tileCol, tileRow);
+				std::uint64_t hash = pass.paramsHash;
+				for (std::uint32_t i = pass.binOffsets[binIndex]; i < pass.binOffsets[binIndex + 1]; i++) {
+					hash = MixTileHash(hash, pass.lightHashes[pass.binLights[i]]);
+				}
+				return hash;
+			}
+
+			// Evaluates the lightmap texels the tile samples from its binned lights and combines them with its
+			// pixels inside the viewport. Texels straddling two tiles are evaluated by both, identically.
+			void ApplyLightingPass(const LightingPass& pass, std::uint8_t* tile, std::int32_t tileX, std::int32_t tileY,
+			                       std::int32_t tileW, std::int32_t tileH, std::int32_t tileCol, std::int32_t tileRow,
+			                       std::int32_t workerIndex)
+			{
+				const LightingParams& params = pass.params;
+				const std::int32_t x0 = std::max(tileX, params.viewportX);
+				const std::int32_t x1 = std::min(tileX + tileW, params.viewportX + params.viewportW);
+				const std::int32_t y0 = std::max(tileY, params.viewportY);
+				const std::int32_t y1 = std::min(tileY + tileH, params.viewportY + params.viewportH);
+				if (x0 >= x1 || y0 >= y1) {
+					return;
+				}
+
+				// Viewport-relative pixel span and the lightmap texels it samples
+				const std::int32_t scale = params.scale;
+				const std::int32_t relX0 = x0 - params.viewportX;
+				const std::int32_t relY0 = y0 - params.viewportY;
+				const std::int32_t relY1 = y1 - params.viewportY;
+				const std::int32_t blockX = relX0 / scale;
+				const std::int32_t blockY = relY0 / scale;
+				const std::int32_t blockW = std::min((x1 - params.viewportX - 1) / scale, params.lightmapW - 1) - blockX + 1;
+				const std::int32_t blockH = std::min((relY1 - 1) / scale, params.lightmapH - 1) - blockY + 1;
+				if DEATH_UNLIKELY(blockW <= 0 || blockH <= 0) {
+					return;
+				}
+
+				const std::int32_t binIndex = GetLightingBinIndex(pass, tileCol, tileRow);
+				const std::uint32_t binBegin = pass.binOffsets[binIndex];
+				const std::uint32_t binEnd = pass.binOffsets[binIndex + 1];
+				float* block = g_tileLightmap[workerIndex];
+				SplatLights(block, blockX, blockY, blockW, blockH, params.ambientLevel, pass.lights.data(),
+					pass.binLights.data() + binBegin, std::int32_t(binEnd - binBegin));
+
+				for (std::int32_t y = relY0; y < relY1; y++) {
+					const std::int32_t lmY = std::min(y / scale, params.lightmapH - 1) - blockY;
+					std::uint8_t* px = tile + ((params.viewportY + y - tileY) * TileSize + (x0 - tileX)) * 4;
+					CombineLightingScanline(px, x1 - x0, relX0, block + std::size_t(lmY) * blockW * 2, params.lightmapW,
+						scale, params.ambientR, params.ambientG, params.ambientB);
+				}
+			}
+
+			// =====================================================================
+			// Tile layer of a single tile
+			// =====================================================================
+
+			// Range of the layer's cells overlapping the inclusive pixel rectangle inside the layer's clip rectangle,
+			// which never leaves the grid
+			inline bool GetTileLayerCellRange(const PreparedTileLayer& layer, std::int32_t x0, std::int32_t y0, std::int32_t x1, std::int32_t y1,
+			                                  std::int32_t& col0, std::int32_t& row0, std::int32_t& col1, std::int32_t& row1)
+			{
+				x0 = std::max(x0, layer.clipMinX);
+				y0 = std::max(y0, layer.clipMinY);
+				x1 = std::min(x1, layer.clipMaxX);
+				y1 = std::min(y1, layer.clipMaxY);
+				if (x0 > x1 || y0 > y1) {
+					return false;
+				}
+				col0 = (x0 - layer.originX) / TileLayerCellSize;
+				row0 = (y0 - layer.originY) / TileLayerCellSize;
+				col1 = (x1 - layer.originX) / TileLayerCellSize;
+				row1 = (y1 - layer.originY) / TileLayerCellSize;
+				return true;
+			}
+
+			inline TileLayerCoverage GetTileLayerCoverage(const TileLayerPass& pass, std::int32_t tileCol, std::int32_t tileRow)
+			{
+				if (tileCol < pass.tileMinX || tileCol > pass.tileMaxX || tileRow < pass.tileMinY || tileRow > pass.tileMaxY) {
+					return TileLayerCoverageNone;
+				}
+				return TileLayerCoverage(pass.tileCoverage[(tileRow - pass.tileMinY) * (pass.tileMaxX - pass.tileMinX + 1) + (tileCol - pass.tileMinX)]);
+			}
+
+			// Everything the layer's output in the tile depends on: the parameters and the cells overlapping the tile
+			std::uint64_t HashTileLayerTile(const TileLayerPass& pass, std::int32_t tileX, std::int32_t tileY, std::int32_t tileW, std::int32_t tileH)
+			{
+				const PreparedTileLayer& layer = pass.layer;
+				std::uint64_t hash = pass.paramsHash;
+				std::int32_t col0, row0, col1, row1;
+				if (GetTileLayerCellRange(layer, tileX, tileY, tileX + tileW - 1, tileY + tileH - 1, col0, row0, col1, row1)) {
+					for (std::int32_t row = row0; row <= row1; row++) {
+						for (std::int32_t col = col0; col <= col1; col++) {
+							const PreparedTileLayerCell& cell = layer.cells[row * layer.columns + col];
+							hash = MixTileHash(hash, std::uint64_t(std::uint32_t(cell.texelOffset)) |
+								(std::uint64_t(cell.flags) << 32) | (std::uint64_t(cell.alphaIndex) << 40));
+						}
+					}
+				}
+				return hash;
+			}
+
+			// Classifies the texels of the atlas tile at `texels` by the alpha they are drawn with before the cell
+			// alpha - a palette index by its palette entry (and the source alpha of an RG8 atlas), an RGBA texel by
+			// its own. Mirrors FusedPaletteLutTexel / SwExpandTexel, so a transparent texel is exactly one that the
+			// quad path would skip.
+			void ClassifyTileSpans(const std::uint8_t* texels, std::int32_t rowBytes, std::int32_t texBpp, const SwPaletteLut* lut, TileLayerSpans& spans)
+			{
+				spans.opaqueRows = 0;
+				spans.visibleRows = 0;
+				for (std::int32_t r = 0; r < TileLayerCellSize; r++) {
+					const std::uint8_t* src = texels + std::size_t(r) * rowBytes;
+					std::int32_t first = -1, last = -1;
+					bool opaque = true;
+					for (std::int32_t c = 0; c < TileLayerCellSize; c++, src += texBpp) {
+						std::int32_t alpha;
+						if (lut != nullptr) {
+							const std::uint8_t idx = (lut->indexByteOffset < texBpp ? src[lut->indexByteOffset] : std::uint8_t(255));
+							alpha = lut->palAlphaByte[idx];
+							if (lut->alphaByteOffset == -2) {
+								alpha = 0;
+							} else if (lut->alphaByteOffset >= 0) {
+								const std::uint8_t alphaByte = (lut->alphaByteOffset < texBpp ? src[lut->alphaByteOffset] : std::uint8_t(255));
+								if (alphaByte != 255 && alpha != 0) {
+									alpha = (alphaByte == 0 ? 0 : 1);
+								}
+							}
+						} else {
+							alpha = (texBpp >= 4 ? src[3] : 255);
+						}
+						if (alpha != 0) {
+							if (first < 0) {
+								first = c;
+							}
+							last = c;
+						}
+						if (alpha != 255) {
+							opaque = false;
+						}
+					}
+					spans.first[r] = std::uint8_t(first >= 0 ? first : 0);
+					spans.last[r] = std::uint8_t(last >= 0 ? last : 0);
+					if (first >= 0) {
+						spans.visibleRows |= (1u << r);
+					}
+					if (opaque) {
+						spans.opaqueRows |= (1u << r);
+					}
+				}
+			}
+
+			// Finds the span cache matching the atlas and the palette, or reuses the least recently used entry
+			TileSpanCache& AcquireTileSpanCache(const SwTexture* atlas, const TileLayerParams& params, const SwPaletteLut* lut)
+			{
+				const std::uint32_t atlasVersion = atlas->GetContentVersion();
+				const SwTexture* palette = (params.indexed ? params.palette : nullptr);
+				const std::uint32_t paletteVersion = (palette != nullptr ? palette->GetContentVersion() : 0);
+				const float paletteOffset = (params.indexed ? params.paletteOffset : 0.0f);
+				const std::int32_t indexByteOffset = (lut != nullptr ? lut->indexByteOffset : 0);
+				const std::int32_t alphaByteOffset = (lut != nullptr ? lut->alphaByteOffset : 0);
+
+				TileSpanCache* found = nullptr;
+				for (TileSpanCache& cache : g_tile.tileSpanCaches) {
+					if (cache.atlas == atlas && cache.atlasVersion == atlasVersion && cache.texBpp == atlas->GetBytesPerPixel() &&
+					    cache.indexed == params.indexed && cache.palette == palette && cache.paletteVersion == paletteVersion &&
+					    cache.paletteOffset == paletteOffset && cache.indexByteOffset == indexByteOffset && cache.alphaByteOffset == alphaByteOffset) {
+						found = &cache;
+						break;
+					}
+					if (found == nullptr || cache.lastUsed < found->lastUsed) {
+						found = &cache;
+					}
+				}
+				if (found->atlas != atlas || found->atlasVersion != atlasVersion || found->texBpp != atlas->GetBytesPerPixel() ||
+				    found->indexed != params.indexed || found->palette != palette || found->paletteVersion != paletteVersion ||
+				    found->paletteOffset != paletteOffset || found->indexByteOffset != indexByteOffset || found->alphaByteOffset != alphaByteOffset) {
+					found->atlas = atlas;
+					found->atlasVersion = atlasVersion;
+					found->texBpp = atlas->GetBytesPerPixel();
+					found->indexed = params.indexed;
+					found->palette = palette;
+					found->paletteVersion = paletteVersion;
+					found->paletteOffset = paletteOffset;
+					found->indexByteOffset = indexByteOffset;
+					found->alphaByteOffset = alphaByteOffset;
+					found->slotsX = (atlas->GetWidth() + TileLayerCellSize - 1) / TileLayerCellSize;
+					const std::int32_t slotsY = (atlas->GetHeight() + TileLayerCellSize - 1) / TileLayerCellSize;
+					found->slots.clear();
+					found->slots.resize(std::size_t(found->slotsX) * slotsY);
+				}
+				found->lastUsed = ++g_tile.tileSpanClock;
+				return *found;
+			}
+
 			// =====================================================================
 			// Process a single tile: read back if needed, render all binned commands, copy back
 			// =====================================================================
-			void ProcessTile(std::int32_t tileIndex, std::int32_t workerIndex)
+			void ProcessTile(const CommandWindow& window, std::int32_t tileIndex, std::int32_t workerIndex)
 			{
-				const std::int32_t tileCol = tileIndex % g_tile.tilesX;
-				const std::int32_t tileRow = tileIndex / g_tile.tilesX;
+				const std::int32_t tileCol = tileIndex % window.tilesX;
+				const std::int32_t tileRow = tileIndex / window.tilesX;
 				const std::int32_t tileX = tileCol * TileSize;
 				const std::int32_t tileY = tileRow * TileSize;
-				const std::int32_t tileW = std::min(TileSize, g_tile.fbWidth - tileX);
-				const std::int32_t tileH = std::min(TileSize, g_tile.fbHeight - tileY);
+				const std::int32_t tileW = std::min(TileSize, window.fbWidth - tileX);
+				const std::int32_t tileH = std::min(TileSize, window.fbHeight - tileY);
 
 				if DEATH_UNLIKELY(tileW <= 0 || tileH <= 0) {
 					return;
 				}
 
-				const auto& bin = g_tile.tileBins[tileIndex];
-				if (bin.empty()) {
+				const auto& bin = window.tileBins[tileIndex];
+				bool isLit = false;
+				for (std::int32_t p = 0; p < window.lightingPassCount; p++) {
+					if (IsTileInLightingPass(window.lightingPasses[p], tileCol, tileRow)) {
+						isLit = true;
+						break;
+					}
+				}
+				if (bin.empty() && !window.hasClear && !isLit) {
 					return; // No commands touch this tile - nothing to do
 				}
 
@@ -402,36 +875,230 @@ namespace nCine::RHI::Software
 				std::size_t firstCmd = 0;
 				bool needsReadBack = true;
 				for (std::size_t i = bin.size(); i > 0;) {
-					const DeferredCommand& cmd = g_tile.commands[bin[--i]];
-					if (cmd.opaqueOverwrite &&
-					    cmd.coverMinX <= tileX && cmd.coverMinY <= tileY &&
-					    cmd.coverMaxX >= tileX + tileW - 1 && cmd.coverMaxY >= tileY + tileH - 1) {
+					const DeferredCommand& cmd = window.commands[bin[--i]];
+					if (cmd.tileLayerIndex >= 0
+						? GetTileLayerCoverage(window.tileLayers[cmd.tileLayerIndex], tileCol, tileRow) == TileLayerCoverageOpaque
+						: (cmd.opaqueOverwrite &&
+						   cmd.coverMinX <= tileX && cmd.coverMinY <= tileY &&
+						   cmd.coverMaxX >= tileX + tileW - 1 && cmd.coverMaxY >= tileY + tileH - 1)) {
 						firstCmd = i;
 						needsReadBack = false;
 						break;
 					}
 				}
 
+				// A lighting pass recorded before the command the walk starts at is overwritten by it as well.
+				// The passes are in command order, so they are merged into the walk below.
+				const std::int32_t firstPassCommand = (needsReadBack ? 0 : std::int32_t(bin[firstCmd]) + 1);
+				auto isPassVisible = [&](const LightingPass& pass) {
+					return (pass.commandIndex >= firstPassCommand && IsTileInLightingPass(pass, tileCol, tileRow));
+				};
+
+				// The tile's output can only be reused when it doesn't depend on what the surface held before
+				// this flush - it starts from a deferred clear, or an opaque command covers it completely
+				TileCounters& counters = g_tileCounters[workerIndex];
+				counters.processed++;
+				std::uint64_t* historyHash = (window.history != nullptr ? &window.history->tileHashes[tileIndex] : nullptr);
+				std::uint64_t tileHash = 0;
+				if (historyHash != nullptr && (!needsReadBack || window.hasClear)) {
+					tileHash = (needsReadBack ? MixTileHash(0x5D5Bull, window.clearColor) : 0x0C0Bull);
+					std::int32_t p = 0;
+					for (std::size_t k = firstCmd; k < bin.size(); k++) {
+						const DeferredCommand& cmd = window.commands[bin[k]];
+						if (!cmd.cacheable) {
+							tileHash = 0;
+							break;
+						}
+						for (; p < window.lightingPassCount && window.lightingPasses[p].commandIndex <= bin[k]; p++) {
+							if (isPassVisible(window.lightingPasses[p])) {
+								tileHash = MixTileHash(tileHash, HashLightingPass(window.lightingPasses[p], tileCol, tileRow));
+							}
+						}
+						tileHash = MixTileHash(tileHash, cmd.tileLayerIndex >= 0
+							? HashTileLayerTile(window.tileLayers[cmd.tileLayerIndex], tileX, tileY, tileW, tileH)
+							: cmd.contentHash);
+					}
+					for (; tileHash != 0 && p < window.lightingPassCount; p++) {
+						if (isPassVisible(window.lightingPasses[p])) {
+							tileHash = MixTileHash(tileHash, HashLightingPass(window.lightingPasses[p], tileCol, tileRow));
+						}
+					}
+					if (tileHash != 0 && *historyHash == tileHash) {
+						counters.skipped++;
+						return;
+					}
+				}
+
 				if (needsReadBack) {
-					// Initialize the tile with current framebuffer contents (needed for correct blending)
-					CopyFramebufferToTile(tileBuf, g_tile.targetBuffer,
-					                      tileX, tileY, tileW, tileH,
-					                      g_tile.fbWidth, g_tile.fbHeight, g_tile.isFboTarget);
+					if (window.hasClear) {
+						// Deferred clear: the surface was never actually cleared, so the tile starts from the color
+						ClearTileBuffer(tileBuf, TileSize * TileSize, window.clearColor);
+					} else {
+						// Initialize the tile with current framebuffer contents (needed for correct blending)
+						CopyFramebufferToTile(window, tileBuf, tileX, tileY, tileW, tileH);
+					}
 				}
 
-				// Render the visible suffix of the commands binned to this tile
+				// Render the visible suffix of the commands binned to this tile, with the lighting passes in between
+				std::int32_t p = 0;
 				for (std::size_t k = firstCmd; k < bin.size(); k++) {
-					const DeferredCommand& cmd = g_tile.commands[bin[k]];
+					for (; p < window.lightingPassCount && window.lightingPasses[p].commandIndex <= bin[k]; p++) {
+						if (isPassVisible(window.lightingPasses[p])) {
+							ApplyLightingPass(window.lightingPasses[p], tileBuf, tileX, tileY, tileW, tileH, tileCol, tileRow, workerIndex);
+						}
+					}
+					const DeferredCommand& cmd = window.commands[bin[k]];
+					if (cmd.tileLayerIndex >= 0) {
+						TileInternal::RenderTileLayerToTile(window.tileLayers[cmd.tileLayerIndex].layer, tileBuf, tileX, tileY, tileW, tileH);
+						continue;
+					}
 					TileInternal::RenderCommandToTile(
 						cmd.ctx, &cmd.prep, cmd.primType, cmd.firstVertex, cmd.count,
 						tileBuf, tileX, tileY, tileW, tileH,
 						cmd.viewportX, cmd.viewportY, cmd.viewportW, cmd.viewportH);
 				}
+				for (; p < window.lightingPassCount; p++) {
+					if (isPassVisible(window.lightingPasses[p])) {
+						ApplyLightingPass(window.lightingPasses[p], tileBuf, tileX, tileY, tileW, tileH, tileCol, tileRow, workerIndex);
+					}
+				}
 
 				// Copy the tile back to the framebuffer
-				CopyTileToFramebuffer(tileBuf, g_tile.targetBuffer,
-				                      tileX, tileY, tileW, tileH,
-				                      g_tile.fbWidth, g_tile.fbHeight, g_tile.isFboTarget);
+				CopyTileToFramebuffer(window, tileBuf, tileX, tileY, tileW, tileH);
+
+				if (historyHash != nullptr) {
+					*historyHash = tileHash;
+				}
+			}
+
+			// =====================================================================
+			// Point a flush window at a destination surface
+			// =====================================================================
+			void ConfigureWindow(CommandWindow& window, std::uint8_t* buffer, std::int32_t width, std::int32_t height, bool isFboTarget)
+			{
+				// Sanity guard only (the bin table below is sized dynamically); a nonsensical target disables
+				// the layer until the next valid one
+				if DEATH_UNLIKELY(width > MaxSurfaceDimension || height > MaxSurfaceDimension || width <= 0 || height <= 0) {
+					window.targetBuffer = nullptr;
+					window.fbWidth = 0;
+					window.fbHeight = 0;
+					window.totalTiles = 0;
+					window.isFboTarget = false;
+					return;
+				}
+
+				window.targetBuffer = buffer;
+				window.isFboTarget = isFboTarget;
+#if defined(RHI_USE_FB16)
+				// On the software backend a non-FBO target IS the screen framebuffer - the only 16-bit surface
+				window.is16Bit = !isFboTarget;
+#endif
+				window.fbWidth = width;
+				window.fbHeight = height;
+				window.tilesX = (width + TileSize - 1) >> TileSizeShift;
+				window.tilesY = (height + TileSize - 1) >> TileSizeShift;
+				window.totalTiles = window.tilesX * window.tilesY;
+				// Grow the bin table to the actual destination's tile count (never shrunk: bins keep their
+				// heap capacity so steady state allocates nothing; the largest target seen wins)
+				if (std::int32_t(window.tileBins.size()) < window.totalTiles) {
+					window.tileBins.resize(window.totalTiles);
+				}
+			}
+
+			// =====================================================================
+			// Resolve the per-command pointers once the window stops growing
+			// =====================================================================
+			void ResolveCommandPointers(CommandWindow& window)
+			{
+				// Fix up the per-command pointers now that submissions are done for this window and neither the
+				// command arena nor the LUT pool grows any further, so everything stays stable for every worker:
+				// - palette-LUT pool indices resolve into pointers
+				// - the self-referential ctx pointers (fragment userData, general-draw vertices) repoint at the
+				//   command's own storage; they held the submit-time caller pointers (dead by now, but never
+				//   dereferenced since) because arena growth may have MOVED the commands after submission
+				for (std::int32_t i = 0; i < window.commandCount; i++) {
+					DeferredCommand& cmd = window.commands[i];
+					cmd.ctx.paletteLut = (cmd.paletteLutIndex >= 0 ? &window.paletteLuts[cmd.paletteLutIndex] : nullptr);
+					if (cmd.ctx.fragmentShader != nullptr && cmd.ctx.fragmentShaderUserData != nullptr) {
+						cmd.ctx.fragmentShaderUserData = cmd.userDataStorage;
+					}
+					if (cmd.ctx.vertexData != nullptr) {
+						cmd.ctx.vertexData = cmd.vertexStorage.data();
+					}
+				}
+				for (std::int32_t i = 0; i < window.tileLayerCount; i++) {
+					PreparedTileLayer& layer = window.tileLayers[i].layer;
+					for (std::int32_t j = 0; j < MaxTileLayerAlphas; j++) {
+						layer.luts[j] = (layer.lutIndices[j] >= 0 ? &window.paletteLuts[layer.lutIndices[j]] : nullptr);
+					}
+				}
+			}
+
+			// =====================================================================
+			// Drop all commands of a window, keeping its allocations
+			// =====================================================================
+			void ResetWindow(CommandWindow& window)
+			{
+				window.commandCount = 0;
+				window.lightingPassCount = 0;
+				window.tileLayerCount = 0;
+				window.hasClear = false;
+				window.history = nullptr;
+				for (std::int32_t i = 0; i < window.totalTiles; i++) {
+					window.tileBins[i].clear();
+				}
+				// The palette LUTs belong to the discarded commands (keys include per-window texture versions)
+				window.paletteLuts.clear();
+				window.paletteLutKeys.clear();
+			}
+
+			// Whether the window has nothing to flush
+			inline bool IsWindowEmpty(const CommandWindow& window)
+			{
+				return (window.commandCount == 0 && window.lightingPassCount == 0 && !window.hasClear);
+			}
+
+			// Finds the tile hashes remembered for the window's destination, or reuses the least recently used
+			// entry (never the one an asynchronous flush is still using)
+			TileHistory* AcquireHistory(const CommandWindow& window)
+			{
+				const TileHistory* inFlight = (g_tile.rasterizing != nullptr ? g_tile.rasterizing->history : nullptr);
+				TileHistory* found = nullptr;
+				TileHistory* oldest = nullptr;
+				for (TileHistory& history : g_tile.histories) {
+					if (history.buffer == window.targetBuffer) {
+						found = &history;
+						break;
+					}
+					if (&history != inFlight && (oldest == nullptr || history.lastUsed < oldest->lastUsed)) {
+						oldest = &history;
+					}
+				}
+				if (found == nullptr) {
+					found = oldest;
+					found->buffer = nullptr;
+				}
+				if (found->buffer != window.targetBuffer || found->fbWidth != window.fbWidth ||
+				    found->fbHeight != window.fbHeight || found->isFboTarget != window.isFboTarget) {
+					found->buffer = window.targetBuffer;
+					found->fbWidth = window.fbWidth;
+					found->fbHeight = window.fbHeight;
+					found->isFboTarget = window.isFboTarget;
+					found->tileHashes.assign(std::size_t(window.totalTiles), 0);
+				}
+				found->lastUsed = ++g_tile.historyClock;
+				return found;
+			}
+
+			// Adds the per-worker tile counters of the finished flush to the totals
+			void FoldTileCounters()
+			{
+				for (TileCounters& counters : g_tileCounters) {
+					g_tile.processedTiles += counters.processed;
+					g_tile.skippedTiles += counters.skipped;
+					counters.processed = 0;
+					counters.skipped = 0;
+				}
 			}
 
 #if defined(WITH_THREADS)
@@ -453,15 +1120,16 @@ namespace nCine::RHI::Software
 						return;
 					}
 					g_tile.workerGeneration[workerIndex] = g_tile.flushGeneration;
+					const CommandWindow& window = *g_tile.rasterizing;
 					g_tile.mutex.Unlock();
 
 					// Process tiles using an atomic counter (work-stealing pattern)
 					while (true) {
 						std::int32_t idx = g_tile.nextTileIndex.fetch_add(1, std::memory_order_relaxed);
-						if (idx >= g_tile.totalTiles) {
+						if (idx >= window.totalTiles) {
 							break;
 						}
-						ProcessTile(idx, workerIndex + 1); // +1 because the main thread uses slot 0
+						ProcessTile(window, idx, workerIndex + 1); // +1 because the main thread uses slot 0
 					}
 
 					// Signal completion
@@ -528,11 +1196,15 @@ namespace nCine::RHI::Software
 			}
 #endif
 			g_tile.initialized = true;
-			g_tile.fbWidth = 0;
-			g_tile.fbHeight = 0;
-			g_tile.totalTiles = 0;
-			g_tile.commandCount = 0;
-			g_tile.targetBuffer = nullptr;
+			for (CommandWindow& window : g_tile.windows) {
+				window.fbWidth = 0;
+				window.fbHeight = 0;
+				window.totalTiles = 0;
+				window.commandCount = 0;
+				window.targetBuffer = nullptr;
+			}
+			g_tile.recording = &g_tile.windows[0];
+			g_tile.rasterizing = nullptr;
 		}
 
 		void Shutdown()
@@ -542,6 +1214,9 @@ namespace nCine::RHI::Software
 			}
 
 #if defined(WITH_THREADS)
+			// Let the workers finish a frame still in flight, its commands reference the target and textures
+			WaitForAsyncFlush();
+
 			// Signal workers to exit
 			g_tile.mutex.Lock();
 			g_tile.shutdownRequested = true;
@@ -580,49 +1255,25 @@ namespace nCine::RHI::Software
 
 			// The device sets the same target before every draw; do nothing (and never flush) when nothing
 			// changed so consecutive draws to the same surface keep batching into one flush.
-			if (buffer == g_tile.targetBuffer && width == g_tile.fbWidth &&
-			    height == g_tile.fbHeight && isFboTarget == g_tile.isFboTarget) {
+			CommandWindow& rec = *g_tile.recording;
+			if (buffer == rec.targetBuffer && width == rec.fbWidth &&
+			    height == rec.fbHeight && isFboTarget == rec.isFboTarget) {
 				return;
 			}
 
 			// The target is actually changing: flush whatever is still queued for the old one first
-			if (g_tile.commandCount > 0) {
+			if (!IsWindowEmpty(rec)) {
 				Flush();
 			}
 
-			// Sanity guard only (the bin table below is sized dynamically); a nonsensical target disables
-			// the layer until the next valid one
-			if DEATH_UNLIKELY(width > MaxSurfaceDimension || height > MaxSurfaceDimension || width <= 0 || height <= 0) {
-				g_tile.targetBuffer = nullptr;
-				g_tile.fbWidth = 0;
-				g_tile.fbHeight = 0;
-				g_tile.totalTiles = 0;
-				g_tile.isFboTarget = false;
-				return;
-			}
-
-			g_tile.targetBuffer = buffer;
-			g_tile.isFboTarget = isFboTarget;
-#if defined(RHI_USE_FB16)
-			// On the software backend a non-FBO target IS the screen framebuffer - the only 16-bit surface
-			g_tile.is16Bit = !isFboTarget;
-#endif
-			g_tile.fbWidth = width;
-			g_tile.fbHeight = height;
-			g_tile.tilesX = (width + TileSize - 1) >> TileSizeShift;
-			g_tile.tilesY = (height + TileSize - 1) >> TileSizeShift;
-			g_tile.totalTiles = g_tile.tilesX * g_tile.tilesY;
-			// Grow the bin table to the actual destination's tile count (never shrunk: bins keep their
-			// heap capacity so steady state allocates nothing; the largest target seen wins)
-			if (std::int32_t(g_tile.tileBins.size()) < g_tile.totalTiles) {
-				g_tile.tileBins.resize(g_tile.totalTiles);
-			}
+			ConfigureWindow(rec, buffer, width, height, isFboTarget);
 		}
 
 		bool SubmitCommand(const DrawContext& ctx, PrimitiveType type,
 		                   std::int32_t firstVertex, std::int32_t count)
 		{
-			if DEATH_UNLIKELY(!g_tile.initialized || g_tile.targetBuffer == nullptr) {
+			CommandWindow& rec = *g_tile.recording;
+			if DEATH_UNLIKELY(!g_tile.initialized || rec.targetBuffer == nullptr) {
 				return false;
 			}
 
@@ -646,10 +1297,10 @@ namespace nCine::RHI::Software
 				}
 			}
 
-			if DEATH_UNLIKELY(g_tile.commandCount >= MaxCommands) {
+			if DEATH_UNLIKELY(rec.commandCount >= MaxCommands) {
 				// Buffer full - flush and retry, or fall back to immediate
 				Flush();
-				if (g_tile.commandCount >= MaxCommands) return false;
+				if (rec.commandCount >= MaxCommands) return false;
 			}
 
 			// Use the viewport snapshot for the NDC→screen transform (mirrors SwRaster::SetViewport). Fall
@@ -661,8 +1312,8 @@ namespace nCine::RHI::Software
 			if (vpW <= 0 || vpH <= 0) {
 				vpX = 0;
 				vpY = 0;
-				vpW = g_tile.fbWidth;
-				vpH = g_tile.fbHeight;
+				vpW = rec.fbWidth;
+				vpH = rec.fbHeight;
 			}
 
 			// Acquire a command slot, growing the arena on demand (geometric growth, capacity and each
@@ -670,11 +1321,11 @@ namespace nCine::RHI::Software
 			// that is safe because their self-referential ctx pointers are only fixed up (and dereferenced)
 			// at Flush. A discarded command simply never increments commandCount, so the slot is reused by
 			// the next submission.
-			const std::int32_t cmdIdx = g_tile.commandCount;
-			if (cmdIdx >= std::int32_t(g_tile.commands.size())) {
-				g_tile.commands.emplace_back();
+			const std::int32_t cmdIdx = rec.commandCount;
+			if (cmdIdx >= std::int32_t(rec.commands.size())) {
+				rec.commands.emplace_back();
 			}
-			DeferredCommand& cmd = g_tile.commands[cmdIdx];
+			DeferredCommand& cmd = rec.commands[cmdIdx];
 			cmd.ctx = ctx;
 			// Snapshot the fragment-callback parameter block into the command's own storage (ctx points at
 			// caller-stack memory, which is still alive here). cmd.ctx.fragmentShaderUserData keeps the
@@ -695,7 +1346,7 @@ namespace nCine::RHI::Software
 			// scissorRect.Y is stored in top-down screen space so the tile rasterizer can use it directly as a
 			// pixel-row clip. ctx.scissorRect.Y is bottom-up (the RHI scissor convention), so flip it here.
 			if DEATH_UNLIKELY(ctx.scissorEnabled) {
-				cmd.ctx.scissorRect.Y = g_tile.fbHeight - ctx.scissorRect.Y - ctx.scissorRect.H;
+				cmd.ctx.scissorRect.Y = rec.fbHeight - ctx.scissorRect.Y - ctx.scissorRect.H;
 			}
 
 			// Compute the screen-space AABB from the draw command
@@ -713,8 +1364,8 @@ namespace nCine::RHI::Software
 				}
 				screenMinX = std::max(0, static_cast<std::int32_t>(cmd.prep.fxMin));
 				screenMinY = std::max(0, static_cast<std::int32_t>(cmd.prep.fyMin));
-				screenMaxX = std::min(g_tile.fbWidth - 1, static_cast<std::int32_t>(cmd.prep.fxMax));
-				screenMaxY = std::min(g_tile.fbHeight - 1, static_cast<std::int32_t>(cmd.prep.fyMax));
+				screenMaxX = std::min(rec.fbWidth - 1, static_cast<std::int32_t>(cmd.prep.fxMax));
+				screenMaxY = std::min(rec.fbHeight - 1, static_cast<std::int32_t>(cmd.prep.fyMax));
 				accurateBounds = true;
 			} else if (cmd.ctx.vertexData != nullptr) {
 				// General vertex-fed draw: bin by the transformed vertices' bounding box (the same NDC ->
@@ -735,24 +1386,24 @@ namespace nCine::RHI::Software
 				}
 				screenMinX = std::max(0, static_cast<std::int32_t>(fxMin) - 1);
 				screenMinY = std::max(0, static_cast<std::int32_t>(fyMin) - 1);
-				screenMaxX = std::min(g_tile.fbWidth - 1, static_cast<std::int32_t>(fxMax) + 1);
-				screenMaxY = std::min(g_tile.fbHeight - 1, static_cast<std::int32_t>(fyMax) + 1);
+				screenMaxX = std::min(rec.fbWidth - 1, static_cast<std::int32_t>(fxMax) + 1);
+				screenMaxY = std::min(rec.fbHeight - 1, static_cast<std::int32_t>(fyMax) + 1);
 				accurateBounds = false;
 			} else {
 				// For non-procedural quads, use full framebuffer bounds (conservative)
 				cmd.prep.valid = false;
 				screenMinX = 0;
 				screenMinY = 0;
-				screenMaxX = g_tile.fbWidth - 1;
-				screenMaxY = g_tile.fbHeight - 1;
+				screenMaxX = rec.fbWidth - 1;
+				screenMaxY = rec.fbHeight - 1;
 				accurateBounds = false;
 			}
 
 			// Scissor clip — Y always flipped for tile culling because tile rows are indexed top-down in
 			// screen space but the framebuffer stores rows bottom-up.
 			if DEATH_UNLIKELY(ctx.scissorEnabled) {
-				std::int32_t scY0 = g_tile.fbHeight - ctx.scissorRect.Y - ctx.scissorRect.H;
-				std::int32_t scY1 = g_tile.fbHeight - 1 - ctx.scissorRect.Y;
+				std::int32_t scY0 = rec.fbHeight - ctx.scissorRect.Y - ctx.scissorRect.H;
+				std::int32_t scY1 = rec.fbHeight - 1 - ctx.scissorRect.Y;
 				screenMinX = std::max(screenMinX, ctx.scissorRect.X);
 				screenMinY = std::max(screenMinY, scY0);
 				screenMaxX = std::min(screenMaxX, ctx.scissorRect.X + ctx.scissorRect.W - 1);
@@ -767,7 +1418,7 @@ namespace nCine::RHI::Software
 			// tile rasterizer indexes instead of calling the transpiled fragment per pixel. -1 (constraint
 			// not met) keeps the generic fragment. Runs at submit time, while the caller's userData pointer
 			// is still alive.
-			cmd.paletteLutIndex = (ctx.paletteRemapHint ? AcquirePaletteLut(cmd.ctx) : -1);
+			cmd.paletteLutIndex = (ctx.paletteRemapHint ? AcquirePaletteLut(rec, cmd.ctx) : -1);
 
 			// Classify a destination-independent full write (the reverse-painter cull's trigger, see the
 			// field in SwTileRenderer.h). Only an axis-aligned procedural quad qualifies - it writes every
@@ -783,7 +1434,7 @@ namespace nCine::RHI::Software
 					} else if (cmd.paletteLutIndex >= 0) {
 						// Every LUT entry opaque and the source alpha a constant 1 - each sampled texel,
 						// whatever its index, lands on an opaque entry
-						const SwPaletteLut& lut = g_tile.paletteLuts[cmd.paletteLutIndex];
+						const SwPaletteLut& lut = rec.paletteLuts[cmd.paletteLutIndex];
 						overwrites = (lut.allOpaque && lut.alphaByteOffset == -1);
 					}
 				}
@@ -811,6 +1462,7 @@ namespace nCine::RHI::Software
 				}
 			}
 
+			cmd.tileLayerIndex = -1;
 			cmd.primType = type;
 			cmd.firstVertex = firstVertex;
 			cmd.count = count;
@@ -823,18 +1475,19 @@ namespace nCine::RHI::Software
 			cmd.screenMaxX = screenMaxX;
 			cmd.screenMaxY = screenMaxY;
 			cmd.boundsAreAccurate = accurateBounds;
-			g_tile.commandCount++;
+			HashCommand(cmd);
+			rec.commandCount++;
 
 			// Bin into overlapping tiles (clamp to the valid tile range)
 			const std::int32_t tileMinCol = std::max(0, screenMinX >> TileSizeShift);
-			const std::int32_t tileMaxCol = std::min(g_tile.tilesX - 1, screenMaxX >> TileSizeShift);
+			const std::int32_t tileMaxCol = std::min(rec.tilesX - 1, screenMaxX >> TileSizeShift);
 			const std::int32_t tileMinRow = std::max(0, screenMinY >> TileSizeShift);
-			const std::int32_t tileMaxRow = std::min(g_tile.tilesY - 1, screenMaxY >> TileSizeShift);
+			const std::int32_t tileMaxRow = std::min(rec.tilesY - 1, screenMaxY >> TileSizeShift);
 
 			for (std::int32_t row = tileMinRow; row <= tileMaxRow; row++) {
 				for (std::int32_t col = tileMinCol; col <= tileMaxCol; col++) {
-					const std::int32_t tileIdx = row * g_tile.tilesX + col;
-					g_tile.tileBins[tileIdx].push_back(static_cast<std::uint16_t>(cmdIdx));
+					const std::int32_t tileIdx = row * rec.tilesX + col;
+					rec.tileBins[tileIdx].push_back(static_cast<std::uint16_t>(cmdIdx));
 				}
 			}
 
@@ -843,38 +1496,34 @@ namespace nCine::RHI::Software
 
 		void Flush()
 		{
-			if DEATH_UNLIKELY(!g_tile.initialized || g_tile.commandCount == 0) {
+			if DEATH_UNLIKELY(!g_tile.initialized) {
+				return;
+			}
+
+			// Everything submitted before must have landed by the time this returns, including a frame
+			// that is still being rasterized asynchronously
+			WaitForAsyncFlush();
+
+			CommandWindow& rec = *g_tile.recording;
+			if (IsWindowEmpty(rec)) {
 				return;
 			}
 
 			// The target buffer must have been set via SetTargetBuffer()
-			if (g_tile.targetBuffer == nullptr || g_tile.totalTiles == 0) {
+			if (rec.targetBuffer == nullptr || rec.totalTiles == 0) {
 				DiscardPending();
 				return;
 			}
 
-			// Fix up the per-command pointers now that submissions are done for this window and neither the
-			// command arena nor the LUT pool grows any further, so everything stays stable for every worker:
-			// - palette-LUT pool indices resolve into pointers
-			// - the self-referential ctx pointers (fragment userData, general-draw vertices) repoint at the
-			//   command's own storage; they held the submit-time caller pointers (dead by now, but never
-			//   dereferenced since) because arena growth may have MOVED the commands after submission
-			for (std::int32_t i = 0; i < g_tile.commandCount; i++) {
-				DeferredCommand& cmd = g_tile.commands[i];
-				cmd.ctx.paletteLut = (cmd.paletteLutIndex >= 0 ? &g_tile.paletteLuts[cmd.paletteLutIndex] : nullptr);
-				if (cmd.ctx.fragmentShader != nullptr && cmd.ctx.fragmentShaderUserData != nullptr) {
-					cmd.ctx.fragmentShaderUserData = cmd.userDataStorage;
-				}
-				if (cmd.ctx.vertexData != nullptr) {
-					cmd.ctx.vertexData = cmd.vertexStorage.data();
-				}
-			}
+			ResolveCommandPointers(rec);
+			rec.history = AcquireHistory(rec);
 
 #if defined(WITH_THREADS)
 			// Multi-threaded tile processing using an atomic work counter
 			g_tile.nextTileIndex.store(0, std::memory_order_relaxed);
 
 			g_tile.mutex.Lock();
+			g_tile.rasterizing = &rec;
 			g_tile.flushGeneration++;
 			// Set the active count based on the successfully spawned threads
 			g_tile.workersActive.store(g_tile.numSpawnedWorkers, std::memory_order_release);
@@ -884,8 +1533,8 @@ namespace nCine::RHI::Software
 			// The main thread also processes tiles (worker slot 0)
 			while (true) {
 				std::int32_t idx = g_tile.nextTileIndex.fetch_add(1, std::memory_order_relaxed);
-				if (idx >= g_tile.totalTiles) break;
-				ProcessTile(idx, 0);
+				if (idx >= rec.totalTiles) break;
+				ProcessTile(rec, idx, 0);
 			}
 
 			// Wait for all workers to finish
@@ -893,6 +1542,7 @@ namespace nCine::RHI::Software
 			while (g_tile.workersActive.load(std::memory_order_acquire) > 0) {
 				g_tile.workDone.Wait(g_tile.mutex);
 			}
+			g_tile.rasterizing = nullptr;
 			g_tile.mutex.Unlock();
 
 			// Ensure all worker pixel writes are globally visible before the engine moves on to
@@ -900,29 +1550,481 @@ namespace nCine::RHI::Software
 			std::atomic_thread_fence(std::memory_order_acquire);
 #else
 			// Single-threaded fallback: process tiles sequentially
-			for (std::int32_t i = 0; i < g_tile.totalTiles; i++) {
-				ProcessTile(i, 0);
+			for (std::int32_t i = 0; i < rec.totalTiles; i++) {
+				ProcessTile(rec, i, 0);
 			}
 #endif
 
 			// Reset for the next frame
-			DiscardPending();
+			FoldTileCounters();
+			ResetWindow(rec);
 		}
 
-		void DiscardPending()
+		void FlushAsync()
+		{
+#if defined(WITH_THREADS)
+			if DEATH_UNLIKELY(!g_tile.initialized) {
+				return;
+			}
+
+			CommandWindow& rec = *g_tile.recording;
+			if (!g_tile.pipelined || g_tile.numSpawnedWorkers == 0 || IsWindowEmpty(rec) ||
+			    rec.targetBuffer == nullptr || rec.totalTiles == 0) {
+				Flush();
+				return;
+			}
+
+			// Only one window can be in flight, the previous frame must be done before the workers take this one
+			WaitForAsyncFlush();
+
+			ResolveCommandPointers(rec);
+			rec.history = AcquireHistory(rec);
+
+			// Recording continues in the other window, pointed at the same surface, so the caller can keep
+			// submitting while the workers rasterize this one
+			CommandWindow& next = (&rec == &g_tile.windows[0] ? g_tile.windows[1] : g_tile.windows[0]);
+			ConfigureWindow(next, rec.targetBuffer, rec.fbWidth, rec.fbHeight, rec.isFboTarget);
+			g_tile.recording = &next;
+
+			// Unlike Flush(), the main thread doesn't take any tile, it returns right away
+			g_tile.nextTileIndex.store(0, std::memory_order_relaxed);
+
+			g_tile.mutex.Lock();
+			g_tile.rasterizing = &rec;
+			g_tile.asyncFlushPending = true;
+			g_tile.flushGeneration++;
+			g_tile.workersActive.store(g_tile.numSpawnedWorkers, std::memory_order_release);
+			g_tile.workReady.Broadcast();
+			g_tile.mutex.Unlock();
+#else
+			Flush();
+#endif
+		}
+
+		void WaitForAsyncFlush()
 		{
-			g_tile.commandCount = 0;
-			for (std::int32_t i = 0; i < g_tile.totalTiles; i++) {
-				g_tile.tileBins[i].clear();
+#if defined(WITH_THREADS)
+			if DEATH_LIKELY(!g_tile.asyncFlushPending) {
+				return;
 			}
-			// The palette LUTs belong to the discarded commands (keys include per-window texture versions)
-			g_tile.paletteLuts.clear();
-			g_tile.paletteLutKeys.clear();
+
+			g_tile.mutex.Lock();
+			while (g_tile.workersActive.load(std::memory_order_acquire) > 0) {
+				g_tile.workDone.Wait(g_tile.mutex);
+			}
+			CommandWindow* window = g_tile.rasterizing;
+			g_tile.rasterizing = nullptr;
+			g_tile.asyncFlushPending = false;
+			g_tile.mutex.Unlock();
+
+			// Make the workers' pixel writes visible to the main thread (presentation reads the surface next)
+			std::atomic_thread_fence(std::memory_order_acquire);
+
+			FoldTileCounters();
+			ResetWindow(*window);
+#endif
+		}
+
+		bool IsAsyncFlushTarget(const std::uint8_t* buffer)
+		{
+#if defined(WITH_THREADS)
+			// Only the main thread assigns the in-flight window, no lock is needed to read it here
+			return (g_tile.asyncFlushPending && g_tile.rasterizing->targetBuffer == buffer);
+#else
+			static_cast<void>(buffer);
+			return false;
+#endif
+		}
+
+		void SetPipelined(bool enable)
+		{
+#if defined(WITH_THREADS)
+			if (!enable) {
+				WaitForAsyncFlush();
+			}
+			g_tile.pipelined = enable;
+#else
+			static_cast<void>(enable);
+#endif
+		}
+
+		bool IsPipelined()
+		{
+#if defined(WITH_THREADS)
+			return (g_tile.initialized && g_tile.pipelined && g_tile.numSpawnedWorkers > 0);
+#else
+			return false;
+#endif
+		}
+
+		void DiscardPending()
+		{
+			ResetWindow(*g_tile.recording);
 		}
 
 		std::int32_t GetPendingCommandCount()
 		{
-			return g_tile.commandCount;
+			return g_tile.recording->commandCount;
+		}
+
+		bool SubmitClear(std::uint32_t clearColor)
+		{
+			CommandWindow& rec = *g_tile.recording;
+			if DEATH_UNLIKELY(!g_tile.initialized || rec.targetBuffer == nullptr || rec.totalTiles == 0) {
+				return false;
+			}
+
+			// Everything queued before is hidden by the clear
+			ResetWindow(rec);
+			rec.hasClear = true;
+			rec.clearColor = clearColor;
+			return true;
+		}
+
+		bool SubmitLighting(const std::uint8_t* buffer, const SwLight* lights, std::int32_t lightCount, const LightingParams& params)
+		{
+			// The combine addresses the rows as they are stored, which only matches the viewport on the screen surface
+			CommandWindow& rec = *g_tile.recording;
+			if DEATH_UNLIKELY(!g_tile.initialized || rec.targetBuffer == nullptr || rec.totalTiles == 0 ||
+			                  rec.targetBuffer != buffer || rec.isFboTarget) {
+				return false;
+			}
+			// The bins index the lights with 16 bits
+			if (lightCount < 0 || lightCount > 65536 || params.scale <= 0 || params.lightmapW <= 0 || params.lightmapH <= 0 ||
+			    params.viewportX < 0 || params.viewportY < 0 || params.viewportW <= 0 || params.viewportH <= 0 ||
+			    params.viewportX + params.viewportW > rec.fbWidth || params.viewportY + params.viewportH > rec.fbHeight) {
+				return false;
+			}
+
+			if (rec.lightingPassCount == std::int32_t(rec.lightingPasses.size())) {
+				rec.lightingPasses.emplace_back();
+			}
+			LightingPass& pass = rec.lightingPasses[rec.lightingPassCount++];
+			pass.params = params;
+			pass.commandIndex = rec.commandCount;
+			pass.tileMinX = (params.viewportX >> TileSizeShift);
+			pass.tileMinY = (params.viewportY >> TileSizeShift);
+			pass.tileMaxX = ((params.viewportX + params.viewportW - 1) >> TileSizeShift);
+			pass.tileMaxY = ((params.viewportY + params.viewportH - 1) >> TileSizeShift);
+			pass.paramsHash = xxHash3(&params, sizeof(params));
+			pass.lights.assign(lights, lights + lightCount);
+			pass.lightHashes.resize_for_overwrite(lightCount);
+			for (std::int32_t i = 0; i < lightCount; i++) {
+				pass.lightHashes[i] = xxHash3(&lights[i], sizeof(SwLight));
+			}
+
+			// Bins every light to the tiles its texel bounding box reaches - counted first, then filled in light
+			// order, so each tile sums its lights in the same order as a whole-lightmap splat would
+			const std::int32_t tilesW = pass.tileMaxX - pass.tileMinX + 1;
+			const std::int32_t tilesH = pass.tileMaxY - pass.tileMinY + 1;
+			const std::int32_t vpMaxX = params.viewportX + params.viewportW - 1;
+			const std::int32_t vpMaxY = params.viewportY + params.viewportH - 1;
+			auto getTileRange = [&](const SwLight& light, std::int32_t& tx0, std::int32_t& ty0, std::int32_t& tx1, std::int32_t& ty1) {
+				if (light.MinX > light.MaxX || light.MinY > light.MaxY) {
+					return false;
+				}
+				const std::int32_t px0 = std::max(params.viewportX + light.MinX * params.scale, params.viewportX);
+				const std::int32_t px1 = std::min(params.viewportX + (light.MaxX + 1) * params.scale - 1, vpMaxX);
+				const std::int32_t py0 = std::max(params.viewportY + light.MinY * params.scale, params.viewportY);
+				const std::int32_t py1 = std::min(params.viewportY + (light.MaxY + 1) * params.scale - 1, vpMaxY);
+				if (px0 > px1 || py0 > py1) {
+					return false;
+				}
+				tx0 = (px0 >> TileSizeShift) - pass.tileMinX;
+				ty0 = (py0 >> TileSizeShift) - pass.tileMinY;
+				tx1 = (px1 >> TileSizeShift) - pass.tileMinX;
+				ty1 = (py1 >> TileSizeShift) - pass.tileMinY;
+				return true;
+			};
+
+			pass.binOffsets.assign(std::size_t(tilesW) * tilesH + 1, 0);
+			for (std::int32_t i = 0; i < lightCount; i++) {
+				std::int32_t tx0, ty0, tx1, ty1;
+				if (getTileRange(lights[i], tx0, ty0, tx1, ty1)) {
+					for (std::int32_t ty = ty0; ty <= ty1; ty++) {
+						for (std::int32_t tx = tx0; tx <= tx1; tx++) {
+							pass.binOffsets[ty * tilesW + tx + 1]++;
+						}
+					}
+				}
+			}
+			for (std::size_t i = 1; i < pass.binOffsets.size(); i++) {
+				pass.binOffsets[i] += pass.binOffsets[i - 1];
+			}
+			pass.binLights.resize_for_overwrite(pass.binOffsets.back());
+			// The offsets double as write cursors, which leaves each one at the start of the next bin
+			for (std::int32_t i = 0; i < lightCount; i++) {
+				std::int32_t tx0, ty0, tx1, ty1;
+				if (getTileRange(lights[i], tx0, ty0, tx1, ty1)) {
+					for (std::int32_t ty = ty0; ty <= ty1; ty++) {
+						for (std::int32_t tx = tx0; tx <= tx1; tx++) {
+							pass.binLights[pass.binOffsets[ty * tilesW + tx]++] = std::uint16_t(i);
+						}
+					}
+				}
+			}
+			for (std::size_t i = pass.binOffsets.size() - 1; i > 0; i--) {
+				pass.binOffsets[i] = pass.binOffsets[i - 1];
+			}
+			pass.binOffsets[0] = 0;
+			return true;
+		}
+
+		bool SubmitTileLayer(const TileLayerParams& params)
+		{
+			CommandWindow& rec = *g_tile.recording;
+			if DEATH_UNLIKELY(!g_tile.initialized || rec.targetBuffer == nullptr || rec.totalTiles == 0) {
+				return false;
+			}
+			// A render target is drawn on the CPU without a content-version bump, neither the spans nor the tile
+			// hashes could tell whether it changed
+			const SwTexture* atlas = params.atlas;
+			if (atlas == nullptr || atlas->GetPixels(0) == nullptr || atlas->IsRenderTarget() ||
+			    atlas->GetWidth() < TileLayerCellSize || atlas->GetHeight() < TileLayerCellSize ||
+			    params.cells == nullptr || params.columns <= 0 || params.rows <= 0 ||
+			    params.alphaCount <= 0 || params.alphaCount > MaxTileLayerAlphas) {
+				return false;
+			}
+			const std::int32_t texW = atlas->GetWidth();
+			const std::int32_t texH = atlas->GetHeight();
+			const std::int32_t texBpp = atlas->GetBytesPerPixel();
+
+			// Validate the cells before anything is recorded, so a declined layer leaves no trace in the window
+			const std::int32_t cellCount = params.columns * params.rows;
+			for (std::int32_t i = 0; i < cellCount; i++) {
+				const TileLayerCell& cell = params.cells[i];
+				if (cell.srcX >= 0 && (cell.srcY < 0 || cell.srcX > texW - TileLayerCellSize || cell.srcY > texH - TileLayerCellSize ||
+				                       cell.alphaIndex >= params.alphaCount)) {
+					return false;
+				}
+			}
+
+			// The clip rectangle is kept inside the surface and the grid, the cell lookups rely on it
+			const std::int32_t clipMinX = std::max({ params.clipMinX, params.originX, 0 });
+			const std::int32_t clipMinY = std::max({ params.clipMinY, params.originY, 0 });
+			const std::int32_t clipMaxX = std::min({ params.clipMaxX, params.originX + params.columns * TileLayerCellSize - 1, rec.fbWidth - 1 });
+			const std::int32_t clipMaxY = std::min({ params.clipMaxY, params.originY + params.rows * TileLayerCellSize - 1, rec.fbHeight - 1 });
+			if (clipMinX > clipMaxX || clipMinY > clipMaxY) {
+				return true; // Fully clipped - accepted but discarded
+			}
+
+			if DEATH_UNLIKELY(rec.commandCount >= MaxCommands) {
+				Flush();
+				if (rec.commandCount >= MaxCommands) return false;
+			}
+
+			// One palette LUT (or tint) per distinct cell alpha, exactly as each cell's quad would bake it
+			std::int32_t lutIndices[MaxTileLayerAlphas];
+			bool alphaOpaque[MaxTileLayerAlphas];
+			std::int32_t tint[MaxTileLayerAlphas][4];
+			for (std::int32_t i = 0; i < MaxTileLayerAlphas; i++) {
+				lutIndices[i] = -1;
+				alphaOpaque[i] = false;
+				if (i >= params.alphaCount) {
+					std::memset(tint[i], 0, sizeof(tint[i]));
+					continue;
+				}
+				const float color[4] = { params.color[0], params.color[1], params.color[2], params.color[3] * params.alphas[i] };
+				for (std::int32_t j = 0; j < 4; j++) {
+					tint[i][j] = static_cast<std::int32_t>(std::min(1.0f, color[j]) * 255.0f + 0.5f);
+				}
+				if (params.indexed) {
+					lutIndices[i] = AcquirePaletteLut(rec, atlas, params.palette, params.paletteOffset, color);
+					if (lutIndices[i] < 0) {
+						return false;
+					}
+					alphaOpaque[i] = (SwQuantizeColor(color[3]) == 255);
+				} else {
+					// A tint below full white scales an opaque texel's alpha to 254
+					alphaOpaque[i] = (tint[i][0] >= 255 && tint[i][1] >= 255 && tint[i][2] >= 255 && tint[i][3] >= 255);
+				}
+			}
+			const SwPaletteLut* lut = (params.indexed ? &rec.paletteLuts[lutIndices[0]] : nullptr);
+
+			if (rec.tileLayerCount == std::int32_t(rec.tileLayers.size())) {
+				rec.tileLayers.emplace_back();
+			}
+			TileLayerPass& pass = rec.tileLayers[rec.tileLayerCount];
+			PreparedTileLayer& layer = pass.layer;
+			layer.texPixels = atlas->GetPixels(0);
+			layer.texW = texW;
+			layer.texBpp = texBpp;
+			layer.indexed = params.indexed;
+			for (std::int32_t i = 0; i < MaxTileLayerAlphas; i++) {
+				layer.luts[i] = nullptr;
+				layer.lutIndices[i] = lutIndices[i];
+				std::memcpy(layer.tint[i], tint[i], sizeof(tint[i]));
+				layer.whiteTint[i] = (tint[i][0] >= 255 && tint[i][1] >= 255 && tint[i][2] >= 255 && tint[i][3] >= 255);
+				layer.opaqueAlpha[i] = alphaOpaque[i];
+			}
+			layer.originX = params.originX;
+			layer.originY = params.originY;
+			layer.columns = params.columns;
+			layer.rows = params.rows;
+			layer.clipMinX = clipMinX;
+			layer.clipMinY = clipMinY;
+			layer.clipMaxX = clipMaxX;
+			layer.clipMaxY = clipMaxY;
+
+			// The spans of each shown atlas tile come from the cache, and are classified on the first use only
+			TileSpanCache& spanCache = AcquireTileSpanCache(atlas, params, lut);
+			const std::int32_t rowBytes = texW * texBpp;
+			layer.cells.resize_for_overwrite(cellCount);
+			for (std::int32_t i = 0; i < cellCount; i++) {
+				const TileLayerCell& src = params.cells[i];
+				PreparedTileLayerCell& cell = layer.cells[i];
+				cell.flags = src.flags;
+				cell.alphaIndex = src.alphaIndex;
+				if (src.srcX < 0) {
+					cell.texelOffset = -1;
+					cell.alphaIndex = 0;
+					cell.opaque = false;
+					cell.spans.visibleRows = 0;
+					cell.spans.opaqueRows = 0;
+					continue;
+				}
+				TileSpanSlot& slot = spanCache.slots[(src.srcY / TileLayerCellSize) * spanCache.slotsX + (src.srcX / TileLayerCellSize)];
+				if (slot.srcX != src.srcX || slot.srcY != src.srcY) {
+					ClassifyTileSpans(layer.texPixels + std::size_t(src.srcY) * rowBytes + std::size_t(src.srcX) * texBpp,
+						rowBytes, texBpp, lut, slot.spans);
+					slot.srcX = src.srcX;
+					slot.srcY = src.srcY;
+				}
+				cell.spans = slot.spans;
+				cell.texelOffset = (slot.spans.visibleRows != 0 ? std::int32_t((std::size_t(src.srcY) * texW + src.srcX) * texBpp) : -1);
+				cell.opaque = (slot.spans.opaqueRows == 0xFFFFFFFFu && alphaOpaque[src.alphaIndex]);
+			}
+
+			// What the layer writes into each tile of its clip rectangle. Only a tile whose every pixel is inside
+			// the clip rectangle and covered by an opaque cell counts as overwritten.
+			pass.tileMinX = (clipMinX >> TileSizeShift);
+			pass.tileMinY = (clipMinY >> TileSizeShift);
+			pass.tileMaxX = (clipMaxX >> TileSizeShift);
+			pass.tileMaxY = (clipMaxY >> TileSizeShift);
+			const std::int32_t tilesW = pass.tileMaxX - pass.tileMinX + 1;
+			const std::int32_t tilesH = pass.tileMaxY - pass.tileMinY + 1;
+			pass.tileCoverage.resize_for_overwrite(std::size_t(tilesW) * tilesH);
+			for (std::int32_t ty = 0; ty < tilesH; ty++) {
+				for (std::int32_t tx = 0; tx < tilesW; tx++) {
+					const std::int32_t tileX = (pass.tileMinX + tx) * TileSize;
+					const std::int32_t tileY = (pass.tileMinY + ty) * TileSize;
+					const std::int32_t tileMaxX = std::min(tileX + TileSize, rec.fbWidth) - 1;
+					const std::int32_t tileMaxY = std::min(tileY + TileSize, rec.fbHeight) - 1;
+					bool anyVisible = false;
+					bool allOpaque = (tileX >= clipMinX && tileY >= clipMinY && tileMaxX <= clipMaxX && tileMaxY <= clipMaxY);
+					std::int32_t col0, row0, col1, row1;
+					if (GetTileLayerCellRange(layer, tileX, tileY, tileMaxX, tileMaxY, col0, row0, col1, row1)) {
+						for (std::int32_t row = row0; row <= row1; row++) {
+							for (std::int32_t col = col0; col <= col1; col++) {
+								const PreparedTileLayerCell& cell = layer.cells[row * layer.columns + col];
+								anyVisible |= (cell.texelOffset >= 0);
+								allOpaque &= cell.opaque;
+							}
+						}
+					} else {
+						allOpaque = false;
+					}
+					pass.tileCoverage[ty * tilesW + tx] = std::uint8_t(allOpaque ? TileLayerCoverageOpaque
+						: (anyVisible ? TileLayerCoveragePartial : TileLayerCoverageNone));
+				}
+			}
+
+			// Everything the output depends on besides the cells, which are hashed per tile
+			struct TileLayerKey
+			{
+				const SwTexture* atlas;
+				const SwTexture* palette;
+				std::uint32_t atlasVersion, paletteVersion;
+				std::int32_t texBpp;
+				std::int32_t indexed;
+				float paletteOffset;
+				float color[4];
+				float alphas[MaxTileLayerAlphas];
+				std::int32_t indexByteOffset, alphaByteOffset;
+				std::int32_t originX, originY, columns, rows;
+				std::int32_t clip[4];
+			};
+			TileLayerKey key;
+			std::memset(&key, 0, sizeof(key));
+			key.atlas = atlas;
+			key.atlasVersion = spanCache.atlasVersion;
+			key.texBpp = texBpp;
+			key.indexed = (params.indexed ? 1 : 0);
+			if (params.indexed) {
+				key.palette = params.palette;
+				key.paletteVersion = spanCache.paletteVersion;
+				key.paletteOffset = params.paletteOffset;
+				key.indexByteOffset = lut->indexByteOffset;
+				key.alphaByteOffset = lut->alphaByteOffset;
+			}
+			std::memcpy(key.color, params.color, sizeof(key.color));
+			std::memcpy(key.alphas, params.alphas, sizeof(float) * params.alphaCount);
+			key.originX = params.originX;
+			key.originY = params.originY;
+			key.columns = params.columns;
+			key.rows = params.rows;
+			key.clip[0] = clipMinX;
+			key.clip[1] = clipMinY;
+			key.clip[2] = clipMaxX;
+			key.clip[3] = clipMaxY;
+			pass.paramsHash = xxHash3(&key, sizeof(key));
+
+			// The command itself only holds the layer's place in the draw order
+			const std::int32_t cmdIdx = rec.commandCount;
+			if (cmdIdx >= std::int32_t(rec.commands.size())) {
+				rec.commands.emplace_back();
+			}
+			DeferredCommand& cmd = rec.commands[cmdIdx];
+			cmd.ctx = DrawContext();
+			cmd.prep.valid = false;
+			cmd.tileLayerIndex = rec.tileLayerCount;
+			cmd.paletteLutIndex = -1;
+			cmd.opaqueOverwrite = false;
+			cmd.primType = PrimitiveType::Triangles;
+			cmd.firstVertex = 0;
+			cmd.count = 0;
+			cmd.viewportX = g_tile.viewportX;
+			cmd.viewportY = g_tile.viewportY;
+			cmd.viewportW = g_tile.viewportW;
+			cmd.viewportH = g_tile.viewportH;
+			cmd.screenMinX = clipMinX;
+			cmd.screenMinY = clipMinY;
+			cmd.screenMaxX = clipMaxX;
+			cmd.screenMaxY = clipMaxY;
+			cmd.boundsAreAccurate = true;
+			cmd.contentHash = pass.paramsHash;
+			cmd.cacheable = true;
+			rec.tileLayerCount++;
+			rec.commandCount++;
+
+			for (std::int32_t ty = 0; ty < tilesH; ty++) {
+				for (std::int32_t tx = 0; tx < tilesW; tx++) {
+					if (pass.tileCoverage[ty * tilesW + tx] != TileLayerCoverageNone) {
+						rec.tileBins[(pass.tileMinY + ty) * rec.tilesX + pass.tileMinX + tx].push_back(static_cast<std::uint16_t>(cmdIdx));
+					}
+				}
+			}
+			return true;
+		}
+
+		void InvalidateTarget(const std::uint8_t* buffer)
+		{
+			if (buffer == nullptr) {
+				return;
+			}
+			for (TileHistory& history : g_tile.histories) {
+				if (history.buffer == buffer) {
+					history.buffer = nullptr;
+				}
+			}
+		}
+
+		TileCacheStats GetTileCacheStats()
+		{
+			TileCacheStats stats;
+			stats.processedTiles = g_tile.processedTiles;
+			stats.skippedTiles = g_tile.skippedTiles;
+			return stats;
 		}
 	}
 }
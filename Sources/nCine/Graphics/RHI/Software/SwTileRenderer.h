@@ -29,6 +29,17 @@ namespace nCine::RHI::Software
 		caller runs it through the immediate rasterizer instead. @ref Flush() is called before the surface
 		is read back (present) or a different render target is bound, and it never returns until every
 		worker has finished writing, so the pixels are complete and race-free by the time it does.
+
+		Commands are recorded into one of two flush windows. At present, @ref FlushAsync() hands the
+		recorded window to the workers and returns immediately, recording continues in the other one, so
+		the next frame's update overlaps the rasterization of the previous one. Anything that reads or
+		modifies state referenced by the in-flight window (textures, the screen surface) must call
+		@ref WaitForAsyncFlush() first.
+
+		Each flush also remembers a hash of every tile's commands per destination surface. When a tile's
+		output doesn't depend on the previous surface content (the surface was cleared, or an opaque command
+		covers the whole tile) and its hash matches the previous flush into the same surface, the pixels
+		from back then are still in place and the tile is skipped entirely.
 	*/
 	namespace SwTileRenderer
 	{
@@ -179,6 +190,138 @@ namespace nCine::RHI::Software
 			std::int32_t dvdxFix;
 		};
 
+		/** @brief Edge length of one tile-layer cell in pixels (and of the atlas tile it shows) */
+		static constexpr std::int32_t TileLayerCellSize = 32;
+		/** @brief Upper bound on the distinct per-cell alphas of one tile layer, see @ref TileLayerParams::alphas */
+		static constexpr std::int32_t MaxTileLayerAlphas = 4;
+
+		/** @brief @ref TileLayerCell::flags bit: the atlas tile is mirrored horizontally */
+		static constexpr std::uint8_t TileLayerFlipX = 0x01;
+		/** @brief @ref TileLayerCell::flags bit: the atlas tile is mirrored vertically */
+		static constexpr std::uint8_t TileLayerFlipY = 0x02;
+
+		/** @brief One cell of a tile layer submitted through @ref SubmitTileLayer() */
+		struct TileLayerCell
+		{
+			/** @brief Atlas column of the tile's top-left texel, or `-1` for an empty cell */
+			std::int32_t srcX;
+			/** @brief Atlas row of the tile's top-left texel */
+			std::int32_t srcY;
+			/** @brief Combination of @ref TileLayerFlipX and @ref TileLayerFlipY */
+			std::uint8_t flags;
+			/** @brief Index of the cell's alpha in @ref TileLayerParams::alphas */
+			std::uint8_t alphaIndex;
+		};
+
+		/**
+			@brief Parameters of a whole tile layer, see @ref SubmitTileLayer()
+
+			The layer is a dense grid of 32x32 cells mapped 1:1 onto surface pixels, each showing one atlas tile
+			(optionally mirrored) or nothing. A cell's output is exactly the textured quad the sprite path would
+			draw for it with the SrcAlpha / OneMinusSrcAlpha pair: the texel - or, for an index atlas, its
+			palette entry - multiplied by @ref color with the alpha additionally scaled by the cell's alpha.
+		*/
+		struct TileLayerParams
+		{
+			/** @brief Tileset atlas, R8 / RG8 palette indices when @ref indexed */
+			const SwTexture* atlas;
+			/** @brief Whether the atlas holds palette indices remapped through @ref palette (the `TileMapMeshPalette` fragment) */
+			bool indexed;
+			/** @brief Palette texture of an indexed atlas, may be `nullptr` (samples transparent black) */
+			const SwTexture* palette;
+			/** @brief Palette row offset of an indexed atlas (the fragment's `vPaletteOffset`) */
+			float paletteOffset;
+			/** @brief Layer tint, the alpha is multiplied by each cell's alpha */
+			float color[4];
+			/** @brief Distinct per-cell alphas, indexed by @ref TileLayerCell::alphaIndex */
+			float alphas[MaxTileLayerAlphas];
+			/** @brief Number of used entries in @ref alphas */
+			std::int32_t alphaCount;
+			/** @brief Surface pixel of the top-left corner of cell `(0, 0)`, top-down */
+			std::int32_t originX, originY;
+			/** @brief Number of cell columns */
+			std::int32_t columns;
+			/** @brief Number of cell rows */
+			std::int32_t rows;
+			/** @brief `columns * rows` cells, row by row, the array is copied */
+			const TileLayerCell* cells;
+			/** @brief Inclusive surface pixel rectangle the layer may write (viewport and scissor applied), top-down */
+			std::int32_t clipMinX, clipMinY, clipMaxX, clipMaxY;
+		};
+
+		/**
+			@brief Opaque and transparent spans of one 32x32 atlas tile under a palette (or of an RGBA tile)
+
+			Row `r` of the tile is fully opaque when bit `r` of @ref opaqueRows is set, and writes nothing at all
+			when bit `r` of @ref visibleRows is clear. Otherwise only texel columns `[first[r], last[r]]` hold
+			non-transparent texels. Texel rows and columns are in atlas order, before any mirroring.
+		*/
+		struct TileLayerSpans
+		{
+			/** @brief Rows whose every texel is opaque */
+			std::uint32_t opaqueRows;
+			/** @brief Rows with at least one non-transparent texel */
+			std::uint32_t visibleRows;
+			/** @brief First non-transparent texel column of each visible row */
+			std::uint8_t first[TileLayerCellSize];
+			/** @brief Last non-transparent texel column of each visible row */
+			std::uint8_t last[TileLayerCellSize];
+		};
+
+		/** @brief Submit-time precomputed state of one tile-layer cell */
+		struct PreparedTileLayerCell
+		{
+			/** @brief Byte offset of the tile's top-left texel in the atlas store, or `-1` for a cell that writes nothing */
+			std::int32_t texelOffset;
+			/** @brief Combination of @ref TileLayerFlipX and @ref TileLayerFlipY */
+			std::uint8_t flags;
+			/** @brief Index of the cell's tint / palette LUT in the @ref PreparedTileLayer arrays */
+			std::uint8_t alphaIndex;
+			/** @brief Whether every pixel of the cell is an opaque write (all rows opaque and an opaque cell alpha) */
+			bool opaque;
+			/** @brief Spans of the atlas tile */
+			TileLayerSpans spans;
+		};
+
+		/**
+			@brief Submit-time precomputed state of a tile-layer command, see @ref SubmitTileLayer()
+
+			Consumed by the tile rasterizer in place of a @ref PreparedQuad: each screen tile walks only the
+			(at most 2x2) cells overlapping it and copies their rows straight from the atlas, skipping transparent
+			rows and the transparent ends of the others, and storing the opaque rows without a blend.
+		*/
+		struct PreparedTileLayer
+		{
+			/** @brief Level-0 texel base of the atlas */
+			const std::uint8_t* texPixels;
+			/** @brief Atlas width in texels */
+			std::int32_t texW;
+			/** @brief Byte size of one stored atlas texel */
+			std::int32_t texBpp;
+			/** @brief Whether the atlas holds palette indices, see @ref luts */
+			bool indexed;
+			/** @brief Palette LUT of each cell alpha (indexed atlas), resolved by @ref Flush() */
+			const SwPaletteLut* luts[MaxTileLayerAlphas];
+			/** @brief Indices of @ref luts in the flush window's LUT pool */
+			std::int32_t lutIndices[MaxTileLayerAlphas];
+			/** @brief Tint of each cell alpha in `[0, 255]` as red, green, blue, alpha (RGBA atlas) */
+			std::int32_t tint[MaxTileLayerAlphas][4];
+			/** @brief Whether the tint of a cell alpha is a full-white no-op (RGBA atlas) */
+			bool whiteTint[MaxTileLayerAlphas];
+			/** @brief Whether an opaque texel stays opaque under each cell alpha */
+			bool opaqueAlpha[MaxTileLayerAlphas];
+			/** @brief Surface pixel of the top-left corner of cell `(0, 0)`, top-down */
+			std::int32_t originX, originY;
+			/** @brief Number of cell columns */
+			std::int32_t columns;
+			/** @brief Number of cell rows */
+			std::int32_t rows;
+			/** @brief Inclusive surface pixel rectangle the layer writes, top-down */
+			std::int32_t clipMinX, clipMinY, clipMaxX, clipMaxY;
+			/** @brief `columns * rows` cells, row by row */
+			SmallVector<PreparedTileLayerCell, 0> cells;
+		};
+
 		/**
 			@brief One deferred draw call together with its pre-computed screen-space bounds
 
@@ -269,6 +412,62 @@ namespace nCine::RHI::Software
 
 			/** @brief Submit-time precomputed vertices and derived state of a procedural quad command */
 			PreparedQuad prep;
+
+			/**
+			 * @brief Index of the command's tile layer in the flush window, or `-1` for an ordinary draw
+			 *
+			 * A tile-layer command (see @ref SubmitTileLayer()) keeps its state outside of the command, which
+			 * only carries its place in the draw order, so the arena slots stay small.
+			 */
+			std::int32_t tileLayerIndex;
+
+			/**
+			 * @brief Hash of everything the command's output depends on
+			 *
+			 * Covers the fixed-function state, blend / scissor, viewport, primitive range, the snapshotted
+			 * parameter block and vertices, and each sampled texture's identity, content version and sampler
+			 * state. A tile whose sequence of command hashes matches the previous flush into the same surface
+			 * is not rasterized again (see @ref GetTileCacheStats()).
+			 */
+			std::uint64_t contentHash;
+			/** @brief Whether @ref contentHash fully describes the output (`false` when it samples a render target) */
+			bool cacheable;
+		};
+
+		/** @brief Parameters of a dynamic-lighting combine, see @ref SubmitLighting() */
+		struct LightingParams
+		{
+			/** @brief Viewport left in surface pixels */
+			std::int32_t viewportX;
+			/** @brief Viewport top in surface pixels */
+			std::int32_t viewportY;
+			/** @brief Viewport width in surface pixels (inside the surface) */
+			std::int32_t viewportW;
+			/** @brief Viewport height in surface pixels (inside the surface) */
+			std::int32_t viewportH;
+			/** @brief Lightmap width in texels */
+			std::int32_t lightmapW;
+			/** @brief Lightmap height in texels */
+			std::int32_t lightmapH;
+			/** @brief Lightmap-to-surface downscale factor (a pixel samples texel `pixel / scale` of the viewport) */
+			std::int32_t scale;
+			/** @brief Intensity of a texel no light reaches */
+			float ambientLevel;
+			/** @brief Ambient colour red the unlit scene is blended toward */
+			float ambientR;
+			/** @brief Ambient colour green the unlit scene is blended toward */
+			float ambientG;
+			/** @brief Ambient colour blue the unlit scene is blended toward */
+			float ambientB;
+		};
+
+		/** @brief Cumulative counters of the tile cache, see @ref GetTileCacheStats() */
+		struct TileCacheStats
+		{
+			/** @brief Tiles that had anything to draw (a binned command or a deferred clear) */
+			std::uint64_t processedTiles;
+			/** @brief Tiles out of @ref processedTiles whose previous pixels were reused instead */
+			std::uint64_t skippedTiles;
 		};
 
 		/** @brief Spins up the worker pool and resets the queue (idempotent; called once at startup) */
@@ -307,6 +506,48 @@ namespace nCine::RHI::Software
 		bool SubmitCommand(const DrawContext& ctx, PrimitiveType type,
 		                   std::int32_t firstVertex, std::int32_t count);
 
+		/**
+			@brief Defers a full-surface clear of the current target into the next flush
+
+			Drops the queued commands, every tile then starts from @p clearColor instead of reading the
+			surface back, and is written even if no command touches it. This also makes the tiles' output
+			independent of the previous surface content, so unchanged tiles can be skipped.
+
+			@param clearColor	Packed RGBA8 clear color (R in the lowest byte)
+			@returns `true` if the clear was deferred, `false` if the caller should clear immediately
+		*/
+		bool SubmitClear(std::uint32_t clearColor);
+
+		/**
+			@brief Defers the dynamic-lighting combine of a viewport into the next flush
+
+			The lights are binned to the tiles of the viewport, and each tile evaluates its own part of the
+			lightmap with @ref SplatLights() and combines it with @ref CombineLightingScanline() right after the
+			commands submitted so far were drawn into it, while it is still in the worker's cache. Commands
+			submitted afterwards (the HUD) are drawn over the lit tile. The lights are copied, the caller may
+			reuse the array right away.
+
+			@param buffer		Surface the combine applies to, it must be the current (screen) target
+			@param lights		Lights in lightmap space, summed in this order
+			@param lightCount	Number of lights
+			@param params		Viewport, lightmap geometry and ambient colour
+			@returns `true` if the combine was deferred, `false` if the caller should flush and apply it itself
+		*/
+		bool SubmitLighting(const std::uint8_t* buffer, const SwLight* lights, std::int32_t lightCount, const LightingParams& params);
+
+		/**
+			@brief Submits a whole tile layer as a single deferred command
+
+			The draw-order equivalent of one textured quad per non-empty cell, see @ref TileLayerParams. Screen
+			tiles are binned only where a cell writes anything, a screen tile that opaque cells cover completely
+			starts its command walk at the layer (it takes part in the reverse-painter cull like an opaque quad),
+			and each screen tile is hashed from the cells overlapping it alone. The opaque and transparent spans
+			of each atlas tile are classified once and cached for as long as the atlas and the palette don't change.
+
+			@returns `true` if the layer was accepted, `false` if the caller should draw the cells one by one
+		*/
+		bool SubmitTileLayer(const TileLayerParams& params);
+
 		/**
 			@brief Renders every queued command tile by tile, then clears the queue
 
@@ -317,11 +558,45 @@ namespace nCine::RHI::Software
 		*/
 		void Flush();
 
+		/**
+			@brief Starts rendering the queued commands on the worker threads without waiting for them
+
+			The recorded window is handed to the workers and recording continues in the other window, pointed
+			at the same surface. Only one window can be in flight, so a previous asynchronous flush is waited
+			for first. Falls back to @ref Flush() when pipelining is disabled or no worker thread is running.
+			The caller must not read the surface or modify any texture used by the submitted commands until
+			@ref WaitForAsyncFlush() returns.
+		*/
+		void FlushAsync();
+
+		/** @brief Waits until the window started by @ref FlushAsync() is fully rendered, no-op if none is in flight */
+		void WaitForAsyncFlush();
+
+		/** @brief Returns `true` if the window started by @ref FlushAsync() is still being rendered into @p buffer */
+		bool IsAsyncFlushTarget(const std::uint8_t* buffer);
+
+		/** @brief Enables or disables overlapping of the flush with the next frame (enabled by default) */
+		void SetPipelined(bool enable);
+
+		/** @brief Returns `true` if @ref FlushAsync() really renders asynchronously */
+		bool IsPipelined();
+
 		/** @brief Drops all queued commands without rendering them (e.g. after a full-surface clear) */
 		void DiscardPending();
 
 		/** @brief Returns the number of commands currently queued */
 		std::int32_t GetPendingCommandCount();
+
+		/**
+			@brief Forgets the tiles remembered for a surface that was written outside of the tile renderer
+
+			Must be called whenever @p buffer is modified directly (immediate draws, blits, clears, texture
+			uploads) or freed, otherwise a tile could be skipped although its pixels no longer match.
+		*/
+		void InvalidateTarget(const std::uint8_t* buffer);
+
+		/** @brief Returns cumulative counters of processed and skipped (reused) tiles */
+		TileCacheStats GetTileCacheStats();
 	}
 }
 
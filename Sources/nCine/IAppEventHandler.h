@@ -55,6 +55,14 @@ namespace nCine
 		virtual bool OnLoadState(std::shared_ptr<Death::IO::Stream> src) {
 			return false;
 		}
+		/** @brief Called when the host frontend asks for an exact snapshot of the current frame, valid only in this process */
+		virtual bool OnSaveFrameState(Death::IO::Stream& dest) {
+			return false;
+		}
+		/** @brief Called when the host frontend restores a snapshot written by @ref OnSaveFrameState(), it must be restored immediately */
+		virtual bool OnLoadFrameState(Death::IO::Stream& src) {
+			return false;
+		}
 #endif
 	};
 
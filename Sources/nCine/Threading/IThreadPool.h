@@ -19,6 +19,8 @@ namespace nCine
 
 		/** @brief Enqueues a command to be executed by a worker thread */
 		virtual void EnqueueCommand(std::unique_ptr<IThreadCommand>&& threadCommand) = 0;
+		/** @brief Returns number of worker threads, `0` if commands cannot be executed */
+		virtual std::size_t GetThreadCount() const = 0;
 	};
 
 	inline IThreadPool::~IThreadPool() { }
@@ -29,6 +31,7 @@ namespace nCine
 	{
 	public:
 		void EnqueueCommand(std::unique_ptr<IThreadCommand>&& threadCommand) override { }
+		std::size_t GetThreadCount() const override { return 0; }
 	};
 #endif
 }
\ No newline at end of file
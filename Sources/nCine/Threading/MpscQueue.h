@@ -0,0 +1,81 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace nCine
+{
+	/**
+		@brief Bounded lock-free multi-producer/single-consumer ring buffer
+
+		Any number of threads may push concurrently, but exactly one thread may pop at any given time, neither
+		side ever blocks or allocates. Each slot carries a sequence number, so a producer first claims a slot
+		and then publishes it, and the consumer never sees a claimed slot before its element is written.
+		Elements must be default-constructible and movable, popped slots are left in a moved-from state and
+		reused. The capacity must be a power of two.
+	*/
+	template<class T, std::uint32_t Capacity>
+	class MpscQueue
+	{
+		static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+	public:
+		MpscQueue() : _head(0), _tail(0) {
+			for (std::uint32_t i = 0; i < Capacity; i++) {
+				_slots[i].Sequence.store(i, std::memory_order_relaxed);
+			}
+		}
+
+		MpscQueue(const MpscQueue&) = delete;
+		MpscQueue& operator=(const MpscQueue&) = delete;
+
+		/** @brief Appends an element, returns `false` and leaves @p value untouched if the queue is full (any thread) */
+		bool TryPush(T&& value) {
+			std::uint32_t tail = _tail.load(std::memory_order_relaxed);
+			Slot* slot;
+			while (true) {
+				slot = &_slots[tail & (Capacity - 1)];
+				std::int32_t diff = std::int32_t(slot->Sequence.load(std::memory_order_acquire) - tail);
+				if (diff == 0) {
+					// The slot is free, try to claim it, another producer may have been faster
+					if (_tail.compare_exchange_weak(tail, tail + 1, std::memory_order_relaxed)) {
+						break;
+					}
+				} else if (diff < 0) {
+					// The slot still holds an element from the previous lap
+					return false;
+				} else {
+					tail = _tail.load(std::memory_order_relaxed);
+				}
+			}
+			slot->Value = std::move(value);
+			slot->Sequence.store(tail + 1, std::memory_order_release);
+			return true;
+		}
+
+		/** @brief Removes the oldest element, returns `false` if the queue is empty (consumer only) */
+		bool TryPop(T& value) {
+			Slot& slot = _slots[_head & (Capacity - 1)];
+			if (slot.Sequence.load(std::memory_order_acquire) != _head + 1) {
+				return false;
+			}
+			value = std::move(slot.Value);
+			slot.Sequence.store(_head + Capacity, std::memory_order_release);
+			_head++;
+			return true;
+		}
+
+	private:
+		struct Slot {
+			std::atomic<std::uint32_t> Sequence;
+			T Value;
+		};
+
+		// The consumer index is touched by a single thread only, the producer index is shared by all producers
+		alignas(64) std::uint32_t _head;
+		alignas(64) std::atomic<std::uint32_t> _tail;
+		alignas(64) Slot _slots[Capacity];
+	};
+}
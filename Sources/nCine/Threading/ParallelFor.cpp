@@ -0,0 +1,99 @@
+#include "ParallelFor.h"
+#include "../ServiceLocator.h"
+
+#if defined(WITH_THREADS)
+#	include "ThreadSync.h"
+
+#	include <algorithm>
+#	include <atomic>
+#	include <memory>
+#endif
+
+using namespace Death::Containers;
+
+namespace nCine
+{
+#if defined(WITH_THREADS)
+	namespace
+	{
+		struct ParallelForContext
+		{
+			Function<void(std::uint32_t)>* Func;
+			std::uint32_t Count;
+			std::atomic<std::uint32_t> NextIndex;
+			std::atomic<std::uint32_t> ProcessedCount;
+			Mutex DoneMutex;
+			CondVariable DoneCV;
+
+			void ProcessAll()
+			{
+				while (true) {
+					std::uint32_t index = NextIndex.fetch_add(1, std::memory_order_relaxed);
+					if (index >= Count) {
+						// All indices were already handed out, `Func` may no longer exist at this point
+						break;
+					}
+					(*Func)(index);
+
+					if (ProcessedCount.fetch_add(1, std::memory_order_acq_rel) + 1 == Count) {
+						DoneMutex.Lock();
+						DoneCV.Signal();
+						DoneMutex.Unlock();
+					}
+				}
+			}
+		};
+
+		class ParallelForCommand : public IThreadCommand
+		{
+		public:
+			explicit ParallelForCommand(std::shared_ptr<ParallelForContext> context)
+				: _context(std::move(context)) {}
+
+			void Execute() override
+			{
+				// The caller returns as soon as all indices are processed, so commands still waiting in the queue
+				// behind unrelated jobs only find nothing left to do. They share ownership of the context for that.
+				_context->ProcessAll();
+			}
+
+		private:
+			std::shared_ptr<ParallelForContext> _context;
+		};
+	}
+#endif
+
+	void ParallelFor(std::uint32_t count, Function<void(std::uint32_t)>&& func)
+	{
+#if defined(WITH_THREADS)
+		IThreadPool& threadPool = theServiceLocator().GetThreadPool();
+		// The calling thread processes indices too, so one job less is needed
+		std::uint32_t workerCount = (count > 1 ? std::min((std::uint32_t)threadPool.GetThreadCount(), count - 1) : 0);
+		if (workerCount > 0) {
+			auto context = std::make_shared<ParallelForContext>();
+			context->Func = &func;
+			context->Count = count;
+			context->NextIndex = 0;
+			context->ProcessedCount = 0;
+
+			for (std::uint32_t i = 0; i < workerCount; i++) {
+				threadPool.EnqueueCommand(std::make_unique<ParallelForCommand>(context));
+			}
+
+			context->ProcessAll();
+
+			// Wait only for indices that are still being processed by other threads, not for the queued commands
+			context->DoneMutex.Lock();
+			while (context->ProcessedCount.load(std::memory_order_acquire) < count) {
+				context->DoneCV.Wait(context->DoneMutex);
+			}
+			context->DoneMutex.Unlock();
+			return;
+		}
+#endif
+
+		for (std::uint32_t i = 0; i < count; i++) {
+			func(i);
+		}
+	}
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstdint>
+
+#include <Containers/Function.h>
+
+namespace nCine
+{
+	/**
+		@brief Invokes @p func for every index in range `[0, count)` using the registered thread pool
+
+		The calling thread takes part in the work and the function returns as soon as all indices have been
+		processed, jobs still queued behind unrelated work exit without doing anything later. Indices are handed
+		out one at a time, so jobs of uneven cost are balanced between threads. If no thread pool is registered,
+		all indices are processed sequentially on the calling thread. The function must be safe to call
+		concurrently for different indices and must not call @ref ParallelFor() recursively, because workers
+		waiting for nested jobs could starve the pool.
+	*/
+	void ParallelFor(std::uint32_t count, Death::Containers::Function<void(std::uint32_t)>&& func);
+}
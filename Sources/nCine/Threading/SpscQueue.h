@@ -0,0 +1,74 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace nCine
+{
+	/**
+		@brief Bounded lock-free single-producer/single-consumer ring buffer
+
+		Exactly one thread may push and exactly one (other) thread may pop at any given time, neither of them
+		ever blocks or allocates. Elements must be default-constructible and movable, popped slots are left
+		in a moved-from state and reused. The capacity must be a power of two.
+	*/
+	template<class T, std::uint32_t Capacity>
+	class SpscQueue
+	{
+		static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+	public:
+		SpscQueue() : _head(0), _tail(0) {}
+
+		SpscQueue(const SpscQueue&) = delete;
+		SpscQueue& operator=(const SpscQueue&) = delete;
+
+		/** @brief Appends an element, returns `false` if the queue is full (producer only) */
+		bool TryPush(T&& value) {
+			std::uint32_t tail = _tail.load(std::memory_order_relaxed);
+			if (tail - _cachedHead == Capacity) {
+				_cachedHead = _head.load(std::memory_order_acquire);
+				if (tail - _cachedHead == Capacity) {
+					return false;
+				}
+			}
+			_items[tail & (Capacity - 1)] = std::move(value);
+			_tail.store(tail + 1, std::memory_order_release);
+			return true;
+		}
+
+		/** @brief Removes the oldest element, returns `false` if the queue is empty (consumer only) */
+		bool TryPop(T& value) {
+			std::uint32_t head = _head.load(std::memory_order_relaxed);
+			if (head == _cachedTail) {
+				_cachedTail = _tail.load(std::memory_order_acquire);
+				if (head == _cachedTail) {
+					return false;
+				}
+			}
+			value = std::move(_items[head & (Capacity - 1)]);
+			_head.store(head + 1, std::memory_order_release);
+			return true;
+		}
+
+		/** @brief Returns number of elements that can be pushed without failing (producer only) */
+		std::uint32_t GetFreeCount() const {
+			return Capacity - (_tail.load(std::memory_order_relaxed) - _head.load(std::memory_order_acquire));
+		}
+
+		/** @brief Returns approximate number of queued elements, exact only when called from one of the two threads */
+		std::uint32_t GetCount() const {
+			return _tail.load(std::memory_order_acquire) - _head.load(std::memory_order_acquire);
+		}
+
+	private:
+		// Indices are kept on separate cache lines, each one is written by a single thread only
+		alignas(64) std::atomic<std::uint32_t> _head;
+		std::uint32_t _cachedTail = 0;
+		alignas(64) std::atomic<std::uint32_t> _tail;
+		std::uint32_t _cachedHead = 0;
+		alignas(64) T _items[Capacity];
+	};
+}
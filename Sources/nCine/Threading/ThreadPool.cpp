@@ -11,8 +11,10 @@ namespace nCine
 	}
 
 	ThreadPool::ThreadPool(std::size_t numThreads)
-		: _threads(numThreads), _numThreads(numThreads)
+		: _numThreads(numThreads)
 	{
+		_threads.reserve(numThreads);
+
 		_threadStruct.queue = &_queue;
 		_threadStruct.queueMutex = &_queueMutex;
 		_threadStruct.queueCV = &_queueCV;
@@ -27,8 +29,11 @@ namespace nCine
 
 	ThreadPool::~ThreadPool()
 	{
+		// Set under the lock, so no worker can miss the broadcast between checking the flag and waiting
+		_queueMutex.Lock();
 		_threadStruct.shouldQuit = true;
 		_queueCV.Broadcast();
+		_queueMutex.Unlock();
 
 		for (std::size_t i = 0; i < _numThreads; i++) {
 			_threads[i].Join();
@@ -45,6 +50,11 @@ namespace nCine
 		_queueMutex.Unlock();
 	}
 
+	std::size_t ThreadPool::GetThreadCount() const
+	{
+		return _numThreads;
+	}
+
 	void ThreadPool::WorkerFunction(void* arg)
 	{
 		ThreadStruct* threadStruct = static_cast<ThreadStruct*>(arg);
@@ -66,7 +76,6 @@ namespace nCine
 			threadStruct->queue->pop_front();
 			threadStruct->queueMutex->Unlock();
 
-			LOGD("Worker thread {} is executing its command", Thread::GetCurrentId());
 			threadCommand->Execute();
 		}
 
@@ -54,6 +54,7 @@ list(APPEND ANDROID_PASSTHROUGH_ARGS -DNCINE_WITH_FIXED_BATCH_SIZE=${NCINE_WITH_
 # Jazz² Resurrection options
 list(APPEND ANDROID_PASSTHROUGH_ARGS -DSHAREWARE_DEMO_ONLY=${SHAREWARE_DEMO_ONLY}
 	-DDISABLE_RESCALE_SHADERS=${DISABLE_RESCALE_SHADERS} -DTILEMAP_USE_SINGLE_DRAW=${TILEMAP_USE_SINGLE_DRAW}
+	-DTILEMAP_USE_PERSISTENT_CHUNKS=${TILEMAP_USE_PERSISTENT_CHUNKS}
 	-DWITH_MULTIPLAYER=${WITH_MULTIPLAYER} -DWITH_ONLINE_MULTIPLAYER=${WITH_ONLINE_MULTIPLAYER}
 	-DWITH_WEBSOCKET=${WITH_WEBSOCKET} -DWITH_WEBSOCKET_TLS_BACKEND=${WITH_WEBSOCKET_TLS_BACKEND})
 
@@ -1248,6 +1248,11 @@ if(TILEMAP_USE_SINGLE_DRAW)
 	target_compile_definitions(${NCINE_APP} PUBLIC "TILEMAP_USE_SINGLE_DRAW")
 endif()
 
+if(TILEMAP_USE_PERSISTENT_CHUNKS)
+	message(STATUS "Building the game with persistent tilemap layer chunks")
+	target_compile_definitions(${NCINE_APP} PUBLIC "TILEMAP_USE_PERSISTENT_CHUNKS")
+endif()
+
 if(WITH_MULTIPLAYER)
 	target_compile_definitions(${NCINE_APP} PUBLIC "WITH_MULTIPLAYER")
 	
@@ -1261,12 +1266,15 @@ if(WITH_MULTIPLAYER)
 		${NCINE_SOURCE_DIR}/Jazz2/Actors/Multiplayer/RemoteActor.h
 		${NCINE_SOURCE_DIR}/Jazz2/Actors/Multiplayer/RemotePlayerOnServer.h
 		${NCINE_SOURCE_DIR}/Jazz2/Actors/Multiplayer/StateInterpolationBuffer.h
+		${NCINE_SOURCE_DIR}/Jazz2/Multiplayer/ActorSnapshot.h
 		${NCINE_SOURCE_DIR}/Jazz2/Multiplayer/ConnectionResult.h
 		${NCINE_SOURCE_DIR}/Jazz2/Multiplayer/INetworkHandler.h
+		${NCINE_SOURCE_DIR}/Jazz2/Multiplayer/ILoopbackHandler.h
 		${NCINE_SOURCE_DIR}/Jazz2/Multiplayer/MpGameMode.h
 		${NCINE_SOURCE_DIR}/Jazz2/Multiplayer/MpLevelHandler.h
 		${NCINE_SOURCE_DIR}/Jazz2/Multiplayer/NetworkManager.h
 		${NCINE_SOURCE_DIR}/Jazz2/Multiplayer/NetworkManagerBase.h
+		${NCINE_SOURCE_DIR}/Jazz2/Multiplayer/OutgoingPacket.h
 		${NCINE_SOURCE_DIR}/Jazz2/Multiplayer/PacketTypes.h
 		${NCINE_SOURCE_DIR}/Jazz2/Multiplayer/Peer.h
 		${NCINE_SOURCE_DIR}/Jazz2/Multiplayer/PeerDescriptor.h
@@ -1306,6 +1314,7 @@ if(WITH_MULTIPLAYER)
 		${NCINE_SOURCE_DIR}/Jazz2/Actors/Multiplayer/RemotablePlayer.cpp
 		${NCINE_SOURCE_DIR}/Jazz2/Actors/Multiplayer/RemoteActor.cpp
 		${NCINE_SOURCE_DIR}/Jazz2/Actors/Multiplayer/RemotePlayerOnServer.cpp
+		${NCINE_SOURCE_DIR}/Jazz2/Multiplayer/ActorSnapshot.cpp
 		${NCINE_SOURCE_DIR}/Jazz2/Multiplayer/ConnectionResult.cpp
 		${NCINE_SOURCE_DIR}/Jazz2/Multiplayer/MpLevelHandler.cpp
 		${NCINE_SOURCE_DIR}/Jazz2/Multiplayer/GameModes/GameModeFactory.cpp
@@ -1317,6 +1326,7 @@ if(WITH_MULTIPLAYER)
 		${NCINE_SOURCE_DIR}/Jazz2/Multiplayer/GameModes/CaptureTheFlagMode.cpp
 		${NCINE_SOURCE_DIR}/Jazz2/Multiplayer/NetworkManager.cpp
 		${NCINE_SOURCE_DIR}/Jazz2/Multiplayer/NetworkManagerBase.cpp
+		${NCINE_SOURCE_DIR}/Jazz2/Multiplayer/OutgoingPacket.cpp
 		${NCINE_SOURCE_DIR}/Jazz2/Multiplayer/Peer.cpp
 		${NCINE_SOURCE_DIR}/Jazz2/Multiplayer/RaceRouteGenerator.cpp
 		${NCINE_SOURCE_DIR}/Jazz2/Multiplayer/ServerDiscovery.cpp
@@ -1336,6 +1346,18 @@ if(WITH_MULTIPLAYER)
 		if(DEDICATED_SERVER)
 			message(STATUS "Building the game with online multiplayer support as dedicated server")
 			target_compile_definitions(${NCINE_APP} PUBLIC "DEDICATED_SERVER")
+
+			if(DEDICATED_SERVER_BENCHMARK)
+				message(STATUS "Building the dedicated server as loopback server benchmark")
+				target_compile_definitions(${NCINE_APP} PUBLIC "DEDICATED_SERVER_BENCHMARK")
+				if(WIN32)
+					set_target_properties(${NCINE_APP} PROPERTIES OUTPUT_NAME "Jazz2.ServerBenchmark")
+				else()
+					set_target_properties(${NCINE_APP} PROPERTIES OUTPUT_NAME "${NCINE_APP}_server_benchmark")
+				endif()
+				list(APPEND HEADERS ${NCINE_SOURCE_DIR}/Jazz2/Multiplayer/ServerBenchmark.h)
+				list(APPEND SOURCES ${NCINE_SOURCE_DIR}/Jazz2/Multiplayer/ServerBenchmark.cpp)
+			endif()
 		else()
 			message(STATUS "Building the game with online multiplayer support")
 		endif()
@@ -172,6 +172,9 @@ list(APPEND HEADERS
 	${NCINE_SOURCE_DIR}/nCine/Threading/IThreadCommand.h
 	${NCINE_SOURCE_DIR}/nCine/Threading/IThreadPool.h
 	${NCINE_SOURCE_DIR}/nCine/Threading/LockedPtr.h
+	${NCINE_SOURCE_DIR}/nCine/Threading/MpscQueue.h
+	${NCINE_SOURCE_DIR}/nCine/Threading/ParallelFor.h
+	${NCINE_SOURCE_DIR}/nCine/Threading/SpscQueue.h
 	${NCINE_SOURCE_DIR}/nCine/Threading/Thread.h
 	${NCINE_SOURCE_DIR}/nCine/Threading/ThreadSync.h
 	# Runtime part of ShaderCompiler, shared with the offline tool
@@ -195,9 +198,12 @@ if(NCINE_PREFERRED_RHI STREQUAL "Software")
 		${NCINE_SOURCE_DIR}/nCine/Graphics/RHI/Software/SwShader.h
 		${NCINE_SOURCE_DIR}/nCine/Graphics/RHI/Software/SwShaderProgram.h
 		${NCINE_SOURCE_DIR}/nCine/Graphics/RHI/Software/SwShaderRuntime.h
+		${NCINE_SOURCE_DIR}/nCine/Graphics/RHI/Software/SwShaderRuntimeMath.h
+		${NCINE_SOURCE_DIR}/nCine/Graphics/RHI/Software/SwShaderRuntimeWide.h
 		${NCINE_SOURCE_DIR}/nCine/Graphics/RHI/Software/SwShaderTypes.h
 		${NCINE_SOURCE_DIR}/nCine/Graphics/RHI/Software/SwShaderUniforms.h
 		${NCINE_SOURCE_DIR}/nCine/Graphics/RHI/Software/SwTexture.h
+		${NCINE_SOURCE_DIR}/nCine/Graphics/RHI/Software/SwTileInternal.h
 		${NCINE_SOURCE_DIR}/nCine/Graphics/RHI/Software/SwTileRenderer.h
 		${NCINE_SOURCE_DIR}/nCine/Graphics/RHI/Software/SwUniformCache.h
 		${NCINE_SOURCE_DIR}/nCine/Graphics/RHI/Software/SwVertexFormat.h
@@ -442,11 +442,14 @@ option(DEATH_CPU_USE_RUNTIME_DISPATCH "Build with runtime dispatch for CPU-depen
 # Jazz² Resurrection options
 option(SHAREWARE_DEMO_ONLY "Show only Shareware Demo episode" OFF)
 cmake_dependent_option(DISABLE_RESCALE_SHADERS "Disable all rescaling options" OFF "NOT NCINE_PREFERRED_RHI STREQUAL Software;NOT NCINE_PREFERRED_RHI STREQUAL GX;NOT NCINE_PREFERRED_RHI STREQUAL PVR;NOT NCINE_PREFERRED_RHI STREQUAL GU;NOT NCINE_PREFERRED_RHI STREQUAL GS;NOT VITA" ON)
-# The single-draw tilemap mesh stays off where the backend cannot consume it: the software backend
-# rasterizes per tile. The GX, PVR and GU backends all consume the whole-layer mesh directly (see
-# GxDevice::DispatchTileMesh, PvrDevice::DispatchTileMesh and GuDevice::DispatchTileMesh), so they
-# keep it on - on the GU it is also what lets a whole layer go out as one GE draw call
-cmake_dependent_option(TILEMAP_USE_SINGLE_DRAW "Aggregate draw calls for each tilemap layer" ON "NOT NCINE_PREFERRED_RHI STREQUAL Software" OFF)
+# The GX, PVR and GU backends all consume the whole-layer mesh directly (see GxDevice::DispatchTileMesh,
+# PvrDevice::DispatchTileMesh and GuDevice::DispatchTileMesh) - on the GU it is also what lets a whole layer
+# go out as one GE draw call. The software backend blits a pixel-aligned layer mesh as a single tile-renderer
+# command (see SwTileRenderer::SubmitTileLayer) and falls back to drawing it quad by quad otherwise
+option(TILEMAP_USE_SINGLE_DRAW "Aggregate draw calls for each tilemap layer" ON)
+# Persistent chunks need a vertex buffer per chunk of each layer, so they're available only where that's cheap.
+# They stay opt-in until they're profiled on OpenGL and Vulkan hardware, the chunked path has never run there
+cmake_dependent_option(TILEMAP_USE_PERSISTENT_CHUNKS "Keep tilemap layer meshes between frames in chunks" OFF "TILEMAP_USE_SINGLE_DRAW;NCINE_PREFERRED_RHI STREQUAL OpenGL OR NCINE_PREFERRED_RHI STREQUAL Vulkan" OFF)
 
 # Even the local (splitscreen) half of multiplayer is built on NetworkManagerBase, which owns an
 # `nCine::Thread` unconditionally on every non-Emscripten platform, so the whole feature needs threads.
@@ -465,6 +468,8 @@ cmake_dependent_option(WITH_MULTIPLAYER "Enable multiplayer support" ON "NCINE_W
 # cannot compile there as it stands. Local splitscreen (WITH_MULTIPLAYER) is unaffected.
 cmake_dependent_option(WITH_ONLINE_MULTIPLAYER "Enable online multiplayer transport (requires WITH_MULTIPLAYER)" ON "WITH_MULTIPLAYER;NCINE_WITH_THREADS OR EMSCRIPTEN;NOT NINTENDO_WII;NOT NINTENDO_GAMECUBE;NOT PLATFORM_DREAMCAST;NOT PLATFORM_PSP;NOT PLATFORM_PS2;NOT VITA" OFF)
 cmake_dependent_option(DEDICATED_SERVER "Build dedicated server only" OFF "WITH_ONLINE_MULTIPLAYER;NOT NCINE_BUILD_ANDROID;NOT EMSCRIPTEN;NOT NINTENDO_SWITCH;NOT WINDOWS_PHONE;NOT WINDOWS_STORE" OFF)
+# The benchmark flavor replaces the server loop by synthetic in-process clients on the loopback transport (see ServerBenchmark)
+cmake_dependent_option(DEDICATED_SERVER_BENCHMARK "Build the dedicated server as standalone loopback server benchmark" OFF "DEDICATED_SERVER;NCINE_WITH_THREADS" OFF)
 # IXWebSocket requires a full BSD sockets stack (e.g. <netinet/ip.h>), which the Nintendo Switch and
 # PS Vita toolchains don't provide, so WebSocket transport is unavailable there (enet is still used).
 cmake_dependent_option(WITH_WEBSOCKET "Enable WebSocket transport for multiplayer" ON "WITH_ONLINE_MULTIPLAYER;NOT EMSCRIPTEN;NOT NINTENDO_SWITCH;NOT VITA" OFF)
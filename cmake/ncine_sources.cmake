@@ -33,6 +33,7 @@ set(SOURCES ${SHARED_SOURCES})
 set(CONVERTER_SOURCES
 	${NCINE_SOURCE_DIR}/Jazz2/Compatibility/AnimSetMapping.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Compatibility/AssetConverter.cpp
+	${NCINE_SOURCE_DIR}/Jazz2/Compatibility/AssetManifest.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Compatibility/EventConverter.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Compatibility/J2vRecompressor.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Compatibility/JJ2Anims.cpp
@@ -114,6 +115,7 @@ list(APPEND SOURCES
 	${NCINE_SOURCE_DIR}/nCine/Primitives/Color.cpp
 	${NCINE_SOURCE_DIR}/nCine/Primitives/Colorf.cpp
 	${NCINE_SOURCE_DIR}/nCine/Primitives/Half.cpp
+	${NCINE_SOURCE_DIR}/nCine/Threading/ParallelFor.cpp
 	${NCINE_SOURCE_DIR}/nCine/Threading/Thread.cpp
 	# Runtime part of ShaderCompiler, shared with the offline tool - enables loading ".shader" files at runtime
 	${NCINE_SOURCE_DIR}/Utilities/ShaderCompiler/ConstFold.cpp
@@ -276,7 +278,10 @@ list(APPEND SOURCES
 	${NCINE_SOURCE_DIR}/Jazz2/LevelInitialization.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/PreferencesCache.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Resources.cpp
+	${NCINE_SOURCE_DIR}/Jazz2/Replay.cpp
+	${NCINE_SOURCE_DIR}/Jazz2/RollbackBuffer.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Actors/ActorBase.cpp
+	${NCINE_SOURCE_DIR}/Jazz2/Actors/ActorCoreTable.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Actors/Player.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Actors/PlayerCorpse.cpp
 	${NCINE_SOURCE_DIR}/Jazz2/Actors/SolidObjectBase.cpp